@@ -0,0 +1,269 @@
+// This file is part of DynExp.
+
+#include "stdafx.h"
+#include "BenchmarkUtil.h"
+
+#if defined(DYNEXP_UNIX)
+#include <unistd.h>
+#elif defined(DYNEXP_MSVC)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <tlhelp32.h>
+#endif
+
+namespace DynExpBenchmark
+{
+	void LatencyRecorder::Add(DurationType Latency) noexcept
+	{
+		const auto Value = std::max(DurationType::rep(0), Latency.count());
+
+		++Buckets[GetBucketIndex(Value)];
+		++Count;
+		Sum += Value;
+		Max = std::max(Max, Value);
+	}
+
+	void LatencyRecorder::Add(double LatencyInSeconds) noexcept
+	{
+		Add(std::chrono::duration_cast<DurationType>(std::chrono::duration<double>(std::max(0.0, LatencyInSeconds))));
+	}
+
+	void LatencyRecorder::Merge(const LatencyRecorder& Other) noexcept
+	{
+		for (size_t i = 0; i < Buckets.size(); ++i)
+			Buckets[i] += Other.Buckets[i];
+
+		Count += Other.Count;
+		Sum += Other.Sum;
+		Max = std::max(Max, Other.Max);
+	}
+
+	void LatencyRecorder::Clear() noexcept
+	{
+		Buckets.fill(0);
+		Count = 0;
+		Sum = 0;
+		Max = 0;
+	}
+
+	double LatencyRecorder::GetPercentile(double Quantile) const noexcept
+	{
+		if (!Count)
+			return 0;
+
+		// Rank of the requested latency (1-based) among all recorded latencies
+		const auto Rank = std::max(size_t(1), static_cast<size_t>(std::ceil(std::clamp(Quantile, 0.0, 1.0) * Count)));
+
+		size_t NumBelow = 0;
+		for (size_t i = 0; i < Buckets.size(); ++i)
+		{
+			NumBelow += Buckets[i];
+
+			// The bucket's upper bound might exceed the maximal latency actually recorded.
+			if (NumBelow >= Rank)
+				return std::min(GetBucketUpperBound(i), static_cast<double>(Max)) / 1e3;
+		}
+
+		return Max / 1e3;
+	}
+
+	LatencyRecorder::SummaryType LatencyRecorder::GetSummary() const noexcept
+	{
+		SummaryType Summary;
+
+		Summary.Count = Count;
+		Summary.Mean = Count ? static_cast<double>(Sum / Count / 1e3) : 0;
+		Summary.P50 = GetPercentile(.5);
+		Summary.P90 = GetPercentile(.9);
+		Summary.P99 = GetPercentile(.99);
+		Summary.P999 = GetPercentile(.999);
+		Summary.Max = Max / 1e3;
+
+		return Summary;
+	}
+
+	size_t LatencyRecorder::GetBucketIndex(DurationType::rep Latency) noexcept
+	{
+		if (Latency <= 1)
+			return 0;
+
+		const auto Index = static_cast<size_t>(std::log2(static_cast<double>(Latency)) * NumBucketsPerOctave);
+
+		return std::min(Index, NumBucketsPerOctave * NumOctaves - 1);
+	}
+
+	double LatencyRecorder::GetBucketUpperBound(size_t Index) noexcept
+	{
+		return std::exp2(static_cast<double>(Index + 1) / NumBucketsPerOctave);
+	}
+
+#if defined(DYNEXP_UNIX)
+	ThreadCPUTimesType GetThreadCPUTimes()
+	{
+		static const auto ClockTicksPerSecond = static_cast<double>(sysconf(_SC_CLK_TCK));
+
+		ThreadCPUTimesType CPUTimes;
+
+		std::error_code Error;
+		for (const auto& Entry : std::filesystem::directory_iterator("/proc/self/task", Error))
+		{
+			uint64_t ThreadID{};
+			const auto Filename = Entry.path().filename().string();
+			if (std::from_chars(Filename.data(), Filename.data() + Filename.size(), ThreadID).ec != std::errc())
+				continue;
+
+			// The thread might have terminated in the meantime.
+			std::ifstream StatFile(Entry.path() / "stat");
+			std::string Stat;
+			if (!StatFile || !std::getline(StatFile, Stat))
+				continue;
+
+			// The thread name (field 2) is enclosed in parentheses and might contain spaces. So, parse after the last ')'.
+			// Then, utime and stime are the 12th and 13th whitespace-separated fields (refer to proc(5)).
+			const auto NameBegin = Stat.find('(');
+			const auto NameEnd = Stat.rfind(')');
+			if (NameBegin == std::string::npos || NameEnd == std::string::npos || NameEnd < NameBegin)
+				continue;
+
+			std::istringstream Fields(Stat.substr(NameEnd + 1));
+			std::string Field;
+			unsigned long long UserTicks{}, SystemTicks{};
+			for (int i = 0; i < 11 && Fields >> Field; ++i);
+			if (!(Fields >> UserTicks >> SystemTicks))
+				continue;
+
+			CPUTimes[ThreadID] = { Stat.substr(NameBegin + 1, NameEnd - NameBegin - 1),
+				UserTicks / ClockTicksPerSecond, SystemTicks / ClockTicksPerSecond };
+		}
+
+		return CPUTimes;
+	}
+#elif defined(DYNEXP_MSVC)
+	ThreadCPUTimesType GetThreadCPUTimes()
+	{
+		// FILETIME counts in units of 100 ns.
+		constexpr auto ToSeconds = [](const FILETIME& Time) {
+			return ((static_cast<uint64_t>(Time.dwHighDateTime) << 32) | Time.dwLowDateTime) / 1e7;
+		};
+
+		ThreadCPUTimesType CPUTimes;
+
+		auto Snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+		if (Snapshot == INVALID_HANDLE_VALUE)
+			return CPUTimes;
+
+		const auto ProcessID = GetCurrentProcessId();
+		THREADENTRY32 Entry{};
+		Entry.dwSize = sizeof(Entry);
+		for (auto Success = Thread32First(Snapshot, &Entry); Success; Success = Thread32Next(Snapshot, &Entry))
+		{
+			if (Entry.th32OwnerProcessID != ProcessID)
+				continue;
+
+			auto Thread = OpenThread(THREAD_QUERY_LIMITED_INFORMATION, FALSE, Entry.th32ThreadID);
+			if (!Thread)
+				continue;
+
+			FILETIME CreationTime{}, ExitTime{}, KernelTime{}, UserTime{};
+			if (GetThreadTimes(Thread, &CreationTime, &ExitTime, &KernelTime, &UserTime))
+			{
+				std::string Name = "thread";
+				PWSTR Description = nullptr;
+				if (SUCCEEDED(GetThreadDescription(Thread, &Description)) && Description)
+				{
+					if (*Description)
+						Name = QString::fromWCharArray(Description).toStdString();
+					LocalFree(Description);
+				}
+
+				CPUTimes[Entry.th32ThreadID] = { std::move(Name), ToSeconds(UserTime), ToSeconds(KernelTime) };
+			}
+
+			CloseHandle(Thread);
+		}
+
+		CloseHandle(Snapshot);
+
+		return CPUTimes;
+	}
+#else
+	ThreadCPUTimesType GetThreadCPUTimes()
+	{
+		throw Util::NotImplementedException("Determining the CPU time per thread is not supported on this platform.");
+	}
+#endif
+
+	ThreadCPUTimesType DiffThreadCPUTimes(const ThreadCPUTimesType& Before, const ThreadCPUTimesType& After)
+	{
+		ThreadCPUTimesType Diff;
+
+		for (const auto& [ThreadID, CPUTime] : After)
+		{
+			auto Result = CPUTime;
+
+			// Thread IDs might be reused by the operating system. If the name has changed, it is a different thread.
+			const auto BeforeIt = Before.find(ThreadID);
+			if (BeforeIt != Before.cend() && BeforeIt->second.Name == CPUTime.Name)
+			{
+				Result.UserTime = std::max(0.0, Result.UserTime - BeforeIt->second.UserTime);
+				Result.SystemTime = std::max(0.0, Result.SystemTime - BeforeIt->second.SystemTime);
+			}
+
+			Diff[ThreadID] = std::move(Result);
+		}
+
+		return Diff;
+	}
+
+	void PrintReport(std::ostream& Stream, const ScenarioResultType& Result, double MinCPUTime)
+	{
+		const auto PrintLatencies = [&Stream](std::string_view Title, const LatencyRecorder& Latencies) {
+			const auto Summary = Latencies.GetSummary();
+
+			Stream << "  " << Title << " (us, n = " << Summary.Count << "): mean " << Summary.Mean << ", p50 " << Summary.P50
+				<< ", p90 " << Summary.P90 << ", p99 " << Summary.P99 << ", p99.9 " << Summary.P999 << ", max " << Summary.Max << "\n";
+		};
+
+		Stream << std::fixed << std::setprecision(1);
+		Stream << "=== " << Result.Name << " (" << Result.Duration << " s) ===\n";
+
+		if (Result.NumItemsProduced || Result.NumItemsConsumed)
+		{
+			const auto Duration = Result.Duration > 0 ? Result.Duration : 1;
+			Stream << "  Throughput: produced " << Result.NumItemsProduced / Duration << " " << Result.ItemUnit << "/s, consumed "
+				<< Result.NumItemsConsumed / Duration << " " << Result.ItemUnit << "/s\n";
+		}
+
+		if (Result.Latencies.GetCount())
+			PrintLatencies(Result.LatencyTitle, Result.Latencies);
+		if (Result.OperationLatencies.GetCount())
+			PrintLatencies(Result.OperationTitle, Result.OperationLatencies);
+
+		for (const auto& [Key, Value] : Result.Details)
+			Stream << "  " << Key << ": " << Value << "\n";
+
+		Stream << "  Lock timeouts: " << Result.NumLockTimeouts << ", event log warnings: " << Result.NumLogWarnings
+			<< ", event log errors: " << Result.NumLogErrors << "\n";
+
+		double TotalCPUTime = 0;
+		std::vector<std::pair<uint64_t, const ThreadCPUTimeType*>> BusyThreads;
+		for (const auto& [ThreadID, CPUTime] : Result.CPUTimes)
+		{
+			TotalCPUTime += CPUTime.UserTime + CPUTime.SystemTime;
+
+			if (CPUTime.UserTime + CPUTime.SystemTime >= MinCPUTime)
+				BusyThreads.emplace_back(ThreadID, &CPUTime);
+		}
+		std::sort(BusyThreads.begin(), BusyThreads.end(), [](const auto& a, const auto& b) {
+			return a.second->UserTime + a.second->SystemTime > b.second->UserTime + b.second->SystemTime;
+		});
+
+		Stream << std::setprecision(3) << "  CPU time: " << TotalCPUTime << " s in " << Result.CPUTimes.size() << " threads ("
+			<< (Result.Duration > 0 ? 100 * TotalCPUTime / Result.Duration : 0) << " % of one core)\n";
+		for (const auto& [ThreadID, CPUTime] : BusyThreads)
+			Stream << "    [" << ThreadID << "] " << CPUTime->Name << ": user " << CPUTime->UserTime << " s, system " << CPUTime->SystemTime << " s\n";
+
+		Stream << std::defaultfloat << std::endl;
+	}
+}
@@ -0,0 +1,136 @@
+// This file is part of DynExp.
+
+/**
+ * @file BenchmarkUtil.h
+ * @brief Provides measurement and reporting utilities for %DynExp's headless benchmark
+ * executable (@p DynExpBenchmark).
+*/
+
+#pragma once
+
+#include "stdafx.h"
+
+/**
+ * @brief %DynExp's headless benchmark executable measuring the overhead of %DynExp's hot paths
+ * (data streams, instrument data locking, gRPC transfer, Python stream manipulation, camera image
+ * transfer) without real hardware and without rendering the GUI.
+*/
+namespace DynExpBenchmark
+{
+	/**
+	 * @brief Records latencies in a histogram with logarithmically spaced buckets (#NumBucketsPerOctave
+	 * buckets per power of two). Percentiles are accurate to approximately 4.4 %. Recording a latency
+	 * neither allocates memory nor locks a mutex. This class is not thread-safe. Each thread should use
+	 * its own instance. The instances can be combined by Merge() afterwards.
+	*/
+	class LatencyRecorder
+	{
+	public:
+		using DurationType = std::chrono::nanoseconds;
+
+		static constexpr size_t NumBucketsPerOctave = 16;		//!< Number of histogram buckets per power of two
+		static constexpr size_t NumOctaves = 42;				//!< Range of the histogram in powers of two (1 ns up to approx. 73 min)
+
+		/**
+		 * @brief Latency statistics in microseconds
+		*/
+		struct SummaryType
+		{
+			size_t Count = 0;		//!< Number of recorded latencies
+			double Mean = 0;
+			double P50 = 0;
+			double P90 = 0;
+			double P99 = 0;
+			double P999 = 0;
+			double Max = 0;
+		};
+
+		void Add(DurationType Latency) noexcept;				//!< Records @p Latency. Negative latencies are recorded as zero.
+		void Add(double LatencyInSeconds) noexcept;				//!< Records @p LatencyInSeconds. Negative latencies are recorded as zero.
+		void Merge(const LatencyRecorder& Other) noexcept;		//!< Adds all latencies recorded by @p Other to this instance.
+		void Clear() noexcept;									//!< Removes all recorded latencies.
+
+		size_t GetCount() const noexcept { return Count; }		//!< Getter for #Count
+
+		/**
+		 * @brief Determines the latency below which @p Quantile of the recorded latencies lie.
+		 * @param Quantile Quantile in the range [0, 1]
+		 * @return Upper bound of the histogram bucket the quantile falls into in microseconds.
+		 * Returns 0 if nothing has been recorded.
+		*/
+		double GetPercentile(double Quantile) const noexcept;
+
+		SummaryType GetSummary() const noexcept;				//!< Computes the count, the mean, typical percentiles and the maximum in microseconds.
+
+	private:
+		static size_t GetBucketIndex(DurationType::rep Latency) noexcept;		//!< Returns the index of the histogram bucket @p Latency (in ns) falls into.
+		static double GetBucketUpperBound(size_t Index) noexcept;				//!< Returns the upper bound of the histogram bucket @p Index in ns.
+
+		std::array<size_t, NumBucketsPerOctave * NumOctaves> Buckets{};		//!< Histogram of the recorded latencies
+		size_t Count = 0;														//!< Number of recorded latencies
+		long double Sum = 0;													//!< Sum of the recorded latencies in ns
+		DurationType::rep Max = 0;												//!< Maximal recorded latency in ns
+	};
+
+	/**
+	 * @brief CPU time a thread has consumed
+	*/
+	struct ThreadCPUTimeType
+	{
+		std::string Name;			//!< Name of the thread as assigned by the operating system or the thread itself
+		double UserTime = 0;		//!< CPU time spent in user mode in seconds
+		double SystemTime = 0;		//!< CPU time spent in kernel mode in seconds
+	};
+
+	/**
+	 * @brief Maps operating system thread IDs to the CPU time the respective threads have consumed.
+	*/
+	using ThreadCPUTimesType = std::map<uint64_t, ThreadCPUTimeType>;
+
+	/**
+	 * @brief Determines the CPU time each thread of this process has consumed since it has been started.
+	 * @return CPU times of all threads currently running in this process
+	 * @throws Util::NotImplementedException is thrown on platforms other than Linux and Windows.
+	*/
+	ThreadCPUTimesType GetThreadCPUTimes();
+
+	/**
+	 * @brief Computes the CPU time threads have consumed between two calls to GetThreadCPUTimes().
+	 * Threads which have terminated before @p After was recorded are omitted. Threads which
+	 * have been started after @p Before was recorded are included with their entire CPU time.
+	 * @param Before Thread CPU times at the beginning of a measurement
+	 * @param After Thread CPU times at the end of a measurement
+	 * @return CPU times consumed during the measurement
+	*/
+	ThreadCPUTimesType DiffThreadCPUTimes(const ThreadCPUTimesType& Before, const ThreadCPUTimesType& After);
+
+	/**
+	 * @brief Result of a single benchmark scenario
+	*/
+	struct ScenarioResultType
+	{
+		std::string Name;							//!< Name of the scenario
+		double Duration = 0;						//!< Duration of the measurement in seconds
+		size_t NumItemsProduced = 0;				//!< Number of samples or images produced
+		size_t NumItemsConsumed = 0;				//!< Number of samples or images which reached the consumers
+		std::string ItemUnit = "samples";			//!< Unit of the items counted by #NumItemsProduced and #NumItemsConsumed
+		std::string LatencyTitle = "Latency";		//!< Description of #Latencies in the report
+		LatencyRecorder Latencies;					//!< Latencies from production to consumption of the items
+		std::string OperationTitle = "Operation duration";	//!< Description of #OperationLatencies in the report
+		LatencyRecorder OperationLatencies;			//!< Duration of the benchmarked operations (e.g. reading a stream, fetching an image)
+		size_t NumLockTimeouts = 0;					//!< Number of Util::TimeoutException exceptions caught
+		size_t NumLogWarnings = 0;					//!< Number of warnings written to the event log during the measurement
+		size_t NumLogErrors = 0;					//!< Number of errors written to the event log during the measurement
+		size_t NumFailedChecks = 0;					//!< Number of failed consistency checks. The benchmark exits with an error code if it is not zero.
+		ThreadCPUTimesType CPUTimes;				//!< CPU time consumed per thread during the measurement
+		std::vector<std::pair<std::string, std::string>> Details;	//!< Additional scenario-specific results as key-value pairs
+	};
+
+	/**
+	 * @brief Writes a human-readable report of @p Result to @p Stream.
+	 * @param Stream Stream to write to
+	 * @param Result Result of a benchmark scenario
+	 * @param MinCPUTime Threads which consumed less CPU time (in seconds) are omitted from the report.
+	*/
+	void PrintReport(std::ostream& Stream, const ScenarioResultType& Result, double MinCPUTime = 1e-3);
+}
@@ -0,0 +1,2499 @@
+// This file is part of DynExp.
+
+/**
+ * @file DynExpBenchmark.cpp
+ * @brief This file defines the main entry point of %DynExp's headless benchmark executable.
+ * @details @p DynExpBenchmark instantiates %DynExp's core without the main window and builds
+ * synthetic projects from dummy instruments and consumer modules. It measures the overhead of
+ * %DynExp's hot paths without real hardware and without rendering the GUI. Run
+ * @p DynExpBenchmark @p --help for the available scenarios and options. Each scenario reports
+ * the throughput, latency percentiles, the CPU time consumed per thread, and the number of lock
+ * timeouts. The executable is built if the cmake option @p BUILD_BENCHMARKS is enabled.
+*/
+
+#include "stdafx.h"
+#include "BenchmarkUtil.h"
+#include <QtWidgets/QApplication>
+
+// Hardware adapters
+#include "HardwareAdapters/HardwareAdapterEthernet.h"
+#include "HardwareAdapters/ZILabOneDemodSampleReader.h"
+
+// Instruments
+#include "Instruments/DummyCamera.h"
+#include "Instruments/DummyDataStreamInstrument.h"
+#include "Instruments/NetworkDataStreamInstrument.h"
+#include "Instruments/StreamSpectrumAnalyzer.h"
+#include "MetaInstruments/LockinAmplifier.h"
+
+// Modules
+#include "Modules/NetworkDataStreamInstrumentModule.h"
+#include "Modules/StreamManipulator.h"
+#include "Modules/StreamOperator.h"
+#include "Modules/WidefieldMicroscope/ConfocalPSFOptimizer.h"
+
+namespace DynExpBenchmark
+{
+	using ClockType = std::chrono::steady_clock;
+
+	/**
+	 * @brief Settings of the benchmark scenarios as passed via the command line
+	*/
+	struct OptionsType
+	{
+		QStringList Scenarios;						//!< Scenarios to run in this order
+		double Duration = 5;						//!< Duration of each measurement in seconds
+		size_t NumInstruments = 4;					//!< Number of data stream instruments written to concurrently
+		double SampleRate = 1e5;					//!< Samples written per second to each data stream instrument
+		size_t BlockSize = 1000;					//!< Number of samples written at once
+		size_t StreamSize = 100000;					//!< Stream size of the data stream instruments in samples
+		std::chrono::milliseconds ReadInterval{ 20 };	//!< Time between two reads of a consumer (like the plotting module's main loop)
+		size_t NumCameras = 1;						//!< Number of cameras to fetch images from concurrently
+		int ImageWidth = 1024;						//!< Width of the camera images in pixels
+		int ImageHeight = 1024;						//!< Height of the camera images in pixels
+		double FPS = 30;							//!< Rate at which images are fetched from each camera
+		unsigned int Port = 50051;					//!< Network port of the gRPC loopback connection
+		size_t NumRepetitions = 100;				//!< Number of repetitions of computational benchmarks
+		double LargeStreamSize = 0;					//!< Size of an additional stream in GiB to check multi-gigabyte buffers (0 to skip)
+		size_t NumManipulators = 1;					//!< Number of stream manipulator modules running concurrently
+		std::vector<size_t> NumManipulatorsList{ 1 };	//!< Values of #NumManipulators to run the multiply and operator scenarios with in this order
+		QString PSFScanFilename;					//!< Recorded confocal scan to replay instead of a synthetic point spread function (empty for synthetic)
+
+		/**
+		 * @brief Python interpreter the stream manipulator modules execute their scripts in
+		*/
+		DynExpModule::StreamManipulatorParams::ExecutionBackendType PyBackend = DynExpModule::StreamManipulatorParams::ExecutionBackendType::MainInterpreter;
+
+		/**
+		 * @brief Values of #PyBackend to run the manipulator and multiply scenarios with in this order
+		*/
+		std::vector<DynExpModule::StreamManipulatorParams::ExecutionBackendType> PyBackends{ DynExpModule::StreamManipulatorParams::ExecutionBackendType::MainInterpreter };
+	};
+
+	/**
+	 * @brief Returns a human-readable description of the Python interpreter @p PyBackend refers to.
+	*/
+	std::string PyBackendToStr(DynExpModule::StreamManipulatorParams::ExecutionBackendType PyBackend)
+	{
+		return PyBackend == DynExpModule::StreamManipulatorParams::ExecutionBackendType::Subinterpreter ? "own subinterpreters" : "main interpreter";
+	}
+
+	/**
+	 * @brief Statistics collected by a single producer or consumer thread
+	*/
+	struct WorkerStatsType
+	{
+		size_t NumItems = 0;						//!< Number of samples or images produced or consumed
+		size_t NumLockTimeouts = 0;					//!< Number of Util::TimeoutException exceptions caught
+		LatencyRecorder Latencies;					//!< Latencies from production to consumption of the items
+		LatencyRecorder OperationLatencies;			//!< Duration of the thread's periodic operation
+		std::exception_ptr Exception;				//!< Exception which has terminated the thread
+	};
+
+	/**
+	 * @brief Runs worker functions on separate threads until Stop() is called and collects their statistics.
+	*/
+	class WorkerGroup : public Util::INonCopyable
+	{
+	public:
+		using WorkerFuncType = std::function<void(const std::atomic<bool>& StopRequested, WorkerStatsType& Stats)>;
+
+		~WorkerGroup() { Stop(); }
+
+		void Add(WorkerFuncType WorkerFunc)
+		{
+			auto& Stats = *AllStats.emplace_back(std::make_unique<WorkerStatsType>());
+
+			Threads.emplace_back([this, WorkerFunc = std::move(WorkerFunc), &Stats]() {
+				try
+				{
+					WorkerFunc(StopRequested, Stats);
+				}
+				catch (...)
+				{
+					Stats.Exception = std::current_exception();
+				}
+			});
+		}
+
+		void Stop()
+		{
+			StopRequested = true;
+
+			for (auto& Thread : Threads)
+				if (Thread.joinable())
+					Thread.join();
+		}
+
+		/**
+		 * @brief Merges the statistics of all threads. Call Stop() before.
+		 * @throws Rethrows the first exception which has terminated a thread.
+		*/
+		WorkerStatsType GetStats() const
+		{
+			WorkerStatsType Merged;
+
+			for (const auto& Stats : AllStats)
+			{
+				if (Stats->Exception)
+					std::rethrow_exception(Stats->Exception);
+
+				Merged.NumItems += Stats->NumItems;
+				Merged.NumLockTimeouts += Stats->NumLockTimeouts;
+				Merged.Latencies.Merge(Stats->Latencies);
+				Merged.OperationLatencies.Merge(Stats->OperationLatencies);
+			}
+
+			return Merged;
+		}
+
+	private:
+		std::atomic<bool> StopRequested = false;
+		std::list<std::unique_ptr<WorkerStatsType>> AllStats;
+		std::list<std::thread> Threads;
+	};
+
+	/**
+	 * @brief Measures the duration, the CPU time per thread, and the event log entries of a scenario.
+	 * Measuring begins upon construction.
+	*/
+	class ScenarioMeasurement
+	{
+	public:
+		ScenarioMeasurement()
+			: FirstLogEntry(Util::EventLog().GetLogSize()), CPUTimesBefore(GetThreadCPUTimes()), BeginTime(ClockType::now()) {}
+
+		/**
+		 * @brief Ends measuring and stores the results in @p Result.
+		 * @param Result Result to store the duration, the CPU times, and the counts of warnings and errors in.
+		*/
+		void Finish(ScenarioResultType& Result) const
+		{
+			Result.Duration = std::chrono::duration<double>(ClockType::now() - BeginTime).count();
+			Result.CPUTimes = DiffThreadCPUTimes(CPUTimesBefore, GetThreadCPUTimes());
+
+			for (const auto& Entry : Util::EventLog().GetLog(FirstLogEntry))
+				if (Entry.Type == Util::ErrorType::Warning)
+					++Result.NumLogWarnings;
+				else if (Entry.Type == Util::ErrorType::Error || Entry.Type == Util::ErrorType::Fatal)
+					++Result.NumLogErrors;
+		}
+
+	private:
+		const size_t FirstLogEntry;
+		const ThreadCPUTimesType CPUTimesBefore;
+		const ClockType::time_point BeginTime;
+	};
+
+	/**
+	 * @brief Builds a synthetic project from instruments and modules and runs them. All objects are
+	 * terminated and removed when the project is destroyed. Only one instance may exist at a time.
+	*/
+	class SyntheticProject : public Util::INonCopyable
+	{
+	public:
+		SyntheticProject(DynExp::DynExpCore& Core) : Core(Core) {}
+		~SyntheticProject()
+		{
+			try
+			{
+				Core.Reset();
+			}
+			catch (...)
+			{
+				Util::EventLog().Log("Removing the objects of a benchmark scenario failed.", Util::ErrorType::Error);
+			}
+		}
+
+		template <typename InstrumentT, typename ConfigureFuncT>
+		const InstrumentT& MakeInstrument(std::string ObjectName, ConfigureFuncT ConfigureFunc)
+		{
+			auto Instrument = MakeItem<InstrumentT>(Core.GetInstrumentManager(), Core.GetInstrumentLib(), std::move(ObjectName), ConfigureFunc);
+
+			return dynamic_cast<const InstrumentT&>(*Instrument);
+		}
+
+		template <typename ModuleT, typename ConfigureFuncT>
+		void MakeModule(std::string ObjectName, ConfigureFuncT ConfigureFunc)
+		{
+			MakeItem<ModuleT>(Core.GetModuleManager(), Core.GetModuleLib(), std::move(ObjectName), ConfigureFunc);
+		}
+
+		/**
+		 * @brief Runs all objects in the order they have been created. Waits until each object is
+		 * ready before running the next one.
+		 * @param Timeout Time to wait at most for each object to become ready
+		 * @throws Util::TimeoutException is thrown if an object does not become ready within @p Timeout.
+		 * @throws Rethrows exceptions of objects which have failed to start.
+		*/
+		void Run(const std::chrono::milliseconds Timeout = std::chrono::milliseconds(10000))
+		{
+			for (auto Object : Objects)
+			{
+				Object->Run();
+
+				const auto BeginTime = ClockType::now();
+				while (!Object->IsReady())
+				{
+					if (ClockType::now() - BeginTime > Timeout)
+						throw Util::TimeoutException(Object->GetObjectName() + " has not become ready in time.");
+
+					QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+			}
+		}
+
+	private:
+		template <typename ObjectT, typename ManagerT, typename LibraryT, typename ConfigureFuncT>
+		auto MakeItem(ManagerT& Manager, const LibraryT& Library, std::string ObjectName, ConfigureFuncT ConfigureFunc)
+		{
+			auto Params = DynExp::MakeParams<typename ObjectT::ConfigType>(Manager.GetNextID(), Core);
+			auto& TypedParams = dynamic_cast<typename ObjectT::ParamsType&>(*Params);
+			TypedParams.ObjectName = std::move(ObjectName);
+			ConfigureFunc(TypedParams);
+
+			const auto LibEntry = std::find_if(Library.cbegin(), Library.cend(), [](const auto& Entry) {
+				return std::string_view(Entry.Name) == ObjectT::Name();
+			});
+			if (LibEntry == Library.cend())
+				throw Util::NotFoundException(std::string("The benchmark library does not contain ") + ObjectT::Name() + ".");
+
+			auto Object = Manager.GetResource(Core.MakeItem(*LibEntry, std::move(Params)));
+			Objects.push_back(Object);
+
+			return Object;
+		}
+
+		DynExp::DynExpCore& Core;
+		std::vector<DynExp::RunnableObject*> Objects;		//!< Objects of this project in the order they have been created
+	};
+
+	/**
+	 * @brief Returns the time in seconds which has passed since @p Epoch. Producers stamp samples with this
+	 * time such that consumers can determine the samples' latencies.
+	*/
+	double SecondsSince(ClockType::time_point Epoch)
+	{
+		return std::chrono::duration<double>(ClockType::now() - Epoch).count();
+	}
+
+	/**
+	 * @brief Writes blocks of samples to @p Instr at the configured rate like an instrument acquiring
+	 * data would do. Each sample's time is set to the time it has been written at.
+	*/
+	void ProduceSamples(const DynExpInstr::DataStreamInstrument& Instr, const OptionsType& Options, ClockType::time_point Epoch,
+		const std::atomic<bool>& StopRequested, WorkerStatsType& Stats)
+	{
+		const auto BlockInterval = std::chrono::duration_cast<ClockType::duration>(std::chrono::duration<double>(Options.BlockSize / Options.SampleRate));
+		DynExpInstr::BasicSampleListType Samples(Options.BlockSize);
+		auto NextBlockTime = ClockType::now();
+		size_t SampleIndex = 0;
+
+		while (!StopRequested)
+		{
+			std::this_thread::sleep_until(NextBlockTime);
+			NextBlockTime += BlockInterval;
+
+			const auto BeginTime = ClockType::now();
+			const auto Time = SecondsSince(Epoch);
+			for (auto& Sample : Samples)
+				Sample = { std::sin(2 * std::numbers::pi * (SampleIndex++ % 1000) / 1000.0), Time };
+
+			try
+			{
+				{
+					auto InstrData = DynExp::dynamic_InstrumentData_cast<DynExpInstr::DataStreamInstrument>(Instr.GetInstrumentData());
+					InstrData->GetSampleStream()->WriteBasicSamples(Samples);
+				} // InstrData unlocked here.
+
+				Instr.WriteData();
+				Stats.NumItems += Samples.size();
+			}
+			catch (const Util::TimeoutException&)
+			{
+				++Stats.NumLockTimeouts;
+			}
+
+			Stats.OperationLatencies.Add(ClockType::now() - BeginTime);
+
+			// Do not try to catch up if the system is overloaded.
+			NextBlockTime = std::max(NextBlockTime, ClockType::now());
+		}
+	}
+
+	/**
+	 * @brief Reads the entire stream of @p Instr periodically and prepares the data for plotting like
+	 * DynExpModule::SignalPlotter does without rendering the plot. Records the latencies of new samples.
+	*/
+	void ConsumeSamples(const DynExpInstr::DataStreamInstrument& Instr, const OptionsType& Options, ClockType::time_point Epoch,
+		const std::atomic<bool>& StopRequested, WorkerStatsType& Stats)
+	{
+		size_t LastNumSamplesWritten = 0;
+		auto NextReadTime = ClockType::now();
+
+		while (!StopRequested)
+		{
+			std::this_thread::sleep_until(NextReadTime);
+			NextReadTime = std::max(NextReadTime + Options.ReadInterval, ClockType::now());
+
+			const auto BeginTime = ClockType::now();
+			DynExpInstr::BasicSampleListType Samples;
+			size_t NumNewSamples = 0;
+
+			try
+			{
+				Instr.ReadData();
+
+				auto InstrData = DynExp::dynamic_InstrumentData_cast<DynExpInstr::DataStreamInstrument>(Instr.GetInstrumentData());
+				auto SampleStream = InstrData->GetSampleStream();
+
+				SampleStream->SeekBeg(std::ios_base::in);
+				Samples = SampleStream->ReadBasicSamples(SampleStream->GetStreamSizeRead());
+
+				const auto NumSamplesWritten = SampleStream->GetNumSamplesWritten();
+				NumNewSamples = std::min(Samples.size(), NumSamplesWritten - std::min(NumSamplesWritten, LastNumSamplesWritten));
+				LastNumSamplesWritten = NumSamplesWritten;
+			} // InstrData unlocked here.
+			catch (const Util::TimeoutException&)
+			{
+				++Stats.NumLockTimeouts;
+				continue;
+			}
+
+			// Plot data preparation as in SignalPlotter::ProcessBasicSamples()
+			QList<QPointF> Points;
+			Points.reserve(Samples.size());
+			QPointF MinValues(std::numeric_limits<qreal>::max(), std::numeric_limits<qreal>::max());
+			QPointF MaxValues(std::numeric_limits<qreal>::lowest(), std::numeric_limits<qreal>::lowest());
+			for (const auto& Sample : Samples)
+			{
+				Points.append(QPointF(Sample.Time, Sample.Value));
+
+				MinValues.setX(std::min(MinValues.x(), Sample.Time));
+				MinValues.setY(std::min(MinValues.y(), Sample.Value));
+				MaxValues.setX(std::max(MaxValues.x(), Sample.Time));
+				MaxValues.setY(std::max(MaxValues.y(), Sample.Value));
+			}
+
+			const auto Now = SecondsSince(Epoch);
+			for (auto i = Samples.size() - NumNewSamples; i < Samples.size(); ++i)
+				Stats.Latencies.Add(Now - Samples[i].Time);
+			Stats.NumItems += NumNewSamples;
+
+			Stats.OperationLatencies.Add(ClockType::now() - BeginTime);
+		}
+	}
+
+	/**
+	 * @brief Fetches images from @p Camera at the configured frame rate like DynExpModule::ImageViewer::ImageViewer
+	 * does. Records the intervals between new images.
+	*/
+	void ConsumeImages(const DynExpInstr::Camera& Camera, const OptionsType& Options, const std::atomic<bool>& StopRequested, WorkerStatsType& Stats)
+	{
+		const auto FrameInterval = std::chrono::duration_cast<ClockType::duration>(std::chrono::duration<double>(1 / Options.FPS));
+		std::optional<ClockType::time_point> LastImageTime;
+		auto NextFetchTime = ClockType::now();
+
+		while (!StopRequested)
+		{
+			std::this_thread::sleep_until(NextFetchTime);
+			NextFetchTime = std::max(NextFetchTime + FrameInterval, ClockType::now());
+
+			const auto BeginTime = ClockType::now();
+			QImage Image;
+
+			try
+			{
+				auto InstrData = DynExp::dynamic_InstrumentData_cast<DynExpInstr::Camera>(Camera.GetInstrumentData());
+
+				if (InstrData->IsImageAvailbale())
+					Image = InstrData->GetImage();
+			} // InstrData unlocked here.
+			catch (const Util::TimeoutException&)
+			{
+				++Stats.NumLockTimeouts;
+				continue;
+			}
+
+			const auto EndTime = ClockType::now();
+			Stats.OperationLatencies.Add(EndTime - BeginTime);
+
+			if (Image.isNull())
+				continue;
+
+			if (LastImageTime)
+				Stats.Latencies.Add(EndTime - *LastImageTime);
+			LastImageTime = EndTime;
+			++Stats.NumItems;
+		}
+	}
+
+	/**
+	 * @brief Fills in the results of the producer and consumer threads and finishes the measurement.
+	*/
+	void CollectResults(ScenarioResultType& Result, const ScenarioMeasurement& Measurement, WorkerGroup& Producers, WorkerGroup& Consumers)
+	{
+		Producers.Stop();
+		Consumers.Stop();
+		Measurement.Finish(Result);
+
+		const auto ProducerStats = Producers.GetStats();
+		const auto ConsumerStats = Consumers.GetStats();
+
+		Result.NumItemsProduced = ProducerStats.NumItems;
+		Result.NumItemsConsumed = ConsumerStats.NumItems;
+		Result.Latencies = ConsumerStats.Latencies;
+		Result.OperationLatencies = ConsumerStats.OperationLatencies;
+		Result.NumLockTimeouts = ProducerStats.NumLockTimeouts + ConsumerStats.NumLockTimeouts;
+
+		if (ProducerStats.OperationLatencies.GetCount())
+		{
+			const auto Summary = ProducerStats.OperationLatencies.GetSummary();
+			Result.Details.emplace_back("Writing a block (us)", Util::ToStr(Summary.Mean) + " mean, " + Util::ToStr(Summary.P99) + " p99, " +
+				Util::ToStr(Summary.Max) + " max");
+		}
+	}
+
+	/**
+	 * @brief Processes Qt events while the producer and consumer threads are running.
+	*/
+	void WaitForMeasurement(const OptionsType& Options)
+	{
+		const auto EndTime = ClockType::now() + std::chrono::duration_cast<ClockType::duration>(std::chrono::duration<double>(Options.Duration));
+
+		while (ClockType::now() < EndTime)
+		{
+			QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+	}
+
+	/**
+	 * @brief Concurrently writes to and reads from several @p DummyDataStreamInstrument instances.
+	*/
+	ScenarioResultType RunStreamsScenario(DynExp::DynExpCore& Core, const OptionsType& Options)
+	{
+		ScenarioResultType Result;
+		Result.Name = "Data streams: " + Util::ToStr(Options.NumInstruments) + " dummy instruments at " + Util::ToStr(Options.SampleRate) +
+			" samples/s, blocks of " + Util::ToStr(Options.BlockSize) + " samples, plot preparation every " + Util::ToStr(Options.ReadInterval.count()) + " ms";
+		Result.OperationTitle = "Reading the stream and preparing the plot";
+
+		SyntheticProject Project(Core);
+		std::vector<const DynExpInstr::DummyDataStreamInstrument*> Instruments;
+		for (size_t i = 0; i < Options.NumInstruments; ++i)
+			Instruments.push_back(&Project.MakeInstrument<DynExpInstr::DummyDataStreamInstrument>("Stream " + Util::ToStr(i + 1),
+				[&Options](auto& Params) { Params.StreamSizeParams.StreamSize = static_cast<double>(Options.StreamSize); }));
+		Project.Run();
+
+		const auto Epoch = ClockType::now();
+		ScenarioMeasurement Measurement;
+		WorkerGroup Producers, Consumers;
+		for (auto Instr : Instruments)
+		{
+			Producers.Add([Instr, &Options, Epoch](const auto& StopRequested, auto& Stats) { ProduceSamples(*Instr, Options, Epoch, StopRequested, Stats); });
+			Consumers.Add([Instr, &Options, Epoch](const auto& StopRequested, auto& Stats) { ConsumeSamples(*Instr, Options, Epoch, StopRequested, Stats); });
+		}
+
+		WaitForMeasurement(Options);
+		CollectResults(Result, Measurement, Producers, Consumers);
+
+		return Result;
+	}
+
+	/**
+	 * @brief Transfers samples from a @p DummyDataStreamInstrument via %DynExp's gRPC server module to a
+	 * @p NetworkDataStreamInstrument connected to it over the loopback interface.
+	*/
+	ScenarioResultType RunGRPCScenario(DynExp::DynExpCore& Core, const OptionsType& Options)
+	{
+		ScenarioResultType Result;
+		Result.Name = "gRPC loopback: " + Util::ToStr(Options.SampleRate) + " samples/s, blocks of " + Util::ToStr(Options.BlockSize) +
+			" samples, port " + Util::ToStr(Options.Port);
+		Result.OperationTitle = "Reading the client's stream and preparing the plot";
+
+		SyntheticProject Project(Core);
+		const auto& Source = Project.MakeInstrument<DynExpInstr::DummyDataStreamInstrument>("Source",
+			[&Options](auto& Params) { Params.StreamSizeParams.StreamSize = static_cast<double>(Options.StreamSize); });
+		const auto SourceID = Source.GetID();
+		Project.MakeModule<DynExpModule::NetworkDataStreamInstrument>("Server", [&Options, SourceID](auto& Params) {
+			Params.DataStreamInstrument = SourceID;
+			Params.NetworkParams.ServerName = std::string("127.0.0.1");
+			Params.NetworkParams.Port = Options.Port;
+		});
+		const auto& Client = Project.MakeInstrument<DynExpInstr::NetworkDataStreamInstrument>("Client", [&Options](auto& Params) {
+			Params.NetworkParams.ServerName = std::string("127.0.0.1");
+			Params.NetworkParams.Port = Options.Port;
+		});
+
+		// Objects are started in the order of their creation. So, the server runs before the client connects to it.
+		Project.Run();
+
+		const auto Epoch = ClockType::now();
+		ScenarioMeasurement Measurement;
+		WorkerGroup Producers, Consumers;
+		Producers.Add([&Source, &Options, Epoch](const auto& StopRequested, auto& Stats) { ProduceSamples(Source, Options, Epoch, StopRequested, Stats); });
+		Consumers.Add([&Client, &Options, Epoch](const auto& StopRequested, auto& Stats) { ConsumeSamples(Client, Options, Epoch, StopRequested, Stats); });
+
+		WaitForMeasurement(Options);
+		CollectResults(Result, Measurement, Producers, Consumers);
+
+		return Result;
+	}
+
+	/**
+	 * @brief Passes samples from one @p DummyDataStreamInstrument to another one through a
+	 * @p StreamManipulator module running a pass-through Python script.
+	*/
+	ScenarioResultType RunManipulatorScenario(DynExp::DynExpCore& Core, const OptionsType& Options, const std::filesystem::path& TempDir)
+	{
+		ScenarioResultType Result;
+		Result.Name = "Stream manipulator (Python pass-through) in " + PyBackendToStr(Options.PyBackend) + ": " +
+			Util::ToStr(Options.SampleRate) + " samples/s, blocks of " + Util::ToStr(Options.BlockSize) + " samples";
+		Result.OperationTitle = "Reading the output stream and preparing the plot";
+
+		const auto ScriptPath = TempDir / "passthrough.py";
+		if (!Util::SaveToFile(QString::fromStdString(ScriptPath.string()),
+			"import datetime\n"
+			"\n"
+			"def on_step(input):\n"
+			"    result = StreamManipulator.OutputData()\n"
+			"    result.MaxNextExecutionDelay = datetime.timedelta(milliseconds=100)\n"
+			"    result.MinNextExecutionDelay = datetime.timedelta(milliseconds=0)\n"
+			"\n"
+			"    samples = input.InputStreams[0].Samples\n"
+			"    input.OutputStreams[0].Samples.extend(samples)\n"
+			"    result.LastConsumedSampleIDsPerInputStream.append(input.InputStreams[0].CalcLastConsumedSampleID(len(samples)))\n"
+			"\n"
+			"    return result\n"))
+			throw Util::FileIOErrorException(ScriptPath.string());
+
+		SyntheticProject Project(Core);
+		const auto MakeStream = [&Options](auto& Params) { Params.StreamSizeParams.StreamSize = static_cast<double>(Options.StreamSize); };
+		const auto& Input = Project.MakeInstrument<DynExpInstr::DummyDataStreamInstrument>("Input", MakeStream);
+		const auto& Output = Project.MakeInstrument<DynExpInstr::DummyDataStreamInstrument>("Output", MakeStream);
+		Project.MakeModule<DynExpModule::StreamManipulator>("Pass-through", [&Input, &Output, &ScriptPath](auto& Params) {
+			Params.InputDataStreams = DynExp::ItemIDListType{ Input.GetID() };
+			Params.OutputDataStreams = DynExp::ItemIDListType{ Output.GetID() };
+			Params.PythonCodePath = ScriptPath.string();
+			Params.ExecutionBackend = Options.PyBackend;
+		});
+		Project.Run();
+
+		const auto Epoch = ClockType::now();
+		ScenarioMeasurement Measurement;
+		WorkerGroup Producers, Consumers;
+		Producers.Add([&Input, &Options, Epoch](const auto& StopRequested, auto& Stats) { ProduceSamples(Input, Options, Epoch, StopRequested, Stats); });
+		Consumers.Add([&Output, &Options, Epoch](const auto& StopRequested, auto& Stats) { ConsumeSamples(Output, Options, Epoch, StopRequested, Stats); });
+
+		WaitForMeasurement(Options);
+		CollectResults(Result, Measurement, Producers, Consumers);
+
+		return Result;
+	}
+
+	/**
+	 * @brief Runs several modules concurrently, each multiplying the samples of two @p DummyDataStreamInstrument
+	 * instances. If @p Native is false, @p StreamManipulator modules run a script equivalent to examples/stream_multiply.py.
+	 * Then, the Python execution backends are compared when started once with each value of option --py-backend.
+	 * If @p Native is true, @p StreamOperator modules multiply the samples without Python.
+	*/
+	ScenarioResultType RunMultiplyScenario(DynExp::DynExpCore& Core, const OptionsType& Options, const std::filesystem::path& TempDir, bool Native)
+	{
+		ScenarioResultType Result;
+		Result.Name = Native ? "Stream operators (native multiplication): " + Util::ToStr(Options.NumManipulators) + " modules" :
+			"Stream manipulators (Python multiplication): " + Util::ToStr(Options.NumManipulators) + " modules in " + PyBackendToStr(Options.PyBackend);
+		Result.Name += ", " + Util::ToStr(Options.SampleRate) + " samples/s, blocks of " + Util::ToStr(Options.BlockSize) + " samples";
+		Result.OperationTitle = "Reading the output stream and preparing the plot";
+
+		// Same as examples/stream_multiply.py, but without artificial delays between the steps.
+		const auto ScriptPath = TempDir / "multiply.py";
+		if (!Util::SaveToFile(QString::fromStdString(ScriptPath.string()),
+			"import datetime\n"
+			"\n"
+			"def on_step(input):\n"
+			"    result = StreamManipulator.OutputData()\n"
+			"    result.MaxNextExecutionDelay = datetime.timedelta(milliseconds=100)\n"
+			"    result.MinNextExecutionDelay = datetime.timedelta(milliseconds=0)\n"
+			"\n"
+			"    NumSamples = min(len(input.InputStreams[0].Samples), len(input.InputStreams[1].Samples))\n"
+			"    for i in range(0, NumSamples):\n"
+			"        input.OutputStreams[0].Samples.append(DataStreamInstrument.BasicSample(\\\n"
+			"            input.InputStreams[0].Samples[i].Value * input.InputStreams[1].Samples[i].Value,\\\n"
+			"            input.InputStreams[0].Samples[i].Time))\n"
+			"\n"
+			"    result.LastConsumedSampleIDsPerInputStream.append(input.InputStreams[0].CalcLastConsumedSampleID(NumSamples))\n"
+			"    result.LastConsumedSampleIDsPerInputStream.append(input.InputStreams[1].CalcLastConsumedSampleID(NumSamples))\n"
+			"\n"
+			"    return result\n"))
+			throw Util::FileIOErrorException(ScriptPath.string());
+
+		SyntheticProject Project(Core);
+		const auto MakeStream = [&Options](auto& Params) { Params.StreamSizeParams.StreamSize = static_cast<double>(Options.StreamSize); };
+		std::vector<const DynExpInstr::DummyDataStreamInstrument*> Inputs, Outputs;
+		for (size_t i = 0; i < Options.NumManipulators; ++i)
+		{
+			const auto Suffix = " " + Util::ToStr(i + 1);
+			const auto& InputA = Project.MakeInstrument<DynExpInstr::DummyDataStreamInstrument>("Input A" + Suffix, MakeStream);
+			const auto& InputB = Project.MakeInstrument<DynExpInstr::DummyDataStreamInstrument>("Input B" + Suffix, MakeStream);
+			const auto& Output = Project.MakeInstrument<DynExpInstr::DummyDataStreamInstrument>("Output" + Suffix, MakeStream);
+			if (Native)
+				Project.MakeModule<DynExpModule::StreamOperator>("Multiplier" + Suffix, [&InputA, &InputB, &Output](auto& Params) {
+					Params.InputDataStreams = DynExp::ItemIDListType{ InputA.GetID(), InputB.GetID() };
+					Params.OutputDataStreams = DynExp::ItemIDListType{ Output.GetID() };
+					Params.CombineMode = DynExpModule::StreamOperatorParams::CombineModeType::Product;
+				});
+			else
+				Project.MakeModule<DynExpModule::StreamManipulator>("Multiplier" + Suffix, [&InputA, &InputB, &Output, &ScriptPath, &Options](auto& Params) {
+					Params.InputDataStreams = DynExp::ItemIDListType{ InputA.GetID(), InputB.GetID() };
+					Params.OutputDataStreams = DynExp::ItemIDListType{ Output.GetID() };
+					Params.PythonCodePath = ScriptPath.string();
+					Params.ExecutionBackend = Options.PyBackend;
+				});
+
+			Inputs.push_back(&InputA);
+			Inputs.push_back(&InputB);
+			Outputs.push_back(&Output);
+		}
+		Project.Run();
+
+		const auto Epoch = ClockType::now();
+		ScenarioMeasurement Measurement;
+		WorkerGroup Producers, Consumers;
+		for (auto Instr : Inputs)
+			Producers.Add([Instr, &Options, Epoch](const auto& StopRequested, auto& Stats) { ProduceSamples(*Instr, Options, Epoch, StopRequested, Stats); });
+		for (auto Instr : Outputs)
+			Consumers.Add([Instr, &Options, Epoch](const auto& StopRequested, auto& Stats) { ConsumeSamples(*Instr, Options, Epoch, StopRequested, Stats); });
+
+		WaitForMeasurement(Options);
+		CollectResults(Result, Measurement, Producers, Consumers);
+
+		return Result;
+	}
+
+	/**
+	 * @brief Fetches synthetic images from several @p DummyCamera instances.
+	*/
+	ScenarioResultType RunCameraScenario(DynExp::DynExpCore& Core, const OptionsType& Options, const std::filesystem::path& TempDir)
+	{
+		ScenarioResultType Result;
+		Result.Name = "Cameras: " + Util::ToStr(Options.NumCameras) + " dummy cameras, " + Util::ToStr(Options.ImageWidth) + "x" +
+			Util::ToStr(Options.ImageHeight) + " pixels, fetched at " + Util::ToStr(Options.FPS) + " fps";
+		Result.ItemUnit = "images";
+		Result.LatencyTitle = "Interval between new images";
+		Result.OperationTitle = "Fetching an image";
+
+		// Synthetic image with a gradient and some noise such that it does not compress too well.
+		QImage Image(Options.ImageWidth, Options.ImageHeight, QImage::Format_Grayscale8);
+		std::mt19937 RandomEngine(0);
+		std::uniform_int_distribution<int> Noise(0, 31);
+		for (int y = 0; y < Image.height(); ++y)
+		{
+			auto Line = Image.scanLine(y);
+			for (int x = 0; x < Image.width(); ++x)
+				Line[x] = static_cast<uchar>((x + y) % 224 + Noise(RandomEngine));
+		}
+
+		const auto ImagePath = QString::fromStdString((TempDir / "image.png").string());
+		if (!Image.save(ImagePath))
+			throw Util::FileIOErrorException(ImagePath.toStdString());
+
+		SyntheticProject Project(Core);
+		std::vector<const DynExpInstr::DummyCamera*> Cameras;
+		for (size_t i = 0; i < Options.NumCameras; ++i)
+			Cameras.push_back(&Project.MakeInstrument<DynExpInstr::DummyCamera>("Camera " + Util::ToStr(i + 1),
+				[&ImagePath](auto& Params) { Params.ImagePath = ImagePath.toStdString(); }));
+		Project.Run();
+
+		ScenarioMeasurement Measurement;
+		WorkerGroup Producers, Consumers;
+		for (auto Camera : Cameras)
+			Consumers.Add([Camera, &Options](const auto& StopRequested, auto& Stats) { ConsumeImages(*Camera, Options, StopRequested, Stats); });
+
+		WaitForMeasurement(Options);
+		CollectResults(Result, Measurement, Producers, Consumers);
+
+		std::string FPS;
+		for (auto Camera : Cameras)
+		{
+			auto InstrData = DynExp::dynamic_InstrumentData_cast<DynExpInstr::Camera>(Camera->GetInstrumentData());
+			FPS += (FPS.empty() ? "" : ", ") + Util::ToStr(InstrData->GetCurrentFPS());
+		}
+		Result.Details.emplace_back("Frame rate reported by the cameras (fps)", FPS);
+
+		return Result;
+	}
+
+	/**
+	 * @brief Times Util::RealFFT() and Util::WelchPSD() for typical transform lengths.
+	*/
+	ScenarioResultType RunFFTScenario(const OptionsType& Options)
+	{
+		ScenarioResultType Result;
+		Result.Name = "FFT: " + Util::ToStr(Options.NumRepetitions) + " repetitions per transform length";
+		Result.OperationTitle = "Welch PSD of 2^20 samples (segments of 4096 samples)";
+
+		std::mt19937 RandomEngine(0);
+		std::normal_distribution<double> Noise;
+		std::vector<double> Data(size_t(1) << 20);
+		for (auto& Value : Data)
+			Value = Noise(RandomEngine);
+
+		ScenarioMeasurement Measurement;
+
+		for (const size_t Length : { size_t(1024), size_t(4096), size_t(65536), size_t(1) << 20 })
+		{
+			const std::vector<double> Segment(Data.cbegin(), Data.cbegin() + Length);
+			LatencyRecorder Durations;
+
+			// The first transform of each length creates the FFT plan. Exclude it from the measurement.
+			Util::RealFFT(Segment);
+
+			for (size_t i = 0; i < Options.NumRepetitions; ++i)
+			{
+				auto Input = Segment;
+				const auto BeginTime = ClockType::now();
+				Util::RealFFT(std::move(Input));
+				Durations.Add(ClockType::now() - BeginTime);
+			}
+
+			const auto Summary = Durations.GetSummary();
+			Result.Details.emplace_back("RealFFT of " + Util::ToStr(Length) + " samples (us)", Util::ToStr(Summary.Mean) + " mean, " +
+				Util::ToStr(Summary.P99) + " p99");
+		}
+
+		for (size_t i = 0; i < std::max(size_t(1), Options.NumRepetitions / 10); ++i)
+		{
+			const auto BeginTime = ClockType::now();
+			Util::WelchPSD(Data, 1e6, 4096);
+			Result.OperationLatencies.Add(ClockType::now() - BeginTime);
+		}
+
+		Measurement.Finish(Result);
+
+		return Result;
+	}
+
+	/**
+	 * @brief Replays DynExpModule::Widefield::ConfocalPSFOptimizer on a synthetic Gaussian point spread
+	 * function with Poisson-distributed count rates starting from random points around the emitter.
+	*/
+	ScenarioResultType RunPSFFitScenario(const OptionsType& Options)
+	{
+		using OptimizerType = DynExpModule::Widefield::ConfocalPSFOptimizer;
+
+		constexpr OptimizerType::PointType Emitter{ 0, 0, 0 };
+		constexpr OptimizerType::PointType PSFWidth{ 150, 150, 0.5 };		// Standard deviation (x, y in nm, z in V)
+		constexpr OptimizerType::PointType InitialStepSize{ 100, 100, 0.2 };
+		constexpr OptimizerType::PointType MaxInitialOffset{ 200, 200, 0.4 };
+		constexpr double PeakCountRate = 2e5;
+		constexpr double BackgroundCountRate = 5e3;
+		constexpr double IntegrationTime = 10e-3;							// in s
+		constexpr double Tolerance = 10;
+
+		ScenarioResultType Result;
+		Result.Name = "Confocal PSF fit replay: " + Util::ToStr(Options.NumRepetitions) + " optimizations";
+		Result.ItemUnit = "measurements";
+		Result.OperationTitle = "Fitting per reported count rate";
+
+		std::mt19937 RandomEngine(0);
+		std::uniform_real_distribution<double> Offset(-1, 1);
+		const auto MeasureCountRate = [&](const OptimizerType::PointType& Point) {
+			double Exponent = 0;
+			for (size_t i = 0; i < Point.size(); ++i)
+				Exponent += (Point[i] - Emitter[i]) * (Point[i] - Emitter[i]) / (2 * PSFWidth[i] * PSFWidth[i]);
+
+			std::poisson_distribution<long long> Counts(IntegrationTime * (BackgroundCountRate + PeakCountRate * std::exp(-Exponent)));
+			return Counts(RandomEngine) / IntegrationTime;
+		};
+
+		ScenarioMeasurement Measurement;
+		OptimizerType Optimizer;
+		size_t NumConverged = 0, NumBatches = 0;
+		LatencyRecorder XYErrors, ZErrors;
+
+		for (size_t i = 0; i < Options.NumRepetitions; ++i)
+		{
+			OptimizerType::PointType Start;
+			for (size_t j = 0; j < Start.size(); ++j)
+				Start[j] = Emitter[j] + MaxInitialOffset[j] * Offset(RandomEngine);
+			Optimizer.Init(Start, InitialStepSize, Tolerance);
+
+			OptimizerType::ResultType OptimizerResult;
+			do
+			{
+				const auto CountRate = MeasureCountRate(Optimizer.GetNextPoint());
+
+				const auto BeginTime = ClockType::now();
+				OptimizerResult = Optimizer.ReportCountRate(CountRate);
+				Result.OperationLatencies.Add(ClockType::now() - BeginTime);
+			} while (OptimizerResult == OptimizerType::ResultType::NextPoint);
+
+			NumConverged += OptimizerResult == OptimizerType::ResultType::Finished;
+			NumBatches += Optimizer.GetNumBatches();
+			Result.NumItemsConsumed += Optimizer.GetNumMeasurements();
+
+			// Record the errors as if they were durations (nm and mV, respectively) to obtain their percentiles.
+			const auto& Center = OptimizerResult == OptimizerType::ResultType::Finished ? Optimizer.GetCenter() : Optimizer.GetBestMeasurement().Point;
+			XYErrors.Add(std::chrono::nanoseconds(std::llround(std::hypot(Center[0] - Emitter[0], Center[1] - Emitter[1]))));
+			ZErrors.Add(std::chrono::nanoseconds(std::llround(1e3 * std::abs(Center[2] - Emitter[2]))));
+		}
+
+		Measurement.Finish(Result);
+		Result.NumItemsProduced = Result.NumItemsConsumed;
+
+		const auto Repetitions = static_cast<double>(std::max(size_t(1), Options.NumRepetitions));
+		const auto XYSummary = XYErrors.GetSummary();
+		const auto ZSummary = ZErrors.GetSummary();
+		Result.Details.emplace_back("Converged", Util::ToStr(NumConverged) + " of " + Util::ToStr(Options.NumRepetitions));
+		Result.Details.emplace_back("Measurements per optimization", Util::ToStr(Result.NumItemsConsumed / Repetitions));
+		Result.Details.emplace_back("Batches per optimization", Util::ToStr(NumBatches / Repetitions));
+		Result.Details.emplace_back("Lateral error (nm)", Util::ToStr(XYSummary.Mean * 1e3) + " mean, " + Util::ToStr(XYSummary.P90 * 1e3) + " p90");
+		Result.Details.emplace_back("Focus error (mV)", Util::ToStr(ZSummary.Mean * 1e3) + " mean, " + Util::ToStr(ZSummary.P90 * 1e3) + " p90");
+
+		return Result;
+	}
+
+	/**
+	 * @brief Confocal scan recorded by DynExpModule::Widefield::WidefieldMicroscope and saved as CSV or
+	 * binary data file (refer to WidefieldMicroscopeData::MakeConfocalScanResultsWriter()). Provides the
+	 * count rate at arbitrary lateral positions by bilinear interpolation in between the scan's pixels.
+	*/
+	class RecordedConfocalScan
+	{
+	public:
+		/**
+		 * @brief Reads a confocal scan from file.
+		 * @param Filename Path to the file. Files ending with the binary format's extension are read as
+		 * binary data files, all other files as CSV files.
+		 * @throws Util::FileIOErrorException is thrown if the file cannot be read.
+		 * @throws Util::InvalidDataException is thrown if the file does not contain a confocal scan
+		 * spanning at least two pixels in both directions.
+		*/
+		RecordedConfocalScan(const QString& Filename);
+
+		/**
+		 * @brief Determines the count rate at a lateral position. Positions outside the scanned area are
+		 * clamped to its border.
+		 * @param X x coordinate in nm
+		 * @param Y y coordinate in nm
+		 * @return Count rate in Hz
+		*/
+		double GetCountRate(double X, double Y) const;
+
+		/**
+		 * @brief Returns the position of the brightest pixel after smoothing the scan, which is used as
+		 * the reference position of the emitter.
+		*/
+		std::pair<double, double> GetBrightestPosition() const;
+
+		double GetBackgroundCountRate() const noexcept { return BackgroundCountRate; }	//!< Getter for #BackgroundCountRate
+		size_t GetNumPixels() const noexcept { return CountRates.size(); }				//!< Returns the number of pixels of the scan grid.
+
+	private:
+		double& At(size_t IndexX, size_t IndexY) { return CountRates[IndexY * Xs.size() + IndexX]; }
+		double At(size_t IndexX, size_t IndexY) const { return CountRates[IndexY * Xs.size() + IndexX]; }
+
+		std::vector<double> Xs;							//!< Sorted distinct x coordinates of the scan grid in nm
+		std::vector<double> Ys;							//!< Sorted distinct y coordinates of the scan grid in nm
+		std::vector<double> CountRates;					//!< Count rates of the pixels in row-major order in Hz
+		double BackgroundCountRate = 0;					//!< Minimal count rate, assigned to pixels missing in the file
+	};
+
+	RecordedConfocalScan::RecordedConfocalScan(const QString& Filename)
+	{
+		const auto Format = Util::DataFileWriter::GetFormatFromFilename(Filename);
+		std::ifstream File(Filename.toStdString(), Format == Util::DataFileWriter::FormatType::Binary ? std::ios::in | std::ios::binary : std::ios::in);
+		if (!File)
+			throw Util::FileIOErrorException(Filename.toStdString());
+
+		// The column names are the last line of the header.
+		std::string ColumnNamesLine;
+		size_t NumColumns = 0;
+		if (Format == Util::DataFileWriter::FormatType::Binary)
+		{
+			std::string Magic(Util::DataFileWriter::BinaryMagic.size(), '\0');
+			uint32_t HeaderLength = 0;
+			if (!File.read(Magic.data(), Magic.size()) || Magic != Util::DataFileWriter::BinaryMagic ||
+				!File.read(reinterpret_cast<char*>(&HeaderLength), sizeof(HeaderLength)))
+				throw Util::InvalidDataException("\"" + Filename.toStdString() + "\" is not a DynExp binary data file.");
+
+			std::string Header(HeaderLength, '\0');
+			uint32_t NumBinaryColumns = 0;
+			if (!File.read(Header.data(), Header.size()) || !File.read(reinterpret_cast<char*>(&NumBinaryColumns), sizeof(NumBinaryColumns)))
+				throw Util::InvalidDataException("The header of \"" + Filename.toStdString() + "\" is incomplete.");
+
+			Header = Header.substr(0, Header.find_last_not_of('\n') + 1);
+			ColumnNamesLine = Header.substr(Header.find_last_of('\n') + 1);
+			NumColumns = NumBinaryColumns;
+		}
+		else
+		{
+			std::string Line;
+			while (std::getline(File, Line) && Line != "HEADER_END");
+			if (!std::getline(File, ColumnNamesLine))
+				throw Util::InvalidDataException("\"" + Filename.toStdString() + "\" does not contain a header.");
+		}
+
+		std::vector<std::string> ColumnNames;
+		for (std::string_view Remaining = ColumnNamesLine; !Remaining.empty(); )
+		{
+			const auto End = std::min(Remaining.find(Util::DataFileWriter::CSVSeparator), Remaining.size());
+			ColumnNames.emplace_back(Remaining.substr(0, End));
+			Remaining.remove_prefix(std::min(End + 1, Remaining.size()));
+		}
+		if (Format == Util::DataFileWriter::FormatType::CSV)
+			NumColumns = ColumnNames.size();
+
+		const auto FindColumn = [&ColumnNames, &Filename](std::string_view Name) {
+			const auto Column = std::find(ColumnNames.cbegin(), ColumnNames.cend(), Name);
+			if (Column == ColumnNames.cend())
+				throw Util::InvalidDataException("\"" + Filename.toStdString() + "\" does not contain a column \"" + std::string(Name) + "\".");
+
+			return static_cast<size_t>(Column - ColumnNames.cbegin());
+		};
+		const auto ColumnX = FindColumn("X_destiny(nm)");
+		const auto ColumnY = FindColumn("Y_destiny(nm)");
+		const auto ColumnC = FindColumn("C(Hz)");
+		if (ColumnNames.size() != NumColumns)
+			throw Util::InvalidDataException("The column names of \"" + Filename.toStdString() + "\" do not match the amount of columns.");
+
+		// Pixels as (x, y, count rate)
+		std::vector<std::array<double, 3>> Pixels;
+		std::vector<double> Row(NumColumns);
+		const auto AddPixel = [&]() { Pixels.push_back({ Row[ColumnX], Row[ColumnY], Row[ColumnC] }); };
+		if (Format == Util::DataFileWriter::FormatType::Binary)
+			while (File.read(reinterpret_cast<char*>(Row.data()), Row.size() * sizeof(double)))
+				AddPixel();
+		else
+			for (std::string Line; std::getline(File, Line); )
+			{
+				if (!Line.empty() && Line.back() == '\r')
+					Line.pop_back();
+				if (Line.empty())
+					continue;
+
+				const char* Begin = Line.data();
+				const char* const End = Line.data() + Line.size();
+				for (size_t i = 0; i < NumColumns; ++i)
+				{
+					const auto Result = std::from_chars(Begin, End, Row[i]);
+					if (Result.ec != std::errc() || (Result.ptr != End && *Result.ptr != Util::DataFileWriter::CSVSeparator))
+						throw Util::InvalidDataException("\"" + Filename.toStdString() + "\" contains an invalid row.");
+
+					Begin = Result.ptr + (Result.ptr != End);
+				}
+
+				AddPixel();
+			}
+
+		for (const auto& Pixel : Pixels)
+		{
+			Xs.push_back(Pixel[0]);
+			Ys.push_back(Pixel[1]);
+		}
+		for (auto* Coords : { &Xs, &Ys })
+		{
+			std::sort(Coords->begin(), Coords->end());
+			Coords->erase(std::unique(Coords->begin(), Coords->end()), Coords->end());
+		}
+		if (Xs.size() < 2 || Ys.size() < 2)
+			throw Util::InvalidDataException("The confocal scan in \"" + Filename.toStdString() + "\" has to span at least 2 x 2 pixels.");
+
+		BackgroundCountRate = std::min_element(Pixels.cbegin(), Pixels.cend(), [](const auto& a, const auto& b) { return a[2] < b[2]; })->at(2);
+		CountRates.resize(Xs.size() * Ys.size(), BackgroundCountRate);
+		for (const auto& Pixel : Pixels)
+			At(std::lower_bound(Xs.cbegin(), Xs.cend(), Pixel[0]) - Xs.cbegin(), std::lower_bound(Ys.cbegin(), Ys.cend(), Pixel[1]) - Ys.cbegin()) = Pixel[2];
+	}
+
+	double RecordedConfocalScan::GetCountRate(double X, double Y) const
+	{
+		// Returns the index of the grid line preceding Value and the relative distance to it (clamped to [0, 1]).
+		const auto Locate = [](const std::vector<double>& Coords, double Value) {
+			const auto Index = static_cast<size_t>(std::clamp<std::ptrdiff_t>(
+				std::upper_bound(Coords.cbegin(), Coords.cend(), Value) - Coords.cbegin() - 1, 0, Coords.size() - 2));
+
+			return std::make_pair(Index, std::clamp((Value - Coords[Index]) / (Coords[Index + 1] - Coords[Index]), 0.0, 1.0));
+		};
+
+		const auto [IndexX, FractionX] = Locate(Xs, X);
+		const auto [IndexY, FractionY] = Locate(Ys, Y);
+
+		return (1 - FractionY) * ((1 - FractionX) * At(IndexX, IndexY) + FractionX * At(IndexX + 1, IndexY)) +
+			FractionY * ((1 - FractionX) * At(IndexX, IndexY + 1) + FractionX * At(IndexX + 1, IndexY + 1));
+	}
+
+	std::pair<double, double> RecordedConfocalScan::GetBrightestPosition() const
+	{
+		double MaxCountRate = -std::numeric_limits<double>::infinity();
+		std::pair<double, double> Position;
+
+		for (size_t IndexY = 0; IndexY < Ys.size(); ++IndexY)
+			for (size_t IndexX = 0; IndexX < Xs.size(); ++IndexX)
+			{
+				// Smoothes with a 3x3 binomial kernel. Neighbors missing at the scan's border count as background.
+				double CountRate = 0;
+				for (int j = -1; j <= 1; ++j)
+					for (int i = -1; i <= 1; ++i)
+					{
+						const auto NeighborX = static_cast<std::ptrdiff_t>(IndexX) + i;
+						const auto NeighborY = static_cast<std::ptrdiff_t>(IndexY) + j;
+						const bool IsInside = NeighborX >= 0 && NeighborX < std::ssize(Xs) && NeighborY >= 0 && NeighborY < std::ssize(Ys);
+
+						CountRate += (2 - std::abs(i)) * (2 - std::abs(j)) * (IsInside ? At(NeighborX, NeighborY) : BackgroundCountRate);
+					}
+
+				if (CountRate > MaxCountRate)
+				{
+					MaxCountRate = CountRate;
+					Position = { Xs[IndexX], Ys[IndexY] };
+				}
+			}
+
+		return Position;
+	}
+
+	/**
+	 * @brief Replays a confocal scan recorded from file through DynExpModule::Widefield::ConfocalPSFOptimizer
+	 * and through GSL's Nelder-Mead simplex minimizer as used by DynExpModule::Widefield::WidefieldMicroscope.
+	 * Both optimizers start from the same random points around the scan's brightest position. The recorded
+	 * scan is two-dimensional. So, the focus dependence is modeled as a Gaussian attenuation of the count rate
+	 * above the background.
+	*/
+	ScenarioResultType RunPSFScanReplayScenario(const OptionsType& Options)
+	{
+		using OptimizerType = DynExpModule::Widefield::ConfocalPSFOptimizer;
+
+		constexpr double FocusWidth = 0.5;									// Standard deviation in V
+		constexpr OptimizerType::PointType InitialStepSize{ 100, 100, 0.2 };
+		constexpr OptimizerType::PointType MaxInitialOffset{ 200, 200, 0.4 };
+		constexpr double Tolerance = 10;
+		constexpr size_t MaxNumNelderMeadIterations = 100;					// Refer to WidefieldMicroscope::ConfocalOptimizationStepStateFunc().
+
+		const RecordedConfocalScan Scan(Options.PSFScanFilename);
+		const auto [EmitterX, EmitterY] = Scan.GetBrightestPosition();
+		const auto MeasureCountRate = [&Scan](double X, double Y, double Z) {
+			return Scan.GetBackgroundCountRate() + (Scan.GetCountRate(X, Y) - Scan.GetBackgroundCountRate()) * std::exp(-Z * Z / (2 * FocusWidth * FocusWidth));
+		};
+
+		ScenarioResultType Result;
+		Result.Name = "Confocal PSF fit vs. Nelder-Mead replaying " + Options.PSFScanFilename.toStdString() + " (" +
+			Util::ToStr(Scan.GetNumPixels()) + " pixels): " + Util::ToStr(Options.NumRepetitions) + " optimizations each";
+		Result.ItemUnit = "measurements";
+		Result.OperationTitle = "Time per optimization";
+
+		// Statistics of one of the optimizers
+		struct OptimizerStatsType
+		{
+			size_t NumConverged = 0;
+			size_t NumMeasurements = 0;
+			size_t NumIterations = 0;
+			LatencyRecorder Durations;
+			LatencyRecorder XYErrors;
+			LatencyRecorder ZErrors;
+
+			void Add(const OptimizerType::PointType& Center, double EmitterX, double EmitterY)
+			{
+				// Record the errors as if they were durations (nm and mV, respectively) to obtain their percentiles.
+				XYErrors.Add(std::chrono::nanoseconds(std::llround(std::hypot(Center[0] - EmitterX, Center[1] - EmitterY))));
+				ZErrors.Add(std::chrono::nanoseconds(std::llround(1e3 * std::abs(Center[2]))));
+			}
+		} PSFFitStats, NelderMeadStats;
+
+		std::unique_ptr<gsl_multimin_fminimizer, decltype(&gsl_multimin_fminimizer_free)> NelderMeadState(
+			gsl_multimin_fminimizer_alloc(gsl_multimin_fminimizer_nmsimplex2, OptimizerType::NumDimensions), &gsl_multimin_fminimizer_free);
+		std::unique_ptr<gsl_vector, decltype(&gsl_vector_free)> NelderMeadStart(gsl_vector_alloc(OptimizerType::NumDimensions), &gsl_vector_free);
+		std::unique_ptr<gsl_vector, decltype(&gsl_vector_free)> NelderMeadStepSize(gsl_vector_alloc(OptimizerType::NumDimensions), &gsl_vector_free);
+		if (!NelderMeadState || !NelderMeadStart || !NelderMeadStepSize)
+			throw std::bad_alloc();
+		for (size_t j = 0; j < InitialStepSize.size(); ++j)
+			gsl_vector_set(NelderMeadStepSize.get(), j, InitialStepSize[j]);
+
+		// Negative count rate to find the maximum instead of the minimum.
+		std::pair<decltype(MeasureCountRate)*, size_t> NelderMeadFuncParams{ &MeasureCountRate, 0 };
+		gsl_multimin_function NelderMeadFunc{ [](const gsl_vector* Point, void* Params) {
+			auto& [Measure, NumMeasurements] = *static_cast<decltype(NelderMeadFuncParams)*>(Params);
+			++NumMeasurements;
+
+			return -(*Measure)(gsl_vector_get(Point, 0), gsl_vector_get(Point, 1), gsl_vector_get(Point, 2));
+		}, OptimizerType::NumDimensions, &NelderMeadFuncParams };
+
+		std::mt19937 RandomEngine(0);
+		std::uniform_real_distribution<double> Offset(-1, 1);
+		ScenarioMeasurement Measurement;
+		OptimizerType Optimizer;
+
+		for (size_t i = 0; i < Options.NumRepetitions; ++i)
+		{
+			const OptimizerType::PointType Start{ EmitterX + MaxInitialOffset[0] * Offset(RandomEngine),
+				EmitterY + MaxInitialOffset[1] * Offset(RandomEngine), MaxInitialOffset[2] * Offset(RandomEngine) };
+
+			{
+				const auto BeginTime = ClockType::now();
+
+				Optimizer.Init(Start, InitialStepSize, Tolerance);
+				OptimizerType::ResultType OptimizerResult;
+				do
+				{
+					const auto& Point = Optimizer.GetNextPoint();
+					OptimizerResult = Optimizer.ReportCountRate(MeasureCountRate(Point[0], Point[1], Point[2]));
+				} while (OptimizerResult == OptimizerType::ResultType::NextPoint);
+
+				PSFFitStats.Durations.Add(ClockType::now() - BeginTime);
+				PSFFitStats.NumConverged += OptimizerResult == OptimizerType::ResultType::Finished;
+				PSFFitStats.NumMeasurements += Optimizer.GetNumMeasurements();
+				PSFFitStats.NumIterations += Optimizer.GetNumBatches();
+				PSFFitStats.Add(OptimizerResult == OptimizerType::ResultType::Finished ? Optimizer.GetCenter() : Optimizer.GetBestMeasurement().Point,
+					EmitterX, EmitterY);
+			}
+
+			{
+				const auto BeginTime = ClockType::now();
+
+				for (size_t j = 0; j < Start.size(); ++j)
+					gsl_vector_set(NelderMeadStart.get(), j, Start[j]);
+				NelderMeadFuncParams.second = 0;
+
+				auto Status = gsl_multimin_fminimizer_set(NelderMeadState.get(), &NelderMeadFunc, NelderMeadStart.get(), NelderMeadStepSize.get());
+				size_t NumIterations = 0;
+				while (Status == GSL_SUCCESS && NumIterations < MaxNumNelderMeadIterations)
+				{
+					++NumIterations;
+					Status = gsl_multimin_fminimizer_iterate(NelderMeadState.get());
+					if (Status != GSL_SUCCESS)
+						break;
+
+					Status = gsl_multimin_test_size(gsl_multimin_fminimizer_size(NelderMeadState.get()), Tolerance);
+					if (Status == GSL_SUCCESS)
+						++NelderMeadStats.NumConverged;
+					if (Status != GSL_CONTINUE)
+						break;
+
+					Status = GSL_SUCCESS;
+				}
+
+				NelderMeadStats.Durations.Add(ClockType::now() - BeginTime);
+				NelderMeadStats.NumMeasurements += NelderMeadFuncParams.second;
+				NelderMeadStats.NumIterations += NumIterations;
+
+				const auto Center = gsl_multimin_fminimizer_x(NelderMeadState.get());
+				NelderMeadStats.Add({ gsl_vector_get(Center, 0), gsl_vector_get(Center, 1), gsl_vector_get(Center, 2) }, EmitterX, EmitterY);
+			}
+		}
+
+		Measurement.Finish(Result);
+		Result.NumItemsConsumed = Result.NumItemsProduced = PSFFitStats.NumMeasurements + NelderMeadStats.NumMeasurements;
+
+		const auto Repetitions = static_cast<double>(std::max(size_t(1), Options.NumRepetitions));
+		Result.Details.emplace_back("Reference emitter position (nm)", Util::ToStr(EmitterX) + ", " + Util::ToStr(EmitterY));
+		const auto AddDetails = [&Result, &Options, Repetitions](const std::string& Name, const std::string& IterationName, const OptimizerStatsType& Stats) {
+			const auto DurationSummary = Stats.Durations.GetSummary();
+			const auto XYSummary = Stats.XYErrors.GetSummary();
+			const auto ZSummary = Stats.ZErrors.GetSummary();
+
+			Result.Details.emplace_back(Name + ": converged", Util::ToStr(Stats.NumConverged) + " of " + Util::ToStr(Options.NumRepetitions));
+			Result.Details.emplace_back(Name + ": " + IterationName + " per optimization", Util::ToStr(Stats.NumIterations / Repetitions));
+			Result.Details.emplace_back(Name + ": measurements per optimization", Util::ToStr(Stats.NumMeasurements / Repetitions));
+			Result.Details.emplace_back(Name + ": lateral error (nm)", Util::ToStr(XYSummary.Mean * 1e3) + " mean, " + Util::ToStr(XYSummary.P90 * 1e3) + " p90");
+			Result.Details.emplace_back(Name + ": focus error (mV)", Util::ToStr(ZSummary.Mean * 1e3) + " mean, " + Util::ToStr(ZSummary.P90 * 1e3) + " p90");
+			Result.Details.emplace_back(Name + ": time per optimization (us)", Util::ToStr(DurationSummary.Mean) + " mean, " + Util::ToStr(DurationSummary.P99) + " p99");
+		};
+		AddDetails("PSF fit", "batches", PSFFitStats);
+		AddDetails("Nelder-Mead", "iterations", NelderMeadStats);
+
+		return Result;
+	}
+
+	/**
+	 * @brief Collects the timings of the circular stream buffer benchmarks in a scenario result and
+	 * counts failed consistency checks. Failed checks are logged as errors to the event log.
+	*/
+	class StreamBenchmarkRecorder
+	{
+	public:
+		StreamBenchmarkRecorder(ScenarioResultType& Result) : Result(Result) {}
+
+		/**
+		 * @brief Runs @p Func and reports its duration per sample and its throughput in the scenario's details.
+		 * @param Name Name of the benchmark case
+		 * @param NumSamples Number of samples @p Func processes
+		 * @param BytesPerSample Size of a single sample in bytes
+		 * @param Func Function performing the benchmark case
+		*/
+		template <typename FuncT>
+		void Time(const std::string& Name, size_t NumSamples, size_t BytesPerSample, FuncT&& Func)
+		{
+			const auto BeginTime = ClockType::now();
+			Func();
+			const auto Duration = std::max(1e-9, std::chrono::duration<double>(ClockType::now() - BeginTime).count());
+
+			Result.Details.emplace_back(Name, Util::ToStr(1e9 * Duration / std::max(size_t(1), NumSamples)) + " ns/sample, " +
+				Util::ToStr(NumSamples * BytesPerSample / Duration / 1e6) + " MB/s");
+		}
+
+		/**
+		 * @brief Counts a failed consistency check if @p Condition is false.
+		 * @param Condition Result of the consistency check
+		 * @param Description Description of the consistency check to be logged if it has failed
+		*/
+		void Check(bool Condition, const std::string& Description)
+		{
+			if (Condition)
+				return;
+
+			if (++Result.NumFailedChecks <= MaxNumLoggedFailures)
+				Util::EventLog().Log("Consistency check failed: " + Description, Util::ErrorType::Error);
+		}
+
+		ScenarioResultType& GetResult() noexcept { return Result; }
+		size_t GetNumFailures() const noexcept { return Result.NumFailedChecks; }
+
+	private:
+		static constexpr size_t MaxNumLoggedFailures = 10;		//!< Only the first failed checks are logged to avoid flooding the event log.
+
+		ScenarioResultType& Result;
+	};
+
+	/**
+	 * @brief Makes a sample encoding @p Index such that GetSampleIndex() recovers it after the sample
+	 * has been read back from a stream.
+	*/
+	template <typename SampleT>
+	SampleT MakeIndexedSample(size_t Index)
+	{
+		const auto Value = static_cast<double>(Index);
+
+		if constexpr (std::is_same_v<SampleT, DynExpInstr::BasicSample>)
+			return { Value, Value * 1e-6 };
+		else if constexpr (std::is_same_v<SampleT, Util::picoseconds>)
+			return Util::picoseconds(Value);
+		else
+			return SampleT(static_cast<uint8_t>(Index % 4), Value, DynExpInstr::LockinAmplifierDefs::LockinResultCartesian(Value, -Value));
+	}
+
+	/**
+	 * @brief Recovers the index a sample has been made from by MakeIndexedSample().
+	*/
+	template <typename SampleT>
+	size_t GetSampleIndex(const SampleT& Sample)
+	{
+		if constexpr (std::is_same_v<SampleT, DynExpInstr::BasicSample>)
+			return static_cast<size_t>(Sample.Value);
+		else if constexpr (std::is_same_v<SampleT, Util::picoseconds>)
+			return static_cast<size_t>(Sample.count());
+		else
+			return static_cast<size_t>(Sample.Time);
+	}
+
+	/**
+	 * @brief Determines which sample a circular stream holds at position @p Position after
+	 * @p NumWritten samples have been written to it. The samples written are taken cyclically
+	 * from a source of @p Period samples.
+	 * @return Index within the source of the sample expected at @p Position
+	*/
+	size_t GetExpectedSampleIndex(size_t Position, size_t NumWritten, size_t StreamSize, size_t Period)
+	{
+		// Index of the last sample written to Position (requires NumWritten > Position)
+		const auto LastWritten = Position + (NumWritten - 1 - Position) / StreamSize * StreamSize;
+
+		return LastWritten % Period;
+	}
+
+	/**
+	 * @brief Times single-sample and bulk writes and reads, writes across the buffer's end, and seeking
+	 * of a stream of type @p StreamT. Checks the samples read back for consistency.
+	 * @tparam StreamT DynExpInstr::CircularDataStream type or DynExpInstr::LockinSampleStream to benchmark
+	*/
+	template <typename StreamT>
+	void BenchmarkCircularDataStream(StreamBenchmarkRecorder& Recorder, const std::string& TypeName, const OptionsType& Options)
+	{
+		using SampleType = typename StreamT::SampleType;
+
+		const auto StreamSize = Options.StreamSize;
+		const auto BlockSize = std::min(Options.BlockSize, StreamSize);
+		const auto NumSamples = StreamSize * Options.NumRepetitions;
+		const auto NumBlocks = std::max(size_t(1), NumSamples / BlockSize);
+
+		// The source's period differs from the stream size, so a wrong wrap-around position becomes apparent.
+		std::vector<SampleType> Source;
+		for (size_t i = 0; i < StreamSize + 7; ++i)
+			Source.push_back(MakeIndexedSample<SampleType>(i));
+		const std::vector<SampleType> Block(Source.cbegin(), Source.cbegin() + BlockSize);
+
+		const auto CheckContent = [&Recorder, &TypeName](StreamT& Stream, size_t NumWritten, size_t Period, const std::string& Case) {
+			const auto RingSize = Stream.GetStreamSizeWrite();
+			const auto NumExpected = std::min(NumWritten, RingSize);
+			bool Ok = Stream.GetStreamSizeRead() == NumExpected && Stream.GetNumSamplesWritten() == NumWritten;
+
+			Stream.SeekBeg(std::ios_base::in);
+			const auto Samples = Ok ? Stream.ReadSamples(NumExpected) : std::vector<SampleType>();
+			for (size_t Position = 0; Ok && Position < Samples.size(); ++Position)
+				Ok = GetSampleIndex(Samples[Position]) == GetExpectedSampleIndex(Position, NumWritten, RingSize, Period);
+
+			Recorder.Check(Ok, TypeName + ": stream content after " + Case);
+		};
+
+		const auto GetExpectedChecksum = [](size_t NumRead, size_t NumWritten, size_t RingSize, size_t Period) {
+			size_t Checksum = 0;
+			for (size_t i = 0; i < NumRead; ++i)
+				Checksum += GetExpectedSampleIndex(i % RingSize, NumWritten, RingSize, Period);
+
+			return Checksum;
+		};
+
+		StreamT Stream(StreamSize);
+		Recorder.Time(TypeName + ": write single", NumSamples, sizeof(SampleType), [&]() {
+			for (size_t i = 0; i < NumSamples; ++i)
+				Stream.WriteSample(Source[i % Source.size()]);
+		});
+		CheckContent(Stream, NumSamples, Source.size(), "single writes");
+
+		// Reading continues at the buffer's beginning after reaching its end.
+		size_t Checksum = 0;
+		Stream.SeekBeg(std::ios_base::in);
+		Recorder.Time(TypeName + ": read single", NumSamples, sizeof(SampleType), [&]() {
+			for (size_t i = 0; i < NumSamples; ++i)
+				Checksum += GetSampleIndex(Stream.ReadSample());
+		});
+		Recorder.Check(Checksum == GetExpectedChecksum(NumSamples, NumSamples, StreamSize, Source.size()), TypeName + ": single reads");
+
+		StreamT BulkStream(StreamSize);
+		Recorder.Time(TypeName + ": write bulk (" + Util::ToStr(BlockSize) + " samples)", NumBlocks * BlockSize, sizeof(SampleType), [&]() {
+			for (size_t i = 0; i < NumBlocks; ++i)
+				BulkStream.WriteSamples(Block);
+		});
+		CheckContent(BulkStream, NumBlocks * BlockSize, BlockSize, "bulk writes");
+
+		Checksum = 0;
+		BulkStream.SeekBeg(std::ios_base::in);
+		Recorder.Time(TypeName + ": read bulk (" + Util::ToStr(BlockSize) + " samples)", NumBlocks * BlockSize, sizeof(SampleType), [&]() {
+			for (size_t i = 0; i < NumBlocks; ++i)
+				for (const auto& Sample : BulkStream.ReadSamples(BlockSize))
+					Checksum += GetSampleIndex(Sample);
+		});
+		Recorder.Check(Checksum == GetExpectedChecksum(NumBlocks * BlockSize, NumBlocks * BlockSize, StreamSize, BlockSize), TypeName + ": bulk reads");
+
+		// Every other block crosses the end of a buffer which is not a multiple of the block size.
+		StreamT RingStream(BlockSize + BlockSize / 2 + 1);
+		Recorder.Time(TypeName + ": write bulk across buffer end", NumBlocks * BlockSize, sizeof(SampleType), [&]() {
+			for (size_t i = 0; i < NumBlocks; ++i)
+				RingStream.WriteSamples(Block);
+		});
+		CheckContent(RingStream, NumBlocks * BlockSize, BlockSize, "bulk writes across the buffer's end");
+
+		// Seek targets and the samples expected there are determined in advance to only time seeking and reading.
+		const auto NumSeeks = std::max(size_t(1), NumSamples / 10);
+		std::mt19937 RandomEngine(0);
+		std::uniform_int_distribution<size_t> PositionDist(0, StreamSize - 1);
+		std::uniform_int_distribution<long long> OffsetDist(-static_cast<long long>(StreamSize) + 1, static_cast<long long>(StreamSize) - 1);
+		std::vector<size_t> Positions(NumSeeks), ExpectedAbs(NumSeeks), ExpectedRel(NumSeeks);
+		std::vector<long long> Offsets(NumSeeks);
+		size_t Position = 0;
+		for (size_t i = 0; i < NumSeeks; ++i)
+		{
+			Positions[i] = PositionDist(RandomEngine);
+			ExpectedAbs[i] = GetExpectedSampleIndex(Positions[i], NumSamples, StreamSize, Source.size());
+
+			Offsets[i] = OffsetDist(RandomEngine);
+			Position = (Position + StreamSize + Offsets[i]) % StreamSize;
+			ExpectedRel[i] = GetExpectedSampleIndex(Position, NumSamples, StreamSize, Source.size());
+			Position = (Position + 1) % StreamSize;		// Reading advances the read pointer.
+		}
+
+		size_t NumMismatches = 0;
+		Recorder.Time(TypeName + ": SeekAbs() and read single", NumSeeks, sizeof(SampleType), [&]() {
+			for (size_t i = 0; i < NumSeeks; ++i)
+			{
+				NumMismatches += !Stream.SeekAbs(Positions[i], std::ios_base::in);
+				NumMismatches += GetSampleIndex(Stream.ReadSample()) != ExpectedAbs[i];
+			}
+		});
+		Recorder.Check(!NumMismatches, TypeName + ": SeekAbs()");
+
+		NumMismatches = 0;
+		Stream.SeekBeg(std::ios_base::in);
+		Recorder.Time(TypeName + ": SeekRel() and read single", NumSeeks, sizeof(SampleType), [&]() {
+			for (size_t i = 0; i < NumSeeks; ++i)
+			{
+				NumMismatches += !Stream.SeekRel(Offsets[i], std::ios_base::cur, std::ios_base::in);
+				NumMismatches += GetSampleIndex(Stream.ReadSample()) != ExpectedRel[i];
+			}
+		});
+		Recorder.Check(!NumMismatches, TypeName + ": SeekRel()");
+	}
+
+	/**
+	 * @brief Times DynExpInstr::CircularDataStreamBase::ReadRecentBasicSamples() as called by consumers
+	 * like the stream manipulator module after each block written to a stream. Checks that exactly the
+	 * samples written since the last call are returned in the order they have been written.
+	*/
+	void BenchmarkReadRecentBasicSamples(StreamBenchmarkRecorder& Recorder, const OptionsType& Options)
+	{
+		const auto StreamSize = Options.StreamSize;
+
+		// With the first block size, the write pointer regularly points to the buffer's end (if the stream size is
+		// a multiple of the block size). The read pointer is moved around before each call since it must not matter.
+		for (const auto BlockSize : { std::min(Options.BlockSize, StreamSize), std::min(Options.BlockSize + 1, StreamSize) })
+		{
+			DynExpInstr::BasicSampleStream Stream(StreamSize);
+			std::vector<DynExpInstr::BasicSample> Block(BlockSize);
+			const auto NumBlocks = std::max(size_t(2), StreamSize * Options.NumRepetitions / BlockSize / 10);
+			size_t NumWritten = 0, NumKnown = 0;
+			bool Ok = true;
+
+			for (size_t i = 0; i < NumBlocks; ++i)
+			{
+				for (auto& Sample : Block)
+					Sample = MakeIndexedSample<DynExpInstr::BasicSample>(NumWritten++);
+				Stream.WriteSamples(Block);
+
+				// Read only after every other block to also request more than one block at once.
+				if (i % 2 == 0)
+					continue;
+
+				Stream.SeekAbs(i % Stream.GetStreamSizeRead(), std::ios_base::in);
+
+				const auto BeginTime = ClockType::now();
+				const auto Samples = Stream.ReadRecentBasicSamples(NumKnown);
+				Recorder.GetResult().OperationLatencies.Add(ClockType::now() - BeginTime);
+
+				Ok = Ok && Samples.size() == std::min(NumWritten - NumKnown, StreamSize);
+				for (size_t j = 0; Ok && j < Samples.size(); ++j)
+					Ok = GetSampleIndex(Samples[j]) == NumWritten - Samples.size() + j;
+
+				NumKnown = Stream.GetNumSamplesWritten();
+			}
+
+			Recorder.Check(Ok, "ReadRecentBasicSamples() with blocks of " + Util::ToStr(BlockSize) + " samples");
+		}
+	}
+
+	/**
+	 * @brief Lets a producer thread write to a stream as fast as possible while the calling thread
+	 * periodically reads the recent samples (like a plotting module) and alternately doubles and halves
+	 * the stream size. Accesses are synchronized by a mutex like the instrument data's lock does.
+	*/
+	void BenchmarkResizeUnderLoad(StreamBenchmarkRecorder& Recorder, const OptionsType& Options)
+	{
+		const auto BlockSize = std::min(Options.BlockSize, Options.StreamSize);
+		DynExpInstr::BasicSampleStream Stream(Options.StreamSize);
+		std::mutex StreamMutex;
+
+		WorkerGroup Producers;
+		Producers.Add([&Stream, &StreamMutex, BlockSize](const auto& StopRequested, auto& Stats) {
+			std::vector<DynExpInstr::BasicSample> Block(BlockSize);
+
+			while (!StopRequested)
+			{
+				{
+					std::lock_guard<decltype(StreamMutex)> lock(StreamMutex);
+
+					for (auto& Sample : Block)
+						Sample = MakeIndexedSample<DynExpInstr::BasicSample>(Stats.NumItems++);
+					Stream.WriteSamples(Block);
+				}
+
+				// Give the consumer a chance to acquire the mutex.
+				std::this_thread::yield();
+			}
+		});
+
+		LatencyRecorder ResizeDurations;
+		size_t NumKnown = 0, NumRead = 0;
+		bool Ok = true;
+		const auto BeginTime = ClockType::now();
+		const auto EndTime = BeginTime + std::chrono::duration_cast<ClockType::duration>(std::chrono::duration<double>(Options.Duration));
+		for (size_t i = 0; ClockType::now() < EndTime; ++i)
+		{
+			std::this_thread::sleep_for(Options.ReadInterval);
+
+			std::lock_guard<decltype(StreamMutex)> lock(StreamMutex);
+
+			const auto NumWritten = Stream.GetNumSamplesWritten();
+			const auto Samples = Stream.ReadRecentBasicSamples(NumKnown);
+			Ok = Ok && Samples.size() <= NumWritten - NumKnown;
+			for (size_t j = 0; Ok && j < Samples.size(); ++j)
+				Ok = GetSampleIndex(Samples[j]) == NumWritten - Samples.size() + j;
+			NumKnown = NumWritten;
+			NumRead += Samples.size();
+
+			const auto NewStreamSize = i % 2 ? Options.StreamSize : 2 * Options.StreamSize;
+			const auto ResizeBeginTime = ClockType::now();
+			Stream.SetStreamSize(NewStreamSize);
+			ResizeDurations.Add(ClockType::now() - ResizeBeginTime);
+			Ok = Ok && Stream.GetStreamSizeWrite() == NewStreamSize && Stream.GetStreamSizeRead() <= NewStreamSize;
+		}
+
+		Producers.Stop();
+		const auto Duration = std::chrono::duration<double>(ClockType::now() - BeginTime).count();
+		const auto ProducerStats = Producers.GetStats();
+
+		const auto Summary = ResizeDurations.GetSummary();
+		Recorder.GetResult().Details.emplace_back("Resize under load: written, read (samples/s)",
+			Util::ToStr(ProducerStats.NumItems / Duration) + ", " + Util::ToStr(NumRead / Duration));
+		Recorder.GetResult().Details.emplace_back("Resize under load: SetStreamSize() (us)",
+			Util::ToStr(Summary.Mean) + " mean, " + Util::ToStr(Summary.Max) + " max, n = " + Util::ToStr(Summary.Count));
+		Recorder.Check(Ok, "ReadRecentBasicSamples() while resizing the stream");
+	}
+
+	/**
+	 * @brief Checks writing and reading across the end of a stream larger than 2 GiB, which exceeds the
+	 * range of the @p int offsets @p std::streambuf uses to move its pointers. If the standard library
+	 * limits stream buffers to 2 GiB (refer to Util::circularbuf::max_size()), the check fails.
+	*/
+	void BenchmarkLargeStream(StreamBenchmarkRecorder& Recorder, const OptionsType& Options)
+	{
+		using StreamType = DynExpInstr::CircularDataStream<uint64_t>;
+
+		const auto StreamSize = static_cast<size_t>(Options.LargeStreamSize * (size_t(1) << 30) / sizeof(uint64_t)) + 3;
+		if ((StreamSize + 1) * sizeof(uint64_t) > Util::circularbuf::max_size())
+		{
+			Recorder.Check(false, "stream larger than 2 GiB: streams are limited to " + Util::ToStr(Util::circularbuf::max_size()) +
+				" bytes with this standard library");
+
+			return;
+		}
+
+		StreamType Stream(StreamSize);
+
+		constexpr uint64_t NumSamples = 8;
+		bool Ok = Stream.SeekAbs(StreamSize - NumSamples / 2, std::ios_base::out);
+		Recorder.Time("Large stream (" + Util::ToStr(StreamSize * sizeof(uint64_t)) + " bytes): write across buffer end", NumSamples, sizeof(uint64_t), [&]() {
+			for (uint64_t i = 0; i < NumSamples; ++i)
+				Stream.WriteSample(i);
+		});
+		Ok = Ok && Stream.GetWritePosition() == std::streampos(NumSamples / 2) && Stream.GetStreamSizeRead() == StreamSize;
+
+		Ok = Ok && Stream.SeekAbs(StreamSize - NumSamples / 2, std::ios_base::in);
+		for (uint64_t i = 0; Ok && i < NumSamples; ++i)
+			Ok = Stream.ReadSample() == i;
+
+		// Enlarging the stream keeps the pointers' positions.
+		Stream.SetStreamSize(StreamSize + 1);
+		Ok = Ok && Stream.GetWritePosition() == std::streampos(NumSamples / 2) && Stream.GetReadPosition() == std::streampos(NumSamples / 2);
+
+		Recorder.Check(Ok, "stream larger than 2 GiB");
+	}
+
+	/**
+	 * @brief Times writing to, reading from, seeking, and resizing DynExpInstr::CircularDataStream instances,
+	 * which all data streams are based on, and checks the samples read back for consistency.
+	*/
+	ScenarioResultType RunCircularBufScenario(const OptionsType& Options)
+	{
+		ScenarioResultType Result;
+		Result.Name = "Circular stream buffers: " + Util::ToStr(Options.StreamSize) + " samples per stream, " +
+			Util::ToStr(Options.NumRepetitions) + " passes";
+		Result.OperationTitle = "ReadRecentBasicSamples() after every other block";
+
+		StreamBenchmarkRecorder Recorder(Result);
+		ScenarioMeasurement Measurement;
+
+		BenchmarkCircularDataStream<DynExpInstr::BasicSampleStream>(Recorder, "BasicSample", Options);
+		BenchmarkCircularDataStream<DynExpInstr::CircularDataStream<Util::picoseconds>>(Recorder, "picoseconds", Options);
+		BenchmarkCircularDataStream<DynExpInstr::CircularDataStream<DynExpInstr::LockinAmplifierDefs::LockinSample>>(Recorder, "LockinSample", Options);
+		BenchmarkCircularDataStream<DynExpInstr::LockinSampleStream>(Recorder, "LockinSample (structure of arrays)", Options);
+		BenchmarkReadRecentBasicSamples(Recorder, Options);
+		BenchmarkResizeUnderLoad(Recorder, Options);
+		if (Options.LargeStreamSize > 0)
+			BenchmarkLargeStream(Recorder, Options);
+
+		Measurement.Finish(Result);
+		Result.Details.emplace_back("Failed consistency checks", Util::ToStr(Recorder.GetNumFailures()));
+
+		return Result;
+	}
+
+	/**
+	 * @brief Streams samples generated by fake poll functions through DynExpHardware::ZILabOneDemodSampleReader
+	 * without any lock-in amplifier being present. Measures the throughput and checks the order of the samples,
+	 * overruns, the propagation of exceptions thrown by the poll function, and stopping the reader thread.
+	*/
+	ScenarioResultType RunZIReaderScenario(const OptionsType& Options)
+	{
+		using ReaderType = DynExpHardware::ZILabOneDemodSampleReader;
+		using SampleType = ReaderType::SampleType;
+
+		const auto BlockSize = Options.BlockSize;
+		const auto BlockInterval = std::chrono::duration_cast<ClockType::duration>(std::chrono::duration<double>(BlockSize / Options.SampleRate));
+
+		ScenarioResultType Result;
+		Result.Name = "ZI demodulator sample reader with fake poll functions: " + Util::ToStr(Options.SampleRate) + " samples/s in blocks of " +
+			Util::ToStr(BlockSize) + " samples";
+		Result.OperationTitle = "Read()";
+
+		StreamBenchmarkRecorder Recorder(Result);
+		ScenarioMeasurement Measurement;
+
+		// Waits for Predicate to become true, but at most for Timeout. Returns the predicate's final result.
+		const auto WaitFor = [](const auto& Predicate, std::chrono::milliseconds Timeout = std::chrono::seconds(5)) {
+			const auto EndTime = ClockType::now() + Timeout;
+			while (!Predicate() && ClockType::now() < EndTime)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+			return Predicate();
+		};
+
+		// Generates NumBlocks blocks of samples as fast as possible and waits for the timeout afterwards like
+		// ziAPIPollDataEx() does if there are no new samples.
+		const auto MakeBurstPollFunction = [BlockSize](size_t NumBlocks, std::atomic<size_t>& NumPolled, bool ThrowAfterBurst) {
+			return [BlockSize, NumBlocks, &NumPolled, ThrowAfterBurst](std::vector<SampleType>& Samples, std::chrono::milliseconds Timeout) {
+				if (NumPolled >= NumBlocks * BlockSize)
+				{
+					if (ThrowAfterBurst)
+						throw Util::InvalidDataException("Fake poll failure");
+
+					std::this_thread::sleep_for(Timeout);
+					return;
+				}
+
+				for (size_t i = 0; i < BlockSize; ++i)
+					Samples.push_back(MakeIndexedSample<SampleType>(NumPolled + i));
+				NumPolled += BlockSize;
+			};
+		};
+
+		// Throughput: blocks paced at the sample rate, read in intervals like the lock-in amplifier instrument does.
+		{
+			std::atomic<size_t> NumPolled = 0;
+			size_t NumRead = 0, LastIndex = 0;
+			bool Ordered = true;
+			std::vector<SampleType> Samples;
+
+			ReaderType Reader(Options.StreamSize, [BlockSize, BlockInterval, &NumPolled, NextBlockTime = ClockType::now()](
+				std::vector<SampleType>& PolledSamples, std::chrono::milliseconds Timeout) mutable {
+				if (NextBlockTime > ClockType::now() + Timeout)
+				{
+					std::this_thread::sleep_for(Timeout);
+					return;
+				}
+
+				std::this_thread::sleep_until(NextBlockTime);
+				NextBlockTime += BlockInterval;
+
+				for (size_t i = 0; i < BlockSize; ++i)
+					PolledSamples.push_back(MakeIndexedSample<SampleType>(NumPolled + i));
+				NumPolled += BlockSize;
+			});
+
+			const auto ReadSamples = [&]() {
+				Samples.clear();
+
+				const auto BeginTime = ClockType::now();
+				const auto NumSamples = Reader.Read(Samples);
+				Result.OperationLatencies.Add(ClockType::now() - BeginTime);
+
+				// Samples might have been dropped due to overruns, but the remaining ones must be in order.
+				for (const auto& Sample : Samples)
+				{
+					Ordered = Ordered && (!NumRead || GetSampleIndex(Sample) > LastIndex);
+					LastIndex = GetSampleIndex(Sample);
+					++NumRead;
+				}
+
+				return NumSamples;
+			};
+
+			const auto EndTime = ClockType::now() + std::chrono::duration_cast<ClockType::duration>(std::chrono::duration<double>(Options.Duration));
+			while (ClockType::now() < EndTime)
+			{
+				std::this_thread::sleep_for(Options.ReadInterval);
+				ReadSamples();
+			}
+
+			Reader.Stop();
+			ReadSamples();
+
+			Result.NumItemsProduced = NumPolled;
+			Result.NumItemsConsumed = NumRead;
+			Result.Details.emplace_back("Overruns at full rate", Util::ToStr(Reader.GetNumOverruns()));
+
+			Recorder.Check(Ordered, "ZI reader: order of the samples");
+			Recorder.Check(NumRead + Reader.GetNumOverruns() == NumPolled, "ZI reader: samples read and dropped add up to samples polled");
+			Recorder.Check(!Reader.IsRunning() && !Reader.GetException(), "ZI reader: reader thread stopped without exception");
+		}
+
+		// Overruns: the consumer does not read before the poll function has produced more samples than the buffer holds.
+		{
+			constexpr size_t NumBlocks = 10;
+			std::atomic<size_t> NumPolled = 0;
+			std::vector<SampleType> Samples;
+
+			ReaderType Reader(BlockSize, MakeBurstPollFunction(NumBlocks, NumPolled, false));
+			// The reader thread counts overruns after the poll function has returned.
+			const bool Finished = WaitFor([&Reader, BlockSize]() { return Reader.GetNumOverruns() >= (NumBlocks - 1) * BlockSize; });
+			Reader.Read(Samples);
+
+			bool Ordered = Samples.size() == BlockSize;
+			for (size_t i = 0; Ordered && i < Samples.size(); ++i)
+				Ordered = GetSampleIndex(Samples[i]) == i;
+
+			Recorder.Check(Finished, "ZI reader overrun: samples dropped");
+			Recorder.Check(Reader.GetNumOverruns() == (NumBlocks - 1) * BlockSize, "ZI reader overrun: GetNumOverruns() counts the dropped samples");
+			Recorder.Check(Ordered, "ZI reader overrun: the samples fitting into the buffer are kept");
+		}
+
+		// Exceptions: an exception thrown by the poll function terminates the reader thread and is returned by GetException().
+		{
+			constexpr size_t NumBlocks = 3;
+			std::atomic<size_t> NumPolled = 0;
+			std::vector<SampleType> Samples;
+
+			ReaderType Reader(NumBlocks * BlockSize, MakeBurstPollFunction(NumBlocks, NumPolled, true));
+			const bool Terminated = WaitFor([&Reader]() { return !Reader.IsRunning(); });
+
+			bool Propagated = false;
+			try
+			{
+				if (const auto Exception = Reader.GetException())
+					std::rethrow_exception(Exception);
+			}
+			catch (const Util::InvalidDataException& e)
+			{
+				Propagated = std::string_view(e.what()).find("Fake poll failure") != std::string_view::npos;
+			}
+			catch (...)
+			{
+			}
+
+			Recorder.Check(Terminated, "ZI reader exception: reader thread terminated");
+			Recorder.Check(Propagated, "ZI reader exception: GetException() returns the poll function's exception");
+			Recorder.Check(Reader.Read(Samples) == NumBlocks * BlockSize, "ZI reader exception: samples polled before the exception are kept");
+		}
+
+		// Stopping: Stop() interrupts a reader thread waiting for samples after at most one poll timeout.
+		{
+			std::atomic<size_t> NumPolled = 0;
+			std::atomic<size_t> NumPollCalls = 0;
+			auto PollFunction = MakeBurstPollFunction(0, NumPolled, false);
+
+			ReaderType Reader(BlockSize, [&NumPollCalls, PollFunction](std::vector<SampleType>& PolledSamples, std::chrono::milliseconds Timeout) mutable {
+				++NumPollCalls;
+				PollFunction(PolledSamples, Timeout);
+			});
+			WaitFor([&NumPollCalls]() { return NumPollCalls > 0; });
+
+			const auto BeginTime = ClockType::now();
+			Reader.Stop();
+			const auto StopDuration = ClockType::now() - BeginTime;
+
+			const size_t NumPollCallsAfterStop = NumPollCalls;
+			std::this_thread::sleep_for(2 * ReaderType::PollTimeout);
+
+			Result.Details.emplace_back("Stop() while waiting for samples (ms)", Util::ToStr(std::chrono::duration<double, std::milli>(StopDuration).count()));
+			Recorder.Check(StopDuration < 2 * ReaderType::PollTimeout + std::chrono::milliseconds(500), "ZI reader stop: Stop() returns after at most one poll");
+			Recorder.Check(!Reader.IsRunning() && NumPollCalls == NumPollCallsAfterStop, "ZI reader stop: poll function not called after Stop()");
+		}
+
+		Measurement.Finish(Result);
+		Result.Details.emplace_back("Failed consistency checks", Util::ToStr(Recorder.GetNumFailures()));
+
+		return Result;
+	}
+
+	/**
+	 * @brief Passes @p Samples through @p Operator in blocks of random size (including empty blocks).
+	 * @return Concatenation of the processed blocks
+	*/
+	DynExpModule::StreamOperatorBlock ProcessInRandomBlocks(DynExpModule::StreamOperatorBase& Operator, const DynExpModule::StreamOperatorBlock& Samples,
+		size_t MaxBlockSize, std::mt19937& RandomEngine)
+	{
+		std::uniform_int_distribution<size_t> BlockSizeDistribution(0, MaxBlockSize);
+		DynExpModule::StreamOperatorBlock Processed;
+
+		for (size_t Begin = 0; Begin < Samples.Size(); )
+		{
+			const auto End = std::min(Samples.Size(), Begin + BlockSizeDistribution(RandomEngine));
+
+			DynExpModule::StreamOperatorBlock Block;
+			Block.Values.assign(Samples.Values.cbegin() + Begin, Samples.Values.cbegin() + End);
+			Block.Times.assign(Samples.Times.cbegin() + Begin, Samples.Times.cbegin() + End);
+			Operator.Process(Block);
+
+			Processed.Values.insert(Processed.Values.cend(), Block.Values.cbegin(), Block.Values.cend());
+			Processed.Times.insert(Processed.Times.cend(), Block.Times.cbegin(), Block.Times.cend());
+			Begin = End;
+		}
+
+		return Processed;
+	}
+
+	/**
+	 * @brief Checks DynExpModule::StreamOperator::Combine() for all combine modes. Samples arrive in chunks
+	 * of random size like they do when the module reads recent samples from its input data streams.
+	*/
+	void CheckStreamOperatorCombine(StreamBenchmarkRecorder& Recorder, std::mt19937& RandomEngine)
+	{
+		using CombineModeType = DynExpModule::StreamOperatorParams::CombineModeType;
+		using SampleListType = DynExpInstr::DataStreamBase::BasicSampleListType;
+
+		constexpr size_t NumInputs = 3;
+		constexpr size_t NumSamples = 10000;
+		std::uniform_real_distribution<double> ValueDistribution(-10, 10);
+		std::uniform_int_distribution<size_t> ChunkSizeDistribution(0, 100);
+
+		// Element-wise combination of inputs of different lengths consumes as many samples from each input as the shortest one has.
+		const std::vector<std::pair<CombineModeType, std::string>> ElementwiseCombineModes = {
+			{ CombineModeType::Sum, "sum" }, { CombineModeType::Product, "product" }, { CombineModeType::Difference, "difference" } };
+		for (const auto& [CombineMode, CombineModeName] : ElementwiseCombineModes)
+		{
+			std::vector<SampleListType> Inputs(NumInputs);
+			for (size_t i = 0; i < NumInputs; ++i)
+				for (size_t j = 0; j < NumSamples - 10 * i; ++j)
+					Inputs[i].emplace_back(ValueDistribution(RandomEngine), j + .1 * i);
+
+			DynExpModule::StreamOperatorBlock Block;
+			const auto NumConsumedSamples = DynExpModule::StreamOperator::Combine(CombineMode, Inputs, Block);
+			const auto NumExpectedSamples = NumSamples - 10 * (NumInputs - 1);
+
+			bool Ok = Block.Size() == NumExpectedSamples && NumConsumedSamples == std::vector<size_t>(NumInputs, NumExpectedSamples);
+			for (size_t j = 0; Ok && j < NumExpectedSamples; ++j)
+			{
+				auto Expected = Inputs[0][j].Value;
+				for (size_t i = 1; i < NumInputs; ++i)
+					Expected = CombineMode == CombineModeType::Sum ? Expected + Inputs[i][j].Value :
+						(CombineMode == CombineModeType::Product ? Expected * Inputs[i][j].Value : Expected - Inputs[i][j].Value);
+
+				Ok = Block.Values[j] == Expected && Block.Times[j] == Inputs[0][j].Time;
+			}
+
+			Recorder.Check(Ok, "StreamOperator::Combine() computing the " + CombineModeName + " of the inputs");
+		}
+
+		// Merging by time across chunk boundaries results in all samples up to the earliest of the inputs' last samples in order of their times.
+		{
+			// Distinct times make the order of the merged samples unique.
+			std::vector<SampleListType> Inputs(NumInputs);
+			std::uniform_real_distribution<double> TimeStepDistribution(0, 3);
+			for (size_t i = 0; i < NumInputs; ++i)
+			{
+				double Time = 0;
+				for (size_t j = 0; j < NumSamples; ++j)
+				{
+					Time = std::floor(Time + TimeStepDistribution(RandomEngine)) + 1 + .1 * i;
+					Inputs[i].emplace_back(ValueDistribution(RandomEngine), Time);
+				}
+			}
+
+			std::vector<SampleListType> PendingSamples(NumInputs);
+			std::vector<size_t> NumArrivedSamples(NumInputs, 0);
+			DynExpModule::StreamOperatorBlock Merged;
+			bool ConsumedOk = true;
+			while (NumArrivedSamples != std::vector<size_t>(NumInputs, NumSamples))
+			{
+				bool AllPending = true;
+				for (size_t i = 0; i < NumInputs; ++i)
+				{
+					const auto NumNewSamples = std::min(NumSamples - NumArrivedSamples[i], ChunkSizeDistribution(RandomEngine));
+					PendingSamples[i].insert(PendingSamples[i].cend(), Inputs[i].cbegin() + NumArrivedSamples[i],
+						Inputs[i].cbegin() + NumArrivedSamples[i] + NumNewSamples);
+					NumArrivedSamples[i] += NumNewSamples;
+					AllPending = AllPending && !PendingSamples[i].empty();
+				}
+
+				// The module only combines samples if each input has samples.
+				if (!AllPending)
+					continue;
+
+				DynExpModule::StreamOperatorBlock Block;
+				const auto NumConsumedSamples = DynExpModule::StreamOperator::Combine(CombineModeType::MergeByTime, PendingSamples, Block);
+				Merged.Values.insert(Merged.Values.cend(), Block.Values.cbegin(), Block.Values.cend());
+				Merged.Times.insert(Merged.Times.cend(), Block.Times.cbegin(), Block.Times.cend());
+
+				size_t NumConsumedTotal = 0;
+				for (size_t i = 0; i < NumInputs; ++i)
+				{
+					ConsumedOk = ConsumedOk && NumConsumedSamples[i] <= PendingSamples[i].size();
+					PendingSamples[i].erase(PendingSamples[i].cbegin(), PendingSamples[i].cbegin() + std::min(NumConsumedSamples[i], PendingSamples[i].size()));
+					NumConsumedTotal += NumConsumedSamples[i];
+				}
+				ConsumedOk = ConsumedOk && NumConsumedTotal == Block.Size();
+			}
+
+			auto EndTime = std::numeric_limits<double>::max();
+			SampleListType Expected;
+			for (const auto& Samples : Inputs)
+			{
+				EndTime = std::min(EndTime, Samples.back().Time);
+				Expected.insert(Expected.cend(), Samples.cbegin(), Samples.cend());
+			}
+			std::sort(Expected.begin(), Expected.end(), [](const auto& a, const auto& b) { return a.Time < b.Time; });
+			Expected.erase(std::upper_bound(Expected.cbegin(), Expected.cend(), EndTime,
+				[](const auto Time, const auto& Sample) { return Time < Sample.Time; }), Expected.cend());
+
+			bool Ok = Merged.Size() == Expected.size();
+			for (size_t j = 0; Ok && j < Expected.size(); ++j)
+				Ok = Merged.Values[j] == Expected[j].Value && Merged.Times[j] == Expected[j].Time;
+
+			Recorder.Check(ConsumedOk, "StreamOperator::Combine() merging by time: consumed samples match the merged samples");
+			Recorder.Check(Ok, "StreamOperator::Combine() merging by time across chunk boundaries");
+		}
+	}
+
+	/**
+	 * @brief Checks that the stateful operators of DynExpModule::StreamOperator produce the same samples
+	 * when samples are processed in blocks of random size as when all samples are processed at once.
+	*/
+	void CheckStreamOperatorBlockBoundaries(StreamBenchmarkRecorder& Recorder, std::mt19937& RandomEngine)
+	{
+		constexpr size_t NumSamples = 20000;
+		std::uniform_real_distribution<double> ValueDistribution(-10, 10);
+
+		DynExpModule::StreamOperatorBlock Samples;
+		Samples.Resize(NumSamples);
+		for (size_t i = 0; i < NumSamples; ++i)
+		{
+			Samples.Values[i] = ValueDistribution(RandomEngine);
+			Samples.Times[i] = static_cast<double>(i);
+		}
+
+		for (const size_t Length : { 2, 7, 100, 1000 })
+		{
+			DynExpModule::MovingAverageOperator Operator(Length);
+			const auto Processed = ProcessInRandomBlocks(Operator, Samples, 2 * Length, RandomEngine);
+
+			// Prefix sums of different lengths round differently. So, compare with a tolerance.
+			bool Ok = Processed.Size() == NumSamples && Processed.Times == Samples.Times;
+			double WindowSum = 0;
+			for (size_t i = 0; Ok && i < NumSamples; ++i)
+			{
+				WindowSum += Samples.Values[i] - (i >= Length ? Samples.Values[i - Length] : 0);
+				Ok = std::abs(Processed.Values[i] - WindowSum / static_cast<double>(std::min(i + 1, Length))) < 1e-9;
+			}
+
+			Recorder.Check(Ok, "MovingAverageOperator of length " + Util::ToStr(Length) + " across block boundaries");
+		}
+
+		// A NaN or an infinite value only affects the means of the windows containing it.
+		{
+			auto NonFiniteSamples = Samples;
+			NonFiniteSamples.Values[NumSamples / 2] = std::numeric_limits<double>::quiet_NaN();
+			NonFiniteSamples.Values[NumSamples / 2 + 1500] = std::numeric_limits<double>::infinity();
+			NonFiniteSamples.Values[NumSamples / 2 + 1600] = -std::numeric_limits<double>::infinity();
+
+			for (const size_t Length : { 2, 7, 100, 1000 })
+			{
+				DynExpModule::MovingAverageOperator Operator(Length);
+				const auto Processed = ProcessInRandomBlocks(Operator, NonFiniteSamples, 2 * Length, RandomEngine);
+
+				bool Ok = Processed.Size() == NumSamples;
+				for (size_t i = 0; Ok && i < NumSamples; ++i)
+				{
+					const auto Begin = i + 1 > Length ? i + 1 - Length : 0;
+					const auto Expected = std::accumulate(NonFiniteSamples.Values.cbegin() + Begin, NonFiniteSamples.Values.cbegin() + i + 1, 0.0) /
+						static_cast<double>(i + 1 - Begin);
+
+					Ok = std::isfinite(Expected) ? std::abs(Processed.Values[i] - Expected) < 1e-9 :
+						(std::isnan(Expected) ? std::isnan(Processed.Values[i]) : Processed.Values[i] == Expected);
+				}
+
+				Recorder.Check(Ok, "MovingAverageOperator of length " + Util::ToStr(Length) + " with NaN and infinite values");
+			}
+		}
+
+		for (const size_t Factor : { 2, 3, 100, 1000 })
+		{
+			DynExpModule::DecimationOperator BlockwiseOperator(Factor), OnePassOperator(Factor);
+			const auto Processed = ProcessInRandomBlocks(BlockwiseOperator, Samples, 2 * Factor, RandomEngine);
+			auto OnePass = Samples;
+			OnePassOperator.Process(OnePass);
+
+			bool Ok = Processed.Size() == (NumSamples + Factor - 1) / Factor && Processed.Values == OnePass.Values && Processed.Times == OnePass.Times;
+			for (size_t i = 0; Ok && i < Processed.Size(); ++i)
+				Ok = Processed.Values[i] == Samples.Values[i * Factor] && Processed.Times[i] == Samples.Times[i * Factor];
+
+			Recorder.Check(Ok, "DecimationOperator with factor " + Util::ToStr(Factor) + " across block boundaries");
+		}
+
+		// The noise has the expected mean and standard deviation, and the same seed results in the same noise.
+		for (const bool Gaussian : { false, true })
+		{
+			const double Amplitude = 2;
+			DynExpModule::NoiseOperator Operator(Gaussian, Amplitude, 0), SameSeedOperator(Gaussian, Amplitude, 0);
+
+			DynExpModule::StreamOperatorBlock Noise, SameSeedNoise;
+			Noise.Resize(NumSamples);
+			SameSeedNoise.Resize(NumSamples);
+			Operator.Process(Noise);
+			SameSeedOperator.Process(SameSeedNoise);
+
+			const auto Mean = std::accumulate(Noise.Values.cbegin(), Noise.Values.cend(), 0.0) / NumSamples;
+			const auto StdDev = std::sqrt(std::inner_product(Noise.Values.cbegin(), Noise.Values.cend(), Noise.Values.cbegin(), 0.0) / NumSamples - Mean * Mean);
+			const auto ExpectedStdDev = Gaussian ? Amplitude : Amplitude / std::sqrt(3.0);
+			const bool InRange = Gaussian || std::all_of(Noise.Values.cbegin(), Noise.Values.cend(), [Amplitude](const auto Value) { return std::abs(Value) <= Amplitude; });
+
+			// Ten times the standard error of the mean and of the standard deviation
+			Recorder.Check(std::abs(Mean) < 10 * ExpectedStdDev / std::sqrt(NumSamples) &&
+				std::abs(StdDev - ExpectedStdDev) < 10 * ExpectedStdDev / std::sqrt(2.0 * NumSamples) && InRange,
+				std::string("NoiseOperator with ") + (Gaussian ? "normally" : "uniformly") + " distributed noise: mean and standard deviation");
+			Recorder.Check(Noise.Values == SameSeedNoise.Values, std::string("NoiseOperator with ") + (Gaussian ? "normally" : "uniformly") +
+				" distributed noise: reproducible with the same seed");
+		}
+	}
+
+	/**
+	 * @brief Times the operators of DynExpModule::StreamOperator on blocks of option --block samples without
+	 * any data stream instruments involved and checks them for consistency. The throughput of the complete
+	 * modules including data stream instruments is measured by the operator scenario and compared to Python
+	 * by the multiply scenario.
+	*/
+	ScenarioResultType RunStreamOperatorKernelsScenario(const OptionsType& Options)
+	{
+		using CombineModeType = DynExpModule::StreamOperatorParams::CombineModeType;
+
+		const auto BlockSize = std::max(size_t(1), Options.BlockSize);
+		const auto NumSamples = BlockSize * Options.NumRepetitions;
+
+		ScenarioResultType Result;
+		Result.Name = "Stream operator kernels: " + Util::ToStr(Options.NumRepetitions) + " blocks of " + Util::ToStr(BlockSize) + " samples";
+		Result.OperationTitle = "Processing a block";
+
+		StreamBenchmarkRecorder Recorder(Result);
+		ScenarioMeasurement Measurement;
+		std::mt19937 RandomEngine(0);
+
+		CheckStreamOperatorCombine(Recorder, RandomEngine);
+		CheckStreamOperatorBlockBoundaries(Recorder, RandomEngine);
+
+		std::vector<DynExpInstr::DataStreamBase::BasicSampleListType> Inputs(2, DynExpInstr::DataStreamBase::BasicSampleListType(BlockSize));
+		for (size_t i = 0; i < BlockSize; ++i)
+		{
+			Inputs[0][i] = { std::sin(.01 * i), static_cast<double>(i) };
+			Inputs[1][i] = { std::cos(.01 * i), i + .5 };
+		}
+
+		const auto TimeCombine = [&](const std::string& Name, CombineModeType CombineMode) {
+			DynExpModule::StreamOperatorBlock Block;
+			Recorder.Time(Name, NumSamples, 2 * sizeof(DynExpInstr::BasicSample), [&]() {
+				for (size_t i = 0; i < Options.NumRepetitions; ++i)
+				{
+					const auto BeginTime = ClockType::now();
+					DynExpModule::StreamOperator::Combine(CombineMode, Inputs, Block);
+					Result.OperationLatencies.Add(ClockType::now() - BeginTime);
+				}
+			});
+		};
+
+		const auto TimeOperator = [&](const std::string& Name, auto&& Operator) {
+			DynExpModule::StreamOperatorBlock Source, Block;
+			DynExpModule::StreamOperator::Combine(CombineModeType::Sum, { Inputs[0] }, Source);
+			Recorder.Time(Name, NumSamples, sizeof(DynExpInstr::BasicSample), [&]() {
+				for (size_t i = 0; i < Options.NumRepetitions; ++i)
+				{
+					Block = Source;
+					Operator.Process(Block);
+				}
+			});
+		};
+
+		TimeCombine("Product of two inputs", CombineModeType::Product);
+		TimeCombine("Merging two inputs by time", CombineModeType::MergeByTime);
+		TimeOperator("Gain and offset", DynExpModule::GainOffsetOperator(2, 1));
+		TimeOperator("Uniformly distributed noise", DynExpModule::NoiseOperator(false, 1, 0));
+		TimeOperator("Normally distributed noise", DynExpModule::NoiseOperator(true, 1, 0));
+		TimeOperator("Moving average of 100 samples", DynExpModule::MovingAverageOperator(100));
+		TimeOperator("Decimation by 10", DynExpModule::DecimationOperator(10));
+		TimeOperator("Threshold", DynExpModule::ThresholdOperator(0, true));
+
+		Result.NumItemsProduced = Result.NumItemsConsumed = NumSamples;
+		Measurement.Finish(Result);
+		Result.Details.emplace_back("Failed consistency checks", Util::ToStr(Recorder.GetNumFailures()));
+
+		return Result;
+	}
+
+	/**
+	 * @brief Feeds the sine written by ProduceSamples() from a @p DummyDataStreamInstrument to a
+	 * @p StreamSpectrumAnalyzer which continuously averages spectra. Reports the number of samples
+	 * the analyzer has processed per second and checks that it keeps up with the stream and that
+	 * the sine shows up in the expected frequency bin.
+	*/
+	ScenarioResultType RunSpectrumAnalyzerScenario(DynExp::DynExpCore& Core, const OptionsType& Options)
+	{
+		// ProduceSamples() writes a sine with a period of 1000 samples. Segments of 4000 samples contain
+		// exactly four periods, so the sine is centered in the fourth bin.
+		constexpr size_t SinePeriod = 1000;
+		constexpr size_t SegmentLength = 4000;
+		constexpr DynExpInstr::SpectrometerData::TimeType ExposureTime(100);
+
+		// Buffer at least one second of samples such that the analyzer's update interval does not cause overflows.
+		const auto StreamSize = std::max(Options.StreamSize, static_cast<size_t>(Options.SampleRate));
+
+		ScenarioResultType Result;
+		Result.Name = "Stream spectrum analyzer: " + Util::ToStr(Options.SampleRate) + " samples/s, blocks of " + Util::ToStr(Options.BlockSize) +
+			" samples, segments of " + Util::ToStr(SegmentLength) + " samples, spectra averaged over " + Util::ToStr(ExposureTime.count()) + " ms";
+		Result.ItemUnit = "samples";
+		Result.LatencyTitle = "Interval between new spectra";
+		Result.OperationTitle = "Fetching a spectrum";
+		StreamBenchmarkRecorder Recorder(Result);
+
+		SyntheticProject Project(Core);
+		const auto& Input = Project.MakeInstrument<DynExpInstr::DummyDataStreamInstrument>("Input",
+			[StreamSize](auto& Params) { Params.StreamSizeParams.StreamSize = static_cast<double>(StreamSize); });
+		const auto InputID = Input.GetID();
+		const auto& Analyzer = Project.MakeInstrument<DynExpInstr::StreamSpectrumAnalyzer>("Analyzer", [&Options, InputID](auto& Params) {
+			Params.DataStreamInstr = InputID;
+			Params.SamplingRate = Options.SampleRate;
+			Params.SegmentLength = static_cast<double>(SegmentLength);
+			Params.AcquisitionMode = DynExpInstr::StreamSpectrumAnalyzerParams::AcquisitionModeType::Continuous;
+		});
+		Project.Run();
+
+		Analyzer.SetExposureTime(ExposureTime);
+		Analyzer.Record();
+
+		const auto Epoch = ClockType::now();
+		std::optional<DynExpInstr::SpectrometerData::SpectrumType> LastSpectrum;
+		size_t NumSpectra = 0;
+
+		ScenarioMeasurement Measurement;
+		WorkerGroup Producers, Consumers;
+		Producers.Add([&Input, &Options, Epoch](const auto& StopRequested, auto& Stats) { ProduceSamples(Input, Options, Epoch, StopRequested, Stats); });
+		Consumers.Add([&Analyzer, &Options, &LastSpectrum, &NumSpectra](const auto& StopRequested, auto& Stats) {
+			std::optional<ClockType::time_point> LastSpectrumTime;
+
+			while (!StopRequested)
+			{
+				std::this_thread::sleep_for(Options.ReadInterval);
+
+				const auto BeginTime = ClockType::now();
+				std::optional<DynExpInstr::SpectrometerData::SpectrumType> Spectrum;
+
+				try
+				{
+					auto InstrData = DynExp::dynamic_InstrumentData_cast<DynExpInstr::StreamSpectrumAnalyzer>(Analyzer.GetInstrumentData());
+
+					if (InstrData->HasSpectrum())
+						Spectrum = InstrData->GetSpectrum();
+				} // InstrData unlocked here.
+				catch (const Util::TimeoutException&)
+				{
+					++Stats.NumLockTimeouts;
+					continue;
+				}
+
+				const auto EndTime = ClockType::now();
+				Stats.OperationLatencies.Add(EndTime - BeginTime);
+
+				if (!Spectrum)
+					continue;
+
+				if (LastSpectrumTime)
+					Stats.Latencies.Add(EndTime - *LastSpectrumTime);
+				LastSpectrumTime = EndTime;
+				LastSpectrum = std::move(Spectrum);
+				++NumSpectra;
+			}
+		});
+
+		WaitForMeasurement(Options);
+		CollectResults(Result, Measurement, Producers, Consumers);
+
+		size_t NumAnalyzedSamples{}, NumDiscontinuities{};
+		{
+			auto InstrData = DynExp::dynamic_InstrumentData_cast<DynExpInstr::StreamSpectrumAnalyzer>(Analyzer.GetInstrumentData());
+			NumAnalyzedSamples = InstrData->GetNumAnalyzedSamples();
+			NumDiscontinuities = InstrData->GetNumDiscontinuities();
+		} // InstrData unlocked here.
+
+		// Report the samples which have passed the analyzer instead of the number of fetched spectra.
+		Result.NumItemsConsumed = NumAnalyzedSamples;
+		Result.Details.emplace_back("Stream size (samples)", Util::ToStr(StreamSize));
+		Result.Details.emplace_back("Spectra fetched", Util::ToStr(NumSpectra));
+		Result.Details.emplace_back("Stream overflows", Util::ToStr(NumDiscontinuities));
+
+		Recorder.Check(NumSpectra > 0, "The analyzer has not published any spectrum.");
+		Recorder.Check(!NumDiscontinuities, "The analyzer has missed samples since its input stream has overflown " + Util::ToStr(NumDiscontinuities) + " times.");
+
+		// Allow for samples written before the acquisition has been started or after the analyzer has read the stream last.
+		Recorder.Check(NumAnalyzedSamples + static_cast<size_t>(Options.SampleRate / 2) >= Result.NumItemsProduced,
+			"The analyzer has processed only " + Util::ToStr(NumAnalyzedSamples) + " of " + Util::ToStr(Result.NumItemsProduced) + " samples.");
+
+		if (LastSpectrum && LastSpectrum->GetNumSamples() > 1)
+		{
+			const auto& Frequencies = LastSpectrum->GetFrequencies();
+			const auto& Intensities = LastSpectrum->GetIntensities();
+
+			// Skip the DC bin.
+			const auto PeakIndex = static_cast<size_t>(std::distance(Intensities.cbegin(), std::max_element(Intensities.cbegin() + 1, Intensities.cend())));
+			const auto ExpectedFrequency = Options.SampleRate / SinePeriod;
+			const auto FrequencyResolution = Options.SampleRate / SegmentLength;
+
+			Result.Details.emplace_back("Peak frequency (Hz)", Util::ToStr(Frequencies[PeakIndex]) + " (expected " + Util::ToStr(ExpectedFrequency) + ")");
+			Recorder.Check(std::abs(Frequencies[PeakIndex] - ExpectedFrequency) < FrequencyResolution / 2,
+				"The sine at " + Util::ToStr(ExpectedFrequency) + " Hz peaks at " + Util::ToStr(Frequencies[PeakIndex]) + " Hz in the analyzer's spectrum.");
+		}
+		else
+			Recorder.Check(false, "The analyzer's last spectrum is empty.");
+
+		Result.Details.emplace_back("Failed consistency checks", Util::ToStr(Recorder.GetNumFailures()));
+
+		return Result;
+	}
+
+	/**
+	 * @brief Makes the options to run scenario @p Scenario with. Scenarios depending on options which
+	 * can be given as lists (OptionsType::NumManipulatorsList, OptionsType::PyBackends) run once per
+	 * combination of these options' values. All the other scenarios run once with @p Options.
+	 * @return Options of each run of @p Scenario in this order
+	*/
+	std::vector<OptionsType> MakeScenarioVariants(const QString& Scenario, const OptionsType& Options)
+	{
+		const bool DependsOnNumManipulators = Scenario == "multiply" || Scenario == "operator";
+		const bool DependsOnPyBackend = Scenario == "manipulator" || Scenario == "multiply";
+
+		std::vector<OptionsType> Variants;
+		for (const auto NumManipulators : DependsOnNumManipulators ? Options.NumManipulatorsList : std::vector<size_t>{ Options.NumManipulators })
+			for (const auto PyBackend : DependsOnPyBackend ? Options.PyBackends : decltype(Options.PyBackends){ Options.PyBackend })
+			{
+				auto& Variant = Variants.emplace_back(Options);
+				Variant.NumManipulators = NumManipulators;
+				Variant.PyBackend = PyBackend;
+			}
+
+		return Variants;
+	}
+
+	/**
+	 * @brief Parses the command line arguments.
+	 * @throws Util::InvalidArgException is thrown if an argument is invalid.
+	*/
+	OptionsType ParseCommandLine(const QApplication& App)
+	{
+		const QStringList AllScenarios = { "streams", "grpc", "manipulator", "multiply", "operator", "camera", "fft", "psffit", "circularbuf", "zireader", "opkernels", "analyzer" };
+		OptionsType Options;
+
+		QCommandLineParser Parser;
+		Parser.setApplicationDescription("Headless benchmark measuring the overhead of DynExp's hot paths with dummy instruments.");
+		Parser.addHelpOption();
+		Parser.addVersionOption();
+
+		const QCommandLineOption ScenarioOption("scenario", "Scenario to run (" + AllScenarios.join(", ") + ", or all). Can be given multiple times.", "name", "all");
+		const QCommandLineOption DurationOption("duration", "Duration of each measurement in seconds.", "s", QString::number(Options.Duration));
+		const QCommandLineOption InstrumentsOption("instruments", "Number of dummy data stream instruments (streams).", "n", QString::number(Options.NumInstruments));
+		const QCommandLineOption RateOption("rate", "Samples written per second to each instrument.", "samples/s", QString::number(Options.SampleRate));
+		const QCommandLineOption BlockOption("block", "Number of samples written at once.", "samples", QString::number(Options.BlockSize));
+		const QCommandLineOption StreamSizeOption("stream-size", "Stream size of the instruments in samples. Also the buffer size of the ZI sample reader (zireader).", "samples", QString::number(Options.StreamSize));
+		const QCommandLineOption ReadIntervalOption("read-interval", "Time between two reads of a consumer in ms.", "ms", QString::number(Options.ReadInterval.count()));
+		const QCommandLineOption CamerasOption("cameras", "Number of dummy cameras (camera).", "n", QString::number(Options.NumCameras));
+		const QCommandLineOption WidthOption("width", "Width of the camera images in pixels.", "pixels", QString::number(Options.ImageWidth));
+		const QCommandLineOption HeightOption("height", "Height of the camera images in pixels.", "pixels", QString::number(Options.ImageHeight));
+		const QCommandLineOption FPSOption("fps", "Rate at which images are fetched from each camera.", "fps", QString::number(Options.FPS));
+		const QCommandLineOption PortOption("port", "Network port of the gRPC loopback connection (grpc).", "port", QString::number(Options.Port));
+		const QCommandLineOption RepetitionsOption("repetitions", "Number of repetitions of computational benchmarks (fft, psffit, circularbuf).", "n", QString::number(Options.NumRepetitions));
+		const QCommandLineOption LargeStreamOption("large-stream", "Size of an additional stream in GiB checking buffers beyond 2 GiB, 0 to skip (circularbuf). Fails with MSVC, whose stream buffers are limited to 2 GiB.", "GiB", QString::number(Options.LargeStreamSize));
+		const QCommandLineOption ManipulatorsOption("manipulators", "Number of concurrent stream manipulator or stream operator modules (multiply, operator). "
+			"A comma-separated list or multiple occurrences run the scenarios once per value.", "n", QString::number(Options.NumManipulators));
+		const QCommandLineOption PyBackendOption("py-backend", "Python interpreter of the stream manipulator modules, main or subinterpreter (manipulator, multiply). "
+			"A comma-separated list or multiple occurrences run the scenarios once per value.", "backend", "main");
+		const QCommandLineOption PSFScanFileOption("psf-scan-file", "Confocal scan (.csv or .dxb) saved by the widefield microscope module to replay through the PSF fit and the Nelder-Mead optimizer instead of a synthetic point spread function (psffit).", "file");
+		Parser.addOptions({ ScenarioOption, DurationOption, InstrumentsOption, RateOption, BlockOption, StreamSizeOption, ReadIntervalOption,
+			CamerasOption, WidthOption, HeightOption, FPSOption, PortOption, RepetitionsOption, LargeStreamOption, ManipulatorsOption, PyBackendOption,
+			PSFScanFileOption });
+		Parser.process(App);
+
+		for (const auto& Scenario : Parser.values(ScenarioOption))
+		{
+			if (Scenario == "all")
+				Options.Scenarios.append(AllScenarios);
+			else if (AllScenarios.contains(Scenario))
+				Options.Scenarios.append(Scenario);
+			else
+				throw Util::InvalidArgException("Unknown scenario \"" + Scenario.toStdString() + "\".");
+		}
+		Options.Scenarios.removeDuplicates();
+
+		const auto ToNumber = [&Parser](const QCommandLineOption& Option, double MinValue) {
+			bool Ok = false;
+			const auto Value = Parser.value(Option).toDouble(&Ok);
+			if (!Ok || Value < MinValue)
+				throw Util::InvalidArgException("Invalid value of option --" + Option.names().constFirst().toStdString() + ".");
+
+			return Value;
+		};
+
+		Options.Duration = ToNumber(DurationOption, 0.1);
+		Options.NumInstruments = static_cast<size_t>(ToNumber(InstrumentsOption, 1));
+		Options.SampleRate = ToNumber(RateOption, 1);
+		Options.BlockSize = static_cast<size_t>(ToNumber(BlockOption, 1));
+		Options.StreamSize = static_cast<size_t>(ToNumber(StreamSizeOption, 1));
+		Options.ReadInterval = std::chrono::milliseconds(static_cast<long long>(ToNumber(ReadIntervalOption, 0)));
+		Options.NumCameras = static_cast<size_t>(ToNumber(CamerasOption, 1));
+		Options.ImageWidth = static_cast<int>(ToNumber(WidthOption, 1));
+		Options.ImageHeight = static_cast<int>(ToNumber(HeightOption, 1));
+		Options.FPS = ToNumber(FPSOption, 0.1);
+		Options.Port = static_cast<unsigned int>(ToNumber(PortOption, 1));
+		Options.NumRepetitions = static_cast<size_t>(ToNumber(RepetitionsOption, 1));
+		Options.LargeStreamSize = ToNumber(LargeStreamOption, 0);
+		Options.PSFScanFilename = Parser.value(PSFScanFileOption);
+
+		// Options which can be given multiple times or as comma-separated lists to run scenarios for each value
+		const auto ToList = [&Parser](const QCommandLineOption& Option) {
+			QStringList Values;
+			for (const auto& Value : Parser.values(Option))
+				Values.append(Value.split(',', Qt::SkipEmptyParts));
+			if (Values.isEmpty())
+				throw Util::InvalidArgException("Invalid value of option --" + Option.names().constFirst().toStdString() + ".");
+
+			return Values;
+		};
+
+		Options.NumManipulatorsList.clear();
+		for (const auto& Value : ToList(ManipulatorsOption))
+		{
+			bool Ok = false;
+			const auto NumManipulators = Value.trimmed().toULongLong(&Ok);
+			if (!Ok || !NumManipulators)
+				throw Util::InvalidArgException("Invalid value of option --manipulators.");
+
+			Options.NumManipulatorsList.push_back(static_cast<size_t>(NumManipulators));
+		}
+		Options.NumManipulators = Options.NumManipulatorsList.front();
+
+		Options.PyBackends.clear();
+		for (const auto& Value : ToList(PyBackendOption))
+		{
+			const auto PyBackend = Value.trimmed();
+			if (PyBackend == "main")
+				Options.PyBackends.push_back(DynExpModule::StreamManipulatorParams::ExecutionBackendType::MainInterpreter);
+			else if (PyBackend == "subinterpreter")
+			{
+				if (!Util::PySubinterpreter::IsAvailable())
+					throw Util::InvalidArgException("Python subinterpreters are not supported by this build (requires Python 3.12 and pybind11 3.0 or later).");
+
+				Options.PyBackends.push_back(DynExpModule::StreamManipulatorParams::ExecutionBackendType::Subinterpreter);
+			}
+			else
+				throw Util::InvalidArgException("Invalid value of option --py-backend.");
+		}
+		Options.PyBackend = Options.PyBackends.front();
+
+		return Options;
+	}
+}
+
+/**
+ * @brief Main entry point of %DynExp's headless benchmark executable
+ * @param argc Number of command line arguments passed when starting the program
+ * @param argv Command line arguments. Run with @p --help for the available options.
+ * @return Returns 0 in case of successful termination, an error code otherwise. Returns
+ * Util::DynExpErrorCodes::InvalidData if any consistency check of the scenarios has failed.
+*/
+int main(int argc, char* argv[])
+{
+	constexpr DynExp::HardwareAdapterLibrary<
+		DynExp::HardwareAdapterTcpSocket
+	> HardwareAdapterLib;
+
+	constexpr DynExp::InstrumentLibrary<
+		DynExpInstr::DummyCamera,
+		DynExpInstr::DummyDataStreamInstrument,
+		DynExpInstr::NetworkDataStreamInstrument,
+		DynExpInstr::StreamSpectrumAnalyzer
+	> InstrumentLib;
+
+	constexpr DynExp::ModuleLibrary<
+		DynExpModule::NetworkDataStreamInstrument,
+		DynExpModule::StreamManipulator,
+		DynExpModule::StreamOperator
+	> ModuleLib;
+
+	int ErrorReturnCode = Util::DynExpErrorCodes::GeneralError;
+	try
+	{
+		// Set up language and application settings.
+		std::locale::global(std::locale(std::locale(DynExp::DefaultLocale), new DynExp::DefaultLocaleSeparator));
+		QLocale::setDefault(Util::GetDefaultQtLocale());
+
+		// No windows are shown. Modal busy dialogs while starting objects still require a platform plugin.
+		if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+			qputenv("QT_QPA_PLATFORM", "offscreen");
+
+		QApplication App(argc, argv);
+		QApplication::setApplicationName("DynExpBenchmark");
+		QApplication::setApplicationVersion(DynExp::DynExpVersion);
+
+		// Turn off GSL error handler.
+		gsl_set_error_handler_off();
+
+		// Initialize Python interpreter.
+		Util::PyGilReleasedInterpreter PyInterpreter;
+
+		const auto Options = DynExpBenchmark::ParseCommandLine(App);
+
+		QTemporaryDir TempDir;
+		if (!TempDir.isValid())
+			throw Util::FileIOErrorException(TempDir.path().toStdString());
+		const std::filesystem::path TempPath = TempDir.path().toStdString();
+
+		auto DynExpCore = std::make_unique<DynExp::DynExpCore>(HardwareAdapterLib.ToVector(), InstrumentLib.ToVector(), ModuleLib.ToVector(), "");
+
+		size_t NumFailedChecks = 0;
+		for (const auto& Scenario : Options.Scenarios)
+		{
+			// Scenarios depending on options given as lists run once per combination of their values.
+			for (const auto& ScenarioOptions : DynExpBenchmark::MakeScenarioVariants(Scenario, Options))
+			{
+				DynExpBenchmark::ScenarioResultType Result;
+
+				if (Scenario == "streams")
+					Result = DynExpBenchmark::RunStreamsScenario(*DynExpCore, ScenarioOptions);
+				else if (Scenario == "grpc")
+					Result = DynExpBenchmark::RunGRPCScenario(*DynExpCore, ScenarioOptions);
+				else if (Scenario == "manipulator")
+					Result = DynExpBenchmark::RunManipulatorScenario(*DynExpCore, ScenarioOptions, TempPath);
+				else if (Scenario == "multiply")
+					Result = DynExpBenchmark::RunMultiplyScenario(*DynExpCore, ScenarioOptions, TempPath, false);
+				else if (Scenario == "operator")
+					Result = DynExpBenchmark::RunMultiplyScenario(*DynExpCore, ScenarioOptions, TempPath, true);
+				else if (Scenario == "camera")
+					Result = DynExpBenchmark::RunCameraScenario(*DynExpCore, ScenarioOptions, TempPath);
+				else if (Scenario == "fft")
+					Result = DynExpBenchmark::RunFFTScenario(ScenarioOptions);
+				else if (Scenario == "psffit")
+					Result = ScenarioOptions.PSFScanFilename.isEmpty() ? DynExpBenchmark::RunPSFFitScenario(ScenarioOptions) : DynExpBenchmark::RunPSFScanReplayScenario(ScenarioOptions);
+				else if (Scenario == "circularbuf")
+					Result = DynExpBenchmark::RunCircularBufScenario(ScenarioOptions);
+				else if (Scenario == "zireader")
+					Result = DynExpBenchmark::RunZIReaderScenario(ScenarioOptions);
+				else if (Scenario == "opkernels")
+					Result = DynExpBenchmark::RunStreamOperatorKernelsScenario(ScenarioOptions);
+				else if (Scenario == "analyzer")
+					Result = DynExpBenchmark::RunSpectrumAnalyzerScenario(*DynExpCore, ScenarioOptions);
+
+				DynExpBenchmark::PrintReport(std::cout, Result);
+				NumFailedChecks += Result.NumFailedChecks;
+			}
+		}
+
+		DynExpCore->Shutdown();
+
+		// Makes failed consistency checks visible to scripts and CI jobs running the benchmark.
+		if (NumFailedChecks)
+		{
+			std::cerr << NumFailedChecks << " consistency checks failed." << std::endl;
+
+			return Util::DynExpErrorCodes::InvalidData;
+		}
+
+		return Util::DynExpErrorCodes::NoError;
+	}
+	catch (const Util::Exception& e)
+	{
+		Util::EventLog().Log(e);
+		std::cerr << e.what() << std::endl;
+		ErrorReturnCode = e.ErrorCode;
+	}
+	catch (const std::exception& e)
+	{
+		Util::EventLog().Log(e.what(), Util::ErrorType::Fatal, ErrorReturnCode);
+		std::cerr << e.what() << std::endl;
+	}
+	catch (...)
+	{
+		Util::EventLog().Log("Unknown Error", Util::ErrorType::Fatal, ErrorReturnCode);
+		std::cerr << "Unknown Error" << std::endl;
+	}
+
+	return ErrorReturnCode;
+}
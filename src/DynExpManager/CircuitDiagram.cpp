@@ -6,64 +6,173 @@
 #include "DynExpCore.h"
 #include "HardwareAdapters/HardwareAdapterEthernet.h"
 
-double CircuitDiagram::GraphType::EvaluateEnergy() const
+CircuitDiagram::LayoutType::LayoutType(const std::array<size_t, NumLayers>& NumNodes)
 {
-	const auto EnergyFunc = [](const NodeListType& Nodes, const NodeListType& LinkedNodes) {
-		double Energy = 0.0;
+	for (size_t Layer = 0; Layer < NumLayers; ++Layer)
+	{
+		Order[Layer].resize(NumNodes[Layer]);
+		std::iota(Order[Layer].begin(), Order[Layer].end(), size_t(0));
+		Positions[Layer] = Order[Layer];
+	}
 
-		// Potentially slow algorithm, but since we are dealing with small graphs, this should be fine.
-		size_t CurrentNodeIndex = 0;
-		std::unordered_map<size_t, size_t> Links;
-		for (size_t i = 0; i < Nodes.size(); ++i)
-			for (size_t j = 0; j < Nodes[i]->LinkedParams.size(); ++j)
-				for (size_t k = 0; k < Nodes[i]->LinkedParams[j].LinkedItems.size(); ++k)
-				{
-					const auto LinkedItem = Nodes[i]->LinkedParams[j].LinkedItems[k].Item;
-					if (!LinkedItem)
-						continue;
+	for (size_t LayerPairIndex = 0; LayerPairIndex < LayerPairs.size(); ++LayerPairIndex)
+	{
+		LayerPairs[LayerPairIndex].LinksOfLowerNodes.resize(NumNodes[LayerPairIndex]);
+		LayerPairs[LayerPairIndex].LinksOfUpperNodes.resize(NumNodes[LayerPairIndex + 1]);
+	}
+}
 
-					// Ignore links skipping a layer. Such links should hardly occur in DynExp.
-					auto LinkedIt = std::find(LinkedNodes.cbegin(), LinkedNodes.cend(), LinkedItem);
-					if (LinkedIt == LinkedNodes.cend())
-						continue;
-					
-					// Build a simplified map of all links. Ignore to which nodes they belong to.
-					Links[CurrentNodeIndex++] = LinkedIt - LinkedNodes.cbegin();
-
-					// Honor short links.
-					double LinkedIndex = static_cast<double>(LinkedIt - LinkedNodes.cbegin());
-					double CurrentIndex = static_cast<double>(i);
-					Energy += std::abs(LinkedIndex - CurrentIndex);
-				}
+void CircuitDiagram::LayoutType::AddLink(size_t UpperLayer, size_t UpperNode, size_t LowerNode)
+{
+	if (UpperLayer < 1 || UpperLayer >= NumLayers || UpperNode >= Order[UpperLayer].size() || LowerNode >= Order[UpperLayer - 1].size())
+		throw Util::OutOfRangeException("A link refers to a layer or a node which does not exist.");
 
-		// Add huge penalty for each intersecting link.
-		for (const auto& A : Links)
-			for (const auto& B : Links)
-				if (B.first > A.first && A.second > B.second)
-					Energy += 10.0;
+	auto& LayerPair = LayerPairs[UpperLayer - 1];
+	const auto LinkIndex = LayerPair.Links.size();
 
-		return Energy;
-	};
+	LayerPair.Links.push_back({ UpperNode, LayerPair.LinksOfUpperNodes[UpperNode].size(), LowerNode });
+	LayerPair.LinksOfUpperNodes[UpperNode].push_back(LinkIndex);
+	LayerPair.LinksOfLowerNodes[LowerNode].push_back(LinkIndex);
+}
+
+size_t CircuitDiagram::LayoutType::GetNumNodes() const noexcept
+{
+	return std::accumulate(Order.cbegin(), Order.cend(), size_t(0), [](size_t Count, const auto& Layer) { return Count + Layer.size(); });
+}
+
+void CircuitDiagram::LayoutType::SetOrder(OrderType NewOrder)
+{
+	for (size_t Layer = 0; Layer < NumLayers; ++Layer)
+	{
+		if (NewOrder[Layer].size() != Order[Layer].size())
+			throw Util::InvalidArgException("The new arrangement has a different number of nodes.");
 
-	auto Energy = EnergyFunc(Instruments, HardwareAdapters) + EnergyFunc(Modules, Instruments);
+		std::vector<size_t> NewPositions(NewOrder[Layer].size(), NewOrder[Layer].size());
+		for (size_t Pos = 0; Pos < NewOrder[Layer].size(); ++Pos)
+		{
+			if (NewOrder[Layer][Pos] >= NewPositions.size() || NewPositions[NewOrder[Layer][Pos]] != NewPositions.size())
+				throw Util::InvalidArgException("The new arrangement is not a permutation of the nodes.");
 
-	// Normalize to keep energy range in the same range regardless of the graph's size.
-	Energy /= static_cast<double>(HardwareAdapters.size()) + static_cast<double>(Instruments.size()) + static_cast<double>(Modules.size());
+			NewPositions[NewOrder[Layer][Pos]] = Pos;
+		}
 
-	return Energy;
+		Positions[Layer] = std::move(NewPositions);
+	}
+
+	Order = std::move(NewOrder);
 }
 
-double CircuitDiagram::GraphType::DistanceTo(const GraphType& Other) const
+void CircuitDiagram::LayoutType::Swap(size_t Layer, size_t PosA, size_t PosB) noexcept
 {
-	// Currently, different samples differ by maximally one permutation.
-	return *this == Other ? 0.0 : 1.0;
+	auto& LayerOrder = Order[Layer];
+
+	std::swap(LayerOrder[PosA], LayerOrder[PosB]);
+	Positions[Layer][LayerOrder[PosA]] = PosA;
+	Positions[Layer][LayerOrder[PosB]] = PosB;
 }
 
-bool CircuitDiagram::GraphType::operator==(const GraphType& Other) const
+int64_t CircuitDiagram::LayoutType::EvaluatePenalty() const
 {
-	return HardwareAdapters == Other.HardwareAdapters &&
-		Instruments == Other.Instruments &&
-		Modules == Other.Modules;
+	int64_t Penalty = 0;
+
+	for (size_t LayerPairIndex = 0; LayerPairIndex < LayerPairs.size(); ++LayerPairIndex)
+	{
+		const auto& Links = LayerPairs[LayerPairIndex].Links;
+
+		for (size_t i = 0; i < Links.size(); ++i)
+		{
+			Penalty += EvaluateLinkPenalty(LayerPairIndex, Links[i]);
+
+			for (size_t j = i + 1; j < Links.size(); ++j)
+				if (DoIntersect(LayerPairIndex, Links[i], Links[j]))
+					Penalty += IntersectionPenalty;
+		}
+	}
+
+	return Penalty;
+}
+
+int64_t CircuitDiagram::LayoutType::EvaluateSwapPenaltyDelta(size_t Layer, size_t PosA, size_t PosB)
+{
+	if (PosA == PosB)
+		return 0;
+
+	const auto NodeA = Order[Layer][PosA];
+	const auto NodeB = Order[Layer][PosB];
+
+	// Only links attached to the swapped nodes change their lengths and possibly their intersections.
+	for (auto& Links : AffectedLinks)
+		Links.clear();
+	if (Layer > 0)
+	{
+		const auto& LayerPair = LayerPairs[Layer - 1];
+		AffectedLinks[Layer - 1] = LayerPair.LinksOfUpperNodes[NodeA];
+		AffectedLinks[Layer - 1].insert(AffectedLinks[Layer - 1].cend(), LayerPair.LinksOfUpperNodes[NodeB].cbegin(), LayerPair.LinksOfUpperNodes[NodeB].cend());
+	}
+	if (Layer < LayerPairs.size())
+	{
+		const auto& LayerPair = LayerPairs[Layer];
+		AffectedLinks[Layer] = LayerPair.LinksOfLowerNodes[NodeA];
+		AffectedLinks[Layer].insert(AffectedLinks[Layer].cend(), LayerPair.LinksOfLowerNodes[NodeB].cbegin(), LayerPair.LinksOfLowerNodes[NodeB].cend());
+	}
+
+	int64_t Delta = 0;
+	for (size_t LayerPairIndex = 0; LayerPairIndex < LayerPairs.size(); ++LayerPairIndex)
+		Delta -= EvaluatePartialPenalty(LayerPairIndex, AffectedLinks[LayerPairIndex]);
+
+	Swap(Layer, PosA, PosB);
+	for (size_t LayerPairIndex = 0; LayerPairIndex < LayerPairs.size(); ++LayerPairIndex)
+		Delta += EvaluatePartialPenalty(LayerPairIndex, AffectedLinks[LayerPairIndex]);
+	Swap(Layer, PosA, PosB);
+
+	return Delta;
+}
+
+bool CircuitDiagram::LayoutType::DoIntersect(size_t LayerPairIndex, const LinkType& A, const LinkType& B) const noexcept
+{
+	const auto& UpperPositions = Positions[LayerPairIndex + 1];
+	const auto& LowerPositions = Positions[LayerPairIndex];
+
+	// Links are ordered by the position of their upper nodes and by their order within the same upper node.
+	const auto PosA = std::make_pair(UpperPositions[A.UpperNode], A.IndexInUpperNode);
+	const auto PosB = std::make_pair(UpperPositions[B.UpperNode], B.IndexInUpperNode);
+
+	// Links intersect if their lower nodes are in reverse order.
+	return PosA < PosB ? LowerPositions[A.LowerNode] > LowerPositions[B.LowerNode] :
+		LowerPositions[B.LowerNode] > LowerPositions[A.LowerNode];
+}
+
+int64_t CircuitDiagram::LayoutType::EvaluateLinkPenalty(size_t LayerPairIndex, const LinkType& Link) const noexcept
+{
+	return std::abs(static_cast<int64_t>(Positions[LayerPairIndex][Link.LowerNode]) -
+		static_cast<int64_t>(Positions[LayerPairIndex + 1][Link.UpperNode]));
+}
+
+int64_t CircuitDiagram::LayoutType::EvaluatePartialPenalty(size_t LayerPairIndex, const std::vector<size_t>& LinkIndices)
+{
+	const auto& Links = LayerPairs[LayerPairIndex].Links;
+	int64_t Penalty = 0;
+
+	IsAffectedLink.assign(Links.size(), false);
+	for (const auto LinkIndex : LinkIndices)
+		IsAffectedLink[LinkIndex] = true;
+
+	for (const auto LinkIndex : LinkIndices)
+	{
+		Penalty += EvaluateLinkPenalty(LayerPairIndex, Links[LinkIndex]);
+
+		for (size_t OtherIndex = 0; OtherIndex < Links.size(); ++OtherIndex)
+		{
+			// Count intersections in between two of the given links only once.
+			if (OtherIndex == LinkIndex || (IsAffectedLink[OtherIndex] && OtherIndex < LinkIndex))
+				continue;
+
+			if (DoIntersect(LayerPairIndex, Links[LinkIndex], Links[OtherIndex]))
+				Penalty += IntersectionPenalty;
+		}
+	}
+
+	return Penalty;
 }
 
 void CircuitDiagram::CircuitDiagramItem::InsertLinks(const DynExp::ParamsBase::ObjectLinkParamsType& ObjectLinkParams,
@@ -175,6 +284,32 @@ bool CircuitDiagram::UpdateStates(const DynExp::DynExpCore& DynExpCore)
 	return true;
 }
 
+bool CircuitDiagram::UpdateLayout()
+{
+	std::optional<LayoutType::OrderType> Order;
+	{
+		std::lock_guard<decltype(LayoutResult.Mutex)> lock(LayoutResult.Mutex);
+		Order.swap(LayoutResult.Order);
+	}
+
+	if (!Order || !Scene)
+		return true;
+
+	try
+	{
+		ApplyLayout(*Order);
+		Render();
+	}
+	catch (...)
+	{
+		Clear();
+
+		return false;
+	}
+
+	return true;
+}
+
 void CircuitDiagram::mouseDoubleClickEvent(QMouseEvent* Event)
 {
 	QGraphicsItem* Item = ui.GVCircuit->itemAt(Event->pos());
@@ -212,9 +347,17 @@ QLinearGradient CircuitDiagram::GetGrayLinearGradient()
 
 void CircuitDiagram::Clear()
 {
+	// Layout thread refers to node indices of the current tree.
+	StopLayoutThread();
+
 	Scene.reset();
 
 	// Clear tree.
+	for (size_t Layer = 0; Layer < LayoutType::NumLayers; ++Layer)
+	{
+		LayoutNodes[Layer].clear();
+		LayoutNodeIDs[Layer].clear();
+	}
 	HardwareAdapterNodes.clear();
 	InstrumentNodes.clear();
 	ModuleNodes.clear();
@@ -253,25 +396,116 @@ void CircuitDiagram::BuildTree(const DynExp::DynExpCore& DynExpCore)
 
 void CircuitDiagram::ArrangeTree()
 {
-	// Sort by item name in lexicographical order.
-	GraphType Graph;
+	const std::array<NodeMapType*, LayoutType::NumLayers> NodeMaps = { &HardwareAdapterNodes, &InstrumentNodes, &ModuleNodes };
+
+	// Assign an index to each node.
+	std::array<std::unordered_map<const CircuitDiagramItem*, size_t>, LayoutType::NumLayers> NodeIndices;
+	std::array<size_t, LayoutType::NumLayers> NumNodes{};
+	for (size_t Layer = 0; Layer < LayoutType::NumLayers; ++Layer)
+	{
+		for (auto& Node : *NodeMaps[Layer])
+		{
+			NodeIndices[Layer].emplace(&Node.second, LayoutNodes[Layer].size());
+			LayoutNodes[Layer].push_back(&Node.second);
+			LayoutNodeIDs[Layer].push_back(Node.first);
+		}
+
+		NumNodes[Layer] = LayoutNodes[Layer].size();
+	}
+
+	LayoutType Layout(NumNodes);
+	for (size_t Layer = 1; Layer < LayoutType::NumLayers; ++Layer)
+		for (size_t NodeIndex = 0; NodeIndex < LayoutNodes[Layer].size(); ++NodeIndex)
+			for (const auto& LinkedParam : LayoutNodes[Layer][NodeIndex]->LinkedParams)
+				for (const auto& LinkedItem : LinkedParam.LinkedItems)
+				{
+					if (!LinkedItem.Item)
+						continue;
+
+					// Ignore links skipping a layer. Such links should hardly occur in DynExp.
+					const auto LinkedNodeIndex = NodeIndices[Layer - 1].find(LinkedItem.Item);
+					if (LinkedNodeIndex == NodeIndices[Layer - 1].cend())
+						continue;
 
-	const auto ValuePtrGetter = [](auto& Pair) { return &Pair.second; };
-	std::transform(HardwareAdapterNodes.begin(), HardwareAdapterNodes.end(), std::back_inserter(Graph.HardwareAdapters), ValuePtrGetter);
-	std::transform(InstrumentNodes.begin(), InstrumentNodes.end(), std::back_inserter(Graph.Instruments), ValuePtrGetter);
-	std::transform(ModuleNodes.begin(), ModuleNodes.end(), std::back_inserter(Graph.Modules), ValuePtrGetter);
+					Layout.AddLink(Layer, NodeIndex, LinkedNodeIndex->second);
+				}
 
+	// Sort by item name in lexicographical order.
 	const auto CircuitDiagramItemSorter = [](const CircuitDiagramItem* a, const CircuitDiagramItem* b) {
 		return a && b && !a->Empty && !b->Empty?
 			QString::localeAwareCompare(a->TreeWidgetItem->text(TreeWidgetItemNameColumn), b->TreeWidgetItem->text(TreeWidgetItemNameColumn)) < 0 :
 			false;
 	};
-	std::sort(Graph.HardwareAdapters.begin(), Graph.HardwareAdapters.end(), CircuitDiagramItemSorter);
-	std::sort(Graph.Instruments.begin(), Graph.Instruments.end(), CircuitDiagramItemSorter);
-	std::sort(Graph.Modules.begin(), Graph.Modules.end(), CircuitDiagramItemSorter);
 
-	// Swap single items to simplify tree and to avoid intersecting links
-	RefineBySimulatedAnnealing(Graph);
+	// Keep the previous arrangement of items which have been displayed before and append new items sorted by name.
+	LayoutType::OrderType SortedOrder;
+	LayoutType::OrderType PreviousOrder;
+	size_t NumChangedNodes = 0;
+	size_t NumPreviousNodes = 0;
+	for (size_t Layer = 0; Layer < LayoutType::NumLayers; ++Layer)
+	{
+		SortedOrder[Layer].resize(NumNodes[Layer]);
+		std::iota(SortedOrder[Layer].begin(), SortedOrder[Layer].end(), size_t(0));
+		std::sort(SortedOrder[Layer].begin(), SortedOrder[Layer].end(), [this, Layer, &CircuitDiagramItemSorter](size_t a, size_t b) {
+			return CircuitDiagramItemSorter(LayoutNodes[Layer][a], LayoutNodes[Layer][b]);
+		});
+
+		std::unordered_map<DynExp::ItemIDType, size_t> IndicesOfIDs;
+		for (size_t NodeIndex = 0; NodeIndex < LayoutNodeIDs[Layer].size(); ++NodeIndex)
+			IndicesOfIDs.emplace(LayoutNodeIDs[Layer][NodeIndex], NodeIndex);
+
+		std::vector<bool> IsArranged(NumNodes[Layer], false);
+		for (const auto ID : LastLayoutIDs[Layer])
+		{
+			const auto NodeIndex = IndicesOfIDs.find(ID);
+			if (NodeIndex == IndicesOfIDs.cend())
+			{
+				++NumChangedNodes;
+				continue;
+			}
+
+			PreviousOrder[Layer].push_back(NodeIndex->second);
+			IsArranged[NodeIndex->second] = true;
+			++NumPreviousNodes;
+		}
+
+		for (const auto NodeIndex : SortedOrder[Layer])
+			if (!IsArranged[NodeIndex])
+			{
+				PreviousOrder[Layer].push_back(NodeIndex);
+				++NumChangedNodes;
+			}
+	}
+
+	// Only refine the previous arrangement if few items have changed. Otherwise, start from scratch.
+	const bool IsIncremental = NumPreviousNodes > 0 && NumChangedNodes <= std::max(MinNumChangedNodesForIncrementalLayout,
+		Layout.GetNumNodes() * MaxChangedNodesPercentageForIncrementalLayout / 100);
+	Layout.SetOrder(IsIncremental ? std::move(PreviousOrder) : std::move(SortedOrder));
+
+	// Display the initial arrangement right away and swap single items to simplify tree and to avoid
+	// intersecting links in the background. Refer to UpdateLayout().
+	ApplyLayout(Layout.GetOrder());
+	LayoutThread = std::jthread(&CircuitDiagram::RefineBySimulatedAnnealing, std::move(Layout),
+		IsIncremental ? IncrementalInitialTemperature : InitialTemperature, std::ref(LayoutResult));
+}
+
+void CircuitDiagram::ApplyLayout(const LayoutType::OrderType& Order)
+{
+	std::array<NodeListType, LayoutType::NumLayers> Graph;
+	for (size_t Layer = 0; Layer < LayoutType::NumLayers; ++Layer)
+	{
+		LastLayoutIDs[Layer].clear();
+
+		for (const auto NodeIndex : Order[Layer])
+		{
+			Graph[Layer].push_back(LayoutNodes[Layer].at(NodeIndex));
+			LastLayoutIDs[Layer].push_back(LayoutNodeIDs[Layer].at(NodeIndex));
+		}
+	}
+
+	const auto& HardwareAdapters = Graph[0];
+	const auto& Instruments = Graph[1];
+	const auto& Modules = Graph[2];
 
 	// Determine items' real coordinates for painting.
 	const auto PositionCalculator = [](CircuitDiagramItem* Item, const qreal x, qreal& y) {
@@ -283,112 +517,115 @@ void CircuitDiagram::ArrangeTree()
 	};
 
 	qreal HardwareAdapterCurrentY = 0;
-	for (const auto Item : Graph.HardwareAdapters)
+	for (const auto Item : HardwareAdapters)
 		PositionCalculator(Item, 0, HardwareAdapterCurrentY);
 	qreal InstrumentCurrentY = 0;
-	for (const auto Item : Graph.Instruments)
+	for (const auto Item : Instruments)
 		PositionCalculator(Item, InnerWidth + NodeHSep, InstrumentCurrentY);
 	qreal ModuleCurrentY = 0;
-	for (const auto Item : Graph.Modules)
+	for (const auto Item : Modules)
 		PositionCalculator(Item, 2 * (InnerWidth + NodeHSep), ModuleCurrentY);
 
 	// Center vertically.
 	if (HardwareAdapterCurrentY > InstrumentCurrentY && HardwareAdapterCurrentY > ModuleCurrentY)
 	{
-		for (const auto Item : Graph.Instruments)
+		for (const auto Item : Instruments)
 			Item->TopLeftPos += { 0, (HardwareAdapterCurrentY - InstrumentCurrentY) / 2 };
-		for (const auto Item : Graph.Modules)
+		for (const auto Item : Modules)
 			Item->TopLeftPos += { 0, (HardwareAdapterCurrentY - ModuleCurrentY) / 2 };
 	}
 	else if (InstrumentCurrentY > HardwareAdapterCurrentY && InstrumentCurrentY > ModuleCurrentY)
 	{
-		for (const auto Item : Graph.HardwareAdapters)
+		for (const auto Item : HardwareAdapters)
 			Item->TopLeftPos += { 0, (InstrumentCurrentY - HardwareAdapterCurrentY) / 2 };
-		for (const auto Item : Graph.Modules)
+		for (const auto Item : Modules)
 			Item->TopLeftPos += { 0, (InstrumentCurrentY - ModuleCurrentY) / 2 };
 	}
 	else
 	{
-		for (const auto Item : Graph.HardwareAdapters)
+		for (const auto Item : HardwareAdapters)
 			Item->TopLeftPos += { 0, (ModuleCurrentY - HardwareAdapterCurrentY) / 2 };
-		for (const auto Item : Graph.Instruments)
+		for (const auto Item : Instruments)
 			Item->TopLeftPos += { 0, (ModuleCurrentY - InstrumentCurrentY) / 2 };
 	}
 }
 
-void CircuitDiagram::RefineBySimulatedAnnealing(GraphType& Graph)
+void CircuitDiagram::StopLayoutThread()
+{
+	if (LayoutThread.joinable())
+	{
+		LayoutThread.request_stop();
+		LayoutThread.join();
+	}
+
+	std::lock_guard<decltype(LayoutResult.Mutex)> lock(LayoutResult.Mutex);
+	LayoutResult.Order.reset();
+}
+
+void CircuitDiagram::RefineBySimulatedAnnealing(std::stop_token StopToken, LayoutType Layout, const double StartTemperature,
+	LayoutResultType& LayoutResult)
 {
 	auto Rnd = std::unique_ptr<gsl_rng, decltype([](gsl_rng* p) { gsl_rng_free(p); })>(gsl_rng_alloc(gsl_rng_mt19937));
 
 	// Ensure to always obtain the same stream of random numbers (see GSL documentation of gsl_rng_set()).
 	gsl_rng_set(Rnd.get(), 1);
 
-	gsl_siman_params_t SimAnParams;
-	SimAnParams.n_tries = 1;
-	SimAnParams.iters_fixed_T = 3;
-	SimAnParams.step_size = 1.0;
-	SimAnParams.k = 1.0;
-	SimAnParams.t_initial = 10;
-	SimAnParams.mu_t = 1.05;
-	SimAnParams.t_min = 1.0e-6;
-
-	const auto StepFunc = [](const gsl_rng* Rnd, void* Element, double StepSize) {
-		auto Graph = static_cast<GraphType*>(Element);
-		NodeListType* NodeListToModify = nullptr;
-
-		// Choose a random vector to modify.
-		const auto NodeListToModifyIndex = gsl_rng_uniform_int(Rnd, 3);
-		switch (NodeListToModifyIndex)
+	// Like gsl_siman_solve(), but evaluating only the energy difference caused by each step. This allows for
+	// more iterations per temperature, so that larger graphs are arranged well, too.
+	const auto IterationsPerTemperature = std::max(MinIterationsPerTemperature, Layout.GetNumNodes());
+	const auto EnergyPerPenalty = Layout.GetEnergyPerPenalty();
+	int64_t Penalty = 0;		// Relative to the initial arrangement
+	int64_t BestPenalty = 0;
+	auto BestOrder = Layout.GetOrder();
+	bool HasUnpublishedOrder = false;
+	auto LastPublishTime = std::chrono::system_clock::now();
+
+	const auto PublishOrder = [&]() {
+		std::lock_guard<decltype(LayoutResult.Mutex)> lock(LayoutResult.Mutex);
+		LayoutResult.Order = BestOrder;
+
+		HasUnpublishedOrder = false;
+		LastPublishTime = std::chrono::system_clock::now();
+	};
+
+	for (auto Temperature = StartTemperature; Temperature >= MinTemperature && !StopToken.stop_requested(); Temperature /= CoolingFactor)
+	{
+		for (size_t i = 0; i < IterationsPerTemperature; ++i)
 		{
-		case 0:
-			NodeListToModify = &Graph->HardwareAdapters;
-			break;
-		case 1:
-			NodeListToModify = &Graph->Instruments;
-			break;
-		default:
-			NodeListToModify = &Graph->Modules;
-		}
+			// Choose a random layer to modify.
+			const auto Layer = gsl_rng_uniform_int(Rnd.get(), LayoutType::NumLayers);
+			if (Layout.GetNumNodes(Layer) < 2)
+				continue;
 
-		if (NodeListToModify->size() < 2)
-			return;
+			// Choose two random elements to swap.
+			const auto MaxIndexPlusOne = static_cast<unsigned long>(std::min(static_cast<size_t>(std::numeric_limits<unsigned long>::max()), Layout.GetNumNodes(Layer)));
+			const auto PosA = gsl_rng_uniform_int(Rnd.get(), MaxIndexPlusOne);
+			const auto PosB = gsl_rng_uniform_int(Rnd.get(), MaxIndexPlusOne);
+			if (PosA == PosB)
+				continue;
 
-		// Choose two random elements to swap.
-		const auto MaxIndexPlusOne = static_cast<unsigned long>(std::min(static_cast<size_t>(std::numeric_limits<unsigned long>::max()), NodeListToModify->size()));
-		const auto SrcIndex = gsl_rng_uniform_int(Rnd, MaxIndexPlusOne);
-		const auto DestIndex = gsl_rng_uniform_int(Rnd, MaxIndexPlusOne);
+			// Metropolis criterion
+			const auto PenaltyDelta = Layout.EvaluateSwapPenaltyDelta(Layer, PosA, PosB);
+			if (PenaltyDelta > 0 && gsl_rng_uniform(Rnd.get()) >= std::exp(-PenaltyDelta * EnergyPerPenalty / Temperature))
+				continue;
 
-		if (SrcIndex != DestIndex)
-		{
-			auto OldNode = NodeListToModify->at(DestIndex);
-			NodeListToModify->at(DestIndex) = NodeListToModify->at(SrcIndex);
-			NodeListToModify->at(SrcIndex) = OldNode;
-		}
-	};
+			Layout.Swap(Layer, PosA, PosB);
+			Penalty += PenaltyDelta;
 
-	GraphType* StartSample = new GraphType(Graph);
-	try
-	{
-		gsl_siman_solve(Rnd.get(), static_cast<void*>(StartSample),
-			[](void* Element) { return static_cast<GraphType*>(Element)->EvaluateEnergy(); },
-			StepFunc,
-			[](void* a, void* b) { return static_cast<GraphType*>(a)->DistanceTo(*static_cast<GraphType*>(b)); },
-			nullptr,
-			[](void* Source, void* Dest) { *static_cast<GraphType*>(Dest) = *static_cast<GraphType*>(Source); },
-			[](void* Source) { return static_cast<void*>(new GraphType(*static_cast<GraphType*>(Source))); },
-			[](void* Element) { delete static_cast<GraphType*>(Element); },
-			0, SimAnParams);
+			if (Penalty < BestPenalty)
+			{
+				BestPenalty = Penalty;
+				BestOrder = Layout.GetOrder();
+				HasUnpublishedOrder = true;
+			}
+		}
 
-		Graph = *StartSample;
+		if (HasUnpublishedOrder && std::chrono::system_clock::now() - LastPublishTime >= LayoutPublishInterval)
+			PublishOrder();
 	}
-	catch (...)
-	{
-		delete StartSample;
 
-		throw;
-	}
-	
-	delete StartSample;
+	if (HasUnpublishedOrder)
+		PublishOrder();
 }
 
 void CircuitDiagram::Render()
@@ -417,6 +654,9 @@ void CircuitDiagram::RenderItem(CircuitDiagramItem& Item, bool DrawOutputSocket)
 {
 	bool Valid = !Item.Empty && Item.TreeWidgetItem && Item.TreeWidgetItem->parent();
 
+	// Graphics items of a previous rendering have been deleted along with the previous scene.
+	Item.ParamGraphicsItems.clear();
+
 	// Inner and outer rects
 	QPainterPath Path;
 	if (Valid)
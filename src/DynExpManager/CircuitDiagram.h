@@ -3,7 +3,7 @@
 /**
  * @file CircuitDiagram.h
  * @brief Implements a window drawing the relations between all DynExp::Object instances as a graph.
- * The arrangement of graph items is optimized by simulated annealing.
+ * The arrangement of graph items is optimized by simulated annealing in a background thread.
 */
 
 #pragma once
@@ -29,17 +29,122 @@ class CircuitDiagram : public QDialog
 
 	static constexpr double ZoomFactor = 1.6;
 
-	struct GraphType
+	/**
+	 * @brief Index-based representation of the circuit diagram's graph. Nodes are arranged in layers (hardware
+	 * adapters, instruments, modules) and links connect nodes of adjacent layers. The penalty of an arrangement
+	 * is the lower the shorter the links are and the fewer links intersect. Since this type does not refer to
+	 * any Qt objects or CircuitDiagramItem instances, arrangements can be optimized in a background thread.
+	*/
+	class LayoutType
 	{
-		NodeListType HardwareAdapters;
-		NodeListType Instruments;
-		NodeListType Modules;
+	public:
+		static constexpr size_t NumLayers = 3;							//!< Hardware adapters, instruments, and modules
+		static constexpr int64_t IntersectionPenalty = 10;				//!< Penalty for each pair of intersecting links
+		using OrderType = std::array<std::vector<size_t>, NumLayers>;	//!< Node indices of each layer in the order they are displayed from top to bottom
+
+		/**
+		 * @brief Constructs a @p LayoutType instance arranging the nodes of each layer in the order of their indices.
+		 * @param NumNodes Number of nodes in each layer
+		*/
+		LayoutType(const std::array<size_t, NumLayers>& NumNodes);
+
+		/**
+		 * @brief Adds a link from a node to a node of the layer below. Links of the same upper node are ordered
+		 * in the order they are added. Add them in the order the linked params are displayed.
+		 * @param UpperLayer Layer of the linking node. Must be greater than 0.
+		 * @param UpperNode Index of the linking node within @p UpperLayer
+		 * @param LowerNode Index of the linked node within the layer below @p UpperLayer
+		 * @throws Util::OutOfRangeException is thrown if any of the arguments is out of range.
+		*/
+		void AddLink(size_t UpperLayer, size_t UpperNode, size_t LowerNode);
+
+		const auto& GetOrder() const noexcept { return Order; }
+		size_t GetNumNodes() const noexcept;										//!< Returns the total number of nodes in all layers.
+		size_t GetNumNodes(size_t Layer) const { return Order.at(Layer).size(); }	//!< Returns the number of nodes in layer @p Layer.
+
+		/**
+		 * @brief Rearranges the nodes.
+		 * @param NewOrder New arrangement. Each layer needs to contain a permutation of its node indices.
+		 * @throws Util::InvalidArgException is thrown if @p NewOrder is not a valid arrangement.
+		*/
+		void SetOrder(OrderType NewOrder);
+
+		/**
+		 * @brief Swaps two nodes of the same layer.
+		 * @param Layer Layer of the nodes to swap
+		 * @param PosA Position of the first node within @p Layer
+		 * @param PosB Position of the second node within @p Layer
+		*/
+		void Swap(size_t Layer, size_t PosA, size_t PosB) noexcept;
+
+		/**
+		 * @brief Evaluates the penalty of the current arrangement. This is the sum of all links' lengths
+		 * (in units of positions) plus #IntersectionPenalty for each pair of intersecting links.
+		 * @return Penalty of the current arrangement
+		*/
+		int64_t EvaluatePenalty() const;
+
+		/**
+		 * @brief Evaluates by how much the penalty changes if @p Swap() was called with the same arguments.
+		 * Only considers the links attached to the swapped nodes, so the cost is proportional to the number
+		 * of those links times the number of links between the respective layers.
+		 * @copydetails Swap
+		 * @return Penalty after the swap minus penalty before the swap
+		*/
+		int64_t EvaluateSwapPenaltyDelta(size_t Layer, size_t PosA, size_t PosB);
+
+		/**
+		 * @brief Returns the factor converting penalties into energies for simulated annealing. This normalizes
+		 * energies to the same range regardless of the graph's size.
+		 * @return Energy per penalty
+		*/
+		double GetEnergyPerPenalty() const noexcept { return 1.0 / static_cast<double>(std::max(GetNumNodes(), size_t(1))); }
 
-		double EvaluateEnergy() const;
-		double DistanceTo(const GraphType& Other) const;
+	private:
+		struct LinkType
+		{
+			size_t UpperNode;			//!< Index of the linking node
+			size_t IndexInUpperNode;	//!< Order of this link among the links of #UpperNode
+			size_t LowerNode;			//!< Index of the linked node
+		};
+
+		/**
+		 * @brief Links between layer @p Index + 1 and layer @p Index.
+		*/
+		struct LayerPairType
+		{
+			std::vector<LinkType> Links;
+			std::vector<std::vector<size_t>> LinksOfUpperNodes;		//!< Indices of #Links by upper node index
+			std::vector<std::vector<size_t>> LinksOfLowerNodes;		//!< Indices of #Links by lower node index
+		};
 
-		bool operator==(const GraphType& Other) const;
-		bool operator!=(const GraphType& Other) const { return !(*this == Other); }
+		bool DoIntersect(size_t LayerPairIndex, const LinkType& A, const LinkType& B) const noexcept;
+		int64_t EvaluateLinkPenalty(size_t LayerPairIndex, const LinkType& Link) const noexcept;
+
+		/**
+		 * @brief Evaluates the part of the penalty between two layers which depends on the given links, i.e. their
+		 * lengths and the intersections they are involved in.
+		 * @param LayerPairIndex Index of the layer pair the links belong to (refer to LayerPairType)
+		 * @param LinkIndices Indices of the links within LayerPairType::Links. Must not contain duplicates.
+		 * @return Partial penalty
+		*/
+		int64_t EvaluatePartialPenalty(size_t LayerPairIndex, const std::vector<size_t>& LinkIndices);
+
+		OrderType Order;										//!< Current arrangement
+		OrderType Positions;									//!< Inverse of #Order. Positions of each layer's nodes.
+		std::array<LayerPairType, NumLayers - 1> LayerPairs;	//!< Links in between adjacent layers
+
+		std::vector<char> IsAffectedLink;						//!< Scratch buffer for @p EvaluatePartialPenalty()
+		std::array<std::vector<size_t>, NumLayers - 1> AffectedLinks;	//!< Scratch buffer for @p EvaluateSwapPenaltyDelta()
+	};
+
+	/**
+	 * @brief Arrangements found by the layout thread which have not been displayed yet
+	*/
+	struct LayoutResultType
+	{
+		std::mutex Mutex;
+		std::optional<LayoutType::OrderType> Order;		//!< Best arrangement found so far. Empty if it has already been fetched.
 	};
 
 	class CircuitDiagramItem
@@ -146,6 +251,13 @@ public:
 	*/
 	bool UpdateStates(const DynExp::DynExpCore& DynExpCore);
 
+	/**
+	 * @brief Displays the best arrangement found by the layout thread since the last call. Only call this
+	 * function if @p Redraw() would not need to be called, since the circuit diagram is rendered again.
+	 * @return Returns true in case of success, false otherwise.
+	*/
+	bool UpdateLayout();
+
 protected:
 	virtual void mouseDoubleClickEvent(QMouseEvent* Event) override;
 	virtual void wheelEvent(QWheelEvent* Event) override;
@@ -177,13 +289,26 @@ private:
 	static const QColor SocketOuterColor;
 	static const QColor SocketInnerColor;
 
+	// Constants for arranging the circuit diagram
+	static constexpr double InitialTemperature = 10;				// For arranging from scratch
+	static constexpr double IncrementalInitialTemperature = 0.1;	// For refining the previous arrangement
+	static constexpr double MinTemperature = 1.0e-6;
+	static constexpr double CoolingFactor = 1.05;
+	static constexpr size_t MinIterationsPerTemperature = 3;
+	static constexpr size_t MinNumChangedNodesForIncrementalLayout = 2;
+	static constexpr size_t MaxChangedNodesPercentageForIncrementalLayout = 10;
+	static constexpr std::chrono::milliseconds LayoutPublishInterval = std::chrono::milliseconds(100);
+
 	static QLinearGradient GetGrayLinearGradient();
 
 	// Helper functions
 	void Clear();
 	void BuildTree(const DynExp::DynExpCore& DynExpCore);
 	void ArrangeTree();
-	void RefineBySimulatedAnnealing(GraphType& Graph);
+	void ApplyLayout(const LayoutType::OrderType& Order);
+	void StopLayoutThread();
+	static void RefineBySimulatedAnnealing(std::stop_token StopToken, LayoutType Layout, const double StartTemperature,
+		LayoutResultType& LayoutResult);
 	void Render();
 	void RenderItem(CircuitDiagramItem& Item, bool DrawOutputSocket);
 	void RenderLinks(CircuitDiagramItem& Item);
@@ -201,6 +326,13 @@ private:
 	NodeMapType InstrumentNodes;
 	NodeMapType ModuleNodes;
 
+	// Nodes and IDs of displayed items by layer and by node index as used by LayoutType
+	std::array<NodeListType, LayoutType::NumLayers> LayoutNodes;
+	std::array<std::vector<DynExp::ItemIDType>, LayoutType::NumLayers> LayoutNodeIDs;
+
+	// IDs of the items in the order they have been displayed most recently. Reused by the next arrangement.
+	std::array<std::vector<DynExp::ItemIDType>, LayoutType::NumLayers> LastLayoutIDs;
+
 	// Item currently selected by a double-click
 	bool SelectionChanged;
 	QTreeWidgetItem* SelectedTreeWidgetItem;
@@ -210,6 +342,10 @@ private:
 	std::unique_ptr<QGraphicsScene> Scene;
 	QMenu* ContextMenu;
 
+	// Layout thread optimizing the arrangement in the background. Declared last to be stopped first.
+	LayoutResultType LayoutResult;
+	std::jthread LayoutThread;
+
 private slots:
 	void OnContextMenuRequested(QPoint Position);
 	void OnZoomIn();
@@ -5,17 +5,17 @@
 
 namespace DynExpModule
 {
-	void StartEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const
+	void StartEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const
 	{
 		EventFunc(&Instance);
 	}
 
-	void StopEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const
+	void StopEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const
 	{
 		EventFunc(&Instance);
 	}
 
-	void TriggerEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const
+	void TriggerEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const
 	{
 		EventFunc(&Instance);
 	}
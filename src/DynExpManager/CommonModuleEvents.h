@@ -25,7 +25,7 @@ namespace DynExpModule
 		virtual ~StartEvent() {}
 
 	private:
-		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const override;
+		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const override;
 	};
 
 	/**
@@ -39,7 +39,7 @@ namespace DynExpModule
 		virtual ~StopEvent() {}
 
 	private:
-		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const override;
+		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const override;
 	};
 
 	/**
@@ -53,6 +53,6 @@ namespace DynExpModule
 		virtual ~TriggerEvent() {}
 
 	private:
-		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const override;
+		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const override;
 	};
 }
\ No newline at end of file
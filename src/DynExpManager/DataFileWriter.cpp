@@ -0,0 +1,287 @@
+// This file is part of DynExp.
+
+#include "stdafx.h"
+#include "DataFileWriter.h"
+
+namespace Util
+{
+	static_assert(std::endian::native == std::endian::little, "The binary format of DataFileWriter requires a little-endian platform.");
+
+	Util::TextValueListType<DataFileWriter::FormatType> DataFileWriter::FormatTypeStrList()
+	{
+		Util::TextValueListType<FormatType> List = {
+			{ "CSV text file (.csv)", FormatType::CSV },
+			{ "DynExp binary data file (.dxb)", FormatType::Binary }
+		};
+
+		return List;
+	}
+
+	QString DataFileWriter::GetFileExtension(FormatType Format)
+	{
+		return Format == FormatType::Binary ? ".dxb" : ".csv";
+	}
+
+	QString DataFileWriter::GetFileFilter()
+	{
+		return " Comma-separated values file (*.csv);; DynExp binary data file (*.dxb)";
+	}
+
+	DataFileWriter::FormatType DataFileWriter::GetFormatFromFilename(const QString& Filename)
+	{
+		return Filename.endsWith(GetFileExtension(FormatType::Binary), Qt::CaseInsensitive) ? FormatType::Binary : FormatType::CSV;
+	}
+
+	DataFileWriter::DataFileWriter(const QString& Filename, FormatType Format, std::optional<int> Precision)
+		: File(Filename), Format(Format), Precision(Precision)
+	{
+		// QIODevice::WriteOnly implies QIODeviceBase::Truncate.
+		if (!File.open(Format == FormatType::Binary ? QIODevice::WriteOnly : (QIODevice::WriteOnly | QIODevice::Text)))
+			throw FileIOErrorException(Filename.toStdString());
+
+		Buffer.reserve(ChunkSize + 1024);
+	}
+
+	DataFileWriter::~DataFileWriter()
+	{
+		try
+		{
+			if (File.isOpen())
+				Close();
+		}
+		catch (...)
+		{
+			// Swallow errors in destructor. Close() has to be called explicitly to handle them.
+		}
+	}
+
+	void DataFileWriter::WriteHeader(std::string_view Header, const std::vector<std::string>& ColumnNames)
+	{
+		if (NumColumns)
+			throw InvalidStateException("The header has already been written.");
+
+		std::string HeaderText(Header);
+		for (size_t i = 0; i < ColumnNames.size(); ++i)
+		{
+			if (i)
+				HeaderText += CSVSeparator;
+			HeaderText += ColumnNames[i];
+		}
+		HeaderText += '\n';
+
+		if (Format == FormatType::Binary)
+		{
+			const auto HeaderLength = NumToT<uint32_t>(HeaderText.size());
+			const auto NumColumns = NumToT<uint32_t>(ColumnNames.size());
+
+			Buffer.append(BinaryMagic);
+			Buffer.append(reinterpret_cast<const char*>(&HeaderLength), sizeof(HeaderLength));
+			Buffer.append(HeaderText);
+			Buffer.append(reinterpret_cast<const char*>(&NumColumns), sizeof(NumColumns));
+		}
+		else
+			Buffer.append(HeaderText);
+
+		NumColumns = ColumnNames.size();
+	}
+
+	void DataFileWriter::WriteRow(std::span<const double> Values)
+	{
+		if (!NumColumns)
+			throw InvalidStateException("The header has to be written before writing rows.");
+		if (Values.size() != *NumColumns)
+			throw InvalidArgException("The amount of values does not match the amount of columns.");
+
+		for (size_t i = 0; i < Values.size(); ++i)
+		{
+			if (i && Format == FormatType::CSV)
+				Buffer += CSVSeparator;
+
+			AppendNumber(Values[i]);
+		}
+
+		if (Format == FormatType::CSV)
+			Buffer += '\n';
+
+		++NumRowsWritten;
+
+		if (Buffer.size() >= ChunkSize)
+			FlushBuffer();
+	}
+
+	void DataFileWriter::Close()
+	{
+		FlushBuffer();
+
+		if (!File.flush())
+			throw FileIOErrorException(File.fileName().toStdString());
+		File.close();
+	}
+
+	void DataFileWriter::AppendNumber(double Value)
+	{
+		if (Format == FormatType::Binary)
+		{
+			Buffer.append(reinterpret_cast<const char*>(&Value), sizeof(Value));
+
+			return;
+		}
+
+		// Sufficient for any double in general format with up to 17 significant digits.
+		std::array<char, 32> Chars;
+		const auto Result = Precision ?
+			std::to_chars(Chars.data(), Chars.data() + Chars.size(), Value, std::chars_format::general, *Precision) :
+			std::to_chars(Chars.data(), Chars.data() + Chars.size(), Value);
+
+		if (Result.ec != std::errc())
+			throw InvalidDataException("A number could not be formatted.");
+
+		Buffer.append(Chars.data(), Result.ptr);
+	}
+
+	void DataFileWriter::FlushBuffer()
+	{
+		if (Buffer.empty())
+			return;
+
+		if (File.write(Buffer.data(), Buffer.size()) != NumToT<qint64>(Buffer.size()))
+			throw FileIOErrorException(File.fileName().toStdString());
+
+		Buffer.clear();
+	}
+
+	AsyncFileWriter::AsyncFileWriter()
+	{
+		// Failures are logged from the writer thread until it terminates. Constructing the event logger before this
+		// instance ensures that it is destroyed after this instance (function-local statics are destroyed in reverse order).
+		EventLog();
+
+		Writer = std::thread(&AsyncFileWriter::WriterThread, this);
+	}
+
+	AsyncFileWriter::~AsyncFileWriter()
+	{
+		{
+			std::lock_guard<decltype(WriterMutex)> lock(WriterMutex);
+			WriterStopRequested = true;
+		}
+		WriterCV.notify_one();
+
+		if (Writer.joinable())
+			Writer.join();
+	}
+
+	void AsyncFileWriter::Enqueue(QString Filename, JobFuncType JobFunc, CompletionCallbackType CompletionCallback)
+	{
+		// Count the job before pushing it. Otherwise, the writer thread might finish it before it is counted, which
+		// would make GetNumPendingJobs() wrap around.
+		++NumEnqueuedJobs;
+		PendingJobs.Push({ std::move(Filename), std::move(JobFunc), std::move(CompletionCallback) });
+
+		// Locking the mutex ensures that the writer thread does not miss the notification.
+		{
+			std::lock_guard<decltype(WriterMutex)> lock(WriterMutex);
+		}
+		WriterCV.notify_one();
+	}
+
+	void AsyncFileWriter::EnqueueText(QString Filename, std::string Text, CompletionCallbackType CompletionCallback)
+	{
+		Enqueue(std::move(Filename), [Text = std::move(Text)](const QString& Filename) {
+			if (!SaveToFile(Filename, Text))
+				throw FileIOErrorException(Filename.toStdString());
+		}, std::move(CompletionCallback));
+	}
+
+	void AsyncFileWriter::EnqueueData(QString Filename, DataFileWriter::FormatType Format, std::string Header, std::vector<std::string> ColumnNames,
+		WriteRowsFuncType WriteRowsFunc, CompletionCallbackType CompletionCallback)
+	{
+		Enqueue(std::move(Filename), [Format, Header = std::move(Header), ColumnNames = std::move(ColumnNames),
+			WriteRowsFunc = std::move(WriteRowsFunc)](const QString& Filename) {
+			DataFileWriter Writer(Filename, Format);
+			Writer.WriteHeader(Header, ColumnNames);
+			WriteRowsFunc(Writer);
+			Writer.Close();
+		}, std::move(CompletionCallback));
+	}
+
+	bool AsyncFileWriter::WaitUntilIdle(const std::chrono::milliseconds Timeout)
+	{
+		const size_t Target = NumEnqueuedJobs;
+
+		std::unique_lock<decltype(WriterMutex)> lock(WriterMutex);
+		return FinishedCV.wait_for(lock, Timeout, [this, Target]() {
+			return NumFinishedJobs >= Target;
+		});
+	}
+
+	void AsyncFileWriter::WriterThread() noexcept
+	{
+		while (true)
+		{
+			bool StopRequested = false;
+			{
+				std::unique_lock<decltype(WriterMutex)> lock(WriterMutex);
+				WriterCV.wait(lock, [this]() { return !PendingJobs.Empty() || WriterStopRequested; });
+
+				StopRequested = WriterStopRequested;
+			}
+
+			// Write all files enqueued so far even if stopping has been requested.
+			while (auto Job = PendingJobs.Pop())
+			{
+				ProcessJob(*Job);
+				++NumFinishedJobs;
+
+				// Locking the mutex ensures that threads waiting in WaitUntilIdle() do not miss the notification.
+				{
+					std::lock_guard<decltype(WriterMutex)> lock(WriterMutex);
+				}
+				FinishedCV.notify_all();
+			}
+
+			if (StopRequested)
+				break;
+		}
+	}
+
+	void AsyncFileWriter::ProcessJob(JobType& Job) noexcept
+	{
+		bool Success = false;
+
+		try
+		{
+			Job.JobFunc(Job.Filename);
+			Success = true;
+		}
+		catch (const Exception& e)
+		{
+			EventLog().Log(e);
+		}
+		catch (const std::exception& e)
+		{
+			EventLog().Log("Saving file \"" + Job.Filename.toStdString() + "\" failed: " + e.what(), ErrorType::Error);
+		}
+		catch (...)
+		{
+			EventLog().Log("Saving file \"" + Job.Filename.toStdString() + "\" failed.", ErrorType::Error);
+		}
+
+		try
+		{
+			if (Job.CompletionCallback)
+				Job.CompletionCallback(Job.Filename, Success);
+		}
+		catch (...)
+		{
+			EventLog().Log("The completion callback of saving file \"" + Job.Filename.toStdString() + "\" failed.", ErrorType::Error);
+		}
+	}
+
+	AsyncFileWriter& FileWriter()
+	{
+		static AsyncFileWriter FileWriter;
+
+		return FileWriter;
+	}
+}
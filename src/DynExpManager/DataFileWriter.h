@@ -0,0 +1,203 @@
+// This file is part of DynExp.
+
+/**
+ * @file DataFileWriter.h
+ * @brief Provides streaming writers for tabular measurement data and a shared service to
+ * save files on a background thread within %DynExp's %Util namespace.
+*/
+
+#pragma once
+
+#include "stdafx.h"
+
+namespace Util
+{
+	/**
+	 * @brief Streams tabular numeric data to a file. Numbers are formatted with @p std::to_chars and
+	 * the file is written in chunks of at most #ChunkSize bytes. So, the file's entire content never has
+	 * to be held in memory. Data is either written as CSV file (semicolon-separated) or in a compact
+	 * binary format. Both formats contain the same header metadata.
+	 *
+	 * The binary format consists of
+	 * - the magic string #BinaryMagic,
+	 * - the length of the header text in bytes as 32-bit unsigned integer,
+	 * - the header text (identical to the CSV file's header including the line of column names),
+	 * - the number of columns as 32-bit unsigned integer,
+	 * - the rows as consecutive 64-bit IEEE 754 floating-point numbers (row-major).
+	 *
+	 * All numbers are little-endian.
+	*/
+	class DataFileWriter : public INonCopyable
+	{
+	public:
+		/**
+		 * @brief File formats supported by @p DataFileWriter
+		*/
+		enum FormatType : int { CSV, Binary };
+
+		static constexpr size_t ChunkSize = 1 << 20;							//!< Buffered data exceeding this size in bytes is written to disk.
+		static constexpr std::string_view BinaryMagic = "DynExpBinaryData\n";	//!< Magic string at the beginning of binary files
+		static constexpr char CSVSeparator = ';';								//!< Separator of the columns of CSV files
+
+		static Util::TextValueListType<FormatType> FormatTypeStrList();			//!< Returns the available formats with descriptions.
+		static QString GetFileExtension(FormatType Format);						//!< Returns the file extension (including dot) of @p Format.
+		static QString GetFileFilter();											//!< Returns a file filter for save file dialogs listing all formats.
+
+		/**
+		 * @brief Determines the format by the extension of @p Filename.
+		 * @param Filename File path to check
+		 * @return Returns @p FormatType::Binary for the binary format's extension, @p FormatType::CSV otherwise.
+		*/
+		static FormatType GetFormatFromFilename(const QString& Filename);
+
+		/**
+		 * @brief Creates or truncates the file @p Filename.
+		 * @param Filename Path of the file to write to
+		 * @param Format Format of the file
+		 * @param Precision Number of significant digits of numbers in CSV files. If not set, the shortest
+		 * representation which can be read back exactly is written.
+		 * @throws FileIOErrorException is thrown if the file cannot be opened for writing.
+		*/
+		DataFileWriter(const QString& Filename, FormatType Format, std::optional<int> Precision = {});
+
+		~DataFileWriter();	//!< Closes the file discarding errors. Call Close() to get notified about errors.
+
+		/**
+		 * @brief Writes the header. Needs to be called once before writing any rows.
+		 * @param Header Metadata text. Each line is expected to end with a newline character.
+		 * @param ColumnNames Names of the columns of the rows to be written.
+		 * @throws InvalidStateException is thrown if the header has already been written.
+		*/
+		void WriteHeader(std::string_view Header, const std::vector<std::string>& ColumnNames);
+
+		/**
+		 * @brief Writes a row of numbers.
+		 * @param Values Numbers to write. Their amount has to equal the amount of column names passed to WriteHeader().
+		 * @throws InvalidStateException is thrown if the header has not been written yet.
+		 * @throws InvalidArgException is thrown if @p Values contains the wrong amount of numbers.
+		 * @throws FileIOErrorException is thrown if writing to the file fails.
+		*/
+		void WriteRow(std::span<const double> Values);
+		void WriteRow(std::initializer_list<double> Values) { WriteRow(std::span(Values.begin(), Values.size())); }	//!< @copydoc WriteRow(std::span<const double>)
+
+		/**
+		 * @brief Writes all buffered data and closes the file.
+		 * @throws FileIOErrorException is thrown if writing to the file fails.
+		*/
+		void Close();
+
+		FormatType GetFormat() const noexcept { return Format; }						//!< Getter for #Format
+		size_t GetNumRowsWritten() const noexcept { return NumRowsWritten; }			//!< Getter for #NumRowsWritten
+
+	private:
+		void AppendNumber(double Value);		//!< Appends @p Value to #Buffer according to #Format.
+		void FlushBuffer();						//!< Writes #Buffer to #File and clears it.
+
+		QFile File;
+		const FormatType Format;
+		const std::optional<int> Precision;		//!< Number of significant digits of numbers in CSV files or shortest exact representation if not set
+		std::string Buffer;						//!< Data not written to #File yet
+
+		std::optional<size_t> NumColumns;		//!< Amount of columns per row. Not set until the header has been written.
+		size_t NumRowsWritten = 0;				//!< Amount of rows written so far
+	};
+
+	/**
+	 * @brief Saves files one after the other on a background thread such that modules do not block
+	 * while files are written. Files are saved in the order in which they have been enqueued. Failures
+	 * are logged to %DynExp's event log. %DynExp uses only one instance of this class (see FileWriter()).
+	*/
+	class AsyncFileWriter : public INonCopyable
+	{
+	public:
+		/**
+		 * @brief Function which writes the file it receives the path of. It runs on the writer thread and
+		 * has to throw an exception if writing the file fails.
+		*/
+		using JobFuncType = std::function<void(const QString& Filename)>;
+
+		/**
+		 * @brief Function writing rows to a @p DataFileWriter the header of which has already been written.
+		 * It runs on the writer thread.
+		*/
+		using WriteRowsFuncType = std::function<void(DataFileWriter& Writer)>;
+
+		/**
+		 * @brief Function called on the writer thread after a file has been written. It receives the
+		 * file's path and whether writing the file succeeded. It must not capture references to objects
+		 * which might have been destroyed by the time it is called.
+		*/
+		using CompletionCallbackType = std::function<void(const QString& Filename, bool Success)>;
+
+		AsyncFileWriter();
+		~AsyncFileWriter();	//!< Saves all files enqueued so far and terminates the writer thread.
+
+		/**
+		 * @brief Enqueues a job writing a file.
+		 * @param Filename Path of the file to write
+		 * @param JobFunc Function writing the file
+		 * @param CompletionCallback Optional function to call after the file has been written
+		*/
+		void Enqueue(QString Filename, JobFuncType JobFunc, CompletionCallbackType CompletionCallback = nullptr);
+
+		/**
+		 * @brief Enqueues saving @p Text to a text file like SaveToFile() does.
+		 * @param Filename Path of the file to write
+		 * @param Text Content of the file
+		 * @param CompletionCallback Optional function to call after the file has been written
+		*/
+		void EnqueueText(QString Filename, std::string Text, CompletionCallbackType CompletionCallback = nullptr);
+
+		/**
+		 * @brief Enqueues saving tabular data with a @p DataFileWriter.
+		 * @param Filename Path of the file to write
+		 * @param Format Format of the file
+		 * @param Header Header metadata (refer to DataFileWriter::WriteHeader())
+		 * @param ColumnNames Column names (refer to DataFileWriter::WriteHeader())
+		 * @param WriteRowsFunc Function writing the rows. It should capture (by moving) the data to write.
+		 * @param CompletionCallback Optional function to call after the file has been written
+		*/
+		void EnqueueData(QString Filename, DataFileWriter::FormatType Format, std::string Header, std::vector<std::string> ColumnNames,
+			WriteRowsFuncType WriteRowsFunc, CompletionCallbackType CompletionCallback = nullptr);
+
+		/**
+		 * @brief Blocks until all files enqueued before calling this function have been written.
+		 * @param Timeout Time to wait at most
+		 * @return Returns true if all these files have been written, false if the timeout has been exceeded.
+		*/
+		bool WaitUntilIdle(const std::chrono::milliseconds Timeout = std::chrono::milliseconds(10000));
+
+		size_t GetNumPendingJobs() const noexcept { return NumEnqueuedJobs - NumFinishedJobs; }		//!< Returns the amount of files still to be written.
+
+	private:
+		/**
+		 * @brief Job as enqueued by Enqueue() and processed by the writer thread
+		*/
+		struct JobType
+		{
+			QString Filename;
+			JobFuncType JobFunc;
+			CompletionCallbackType CompletionCallback;
+		};
+
+		void WriterThread() noexcept;			//!< Writer thread's main function
+		void ProcessJob(JobType& Job) noexcept;	//!< Runs @p Job catching and logging all exceptions.
+
+		MPSCQueue<JobType> PendingJobs;						//!< Jobs enqueued by Enqueue(), consumed by the writer thread
+		std::atomic<size_t> NumEnqueuedJobs = 0;			//!< Number of jobs ever enqueued into @p PendingJobs
+		std::atomic<size_t> NumFinishedJobs = 0;			//!< Number of jobs ever finished by the writer thread
+
+		bool WriterStopRequested = false;					//!< Indicates that the writer should terminate. Synchronized by @p WriterMutex.
+		std::mutex WriterMutex;								//!< Mutex for @p WriterCV and @p FinishedCV
+		std::condition_variable WriterCV;					//!< Wakes up the writer thread.
+		std::condition_variable FinishedCV;					//!< Notifies threads waiting in WaitUntilIdle().
+		std::thread Writer;									//!< Writer thread. Must be the last member to be initialized.
+	};
+
+	/**
+	 * @brief This function holds a static AsyncFileWriter instance and returns a reference to it.
+	 * A local static object instead of a global object is employed to avoid initialization order problems.
+	 * @return Reference to %DynExp's unique AsyncFileWriter instance
+	*/
+	AsyncFileWriter& FileWriter();
+}
@@ -13,7 +13,8 @@ DynExpManager::DynExpManager(DynExp::DynExpCore& DynExpCore, QWidget* parent)
 	LogContextMenu(new QMenu(this)),
 	ItemTreeContextMenu(new QMenu(this)), ClearWarningAction(nullptr),
 	ItemTreeHardwareAdapters(nullptr), ItemTreeInstruments(nullptr), ItemTreeModules(nullptr),
-	StatusBar(this), IsResetting(false), ShouldRedrawCircuitDiagram(true), ShouldUpdateCircuitDiagram(false)
+	StatusBar(this), ItemTreeUpdateCycle(0), IsFullItemTreeUpdate(true),
+	IsResetting(false), ShouldRedrawCircuitDiagram(true), ShouldUpdateCircuitDiagram(false)
 {
 	qApp->setStyle(QStyleFactory::create("Fusion"));
 
@@ -274,7 +275,7 @@ void DynExpManager::UpdateModulesUI() noexcept
 				QModule.HideUI();
 			else if (QModule.IsPaused())
 				QModule.DisableUI();
-			else
+			else if (QModule.IsUIUpdateDue())
 				QModule.UpdateUI();
 		}
 		catch (const Util::Exception& e)
@@ -324,38 +325,46 @@ void DynExpManager::UpdateStatusBar()
 	StatusBar.NumRunningInstr->setText(QString::number(NumRunningInstr));
 	StatusBar.NumRunningModule->setText(QString::number(NumRunningModule));
 
+	QString StateText;
+	QString StateStyleSheet;
 	if (StatusBar.NumItemsInErrorState > 0)
 	{
-		StatusBar.State->setText(QString::number(StatusBar.NumItemsInErrorState) +
+		StateText = QString::number(StatusBar.NumItemsInErrorState) +
 			QString((StatusBar.NumItemsInErrorState != 1 ? " errors" : " error")) +
 			", " + QString::number(StatusBar.NumItemsInWarningState) +
-			QString((StatusBar.NumItemsInWarningState != 1 ? " warnings" : " warning")) + " occurred.");
-		StatusBar.State->setStyleSheet(QString::fromStdString(DynExpUI::PushButtonErrorStyleSheet));
+			QString((StatusBar.NumItemsInWarningState != 1 ? " warnings" : " warning")) + " occurred.";
+		StateStyleSheet = QString::fromStdString(DynExpUI::PushButtonErrorStyleSheet);
 	}
 	else
 	{
 		if (StatusBar.NumItemsInWarningState > 0)
 		{
-			StatusBar.State->setText(QString::number(StatusBar.NumItemsInWarningState) +
-				QString((StatusBar.NumItemsInWarningState != 1 ? " warnings" : " warning")) + " occurred.");
-			StatusBar.State->setStyleSheet(QString::fromStdString(DynExpUI::PushButtonWarningStyleSheet));
+			StateText = QString::number(StatusBar.NumItemsInWarningState) +
+				QString((StatusBar.NumItemsInWarningState != 1 ? " warnings" : " warning")) + " occurred.";
+			StateStyleSheet = QString::fromStdString(DynExpUI::PushButtonWarningStyleSheet);
 		}
 		else
 		{
 			if (NumRunningInstr + NumRunningModule > 0)
 			{
-				StatusBar.State->setText("Running");
-				StatusBar.State->setStyleSheet(QString::fromStdString(DynExpUI::PushButtonRunningStyleSheet));
+				StateText = "Running";
+				StateStyleSheet = QString::fromStdString(DynExpUI::PushButtonRunningStyleSheet);
 			}
 			else
 			{
-				StatusBar.State->setText("Ready");
-				StatusBar.State->setStyleSheet(QString::fromStdString(UIBrightThemeAction->isChecked() ?
-					DynExpUI::PushButtonReadyStyleSheetBright : DynExpUI::PushButtonReadyStyleSheetDark));
+				StateText = "Ready";
+				StateStyleSheet = QString::fromStdString(UIBrightThemeAction->isChecked() ?
+					DynExpUI::PushButtonReadyStyleSheetBright : DynExpUI::PushButtonReadyStyleSheetDark);
 			}
 		}
 	}
 
+	// Setting a style sheet causes Qt to repolish the widget, so only do this if something has changed.
+	if (StatusBar.State->text() != StateText)
+		StatusBar.State->setText(StateText);
+	if (StatusBar.State->styleSheet() != StateStyleSheet)
+		StatusBar.State->setStyleSheet(StateStyleSheet);
+
 	// When item in ErrorListDlg has been double-clicked, select the respective entry in ui.treeItems.
 	ErrorListDlg->SetErrorEntries(ErrorEntries);
 	SelectItemTreeItem(ErrorListDlg->GetSelectedEntry());
@@ -385,6 +394,13 @@ void DynExpManager::UpdateCircuitDiagram()
 			return;
 	}
 
+	// Display a better arrangement if the circuit diagram's layout thread has found one.
+	if (!CircuitDiagramDlg->UpdateLayout())
+	{
+		ShouldRedrawCircuitDiagram = true;
+		return;
+	}
+
 	// When item in CircuitDiagramDlg has been double-clicked, select the respective entry in ui.treeItems.
 	SelectItemTreeItem(CircuitDiagramDlg->GetSelectedEntry());
 }
@@ -396,6 +412,12 @@ void DynExpManager::UpdateItemTree()
 
 	ErrorEntries.clear();
 
+	++ItemTreeUpdateCycle;
+	const auto Now = std::chrono::system_clock::now();
+	IsFullItemTreeUpdate = Now - LastFullItemTreeUpdate >= FullItemTreeUpdateInterval;
+	if (IsFullItemTreeUpdate)
+		LastFullItemTreeUpdate = Now;
+
 	// Update item tree and select item most recently added. This is required since editing an item
 	// causes it to be removed and readded to the tree. Its selection state is restored.
 	// Reverse order to show low level (hardware adapter) errors in status bar with highest priority.
@@ -407,6 +429,9 @@ void DynExpManager::UpdateItemTree()
 	if (LastAdded)
 		ItemToSelect = LastAdded;
 
+	// Remove cache entries of items which do not exist anymore.
+	std::erase_if(ItemTreeItemCache, [this](const auto& Entry) { return Entry.second.UpdateCycle != ItemTreeUpdateCycle; });
+
 	if (ItemToSelect)
 	{
 		ui.treeItems->clearSelection();
@@ -414,7 +439,7 @@ void DynExpManager::UpdateItemTree()
 	}
 }
 
-void DynExpManager::UpdateItemTreeItem(const DynExp::HardwareAdapterManager::ResourceType& Resource)
+bool DynExpManager::UpdateItemTreeItem(const DynExp::HardwareAdapterManager::ResourceType& Resource)
 {
 	const auto ItemData = Resource.TreeWidgetItem->data(2, Qt::ItemDataRole::UserRole).value<ItemTreeItemDataType>();
 
@@ -467,10 +492,14 @@ void DynExpManager::UpdateItemTreeItem(const DynExp::HardwareAdapterManager::Res
 			ChangeItemTreeItemToNotRespondingState(*Resource.TreeWidgetItem, ItemData, Msg);
 
 		++StatusBar.NumItemsInWarningState;
+
+		return false;
 	}
+
+	return true;
 }
 
-void DynExpManager::UpdateItemTreeItem(const DynExp::InstrumentManager::ResourceType& Resource)
+bool DynExpManager::UpdateItemTreeItem(const DynExp::InstrumentManager::ResourceType& Resource)
 {
 	const auto ItemData = Resource.TreeWidgetItem->data(2, Qt::ItemDataRole::UserRole).value<ItemTreeItemDataType>();
 
@@ -523,10 +552,14 @@ void DynExpManager::UpdateItemTreeItem(const DynExp::InstrumentManager::Resource
 			ChangeItemTreeItemToNotRespondingState(*Resource.TreeWidgetItem, ItemData, Msg);
 
 		++StatusBar.NumItemsInWarningState;
+
+		return false;
 	}
+
+	return true;
 }
 
-void DynExpManager::UpdateItemTreeItem(const DynExp::ModuleManager::ResourceType& Resource)
+bool DynExpManager::UpdateItemTreeItem(const DynExp::ModuleManager::ResourceType& Resource)
 {
 	const auto ItemData = Resource.TreeWidgetItem->data(2, Qt::ItemDataRole::UserRole).value<ItemTreeItemDataType>();
 
@@ -605,7 +638,32 @@ void DynExpManager::UpdateItemTreeItem(const DynExp::ModuleManager::ResourceType
 			ChangeItemTreeItemToNotRespondingState(*Resource.TreeWidgetItem, ItemData, Msg);
 
 		++StatusBar.NumItemsInWarningState;
+
+		return false;
 	}
+
+	return true;
+}
+
+bool DynExpManager::HasUntrackedItemTreeItemStateChanged(const DynExp::HardwareAdapterManager::ResourceType& Resource, ItemTreeItemCacheType& Cache) noexcept
+{
+	// Connection state is not tracked by DynExp::Object::GetStateVersion(), but querying it does not lock the hardware adapter.
+	const auto IsConnected = Resource.ResourcePointer->IsConnected();
+	const bool HasChanged = IsConnected != Cache.IsConnected;
+	Cache.IsConnected = IsConnected;
+
+	return HasChanged;
+}
+
+bool DynExpManager::HasUntrackedItemTreeItemStateChanged(const DynExp::InstrumentManager::ResourceType& Resource, ItemTreeItemCacheType& Cache) noexcept
+{
+	return false;
+}
+
+bool DynExpManager::HasUntrackedItemTreeItemStateChanged(const DynExp::ModuleManager::ResourceType& Resource, ItemTreeItemCacheType& Cache) noexcept
+{
+	// Items of paused modules toggle between paused and warning state (refer to UpdateItemTreeItem()).
+	return Resource.ResourcePointer->IsPaused();
 }
 
 void DynExpManager::UpdateItemTreeItemObjectName(QTreeWidgetItem* Item, const DynExp::Object* Object)
@@ -52,6 +52,28 @@ public:
 	~DynExpManager() = default;
 
 private:
+	/**
+	 * @brief Bundles what an item of the main @p QTreeWidget has contributed to #StatusBar and #ErrorEntries
+	 * when @p UpdateItemTreeItem() has been called for it the last time. This allows to skip updating items
+	 * whose related DynExp::Object instance has not changed its state.
+	*/
+	struct ItemTreeItemCacheType
+	{
+		uint64_t StateVersion = 0;							//!< DynExp::Object::GetStateVersion() of the related object at the last update
+		bool IsUpToDate = false;							//!< Indicates whether the other fields are valid. If false, the item is updated in any case.
+		bool IsConnected = false;							//!< DynExp::HardwareAdapterBase::IsConnected() at the last update (hardware adapters only)
+		size_t UpdateCycle = 0;								//!< Value of #ItemTreeUpdateCycle when the item has been visited the last time
+		size_t NumItemsInWarningState = 0;					//!< Contribution to StatusBarType::NumItemsInWarningState
+		size_t NumItemsInErrorState = 0;					//!< Contribution to StatusBarType::NumItemsInErrorState
+		ErrorListDialog::ErrorEntriesType ErrorEntries;		//!< Contribution to #ErrorEntries
+	};
+
+	/**
+	 * @brief Time after which all items of the main @p QTreeWidget are updated regardless of whether their
+	 * state has changed. Safety net for state which is not tracked by DynExp::Object::GetStateVersion().
+	*/
+	static constexpr std::chrono::seconds FullItemTreeUpdateInterval = std::chrono::seconds(2);
+
 	/**
 	 * @brief Retrieves the name of a DynExp::Object instance from its parameter class instance.
 	 * @param Object DynExp::Object whose name to retrieve
@@ -125,9 +147,17 @@ private:
 	void UpdateStatusBar();
 	void UpdateCircuitDiagram();
 	void UpdateItemTree();
-	void UpdateItemTreeItem(const DynExp::HardwareAdapterManager::ResourceType& Resource);
-	void UpdateItemTreeItem(const DynExp::InstrumentManager::ResourceType& Resource);
-	void UpdateItemTreeItem(const DynExp::ModuleManager::ResourceType& Resource);
+
+	/**
+	 * @brief Updates the state of a resource's item within the main tree widget and adds the resource's
+	 * warnings and errors to #StatusBar and #ErrorEntries.
+	 * @param Resource Resource to update the item tree item of
+	 * @return Returns false if the resource's state could not be determined since the resource did not
+	 * respond, true otherwise.
+	*/
+	bool UpdateItemTreeItem(const DynExp::HardwareAdapterManager::ResourceType& Resource);
+	bool UpdateItemTreeItem(const DynExp::InstrumentManager::ResourceType& Resource);		//!< @copydoc UpdateItemTreeItem(const DynExp::HardwareAdapterManager::ResourceType&)
+	bool UpdateItemTreeItem(const DynExp::ModuleManager::ResourceType& Resource);			//!< @copydoc UpdateItemTreeItem(const DynExp::HardwareAdapterManager::ResourceType&)
 	///@}
 
 	/** @name UI item tree functions
@@ -137,7 +167,8 @@ private:
 	///@{
 	/**
 	 * @brief Loops through resources managed by @p ResourceManager and adds respective @p QTreeWidgetItem instances as
-	 * childs to @p Section. Data is assigned to the user role of the columns of added items:
+	 * childs to @p Section. Only calls @p UpdateItemTreeItem() for resources whose state might have changed since the
+	 * last call (refer to #ItemTreeItemCache). Data is assigned to the user role of the columns of added items:
 	 * column 0's data contains a boolean flag which is true if column 0's text (object name) needs to be updated.
 	 * column 1's data contains a pointer (@p QTreeWidgetItem*) to the respectve item.
 	 * column 2's data contains a @p ItemTreeItemDataType instance.
@@ -157,6 +188,17 @@ private:
 	*/
 	void UpdateItemTreeItemObjectName(QTreeWidgetItem* Item, const DynExp::Object* Object);
 
+	/**
+	 * @brief Checks whether state of a resource which is not tracked by DynExp::Object::GetStateVersion()
+	 * might have changed since the last call to @p UpdateItemTreeItem() for this resource.
+	 * @param Resource Resource to check
+	 * @param Cache Cache entry of @p Resource. Updated by this function.
+	 * @return Returns true if @p UpdateItemTreeItem() needs to be called for @p Resource, false otherwise.
+	*/
+	static bool HasUntrackedItemTreeItemStateChanged(const DynExp::HardwareAdapterManager::ResourceType& Resource, ItemTreeItemCacheType& Cache) noexcept;
+	static bool HasUntrackedItemTreeItemStateChanged(const DynExp::InstrumentManager::ResourceType& Resource, ItemTreeItemCacheType& Cache) noexcept;	//!< @copydoc HasUntrackedItemTreeItemStateChanged(const DynExp::HardwareAdapterManager::ResourceType&, ItemTreeItemCacheType&)
+	static bool HasUntrackedItemTreeItemStateChanged(const DynExp::ModuleManager::ResourceType& Resource, ItemTreeItemCacheType& Cache) noexcept;		//!< @copydoc HasUntrackedItemTreeItemStateChanged(const DynExp::HardwareAdapterManager::ResourceType&, ItemTreeItemCacheType&)
+
 	/**
 	 * @brief Selects the given @p QTreeWidgetItem instance and brings this @p DynExpManager
 	 * window to the front.
@@ -307,6 +349,16 @@ private:
 	*/
 	ErrorListDialog::ErrorEntriesType ErrorEntries;
 
+	/**
+	 * @brief Maps the IDs of all DynExp::Object instances listed in the main @p QTreeWidget to
+	 * what their items contributed to #StatusBar and #ErrorEntries. Refer to @p UpdateItemTreeSection().
+	*/
+	std::unordered_map<DynExp::ItemIDType, ItemTreeItemCacheType> ItemTreeItemCache;
+
+	size_t ItemTreeUpdateCycle;											//!< Incremented in each call to @p UpdateItemTree() to find stale entries in #ItemTreeItemCache.
+	bool IsFullItemTreeUpdate;											//!< Indicates whether the current call to @p UpdateItemTree() updates all items.
+	std::chrono::system_clock::time_point LastFullItemTreeUpdate;		//!< Time point when all items have been updated the last time. Refer to #FullItemTreeUpdateInterval.
+
 	/**
 	 * @brief Indicates whether DynExpManager is currently deleting all resources to empty the project.
 	*/
@@ -531,6 +583,9 @@ QTreeWidgetItem* DynExpManager::UpdateItemTreeSection(QTreeWidgetItem* Section,
 
 	for (auto Resource = ResourceManager.cbegin(); Resource != ResourceManager.cend(); ++Resource)
 	{
+		// Is item new or is its name to be updated?
+		bool IsItemRecreated = true;
+
 		if (!Resource->second.TreeWidgetItem)
 		{
 			auto CategoryAndName = QString::fromStdString(Resource->second.ResourcePointer->GetCategoryAndName());
@@ -557,8 +612,36 @@ QTreeWidgetItem* DynExpManager::UpdateItemTreeSection(QTreeWidgetItem* Section,
 
 			ShouldRedrawCircuitDiagram = true;
 		}
+		else
+			IsItemRecreated = false;
 
-		UpdateItemTreeItem(Resource->second);
+		auto& Cache = ItemTreeItemCache[Resource->first];
+		Cache.UpdateCycle = ItemTreeUpdateCycle;
+
+		// Read state version before updating the item. If the state changes in between, the item is updated again next time.
+		const auto StateVersion = Resource->second.ResourcePointer->GetStateVersion();
+
+		// Short-circuit evaluation is not desired here since HasUntrackedItemTreeItemStateChanged() updates the cache.
+		const bool HasUntrackedStateChanged = HasUntrackedItemTreeItemStateChanged(Resource->second, Cache);
+		if (IsFullItemTreeUpdate || IsItemRecreated || !Cache.IsUpToDate ||
+			Cache.StateVersion != StateVersion || HasUntrackedStateChanged)
+		{
+			const auto NumItemsInWarningState = StatusBar.NumItemsInWarningState;
+			const auto NumItemsInErrorState = StatusBar.NumItemsInErrorState;
+			const auto NumErrorEntries = ErrorEntries.size();
+
+			Cache.IsUpToDate = UpdateItemTreeItem(Resource->second);
+			Cache.StateVersion = StateVersion;
+			Cache.NumItemsInWarningState = StatusBar.NumItemsInWarningState - NumItemsInWarningState;
+			Cache.NumItemsInErrorState = StatusBar.NumItemsInErrorState - NumItemsInErrorState;
+			Cache.ErrorEntries.assign(ErrorEntries.cbegin() + NumErrorEntries, ErrorEntries.cend());
+		}
+		else
+		{
+			StatusBar.NumItemsInWarningState += Cache.NumItemsInWarningState;
+			StatusBar.NumItemsInErrorState += Cache.NumItemsInErrorState;
+			ErrorEntries.insert(ErrorEntries.cend(), Cache.ErrorEntries.cbegin(), Cache.ErrorEntries.cend());
+		}
 	}
 
 	return LastAdded;
@@ -24,6 +24,7 @@ namespace DynExp
 		auto lock = AcquireLock();
 
 		LastException = std::exception_ptr();
+		BumpStateVersion();
 	}
 
 	void HardwareAdapterBase::ThrowException(std::exception_ptr Exception) const
@@ -52,6 +53,7 @@ namespace DynExp
 		{
 			Util::EventLog().Log(e);
 			LastException = std::current_exception();
+			BumpStateVersion();
 
 			Util::ForwardException(LastException);
 		}
@@ -59,6 +61,7 @@ namespace DynExp
 		catch (...)
 		{
 			LastException = std::current_exception();
+			BumpStateVersion();
 
 			Util::ForwardException(LastException);
 		}
@@ -82,6 +85,8 @@ namespace DynExp
 		{
 			LastException = std::current_exception();
 		}
+
+		BumpStateVersion();
 	}
 
 	void HardwareAdapterBase::ResetImpl(dispatch_tag<Object>)
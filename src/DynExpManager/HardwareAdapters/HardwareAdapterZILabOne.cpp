@@ -128,6 +128,99 @@ namespace DynExpHardware
 		return GetAcquiredDataUnsafe();
 	}
 
+	void ZILabOneHardwareAdapter::StartStreaming(uint8_t Demodulator, size_t BufferSizeInSamples) const
+	{
+		auto lock = AcquireLock(HardwareOperationTimeout);
+
+		StartStreamingUnsafe(Demodulator, BufferSizeInSamples);
+	}
+
+	void ZILabOneHardwareAdapter::StopStreaming() const
+	{
+		auto lock = AcquireLock(HardwareOperationTimeout);
+
+		StopStreamingUnsafe();
+	}
+
+	bool ZILabOneHardwareAdapter::IsStreaming() const
+	{
+		auto lock = AcquireLock(HardwareOperationTimeout);
+
+		CheckStreamingErrorUnsafe();
+
+		return StreamReader && StreamReader->IsRunning();
+	}
+
+	void ZILabOneHardwareAdapter::ClearStreamedData() const
+	{
+		auto lock = AcquireLock(HardwareOperationTimeout);
+
+		if (StreamReader)
+			StreamReader->Clear();
+	}
+
+	std::vector<DynExpInstr::LockinAmplifierDefs::LockinSample> ZILabOneHardwareAdapter::GetStreamedData() const
+	{
+		auto lock = AcquireLock(HardwareOperationTimeout);
+
+		CheckStreamingErrorUnsafe();
+
+		std::vector<DynExpInstr::LockinAmplifierDefs::LockinSample> Samples;
+		if (StreamReader)
+			StreamReader->Read(Samples);
+
+		return Samples;
+	}
+
+	void ZILabOneHardwareAdapter::ReadNodes(std::span<NodeValueType> Nodes) const
+	{
+		auto lock = AcquireLock(HardwareOperationTimeout);
+
+		ReadNodesUnsafe(Nodes);
+	}
+
+	void ZILabOneHardwareAdapter::WriteNodes(std::span<const NodeValueType> Nodes) const
+	{
+		auto lock = AcquireLock(HardwareOperationTimeout);
+
+		WriteNodesUnsafe(Nodes);
+	}
+
+	ZILabOneHardwareAdapter::DemodStatusType ZILabOneHardwareAdapter::GetDemodStatus(SignalInputType SignalInput, uint8_t Demodulator) const
+	{
+		const auto InputIndex = static_cast<uint8_t>(SignalInput);
+		std::array<NodeValueType, 9> Nodes = { {
+			{ NodeType::InputRange, InputIndex },
+			{ NodeType::InputMin, InputIndex },
+			{ NodeType::InputMax, InputIndex },
+			{ NodeType::DemodPhaseShift, Demodulator },
+			{ NodeType::DemodTimeConstant, Demodulator },
+			{ NodeType::DemodOrder, Demodulator },
+			{ NodeType::DemodRate, Demodulator },
+			{ NodeType::DemodEnable, Demodulator },
+			{ NodeType::OscFreq, 0 }
+		} };
+
+		{
+			auto lock = AcquireLock(HardwareOperationTimeout);
+
+			ReadNodesUnsafe(Nodes);
+		} // lock unlocked here.
+
+		DemodStatusType Status;
+		Status.InputRange = Nodes[0].Value;
+		Status.NegInputLoad = std::abs(Nodes[1].Value);
+		Status.PosInputLoad = std::abs(Nodes[2].Value);
+		Status.Phase = Nodes[3].Value / 180.0 * std::numbers::pi + std::numbers::pi;
+		Status.TimeConstant = Nodes[4].Value;
+		Status.FilterOrder = static_cast<uint8_t>(Nodes[5].Value);
+		Status.SamplingRate = Nodes[6].Value;
+		Status.Enabled = Nodes[7].Value != 0;
+		Status.OscillatorFrequency = Nodes[8].Value;
+
+		return Status;
+	}
+
 	double ZILabOneHardwareAdapter::GetInputRange(SignalInputType SignalInput) const
 	{
 		auto lock = AcquireLock(HardwareOperationTimeout);
@@ -292,7 +385,15 @@ namespace DynExpHardware
 		auto DerivedParams = dynamic_Params_cast<ZILabOneHardwareAdapter>(GetParams());
 		DeviceDescriptor = DerivedParams->DeviceDescriptor;
 		Interface = DerivedParams->Interface;
+		ServerAddress.clear();
+		ServerPort = 0;
+		APILevel = static_cast<ZILabOneHardwareAdapterSyms::ZIAPIVersion_enum>(6);
 		Clockbase = 1;
+
+		NodePathCache.clear();
+
+		// Disconnects and destroys the stream connection (if still streaming) instead of just discarding it.
+		StopStreamingUnsafe();
 	}
 
 	void ZILabOneHardwareAdapter::ResetImpl(dispatch_tag<HardwareAdapterBase>)
@@ -300,6 +401,9 @@ namespace DynExpHardware
 		// auto lock = AcquireLock(); not necessary here, since DynExp ensures that Object::Reset() can only
 		// be called if respective object is not in use.
 
+		// Stop the reader thread and disconnect and destroy the stream connection before anything else since
+		// CloseUnsafe() might throw if disconnecting the main connection fails.
+		StopStreamingUnsafe();
 		CloseUnsafe();
 		ZILabOneHardwareAdapterSyms::ziAPIDestroy(ZIConnection);
 
@@ -351,23 +455,29 @@ namespace DynExpHardware
 			return;
 
 		const char* DeviceID = nullptr;
-		const char* ServerAddress;
+		const char* ServerAddressStr;
 		ZILabOneHardwareAdapterSyms::ZIIntegerData Port = 0;
-		ZILabOneHardwareAdapterSyms::ZIIntegerData APILevel = 6;
+		ZILabOneHardwareAdapterSyms::ZIIntegerData APILevelNumber = 6;
 
 		auto Result = ZILabOneHardwareAdapterSyms::ziAPIDiscoveryFind(ZIConnection, DeviceDescriptor.c_str(), &DeviceID);
 		CheckError(Result);
 		if (DeviceID)
 			DeviceDescriptor = DeviceID;	// To get rid of some trailing zeros.
+		NodePathCache.clear();
 		
-		Result = ZILabOneHardwareAdapterSyms::ziAPIDiscoveryGetValueS(ZIConnection, DeviceDescriptor.c_str(), "serveraddress", &ServerAddress);
+		Result = ZILabOneHardwareAdapterSyms::ziAPIDiscoveryGetValueS(ZIConnection, DeviceDescriptor.c_str(), "serveraddress", &ServerAddressStr);
 		CheckError(Result);
 		Result = ZILabOneHardwareAdapterSyms::ziAPIDiscoveryGetValueI(ZIConnection, DeviceDescriptor.c_str(), "serverport", &Port);
 		CheckError(Result);
-		Result = ZILabOneHardwareAdapterSyms::ziAPIDiscoveryGetValueI(ZIConnection, DeviceDescriptor.c_str(), "apilevel", &APILevel);
+		Result = ZILabOneHardwareAdapterSyms::ziAPIDiscoveryGetValueI(ZIConnection, DeviceDescriptor.c_str(), "apilevel", &APILevelNumber);
 		CheckError(Result);
-		Result = ZILabOneHardwareAdapterSyms::ziAPIConnectEx(ZIConnection, ServerAddress, static_cast<uint16_t>(Port),
-			static_cast<ZILabOneHardwareAdapterSyms::ZIAPIVersion_enum>(APILevel), nullptr);
+
+		// Stored to establish further connections for streaming.
+		ServerAddress = ServerAddressStr;
+		ServerPort = static_cast<uint16_t>(Port);
+		APILevel = static_cast<ZILabOneHardwareAdapterSyms::ZIAPIVersion_enum>(APILevelNumber);
+
+		Result = ZILabOneHardwareAdapterSyms::ziAPIConnectEx(ZIConnection, ServerAddress.c_str(), ServerPort, APILevel, nullptr);
 		CheckError(Result);
 
 		const char* Connected;
@@ -415,13 +525,15 @@ namespace DynExpHardware
 		
 		StopAcquisitionUnsafe();
 
-		Clockbase = ReadDoubleUnsafe("clockbase");
+		Clockbase = ReadDoubleUnsafe(NodeType::Clockbase);
 
 		Opened = true;
 	}
 
 	void ZILabOneHardwareAdapter::CloseUnsafe()
 	{
+		StopStreamingUnsafe();
+
 		if (IsOpened())
 		{
 			// Handles now considered invalid, even if disconnecting fails.
@@ -438,9 +550,9 @@ namespace DynExpHardware
 
 	void ZILabOneHardwareAdapter::ConfigureInputUnsafe(SignalInputType SignalInput, uint8_t Demodulator) const
 	{
-		WriteIntUnsafe("demods/" + Util::ToStr(Demodulator) + "/adcselect", SignalInput == SignalInputType::Current);
+		WriteIntUnsafe(NodeType::DemodADCSelect, Demodulator, SignalInput == SignalInputType::Current);
 		if (SignalInput != SignalInputType::Current)
-			WriteIntUnsafe(SignalInputTypeToCmdStr(SignalInput) + "/0/diff", SignalInput == SignalInputType::DifferentialVoltage);
+			WriteIntUnsafe(NodeType::InputDiff, static_cast<uint8_t>(SignalInput), SignalInput == SignalInputType::DifferentialVoltage);
 	}
 
 	void ZILabOneHardwareAdapter::StartAcquisitionUnsafe(uint8_t Demodulator, size_t NumSamples, size_t NumRuns, bool AverageRuns) const
@@ -600,6 +712,109 @@ namespace DynExpHardware
 		return Samples;
 	}
 
+	void ZILabOneHardwareAdapter::StartStreamingUnsafe(uint8_t Demodulator, size_t BufferSizeInSamples) const
+	{
+		StopStreamingUnsafe();
+
+		try
+		{
+			auto Result = ZILabOneHardwareAdapterSyms::ziAPIInit(&StreamConnection);
+			CheckError(Result);
+			Result = ZILabOneHardwareAdapterSyms::ziAPIConnectEx(StreamConnection, ServerAddress.c_str(), ServerPort, APILevel, nullptr);
+			CheckError(Result);
+
+			StreamNodePath = "/" + DeviceDescriptor + "/demods/" + Util::ToStr(Demodulator) + "/sample";
+			Result = ZILabOneHardwareAdapterSyms::ziAPISubscribe(StreamConnection, StreamNodePath.c_str());
+			CheckError(Result);
+
+			StreamEvent = ZILabOneHardwareAdapterSyms::ziAPIAllocateEventEx();
+			if (!StreamEvent)
+				ThrowExceptionUnsafe(std::make_exception_ptr(Util::NotAvailableException(
+					"Allocating an event for streaming demodulator samples failed.", Util::ErrorType::Error)));
+
+			// Only accessed by the reader thread from now on.
+			StreamReader = std::make_unique<ZILabOneDemodSampleReader>(std::max(BufferSizeInSamples, MinStreamBufferSizeInSamples),
+				[Connection = StreamConnection, Event = StreamEvent, Clockbase = static_cast<double>(Clockbase), Demodulator,
+				ZeroTimestamp = std::optional<ZILabOneHardwareAdapterSyms::ZITimeStamp>()](
+					std::vector<DynExpInstr::LockinAmplifierDefs::LockinSample>& Samples, std::chrono::milliseconds Timeout) mutable {
+				auto Result = ZILabOneHardwareAdapterSyms::ziAPIPollDataEx(Connection, Event, Util::NumToT<uint32_t>(Timeout.count()));
+				if (Result != ZILabOneHardwareAdapterSyms::ZI_INFO_SUCCESS)
+					throw ZILabOneException("Error polling demodulator samples.", Result);
+
+				// No new samples within timeout.
+				if (Event->valueType != ZILabOneHardwareAdapterSyms::ZI_VALUE_TYPE_DEMOD_SAMPLE)
+					return;
+
+				for (uint32_t i = 0; i < Event->count; ++i)
+				{
+					const auto& Sample = Event->value.demodSample[i];
+					if (!ZeroTimestamp)
+						ZeroTimestamp = Sample.timeStamp;
+
+					Samples.emplace_back(Demodulator, static_cast<double>(Sample.timeStamp - *ZeroTimestamp) / Clockbase,
+						DynExpInstr::LockinAmplifierDefs::LockinResultCartesian(Sample.x, Sample.y));
+				}
+			});
+		}
+		catch (...)
+		{
+			StopStreamingUnsafe();
+
+			throw;
+		}
+	}
+
+	void ZILabOneHardwareAdapter::StopStreamingUnsafe() const
+	{
+		// Joins the reader thread. Afterwards, the stream connection is not accessed concurrently anymore.
+		StreamReader.reset();
+
+		// Errors are ignored here since the stream connection is discarded anyway.
+		if (StreamEvent)
+			ZILabOneHardwareAdapterSyms::ziAPIDeallocateEventEx(StreamEvent);
+		StreamEvent = nullptr;
+
+		if (StreamConnection)
+		{
+			if (!StreamNodePath.empty())
+				ZILabOneHardwareAdapterSyms::ziAPIUnSubscribe(StreamConnection, StreamNodePath.c_str());
+			ZILabOneHardwareAdapterSyms::ziAPIDisconnect(StreamConnection);
+			ZILabOneHardwareAdapterSyms::ziAPIDestroy(StreamConnection);
+		}
+		StreamConnection = nullptr;
+		StreamNodePath.clear();
+	}
+
+	void ZILabOneHardwareAdapter::CheckStreamingErrorUnsafe() const
+	{
+		if (!StreamReader)
+			return;
+
+		auto Exception = StreamReader->GetException();
+		if (Exception)
+		{
+			StopStreamingUnsafe();
+			ThrowExceptionUnsafe(Exception);
+		}
+	}
+
+	void ZILabOneHardwareAdapter::ReadNodesUnsafe(std::span<NodeValueType> Nodes) const
+	{
+		for (auto& Node : Nodes)
+			Node.Value = IsIntegerNode(Node.Node) ? static_cast<double>(ReadIntUnsafe(Node.Node, Node.Index)) : ReadDoubleUnsafe(Node.Node, Node.Index);
+	}
+
+	void ZILabOneHardwareAdapter::WriteNodesUnsafe(std::span<const NodeValueType> Nodes) const
+	{
+		for (const auto& Node : Nodes)
+		{
+			if (IsIntegerNode(Node.Node))
+				WriteIntUnsafe(Node.Node, Node.Index, std::llround(Node.Value));
+			else
+				WriteDoubleUnsafe(Node.Node, Node.Index, Node.Value);
+		}
+	}
+
 	std::string ZILabOneHardwareAdapter::SignalInputTypeToCmdStr(SignalInputType SignalInput) const
 	{
 		switch (SignalInput)
@@ -611,17 +826,17 @@ namespace DynExpHardware
 
 	double ZILabOneHardwareAdapter::GetInputRangeUnsafe(SignalInputType SignalInput) const
 	{
-		return ReadDoubleUnsafe(SignalInputTypeToCmdStr(SignalInput) + "/0/range");
+		return ReadDoubleUnsafe(NodeType::InputRange, static_cast<uint8_t>(SignalInput));
 	}
 
 	void ZILabOneHardwareAdapter::SetInputRangeUnsafe(SignalInputType SignalInput, double InputRange) const
 	{
-		WriteDoubleUnsafe(SignalInputTypeToCmdStr(SignalInput) + "/0/range", InputRange);
+		WriteDoubleUnsafe(NodeType::InputRange, static_cast<uint8_t>(SignalInput), InputRange);
 	}
 
 	void ZILabOneHardwareAdapter::AutoAdjustInputRangeUnsafe(SignalInputType SignalInput) const
 	{
-		WriteIntUnsafe(SignalInputTypeToCmdStr(SignalInput) + "/0/autorange", 1);
+		WriteIntUnsafe(NodeType::InputAutoRange, static_cast<uint8_t>(SignalInput), 1);
 	}
 
 	bool ZILabOneHardwareAdapter::IsInputOverloadUnsafe(SignalInputType SignalInput) const
@@ -632,48 +847,48 @@ namespace DynExpHardware
 	double ZILabOneHardwareAdapter::GetNegInputLoadUnsafe(SignalInputType SignalInput) const
 	{
 		// Reading this value seems to take relatively much time.
-		return std::abs(ReadDoubleUnsafe(SignalInputTypeToCmdStr(SignalInput) + "/0/min"));
+		return std::abs(ReadDoubleUnsafe(NodeType::InputMin, static_cast<uint8_t>(SignalInput)));
 	}
 
 	double ZILabOneHardwareAdapter::GetPosInputLoadUnsafe(SignalInputType SignalInput) const
 	{
 		// Reading this value seems to take relatively much time.
-		return std::abs(ReadDoubleUnsafe(SignalInputTypeToCmdStr(SignalInput) + "/0/max"));
+		return std::abs(ReadDoubleUnsafe(NodeType::InputMax, static_cast<uint8_t>(SignalInput)));
 	}
 
 	double ZILabOneHardwareAdapter::GetDemodPhaseUnsafe(uint8_t Demodulator) const
 	{
-		return ReadDoubleUnsafe("demods/" + Util::ToStr(Demodulator) + "/phaseshift") / 180.0 * std::numbers::pi + std::numbers::pi;
+		return ReadDoubleUnsafe(NodeType::DemodPhaseShift, Demodulator) / 180.0 * std::numbers::pi + std::numbers::pi;
 	}
 
 	void ZILabOneHardwareAdapter::SetDemodPhaseUnsafe(uint8_t Demodulator, double Phase) const
 	{
-		WriteDoubleUnsafe("demods/" + Util::ToStr(Demodulator) + "/phaseshift", Phase / std::numbers::pi * 180.0 - 180.0);
+		WriteDoubleUnsafe(NodeType::DemodPhaseShift, Demodulator, Phase / std::numbers::pi * 180.0 - 180.0);
 	}
 
 	void ZILabOneHardwareAdapter::AutoAdjustDemodPhaseUnsafe(uint8_t Demodulator) const
 	{
-		WriteIntUnsafe("demods/" + Util::ToStr(Demodulator) + "/phaseadjust", 1);
+		WriteIntUnsafe(NodeType::DemodPhaseAdjust, Demodulator, 1);
 	}
 
 	double ZILabOneHardwareAdapter::GetDemodTimeConstantUnsafe(uint8_t Demodulator) const
 	{
-		return ReadDoubleUnsafe("demods/" + Util::ToStr(Demodulator) + "/timeconstant");
+		return ReadDoubleUnsafe(NodeType::DemodTimeConstant, Demodulator);
 	}
 
 	void ZILabOneHardwareAdapter::SetDemodTimeConstantUnsafe(uint8_t Demodulator, double TimeConstant) const
 	{
-		WriteDoubleUnsafe("demods/" + Util::ToStr(Demodulator) + "/timeconstant", TimeConstant);
+		WriteDoubleUnsafe(NodeType::DemodTimeConstant, Demodulator, TimeConstant);
 	}
 
 	uint8_t ZILabOneHardwareAdapter::GetDemodFilterOrderUnsafe(uint8_t Demodulator) const
 	{
-		return ReadIntUnsafe("demods/" + Util::ToStr(Demodulator) + "/order");
+		return ReadIntUnsafe(NodeType::DemodOrder, Demodulator);
 	}
 
 	void ZILabOneHardwareAdapter::SetDemodFilterOrderUnsafe(uint8_t Demodulator, uint8_t FilterOrder) const
 	{
-		WriteIntUnsafe("demods/" + Util::ToStr(Demodulator) + "/order", FilterOrder);
+		WriteIntUnsafe(NodeType::DemodOrder, Demodulator, FilterOrder);
 	}
 
 	DynExpInstr::LockinAmplifierDefs::TriggerModeType ZILabOneHardwareAdapter::GetTriggerModeUnsafe() const
@@ -733,56 +948,112 @@ namespace DynExpHardware
 
 	double ZILabOneHardwareAdapter::GetDemodSamplingRateUnsafe(uint8_t Demodulator) const
 	{
-		return ReadDoubleUnsafe("demods/" + Util::ToStr(Demodulator) + "/rate");
+		return ReadDoubleUnsafe(NodeType::DemodRate, Demodulator);
 	}
 
 	void ZILabOneHardwareAdapter::SetDemodSamplingRateUnsafe(uint8_t Demodulator, double SamplingRate) const
 	{
-		WriteDoubleUnsafe("demods/" + Util::ToStr(Demodulator) + "/rate", SamplingRate);
+		WriteDoubleUnsafe(NodeType::DemodRate, Demodulator, SamplingRate);
 	}
 
 	bool ZILabOneHardwareAdapter::GetEnabledUnsafe(uint8_t Demodulator) const
 	{
-		return ReadIntUnsafe("demods/" + Util::ToStr(Demodulator) + "/enable");
+		return ReadIntUnsafe(NodeType::DemodEnable, Demodulator);
 	}
 
 	void ZILabOneHardwareAdapter::SetEnabledUnsafe(uint8_t Demodulator, bool Enabled) const
 	{
-		WriteIntUnsafe("demods/" + Util::ToStr(Demodulator) + "/enable", Enabled);
+		WriteIntUnsafe(NodeType::DemodEnable, Demodulator, Enabled);
 	}
 
 	double ZILabOneHardwareAdapter::GetOscillatorFrequencyUnsafe(uint8_t Oscillator) const
 	{
-		return ReadDoubleUnsafe("oscs/" + Util::ToStr(Oscillator) + "/freq");
+		return ReadDoubleUnsafe(NodeType::OscFreq, Oscillator);
+	}
+
+	bool ZILabOneHardwareAdapter::IsIntegerNode(NodeType Node) noexcept
+	{
+		switch (Node)
+		{
+		case NodeType::InputAutoRange:
+		case NodeType::InputDiff:
+		case NodeType::DemodADCSelect:
+		case NodeType::DemodPhaseAdjust:
+		case NodeType::DemodOrder:
+		case NodeType::DemodEnable:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	std::string ZILabOneHardwareAdapter::MakeNodePath(NodeType Node, uint8_t Index) const
+	{
+		const auto InputPath = [this, Index](const char* Name) {
+			return "/" + DeviceDescriptor + "/" + SignalInputTypeToCmdStr(static_cast<SignalInputType>(Index)) + "/0/" + Name;
+		};
+		const auto DemodPath = [this, Index](const char* Name) {
+			return "/" + DeviceDescriptor + "/demods/" + Util::ToStr(Index) + "/" + Name;
+		};
+
+		switch (Node)
+		{
+		case NodeType::InputRange: return InputPath("range");
+		case NodeType::InputAutoRange: return InputPath("autorange");
+		case NodeType::InputDiff: return InputPath("diff");
+		case NodeType::InputMin: return InputPath("min");
+		case NodeType::InputMax: return InputPath("max");
+		case NodeType::DemodADCSelect: return DemodPath("adcselect");
+		case NodeType::DemodPhaseShift: return DemodPath("phaseshift");
+		case NodeType::DemodPhaseAdjust: return DemodPath("phaseadjust");
+		case NodeType::DemodTimeConstant: return DemodPath("timeconstant");
+		case NodeType::DemodOrder: return DemodPath("order");
+		case NodeType::DemodRate: return DemodPath("rate");
+		case NodeType::DemodEnable: return DemodPath("enable");
+		case NodeType::OscFreq: return "/" + DeviceDescriptor + "/oscs/" + Util::ToStr(Index) + "/freq";
+		case NodeType::Clockbase: return "/" + DeviceDescriptor + "/clockbase";
+		default: throw Util::InvalidArgException("The given node is invalid.");
+		}
+	}
+
+	const std::string& ZILabOneHardwareAdapter::GetNodePathUnsafe(NodeType Node, uint8_t Index) const
+	{
+		const auto Key = static_cast<uint16_t>((static_cast<uint16_t>(Node) << 8) | Index);
+
+		auto It = NodePathCache.find(Key);
+		if (It == NodePathCache.cend())
+			It = NodePathCache.emplace(Key, MakeNodePath(Node, Index)).first;
+
+		return It->second;
 	}
 
-	double ZILabOneHardwareAdapter::ReadDoubleUnsafe(const std::string& Path) const
+	double ZILabOneHardwareAdapter::ReadDoubleUnsafe(NodeType Node, uint8_t Index) const
 	{
 		ZILabOneHardwareAdapterSyms::ZIDoubleData Data;
-		auto Result = ZILabOneHardwareAdapterSyms::ziAPIGetValueD(ZIConnection, ("/" + DeviceDescriptor + "/" + Path).c_str(), &Data);
+		auto Result = ZILabOneHardwareAdapterSyms::ziAPIGetValueD(ZIConnection, GetNodePathUnsafe(Node, Index).c_str(), &Data);
 		CheckError(Result);
 
 		return static_cast<double>(Data);
 	}
 
-	long long ZILabOneHardwareAdapter::ReadIntUnsafe(const std::string& Path) const
+	long long ZILabOneHardwareAdapter::ReadIntUnsafe(NodeType Node, uint8_t Index) const
 	{
 		ZILabOneHardwareAdapterSyms::ZIIntegerData Data;
-		auto Result = ZILabOneHardwareAdapterSyms::ziAPIGetValueI(ZIConnection, ("/" + DeviceDescriptor + "/" + Path).c_str(), &Data);
+		auto Result = ZILabOneHardwareAdapterSyms::ziAPIGetValueI(ZIConnection, GetNodePathUnsafe(Node, Index).c_str(), &Data);
 		CheckError(Result);
 
 		return static_cast<long long>(Data);
 	}
 
-	void ZILabOneHardwareAdapter::WriteDoubleUnsafe(const std::string& Path, double Value) const
+	void ZILabOneHardwareAdapter::WriteDoubleUnsafe(NodeType Node, uint8_t Index, double Value) const
 	{
-		auto Result = ZILabOneHardwareAdapterSyms::ziAPISetValueD(ZIConnection, ("/" + DeviceDescriptor + "/" + Path).c_str(), Value);
+		auto Result = ZILabOneHardwareAdapterSyms::ziAPISetValueD(ZIConnection, GetNodePathUnsafe(Node, Index).c_str(), Value);
 		CheckError(Result);
 	}
 
-	void ZILabOneHardwareAdapter::WriteIntUnsafe(const std::string& Path, long long Value) const
+	void ZILabOneHardwareAdapter::WriteIntUnsafe(NodeType Node, uint8_t Index, long long Value) const
 	{
-		auto Result = ZILabOneHardwareAdapterSyms::ziAPISetValueI(ZIConnection, ("/" + DeviceDescriptor + "/" + Path).c_str(), Value);
+		auto Result = ZILabOneHardwareAdapterSyms::ziAPISetValueI(ZIConnection, GetNodePathUnsafe(Node, Index).c_str(), Value);
 		CheckError(Result);
 	}
 }
\ No newline at end of file
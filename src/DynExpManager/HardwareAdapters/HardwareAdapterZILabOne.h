@@ -11,6 +11,7 @@
 #include "stdafx.h"
 #include "HardwareAdapter.h"
 #include "../MetaInstruments/LockinAmplifier.h"
+#include "ZILabOneDemodSampleReader.h"
 
 #undef DEPRECATED
 namespace DynExpHardware::ZILabOneHardwareAdapterSyms
@@ -69,7 +70,47 @@ namespace DynExpHardware
 		using ConfigType = ZILabOneHardwareAdapterConfigurator;
 
 		enum SignalInputType { Voltage, DifferentialVoltage, Current };
-		
+		enum AcquisitionModeType { DataAcquisitionModule, Streaming };
+
+		/**
+		 * @brief Settings and status nodes of the instrument. Full node paths are built once and cached.
+		 * Input nodes are indexed by @p SignalInputType, demodulator nodes by the demodulator, and
+		 * oscillator nodes by the oscillator.
+		*/
+		enum class NodeType : uint8_t {
+			InputRange, InputAutoRange, InputDiff, InputMin, InputMax,
+			DemodADCSelect, DemodPhaseShift, DemodPhaseAdjust, DemodTimeConstant, DemodOrder, DemodRate, DemodEnable,
+			OscFreq, Clockbase
+		};
+
+		/**
+		 * @brief Node and value to read or write by ReadNodes() or WriteNodes().
+		*/
+		struct NodeValueType
+		{
+			NodeType Node;
+			uint8_t Index = 0;
+			double Value = 0;		//!< Integer nodes are converted from/to double.
+		};
+
+		/**
+		 * @brief Status of a signal input and a demodulator as read by GetDemodStatus()
+		*/
+		struct DemodStatusType
+		{
+			double InputRange{};
+			double NegInputLoad{};
+			double PosInputLoad{};
+			double Phase{};				//!< in rad
+			double TimeConstant{};		//!< in s
+			uint8_t FilterOrder{};
+			double SamplingRate{};		//!< in samples/s
+			bool Enabled{};
+			double OscillatorFrequency{};	//!< in Hz of oscillator 0
+		};
+
+		static constexpr size_t MinStreamBufferSizeInSamples = 1 << 16;	//!< Minimal capacity of the ring buffer samples are streamed into
+
 		constexpr static bool DetermineOverload(double PosInputLoad, double NegInputLoad) { return PosInputLoad > 0.95 || NegInputLoad < -0.95; }
 
 		constexpr static auto Name() noexcept { return "ZI LabOne"; }
@@ -97,6 +138,18 @@ namespace DynExpHardware
 		void ClearAcquiredData() const;
 		std::vector<DynExpInstr::LockinAmplifierDefs::LockinSample> GetAcquiredData() const;
 
+		// Continuous streaming of demodulator samples by subscribing to the demodulator's sample node
+		void StartStreaming(uint8_t Demodulator, size_t BufferSizeInSamples) const;
+		void StopStreaming() const;
+		bool IsStreaming() const;
+		void ClearStreamedData() const;
+		std::vector<DynExpInstr::LockinAmplifierDefs::LockinSample> GetStreamedData() const;
+
+		// Reading or writing multiple nodes acquiring the lock only once
+		void ReadNodes(std::span<NodeValueType> Nodes) const;
+		void WriteNodes(std::span<const NodeValueType> Nodes) const;
+		DemodStatusType GetDemodStatus(SignalInputType SignalInput, uint8_t Demodulator) const;
+
 		double GetInputRange(SignalInputType SignalInput) const;
 		void SetInputRange(SignalInputType SignalInput, double InputRange) const;
 		void AutoAdjustInputRange(SignalInputType SignalInput) const;
@@ -160,6 +213,13 @@ namespace DynExpHardware
 		void ClearAcquiredDataUnsafe() const;
 		std::vector<DynExpInstr::LockinAmplifierDefs::LockinSample> GetAcquiredDataUnsafe() const;
 
+		void StartStreamingUnsafe(uint8_t Demodulator, size_t BufferSizeInSamples) const;
+		void StopStreamingUnsafe() const;
+		void CheckStreamingErrorUnsafe() const;
+
+		void ReadNodesUnsafe(std::span<NodeValueType> Nodes) const;
+		void WriteNodesUnsafe(std::span<const NodeValueType> Nodes) const;
+
 		std::string SignalInputTypeToCmdStr(SignalInputType SignalInput) const;
 		double GetInputRangeUnsafe(SignalInputType SignalInput) const;
 		void SetInputRangeUnsafe(SignalInputType SignalInput, double InputRange) const;
@@ -192,10 +252,14 @@ namespace DynExpHardware
 
 		double GetOscillatorFrequencyUnsafe(uint8_t Oscillator) const;
 
-		double ReadDoubleUnsafe(const std::string& Path) const;
-		long long ReadIntUnsafe(const std::string& Path) const;
-		void WriteDoubleUnsafe(const std::string& Path, double Value) const;
-		void WriteIntUnsafe(const std::string& Path, long long Value) const;
+		static bool IsIntegerNode(NodeType Node) noexcept;
+		std::string MakeNodePath(NodeType Node, uint8_t Index) const;
+		const std::string& GetNodePathUnsafe(NodeType Node, uint8_t Index) const;
+
+		double ReadDoubleUnsafe(NodeType Node, uint8_t Index = 0) const;
+		long long ReadIntUnsafe(NodeType Node, uint8_t Index = 0) const;
+		void WriteDoubleUnsafe(NodeType Node, uint8_t Index, double Value) const;
+		void WriteIntUnsafe(NodeType Node, uint8_t Index, long long Value) const;
 
 		ZILabOneHardwareAdapterSyms::ZIConnection ZIConnection;
 		ZILabOneHardwareAdapterSyms::ZIModuleHandle DAQModuleHandle;
@@ -203,6 +267,19 @@ namespace DynExpHardware
 		std::atomic<bool> Opened;
 		std::string DeviceDescriptor;
 		std::string Interface;
+		std::string ServerAddress;
+		uint16_t ServerPort;
+		ZILabOneHardwareAdapterSyms::ZIAPIVersion_enum APILevel;
 		int Clockbase;
+
+		// Full node paths indexed by (NodeType << 8) | Index. Cleared when (re)connecting.
+		mutable std::unordered_map<uint16_t, std::string> NodePathCache;
+
+		// ziAPI connections must not be shared across threads. So, streaming uses its own connection
+		// which is only accessed by StreamReader's thread while streaming.
+		mutable ZILabOneHardwareAdapterSyms::ZIConnection StreamConnection = nullptr;
+		mutable ZILabOneHardwareAdapterSyms::ZIEvent* StreamEvent = nullptr;
+		mutable std::string StreamNodePath;
+		mutable std::unique_ptr<ZILabOneDemodSampleReader> StreamReader;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+// This file is part of DynExp.
+
+#include "stdafx.h"
+#include "ZILabOneDemodSampleReader.h"
+
+namespace DynExpHardware
+{
+	ZILabOneDemodSampleReader::ZILabOneDemodSampleReader(size_t BufferSizeInSamples, PollFunctionType PollFunction)
+		: Buffer(BufferSizeInSamples), PollFunction(std::move(PollFunction)),
+		ReaderThread([this](std::stop_token StopToken) { ReaderThreadMain(StopToken); })
+	{
+	}
+
+	void ZILabOneDemodSampleReader::Stop()
+	{
+		ReaderThread.request_stop();
+		if (ReaderThread.joinable())
+			ReaderThread.join();
+	}
+
+	std::exception_ptr ZILabOneDemodSampleReader::GetException() const
+	{
+		std::lock_guard<decltype(ExceptionMutex)> lock(ExceptionMutex);
+
+		return Exception;
+	}
+
+	void ZILabOneDemodSampleReader::ReaderThreadMain(std::stop_token StopToken)
+	{
+		// Reused for every poll. So, it does not allocate memory anymore after having grown to the
+		// maximal amount of samples received at once.
+		std::vector<SampleType> Samples;
+
+		try
+		{
+			while (!StopToken.stop_requested())
+			{
+				Samples.clear();
+				PollFunction(Samples, PollTimeout);
+
+				for (const auto& Sample : Samples)
+					if (!Buffer.Push(Sample))
+						++NumOverruns;
+			}
+		}
+		catch (...)
+		{
+			std::lock_guard<decltype(ExceptionMutex)> lock(ExceptionMutex);
+
+			Exception = std::current_exception();
+		}
+
+		Running = false;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+// This file is part of DynExp.
+
+/**
+ * @file ZILabOneDemodSampleReader.h
+ * @brief Implementation of a reader thread streaming demodulator samples of Zurich Instruments
+ * lock-in amplifiers into a ring buffer. Does not depend on ziAPI.
+*/
+
+#pragma once
+
+#include "stdafx.h"
+#include "../MetaInstruments/LockinAmplifier.h"
+
+namespace DynExpHardware
+{
+	/**
+	 * @brief Continuously reads lock-in samples in a dedicated reader thread into a preallocated
+	 * lock-free ring buffer. The reader thread repeatedly calls a poll function which waits for new
+	 * samples from the data server. The poll function is the only part depending on ziAPI. So, it
+	 * can be replaced by a fake one generating samples without any hardware being present.
+	*/
+	class ZILabOneDemodSampleReader : public Util::INonCopyable
+	{
+	public:
+		using SampleType = DynExpInstr::LockinAmplifierDefs::LockinSample;
+
+		/**
+		 * @brief Function waiting at most for the given timeout for new samples and appending them to the given
+		 * vector. Called by the reader thread only. Exceptions thrown by the function terminate the reader thread.
+		*/
+		using PollFunctionType = std::function<void(std::vector<SampleType>&, std::chrono::milliseconds)>;
+
+		static constexpr std::chrono::milliseconds PollTimeout{ 50 };	//!< Timeout passed to #PollFunction
+
+		/**
+		 * @brief Constructs a @p ZILabOneDemodSampleReader instance and starts the reader thread.
+		 * @param BufferSizeInSamples Capacity of #Buffer
+		 * @param PollFunction @copybrief #PollFunction
+		*/
+		ZILabOneDemodSampleReader(size_t BufferSizeInSamples, PollFunctionType PollFunction);
+
+		/**
+		 * @brief Stops the reader thread and waits for it to terminate. Refer to Stop().
+		*/
+		~ZILabOneDemodSampleReader() { Stop(); }
+
+		/**
+		 * @brief Requests the reader thread to stop and waits for it to terminate. This takes at most
+		 * as long as a single call to #PollFunction. Samples read before can still be obtained by Read().
+		 * Must not be called from the reader thread.
+		*/
+		void Stop();
+
+		/**
+		 * @brief Moves all samples read so far to @p Samples. Must only be called by a single thread at a time.
+		 * @param Samples Vector to append the samples to
+		 * @return Returns the amount of appended samples.
+		*/
+		size_t Read(std::vector<SampleType>& Samples) { return Buffer.PopAll(Samples); }
+
+		/**
+		 * @brief Discards all samples read so far. Must not be called concurrently with Read().
+		*/
+		void Clear() noexcept { Buffer.Clear(); }
+
+		bool IsRunning() const noexcept { return Running; }						//!< Returns whether the reader thread is still polling samples.
+		size_t GetNumOverruns() const noexcept { return NumOverruns; }			//!< Returns the amount of samples dropped since #Buffer was full.
+		std::exception_ptr GetException() const;									//!< Returns the exception which terminated the reader thread (if any).
+
+	private:
+		void ReaderThreadMain(std::stop_token StopToken);
+
+		Util::SPSCRingBuffer<SampleType> Buffer;		//!< Samples read by the reader thread and not read by the consumer yet
+		const PollFunctionType PollFunction;			//!< Function polling new samples from the data server
+
+		std::atomic<bool> Running = true;				//!< Indicates whether the reader thread is still polling samples.
+		std::atomic<size_t> NumOverruns = 0;			//!< Amount of samples dropped since #Buffer was full
+
+		mutable std::mutex ExceptionMutex;				//!< Guards #Exception
+		std::exception_ptr Exception;					//!< Exception which terminated the reader thread
+
+		std::jthread ReaderThread;						//!< Thread calling #PollFunction. Declared last to start after all other members have been initialized.
+	};
+}
\ No newline at end of file
@@ -460,6 +460,9 @@ namespace DynExp
 				// Swallow exceptions possibly thrown by CallbackFunc to prevent them leave the destructor.
 			}
 		}
+
+		// Does not have any effect if the future has already been completed by Run().
+		CompleteFuture({});
 	}
 
 	bool TaskBase::IsLocked() const noexcept
@@ -498,6 +501,7 @@ namespace DynExp
 				ExceptionContainer Exception;
 				CallbackFunc(*this, Exception);
 			}
+			CompleteFuture({});
 
 			return Result.ShouldContinue();
 		}
@@ -508,16 +512,154 @@ namespace DynExp
 
 			ExceptionContainer Exception(std::current_exception());
 			if (CallbackFunc)
-			{
 				CallbackFunc(*this, Exception);
-				if (!Exception.IsError())
-					return true;
-			}
+			CompleteFuture(Exception);
+
+			if (CallbackFunc && !Exception.IsError())
+				return true;
 
 			throw;
 		}
 	}
 
+	std::shared_ptr<TaskFutureState> TaskBase::MakeFutureState()
+	{
+		FutureState = std::make_shared<TaskFutureState>();
+
+		return FutureState;
+	}
+
+	void TaskBase::CompleteFuture(const ExceptionContainer& Exception) noexcept
+	{
+		if (FutureState)
+			FutureState->Complete(State, ErrorCode, Exception);
+	}
+
+	void TaskFutureState::Complete(TaskBase::TaskState State, int ErrorCode, const ExceptionContainer& Exception) noexcept
+	{
+		decltype(Continuations) ContinuationsToCall;
+
+		{
+			std::lock_guard<decltype(Mutex)> lock(Mutex);
+
+			if (Completed)
+				return;
+
+			this->State = State;
+			this->ErrorCode = ErrorCode;
+			this->Exception = Exception;
+			Completed = true;
+			ContinuationsToCall.swap(Continuations);
+		}
+
+		CompletedCV.notify_all();
+
+		// Call continuations with Mutex unlocked since they might query this future.
+		for (const auto& Continuation : ContinuationsToCall)
+		{
+			try
+			{
+				Continuation();
+			}
+			catch (...)
+			{
+				// Swallow exceptions since they cannot be handled by the thread completing the task.
+			}
+		}
+	}
+
+	bool TaskFuture::IsReady() const
+	{
+		if (!State)
+			throw Util::InvalidStateException("A task future which does not refer to a task cannot be queried.");
+
+		std::lock_guard<decltype(State->Mutex)> lock(State->Mutex);
+
+		return State->Completed;
+	}
+
+	void TaskFuture::Wait() const
+	{
+		WaitUnsafe();
+	}
+
+	bool TaskFuture::WaitFor(const std::chrono::milliseconds Timeout) const
+	{
+		if (!State)
+			throw Util::InvalidStateException("A task future which does not refer to a task cannot be waited for.");
+
+		std::unique_lock<decltype(State->Mutex)> lock(State->Mutex);
+
+		return State->CompletedCV.wait_for(lock, Timeout, [this]() { return State->Completed; });
+	}
+
+	ExceptionContainer TaskFuture::Get() const
+	{
+		auto lock = WaitUnsafe();
+
+		return State->Exception;
+	}
+
+	TaskBase::TaskState TaskFuture::GetState() const
+	{
+		auto lock = WaitUnsafe();
+
+		return State->State;
+	}
+
+	int TaskFuture::GetErrorCode() const
+	{
+		auto lock = WaitUnsafe();
+
+		return State->ErrorCode;
+	}
+
+	void TaskFuture::Then(std::function<void()> Continuation) const
+	{
+		if (!State)
+			throw Util::InvalidStateException("A continuation cannot be attached to a task future which does not refer to a task.");
+
+		{
+			std::lock_guard<decltype(State->Mutex)> lock(State->Mutex);
+
+			if (!State->Completed)
+			{
+				State->Continuations.push_back(std::move(Continuation));
+				return;
+			}
+		} // State->Mutex unlocked here.
+
+		Continuation();
+	}
+
+	ExceptionContainer TaskFuture::WaitAll(std::span<const TaskFuture> Futures)
+	{
+		ExceptionContainer FirstException;
+
+		for (const auto& Future : Futures)
+		{
+			if (!Future.IsValid())
+				continue;
+
+			auto Exception = Future.Get();
+			if (!FirstException.IsError())
+				FirstException = Exception;
+		}
+
+		return FirstException;
+	}
+
+	std::unique_lock<std::mutex> TaskFuture::WaitUnsafe() const
+	{
+		if (!State)
+			throw Util::InvalidStateException("A task future which does not refer to a task cannot be waited for.");
+
+		std::unique_lock<decltype(State->Mutex)> lock(State->Mutex);
+		State->CompletedCV.wait(lock, [this]() { return State->Completed; });
+
+		return lock;
+	}
+
 	TaskResultType InitTaskBase::RunChild(InstrumentInstance& Instance)
 	{
 		InitFuncImpl(dispatch_tag<InitTaskBase>(), Instance);
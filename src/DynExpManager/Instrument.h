@@ -16,6 +16,8 @@ namespace DynExp
 	class InstrumentInstance;
 	class ExceptionContainer;
 	class TaskBase;
+	class TaskFutureState;
+	class TaskFuture;
 	class InitTaskBase;
 	class ExitTaskBase;
 	class UpdateTaskBase;
@@ -622,22 +624,33 @@ namespace DynExp
 		 * @tparam TaskT Type of a task derived from class @p TaskBase
 		 * @tparam ...ArgTs Types of the arguments to forward to the task's constructor
 		 * @param ...Args Arguments to forward to the task's constructor
+		 * @return Returns a @p TaskFuture becoming ready when the task has been executed or aborted.
+		 * The result may be discarded.
 		*/
 		template <typename TaskT, typename... ArgTs>
-		void MakeAndEnqueueTask(ArgTs&& ...Args) const
-		{
-			auto Task = MakeTask<TaskT>(std::forward<ArgTs>(Args)...);
-
-			// Locks InstrumentData
-			GetNonConstInstrumentData()->InstrumentBaseOnly.EnqueueTask(std::move(Task), IsCallFromRunnableThread(), true);
-		}
+		TaskFuture MakeAndEnqueueTask(ArgTs&& ...Args) const;
 
 	public:
+		/**
+		 * @brief Calls a (derived) instrument's function which inserts a task into the instrument's task queue
+		 * asynchronously. A callback function is passed to the task which completes the returned @p TaskFuture
+		 * after the task execution. This allows a module to enqueue tasks into several instruments and to wait
+		 * for all of them afterwards (refer to TaskFuture::WaitAll()) instead of serializing the tasks.
+		 * @tparam DerivedInstrT Instrument type (derived from class @p InstrumentBase).
+		 * @tparam ...TaskFuncArgTs Types the task inserting function expects as arguments.
+		 * @tparam ...ArgTs Types of the arguments passed to @p AsAsyncTask().
+		 * @param TaskFunc Member function pointer to (derived) instrument's task-inserting function.
+		 * @param ...Args  Arguments to be perfectly forwarded to the task function.
+		 * @return Returns a @p TaskFuture becoming ready when the task has been executed or aborted.
+		*/
+		template <typename DerivedInstrT, typename... TaskFuncArgTs, typename... ArgTs>
+		TaskFuture AsAsyncTask(void (DerivedInstrT::* TaskFunc)(TaskFuncArgTs...) const, ArgTs&& ...Args) const;
+
 		/**
 		 * @brief Calls a (derived) instrument's function which inserts a task into the instrument's task queue
 		 * synchronously. This means that @p AsSyncTask() blocks until the task has been executed or aborted.
-		 * This is achieved by passing a callback function to the task which in turn sets a flag after the task
-		 * execution. The thread calling @p AsSyncTask() blocks (via @p std::this_thread::yield()) until this flag is set.
+		 * This is achieved by waiting for the @p TaskFuture returned by @p AsAsyncTask(). The calling thread
+		 * sleeps while waiting.
 		 * @tparam DerivedInstrT Instrument type (derived from class @p InstrumentBase).
 		 * @tparam ...TaskFuncArgTs Types the task inserting function expects as arguments.
 		 * @tparam ...ArgTs Types of the arguments passed to @p AsSyncTask().
@@ -646,24 +659,7 @@ namespace DynExp
 		 * @return Return the exception possibly thrown by the task.
 		*/
 		template <typename DerivedInstrT, typename... TaskFuncArgTs, typename... ArgTs>
-		ExceptionContainer AsSyncTask(void (DerivedInstrT::* TaskFunc)(TaskFuncArgTs...) const, ArgTs&& ...Args) const
-		{
-			std::atomic<bool> FinishedFlag = false;
-			ExceptionContainer Exception;
-			auto CallbackFunc = [&FinishedFlag, &Exception](const TaskBase& Task, auto E) {
-				Exception = E;
-
-				// Must come last!
-				FinishedFlag = true;
-			};
-
-			(dynamic_cast<const DerivedInstrT&>(*this).*TaskFunc)(std::forward<ArgTs>(Args)..., CallbackFunc);
-
-			while (!FinishedFlag)
-				std::this_thread::yield();
-
-			return Exception;
-		}
+		ExceptionContainer AsSyncTask(void (DerivedInstrT::* TaskFunc)(TaskFuncArgTs...) const, ArgTs&& ...Args) const;
 
 	private:
 		/** @name Instrument thread only
@@ -906,6 +902,7 @@ namespace DynExp
 
 			void Lock() { Parent.Lock(); }													//!< @copydoc TaskBase::Lock
 			bool Run(InstrumentInstance& Instance) { return Parent.Run(Instance); }			//!< @copydoc TaskBase::Run
+			auto MakeFutureState() { return Parent.MakeFutureState(); }						//!< @copydoc TaskBase::MakeFutureState
 
 			TaskBase& Parent;		//!< Owning @p TaskBase instance
 		};
@@ -982,7 +979,8 @@ namespace DynExp
 
 		/**
 		 * @brief The destructor aborts a waiting task setting #State to TaskState::Aborted. Then, it
-		 * calls #CallbackFunc with a default-constructed @p ExceptionContainer instance.
+		 * calls #CallbackFunc with a default-constructed @p ExceptionContainer instance. Finally, it
+		 * completes #FutureState if this has not happened before.
 		*/
 		virtual ~TaskBase() = 0;
 
@@ -1049,6 +1047,18 @@ namespace DynExp
 		*/
 		bool Run(InstrumentInstance& Instance);
 
+		/**
+		 * @brief Creates #FutureState to be shared with a @p TaskFuture. Call before enqueueing the task.
+		 * @return Returns #FutureState.
+		*/
+		std::shared_ptr<TaskFutureState> MakeFutureState();
+
+		/**
+		 * @brief Completes #FutureState (if it exists) with the task's current state and error code.
+		 * @param Exception Exception which occurred while executing the task
+		*/
+		void CompleteFuture(const ExceptionContainer& Exception) noexcept;
+
 		/** @name Override
 		 * Override by derived classes.
 		*/
@@ -1071,6 +1081,12 @@ namespace DynExp
 		*/
 		const CallbackType CallbackFunc;
 
+		/**
+		 * @brief State shared with the @p TaskFuture returned by InstrumentBase::MakeAndEnqueueTask().
+		 * Completed after #CallbackFunc has been called. Might be @p nullptr.
+		*/
+		std::shared_ptr<TaskFutureState> FutureState;
+
 		/** @name Instrument-to-other communication
 		 * These variables are for communication from the instrument thread to other thread(s) only.
 		*/
@@ -1087,9 +1103,167 @@ namespace DynExp
 		///@}
 	};
 
+	/**
+	 * @brief State shared between a task (or a task's callback function) and the @p TaskFuture
+	 * instances waiting for the task's completion.
+	*/
+	class TaskFutureState : public Util::INonCopyable
+	{
+	public:
+		TaskFutureState() = default;
+
+		/**
+		 * @brief Stores the task's result, wakes up all threads waiting for it, and calls all continuations
+		 * registered by TaskFuture::Then(). Only the first call has an effect. Thread-safe.
+		 * @param State Final state of the task
+		 * @param ErrorCode Error code of the task
+		 * @param Exception Exception which occurred while executing the task
+		*/
+		void Complete(TaskBase::TaskState State, int ErrorCode, const ExceptionContainer& Exception) noexcept;
+
+	private:
+		friend class TaskFuture;
+
+		mutable std::mutex Mutex;						//!< Mutex guarding all members
+		mutable std::condition_variable CompletedCV;	//!< Notified when the task has completed
+		bool Completed = false;							//!< Indicates whether the task has completed
+		TaskBase::TaskState State = TaskBase::TaskState::Waiting;	//!< Final state of the task
+		int ErrorCode = 0;								//!< Error code of the task
+		ExceptionContainer Exception;					//!< Exception which occurred while executing the task
+		std::vector<std::function<void()>> Continuations;	//!< Functions to call when the task has completed
+	};
+
+	/**
+	 * @brief Lightweight future referring to the completion of an instrument's task. Returned by
+	 * InstrumentBase::MakeAndEnqueueTask() and InstrumentBase::AsAsyncTask(). Waiting functions put
+	 * the calling thread to sleep. Instances can be copied and shared among threads.
+	*/
+	class TaskFuture
+	{
+	public:
+		/**
+		 * @brief Constructs an invalid @p TaskFuture not referring to any task.
+		*/
+		TaskFuture() = default;
+
+		/**
+		 * @brief Constructs a @p TaskFuture referring to @p State.
+		 * @param State @copybrief #State
+		*/
+		explicit TaskFuture(std::shared_ptr<TaskFutureState> State) noexcept : State(std::move(State)) {}
+
+		/**
+		 * @brief Determines whether this @p TaskFuture refers to a task.
+		 * @return Returns true if #State is not @p nullptr, false otherwise.
+		*/
+		bool IsValid() const noexcept { return static_cast<bool>(State); }
+
+		/**
+		 * @brief Determines whether the task has completed without blocking.
+		 * @return Returns true if the task has been executed or aborted, false otherwise.
+		 * @throws Util::InvalidStateException is thrown if the @p TaskFuture is invalid.
+		*/
+		bool IsReady() const;
+
+		/**
+		 * @brief Blocks until the task has been executed or aborted.
+		 * @throws Util::InvalidStateException is thrown if the @p TaskFuture is invalid.
+		*/
+		void Wait() const;
+
+		/**
+		 * @brief Blocks until the task has been executed or aborted or until @p Timeout has elapsed.
+		 * @param Timeout Maximal time to wait
+		 * @return Returns true if the task has completed, false if the wait has timed out.
+		 * @throws Util::InvalidStateException is thrown if the @p TaskFuture is invalid.
+		*/
+		bool WaitFor(const std::chrono::milliseconds Timeout) const;
+
+		/**
+		 * @brief Blocks until the task has been executed or aborted.
+		 * @return Returns the exception possibly thrown by the task.
+		 * @throws Util::InvalidStateException is thrown if the @p TaskFuture is invalid.
+		*/
+		ExceptionContainer Get() const;
+
+		/**
+		 * @brief Blocks until the task has been executed or aborted.
+		 * @return Returns the task's final state (TaskBase::TaskState::Finished, TaskBase::TaskState::Failed,
+		 * or TaskBase::TaskState::Aborted).
+		 * @throws Util::InvalidStateException is thrown if the @p TaskFuture is invalid.
+		*/
+		TaskBase::TaskState GetState() const;
+
+		/**
+		 * @brief Blocks until the task has been executed or aborted.
+		 * @return Returns the task's error code (refer to TaskBase::GetErrorCode()).
+		 * @throws Util::InvalidStateException is thrown if the @p TaskFuture is invalid.
+		*/
+		int GetErrorCode() const;
+
+		/**
+		 * @brief Registers a function to be called once the task has been executed or aborted. If this has
+		 * already happened, @p Continuation is called immediately by the calling thread. Otherwise, it is
+		 * called by the thread completing the task (usually the instrument thread). So, @p Continuation must
+		 * return quickly and must not block. Exceptions leaving @p Continuation are ignored.
+		 * @param Continuation Function to call
+		 * @throws Util::InvalidStateException is thrown if the @p TaskFuture is invalid.
+		*/
+		void Then(std::function<void()> Continuation) const;
+
+		/**
+		 * @brief Blocks until all tasks referred to by @p Futures have been executed or aborted.
+		 * Invalid futures are ignored.
+		 * @param Futures Futures to wait for
+		 * @return Returns the first exception thrown by one of the tasks (in the order of @p Futures).
+		*/
+		static ExceptionContainer WaitAll(std::span<const TaskFuture> Futures);
+
+	private:
+		/**
+		 * @brief Blocks until the task has completed.
+		 * @return Returns a lock on TaskFutureState::Mutex.
+		 * @throws Util::InvalidStateException is thrown if the @p TaskFuture is invalid.
+		*/
+		std::unique_lock<std::mutex> WaitUnsafe() const;
+
+		std::shared_ptr<TaskFutureState> State;		//!< State shared with the task
+	};
+
+	template <typename TaskT, typename... ArgTs>
+	TaskFuture InstrumentBase::MakeAndEnqueueTask(ArgTs&& ...Args) const
+	{
+		auto Task = MakeTask<TaskT>(std::forward<ArgTs>(Args)...);
+		TaskFuture Future(Task->InstrumentBaseOnly.MakeFutureState());
+
+		// Locks InstrumentData
+		GetNonConstInstrumentData()->InstrumentBaseOnly.EnqueueTask(std::move(Task), IsCallFromRunnableThread(), true);
+
+		return Future;
+	}
+
+	template <typename DerivedInstrT, typename... TaskFuncArgTs, typename... ArgTs>
+	TaskFuture InstrumentBase::AsAsyncTask(void (DerivedInstrT::* TaskFunc)(TaskFuncArgTs...) const, ArgTs&& ...Args) const
+	{
+		auto State = std::make_shared<TaskFutureState>();
+		auto CallbackFunc = [State](const TaskBase& Task, ExceptionContainer& Exception) {
+			State->Complete(Task.GetState(), Task.GetErrorCode(), Exception);
+		};
+
+		(dynamic_cast<const DerivedInstrT&>(*this).*TaskFunc)(std::forward<ArgTs>(Args)..., CallbackFunc);
+
+		return TaskFuture(std::move(State));
+	}
+
+	template <typename DerivedInstrT, typename... TaskFuncArgTs, typename... ArgTs>
+	ExceptionContainer InstrumentBase::AsSyncTask(void (DerivedInstrT::* TaskFunc)(TaskFuncArgTs...) const, ArgTs&& ...Args) const
+	{
+		return AsAsyncTask(TaskFunc, std::forward<ArgTs>(Args)...).Get();
+	}
+
 	/**
 	 * @brief Default task which does not do anything. Though, calling it ensures that TaskBase::CallbackFunc
-	 * gets called. This is required to avoid InstrumentBase::AsSyncTask() getting stuck in an infinite loop.
+	 * gets called. This is required to avoid InstrumentBase::AsSyncTask() blocking forever.
 	 * All functions overridden from meta instruments, which are expected to enqueue a task, must at least
 	 * enqueue a @p DefaultTask (by calling @p MakeAndEnqueueTask< DynExp::DefaultTask >(CallbackFunc);)
 	*/
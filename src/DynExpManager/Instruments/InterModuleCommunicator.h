@@ -140,8 +140,11 @@ namespace DynExpInstr
 
 		/**
 		 * @brief Inserts the event passed to the function into the event queues of the modules making use of
-		 * this @p InterModuleCommunicator instance if they are in a ready state (i.e. DynExp::Object::IsReady()
-		 * returns true). The event is not inserted into the @p Caller's event queue.
+		 * this @p InterModuleCommunicator instance if they are running and not about to terminate. The event
+		 * is not inserted into the @p Caller's event queue. Posting never blocks and does not lose events since
+		 * the modules' event queues are lock-free. @p InterModuleEvent is copied once into an immutable event
+		 * shared by all receivers (refer to DynExp::SharedEvent) instead of being copied for each receiver.
+		 * Posted and dropped events are counted by DynExp::InterModuleEvent::GetCounters().
 		 * @tparam DerivedEvent Type of the event to post (derived from DynExp::InterModuleEvent).
 		 * @param Caller Reference to the module calling this function.
 		 * @param InterModuleEvent Event to post to the modules using this @p InterModuleCommunicator instance.
@@ -152,7 +155,10 @@ namespace DynExpInstr
 		{
 			auto& ModuleMgr = Core.GetModuleManager();
 			const auto UserIDs = GetUserIDs();
+			auto& Counters = DerivedEvent::GetCounters();
+			std::shared_ptr<const DerivedEvent> Payload;
 
+			++Counters.NumPosted;
 			for (auto ID : UserIDs)
 			{
 				// Do not send the event back to the caller.
@@ -161,28 +167,17 @@ namespace DynExpInstr
 
 				auto Resource = ModuleMgr.GetResource(ID);
 
-				// Retry in case of Util::TimeoutException a couple of times to not lose events.
-				for (int NumTries = 0; true; NumTries++)
+				// Neither checking whether the module is running nor enqueueing the event locks the module's data.
+				// So, posting events does not block and cannot time out.
+				if (Resource->IsRunning() && !Resource->IsExiting())
 				{
-					try
-					{
-						if (Resource->IsReady())
-							Resource->EnqueueEvent(std::make_unique<DerivedEvent>(InterModuleEvent));
-					}
-					catch ([[maybe_unused]] const Util::TimeoutException& e)
-					{
-						if (NumTries >= 100)
-							throw;
-						else
-						{
-							std::this_thread::yield();
-
-							continue;
-						}
-					}
-
-					break;
+					if (!Payload)
+						Payload = std::make_shared<const DerivedEvent>(InterModuleEvent);
+
+					Resource->EnqueueEvent(std::make_unique<DynExp::SharedEvent>(Payload));
 				}
+				else
+					++Counters.NumDropped;
 			}
 		}
 
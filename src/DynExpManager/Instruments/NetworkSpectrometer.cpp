@@ -88,8 +88,9 @@ namespace DynExpInstr
 				else
 				{
 					SpectrometerData::SpectrumType Spectrum(InstrData->GetFrequencyUnit(), InstrData->GetIntensityUnit());
+					Spectrum.Reserve(SpectrumResponse.samples_size());
 					for (decltype(SpectrumResponse.samples_size()) i = 0; i < SpectrumResponse.samples_size(); ++i)
-						Spectrum.GetSpectrum().insert({ SpectrumResponse.samples(i).frequency(), SpectrumResponse.samples(i).value() });
+						Spectrum.AddSample(SpectrumResponse.samples(i).frequency(), SpectrumResponse.samples(i).value());
 
 					InstrData->SetSpectrum(std::move(Spectrum));
 				}
@@ -54,10 +54,12 @@ namespace DynExpInstr
 
 			try
 			{
-				// Tell position
+				// Tell position (timestamped with the middle of the request to minimize the position trace's timing error)
+				const auto RequestTime = PositionerStageData::PositionTraceClockType::now();
 				*InstrData->HardwareAdapter << "TP";
-				InstrData->SetCurrentPosition(Util::StrToT<PositionerStageData::PositionType>(
-					PI_C_862::AnswerToNumberString(InstrData->HardwareAdapter->WaitForLine(3), "P:")));
+				const auto PositionAnswer = InstrData->HardwareAdapter->WaitForLine(3);
+				InstrData->SetCurrentPosition(Util::StrToT<PositionerStageData::PositionType>(PI_C_862::AnswerToNumberString(PositionAnswer, "P:")),
+					RequestTime + (PositionerStageData::PositionTraceClockType::now() - RequestTime) / 2);
 
 				// Tell programmed velocity
 				*InstrData->HardwareAdapter << "TY";
@@ -62,7 +62,8 @@ namespace DynExpInstr
 		{
 			auto Counts = InstrData->HardwareAdapter->GetCoincidenceCounts(InstrData->GetChannel() + 1);
 			if (Counts.second)
-				SampleStream->WriteSample(Counts.first);
+				SampleStream->WriteSample({ static_cast<BasicSample::DataType>(Counts.first),
+					InstrData->ToCountsTime(TimeTaggerData::CountsClockType::now()) });
 		}
 		else
 			SampleStream->WriteSamples(InstrData->HardwareAdapter->GetTimestamps(InstrData->GetChannel()));
@@ -160,6 +160,8 @@ namespace DynExpInstr
 		auto GetChannel() const noexcept { return Channel; }
 		void SetChannel(DynExpHardware::QutoolsTDCHardwareAdapter::ChannelType Channel) noexcept { this->Channel = Channel; }
 
+		bool AreCountsTimestamped() const noexcept override { return true; }
+
 	private:
 		void ResetImpl(dispatch_tag<TimeTaggerData>) override final;
 		virtual void ResetImpl(dispatch_tag<QutoolsQuTAGData>) {};
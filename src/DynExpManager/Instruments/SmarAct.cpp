@@ -47,7 +47,11 @@ namespace DynExpInstr
 
 			try
 			{
-				InstrData->SetCurrentPosition(InstrData->HardwareAdapter->GetCurrentPosition(InstrData->GetChannel()));
+				// Timestamp the position with the middle of the request to minimize the position trace's timing error.
+				const auto RequestTime = PositionerStageData::PositionTraceClockType::now();
+				const auto Position = InstrData->HardwareAdapter->GetCurrentPosition(InstrData->GetChannel());
+				InstrData->SetCurrentPosition(Position, RequestTime + (PositionerStageData::PositionTraceClockType::now() - RequestTime) / 2);
+
 				InstrData->SetVelocity(InstrData->HardwareAdapter->GetVelocity(InstrData->GetChannel()));
 				InstrData->SmarActChannelStatus.Set(InstrData->HardwareAdapter->GetChannelState(InstrData->GetChannel()));
 			}
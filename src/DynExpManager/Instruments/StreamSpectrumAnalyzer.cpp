@@ -0,0 +1,305 @@
+// This file is part of DynExp.
+
+#include "stdafx.h"
+#include "StreamSpectrumAnalyzer.h"
+
+namespace DynExpInstr
+{
+	void StreamSpectrumAnalyzerTasks::InitTask::InitFuncImpl(dispatch_tag<SpectrometerTasks::InitTask>, DynExp::InstrumentInstance& Instance)
+	{
+		{
+			auto InstrParams = DynExp::dynamic_Params_cast<StreamSpectrumAnalyzer>(Instance.ParamsGetter());
+			auto InstrData = DynExp::dynamic_InstrumentData_cast<StreamSpectrumAnalyzer>(Instance.InstrumentDataGetter());
+
+			Instance.LockObject(InstrParams->DataStreamInstr, InstrData->DataStreamInstr);
+
+			{
+				auto StreamInstrData = DynExp::dynamic_InstrumentData_cast<DataStreamInstrument>(InstrData->DataStreamInstr->GetInstrumentData());
+				if (!StreamInstrData->GetSampleStream()->IsBasicSampleConvertible())
+					throw Util::InvalidDataException("The samples of the linked data stream instrument cannot be converted to basic samples.");
+
+				// Ensures that the sample stream is circular since only then recent samples can be read.
+				StreamInstrData->GetCastSampleStream<CircularDataStreamBase>();
+			} // StreamInstrData unlocked here.
+
+			const auto SegmentLength = Util::NumToT<size_t>(InstrParams->SegmentLength.Get());
+			InstrData->SamplingRate = InstrParams->SamplingRate.Get();
+			InstrData->Estimator = std::make_unique<Util::WelchEstimator>(SegmentLength, InstrData->SamplingRate, InstrParams->Window.Get());
+			InstrData->PendingSamples.reserve(2 * SegmentLength);
+
+			// At least one segment has to be acquired per spectrum.
+			const auto SegmentDuration = std::chrono::duration<double>(SegmentLength / InstrData->SamplingRate);
+			InstrData->SetMinExposureTime(std::max(SpectrometerData::TimeType(1), std::chrono::ceil<SpectrometerData::TimeType>(SegmentDuration)));
+			InstrData->SetMaxExposureTime(SpectrometerData::TimeType(std::chrono::hours(1)));
+			InstrData->SetCurrentExposureTime(std::clamp(SpectrometerData::TimeType(std::chrono::seconds(1)),
+				InstrData->GetMinExposureTime(), InstrData->GetMaxExposureTime()));
+			InstrData->SetCurrentLowerFrequency(0.0);
+			InstrData->SetCurrentUpperFrequency(InstrData->SamplingRate / 2);
+		} // InstrParams and InstrData unlocked here.
+
+		// Initialize derived instrument last.
+		InitFuncImpl(dispatch_tag<InitTask>(), Instance);
+	}
+
+	void StreamSpectrumAnalyzerTasks::ExitTask::ExitFuncImpl(dispatch_tag<SpectrometerTasks::ExitTask>, DynExp::InstrumentInstance& Instance)
+	{
+		// Shut down derived instrument first.
+		ExitFuncImpl(dispatch_tag<ExitTask>(), Instance);
+
+		auto InstrData = DynExp::dynamic_InstrumentData_cast<StreamSpectrumAnalyzer>(Instance.InstrumentDataGetter());
+
+		Instance.UnlockObject(InstrData->DataStreamInstr);
+	}
+
+	void StreamSpectrumAnalyzerTasks::UpdateTask::UpdateFuncImpl(dispatch_tag<SpectrometerTasks::UpdateTask>, DynExp::InstrumentInstance& Instance)
+	{
+		double Overlap{};
+		StreamSpectrumAnalyzerParams::OutputType Output{};
+		StreamSpectrumAnalyzerParams::AcquisitionModeType AcquisitionMode{};
+		{
+			auto InstrParams = DynExp::dynamic_Params_cast<StreamSpectrumAnalyzer>(Instance.ParamsGetter());
+
+			Overlap = InstrParams->Overlap;
+			Output = InstrParams->Output;
+			AcquisitionMode = InstrParams->AcquisitionMode;
+		} // InstrParams unlocked here.
+
+		bool IsCapturing{};
+		bool HasDiscontinuity{};
+		DataStreamBase::BasicSampleListType Samples;
+		std::unique_ptr<Util::WelchEstimator> Estimator;
+		std::vector<double> PendingSamples;
+		size_t NumConsumedSamples{};
+		double SamplingRate{};
+		SpectrometerData::TimeType ExposureTime;
+		double LowerFrequency{}, UpperFrequency{};
+
+		{
+			auto InstrData = DynExp::dynamic_InstrumentData_cast<StreamSpectrumAnalyzer>(Instance.InstrumentDataGetter());
+			IsCapturing = InstrData->CapturingState == SpectrometerData::CapturingStateType::Capturing;
+
+			if (IsCapturing)
+			{
+				InstrData->DataStreamInstr->ReadData();
+
+				{
+					auto StreamInstrData = DynExp::dynamic_InstrumentData_cast<DataStreamInstrument>(InstrData->DataStreamInstr->GetInstrumentData());
+					auto SampleStream = StreamInstrData->GetCastSampleStream<CircularDataStreamBase>();
+					const auto NumSamplesWritten = SampleStream->GetNumSamplesWritten();
+
+					// The stream has been cleared or it has overflown since it has been read last.
+					if (NumSamplesWritten < InstrData->LastConsumedSampleID)
+					{
+						HasDiscontinuity = true;
+						InstrData->LastConsumedSampleID = 0;
+					}
+					else if (NumSamplesWritten - InstrData->LastConsumedSampleID > SampleStream->GetStreamSizeRead())
+						HasDiscontinuity = true;
+
+					Samples = SampleStream->ReadRecentBasicSamples(InstrData->LastConsumedSampleID);
+					InstrData->LastConsumedSampleID = NumSamplesWritten;
+				} // StreamInstrData unlocked here.
+
+				if (HasDiscontinuity)
+					++InstrData->NumDiscontinuities;
+
+				Estimator = std::move(InstrData->Estimator);
+				PendingSamples = std::move(InstrData->PendingSamples);
+				NumConsumedSamples = InstrData->NumConsumedSamples;
+				SamplingRate = InstrData->SamplingRate;
+				ExposureTime = InstrData->GetCurrentExposureTime();
+				LowerFrequency = InstrData->GetCurrentLowerFrequency();
+				UpperFrequency = InstrData->GetCurrentUpperFrequency();
+			}
+		} // InstrData unlocked here.
+
+		if (!IsCapturing || !Estimator)
+		{
+			// Update derived instrument.
+			UpdateFuncImpl(dispatch_tag<UpdateTask>(), Instance);
+
+			return;
+		}
+
+		if (HasDiscontinuity)
+		{
+			// Do not combine samples from before and after the gap to a single segment.
+			PendingSamples.clear();
+
+			Instance.GetOwner().SetWarning("The data stream instrument's sample stream has overflown. Samples have been lost. Consider increasing its stream size.",
+				Util::DynExpErrorCodes::Overflow);
+		}
+
+		PendingSamples.reserve(PendingSamples.size() + Samples.size());
+		for (const auto& Sample : Samples)
+			PendingSamples.push_back(Sample.Value);
+
+		const auto NumProcessedSamples = Estimator->AddData(PendingSamples, Overlap);
+		PendingSamples.erase(PendingSamples.begin(), PendingSamples.begin() + NumProcessedSamples);
+		NumConsumedSamples += Samples.size();
+
+		const auto NumSamplesPerSpectrum = std::chrono::duration<double>(ExposureTime).count() * SamplingRate;
+		const bool IsSpectrumComplete = NumConsumedSamples >= NumSamplesPerSpectrum && Estimator->GetNumSegments();
+
+		std::optional<SpectrometerData::SpectrumType> Spectrum;
+		if (IsSpectrumComplete)
+		{
+			auto Values = Output == StreamSpectrumAnalyzerParams::OutputType::ASD ? Estimator->GetASD() : Estimator->GetPSD();
+			const auto FrequencyResolution = Estimator->GetFrequencyResolution();
+
+			std::vector<double> Frequencies(Values.size());
+			for (size_t i = 0; i < Frequencies.size(); ++i)
+				Frequencies[i] = i * FrequencyResolution;
+
+			Spectrum.emplace(SpectrometerData::FrequencyUnitType::Hz, SpectrometerData::IntensityUnitType::Counts);
+			Spectrum->SetSamples(std::move(Frequencies), std::move(Values));
+			if (LowerFrequency > 0 || UpperFrequency < Spectrum->GetFrequencies().back())
+				*Spectrum = Spectrum->ExtractROI(LowerFrequency, UpperFrequency);
+
+			Estimator->Reset();
+			NumConsumedSamples = 0;
+		}
+
+		{
+			auto InstrData = DynExp::dynamic_InstrumentData_cast<StreamSpectrumAnalyzer>(Instance.InstrumentDataGetter());
+
+			InstrData->Estimator = std::move(Estimator);
+			InstrData->PendingSamples = std::move(PendingSamples);
+			InstrData->NumConsumedSamples = NumConsumedSamples;
+			InstrData->NumAnalyzedSamples += Samples.size();
+			InstrData->CapturingProgress = std::min(100.0, NumSamplesPerSpectrum > 0 ? 100.0 * NumConsumedSamples / NumSamplesPerSpectrum : 100.0);
+
+			if (Spectrum)
+			{
+				InstrData->SetSpectrum(std::move(*Spectrum));
+
+				if (AcquisitionMode == StreamSpectrumAnalyzerParams::AcquisitionModeType::Single)
+				{
+					InstrData->CapturingState = SpectrometerData::CapturingStateType::Ready;
+					InstrData->CapturingProgress = 0.0;
+				}
+			}
+		} // InstrData unlocked here.
+
+		// Update derived instrument.
+		UpdateFuncImpl(dispatch_tag<UpdateTask>(), Instance);
+	}
+
+	DynExp::TaskResultType StreamSpectrumAnalyzerTasks::SetExposureTimeTask::RunChild(DynExp::InstrumentInstance& Instance)
+	{
+		auto InstrData = DynExp::dynamic_InstrumentData_cast<StreamSpectrumAnalyzer>(Instance.InstrumentDataGetter());
+
+		InstrData->SetCurrentExposureTime(std::clamp(ExposureTime, InstrData->GetMinExposureTime(), InstrData->GetMaxExposureTime()));
+
+		return {};
+	}
+
+	DynExp::TaskResultType StreamSpectrumAnalyzerTasks::SetFrequencyRangeTask::RunChild(DynExp::InstrumentInstance& Instance)
+	{
+		auto InstrData = DynExp::dynamic_InstrumentData_cast<StreamSpectrumAnalyzer>(Instance.InstrumentDataGetter());
+
+		const auto MaxFrequency = InstrData->GetSamplingRate() / 2;
+		InstrData->SetCurrentLowerFrequency(std::clamp(std::min(LowerFrequency, UpperFrequency), 0.0, MaxFrequency));
+		InstrData->SetCurrentUpperFrequency(std::clamp(std::max(LowerFrequency, UpperFrequency), 0.0, MaxFrequency));
+
+		return {};
+	}
+
+	DynExp::TaskResultType StreamSpectrumAnalyzerTasks::RecordTask::RunChild(DynExp::InstrumentInstance& Instance)
+	{
+		auto InstrData = DynExp::dynamic_InstrumentData_cast<StreamSpectrumAnalyzer>(Instance.InstrumentDataGetter());
+
+		{
+			auto StreamInstrData = DynExp::dynamic_InstrumentData_cast<DataStreamInstrument>(InstrData->DataStreamInstr->GetInstrumentData());
+
+			// Only analyze samples which are recorded after the acquisition has been started.
+			InstrData->LastConsumedSampleID = StreamInstrData->GetSampleStream()->GetNumSamplesWritten();
+		} // StreamInstrData unlocked here.
+
+		if (InstrData->Estimator)
+			InstrData->Estimator->Reset();
+		InstrData->PendingSamples.clear();
+		InstrData->NumConsumedSamples = 0;
+		InstrData->NumDiscontinuities = 0;
+		InstrData->NumAnalyzedSamples = 0;
+		InstrData->ClearSpectrum();
+
+		InstrData->CapturingState = SpectrometerData::CapturingStateType::Capturing;
+		InstrData->CapturingProgress = 0.0;
+
+		return {};
+	}
+
+	DynExp::TaskResultType StreamSpectrumAnalyzerTasks::AbortTask::RunChild(DynExp::InstrumentInstance& Instance)
+	{
+		auto InstrData = DynExp::dynamic_InstrumentData_cast<StreamSpectrumAnalyzer>(Instance.InstrumentDataGetter());
+
+		InstrData->CapturingState = SpectrometerData::CapturingStateType::Ready;
+		InstrData->CapturingProgress = 0.0;
+
+		return {};
+	}
+
+	void StreamSpectrumAnalyzerData::ResetImpl(dispatch_tag<SpectrometerData>)
+	{
+		CapturingState = CapturingStateType::Ready;
+		CapturingProgress = 0.0;
+		SamplingRate = 0.0;
+
+		Estimator.reset();
+		PendingSamples.clear();
+		LastConsumedSampleID = 0;
+		NumConsumedSamples = 0;
+		NumDiscontinuities = 0;
+		NumAnalyzedSamples = 0;
+
+		ResetImpl(dispatch_tag<StreamSpectrumAnalyzerData>());
+	}
+
+	Util::TextValueListType<StreamSpectrumAnalyzerParams::AcquisitionModeType> StreamSpectrumAnalyzerParams::AcquisitionModeTypeStrList()
+	{
+		Util::TextValueListType<AcquisitionModeType> List = {
+			{ "Average a single spectrum.", AcquisitionModeType::Single },
+			{ "Average and publish spectra continuously.", AcquisitionModeType::Continuous }
+		};
+
+		return List;
+	}
+
+	Util::TextValueListType<Util::FFTWindowType> StreamSpectrumAnalyzerParams::WindowTypeStrList()
+	{
+		Util::TextValueListType<Util::FFTWindowType> List = {
+			{ "Rectangular", Util::FFTWindowType::Rectangular },
+			{ "Hann", Util::FFTWindowType::Hann }
+		};
+
+		return List;
+	}
+
+	Util::TextValueListType<StreamSpectrumAnalyzerParams::OutputType> StreamSpectrumAnalyzerParams::OutputTypeStrList()
+	{
+		Util::TextValueListType<OutputType> List = {
+			{ "Power spectral density (PSD) in squared sample units per Hz", OutputType::PSD },
+			{ "Amplitude spectral density (ASD) in sample units per square root of Hz", OutputType::ASD }
+		};
+
+		return List;
+	}
+
+	StreamSpectrumAnalyzer::StreamSpectrumAnalyzer(const std::thread::id OwnerThreadID, DynExp::ParamsBasePtrType&& Params)
+		: Spectrometer(OwnerThreadID, std::move(Params))
+	{
+	}
+
+	double StreamSpectrumAnalyzer::GetMaxFrequency() const
+	{
+		auto InstrData = DynExp::dynamic_InstrumentData_cast<StreamSpectrumAnalyzer>(GetInstrumentData());
+
+		return InstrData->GetSamplingRate() / 2;
+	}
+
+	void StreamSpectrumAnalyzer::ResetImpl(dispatch_tag<Spectrometer>)
+	{
+		ResetImpl(dispatch_tag<StreamSpectrumAnalyzer>());
+	}
+}
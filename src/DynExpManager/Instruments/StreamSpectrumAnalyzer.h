@@ -0,0 +1,227 @@
+// This file is part of DynExp.
+
+/**
+ * @file StreamSpectrumAnalyzer.h
+ * @brief Implementation of a spectrometer instrument estimating the power spectral density of
+ * the samples recorded by an arbitrary data stream instrument.
+*/
+
+#pragma once
+
+#include "stdafx.h"
+#include "DynExpCore.h"
+#include "MetaInstruments/Spectrometer.h"
+#include "MetaInstruments/DataStreamInstrument.h"
+
+namespace DynExpInstr
+{
+	class StreamSpectrumAnalyzer;
+
+	namespace StreamSpectrumAnalyzerTasks
+	{
+		class InitTask : public SpectrometerTasks::InitTask
+		{
+			void InitFuncImpl(dispatch_tag<SpectrometerTasks::InitTask>, DynExp::InstrumentInstance& Instance) override final;
+			virtual void InitFuncImpl(dispatch_tag<InitTask>, DynExp::InstrumentInstance& Instance) {}
+		};
+
+		class ExitTask : public SpectrometerTasks::ExitTask
+		{
+			void ExitFuncImpl(dispatch_tag<SpectrometerTasks::ExitTask>, DynExp::InstrumentInstance& Instance) override final;
+			virtual void ExitFuncImpl(dispatch_tag<ExitTask>, DynExp::InstrumentInstance& Instance) {}
+		};
+
+		/**
+		 * @brief Pulls the samples which have been recorded by the linked data stream instrument since
+		 * the last update, feeds them into the Welch estimator and publishes the averaged spectrum once
+		 * the exposure time has been reached. Since the update task runs in the instrument's thread, the
+		 * spectral estimation neither blocks the data source nor any module displaying the spectrum.
+		*/
+		class UpdateTask : public SpectrometerTasks::UpdateTask
+		{
+			void UpdateFuncImpl(dispatch_tag<SpectrometerTasks::UpdateTask>, DynExp::InstrumentInstance& Instance) override final;
+			virtual void UpdateFuncImpl(dispatch_tag<UpdateTask>, DynExp::InstrumentInstance& Instance) {}
+		};
+
+		class SetExposureTimeTask final : public DynExp::TaskBase
+		{
+		public:
+			SetExposureTimeTask(SpectrometerData::TimeType ExposureTime, CallbackType CallbackFunc) noexcept : TaskBase(CallbackFunc), ExposureTime(ExposureTime) {}
+
+		private:
+			virtual DynExp::TaskResultType RunChild(DynExp::InstrumentInstance& Instance) override;
+
+			SpectrometerData::TimeType ExposureTime;
+		};
+
+		class SetFrequencyRangeTask final : public DynExp::TaskBase
+		{
+		public:
+			SetFrequencyRangeTask(double LowerFrequency, double UpperFrequency, CallbackType CallbackFunc) noexcept : TaskBase(CallbackFunc), LowerFrequency(LowerFrequency), UpperFrequency(UpperFrequency) {}
+
+		private:
+			virtual DynExp::TaskResultType RunChild(DynExp::InstrumentInstance& Instance) override;
+
+			double LowerFrequency;
+			double UpperFrequency;
+		};
+
+		class RecordTask final : public DynExp::TaskBase
+		{
+		public:
+			RecordTask(CallbackType CallbackFunc) noexcept : TaskBase(CallbackFunc) {}
+
+		private:
+			virtual DynExp::TaskResultType RunChild(DynExp::InstrumentInstance& Instance) override;
+		};
+
+		class AbortTask final : public DynExp::TaskBase
+		{
+		public:
+			AbortTask(CallbackType CallbackFunc) noexcept : TaskBase(CallbackFunc) {}
+
+		private:
+			virtual DynExp::TaskResultType RunChild(DynExp::InstrumentInstance& Instance) override;
+		};
+	}
+
+	class StreamSpectrumAnalyzerData : public SpectrometerData
+	{
+		friend class StreamSpectrumAnalyzerTasks::InitTask;
+		friend class StreamSpectrumAnalyzerTasks::UpdateTask;
+		friend class StreamSpectrumAnalyzerTasks::RecordTask;
+		friend class StreamSpectrumAnalyzerTasks::AbortTask;
+
+	public:
+		StreamSpectrumAnalyzerData() = default;
+		virtual ~StreamSpectrumAnalyzerData() = default;
+
+		auto GetSamplingRate() const noexcept { return SamplingRate; }
+		auto GetNumAveragedSegments() const noexcept { return Estimator ? Estimator->GetNumSegments() : 0; }
+		auto GetNumDiscontinuities() const noexcept { return NumDiscontinuities; }
+		auto GetNumAnalyzedSamples() const noexcept { return NumAnalyzedSamples; }
+
+		DynExp::LinkedObjectWrapperContainer<DataStreamInstrument> DataStreamInstr;
+
+	private:
+		void ResetImpl(dispatch_tag<SpectrometerData>) override final;
+		virtual void ResetImpl(dispatch_tag<StreamSpectrumAnalyzerData>) {};
+
+		virtual CapturingStateType GetCapturingStateChild() const noexcept override { return CapturingState; }
+		virtual double GetCapturingProgressChild() const noexcept override { return CapturingProgress; }
+
+		CapturingStateType CapturingState = CapturingStateType::Ready;
+		double CapturingProgress = 0.0;
+
+		double SamplingRate = 0.0;
+
+		/** @name Estimation state
+		 * Only accessed by the instrument's tasks. Moved out of the instrument data while the spectrum is
+		 * being estimated in order not to keep the instrument data locked during the computation.
+		*/
+		///@{
+		std::unique_ptr<Util::WelchEstimator> Estimator;	//!< Averages the spectra of all segments belonging to the current acquisition.
+		std::vector<double> PendingSamples;					//!< Samples not forming a complete segment yet
+		size_t LastConsumedSampleID = 0;					//!< DataStreamBase::GetNumSamplesWritten() when the linked stream was read last.
+		size_t NumConsumedSamples = 0;						//!< Number of samples consumed during the current acquisition
+		size_t NumDiscontinuities = 0;						//!< Number of times the linked stream has overflown since the acquisition started
+		size_t NumAnalyzedSamples = 0;						//!< Number of samples consumed since the acquisition started
+		///@}
+	};
+
+	class StreamSpectrumAnalyzerParams : public SpectrometerParams
+	{
+	public:
+		/**
+		 * @brief Determines whether to stop after a single spectrum or to keep on averaging new spectra.
+		*/
+		enum AcquisitionModeType { Single, Continuous };
+
+		/**
+		 * @brief Determines the quantity to be published as the spectrum's intensity.
+		*/
+		enum OutputType { PSD, ASD };
+
+		static Util::TextValueListType<AcquisitionModeType> AcquisitionModeTypeStrList();
+		static Util::TextValueListType<Util::FFTWindowType> WindowTypeStrList();
+		static Util::TextValueListType<OutputType> OutputTypeStrList();
+
+		StreamSpectrumAnalyzerParams(DynExp::ItemIDType ID, const DynExp::DynExpCore& Core) : SpectrometerParams(ID, Core) {}
+		virtual ~StreamSpectrumAnalyzerParams() = default;
+
+		virtual const char* GetParamClassTag() const noexcept override { return "StreamSpectrumAnalyzerParams"; }
+
+		Param<DynExp::ObjectLink<DataStreamInstrument>> DataStreamInstr = { *this, GetCore().GetInstrumentManager(),
+			"DataStreamInstrument", "Data stream instrument", "Data stream instrument whose samples are analyzed", DynExpUI::Icons::Instrument };
+		Param<ParamsConfigDialog::NumberType> SamplingRate = { *this, "SamplingRate", "Sampling rate",
+			"Sampling rate of the data stream instrument's samples in samples per second", true, 1e6, 1e-3, std::numeric_limits<ParamsConfigDialog::NumberType>::max(), 1, 3 };
+		Param<ParamsConfigDialog::NumberType> SegmentLength = { *this, "SegmentLength", "Segment length",
+			"Number of samples per segment to be Fourier-transformed. Determines the frequency resolution.", true, 4096, 16, 1 << 24, 1, 0 };
+		Param<ParamsConfigDialog::NumberType> Overlap = { *this, "Overlap", "Segment overlap",
+			"Fraction by which consecutive segments overlap", true, .5, 0, .9, .1, 2 };
+		Param<Util::FFTWindowType> Window = { *this, WindowTypeStrList(), "Window", "Window function",
+			"Window function applied to each segment before transforming it", true, Util::FFTWindowType::Hann };
+		Param<OutputType> Output = { *this, OutputTypeStrList(), "Output", "Output",
+			"Determines whether the power spectral density (PSD) or the amplitude spectral density (ASD) is published", true, OutputType::ASD };
+		Param<AcquisitionModeType> AcquisitionMode = { *this, AcquisitionModeTypeStrList(), "AcquisitionMode", "Acquisition mode",
+			"Determines whether a single spectrum is averaged on recording or whether spectra are averaged and published continuously until the acquisition is aborted", true, AcquisitionModeType::Continuous };
+
+	private:
+		void ConfigureParamsImpl(dispatch_tag<SpectrometerParams>) override final { ConfigureParamsImpl(dispatch_tag<StreamSpectrumAnalyzerParams>()); }
+		virtual void ConfigureParamsImpl(dispatch_tag<StreamSpectrumAnalyzerParams>) {}
+	};
+
+	class StreamSpectrumAnalyzerConfigurator : public SpectrometerConfigurator
+	{
+	public:
+		using ObjectType = StreamSpectrumAnalyzer;
+		using ParamsType = StreamSpectrumAnalyzerParams;
+
+		StreamSpectrumAnalyzerConfigurator() = default;
+		virtual ~StreamSpectrumAnalyzerConfigurator() = default;
+
+	private:
+		virtual DynExp::ParamsBasePtrType MakeParams(DynExp::ItemIDType ID, const DynExp::DynExpCore& Core) const override { return DynExp::MakeParams<StreamSpectrumAnalyzerConfigurator>(ID, Core); }
+	};
+
+	/**
+	 * @brief Spectrometer estimating the one-sided power spectral density of the samples recorded by
+	 * any @p DataStreamInstrument by Welch's method. The resulting spectrum can be displayed by modules
+	 * operating on spectrometers like the spectrum viewer. The exposure time denotes the duration of
+	 * data (in terms of the configured sampling rate) averaged per spectrum.
+	*/
+	class StreamSpectrumAnalyzer : public Spectrometer
+	{
+	public:
+		using ParamsType = StreamSpectrumAnalyzerParams;
+		using ConfigType = StreamSpectrumAnalyzerConfigurator;
+		using InstrumentDataType = StreamSpectrumAnalyzerData;
+
+		constexpr static auto Name() noexcept { return "Stream Spectrum Analyzer"; }
+
+		StreamSpectrumAnalyzer(const std::thread::id OwnerThreadID, DynExp::ParamsBasePtrType&& Params);
+		virtual ~StreamSpectrumAnalyzer() {}
+
+		virtual std::string GetName() const override { return Name(); }
+
+		virtual SpectrometerData::FrequencyUnitType GetFrequencyUnit() const override { return SpectrometerData::FrequencyUnitType::Hz; }
+		virtual SpectrometerData::IntensityUnitType GetIntensityUnit() const override { return SpectrometerData::IntensityUnitType::Counts; }
+		virtual double GetMinFrequency() const override { return 0.0; }
+		virtual double GetMaxFrequency() const override;
+
+		// Logical const-ness: const member functions to allow inserting tasks into task queue.
+		virtual void SetExposureTime(SpectrometerData::TimeType ExposureTime, DynExp::TaskBase::CallbackType CallbackFunc = nullptr) const override { MakeAndEnqueueTask<StreamSpectrumAnalyzerTasks::SetExposureTimeTask>(ExposureTime, CallbackFunc); }
+		virtual void SetFrequencyRange(double LowerFrequency, double UpperFrequency, DynExp::TaskBase::CallbackType CallbackFunc = nullptr) const override { MakeAndEnqueueTask<StreamSpectrumAnalyzerTasks::SetFrequencyRangeTask>(LowerFrequency, UpperFrequency, CallbackFunc); }
+
+		virtual void Record(DynExp::TaskBase::CallbackType CallbackFunc = nullptr) const override { MakeAndEnqueueTask<StreamSpectrumAnalyzerTasks::RecordTask>(CallbackFunc); }
+		virtual void Abort(DynExp::TaskBase::CallbackType CallbackFunc = nullptr) const override { MakeAndEnqueueTask<StreamSpectrumAnalyzerTasks::AbortTask>(CallbackFunc); }
+
+	private:
+		void ResetImpl(dispatch_tag<Spectrometer>) override final;
+		virtual void ResetImpl(dispatch_tag<StreamSpectrumAnalyzer>) {}
+
+		virtual std::unique_ptr<DynExp::InitTaskBase> MakeInitTask() const override { return DynExp::MakeTask<StreamSpectrumAnalyzerTasks::InitTask>(); }
+		virtual std::unique_ptr<DynExp::ExitTaskBase> MakeExitTask() const override { return DynExp::MakeTask<StreamSpectrumAnalyzerTasks::ExitTask>(); }
+		virtual std::unique_ptr<DynExp::UpdateTaskBase> MakeUpdateTask() const override { return DynExp::MakeTask<StreamSpectrumAnalyzerTasks::UpdateTask>(); }
+	};
+}
@@ -50,10 +50,137 @@ namespace DynExpInstr
 		std::memcpy(ImageData.data(), Image.bits(), ImageData.size());
 	}
 
-	DynExpProto::WidefieldLocalization::ImageMessage WidefieldLocalizationTasks::ImageProcessingTaskBase::MakeImageMessage()
+	grpc::Status WidefieldLocalizationTasks::ImageProcessingTaskBase::InvokeWithImage(DynExp::InstrumentInstance& Instance, RPCFuncType RPCFunc)
+	{
+		const auto ImageMsg = MakeImageMessage(Instance);
+		auto Result = RPCFunc(ImageMsg);
+
+		// The server has evicted the image from its cache in the meantime. Upload it again and retry once.
+		if (Result.error_code() == grpc::StatusCode::NOT_FOUND && ImageMsg.imagehandle())
+		{
+			{
+				auto InstrData = DynExp::dynamic_InstrumentData_cast<WidefieldLocalization>(Instance.InstrumentDataGetter());
+				InstrData->RemoveKnownImageHandle(ImageHandle);
+			} // InstrData unlocked here.
+
+			if (UploadImage(Instance))
+				Result = RPCFunc(ImageMsg);
+		}
+
+		return Result;
+	}
+
+	DynExpProto::WidefieldLocalization::ImageMessage WidefieldLocalizationTasks::ImageProcessingTaskBase::MakeImageMessage(DynExp::InstrumentInstance& Instance)
 	{
 		DynExpProto::WidefieldLocalization::ImageMessage ImageMsg;
+		SetImageProperties(ImageMsg);
+
+		WidefieldLocalizationData::ImageTransportType ImageTransport;
+		{
+			auto InstrParams = DynExp::dynamic_Params_cast<WidefieldLocalization>(Instance.ParamsGetter());
+			ImageTransport = InstrParams->ImageTransport;
+		} // InstrParams unlocked here.
+
+		bool IsImageKnown = false;
+		if (ImageTransport != WidefieldLocalizationData::ImageTransportType::Inline)
+		{
+			ImageHandle = MakeImageHandle();
+
+			auto InstrData = DynExp::dynamic_InstrumentData_cast<WidefieldLocalization>(Instance.InstrumentDataGetter());
+			if (InstrData->ImageHandlesUnsupported)
+				ImageTransport = WidefieldLocalizationData::ImageTransportType::Inline;
+			else
+				IsImageKnown = InstrData->UseKnownImageHandle(ImageHandle);
+		} // InstrData unlocked here.
+
+		if (ImageTransport != WidefieldLocalizationData::ImageTransportType::Inline && (IsImageKnown || UploadImage(Instance)))
+			ImageMsg.set_imagehandle(ImageHandle);
+		else
+		{
+			ImageHandle = 0;
+			ImageMsg.set_image(std::move(ImageData));
+		}
+
+		return ImageMsg;
+	}
+
+	bool WidefieldLocalizationTasks::ImageProcessingTaskBase::UploadImage(DynExp::InstrumentInstance& Instance)
+	{
+		WidefieldLocalizationData::ImageTransportType ImageTransport;
+		bool IsServerLocal = false;
+		{
+			auto InstrParams = DynExp::dynamic_Params_cast<WidefieldLocalization>(Instance.ParamsGetter());
+			ImageTransport = InstrParams->ImageTransport;
+			IsServerLocal = IsLocalServer(InstrParams->NetworkParams.ServerName.Get());
+		} // InstrParams unlocked here.
+
+		DynExpProto::WidefieldLocalization::ImageMessage ImageMsg;
+		SetImageProperties(ImageMsg);
+		ImageMsg.set_imagehandle(ImageHandle);
+
+		// The server copies the image from the shared memory segment while handling the UploadImage rpc.
+		// So, the segment is only needed until this function returns.
+		QSharedMemory SharedMemory;
+		if (ImageTransport == WidefieldLocalizationData::ImageTransportType::SharedMemoryImageHandle && IsServerLocal)
+		{
+			SharedMemory.setNativeKey(QString("DynExpWidefieldImage_%1").arg(ImageHandle, 16, 16, QChar('0')));
+
+			// If creating the segment fails, fall back to uploading the image via the network.
+			if (SharedMemory.create(Util::NumToT<qsizetype>(ImageData.size())))
+			{
+				SharedMemory.lock();
+				std::memcpy(SharedMemory.data(), ImageData.data(), ImageData.size());
+				SharedMemory.unlock();
+
+				ImageMsg.set_sharedmemoryname(SharedMemory.nativeKey().toStdString());
+			}
+		}
+
+		if (ImageMsg.sharedmemoryname().empty())
+		{
+			if (ImageTransport == WidefieldLocalizationData::ImageTransportType::CompressedImageHandle)
+			{
+				const auto CompressedImageData = qCompress(reinterpret_cast<const uchar*>(ImageData.data()), Util::NumToT<qsizetype>(ImageData.size()));
+				ImageMsg.set_image(CompressedImageData.constData(), CompressedImageData.size());
+				ImageMsg.set_compression(DynExpProto::WidefieldLocalization::ImageCompressionType::Zlib);
+			}
+			else
+				ImageMsg.set_image(ImageData);
+		}
+
+		grpc::ClientContext Context;
+		DynExpProto::WidefieldLocalization::VoidMessage VoidMsg;
+
+		StubPtrType<DynExpProto::WidefieldLocalization::WidefieldLocalization> StubPtr;
+		{
+			auto InstrData = DynExp::dynamic_InstrumentData_cast<WidefieldLocalization>(Instance.InstrumentDataGetter());
+			StubPtr = InstrData->GetStub<0>();
+		} // InstrData unlocked here.
+
+		auto Result = StubPtr->UploadImage(&Context, ImageMsg, &VoidMsg);
+		if (Result.error_code() == grpc::StatusCode::UNIMPLEMENTED)
+		{
+			auto InstrData = DynExp::dynamic_InstrumentData_cast<WidefieldLocalization>(Instance.InstrumentDataGetter());
+			InstrData->ImageHandlesUnsupported = true;
+
+			Util::EventLog().Log("The widefield localization server does not support image handles. Images are sent along with each request instead.",
+				Util::ErrorType::Warning);
+
+			return false;
+		}
+		if (!Result.ok())
+			throw DynExpHardware::gRPCException(Result);
 
+		{
+			auto InstrData = DynExp::dynamic_InstrumentData_cast<WidefieldLocalization>(Instance.InstrumentDataGetter());
+			InstrData->AddKnownImageHandle(ImageHandle);
+		} // InstrData unlocked here.
+
+		return true;
+	}
+
+	void WidefieldLocalizationTasks::ImageProcessingTaskBase::SetImageProperties(DynExpProto::WidefieldLocalization::ImageMessage& ImageMsg) const
+	{
 		ImageMsg.set_width(ImageWidth);
 		ImageMsg.set_height(ImageHeight);
 
@@ -63,10 +190,24 @@ namespace DynExpInstr
 		case QImage::Format::Format_Grayscale16: ImageMsg.set_imageformat(DynExpProto::WidefieldLocalization::ImageFormatType::Mono16); break;
 		default: throw Util::NotImplementedException("The format of the given image is not supported.");
 		}
+	}
 
-		ImageMsg.set_image(std::move(ImageData));
+	google::protobuf::uint64 WidefieldLocalizationTasks::ImageProcessingTaskBase::MakeImageHandle() const
+	{
+		// Derive the handle from the image's content such that subsequent tasks processing the same image
+		// refer to the image uploaded once. Zero denotes no handle.
+		google::protobuf::uint64 Handle = std::hash<std::string_view>()(ImageData);
+		for (const google::protobuf::uint64 Property : { google::protobuf::uint64(ImageWidth), google::protobuf::uint64(ImageHeight), google::protobuf::uint64(ImageFormat) })
+			Handle ^= std::hash<google::protobuf::uint64>()(Property) + 0x9e3779b97f4a7c15 + (Handle << 6) + (Handle >> 2);
 
-		return ImageMsg;
+		return Handle ? Handle : 1;
+	}
+
+	bool WidefieldLocalizationTasks::ImageProcessingTaskBase::IsLocalServer(std::string_view ServerName)
+	{
+		const auto Name = QString::fromUtf8(ServerName.data(), ServerName.size()).trimmed().toLower();
+
+		return Name == "localhost" || Name == "127.0.0.1" || Name == "::1" || Name == "[::1]";
 	}
 
 	WidefieldLocalizationTasks::ReadCellIDTask::ReadCellIDTask(const QImage& Image, CallbackType CallbackFunc) noexcept
@@ -76,8 +217,6 @@ namespace DynExpInstr
 
 	DynExp::TaskResultType WidefieldLocalizationTasks::ReadCellIDTask::RunChild(DynExp::InstrumentInstance& Instance)
 	{
-		grpc::ClientContext Context;
-		DynExpProto::WidefieldLocalization::ImageMessage ImageMsg = MakeImageMessage();
 		DynExpProto::WidefieldLocalization::CellIDMessage CellIDMsg;
 
 		StubPtrType<DynExpProto::WidefieldLocalization::WidefieldLocalization> StubPtr;
@@ -86,7 +225,10 @@ namespace DynExpInstr
 			StubPtr = InstrData->GetStub<0>();
 		} // InstrData unlocked here.
 
-		auto Result = StubPtr->ReadCellID(&Context, ImageMsg, &CellIDMsg);
+		auto Result = InvokeWithImage(Instance, [&StubPtr, &CellIDMsg](const DynExpProto::WidefieldLocalization::ImageMessage& ImageMsg) {
+			grpc::ClientContext Context;
+			return StubPtr->ReadCellID(&Context, ImageMsg, &CellIDMsg);
+		});
 		if (!Result.ok())
 			throw DynExpHardware::gRPCException(Result);
 		if (CellIDMsg.resultmsg().result() != DynExpProto::WidefieldLocalization::ResultType::OK &&
@@ -124,8 +266,6 @@ namespace DynExpInstr
 
 	DynExp::TaskResultType WidefieldLocalizationTasks::AnalyzeWidefieldTask::RunChild(DynExp::InstrumentInstance& Instance)
 	{
-		grpc::ClientContext Context;
-		DynExpProto::WidefieldLocalization::ImageMessage ImageMsg = MakeImageMessage();
 		DynExpProto::WidefieldLocalization::PositionsMessage PositionsMsg;
 
 		StubPtrType<DynExpProto::WidefieldLocalization::WidefieldLocalization> StubPtr;
@@ -134,7 +274,10 @@ namespace DynExpInstr
 			StubPtr = InstrData->GetStub<0>();
 		} // InstrData unlocked here.
 
-		auto Result = StubPtr->AnalyzeWidefield(&Context, ImageMsg, &PositionsMsg);
+		auto Result = InvokeWithImage(Instance, [&StubPtr, &PositionsMsg](const DynExpProto::WidefieldLocalization::ImageMessage& ImageMsg) {
+			grpc::ClientContext Context;
+			return StubPtr->AnalyzeWidefield(&Context, ImageMsg, &PositionsMsg);
+		});
 		if (!Result.ok())
 			throw DynExpHardware::gRPCException(Result);
 
@@ -153,8 +296,6 @@ namespace DynExpInstr
 
 	DynExp::TaskResultType WidefieldLocalizationTasks::AnalyzeDistortionTask::RunChild(DynExp::InstrumentInstance& Instance)
 	{
-		grpc::ClientContext Context;
-		DynExpProto::WidefieldLocalization::ImageMessage ImageMsg = MakeImageMessage();
 		DynExpProto::WidefieldLocalization::VoidMessage VoidMsg;
 
 		StubPtrType<DynExpProto::WidefieldLocalization::WidefieldLocalization> StubPtr;
@@ -163,7 +304,10 @@ namespace DynExpInstr
 			StubPtr = InstrData->GetStub<0>();
 		} // InstrData unlocked here.
 
-		auto Result = StubPtr->AnalyzeTipTilt(&Context, ImageMsg, &VoidMsg);
+		auto Result = InvokeWithImage(Instance, [&StubPtr, &VoidMsg](const DynExpProto::WidefieldLocalization::ImageMessage& ImageMsg) {
+			grpc::ClientContext Context;
+			return StubPtr->AnalyzeTipTilt(&Context, ImageMsg, &VoidMsg);
+		});
 		if (!Result.ok())
 			throw DynExpHardware::gRPCException(Result);
 
@@ -178,13 +322,9 @@ namespace DynExpInstr
 
 	DynExp::TaskResultType DynExpInstr::WidefieldLocalizationTasks::RecallPositionsTask::RunChild(DynExp::InstrumentInstance& Instance)
 	{
-		grpc::ClientContext Context;
 		DynExpProto::WidefieldLocalization::RecallPositionsMessage RecallPositionsMsg;
 		DynExpProto::WidefieldLocalization::PositionsMessage PositionsMsg;
 
-		auto ImageMsg = std::make_unique<DynExpProto::WidefieldLocalization::ImageMessage>(MakeImageMessage());
-		RecallPositionsMsg.set_allocated_image(ImageMsg.release());
-
 		auto CellIDResultsMsg = std::make_unique<DynExpProto::WidefieldLocalization::ResultMessage>();
 		CellIDResultsMsg->set_result(CellID.Valid ? DynExpProto::WidefieldLocalization::ResultType::OK : DynExpProto::WidefieldLocalization::ResultType::GeneralError);
 		auto IDPointMsg = std::make_unique<DynExpProto::WidefieldLocalization::PointMessage>();
@@ -204,7 +344,12 @@ namespace DynExpInstr
 			StubPtr = InstrData->GetStub<0>();
 		} // InstrData unlocked here.
 
-		auto Result = StubPtr->RecallPositions(&Context, RecallPositionsMsg, &PositionsMsg);
+		auto Result = InvokeWithImage(Instance, [&StubPtr, &RecallPositionsMsg, &PositionsMsg](const DynExpProto::WidefieldLocalization::ImageMessage& ImageMsg) {
+			grpc::ClientContext Context;
+			*RecallPositionsMsg.mutable_image() = ImageMsg;
+
+			return StubPtr->RecallPositions(&Context, RecallPositionsMsg, &PositionsMsg);
+		});
 		if (!Result.ok())
 			throw DynExpHardware::gRPCException(Result);
 
@@ -220,6 +365,8 @@ namespace DynExpInstr
 	{
 		CellID = {};
 		LocalizedPositions.clear();
+		KnownImageHandles.clear();
+		ImageHandlesUnsupported = false;
 
 		ResetImpl(dispatch_tag<WidefieldLocalizationData>());
 	}
@@ -238,6 +385,44 @@ namespace DynExpInstr
 		}
 	}
 
+	bool WidefieldLocalizationData::UseKnownImageHandle(google::protobuf::uint64 Handle)
+	{
+		auto KnownHandle = std::find(KnownImageHandles.begin(), KnownImageHandles.end(), Handle);
+		if (KnownHandle == KnownImageHandles.end())
+			return false;
+
+		KnownImageHandles.erase(KnownHandle);
+		KnownImageHandles.push_back(Handle);
+
+		return true;
+	}
+
+	void WidefieldLocalizationData::AddKnownImageHandle(google::protobuf::uint64 Handle)
+	{
+		RemoveKnownImageHandle(Handle);
+
+		KnownImageHandles.push_back(Handle);
+		while (KnownImageHandles.size() > MaxNumKnownImageHandles)
+			KnownImageHandles.pop_front();
+	}
+
+	void WidefieldLocalizationData::RemoveKnownImageHandle(google::protobuf::uint64 Handle)
+	{
+		std::erase(KnownImageHandles, Handle);
+	}
+
+	Util::TextValueListType<WidefieldLocalizationData::ImageTransportType> WidefieldLocalizationParams::ImageTransportTypeStrList()
+	{
+		Util::TextValueListType<WidefieldLocalizationData::ImageTransportType> List = {
+			{ "Send the image along with each request", WidefieldLocalizationData::ImageTransportType::Inline },
+			{ "Upload each image once and refer to it by a handle", WidefieldLocalizationData::ImageTransportType::ImageHandle },
+			{ "Upload each image once losslessly compressed", WidefieldLocalizationData::ImageTransportType::CompressedImageHandle },
+			{ "Upload each image once via shared memory (local server only)", WidefieldLocalizationData::ImageTransportType::SharedMemoryImageHandle }
+		};
+
+		return List;
+	}
+
 	WidefieldLocalization::WidefieldLocalization(const std::thread::id OwnerThreadID, DynExp::ParamsBasePtrType&& Params)
 		: gRPCInstrument(OwnerThreadID, std::move(Params))
 	{
@@ -60,16 +60,31 @@ namespace DynExpInstr
 		class ImageProcessingTaskBase
 		{
 		public:
+			using RPCFuncType = std::function<grpc::Status(const DynExpProto::WidefieldLocalization::ImageMessage&)>;
+
 			ImageProcessingTaskBase(const QImage& Image) noexcept;
 
-			// Consumes ImageData.
-			DynExpProto::WidefieldLocalization::ImageMessage MakeImageMessage();
+			// Creates the image message according to WidefieldLocalizationParams::ImageTransport and calls RPCFunc with it.
+			// If the image is referenced by a handle the server has evicted from its cache, the image is uploaded again and
+			// RPCFunc is called once more. RPCFunc has to create a new grpc::ClientContext each time it is called.
+			grpc::Status InvokeWithImage(DynExp::InstrumentInstance& Instance, RPCFuncType RPCFunc);
 
 		private:
+			// Consumes ImageData if the image is transferred inline.
+			DynExpProto::WidefieldLocalization::ImageMessage MakeImageMessage(DynExp::InstrumentInstance& Instance);
+
+			// Sends the image to the server to be cached under ImageHandle. Returns false if the server does not support this.
+			bool UploadImage(DynExp::InstrumentInstance& Instance);
+
+			void SetImageProperties(DynExpProto::WidefieldLocalization::ImageMessage& ImageMsg) const;
+			google::protobuf::uint64 MakeImageHandle() const;
+			static bool IsLocalServer(std::string_view ServerName);
+
 			const google::protobuf::uint32 ImageWidth;
 			const google::protobuf::uint32 ImageHeight;
 			const QImage::Format ImageFormat;
 			std::string ImageData;
+			google::protobuf::uint64 ImageHandle = 0;
 		};
 
 		class ReadCellIDTask final : public DynExp::TaskBase, ImageProcessingTaskBase
@@ -118,8 +133,21 @@ namespace DynExpInstr
 		friend class WidefieldLocalizationTasks::ReadCellIDTask;
 		friend class WidefieldLocalizationTasks::AnalyzeWidefieldTask;
 		friend class WidefieldLocalizationTasks::RecallPositionsTask;
+		friend class WidefieldLocalizationTasks::ImageProcessingTaskBase;
 
 	public:
+		/**
+		 * @brief Determines how images are transferred to the server.
+		*/
+		enum ImageTransportType {
+			Inline,						//!< Send the whole image along with each request (supported by all servers).
+			ImageHandle,				//!< Upload each image once and refer to it by a handle in subsequent requests.
+			CompressedImageHandle,		//!< Like @p ImageHandle, but upload images losslessly compressed.
+			SharedMemoryImageHandle		//!< Like @p ImageHandle, but upload images via shared memory if the server runs on the same machine.
+		};
+
+		static constexpr size_t MaxNumKnownImageHandles = 16;	//!< Maximal number of handles of images uploaded to the server to keep track of
+
 		WidefieldLocalizationData() = default;
 		virtual ~WidefieldLocalizationData() = default;
 
@@ -132,23 +160,36 @@ namespace DynExpInstr
 
 		void SetLocalizedPositions(const DynExpProto::WidefieldLocalization::PositionsMessage& PositionsMsg);
 
+		bool UseKnownImageHandle(google::protobuf::uint64 Handle);		// Returns whether Handle is known and marks it as most recently used.
+		void AddKnownImageHandle(google::protobuf::uint64 Handle);
+		void RemoveKnownImageHandle(google::protobuf::uint64 Handle);
+
 		WidefieldLocalizationCellIDType CellID;
 		std::map<google::protobuf::uint32, QPoint> LocalizedPositions;
+
+		// Handles of the images most recently uploaded to the server (most recently used last). The server might have
+		// evicted some of them from its cache already. Then, the images are uploaded again.
+		std::deque<google::protobuf::uint64> KnownImageHandles;
+		bool ImageHandlesUnsupported = false;		// Set if the server does not implement the UploadImage rpc.
 	};
 
 	class WidefieldLocalizationParams : public gRPCInstrumentParams<DynExp::InstrumentBase, 0, DynExpProto::WidefieldLocalization::WidefieldLocalization>
 	{
 	public:
+		static Util::TextValueListType<WidefieldLocalizationData::ImageTransportType> ImageTransportTypeStrList();
+
 		WidefieldLocalizationParams(DynExp::ItemIDType ID, const DynExp::DynExpCore& Core) : gRPCInstrumentParams(ID, Core) {}
 		virtual ~WidefieldLocalizationParams() = default;
 
 		virtual const char* GetParamClassTag() const noexcept override { return "WidefieldLocalizationParams"; }
 
+		Param<WidefieldLocalizationData::ImageTransportType> ImageTransport = { *this, ImageTransportTypeStrList(), "ImageTransport", "Image transport",
+			"Determines how images are transferred to the server. Referring to images by handles requires the server to implement the UploadImage rpc. "
+			"Transferring images via shared memory requires the server to run on the same machine.", false, WidefieldLocalizationData::ImageTransportType::Inline };
+
 	private:
 		void ConfigureParamsImpl(dispatch_tag<gRPCInstrumentParams<DynExp::InstrumentBase, 0, DynExpProto::WidefieldLocalization::WidefieldLocalization>>) override final { ConfigureParamsImpl(dispatch_tag<WidefieldLocalizationParams>()); }
 		virtual void ConfigureParamsImpl(dispatch_tag<WidefieldLocalizationParams>) {}
-
-		DummyParam Dummy = { *this };
 	};
 
 	class WidefieldLocalizationConfigurator : public gRPCInstrumentConfigurator<DynExp::InstrumentBase, 0, DynExpProto::WidefieldLocalization::WidefieldLocalization>
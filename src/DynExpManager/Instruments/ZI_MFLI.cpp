@@ -25,6 +25,7 @@ namespace DynExpInstr
 
 		try
 		{
+			InstrData->HardwareAdapter->StopStreaming();
 			InstrData->HardwareAdapter->StopAcquisition();
 			InstrData->HardwareAdapter->SetEnabled(GetUsedDemodulator(), false);
 		}
@@ -46,19 +47,22 @@ namespace DynExpInstr
 
 			try
 			{
-				InstrData->SetSensitivity(InstrData->HardwareAdapter->GetInputRange(GetUsedSignalInput()));
-				InstrData->SetPhase(InstrData->HardwareAdapter->GetDemodPhase(GetUsedDemodulator()));
-				InstrData->SetTimeConstant(InstrData->HardwareAdapter->GetDemodTimeConstant(GetUsedDemodulator()));
-				InstrData->SetFilterOrder(InstrData->HardwareAdapter->GetDemodFilterOrder(GetUsedDemodulator()));
+				// Reads all device nodes at once acquiring the hardware adapter's lock only once.
+				const auto Status = InstrData->HardwareAdapter->GetDemodStatus(GetUsedSignalInput(), GetUsedDemodulator());
+
+				InstrData->SetSensitivity(Status.InputRange);
+				InstrData->SetPhase(Status.Phase);
+				InstrData->SetTimeConstant(Status.TimeConstant);
+				InstrData->SetFilterOrder(Status.FilterOrder);
 				InstrData->SetTriggerMode(InstrData->HardwareAdapter->GetTriggerMode());
 				InstrData->SetTriggerEdge(InstrData->HardwareAdapter->GetTriggerEdge());
-				InstrData->SetSamplingRate(InstrData->HardwareAdapter->GetDemodSamplingRate(GetUsedDemodulator()));
-				InstrData->SetEnable(InstrData->HardwareAdapter->GetEnabled(GetUsedDemodulator()));
+				InstrData->SetSamplingRate(Status.SamplingRate);
+				InstrData->SetEnable(Status.Enabled);
 
-				InstrData->NegInputLoad = InstrData->HardwareAdapter->GetNegInputLoad(GetUsedSignalInput());
-				InstrData->PosInputLoad = InstrData->HardwareAdapter->GetPosInputLoad(GetUsedSignalInput());
+				InstrData->NegInputLoad = Status.NegInputLoad;
+				InstrData->PosInputLoad = Status.PosInputLoad;
 				InstrData->Overload = DynExpHardware::ZILabOneHardwareAdapter::DetermineOverload(InstrData->PosInputLoad, InstrData->NegInputLoad);
-				InstrData->OscillatorFrequency = InstrData->HardwareAdapter->GetOscillatorFrequency(0);
+				InstrData->OscillatorFrequency = Status.OscillatorFrequency;
 				InstrData->AcquisitionProgress = InstrData->HardwareAdapter->GetAcquisitionProgress();
 			}
 			catch ([[maybe_unused]] const DynExpHardware::ZILabOneException& e)
@@ -96,10 +100,13 @@ namespace DynExpInstr
 		auto InstrData = DynExp::dynamic_InstrumentData_cast<ZI_MFLI>(Instance.InstrumentDataGetter());
 
 		auto SampleStream = InstrData->GetCastSampleStream<LockinAmplifierData::SampleStreamType>();
-		auto LockinSamples = InstrData->HardwareAdapter->GetAcquiredData();
+		auto LockinSamples = AcquisitionMode == DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType::Streaming ?
+			InstrData->HardwareAdapter->GetStreamedData() : InstrData->HardwareAdapter->GetAcquiredData();
 
-		for (const auto& Sample : LockinSamples)
-			SampleStream->WriteSample({ Sample.GetDisambiguatedValue(InstrData->GetSignalType()), Sample.Time });
+		// The stream stores the samples' cartesian representation. The signal type only determines how
+		// they are converted when they are read as basic samples.
+		SampleStream->SetSignalType(InstrData->GetSignalType());
+		SampleStream->WriteSamples(LockinSamples);
 
 		return {};
 	}
@@ -108,7 +115,10 @@ namespace DynExpInstr
 	{
 		auto InstrData = DynExp::dynamic_InstrumentData_cast<ZI_MFLI>(Instance.InstrumentDataGetter());
 
-		InstrData->HardwareAdapter->ClearAcquiredData();
+		if (AcquisitionMode == DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType::Streaming)
+			InstrData->HardwareAdapter->ClearStreamedData();
+		else
+			InstrData->HardwareAdapter->ClearAcquiredData();
 
 		return {};
 	}
@@ -117,7 +127,10 @@ namespace DynExpInstr
 	{
 		auto InstrData = DynExp::dynamic_InstrumentData_cast<ZI_MFLI>(Instance.InstrumentDataGetter());
 
-		InstrData->HardwareAdapter->StartAcquisition(GetUsedDemodulator(), InstrData->GetSampleStream()->GetStreamSizeWrite());
+		if (AcquisitionMode == DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType::Streaming)
+			InstrData->HardwareAdapter->StartStreaming(GetUsedDemodulator(), InstrData->GetSampleStream()->GetStreamSizeWrite());
+		else
+			InstrData->HardwareAdapter->StartAcquisition(GetUsedDemodulator(), InstrData->GetSampleStream()->GetStreamSizeWrite());
 
 		return {};
 	}
@@ -126,7 +139,10 @@ namespace DynExpInstr
 	{
 		auto InstrData = DynExp::dynamic_InstrumentData_cast<ZI_MFLI>(Instance.InstrumentDataGetter());
 
-		InstrData->HardwareAdapter->StopAcquisition();
+		if (AcquisitionMode == DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType::Streaming)
+			InstrData->HardwareAdapter->StopStreaming();
+		else
+			InstrData->HardwareAdapter->StopAcquisition();
 
 		return {};
 	}
@@ -273,9 +289,20 @@ namespace DynExpInstr
 		return List;
 	}
 
+	Util::TextValueListType<DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType> ZI_MFLIParams::AcquisitionModeTypeStrList()
+	{
+		Util::TextValueListType<DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType> List = {
+			{ "Data acquisition module (triggered)", DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType::DataAcquisitionModule },
+			{ "Continuous streaming", DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType::Streaming },
+		};
+
+		return List;
+	}
+
 	ZI_MFLI::ZI_MFLI(const std::thread::id OwnerThreadID, DynExp::ParamsBasePtrType&& Params)
 		: LockinAmplifier(OwnerThreadID, std::move(Params)),
-		SignalInput(DynExpHardware::ZILabOneHardwareAdapter::SignalInputType::Voltage), UsedDemodulator(0), TriggerChannel(1)
+		SignalInput(DynExpHardware::ZILabOneHardwareAdapter::SignalInputType::Voltage), UsedDemodulator(0), TriggerChannel(1),
+		AcquisitionMode(DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType::DataAcquisitionModule)
 	{
 	}
 
@@ -283,6 +310,10 @@ namespace DynExpInstr
 	{
 		auto InstrData = DynExp::dynamic_InstrumentData_cast<ZI_MFLI>(GetInstrumentData());
 
+		// Streaming never finishes by itself.
+		if (AcquisitionMode == DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType::Streaming)
+			return !InstrData->HardwareAdapter->IsStreaming();
+
 		return InstrData->HardwareAdapter->HasFinishedAcquisition();
 	}
 
@@ -299,6 +330,7 @@ namespace DynExpInstr
 			SignalInput = InstrParams->SignalInput;
 			UsedDemodulator = InstrParams->Demodulator;
 			TriggerChannel = InstrParams->TriggerChannel;
+			AcquisitionMode = InstrParams->AcquisitionMode;
 		} // InstrParams unlocked here.
 
 		ResetImpl(dispatch_tag<ZI_MFLI>());
@@ -70,41 +70,53 @@ namespace DynExpInstr
 		class ReadTask final : public DynExp::TaskBase, ZI_MFLITaskBase
 		{
 		public:
-			ReadTask(DynExpHardware::ZILabOneHardwareAdapter::SignalInputType UsedSignalInput, uint8_t UsedDemodulator, CallbackType CallbackFunc) noexcept
-				: TaskBase(CallbackFunc), ZI_MFLITaskBase(UsedSignalInput, UsedDemodulator) {}
+			ReadTask(DynExpHardware::ZILabOneHardwareAdapter::SignalInputType UsedSignalInput, uint8_t UsedDemodulator,
+				DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType AcquisitionMode, CallbackType CallbackFunc) noexcept
+				: TaskBase(CallbackFunc), ZI_MFLITaskBase(UsedSignalInput, UsedDemodulator), AcquisitionMode(AcquisitionMode) {}
 
 		private:
 			virtual DynExp::TaskResultType RunChild(DynExp::InstrumentInstance& Instance) override;
+
+			const DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType AcquisitionMode;
 		};
 
 		class ClearDataTask final : public DynExp::TaskBase, ZI_MFLITaskBase
 		{
 		public:
-			ClearDataTask(DynExpHardware::ZILabOneHardwareAdapter::SignalInputType UsedSignalInput, uint8_t UsedDemodulator, CallbackType CallbackFunc) noexcept
-				: TaskBase(CallbackFunc), ZI_MFLITaskBase(UsedSignalInput, UsedDemodulator) {}
+			ClearDataTask(DynExpHardware::ZILabOneHardwareAdapter::SignalInputType UsedSignalInput, uint8_t UsedDemodulator,
+				DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType AcquisitionMode, CallbackType CallbackFunc) noexcept
+				: TaskBase(CallbackFunc), ZI_MFLITaskBase(UsedSignalInput, UsedDemodulator), AcquisitionMode(AcquisitionMode) {}
 
 		private:
 			virtual DynExp::TaskResultType RunChild(DynExp::InstrumentInstance& Instance) override;
+
+			const DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType AcquisitionMode;
 		};
 
 		class StartTask final : public DynExp::TaskBase, ZI_MFLITaskBase
 		{
 		public:
-			StartTask(DynExpHardware::ZILabOneHardwareAdapter::SignalInputType UsedSignalInput, uint8_t UsedDemodulator, CallbackType CallbackFunc) noexcept
-				: TaskBase(CallbackFunc), ZI_MFLITaskBase(UsedSignalInput, UsedDemodulator) {}
+			StartTask(DynExpHardware::ZILabOneHardwareAdapter::SignalInputType UsedSignalInput, uint8_t UsedDemodulator,
+				DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType AcquisitionMode, CallbackType CallbackFunc) noexcept
+				: TaskBase(CallbackFunc), ZI_MFLITaskBase(UsedSignalInput, UsedDemodulator), AcquisitionMode(AcquisitionMode) {}
 
 		private:
 			virtual DynExp::TaskResultType RunChild(DynExp::InstrumentInstance& Instance) override;
+
+			const DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType AcquisitionMode;
 		};
 
 		class StopTask final : public DynExp::TaskBase, ZI_MFLITaskBase
 		{
 		public:
-			StopTask(DynExpHardware::ZILabOneHardwareAdapter::SignalInputType UsedSignalInput, uint8_t UsedDemodulator, CallbackType CallbackFunc) noexcept
-				: TaskBase(CallbackFunc), ZI_MFLITaskBase(UsedSignalInput, UsedDemodulator) {}
+			StopTask(DynExpHardware::ZILabOneHardwareAdapter::SignalInputType UsedSignalInput, uint8_t UsedDemodulator,
+				DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType AcquisitionMode, CallbackType CallbackFunc) noexcept
+				: TaskBase(CallbackFunc), ZI_MFLITaskBase(UsedSignalInput, UsedDemodulator), AcquisitionMode(AcquisitionMode) {}
 
 		private:
 			virtual DynExp::TaskResultType RunChild(DynExp::InstrumentInstance& Instance) override;
+
+			const DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType AcquisitionMode;
 		};
 
 		class SetSensitivityTask final : public DynExp::TaskBase, ZI_MFLITaskBase
@@ -319,6 +331,7 @@ namespace DynExpInstr
 	{
 	public:
 		static Util::TextValueListType<DynExpHardware::ZILabOneHardwareAdapter::SignalInputType> SignalInputTypeStrList();
+		static Util::TextValueListType<DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType> AcquisitionModeTypeStrList();
 
 		ZI_MFLIParams(DynExp::ItemIDType ID, const DynExp::DynExpCore& Core) : LockinAmplifierParams(ID, Core) {}
 		virtual ~ZI_MFLIParams() = default;
@@ -334,6 +347,10 @@ namespace DynExpInstr
 			"Demodulator of the lock-in amplifier to read out", true, 0, 0, std::numeric_limits<uint8_t>::max(), 1, 0 };
 		Param<ParamsConfigDialog::NumberType> TriggerChannel = { *this, "TriggerChannel", "Trigger channel",
 			"Trigger channel to use for external trigger modes", true, 1, 1, std::numeric_limits<uint8_t>::max(), 1, 0 };
+		Param<DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType> AcquisitionMode = {
+			*this, AcquisitionModeTypeStrList(), "AcquisitionMode", "Acquisition mode",
+			"Determines whether to acquire a fixed amount of samples per (triggered) run using the data acquisition module or to continuously stream all samples of the demodulator (ignoring the trigger settings)",
+			true, DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType::DataAcquisitionModule };
 
 	private:
 		void ConfigureParamsImpl(dispatch_tag<LockinAmplifierParams>) override final { ConfigureParamsImpl(dispatch_tag<ZI_MFLIParams>()); }
@@ -367,8 +384,9 @@ namespace DynExpInstr
 
 		virtual std::string GetName() const override { return Name(); }
 
-		// ZI MFLI does not like polling data too frequently...
-		virtual std::chrono::milliseconds GetTaskQueueDelay() const override { return std::chrono::milliseconds(200); }
+		// ZI MFLI does not like polling data too frequently... Streamed samples are read from a local buffer, though.
+		virtual std::chrono::milliseconds GetTaskQueueDelay() const override { return std::chrono::milliseconds(
+			AcquisitionMode == DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType::Streaming ? 20 : 200); }
 
 		// Further information about the instrument
 		virtual DataStreamInstrumentData::UnitType GetValueUnit() const noexcept override { return SignalInput == DynExpHardware::ZILabOneHardwareAdapter::SignalInputType::Current ? DataStreamInstrumentData::UnitType::Ampere : DataStreamInstrumentData::UnitType::Volt; }
@@ -378,10 +396,10 @@ namespace DynExpInstr
 		virtual Util::OptionalBool IsRunning() const override;
 
 		// Tasks
-		virtual void ReadData(DynExp::TaskBase::CallbackType CallbackFunc = nullptr) const override { MakeAndEnqueueTask<ZI_MFLITasks::ReadTask>(SignalInput, UsedDemodulator, CallbackFunc); }
-		virtual void ClearData(DynExp::TaskBase::CallbackType CallbackFunc = nullptr) const override { MakeAndEnqueueTask<ZI_MFLITasks::ClearDataTask>(SignalInput, UsedDemodulator, CallbackFunc); }
-		virtual void Start(DynExp::TaskBase::CallbackType CallbackFunc = nullptr) const override { MakeAndEnqueueTask<ZI_MFLITasks::StartTask>(SignalInput, UsedDemodulator, CallbackFunc); }
-		virtual void Stop(DynExp::TaskBase::CallbackType CallbackFunc = nullptr) const override { MakeAndEnqueueTask<ZI_MFLITasks::StopTask>(SignalInput, UsedDemodulator, CallbackFunc); }
+		virtual void ReadData(DynExp::TaskBase::CallbackType CallbackFunc = nullptr) const override { MakeAndEnqueueTask<ZI_MFLITasks::ReadTask>(SignalInput, UsedDemodulator, AcquisitionMode, CallbackFunc); }
+		virtual void ClearData(DynExp::TaskBase::CallbackType CallbackFunc = nullptr) const override { MakeAndEnqueueTask<ZI_MFLITasks::ClearDataTask>(SignalInput, UsedDemodulator, AcquisitionMode, CallbackFunc); }
+		virtual void Start(DynExp::TaskBase::CallbackType CallbackFunc = nullptr) const override { MakeAndEnqueueTask<ZI_MFLITasks::StartTask>(SignalInput, UsedDemodulator, AcquisitionMode, CallbackFunc); }
+		virtual void Stop(DynExp::TaskBase::CallbackType CallbackFunc = nullptr) const override { MakeAndEnqueueTask<ZI_MFLITasks::StopTask>(SignalInput, UsedDemodulator, AcquisitionMode, CallbackFunc); }
 
 		virtual void SetSensitivity(double Sensitivity, DynExp::TaskBase::CallbackType CallbackFunc = nullptr) const override { MakeAndEnqueueTask<ZI_MFLITasks::SetSensitivityTask>(Sensitivity, SignalInput, UsedDemodulator, CallbackFunc); }
 		virtual void AutoAdjustSensitivity(DynExp::TaskBase::CallbackType CallbackFunc = nullptr) const override { MakeAndEnqueueTask<ZI_MFLITasks::AutoAdjustSensitivityTask>(SignalInput, UsedDemodulator, CallbackFunc); }
@@ -411,5 +429,6 @@ namespace DynExpInstr
 
 		uint8_t UsedDemodulator;
 		uint8_t TriggerChannel;
+		DynExpHardware::ZILabOneHardwareAdapter::AcquisitionModeType AcquisitionMode;
 	};
 }
\ No newline at end of file
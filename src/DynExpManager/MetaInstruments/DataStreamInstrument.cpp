@@ -25,12 +25,7 @@ namespace DynExpInstr
 		if (!CanRead())
 			return {};
 
-		BasicSampleListType Samples;
-
-		for (decltype(Count) i = 0; i < Count; ++i)
-			Samples.push_back(ReadBasicSampleChild());
-
-		return Samples;
+		return ReadBasicSamplesChild(Count);
 	}
 
 	void DataStreamBase::WriteBasicSampleChild(const BasicSample& Sample)
@@ -45,6 +40,17 @@ namespace DynExpInstr
 		return {};
 	}
 
+	DataStreamBase::BasicSampleListType DataStreamBase::ReadBasicSamplesChild(size_t Count)
+	{
+		BasicSampleListType Samples;
+		Samples.reserve(Count);
+
+		for (decltype(Count) i = 0; i < Count; ++i)
+			Samples.push_back(ReadBasicSampleChild());
+
+		return Samples;
+	}
+
 	size_t CircularDataStreamBase::GetNumRecentBasicSamples(size_t Count) const
 	{
 		return std::min(GetNumSamplesWritten() - Count, GetStreamSizeRead());
@@ -54,8 +60,12 @@ namespace DynExpInstr
 	{
 		auto OldReadPos = GetReadPosition();
 		auto ReadLength = Util::NumToT<signed long long>(GetNumRecentBasicSamples(Count));
-		SeekEqual(std::ios_base::in);
-		SeekRel(-ReadLength, std::ios_base::cur, std::ios_base::in);
+
+		// The recent samples precede the write pointer. Seeking relative to the get area's beginning wraps around
+		// correctly even if the write pointer points to the buffer's end or if the get area does not span the entire
+		// buffer yet (in both cases, SeekEqual() cannot move the read pointer to the write pointer).
+		SeekBeg(std::ios_base::in);
+		SeekRel(Util::NumToT<signed long long>(std::streamoff(GetWritePosition())) - ReadLength, std::ios_base::cur, std::ios_base::in);
 		auto Samples = ReadBasicSamples(ReadLength);
 		SeekAbs(OldReadPos, std::ios_base::in);
 
@@ -132,6 +142,9 @@ namespace DynExpInstr
 	{
 		// Do not throw a Util::NotImplementedException here, since it is fine to read data
 		// which has been written to the buffer of e.g. a derived function generator instrument.
+		// Anyway, ensure that CallbackFunc gets called (e.g. by InstrumentBase::AsSyncTask()).
+		if (CallbackFunc)
+			MakeAndEnqueueTask<DynExp::DefaultTask>(CallbackFunc);
 	}
 
 	void DataStreamInstrument::WriteData(DynExp::TaskBase::CallbackType CallbackFunc) const
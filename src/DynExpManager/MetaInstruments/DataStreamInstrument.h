@@ -248,6 +248,13 @@ namespace DynExpInstr
 		*/
 		virtual BasicSample ReadBasicSampleChild();
 
+		/**
+		 * @copydoc ReadBasicSamples
+		 * The default implementation calls @p ReadBasicSampleChild() @p Count times. Override to
+		 * convert multiple samples at once. Only called if @p CanRead() returns true.
+		*/
+		virtual BasicSampleListType ReadBasicSamplesChild(size_t Count);
+
 		virtual void ClearChild() = 0;		//!< @copydoc Clear
 		///@}
 	};
@@ -416,8 +423,10 @@ namespace DynExpInstr
 			{
 				StreamBuffer.pubsync();
 
-				if (GetStreamSizeRead() >= GetStreamSizeWrite())
-					SeekAbs(GetWritePosition(), std::ios_base::in);
+				// The write pointer points to the buffer's end until the next sample wraps around.
+				const auto ReadSize = GetStreamSizeRead();
+				if (ReadSize >= GetStreamSizeWrite())
+					SeekAbs(ReadSize ? static_cast<unsigned long long>(std::streamoff(GetWritePosition())) % ReadSize : 0, std::ios_base::in);
 				else
 					return false;
 			}
@@ -46,6 +46,349 @@ namespace DynExpInstr
 		}
 	}
 
+	LockinSampleStream::LockinSampleStream(size_t BufferSizeInSamples)
+		: X(BufferSizeInSamples), Y(BufferSizeInSamples), Time(BufferSizeInSamples), Channel(BufferSizeInSamples)
+	{
+	}
+
+	bool LockinSampleStream::SeekRel(signed long long OffsetInSamples, std::ios_base::seekdir SeekDir, std::ios_base::openmode Which)
+	{
+		return SeekOffUnsafe(OffsetInSamples, SeekDir, Which) != -1;
+	}
+
+	bool LockinSampleStream::SeekAbs(unsigned long long PositionInSamples, std::ios_base::openmode Which)
+	{
+		return SeekPosUnsafe(Util::NumToT<long long>(PositionInSamples), Which) != -1;
+	}
+
+	void LockinSampleStream::SeekBeg(std::ios_base::openmode Which)
+	{
+		SeekAbs(0, Which);
+	}
+
+	void LockinSampleStream::SeekEnd(std::ios_base::openmode Which)
+	{
+		if (Which & std::ios_base::in)
+			SeekRel(-1, std::ios_base::end, std::ios_base::in);
+		if (Which & std::ios_base::out)
+			SeekRel(0, std::ios_base::end, std::ios_base::out);
+	}
+
+	bool LockinSampleStream::SeekEqual(std::ios_base::openmode Which)
+	{
+		if (Which & std::ios_base::in)
+		{
+			// The write pointer points to the buffer's end until the next sample wraps around.
+			if (GetAreaSize >= GetStreamSizeWrite())
+				SeekAbs(GetAreaSize ? WritePos % GetAreaSize : 0, std::ios_base::in);
+			else
+				return false;
+		}
+
+		// Read buffer is never larger than write buffer.
+		if (Which & std::ios_base::out)
+			SeekAbs(ReadPos, std::ios_base::out);
+
+		return true;
+	}
+
+	void LockinSampleStream::SetStreamSize(size_t BufferSizeInSamples)
+	{
+		X.resize(BufferSizeInSamples);
+		Y.resize(BufferSizeInSamples);
+		Time.resize(BufferSizeInSamples);
+		Channel.resize(BufferSizeInSamples);
+
+		WritePos = std::min(WritePos, BufferSizeInSamples);
+		ReadPos = std::min(ReadPos, BufferSizeInSamples);
+		GetAreaSize = std::min(GetAreaSize, BufferSizeInSamples);
+	}
+
+	void LockinSampleStream::WriteSample(const SampleType& Sample)
+	{
+		WriteRanges(1, [this, &Sample](size_t DestIndex, size_t, size_t) {
+			X[DestIndex] = Sample.CartesianResult.X;
+			Y[DestIndex] = Sample.CartesianResult.Y;
+			Time[DestIndex] = Sample.Time;
+			Channel[DestIndex] = Sample.Channel;
+		});
+	}
+
+	LockinSampleStream::SampleType LockinSampleStream::ReadSample()
+	{
+		SampleType Sample;
+
+		ReadRanges(1, [this, &Sample](size_t SrcIndex, size_t) {
+			Sample.Channel = Channel[SrcIndex];
+			Sample.Time = Time[SrcIndex];
+			Sample.CartesianResult = { X[SrcIndex], Y[SrcIndex] };
+			Sample.UpdatePolar();
+		});
+
+		return Sample;
+	}
+
+	void LockinSampleStream::WriteSamples(const std::vector<SampleType>& Samples)
+	{
+		// Each column is filled by a separate loop, so that every loop writes to contiguous memory.
+		WriteRanges(Samples.size(), [this, &Samples](size_t DestIndex, size_t SrcIndex, size_t Length) {
+			const auto Src = Samples.data() + SrcIndex;
+
+			for (size_t i = 0; i < Length; ++i)
+				X[DestIndex + i] = Src[i].CartesianResult.X;
+			for (size_t i = 0; i < Length; ++i)
+				Y[DestIndex + i] = Src[i].CartesianResult.Y;
+			for (size_t i = 0; i < Length; ++i)
+				Time[DestIndex + i] = Src[i].Time;
+			for (size_t i = 0; i < Length; ++i)
+				Channel[DestIndex + i] = Src[i].Channel;
+		});
+	}
+
+	std::vector<LockinSampleStream::SampleType> LockinSampleStream::ReadSamples(size_t Count)
+	{
+		std::vector<SampleType> Samples(Count);
+		size_t DestIndex = 0;
+
+		ReadRanges(Count, [this, &Samples, &DestIndex](size_t SrcIndex, size_t Length) {
+			const auto Dest = Samples.data() + DestIndex;
+
+			for (size_t i = 0; i < Length; ++i)
+			{
+				const auto SampleX = X[SrcIndex + i];
+				const auto SampleY = Y[SrcIndex + i];
+
+				// Same as LockinAmplifierDefs::LockinSample::UpdatePolar(), but inlined.
+				Dest[i].Channel = Channel[SrcIndex + i];
+				Dest[i].Time = Time[SrcIndex + i];
+				Dest[i].CartesianResult = { SampleX, SampleY };
+				Dest[i].PolarResult = { std::sqrt(SampleX * SampleX + SampleY * SampleY), std::atan(SampleY / SampleX) };
+			}
+
+			DestIndex += Length;
+		});
+
+		return Samples;
+	}
+
+	void LockinSampleStream::ReadValues(size_t Count, LockinAmplifierDefs::SignalType Signal, std::vector<DataType>& Values,
+		std::vector<DataType>* Times)
+	{
+		const auto Offset = Values.size();
+		Values.resize(Offset + Count);
+		if (Times)
+			Times->resize(Offset + Count);
+		size_t DestIndex = Offset;
+
+		// Selecting the coordinate once per contiguous range keeps the inner loops free of branches.
+		ReadRanges(Count, [this, Signal, &Values, Times, &DestIndex](size_t SrcIndex, size_t Length) {
+			const auto SrcX = X.data() + SrcIndex;
+			const auto SrcY = Y.data() + SrcIndex;
+			const auto Dest = Values.data() + DestIndex;
+
+			switch (Signal)
+			{
+			case LockinAmplifierDefs::SignalType::X:
+				std::copy_n(SrcX, Length, Dest);
+				break;
+			case LockinAmplifierDefs::SignalType::Y:
+				std::copy_n(SrcY, Length, Dest);
+				break;
+			case LockinAmplifierDefs::SignalType::R:
+				for (size_t i = 0; i < Length; ++i)
+					Dest[i] = std::sqrt(SrcX[i] * SrcX[i] + SrcY[i] * SrcY[i]);
+				break;
+			case LockinAmplifierDefs::SignalType::Theta:
+				for (size_t i = 0; i < Length; ++i)
+					Dest[i] = std::atan(SrcY[i] / SrcX[i]);
+				break;
+			default:
+				std::fill_n(Dest, Length, DataType(0));
+			}
+
+			if (Times)
+				std::copy_n(Time.data() + SrcIndex, Length, Times->data() + DestIndex);
+
+			DestIndex += Length;
+		});
+	}
+
+	void LockinSampleStream::ClearChild()
+	{
+		ReadPos = 0;
+		WritePos = 0;
+		GetAreaSize = 0;
+	}
+
+	template <typename FuncT>
+	void LockinSampleStream::WriteRanges(size_t Count, FuncT Func)
+	{
+		if (!Count)
+			return;
+
+		const auto BufferSize = GetStreamSizeWrite();
+		if (!BufferSize)
+			throw Util::OverflowException("Cannot write to a lock-in sample stream with a buffer size of 0.");
+
+		for (size_t SrcIndex = 0; SrcIndex < Count;)
+		{
+			// Restart from beginning if at buffer's end. Then, the entire buffer can be read.
+			if (WritePos == BufferSize)
+			{
+				WritePos = 0;
+				GetAreaSize = BufferSize;
+			}
+
+			const auto Length = std::min(Count - SrcIndex, BufferSize - WritePos);
+			Func(WritePos, SrcIndex, Length);
+
+			WritePos += Length;
+			SrcIndex += Length;
+			GetAreaSize = std::max(GetAreaSize, WritePos);
+		}
+
+		NumSamplesWritten = Count > std::numeric_limits<decltype(NumSamplesWritten)>::max() - NumSamplesWritten ?
+			std::numeric_limits<decltype(NumSamplesWritten)>::max() : NumSamplesWritten + Count;
+	}
+
+	template <typename FuncT>
+	void LockinSampleStream::ReadRanges(size_t Count, FuncT Func)
+	{
+		if (!Count)
+			return;
+
+		if (!GetAreaSize)
+			throw Util::UnderflowException("Cannot read from an empty lock-in sample stream.");
+
+		for (size_t NumRead = 0; NumRead < Count;)
+		{
+			// Restart from beginning if at buffer's end
+			if (ReadPos == GetAreaSize)
+				ReadPos = 0;
+
+			const auto Length = std::min(Count - NumRead, GetAreaSize - ReadPos);
+			Func(ReadPos, Length);
+
+			ReadPos += Length;
+			NumRead += Length;
+		}
+	}
+
+	long long LockinSampleStream::SeekOffUnsafe(long long Offset, std::ios_base::seekdir SeekDir, std::ios_base::openmode Which)
+	{
+		const bool In = Which & std::ios_base::in;
+		const bool Out = Which & std::ios_base::out;
+		long long NewPos = -1;
+
+		// Moves Position by Offset wrapping around within [0, Size).
+		const auto Wrap = [Offset](long long Position, long long Size) {
+			if (Size)
+				Position += std::abs(Offset % Size) * (Offset >= 0 ? 1 : -1);
+			else
+				Position += Offset;
+
+			// Check boundaries
+			if (Position < 0 || Size <= Position)
+				Position += Size * (Position < 0 ? 1 : -1);
+
+			return Position;
+		};
+
+		if (In)
+		{
+			const auto Size = Util::NumToT<long long>(GetAreaSize);
+			const auto AbsPosIn = SeekDir == std::ios_base::end ? Size :
+				(SeekDir == std::ios_base::cur ? Util::NumToT<long long>(ReadPos) : 0);
+			if (!Offset)
+				return AbsPosIn;
+
+			NewPos = SeekPosUnsafe(Wrap(AbsPosIn, Size), std::ios_base::in);
+		}
+
+		// Only do something if there wasn't any error.
+		if (Out && ((In && NewPos >= 0) || !In))
+		{
+			const auto Size = Util::NumToT<long long>(GetStreamSizeWrite());
+			const auto AbsPosOut = SeekDir == std::ios_base::end ? Size :
+				(SeekDir == std::ios_base::cur ? Util::NumToT<long long>(WritePos) : 0);
+			if (!Offset)
+				return AbsPosOut;
+
+			const auto NewPosOut = SeekPosUnsafe(Wrap(AbsPosOut, Size), std::ios_base::out);
+			if (NewPosOut < 0 || !In)
+				NewPos = NewPosOut;
+		}
+
+		// Behaves as Util::circularbuf::seekoff(), which reports an error if both pointers are moved.
+		return In && Out ? -1 : NewPos;
+	}
+
+	long long LockinSampleStream::SeekPosUnsafe(long long Position, std::ios_base::openmode Which)
+	{
+		bool Fail = false;
+
+		if (Which & std::ios_base::in)
+		{
+			if (Util::NumToT<long long>(GetAreaSize) <= Position || Position < 0)
+				Fail = true;
+			else
+				ReadPos = static_cast<size_t>(Position);
+		}
+
+		if (Which & std::ios_base::out && !Fail)
+		{
+			if (Util::NumToT<long long>(GetStreamSizeWrite()) <= Position || Position < 0)
+				Fail = true;
+			else
+			{
+				WritePos = static_cast<size_t>(Position);
+
+				// As for Util::circularbuf, the get area always extends to the write pointer.
+				GetAreaSize = std::max(GetAreaSize, WritePos);
+			}
+		}
+
+		return Fail ? -1 : Position;
+	}
+
+	void LockinSampleStream::WriteBasicSampleChild(const BasicSample& Sample)
+	{
+		LockinAmplifierDefs::LockinResultCartesian Result;
+
+		switch (Signal)
+		{
+		case LockinAmplifierDefs::SignalType::Y: Result = { 0, Sample.Value }; break;
+		case LockinAmplifierDefs::SignalType::Theta: Result = { std::cos(Sample.Value), std::sin(Sample.Value) }; break;
+		default: Result = { Sample.Value, 0 };
+		}
+
+		WriteRanges(1, [this, &Sample, &Result](size_t DestIndex, size_t, size_t) {
+			X[DestIndex] = Result.X;
+			Y[DestIndex] = Result.Y;
+			Time[DestIndex] = Sample.Time;
+			Channel[DestIndex] = 0;
+		});
+	}
+
+	BasicSample LockinSampleStream::ReadBasicSampleChild()
+	{
+		const auto Sample = ReadSample();
+
+		return { Sample.GetDisambiguatedValue(Signal), Sample.Time };
+	}
+
+	DataStreamBase::BasicSampleListType LockinSampleStream::ReadBasicSamplesChild(size_t Count)
+	{
+		std::vector<DataType> Values, Times;
+		ReadValues(Count, Signal, Values, &Times);
+
+		BasicSampleListType Samples(Count);
+		for (size_t i = 0; i < Count; ++i)
+			Samples[i] = { Values[i], Times[i] };
+
+		return Samples;
+	}
+
 	void LockinAmplifierTasks::InitTask::InitFuncImpl(dispatch_tag<DataStreamInstrumentTasks::InitTask>, DynExp::InstrumentInstance& Instance)
 	{
 		auto Owner = DynExp::dynamic_Object_cast<LockinAmplifier>(&Instance.GetOwner());
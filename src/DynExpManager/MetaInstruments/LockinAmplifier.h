@@ -169,6 +169,173 @@ namespace DynExpInstr
 		};
 	}
 
+	/**
+	 * @brief Implements a circular data stream of LockinAmplifierDefs::LockinSample samples. In contrast to
+	 * CircularDataStream<LockinAmplifierDefs::LockinSample>, the samples are stored as a structure of arrays
+	 * (one contiguous column per sample component) and only the cartesian representation of the samples is
+	 * stored. The polar representation is computed when samples are read. Converting samples to basic samples
+	 * (refer to DataStreamBase::ReadBasicSamples()) only computes the coordinate selected by SetSignalType().
+	 * The read and write pointers behave exactly as the ones of Util::circularbuf apart from the get area
+	 * growing as soon as samples are written (and not only when Util::circularbuf synchronizes).
+	*/
+	class LockinSampleStream : public CircularDataStreamBase
+	{
+	public:
+		using SampleType = LockinAmplifierDefs::LockinSample;		//!< Type of the samples stored in the data stream
+		using DataType = SampleType::DataType;						//!< Data type of the samples' components
+
+		/**
+		 * @brief Constructs a @p LockinSampleStream instance.
+		 * @param BufferSizeInSamples Initial stream buffer size in samples
+		*/
+		LockinSampleStream(size_t BufferSizeInSamples);
+
+		virtual ~LockinSampleStream() = default;
+
+		bool IsBasicSampleConvertible() const noexcept override final { return true; }
+		bool IsBasicSampleTimeUsed() const noexcept override final { return true; }
+
+		/**
+		 * @brief Getter for #Signal.
+		 * @return Returns the coordinate the values of basic samples refer to.
+		*/
+		LockinAmplifierDefs::SignalType GetSignalType() const noexcept { return Signal; }
+
+		/**
+		 * @brief Setter for #Signal. Applies to samples which have been written before, too.
+		 * @param Signal Coordinate the values of basic samples refer to.
+		*/
+		void SetSignalType(LockinAmplifierDefs::SignalType Signal) noexcept { this->Signal = Signal; }
+
+		size_t GetNumAvailableSamplesToReadTillEnd() const noexcept override { return GetAreaSize - ReadPos; }
+		size_t GetNumFreeSamplesToWrite() const noexcept override { return GetStreamSizeWrite() - WritePos; }
+		std::streampos GetReadPosition() const noexcept override { return ReadPos; }
+		std::streampos GetWritePosition() const noexcept override { return WritePos; }
+
+		virtual bool SeekRel(signed long long OffsetInSamples, std::ios_base::seekdir SeekDir,
+			std::ios_base::openmode Which = std::ios_base::in | std::ios_base::out) override;
+		virtual bool SeekAbs(unsigned long long PositionInSamples,
+			std::ios_base::openmode Which = std::ios_base::in | std::ios_base::out) override;
+		virtual void SeekBeg(std::ios_base::openmode Which = std::ios_base::in | std::ios_base::out) override;
+		virtual void SeekEnd(std::ios_base::openmode Which = std::ios_base::in | std::ios_base::out) override;
+		virtual bool SeekEqual(std::ios_base::openmode Which = std::ios_base::in | std::ios_base::out) override;
+
+		virtual size_t GetStreamSizeRead() const noexcept override { return GetAreaSize; }
+		virtual size_t GetStreamSizeWrite() const noexcept override { return X.size(); }
+		virtual size_t GetNumSamplesWritten() const noexcept override { return NumSamplesWritten; }
+		virtual void SetStreamSize(size_t BufferSizeInSamples) override;
+
+		/**
+		 * @brief Writes a single sample to the stream. Only the cartesian representation of @p Sample is stored.
+		 * @param Sample Sample to write
+		 * @throws Util::OverflowException is thrown if the stream's buffer size is 0.
+		*/
+		void WriteSample(const SampleType& Sample);
+
+		/**
+		 * @brief Reads a single sample from the stream computing its polar representation.
+		 * @return Sample read
+		 * @throws Util::UnderflowException is thrown if the stream does not contain any sample.
+		*/
+		SampleType ReadSample();
+
+		/**
+		 * @brief Writes multiple samples to the stream copying their components column-wise.
+		 * Only the cartesian representation of the samples is stored.
+		 * @param Samples List of samples to write
+		 * @throws Util::OverflowException is thrown if the stream's buffer size is 0 and
+		 * @p Samples is not empty.
+		*/
+		void WriteSamples(const std::vector<SampleType>& Samples);
+
+		/**
+		 * @brief Reads multiple samples from the stream computing their polar representation.
+		 * @param Count Amount of samples to read
+		 * @return Samples read
+		 * @throws Util::UnderflowException is thrown if the stream does not contain any sample
+		 * and @p Count is greater than 0.
+		*/
+		std::vector<SampleType> ReadSamples(size_t Count);
+
+		/**
+		 * @brief Reads the coordinate @p Signal of multiple samples from the stream without
+		 * computing the other coordinates.
+		 * @param Count Amount of samples to read
+		 * @param Signal Coordinate of the sample values to read
+		 * @param Values Values read are appended to this vector.
+		 * @param Times Times of the samples read are appended to this vector if it is not @p nullptr.
+		 * @throws Util::UnderflowException is thrown if the stream does not contain any sample
+		 * and @p Count is greater than 0.
+		*/
+		void ReadValues(size_t Count, LockinAmplifierDefs::SignalType Signal, std::vector<DataType>& Values,
+			std::vector<DataType>* Times = nullptr);
+
+	protected:
+		virtual void ClearChild() override;
+
+	private:
+		/**
+		 * @brief Writes @p Count samples invoking @p Func once per contiguous range of the buffer to fill.
+		 * @tparam FuncT Callable with signature <tt>void(size_t DestIndex, size_t SrcIndex, size_t Length)</tt>
+		 * @param Count Amount of samples to write
+		 * @param Func Function copying the samples with indices [@p SrcIndex, @p SrcIndex + @p Length)
+		 * to the columns starting at @p DestIndex
+		 * @throws Util::OverflowException is thrown if the stream's buffer size is 0 and @p Count is greater than 0.
+		*/
+		template <typename FuncT>
+		void WriteRanges(size_t Count, FuncT Func);
+
+		/**
+		 * @brief Reads @p Count samples invoking @p Func once per contiguous range of the buffer to read.
+		 * Reading continues at the buffer's beginning after reaching the get area's end.
+		 * @tparam FuncT Callable with signature <tt>void(size_t SrcIndex, size_t Length)</tt>
+		 * @param Count Amount of samples to read
+		 * @param Func Function reading the samples from the columns starting at @p SrcIndex
+		 * @throws Util::UnderflowException is thrown if the stream does not contain any sample and
+		 * @p Count is greater than 0.
+		*/
+		template <typename FuncT>
+		void ReadRanges(size_t Count, FuncT Func);
+
+		/**
+		 * @brief Moves the read and/or write pointer as Util::circularbuf::seekoff() does.
+		 * @return Returns the new absolute position or -1 in case of an error.
+		*/
+		long long SeekOffUnsafe(long long Offset, std::ios_base::seekdir SeekDir, std::ios_base::openmode Which);
+
+		/**
+		 * @brief Moves the read and/or write pointer as Util::circularbuf::seekpos() does.
+		 * @return Returns @p Position or -1 in case of an error.
+		*/
+		long long SeekPosUnsafe(long long Position, std::ios_base::openmode Which);
+
+		/**
+		 * @brief Converts a basic sample to a lock-in sample interpreting BasicSample::Value as the
+		 * coordinate #Signal. The respective other cartesian or polar coordinate is assumed to be 0.
+		*/
+		virtual void WriteBasicSampleChild(const BasicSample& Sample) override;
+
+		virtual BasicSample ReadBasicSampleChild() override;
+		virtual BasicSampleListType ReadBasicSamplesChild(size_t Count) override;
+
+		/** @name Columns
+		 * Components of the stored samples. All columns always have the same size.
+		*/
+		///@{
+		std::vector<DataType> X;					//!< @copydoc LockinAmplifierDefs::LockinResultCartesian::X
+		std::vector<DataType> Y;					//!< @copydoc LockinAmplifierDefs::LockinResultCartesian::Y
+		std::vector<DataType> Time;					//!< @copydoc LockinAmplifierDefs::LockinSample::Time
+		std::vector<uint8_t> Channel;				//!< @copydoc LockinAmplifierDefs::LockinSample::Channel
+		///@}
+
+		size_t ReadPos = 0;							//!< Position of the read (get) pointer in samples
+		size_t WritePos = 0;						//!< Position of the write (put) pointer in samples
+		size_t GetAreaSize = 0;						//!< Amount of samples which can be read (size of the get area)
+		size_t NumSamplesWritten = 0;				//!< Amount of samples which have been written to the stream in total
+
+		LockinAmplifierDefs::SignalType Signal = LockinAmplifierDefs::SignalType::X;	//!< Coordinate the values of basic samples refer to
+	};
+
 	/**
 	 * @brief Tasks for @p LockinAmplifier
 	*/
@@ -220,7 +387,7 @@ namespace DynExpInstr
 	class LockinAmplifierData : public DataStreamInstrumentData
 	{
 	public:
-		using SampleStreamType = BasicSampleStream;		//!< Data stream type this data stream instrument operates on.
+		using SampleStreamType = LockinSampleStream;	//!< Data stream type this data stream instrument operates on.
 
 		/**
 		 * @brief Constructs a @p LockinAmplifierData instance.
@@ -25,35 +25,218 @@ namespace DynExpInstr
 		}
 	}
 
-	SpectrometerData::SpectrumType::SpectrumType(SpectrumType&& Other)
-		: FrequencyUnit(Other.FrequencyUnit), IntensityUnit(Other.IntensityUnit), Samples(std::move(Other.Samples))
+	SpectrometerData::SpectrumType::SpectrumType(SpectrumType&& Other) noexcept
+		: FrequencyUnit(Other.FrequencyUnit), IntensityUnit(Other.IntensityUnit),
+		Frequencies(std::move(Other.Frequencies)), Intensities(std::move(Other.Intensities))
 	{
 		Other.Reset();
 	}
 
-	SpectrometerData::SpectrumType& SpectrometerData::SpectrumType::operator=(const SpectrumType& Other)
+	SpectrometerData::SpectrumType& SpectrometerData::SpectrumType::operator=(SpectrumType&& Other) noexcept
 	{
 		FrequencyUnit = Other.FrequencyUnit;
 		IntensityUnit = Other.IntensityUnit;
-		Samples = Other.Samples;
+		Frequencies = std::move(Other.Frequencies);
+		Intensities = std::move(Other.Intensities);
+
+		Other.Reset();
 
 		return *this;
 	}
 
-	SpectrometerData::SpectrumType& SpectrometerData::SpectrumType::operator=(SpectrumType&& Other)
+	void SpectrometerData::SpectrumType::Reset()
 	{
-		FrequencyUnit = Other.FrequencyUnit;
-		IntensityUnit = Other.IntensityUnit;
-		Samples = std::move(Other.Samples);
+		Frequencies.clear();
+		Intensities.clear();
+	}
 
-		Other.Reset();
+	void SpectrometerData::SpectrumType::Reserve(size_t NumSamples)
+	{
+		Frequencies.reserve(NumSamples);
+		Intensities.reserve(NumSamples);
+	}
+
+	std::pair<double, double> SpectrometerData::SpectrumType::GetIntensityRange() const
+	{
+		if (!HasSpectrum())
+			throw Util::EmptyException("The spectrum does not contain any sample.");
+
+		const auto MinMax = std::minmax_element(Intensities.cbegin(), Intensities.cend());
+
+		return { *MinMax.first, *MinMax.second };
+	}
+
+	void SpectrometerData::SpectrumType::AddSample(double Frequency, double Intensity)
+	{
+		// Fast path for samples being added in ascending order.
+		if (Frequencies.empty() || Frequency > Frequencies.back())
+		{
+			Frequencies.push_back(Frequency);
+			Intensities.push_back(Intensity);
+
+			return;
+		}
+
+		const auto Pos = std::lower_bound(Frequencies.begin(), Frequencies.end(), Frequency);
+		const auto Index = std::distance(Frequencies.begin(), Pos);
+		if (*Pos == Frequency)
+			Intensities[Index] = Intensity;
+		else
+		{
+			Frequencies.insert(Pos, Frequency);
+			Intensities.insert(Intensities.begin() + Index, Intensity);
+		}
+	}
+
+	void SpectrometerData::SpectrumType::SetSamples(std::vector<double>&& Frequencies, std::vector<double>&& Intensities)
+	{
+		if (Frequencies.size() != Intensities.size())
+			throw Util::InvalidArgException("The number of frequencies and intensities has to be equal.");
+
+		if (!std::is_sorted(Frequencies.cbegin(), Frequencies.cend()))
+		{
+			std::vector<size_t> Indices(Frequencies.size());
+			std::iota(Indices.begin(), Indices.end(), 0);
+			std::stable_sort(Indices.begin(), Indices.end(), [&Frequencies](size_t a, size_t b) { return Frequencies[a] < Frequencies[b]; });
+
+			std::vector<double> SortedFrequencies(Frequencies.size()), SortedIntensities(Intensities.size());
+			for (size_t i = 0; i < Indices.size(); ++i)
+			{
+				SortedFrequencies[i] = Frequencies[Indices[i]];
+				SortedIntensities[i] = Intensities[Indices[i]];
+			}
+
+			Frequencies = std::move(SortedFrequencies);
+			Intensities = std::move(SortedIntensities);
+		}
+
+		this->Frequencies = std::move(Frequencies);
+		this->Intensities = std::move(Intensities);
+	}
+
+	SpectrometerData::SpectrumType& SpectrometerData::SpectrumType::SubtractBackground(const SpectrumType& Background)
+	{
+		CheckUnits(Background);
+		if (!Background.HasSpectrum())
+			throw Util::InvalidArgException("The background spectrum does not contain any sample.");
+
+		if (Frequencies == Background.Frequencies)
+		{
+			std::transform(Intensities.cbegin(), Intensities.cend(), Background.Intensities.cbegin(), Intensities.begin(), std::minus<double>());
+
+			return *this;
+		}
+
+		// Both frequency axes are sorted, so the interpolation interval only moves forward.
+		const auto& BgFrequencies = Background.Frequencies;
+		const auto& BgIntensities = Background.Intensities;
+		size_t j = 0;
+		for (size_t i = 0; i < Frequencies.size(); ++i)
+		{
+			const auto Frequency = Frequencies[i];
+			while (j + 1 < BgFrequencies.size() && BgFrequencies[j + 1] < Frequency)
+				++j;
+
+			double BgIntensity{};
+			if (Frequency <= BgFrequencies.front())
+				BgIntensity = BgIntensities.front();
+			else if (Frequency >= BgFrequencies.back())
+				BgIntensity = BgIntensities.back();
+			else
+			{
+				const auto t = (Frequency - BgFrequencies[j]) / (BgFrequencies[j + 1] - BgFrequencies[j]);
+				BgIntensity = BgIntensities[j] + t * (BgIntensities[j + 1] - BgIntensities[j]);
+			}
+
+			Intensities[i] -= BgIntensity;
+		}
 
 		return *this;
 	}
 
-	void SpectrometerData::SpectrumType::Reset()
+	SpectrometerData::SpectrumType& SpectrometerData::SpectrumType::Accumulate(const SpectrumType& Other)
+	{
+		CheckUnits(Other);
+
+		if (!HasSpectrum())
+		{
+			Frequencies = Other.Frequencies;
+			Intensities = Other.Intensities;
+
+			return *this;
+		}
+
+		if (Frequencies != Other.Frequencies)
+			throw Util::InvalidArgException("Only spectra with identical frequency axes can be accumulated.");
+
+		std::transform(Intensities.cbegin(), Intensities.cend(), Other.Intensities.cbegin(), Intensities.begin(), std::plus<double>());
+
+		return *this;
+	}
+
+	SpectrometerData::SpectrumType& SpectrometerData::SpectrumType::Scale(double Factor) noexcept
+	{
+		for (auto& Intensity : Intensities)
+			Intensity *= Factor;
+
+		return *this;
+	}
+
+	SpectrometerData::SpectrumType SpectrometerData::SpectrumType::Average(std::span<const SpectrumType> Spectra)
+	{
+		if (Spectra.empty())
+			return {};
+
+		SpectrumType Result(Spectra.front().GetFrequencyUnit(), Spectra.front().GetIntensityUnit());
+		for (const auto& Spectrum : Spectra)
+			Result.Accumulate(Spectrum);
+
+		return std::move(Result.Scale(1.0 / Spectra.size()));
+	}
+
+	SpectrometerData::SpectrumType SpectrometerData::SpectrumType::Bin(size_t BinSize) const
+	{
+		if (!BinSize)
+			throw Util::InvalidArgException("The bin size must not be zero.");
+
+		SpectrumType Result(FrequencyUnit, IntensityUnit);
+		Result.Reserve((GetNumSamples() + BinSize - 1) / BinSize);
+
+		for (size_t i = 0; i < GetNumSamples(); i += BinSize)
+		{
+			const auto Count = std::min(BinSize, GetNumSamples() - i);
+			const auto FrequencySum = std::accumulate(Frequencies.cbegin() + i, Frequencies.cbegin() + i + Count, 0.0);
+			const auto IntensitySum = std::accumulate(Intensities.cbegin() + i, Intensities.cbegin() + i + Count, 0.0);
+
+			// Means of sorted and consecutive frequencies are sorted, too.
+			Result.Frequencies.push_back(FrequencySum / Count);
+			Result.Intensities.push_back(IntensitySum / Count);
+		}
+
+		return Result;
+	}
+
+	SpectrometerData::SpectrumType SpectrometerData::SpectrumType::ExtractROI(double LowerFrequency, double UpperFrequency) const
+	{
+		SpectrumType Result(FrequencyUnit, IntensityUnit);
+		if (LowerFrequency > UpperFrequency)
+			return Result;
+
+		const auto First = std::lower_bound(Frequencies.cbegin(), Frequencies.cend(), LowerFrequency);
+		const auto Last = std::upper_bound(First, Frequencies.cend(), UpperFrequency);
+		const auto FirstIndex = std::distance(Frequencies.cbegin(), First);
+		const auto LastIndex = std::distance(Frequencies.cbegin(), Last);
+
+		Result.Frequencies.assign(First, Last);
+		Result.Intensities.assign(Intensities.cbegin() + FirstIndex, Intensities.cbegin() + LastIndex);
+
+		return Result;
+	}
+
+	void SpectrometerData::SpectrumType::CheckUnits(const SpectrumType& Other) const
 	{
-		Samples.clear();
+		if (FrequencyUnit != Other.FrequencyUnit || IntensityUnit != Other.IntensityUnit)
+			throw Util::InvalidArgException("The units of both spectra have to be equal.");
 	}
 
 	SpectrometerData::SpectrumType SpectrometerData::GetSpectrum() const
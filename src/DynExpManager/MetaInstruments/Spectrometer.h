@@ -116,6 +116,9 @@ namespace DynExpInstr
 
 		/**
 		 * @brief Type describing a spectrum as acquired by the @p Spectrometer instrument.
+		 * The samples are stored as a structure of arrays (#Frequencies and #Intensities) which
+		 * are sorted by frequency in ascending order. The spectrum is meant to be handed off by
+		 * moving it from the instrument to the consumer. Then, no sample needs to be copied.
 		*/
 		class SpectrumType
 		{
@@ -137,46 +140,142 @@ namespace DynExpInstr
 			 * @brief Copy-constructs a @p SpectrumType instance.
 			 * @param Other Spectrum to copy from
 			*/
-			SpectrumType(const SpectrumType& Other) : FrequencyUnit(Other.FrequencyUnit), IntensityUnit(Other.IntensityUnit), Samples(Other.Samples) {}
+			SpectrumType(const SpectrumType& Other) = default;
 			
 			/**
 			 * @brief Move-constructs a @p SpectrumType instance.
-			 * @param Other Spectrum to move from. #Samples of @p Other will be empty after the operation.
+			 * @param Other Spectrum to move from. @p Other will be empty after the operation.
 			*/
-			SpectrumType(SpectrumType&& Other);
+			SpectrumType(SpectrumType&& Other) noexcept;
 
 			/**
 			 * @brief Copies a @p SpectrumType instance's content to this instance.
 			 * @param Other Spectrum to copy from
 			 * @return Returns a reference to this @p SpectrumType instance.
 			*/
-			SpectrumType& operator=(const SpectrumType& Other);
+			SpectrumType& operator=(const SpectrumType& Other) = default;
 
 			/**
 			 * @brief Moves a @p SpectrumType instance's content to this instance.
-			 * @param Other Spectrum to move from. #Samples of @p Other will be empty after the operation.
+			 * @param Other Spectrum to move from. @p Other will be empty after the operation.
 			 * @return Returns a reference to this @p SpectrumType instance.
 			*/
-			SpectrumType& operator=(SpectrumType&& Other);
+			SpectrumType& operator=(SpectrumType&& Other) noexcept;
 
-			void Reset();	//!< Removes all samples from the spectrum (clears #Samples).
+			void Reset();	//!< Removes all samples from the spectrum (clears #Frequencies and #Intensities).
 
-			auto GetFrequencyUnit() const noexcept { return FrequencyUnit; }	//!< Getter for #FrequencyUnit.
-			auto GetIntensityUnit() const noexcept { return IntensityUnit; }	//!< Getter for #IntensityUnit.
-			auto& GetSpectrum() const noexcept { return Samples; }				//!< Getter for #Samples.
-			auto& GetSpectrum() noexcept { return Samples; }					//!< Getter for #Samples.
+			/**
+			 * @brief Reserves memory for @p NumSamples samples to avoid reallocations when adding samples.
+			 * @param NumSamples Expected number of samples
+			*/
+			void Reserve(size_t NumSamples);
+
+			auto GetFrequencyUnit() const noexcept { return FrequencyUnit; }		//!< Getter for #FrequencyUnit.
+			auto GetIntensityUnit() const noexcept { return IntensityUnit; }		//!< Getter for #IntensityUnit.
+			const auto& GetFrequencies() const noexcept { return Frequencies; }		//!< Getter for #Frequencies.
+			const auto& GetIntensities() const noexcept { return Intensities; }		//!< Getter for #Intensities.
+			auto& GetIntensities() noexcept { return Intensities; }					//!< Getter for #Intensities. The frequency axis cannot be altered directly to keep it sorted.
+			size_t GetNumSamples() const noexcept { return Frequencies.size(); }	//!< Returns the number of samples of the spectrum.
 
 			/**
 			 * @brief Indicates whether the spectrum is empty.
-			 * @return Returns true when SpectrumType::Samples contain at least one sample, false otherwise.
+			 * @return Returns true when the spectrum contains at least one sample, false otherwise.
+			*/
+			bool HasSpectrum() const noexcept { return !Frequencies.empty(); }
+
+			/**
+			 * @brief Determines the smallest and the largest intensity of the spectrum.
+			 * @return Pair of minimal and maximal intensity
+			 * @throws Util::EmptyException is thrown if the spectrum is empty.
+			*/
+			std::pair<double, double> GetIntensityRange() const;
+
+			/**
+			 * @brief Adds a sample to the spectrum. Appending samples in ascending frequency order is
+			 * cheapest. If a sample at @p Frequency already exists, its intensity is overwritten.
+			 * @param Frequency Frequency of the sample in units of #FrequencyUnit
+			 * @param Intensity Intensity of the sample in units of #IntensityUnit
+			*/
+			void AddSample(double Frequency, double Intensity);
+
+			/**
+			 * @brief Replaces all samples of the spectrum by moving from the given vectors. If the
+			 * frequencies are not in ascending order, the samples are sorted.
+			 * @param Frequencies Frequencies of the samples in units of #FrequencyUnit
+			 * @param Intensities Intensities of the samples in units of #IntensityUnit
+			 * @throws Util::InvalidArgException is thrown if the sizes of @p Frequencies and
+			 * @p Intensities differ.
+			*/
+			void SetSamples(std::vector<double>&& Frequencies, std::vector<double>&& Intensities);
+
+			/**
+			 * @brief Subtracts a background spectrum from this spectrum. If the frequency axes of both
+			 * spectra differ, the background is linearly interpolated (and extrapolated with its
+			 * boundary values) at this spectrum's frequencies.
+			 * @param Background Background spectrum to subtract
+			 * @return Returns a reference to this @p SpectrumType instance.
+			 * @throws Util::InvalidArgException is thrown if the units of both spectra differ or if
+			 * @p Background is empty.
+			*/
+			SpectrumType& SubtractBackground(const SpectrumType& Background);
+
+			/**
+			 * @brief Adds the intensities of another spectrum with an identical frequency axis to this
+			 * spectrum. If this spectrum is empty, @p Other is copied.
+			 * @param Other Spectrum to accumulate
+			 * @return Returns a reference to this @p SpectrumType instance.
+			 * @throws Util::InvalidArgException is thrown if the units or the frequency axes of both
+			 * spectra differ.
+			*/
+			SpectrumType& Accumulate(const SpectrumType& Other);
+
+			/**
+			 * @brief Multiplies all intensities by a factor, e.g. to average accumulated spectra.
+			 * @param Factor Factor to multiply the intensities with
+			 * @return Returns a reference to this @p SpectrumType instance.
+			*/
+			SpectrumType& Scale(double Factor) noexcept;
+
+			/**
+			 * @brief Averages the given spectra, which need to have identical frequency axes.
+			 * @param Spectra Spectra to average
+			 * @return Averaged spectrum. Empty if @p Spectra is empty.
+			 * @throws Util::InvalidArgException is thrown if the units or the frequency axes
+			 * of the spectra differ.
 			*/
-			bool HasSpectrum() const noexcept { return !Samples.empty(); }
+			static SpectrumType Average(std::span<const SpectrumType> Spectra);
+
+			/**
+			 * @brief Combines each @p BinSize consecutive samples to a single sample whose frequency
+			 * and intensity are the means of the combined samples' frequencies and intensities.
+			 * Remaining samples at the end of the spectrum form a smaller last bin.
+			 * @param BinSize Number of samples to combine
+			 * @return Binned spectrum
+			 * @throws Util::InvalidArgException is thrown if @p BinSize is zero.
+			*/
+			SpectrumType Bin(size_t BinSize) const;
+
+			/**
+			 * @brief Extracts the samples within a region of interest.
+			 * @param LowerFrequency Lower frequency limit (inclusive) in units of #FrequencyUnit
+			 * @param UpperFrequency Upper frequency limit (inclusive) in units of #FrequencyUnit
+			 * @return Spectrum containing only the samples within the specified frequency range
+			*/
+			SpectrumType ExtractROI(double LowerFrequency, double UpperFrequency) const;
 
 		private:
+			/**
+			 * @brief Checks whether @p Other has the same units as this spectrum.
+			 * @param Other Spectrum to compare with
+			 * @throws Util::InvalidArgException is thrown if the units differ.
+			*/
+			void CheckUnits(const SpectrumType& Other) const;
+
 			FrequencyUnitType FrequencyUnit;	//!< The spectrum's frequency (x-axis) unit.
 			IntensityUnitType IntensityUnit;	//!< The spectrum's intensity (y-axis) unit.
 
-			std::map<double, double> Samples;	//!< Samples of the spectrum as tuples in units (#FrequencyUnit, #IntensityUnit)
+			std::vector<double> Frequencies;	//!< Frequencies of the samples in units of #FrequencyUnit sorted in ascending order
+			std::vector<double> Intensities;	//!< Intensities of the samples in units of #IntensityUnit. Same size as #Frequencies.
 		};
 
 		SpectrometerData() = default;
@@ -5,10 +5,122 @@
 
 namespace DynExpInstr
 {
+	void PositionerStageTasks::InitTask::InitFuncImpl(dispatch_tag<InitTaskBase>, DynExp::InstrumentInstance& Instance)
+	{
+		{
+			auto InstrParams = DynExp::dynamic_Params_cast<PositionerStage>(Instance.ParamsGetter());
+			auto InstrData = DynExp::dynamic_InstrumentData_cast<PositionerStage>(Instance.InstrumentDataGetter());
+
+			const auto PositionTraceSize = Util::NumToT<size_t>(InstrParams->PositionTraceSize.Get());
+			InstrData->EnablePositionTrace(PositionTraceSize);
+
+			DynExp::dynamic_Object_cast<PositionerStage>(&Instance.GetOwner())->PositionTracePollingInterval = PositionTraceSize ?
+				std::chrono::milliseconds(Util::NumToT<std::chrono::milliseconds::rep>(InstrParams->PositionTracePollingInterval.Get())) :
+				std::chrono::milliseconds(0);
+		} // InstrParams and InstrData unlocked here.
+
+		InitFuncImpl(dispatch_tag<InitTask>(), Instance);
+	}
+
+	void PositionerStageData::SetCurrentPosition(PositionType Position, PositionTraceClockType::time_point Time)
+	{
+		this->Position = Position;
+
+		if (!PositionTrace)
+			return;
+
+		const auto TraceTime = ToPositionTraceTime(Time);
+		if (TraceTime < LastPositionTraceTime)
+			return;
+
+		PositionTrace->WriteSample({ static_cast<BasicSample::DataType>(Position), TraceTime });
+		LastPositionTraceTime = TraceTime;
+	}
+
+	void PositionerStageData::EnablePositionTrace(size_t BufferSizeInSamples)
+	{
+		if (!BufferSizeInSamples)
+		{
+			DisablePositionTrace();
+
+			return;
+		}
+
+		PositionTrace = std::make_unique<PositionTraceType>(BufferSizeInSamples);
+		PositionTraceStartTime = PositionTraceClockType::now();
+		LastPositionTraceTime = 0;
+	}
+
+	PositionerStageData::PositionTraceType& PositionerStageData::GetPositionTrace()
+	{
+		if (!PositionTrace)
+			throw Util::InvalidStateException("The position trace of this positioner stage is disabled.");
+
+		return *PositionTrace;
+	}
+
+	BasicSample::DataType PositionerStageData::ToPositionTraceTime(PositionTraceClockType::time_point Time) const noexcept
+	{
+		return std::chrono::duration<BasicSample::DataType>(Time - PositionTraceStartTime).count();
+	}
+
+	double PositionerStageData::InterpolatePosition(PositionTraceClockType::time_point Time)
+	{
+		return InterpolatePositions({ Time }).front();
+	}
+
+	std::vector<double> PositionerStageData::InterpolatePositions(const std::vector<PositionTraceClockType::time_point>& Times)
+	{
+		std::vector<double> Positions(Times.size(), static_cast<double>(Position));
+		if (!PositionTrace || Times.empty())
+			return Positions;
+
+		// Samples are sorted by time (refer to SetCurrentPosition()). So, only the most recent samples back to the
+		// last one preceding the earliest time of interest are required. Read windows of growing size until the
+		// window covers that sample to avoid copying the entire trace.
+		constexpr size_t MinWindowSize = 64;
+		const auto MinTime = ToPositionTraceTime(*std::min_element(Times.cbegin(), Times.cend()));
+		const auto NumAvailableSamples = PositionTrace->GetNumRecentBasicSamples(0);
+		DataStreamBase::BasicSampleListType Samples;
+		for (auto WindowSize = std::min(MinWindowSize, NumAvailableSamples); ; WindowSize = std::min(2 * WindowSize, NumAvailableSamples))
+		{
+			Samples = PositionTrace->ReadRecentBasicSamples(PositionTrace->GetNumSamplesWritten() - WindowSize);
+			if (Samples.empty() || Samples.front().Time <= MinTime || WindowSize == NumAvailableSamples)
+				break;
+		}
+
+		if (Samples.empty())
+			return Positions;
+
+		for (size_t i = 0; i < Times.size(); ++i)
+		{
+			const auto Time = ToPositionTraceTime(Times[i]);
+			const auto Upper = std::lower_bound(Samples.cbegin(), Samples.cend(), Time,
+				[](const BasicSample& Sample, BasicSample::DataType Time) { return Sample.Time < Time; });
+
+			if (Upper == Samples.cbegin())
+				Positions[i] = Upper->Value;
+			else if (Upper == Samples.cend())
+				Positions[i] = Samples.back().Value;
+			else
+			{
+				const auto Lower = std::prev(Upper);
+				const auto TimeSpan = Upper->Time - Lower->Time;
+
+				Positions[i] = TimeSpan > 0 ?
+					Lower->Value + (Upper->Value - Lower->Value) * (Time - Lower->Time) / TimeSpan : Upper->Value;
+			}
+		}
+
+		return Positions;
+	}
+
 	void PositionerStageData::ResetImpl(dispatch_tag<InstrumentDataBase>)
 	{
 		Position = 0;
 		Velocity = 0;
+		PositionTrace.reset();
+		LastPositionTraceTime = 0;
 
 		ResetImpl(dispatch_tag<PositionerStageData>());
 	}
@@ -25,6 +137,13 @@ namespace DynExpInstr
 	{
 	}
 
+	std::chrono::milliseconds PositionerStage::GetTaskQueueDelay() const
+	{
+		const auto PositionTracePollingInterval = this->PositionTracePollingInterval.load();
+
+		return PositionTracePollingInterval.count() ? PositionTracePollingInterval : std::chrono::milliseconds(100);
+	}
+
 	void PositionerStage::SetHome() const
 	{
 		throw Util::NotImplementedException();
@@ -47,6 +166,8 @@ namespace DynExpInstr
 
 	void PositionerStage::ResetImpl(dispatch_tag<InstrumentBase>)
 	{
+		PositionTracePollingInterval = std::chrono::milliseconds(0);
+
 		ResetImpl(dispatch_tag<PositionerStage>());
 	}
 }
\ No newline at end of file
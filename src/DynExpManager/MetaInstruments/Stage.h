@@ -9,6 +9,7 @@
 
 #include "stdafx.h"
 #include "Instrument.h"
+#include "DataStreamInstrument.h"
 
 namespace DynExpInstr
 {
@@ -24,7 +25,7 @@ namespace DynExpInstr
 		*/
 		class InitTask : public DynExp::InitTaskBase
 		{
-			void InitFuncImpl(dispatch_tag<InitTaskBase>, DynExp::InstrumentInstance& Instance) override final { InitFuncImpl(dispatch_tag<InitTask>(), Instance); }
+			void InitFuncImpl(dispatch_tag<InitTaskBase>, DynExp::InstrumentInstance& Instance) override final;
 
 			/**
 			 * @copydoc InitFuncImpl(dispatch_tag<DynExp::InitTaskBase>, DynExp::InstrumentInstance&)
@@ -70,14 +71,92 @@ namespace DynExpInstr
 		*/
 		using PositionType = signed long long;
 
+		/**
+		 * @brief Clock used to timestamp the samples of the position trace #PositionTrace
+		*/
+		using PositionTraceClockType = std::chrono::system_clock;
+
+		/**
+		 * @brief Type of the stream storing the position trace. Each sample's value is a
+		 * position in units of #Position, each sample's time is given in seconds relative to
+		 * #PositionTraceStartTime.
+		*/
+		using PositionTraceType = BasicSampleStream;
+
 		PositionerStageData() = default;
 		virtual ~PositionerStageData() = default;
 
 		auto GetCurrentPosition() const noexcept { return Position; }							//!< Returns #Position.
 		auto GetVelocity() const noexcept { return Velocity; }									//!< Returns #Velocity.
-		void SetCurrentPosition(PositionType Position) noexcept { this->Position = Position; }	//!< Sets #Position to @p #Position.
 		void SetVelocity(PositionType Velocity) noexcept { this->Velocity = Velocity; }			//!< Sets #Velocity to @p #Velocity.
 
+		/**
+		 * @brief Sets #Position to @p Position. If the position trace is enabled, @p Position is
+		 * also written to #PositionTrace timestamped with the current time.
+		 * @param Position New position in nm if the stage supports SI units, in step units otherwise
+		*/
+		void SetCurrentPosition(PositionType Position) { SetCurrentPosition(Position, PositionTraceClockType::now()); }
+
+		/**
+		 * @brief Sets #Position to @p Position. If the position trace is enabled, @p Position is
+		 * also written to #PositionTrace timestamped with @p Time. Call this overload if the time the
+		 * position has been determined at is known more precisely than the time this function is called.
+		 * @param Position New position in nm if the stage supports SI units, in step units otherwise
+		 * @param Time Time point the stage has been at @p Position
+		*/
+		void SetCurrentPosition(PositionType Position, PositionTraceClockType::time_point Time);
+
+		/** @name Position trace
+		 * The optional position trace records timestamped positions each time the position is updated.
+		 * This allows modules to determine where the stage has been at arbitrary times within the
+		 * trace's time span while locking the instrument data only once.
+		*/
+		///@{
+		/**
+		 * @brief Enables the position trace discarding any samples recorded before.
+		 * @param BufferSizeInSamples Number of samples the position trace is able to hold.
+		 * Disables the position trace if zero.
+		*/
+		void EnablePositionTrace(size_t BufferSizeInSamples);
+
+		void DisablePositionTrace() noexcept { PositionTrace.reset(); }						//!< Disables the position trace discarding all its samples.
+		bool IsPositionTraceEnabled() const noexcept { return PositionTrace != nullptr; }	//!< Returns whether the position trace is enabled.
+		auto GetPositionTraceStartTime() const noexcept { return PositionTraceStartTime; }	//!< Returns #PositionTraceStartTime.
+
+		/**
+		 * @brief Getter for #PositionTrace
+		 * @return Returns the stream containing the position trace.
+		 * @throws Util::InvalidStateException is thrown if the position trace is disabled.
+		*/
+		PositionTraceType& GetPositionTrace();
+
+		/**
+		 * @brief Converts a time point into a time of the samples of #PositionTrace.
+		 * @param Time Time point to convert
+		 * @return Returns @p Time in seconds relative to #PositionTraceStartTime.
+		*/
+		BasicSample::DataType ToPositionTraceTime(PositionTraceClockType::time_point Time) const noexcept;
+
+		/**
+		 * @brief Determines the stage's position at time @p Time by linearly interpolating in
+		 * between the two samples of #PositionTrace enclosing @p Time. Times outside the time span
+		 * covered by #PositionTrace are clamped to the first or the last sample, respectively.
+		 * @param Time Time point to determine the stage's position at
+		 * @return Position at time @p Time in units of #Position. Returns #Position if the position
+		 * trace is disabled or if it does not contain any samples yet.
+		*/
+		double InterpolatePosition(PositionTraceClockType::time_point Time);
+
+		/**
+		 * @brief Determines the stage's positions at multiple times. Refer to @p InterpolatePosition().
+		 * Only reads the most recent samples of #PositionTrace back to the sample preceding the
+		 * earliest of @p Times instead of copying the entire trace.
+		 * @param Times Time points to determine the stage's positions at
+		 * @return Positions with the same order as @p Times
+		*/
+		std::vector<double> InterpolatePositions(const std::vector<PositionTraceClockType::time_point>& Times);
+		///@}
+
 		bool IsMoving() const noexcept { return IsMovingChild(); }								//!< Returns whether the stage is currently moving (result of @p IsMovingChild())
 		bool HasArrived() const noexcept { return HasArrivedChild(); }							//!< Returns whether the stage has arrived at its destiny position (result of @p HasArrivedChild())
 		bool HasFailed() const noexcept { return HasFailedChild(); }							//!< Returns whether the stage is in an error state, i.e. moving has failed (result of @p HasFailedChild())
@@ -110,6 +189,23 @@ namespace DynExpInstr
 		 * @brief Velocity in nm/s if the respective stage supports SI units. Otherwise, in units of steps/s.
 		*/
 		PositionType Velocity = 0;
+
+		/**
+		 * @brief Stream of timestamped positions. nullptr if the position trace is disabled.
+		*/
+		DataStreamPtrType<PositionTraceType> PositionTrace;
+
+		/**
+		 * @brief Time point the position trace has been enabled at. Times of #PositionTrace's
+		 * samples are specified relative to this time point.
+		*/
+		PositionTraceClockType::time_point PositionTraceStartTime;
+
+		/**
+		 * @brief Time of the most recent sample written to #PositionTrace. Older samples are
+		 * discarded to keep #PositionTrace sorted by time.
+		*/
+		BasicSample::DataType LastPositionTraceTime = 0;
 	};
 
 	/**
@@ -128,11 +224,23 @@ namespace DynExpInstr
 
 		virtual const char* GetParamClassTag() const noexcept override { return "PositionerStageParams"; }
 
+		/**
+		 * @brief Number of samples the position trace is able to hold. Refer to PositionerStageData::EnablePositionTrace().
+		*/
+		Param<ParamsConfigDialog::NumberType> PositionTraceSize = { *this, "PositionTraceSize", "Position trace size",
+			"Number of timestamped positions to keep recording the stage's position history. Set to 0 to disable the position trace.",
+			true, 0, 0, 1 << 24, 1, 0 };
+
+		/**
+		 * @brief Interval in ms in between subsequent position updates if the position trace is enabled.
+		*/
+		Param<ParamsConfigDialog::NumberType> PositionTracePollingInterval = { *this, "PositionTracePollingInterval", "Position trace polling interval (ms)",
+			"Time in between subsequent position updates if the position trace is enabled. Stages with a fixed update interval ignore this setting.",
+			true, 20, 1, 1000, 1, 0 };
+
 	private:
 		void ConfigureParamsImpl(dispatch_tag<InstrumentParamsBase>) override final { ConfigureParamsImpl(dispatch_tag<PositionerStageParams>()); }
 		virtual void ConfigureParamsImpl(dispatch_tag<PositionerStageParams>) {}	//!< @copydoc ConfigureParamsImpl(dispatch_tag<DynExp::InstrumentParamsBase>)
-
-		DummyParam Dummy = { *this };												//!< @copydoc DynExp::ParamsBase::DummyParam
 	};
 
 	/**
@@ -194,7 +302,12 @@ namespace DynExpInstr
 		virtual std::string GetName() const override { return Name(); }
 		virtual std::string GetCategory() const override { return Category(); }
 
-		virtual std::chrono::milliseconds GetTaskQueueDelay() const override { return std::chrono::milliseconds(100); }
+		/**
+		 * @brief Updates the stage's data every 100 ms or at the position trace's polling interval
+		 * if the position trace is enabled. Also refer to PositionerStageParams::PositionTracePollingInterval.
+		 * @copydetails DynExp::InstrumentBase::GetTaskQueueDelay
+		*/
+		virtual std::chrono::milliseconds GetTaskQueueDelay() const override;
 
 		/** @name Override (instrument information)
 		 * Override by derived classes to provide information about the instrument.
@@ -300,5 +413,13 @@ namespace DynExpInstr
 	private:
 		void ResetImpl(dispatch_tag<InstrumentBase>) override final;
 		virtual void ResetImpl(dispatch_tag<PositionerStage>) = 0;				//!< @copydoc ResetImpl(dispatch_tag<DynExp::InstrumentBase>)
+
+		/**
+		 * @brief Polling interval if the position trace is enabled, zero otherwise. Cached
+		 * by PositionerStageTasks::InitTask since @p GetTaskQueueDelay() is called frequently.
+		*/
+		mutable std::atomic<std::chrono::milliseconds> PositionTracePollingInterval{ std::chrono::milliseconds(0) };
+
+		friend class PositionerStageTasks::InitTask;
 	};
 }
\ No newline at end of file
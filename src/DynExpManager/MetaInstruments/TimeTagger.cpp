@@ -44,10 +44,16 @@ namespace DynExpInstr
 		StreamModeChanged = true;
 	}
 
+	BasicSample::DataType TimeTaggerData::ToCountsTime(CountsClockType::time_point Time) const noexcept
+	{
+		return std::chrono::duration<BasicSample::DataType>(Time - CountsStartTime).count();
+	}
+
 	void TimeTaggerData::ResetImpl(dispatch_tag<DataStreamInstrumentData>)
 	{
 		StreamMode = StreamModeType::Counts;
 		HBTResults.Reset();
+		CountsStartTime = CountsClockType::now();
 
 		ResetImpl(dispatch_tag<TimeTaggerData>());
 	}
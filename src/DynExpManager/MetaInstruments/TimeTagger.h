@@ -138,6 +138,12 @@ namespace DynExpInstr
 
 		using SampleStreamType = BasicSampleStream;		//!< Data stream type this data stream instrument operates on.
 
+		/**
+		 * @brief Clock used to timestamp the samples written to the data stream in
+		 * StreamModeType::Counts stream mode
+		*/
+		using CountsClockType = std::chrono::system_clock;
+
 		/**
 		 * @brief Constructs a @p TimeTaggerData instance.
 		 * @param BufferSizeInSamples Initial buffer size of a data stream of type
@@ -167,6 +173,25 @@ namespace DynExpInstr
 		auto& GetHBTResults() const noexcept { return HBTResults; }					//!< Getter for #HBTResults
 		auto& GetHBTResults() noexcept { return HBTResults; }						//!< Getter for #HBTResults
 
+		auto GetCountsStartTime() const noexcept { return CountsStartTime; }		//!< Getter for #CountsStartTime
+
+		/**
+		 * @brief Converts a time point into a time of the samples written to the data stream
+		 * in StreamModeType::Counts stream mode.
+		 * @param Time Time point to convert
+		 * @return Returns @p Time in seconds relative to #CountsStartTime.
+		*/
+		BasicSample::DataType ToCountsTime(CountsClockType::time_point Time) const noexcept;
+
+		/**
+		 * @brief Determines whether the derived instrument timestamps the samples written to the data
+		 * stream in StreamModeType::Counts stream mode relative to #CountsStartTime (refer to @p ToCountsTime()).
+		 * Otherwise, the samples' times are not related to #CountsStartTime (e.g. they are zero or relative
+		 * to a remote clock), and modules have to timestamp the samples when reading them.
+		 * @return Override to return true if the count samples are timestamped relative to #CountsStartTime.
+		*/
+		virtual bool AreCountsTimestamped() const noexcept { return false; }
+
 	private:
 		void ResetImpl(dispatch_tag<DataStreamInstrumentData>) override final;
 		virtual void ResetImpl(dispatch_tag<TimeTaggerData>) {};					//!< @copydoc ResetImpl(dispatch_tag<DynExp::InstrumentDataBase>)
@@ -193,6 +218,13 @@ namespace DynExpInstr
 		 * @brief Stores the results of a g^(2) measurement.
 		*/
 		HBTResultsType HBTResults;
+
+		/**
+		 * @brief Time point the times of the samples written to the data stream in StreamModeType::Counts
+		 * stream mode are specified relative to. Derived instruments are supposed to timestamp each count
+		 * sample with the end of its exposure interval (refer to @p ToCountsTime()).
+		*/
+		CountsClockType::time_point CountsStartTime = CountsClockType::now();
 	};
 
 	/**
@@ -51,8 +51,7 @@ namespace DynExp
 						}
 					}
 
-					while (Module->GetModuleData()->GetNumEnqueuedEvents())
-						Module->ModuleThreadOnly.HandleEvent(Instance);
+					while (Module->ModuleThreadOnly.HandleEvent(Instance));
 
 					if (!IsExiting)
 					{
@@ -155,25 +154,21 @@ namespace DynExp
 		if (!Event)
 			throw Util::InvalidArgException("Event cannot be nullptr.");
 
-		EventQueue.push(std::move(Event));
+		EventQueue.Push(std::move(Event));
 		NewEventNotifier.Notify();
 	}
 
 	ModuleDataBase::EventPtrType ModuleDataBase::PopEvent()
 	{
-		if (EventQueue.empty())
-			return nullptr;
+		auto Event = EventQueue.Pop();
 
-		auto Event = std::move(EventQueue.front());
-		EventQueue.pop();
-
-		return Event;
+		return Event ? std::move(*Event) : nullptr;
 	}
 
 	void ModuleDataBase::Reset()
 	{
 		ModuleException = nullptr;
-		EventQueueType().swap(EventQueue);	// clear EventQueue
+		while (EventQueue.Pop());	// clear EventQueue
 
 		ResetImpl(dispatch_tag<ModuleDataBase>());
 	}
@@ -211,32 +206,21 @@ namespace DynExp
 
 	void ModuleBase::EnqueueEvent(ModuleDataBase::EventPtrType&& Event) const
 	{
-		GetNonConstModuleData()->EnqueueEvent(std::move(Event));
-	}
-
-	ModuleBase::ModuleDataTypeSyncPtrType ModuleBase::GetNonConstModuleData(const std::chrono::milliseconds Timeout) const
-	{
-		return ModuleDataTypeSyncPtrType(ModuleData.get(), Timeout);
+		// The event queue is synchronized on its own. Not locking ModuleData avoids contending with the module thread.
+		ModuleData->EnqueueEvent(std::move(Event));
 	}
 
-	void ModuleBase::HandleEvent(ModuleInstance& Instance)
+	bool ModuleBase::HandleEvent(ModuleInstance& Instance)
 	{
 		EnsureCallFromRunnableThread();
 
-		ModuleDataBase::EventPtrType EventPtr;
-
-		{
-			// Locks ModuleData
-			auto ModuleDataPtr = GetModuleData();
-
-			if (!ModuleDataPtr->GetNumEnqueuedEvents())
-				return;
+		auto EventPtr = ModuleData->PopEvent();
+		if (!EventPtr)
+			return false;
 
-			EventPtr = ModuleDataPtr->PopEvent();
-		} // ModuleData unlocked here
+		EventPtr->Invoke(Instance);
 
-		if (EventPtr)
-			EventPtr->Invoke(Instance);
+		return true;
 	}
 
 	void ModuleBase::AddRegisteredEvent(EventListenersBase& EventListeners)
@@ -327,7 +311,7 @@ namespace DynExp
 
 	void ModuleBase::NotifyChild()
 	{
-		GetModuleData()->ModuleBaseOnly.GetNewEventNotifier().Notify();
+		ModuleData->ModuleBaseOnly.GetNewEventNotifier().Notify();
 	}
 
 	void ModuleBase::TerminateChild(const std::chrono::milliseconds Timeout)
@@ -398,6 +382,42 @@ namespace DynExp
 	{
 	}
 
+	/**
+	 * @brief Registry of all InterModuleEventCounters instances. Function-local to be constructed
+	 * before the first (static) InterModuleEventCounters instance registers itself.
+	*/
+	static auto& GetInterModuleEventCountersRegistry()
+	{
+		static std::pair<std::mutex, std::vector<const InterModuleEventCounters*>> Registry;
+
+		return Registry;
+	}
+
+	InterModuleEventCounters::InterModuleEventCounters(std::string EventName)
+		: EventName(std::move(EventName))
+	{
+		auto& Registry = GetInterModuleEventCountersRegistry();
+		std::lock_guard<std::mutex> lock(Registry.first);
+
+		Registry.second.push_back(this);
+	}
+
+	InterModuleEventCounters::~InterModuleEventCounters()
+	{
+		auto& Registry = GetInterModuleEventCountersRegistry();
+		std::lock_guard<std::mutex> lock(Registry.first);
+
+		std::erase(Registry.second, this);
+	}
+
+	std::vector<const InterModuleEventCounters*> InterModuleEventCounters::GetAll()
+	{
+		auto& Registry = GetInterModuleEventCountersRegistry();
+		std::lock_guard<std::mutex> lock(Registry.first);
+
+		return Registry.second;
+	}
+
 	InterModuleEventBase::~InterModuleEventBase()
 	{
 	}
@@ -624,6 +644,25 @@ namespace DynExp
 
 		Widget->setEnabled(true);
 		UpdateUIChild({ *this, &ModuleBase::GetModuleData, { ModuleBase::GetModuleDataTimeoutDefault } });
+		LastUIUpdate = std::chrono::system_clock::now();
+	}
+
+	bool QModuleBase::IsUIVisible() noexcept
+	{
+		if (!Widget)
+			return false;
+
+		// QWidget::isVisible() is only true if all ancestors are visible as well. The module window
+		// remains visible in this sense when its frame or the main window are minimized.
+		if (!Widget->isVisible() || Widget->window()->isMinimized())
+			return false;
+
+		return !(IsWindowDocked() && MdiSubWindow && MdiSubWindow->isMinimized());
+	}
+
+	bool QModuleBase::IsUIUpdateDue() noexcept
+	{
+		return IsUIVisible() || std::chrono::system_clock::now() - LastUIUpdate >= HiddenUIUpdateInterval;
 	}
 
 	void QModuleBase::UpdateModuleWindowFocusAction()
@@ -62,8 +62,10 @@ namespace DynExp
 
 	/**
 	 * @brief Common base class for all events to store them in a FIFO queue to be invoked later.
+	 * Events are allocated from Util::SmallObjectPool since they are created frequently by one thread
+	 * (e.g. the user interface thread) and destroyed by another one (the receiving module's thread).
 	*/
-	class EventBase
+	class EventBase : public Util::PooledAllocation
 	{
 	public:
 		EventBase() = default;
@@ -155,6 +157,31 @@ namespace DynExp
 		const EventFuncType EventFunc;
 	};
 
+	/**
+	 * @brief Wraps an immutable event shared by multiple receivers. When an event is fanned out to
+	 * many modules, the event itself is only created once and each receiver's queue only holds this
+	 * small (pooled) wrapper referencing the shared event.
+	*/
+	class SharedEvent : public EventBase
+	{
+	public:
+		/**
+		 * @brief Constructs a @p SharedEvent instance.
+		 * @param Payload @copydoc Payload
+		*/
+		SharedEvent(std::shared_ptr<const EventBase> Payload) noexcept : Payload(std::move(Payload)) {}
+
+		virtual ~SharedEvent() {}
+
+	private:
+		virtual void InvokeChild(ModuleInstance& Instance) const override { Payload->Invoke(Instance); }
+
+		/**
+		 * @brief Event shared by all receivers. Must not be @p nullptr.
+		*/
+		const std::shared_ptr<const EventBase> Payload;
+	};
+
 	/**
 	 * @brief Data structure to contain data which is synchronized in between different threads.
 	 * This is needed since the module thread as well as the main thread might access the module
@@ -176,9 +203,10 @@ namespace DynExp
 		using EventPtrType = std::unique_ptr<EventBase>;
 
 		/**
-		 * @brief A module's event queue is a FIFO queue owning the enqueued events.
+		 * @brief A module's event queue is a lock-free FIFO queue owning the enqueued events. Any thread
+		 * might enqueue events. Only the module thread dequeues them.
 		*/
-		using EventQueueType = std::queue<EventPtrType>;
+		using EventQueueType = Util::MPSCQueue<EventPtrType>;
 
 	protected:
 		/**
@@ -237,13 +265,14 @@ namespace DynExp
 
 		/** @name Module event queue
 		 * Methods to access and manipulate the event queue belonging to the module which owns
-		 * the respective @p ModuleDataBase's instance
+		 * the respective @p ModuleDataBase's instance. The event queue is synchronized on its own.
+		 * So, these methods do not require the @p ModuleDataBase's instance to be locked.
 		*/
 		///@{
 		/**
 		 * @brief Enqueues @p Event at the module event queue's back. Takes ownership of the event.
 		 * Notifies the module owning the respective @p ModuleDataBase's instance that a new event has
-		 * been enqueued.
+		 * been enqueued. Thread-safe, lock-free.
 		 * @param Event Pointer to the event to be enqueued. Must not be nullptr.
 		 * @throws Util::InvalidArgException is thrown if @p Event is nullptr.
 		*/
@@ -251,29 +280,17 @@ namespace DynExp
 		
 		/**
 		 * @brief Removes one event from the event queue's front and returns the event.
-		 * Ownership of the event is transferred to the caller of this method.
+		 * Ownership of the event is transferred to the caller of this method. Must only be
+		 * called by the module thread.
 		 * @return Pointer to the popped event or nullptr if the event queue is empty.
 		*/
 		EventPtrType PopEvent();
-		
-		/**
-		 * @brief Returns a pointer to the event in the front of the module's event queue
-		 * without transferring ownership and without removing the event from the queue.
-		 * @return Constant pointer to the event
-		*/
-		const auto& GetEventFront() const noexcept { return *EventQueue.front().get(); }
-
-		/**
-		 * @copybrief ModuleDataBase::GetEventFront() const
-		 * @return Pointer to the event
-		*/
-		auto& GetEventFront() noexcept { return *EventQueue.front().get(); }
 
 		/**
 		 * @brief Getter for the module event queue's length
-		 * @return Returns the number of currently enqueued events.
+		 * @return Returns the approximate number of currently enqueued events.
 		*/
-		size_t GetNumEnqueuedEvents() const noexcept { return EventQueue.size(); }
+		size_t GetNumEnqueuedEvents() const noexcept { return EventQueue.Size(); }
 		///@}
 
 		/**
@@ -405,7 +422,7 @@ namespace DynExp
 			*/
 			constexpr ModuleThreadOnlyType(ModuleBase& Parent) noexcept : Parent(Parent) {}
 
-			void HandleEvent(ModuleInstance& Instance) { Parent.HandleEvent(Instance); }														//<! @copydoc ModuleBase::HandleEvent
+			bool HandleEvent(ModuleInstance& Instance) { return Parent.HandleEvent(Instance); }												//<! @copydoc ModuleBase::HandleEvent
 			Util::DynExpErrorCodes::DynExpErrorCodes ModuleMainLoop(ModuleInstance& Instance) { return Parent.ExecModuleMainLoop(Instance); }	//<! @copydoc ModuleBase::ExecModuleMainLoop
 			void OnPause(ModuleInstance& Instance) { Parent.OnPause(Instance); }																//<! @copydoc ModuleBase::OnPause
 			void OnResume(ModuleInstance& Instance) { Parent.OnResume(Instance); }																//<! @copydoc ModuleBase::OnResume
@@ -586,20 +603,6 @@ namespace DynExp
 		using ModuleDataGetterType = Util::CallableMemberWrapper<ModuleBase,
 			ModuleDataTypeSyncPtrType (ModuleBase::*)(const std::chrono::milliseconds)>;
 
-	private:
-		/** @name Private functions for logical const-ness
-		 * Logical const-ness: refer to ModuleBase::MakeAndEnqueueEvent().
-		*/
-		///@{
-		/**
-		 * @brief Always allows @p ModuleBase to obtain a non-const pointer to the module's data -
-		 * even in const event functions.
-		 * @param Timeout Time to wait for locking the mutex of #ModuleData.
-		 * @return Returns a pointer to @p ModuleDataType (non-const) to allow access all of its members.
-		*/
-		ModuleDataTypeSyncPtrType GetNonConstModuleData(const std::chrono::milliseconds Timeout = GetModuleDataTimeoutDefault) const;
-		///@}
-
 	protected:
 		/**
 		 * @brief Getter for ModuleDataBase::ModuleException assuming that the module data
@@ -616,9 +619,11 @@ namespace DynExp
 		///@{
 		/**
 		 * @brief Executes and removes the next pending event from the module's event queue.
+		 * Does not lock #ModuleData.
 		 * @param Instance Handle to the module thread's data
+		 * @return Returns true if an event has been executed, false if the event queue was empty.
 		*/
-		void HandleEvent(ModuleInstance& Instance);
+		bool HandleEvent(ModuleInstance& Instance);
 
 		/**
 		 * @brief Adds a manager of event listeners to #RegisteredEvents if it was not already added before.
@@ -898,7 +903,14 @@ namespace DynExp
 		*/
 		using EventFunctionType = std::function<void(ModuleInstance*, EventFuncArgs...)>;
 
-		TypedEventListeners() = default;
+		/**
+		 * @brief Immutable snapshot of the mapping of modules to their event functions. Register() and
+		 * Deregister() replace the snapshot by a modified copy (copy-on-write). So, looking up listeners
+		 * neither locks a mutex nor copies event functions.
+		*/
+		using ListenersSnapshotType = std::shared_ptr<const std::unordered_map<const ModuleBase*, EventFunctionType>>;
+
+		TypedEventListeners() : Listeners(std::make_shared<const std::unordered_map<const ModuleBase*, EventFunctionType>>()) {}
 		virtual ~TypedEventListeners() = default;
 
 		/**
@@ -925,17 +937,27 @@ namespace DynExp
 
 		/**
 		 * @brief Looks up the event function the module @p Listener has registered/subscribed with.
+		 * Does not lock the mutex of this @p EventListenersBase instance.
 		 * @param Listener Module to look up the registered event function for
-		 * @param Timeout Time to wait for locking the mutex of this @p EventListenersBase instance.
 		 * @return Returns the registered event function or @p nullptr if @p Listener has not
 		 * registered/subscribed for this event.
 		*/
-		EventFunctionType GetFunc(const ModuleBase& Listener, const std::chrono::milliseconds Timeout = DefaultTimeout) const
+		EventFunctionType GetFunc(const ModuleBase& Listener) const
 		{
-			auto lock = AcquireLock(Timeout);
-			return GetFuncUnsafe(Listener);
+			const auto Snapshot = GetListeners();
+			auto ListenerIt = Snapshot->find(&Listener);
+
+			return ListenerIt != Snapshot->cend() ? ListenerIt->second : nullptr;
 		}
 
+		/**
+		 * @brief Returns the current snapshot of all registered listeners. Thread-safe. Does not lock
+		 * the mutex of this @p EventListenersBase instance. The snapshot stays valid (but might become
+		 * outdated) while it is held.
+		 * @return Returns the current snapshot of the mapping of modules to their event functions.
+		*/
+		ListenersSnapshotType GetListeners() const noexcept { return Listeners.load(std::memory_order_acquire); }
+
 	private:
 		/**
 		 * @brief This function is the version of @p Register() which is not thread-safe (assuming
@@ -948,9 +970,11 @@ namespace DynExp
 		template <typename CallableT>
 		void RegisterUnsafe(const ModuleBase& Listener, CallableT EventFunc) 
 		{
-			Listeners[&Listener] = [&Listener, EventFunc](ModuleInstance* Instance, EventFuncArgs... Args) {
+			auto NewListeners = std::make_shared<std::unordered_map<const ModuleBase*, EventFunctionType>>(*Listeners.load(std::memory_order_relaxed));
+			(*NewListeners)[&Listener] = [&Listener, EventFunc](ModuleInstance* Instance, EventFuncArgs... Args) {
 				(dynamic_cast<std::add_const_t<typename Util::member_fn_ptr_traits<CallableT>::instance_type>&>(Listener).*EventFunc)(Instance, Args...);
 			};
+			Listeners.store(std::move(NewListeners), std::memory_order_release);
 
 			Listener.EventListenersOnly.AddRegisteredEvent(*this);
 		}
@@ -962,32 +986,53 @@ namespace DynExp
 		*/
 		void DeregisterUnsafe(const ModuleBase& Listener)
 		{
-			auto ListenerIt = Listeners.find(&Listener);
-			if (ListenerIt == Listeners.cend())
+			const auto OldListeners = Listeners.load(std::memory_order_relaxed);
+			if (!OldListeners->contains(&Listener))
 				return;
 
-			Listeners.erase(ListenerIt);
+			auto NewListeners = std::make_shared<std::unordered_map<const ModuleBase*, EventFunctionType>>(*OldListeners);
+			NewListeners->erase(&Listener);
+			Listeners.store(std::move(NewListeners), std::memory_order_release);
+
 			Listener.EventListenersOnly.RemoveRegisteredEvent(*this);
 		}
 
 		/**
-		 * @brief This function is the version of @p GetFunc() which is not thread-safe (assuming
-		 * @p EventListenersBase's mutex has already been locked before.
-		 * @param Listener Module to look up the registered event function for
-		 * @return Returns the registered event function or @p nullptr if @p Listener has not
-		 * registered/subscribed for this event.
+		 * @brief Each module can register to each inter-module event with one event
+		 * function of type @p EventFunctionType. This mapping is stored here. Modified
+		 * (replaced) only while the mutex of this @p EventListenersBase instance is locked.
 		*/
-		EventFunctionType GetFuncUnsafe(const ModuleBase& Listener) const
-		{
-			auto ListenerIt = Listeners.find(&Listener);
-			return ListenerIt != Listeners.cend() ? ListenerIt->second : nullptr;
-		}
+		std::atomic<ListenersSnapshotType> Listeners;
+	};
+
+	/**
+	 * @brief Counts how often an inter-module event type has been posted, delivered to a subscribed
+	 * module, or dropped (since the receiving module was not running or has not subscribed to the event).
+	 * Each @p InterModuleEvent type owns one instance. All instances register themselves such that they
+	 * can be enumerated by GetAll() for diagnostics. Counting is thread-safe and lock-free.
+	*/
+	class InterModuleEventCounters : public Util::INonCopyable
+	{
+	public:
+		/**
+		 * @brief Constructs an @p InterModuleEventCounters instance and registers it.
+		 * @param EventName @copydoc EventName
+		*/
+		InterModuleEventCounters(std::string EventName);
+
+		~InterModuleEventCounters();
 
 		/**
-		 * @brief Each module can register to each inter-module event with one event
-		 * function of type @p EventFunctionType. This mapping is stored here.
+		 * @brief Returns all @p InterModuleEventCounters instances currently in existence.
+		 * @return List of pointers to all instances
 		*/
-		std::unordered_map<const ModuleBase*, EventFunctionType> Listeners;
+		static std::vector<const InterModuleEventCounters*> GetAll();
+
+		const std::string EventName;				//!< (Implementation-defined) type name of the counted event
+
+		std::atomic<size_t> NumPosted = 0;			//!< Number of times the event has been posted to a set of receivers
+		std::atomic<size_t> NumDelivered = 0;		//!< Number of times the event has been invoked on a subscribed receiver
+		std::atomic<size_t> NumDropped = 0;			//!< Number of times the event has been discarded for a single receiver
 	};
 
 	/**
@@ -1033,13 +1078,26 @@ namespace DynExp
 		*/
 		static void Deregister(const ModuleBase& Listener) { Listeners.Deregister(Listener); }
 
+		/**
+		 * @brief Getter for the event counters of @p DerivedEvent.
+		 * @return Returns #Counters.
+		*/
+		static auto& GetCounters() noexcept { return Counters; }
+
 	private:
 		virtual void InvokeChild(ModuleInstance& Instance) const override final
 		{
-			auto EventFunc = Listeners.GetFunc(static_cast<const ModuleBase&>(Instance.GetOwner()));
+			// Hold the snapshot while invoking to avoid copying the event function.
+			const auto Snapshot = Listeners.GetListeners();
+			auto ListenerIt = Snapshot->find(&static_cast<const ModuleBase&>(Instance.GetOwner()));
 
-			if (EventFunc)
-				InvokeWithParamsChild(Instance, EventFunc);
+			if (ListenerIt != Snapshot->cend() && ListenerIt->second)
+			{
+				++Counters.NumDelivered;
+				InvokeWithParamsChild(Instance, ListenerIt->second);
+			}
+			else
+				++Counters.NumDropped;
 		}
 
 		/** @name Override
@@ -1053,7 +1111,7 @@ namespace DynExp
 		 * is invoked on.
 		 * @param EventFunc Event function to invoke.
 		*/
-		virtual void InvokeWithParamsChild(ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const = 0;
+		virtual void InvokeWithParamsChild(ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const = 0;
 		///@}
 
 		/**
@@ -1061,6 +1119,11 @@ namespace DynExp
 		 * manages all the subscribers of @p DerivedEvent.
 		*/
 		static EventListenersType Listeners;
+
+		/**
+		 * @brief Holds one @p InterModuleEventCounters instance per derived event.
+		*/
+		static InterModuleEventCounters Counters;
 	};
 
 	/**
@@ -1070,6 +1133,13 @@ namespace DynExp
 	template <typename DerivedEvent, typename... EventFuncArgs>
 	typename InterModuleEvent<DerivedEvent, EventFuncArgs...>::EventListenersType InterModuleEvent<DerivedEvent, EventFuncArgs...>::Listeners;
 
+	/**
+	 * @brief Instantiate the respective static InterModuleEvent::Counters variable to avoid linker errors.
+	 * @copydetails InterModuleEvent
+	*/
+	template <typename DerivedEvent, typename... EventFuncArgs>
+	InterModuleEventCounters InterModuleEvent<DerivedEvent, EventFuncArgs...>::Counters(typeid(DerivedEvent).name());
+
 	/**
 	 * @brief Window class for Qt-based user interfaces belonging to %DynExp modules.
 	 * User interface Qt window classes belonging to a module derived from @p ModuleBase
@@ -1343,6 +1413,12 @@ namespace DynExp
 	class QModuleBase : public ModuleBase
 	{
 	public:
+		/**
+		 * @brief Minimal time between two calls to @p UpdateUI() by DynExpManager while #Widget is
+		 * hidden or minimized. Refer to @p IsUIUpdateDue().
+		*/
+		static constexpr std::chrono::milliseconds HiddenUIUpdateInterval = std::chrono::milliseconds(500);
+
 		using ParamsType = QModuleParamsBase;									//!< @copydoc Object::ParamsType
 		using ConfigType = QModuleConfiguratorBase;								//!< @copydoc Object::ConfigType
 		using ModuleDataType = QModuleDataBase;									//!< @copydoc ModuleBase::ModuleDataType
@@ -1377,6 +1453,22 @@ namespace DynExp
 		void DisableUI();					//!< Disables all user interface controls in #Widget. Does nothing if #Widget is @p nullptr.
 		void UpdateUI();					//!< Enables the user interface controls in #Widget. Does nothing if #Widget is @p nullptr. Calls @p UpdateUIChild().
 
+		/**
+		 * @brief Checks whether #Widget is currently visible to the user, i.e. it is shown and neither
+		 * its window frame nor the window containing the frame is minimized.
+		 * @return Returns true if #Widget is visible, false otherwise or if #Widget is @p nullptr.
+		*/
+		bool IsUIVisible() noexcept;
+
+		/**
+		 * @brief Determines whether DynExpManager should call @p UpdateUI() in the current update cycle.
+		 * Visible module windows are updated in every cycle. Hidden or minimized module windows are updated
+		 * at most every #HiddenUIUpdateInterval to save the time spent in @p UpdateUIChild() on widgets
+		 * nobody sees, while still keeping them reasonably up to date once they are shown again.
+		 * @return Returns true if #Widget should be updated now, false otherwise.
+		*/
+		bool IsUIUpdateDue() noexcept;
+
 		/**
 		 * @brief Updates the icon assigned to #ModuleWindowFocusAction depending on whether #Widget
 		 * is docked to or undocked from #MdiArea.
@@ -1494,6 +1586,8 @@ namespace DynExp
 		std::unique_ptr<QAction> ModuleWindowFocusAction;		//!< Qt action to push module window into focus. When triggered, QModuleWidget::OnFocusWindow() in invoked.
 
 		QMdiArea* MdiArea;										//!< Pointer to @p DynExpManager's QMdiArea
+
+		std::chrono::system_clock::time_point LastUIUpdate;		//!< Time point when @p UpdateUI() has called @p UpdateUIChild() the last time.
 	};
 
 	template <typename SenderType, typename SignalType, typename ReceiverType, typename EventType>
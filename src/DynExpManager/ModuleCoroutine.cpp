@@ -0,0 +1,203 @@
+// This file is part of DynExp.
+
+#include "stdafx.h"
+#include "ModuleCoroutine.h"
+
+namespace DynExp
+{
+	/**
+	 * @brief Event inserted into a module's event queue to resume the module's coroutine
+	 * (or to evaluate the condition the coroutine waits for) in the module thread.
+	*/
+	class ModuleCoroutineScheduler::ResumeEvent : public EventBase
+	{
+	public:
+		/**
+		 * @brief Constructs a @p ResumeEvent instance.
+		 * @param Token @copybrief #Token
+		*/
+		ResumeEvent(std::shared_ptr<ResumeTokenType> Token) noexcept : Token(std::move(Token)) {}
+
+		virtual ~ResumeEvent() {}
+
+	private:
+		virtual void InvokeChild(ModuleInstance& Instance) const override
+		{
+			// Only the module thread invalidates tokens. So, the scheduler cannot be destroyed in the meantime.
+			ModuleCoroutineScheduler* Scheduler = nullptr;
+			{
+				std::lock_guard<decltype(Token->Mutex)> lock(Token->Mutex);
+				Scheduler = Token->Scheduler;
+			} // Token->Mutex unlocked here.
+
+			if (Scheduler)
+				Scheduler->OnResumeEvent(Token);
+		}
+
+		const std::shared_ptr<ResumeTokenType> Token;		//!< Token identifying the coroutine's suspension to resume
+	};
+
+	void TaskFutureAwaiter::await_suspend(std::coroutine_handle<ModuleCoroutinePromise> Handle) const
+	{
+		Future.Then([Token = Handle.promise().Scheduler->MakeResumeToken()]() {
+			ModuleCoroutineScheduler::NotifyResume(Token);
+		});
+	}
+
+	void WaitUntilAwaiter::await_suspend(std::coroutine_handle<ModuleCoroutinePromise> Handle)
+	{
+		Handle.promise().Scheduler->WaitFor(std::move(Condition));
+	}
+
+	ModuleCoroutine& ModuleCoroutine::operator=(ModuleCoroutine&& Other) noexcept
+	{
+		if (this != &Other)
+		{
+			Destroy();
+			Handle = std::exchange(Other.Handle, nullptr);
+		}
+
+		return *this;
+	}
+
+	void ModuleCoroutine::Destroy() noexcept
+	{
+		if (Handle)
+			Handle.destroy();
+
+		Handle = nullptr;
+	}
+
+	void ModuleCoroutineScheduler::Start(ModuleCoroutine&& Coroutine)
+	{
+		if (!Coroutine)
+			throw Util::InvalidArgException("Coroutine must not be empty.");
+
+		Cancel();
+
+		this->Coroutine = std::move(Coroutine);
+		this->Coroutine.Handle.promise().Scheduler = this;
+
+		Resume();
+
+		if (Exception)
+			std::rethrow_exception(std::exchange(Exception, nullptr));
+	}
+
+	void ModuleCoroutineScheduler::Cancel() noexcept
+	{
+		InvalidateResumeToken();
+		PendingCondition.reset();
+		PendingRefreshTasks.clear();
+
+		Coroutine.Destroy();
+		Exception = nullptr;
+	}
+
+	bool ModuleCoroutineScheduler::Poll()
+	{
+		if (PendingCondition)
+		{
+			if (PendingCondition->Condition())
+				Resume();
+			else if (PendingCondition->Refresh && std::all_of(PendingRefreshTasks.cbegin(), PendingRefreshTasks.cend(),
+				[](const auto& Future) { return !Future.IsValid() || Future.IsReady(); }))
+				Refresh();
+		}
+
+		if (Exception)
+			std::rethrow_exception(std::exchange(Exception, nullptr));
+
+		return IsRunning();
+	}
+
+	std::shared_ptr<ModuleCoroutineScheduler::ResumeTokenType> ModuleCoroutineScheduler::MakeResumeToken()
+	{
+		InvalidateResumeToken();
+		ResumeToken = std::make_shared<ResumeTokenType>(this);
+
+		return ResumeToken;
+	}
+
+	void ModuleCoroutineScheduler::InvalidateResumeToken() noexcept
+	{
+		if (!ResumeToken)
+			return;
+
+		{
+			std::lock_guard<decltype(ResumeToken->Mutex)> lock(ResumeToken->Mutex);
+			ResumeToken->Scheduler = nullptr;
+		} // ResumeToken->Mutex unlocked here.
+
+		ResumeToken.reset();
+	}
+
+	void ModuleCoroutineScheduler::NotifyResume(const std::shared_ptr<ResumeTokenType>& Token)
+	{
+		std::lock_guard<decltype(Token->Mutex)> lock(Token->Mutex);
+
+		// Enqueueing an event does not block. So, it is fine to keep the token locked. This prevents
+		// the scheduler (and its owning module) from being destroyed while the event is enqueued.
+		if (Token->Scheduler)
+			Token->Scheduler->Owner.EnqueueEvent(std::make_unique<ResumeEvent>(Token));
+	}
+
+	void ModuleCoroutineScheduler::OnResumeEvent(const std::shared_ptr<ResumeTokenType>& Token)
+	{
+		if (Token != ResumeToken || !IsRunning())
+			return;
+
+		// Awaiting a task: the task has completed. Awaiting a condition: the refresh tasks have completed.
+		if (!PendingCondition || PendingCondition->Condition())
+			Resume();
+	}
+
+	void ModuleCoroutineScheduler::WaitFor(WaitUntil&& Condition)
+	{
+		PendingCondition = std::move(Condition);
+		PendingRefreshTasks.clear();
+
+		if (PendingCondition->Refresh)
+			Refresh();
+	}
+
+	void ModuleCoroutineScheduler::Refresh()
+	{
+		PendingRefreshTasks = PendingCondition->Refresh();
+
+		// Evaluate the condition as soon as all refresh tasks have completed.
+		auto NumPendingTasks = std::make_shared<std::atomic<size_t>>(PendingRefreshTasks.size());
+		auto Token = MakeResumeToken();
+		for (const auto& Future : PendingRefreshTasks)
+		{
+			if (!Future.IsValid())
+			{
+				if (--*NumPendingTasks == 0)
+					NotifyResume(Token);
+
+				continue;
+			}
+
+			Future.Then([Token, NumPendingTasks]() {
+				if (--*NumPendingTasks == 0)
+					ModuleCoroutineScheduler::NotifyResume(Token);
+			});
+		}
+	}
+
+	void ModuleCoroutineScheduler::Resume()
+	{
+		InvalidateResumeToken();
+		PendingCondition.reset();
+		PendingRefreshTasks.clear();
+
+		// Runs the coroutine until it awaits something again or until it finishes.
+		Coroutine.Handle.resume();
+
+		if (Coroutine.Handle.done())
+		{
+			Exception = Coroutine.Handle.promise().Exception;
+			Coroutine.Destroy();
+		}
+	}
+}
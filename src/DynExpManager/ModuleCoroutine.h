@@ -0,0 +1,248 @@
+// This file is part of DynExp.
+
+/**
+ * @file ModuleCoroutine.h
+ * @brief Provides C++20 coroutines for %DynExp modules to implement measurement sequences which
+ * wait for instruments' tasks or other conditions without splitting the sequence into many states
+ * of a Util::StateMachine.
+*/
+
+#pragma once
+
+#include "stdafx.h"
+#include "Module.h"
+#include "Instrument.h"
+
+namespace DynExp
+{
+	class ModuleCoroutinePromise;
+	class ModuleCoroutineScheduler;
+
+	/**
+	 * @brief Condition a @p ModuleCoroutine can wait for by <tt>co_await WaitUntil(Condition, Refresh)</tt>.
+	 * #Condition is evaluated by the module thread each time ModuleCoroutineScheduler::Poll() is called
+	 * (usually once per module main loop iteration). If #Refresh is set, it is called to enqueue tasks
+	 * (e.g. reading data from an instrument) which are required to update what #Condition checks. When
+	 * all of these tasks have completed, #Condition is evaluated directly (without waiting for the next
+	 * module main loop iteration). #Refresh is called again by the next call to ModuleCoroutineScheduler::Poll()
+	 * after the previously enqueued tasks have completed if #Condition still evaluates to false.
+	*/
+	class WaitUntil
+	{
+	public:
+		using ConditionType = std::function<bool()>;					//!< Type of #Condition
+		using RefreshType = std::function<std::vector<TaskFuture>()>;	//!< Type of #Refresh
+
+		/**
+		 * @brief Constructs a @p WaitUntil instance.
+		 * @param Condition @copybrief #Condition
+		 * @param Refresh @copybrief #Refresh
+		*/
+		WaitUntil(ConditionType Condition, RefreshType Refresh = nullptr)
+			: Condition(std::move(Condition)), Refresh(std::move(Refresh)) {}
+
+		ConditionType Condition;	//!< Returns true if the coroutine should be resumed. Called by the module thread.
+		RefreshType Refresh;		//!< Enqueues tasks updating what #Condition checks and returns their futures. Might be @p nullptr.
+	};
+
+	/**
+	 * @brief Awaiter to make a @p ModuleCoroutine wait for an instrument's task to complete.
+	 * The coroutine is resumed by an event which the thread completing the task (usually the
+	 * instrument thread) inserts into the module's event queue. @p co_await returns the exception
+	 * possibly thrown by the task.
+	*/
+	class TaskFutureAwaiter
+	{
+	public:
+		/**
+		 * @brief Constructs a @p TaskFutureAwaiter instance.
+		 * @param Future @copybrief #Future
+		*/
+		TaskFutureAwaiter(TaskFuture Future) noexcept : Future(std::move(Future)) {}
+
+		bool await_ready() const { return !Future.IsValid() || Future.IsReady(); }
+		void await_suspend(std::coroutine_handle<ModuleCoroutinePromise> Handle) const;
+		ExceptionContainer await_resume() const { return Future.IsValid() ? Future.Get() : ExceptionContainer(); }
+
+	private:
+		const TaskFuture Future;	//!< Future of the task to wait for
+	};
+
+	/**
+	 * @brief Awaiter to make a @p ModuleCoroutine wait until a @p WaitUntil condition is fulfilled.
+	*/
+	class WaitUntilAwaiter
+	{
+	public:
+		/**
+		 * @brief Constructs a @p WaitUntilAwaiter instance.
+		 * @param Condition @copybrief #Condition
+		*/
+		WaitUntilAwaiter(WaitUntil&& Condition) noexcept : Condition(std::move(Condition)) {}
+
+		bool await_ready() const { return Condition.Condition(); }
+		void await_suspend(std::coroutine_handle<ModuleCoroutinePromise> Handle);
+		void await_resume() const noexcept {}
+
+	private:
+		WaitUntil Condition;		//!< Condition to wait for
+	};
+
+	/**
+	 * @brief Coroutine type for measurement sequences of modules. A coroutine returning @p ModuleCoroutine
+	 * is started by ModuleCoroutineScheduler::Start() and always runs in the module thread. It can wait for
+	 * instruments' tasks by <tt>co_await</tt>ing a @p TaskFuture (refer to InstrumentBase::AsAsyncTask()) and
+	 * for arbitrary conditions by <tt>co_await</tt>ing a @p WaitUntil instance. Other awaitables are not
+	 * allowed since they could resume the coroutine in a thread different from the module thread.
+	*/
+	class ModuleCoroutine
+	{
+	public:
+		using promise_type = ModuleCoroutinePromise;					//!< Promise type required by the C++ coroutine machinery
+		using HandleType = std::coroutine_handle<ModuleCoroutinePromise>;	//!< Handle to the coroutine's frame
+
+		ModuleCoroutine() = default;
+		ModuleCoroutine(const ModuleCoroutine&) = delete;
+		ModuleCoroutine(ModuleCoroutine&& Other) noexcept : Handle(std::exchange(Other.Handle, nullptr)) {}
+		~ModuleCoroutine() { Destroy(); }
+
+		ModuleCoroutine& operator=(const ModuleCoroutine&) = delete;
+		ModuleCoroutine& operator=(ModuleCoroutine&& Other) noexcept;
+
+		/**
+		 * @brief Determines whether this instance owns a coroutine.
+		 * @return Returns true if #Handle is not @p nullptr, false otherwise.
+		*/
+		explicit operator bool() const noexcept { return static_cast<bool>(Handle); }
+
+	private:
+		friend class ModuleCoroutinePromise;
+		friend class ModuleCoroutineScheduler;
+
+		/**
+		 * @brief Constructs a @p ModuleCoroutine instance taking ownership of the coroutine @p Handle refers to.
+		 * @param Handle @copybrief #Handle
+		*/
+		explicit ModuleCoroutine(HandleType Handle) noexcept : Handle(Handle) {}
+
+		void Destroy() noexcept;		//!< Destroys the coroutine's frame (if any) calling destructors of its local variables.
+
+		HandleType Handle;				//!< Handle to the owned coroutine's frame
+	};
+
+	/**
+	 * @brief Promise type of @p ModuleCoroutine. Coroutines are started suspended and remain suspended
+	 * after they have finished such that ModuleCoroutineScheduler can destroy them and retrieve exceptions.
+	*/
+	class ModuleCoroutinePromise
+	{
+	public:
+		ModuleCoroutine get_return_object() noexcept { return ModuleCoroutine(ModuleCoroutine::HandleType::from_promise(*this)); }
+		std::suspend_always initial_suspend() const noexcept { return {}; }
+		std::suspend_always final_suspend() const noexcept { return {}; }
+		void return_void() const noexcept {}
+		void unhandled_exception() noexcept { Exception = std::current_exception(); }
+
+		TaskFutureAwaiter await_transform(TaskFuture Future) const noexcept { return { std::move(Future) }; }
+		WaitUntilAwaiter await_transform(WaitUntil Condition) const noexcept { return { std::move(Condition) }; }
+
+		ModuleCoroutineScheduler* Scheduler = nullptr;	//!< Scheduler running the coroutine. Set by ModuleCoroutineScheduler::Start().
+		std::exception_ptr Exception;					//!< Exception which has left the coroutine's body
+	};
+
+	/**
+	 * @brief Runs a @p ModuleCoroutine in the module thread. Each module owns one instance per coroutine
+	 * which is supposed to run at the same time. All functions must be called from the module thread only.
+	 * Completed tasks awaited by the coroutine wake up the module thread via the module's event queue. So,
+	 * the coroutine is resumed right after the task has completed and not only in the next module main loop
+	 * iteration as it would be the case for states of a Util::StateMachine polling the task's state.
+	*/
+	class ModuleCoroutineScheduler : public Util::INonCopyable
+	{
+	public:
+		/**
+		 * @brief Constructs a @p ModuleCoroutineScheduler instance.
+		 * @param Owner @copybrief #Owner
+		*/
+		ModuleCoroutineScheduler(const ModuleBase& Owner) noexcept : Owner(Owner) {}
+
+		~ModuleCoroutineScheduler() { Cancel(); }
+
+		/**
+		 * @brief Cancels the coroutine currently running (if any) and starts @p Coroutine. @p Coroutine
+		 * runs until it awaits something for the first time or until it finishes.
+		 * @param Coroutine Coroutine to start
+		 * @throws Util::InvalidArgException is thrown if @p Coroutine is empty.
+		 * @throws Any exception leaving @p Coroutine's body before it awaits something for the first time
+		 * is rethrown.
+		*/
+		void Start(ModuleCoroutine&& Coroutine);
+
+		/**
+		 * @brief Destroys the coroutine currently running (if any). Events possibly pending to resume it
+		 * are ignored. Tasks it has enqueued are not aborted.
+		*/
+		void Cancel() noexcept;
+
+		/**
+		 * @brief Determines whether a coroutine is running (i.e. has been started, but has not finished yet).
+		 * @return Returns true if a coroutine is running, false otherwise.
+		*/
+		bool IsRunning() const noexcept { return static_cast<bool>(Coroutine); }
+
+		/**
+		 * @brief Evaluates the @p WaitUntil condition the coroutine is waiting for (if any) and resumes it
+		 * if the condition is fulfilled. Otherwise, refreshes the condition if required. Call once per module
+		 * main loop iteration while the coroutine is running.
+		 * @return Returns true if the coroutine is still running, false if it has finished or has not been started.
+		 * @throws Any exception having left the coroutine's body since the last call is rethrown.
+		*/
+		bool Poll();
+
+	private:
+		friend class TaskFutureAwaiter;
+		friend class WaitUntilAwaiter;
+
+		/**
+		 * @brief Identifies a single suspension of the coroutine. Resuming the coroutine invalidates
+		 * the token by setting #Scheduler to @p nullptr. So, outdated events are ignored.
+		*/
+		struct ResumeTokenType
+		{
+			ResumeTokenType(ModuleCoroutineScheduler* Scheduler) noexcept : Scheduler(Scheduler) {}
+
+			std::mutex Mutex;						//!< Guards #Scheduler since tokens are accessed by other threads, too.
+			ModuleCoroutineScheduler* Scheduler;	//!< Scheduler the token belongs to or @p nullptr if invalidated
+		};
+
+		class ResumeEvent;
+
+		std::shared_ptr<ResumeTokenType> MakeResumeToken();		//!< Invalidates #ResumeToken and replaces it by a new one.
+		void InvalidateResumeToken() noexcept;					//!< Invalidates #ResumeToken and sets it to @p nullptr.
+
+		/**
+		 * @brief Inserts a @p ResumeEvent into #Owner's event queue if @p Token is still valid.
+		 * Thread-safe. Called by threads completing tasks the coroutine awaits.
+		 * @param Token Token identifying the coroutine's suspension
+		*/
+		static void NotifyResume(const std::shared_ptr<ResumeTokenType>& Token);
+
+		/**
+		 * @brief Handles a @p ResumeEvent. Resumes the coroutine if it is waiting for a task or evaluates
+		 * the @p WaitUntil condition the coroutine is waiting for.
+		 * @param Token Token the event has been created with
+		*/
+		void OnResumeEvent(const std::shared_ptr<ResumeTokenType>& Token);
+
+		void WaitFor(WaitUntil&& Condition);			//!< Makes the coroutine wait until @p Condition is fulfilled.
+		void Refresh();									//!< Calls WaitUntil::Refresh of #PendingCondition.
+		void Resume();									//!< Resumes the coroutine and destroys it if it has finished.
+
+		const ModuleBase& Owner;						//!< Module owning this scheduler. Resume events are inserted into its event queue.
+		ModuleCoroutine Coroutine;						//!< Coroutine currently running
+		std::shared_ptr<ResumeTokenType> ResumeToken;	//!< Token identifying the coroutine's current suspension
+		std::optional<WaitUntil> PendingCondition;		//!< Condition the coroutine is currently waiting for (if any)
+		std::vector<TaskFuture> PendingRefreshTasks;	//!< Futures of the tasks enqueued by the last call to WaitUntil::Refresh
+		std::exception_ptr Exception;					//!< Exception which has left the coroutine's body to be rethrown by Poll()
+	};
+}
@@ -5,32 +5,32 @@
 
 namespace DynExpModule::ImageViewer
 {
-	void PauseImageCapturingEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const
+	void PauseImageCapturingEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const
 	{
 		EventFunc(&Instance, ResetImageTransformation);
 	}
 
-	void ImageCapturingPausedEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const
+	void ImageCapturingPausedEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const
 	{
 		EventFunc(&Instance);
 	}
 
-	void ResumeImageCapturingEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const
+	void ResumeImageCapturingEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const
 	{
 		EventFunc(&Instance);
 	}
 
-	void ImageCapturingResumedEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const
+	void ImageCapturingResumedEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const
 	{
 		EventFunc(&Instance);
 	}
 
-	void AutofocusEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const
+	void AutofocusEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const
 	{
 		EventFunc(&Instance, ResetImageTransformation);
 	}
 
-	void FinishedAutofocusEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const
+	void FinishedAutofocusEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const
 	{
 		EventFunc(&Instance, Success, Voltage);
 	}
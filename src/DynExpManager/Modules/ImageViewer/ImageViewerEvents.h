@@ -20,7 +20,7 @@ namespace DynExpModule::ImageViewer
 		virtual ~PauseImageCapturingEvent() {}
 
 	private:
-		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const override;
+		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const override;
 		
 		const bool ResetImageTransformation;
 	};
@@ -32,7 +32,7 @@ namespace DynExpModule::ImageViewer
 		virtual ~ImageCapturingPausedEvent() {}
 
 	private:
-		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const override;
+		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const override;
 	};
 
 	class ResumeImageCapturingEvent : public DynExp::InterModuleEvent<ResumeImageCapturingEvent>
@@ -42,7 +42,7 @@ namespace DynExpModule::ImageViewer
 		virtual ~ResumeImageCapturingEvent() {}
 
 	private:
-		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const override;
+		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const override;
 	};
 
 	class ImageCapturingResumedEvent : public DynExp::InterModuleEvent<ImageCapturingResumedEvent>
@@ -52,7 +52,7 @@ namespace DynExpModule::ImageViewer
 		virtual ~ImageCapturingResumedEvent() {}
 
 	private:
-		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const override;
+		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const override;
 	};
 
 	class AutofocusEvent : public DynExp::InterModuleEvent<AutofocusEvent, bool>
@@ -62,7 +62,7 @@ namespace DynExpModule::ImageViewer
 		virtual ~AutofocusEvent() {}
 
 	private:
-		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const override;
+		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const override;
 
 		const bool ResetImageTransformation;
 	};
@@ -74,7 +74,7 @@ namespace DynExpModule::ImageViewer
 		virtual ~FinishedAutofocusEvent() {}
 
 	private:
-		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const override;
+		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const override;
 
 		const bool Success;
 		const double Voltage;
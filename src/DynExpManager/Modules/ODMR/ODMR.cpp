@@ -149,6 +149,16 @@ namespace DynExpModule::ODMR
 		Features = {};
 	}
 
+	Util::TextValueListType<ODMRParams::SweepProcessingType> ODMRParams::SweepProcessingTypeStrList()
+	{
+		Util::TextValueListType<SweepProcessingType> List = {
+			{ "Sequential (analyze and save before next sweep)", SweepProcessingType::Sequential },
+			{ "Pipelined (analyze and save during next sweep)", SweepProcessingType::Pipelined }
+		};
+
+		return List;
+	}
+
 	ODMR::ODMR::ODMR(const std::thread::id OwnerThreadID, DynExp::ParamsBasePtrType&& Params)
 		: QModuleBase(OwnerThreadID, std::move(Params)),
 		StateMachine(InitializingState, ReadyState,
@@ -203,6 +213,7 @@ namespace DynExpModule::ODMR
 		NextRFModulationDepth = 0;
 		NextAuxAnalogOutValue = 0;
 
+		AnalysisPipeline.Clear();
 		NumFailedUpdateAttempts = 0;
 	}
 
@@ -689,11 +700,22 @@ namespace DynExpModule::ODMR
 
 	StateType ODMR::ODMR::ReadyStateFunc(DynExp::ModuleInstance& Instance)
 	{
+		// Results of analyses still running when the measurement has been stopped arrive here.
+		auto ModuleData = DynExp::dynamic_ModuleData_cast<ODMR>(Instance.ModuleDataGetter());
+		AnalysisPipeline.ApplyFinished(*ModuleData);
+
 		return StateType::Ready;
 	}
 
 	StateType ODMR::MeasurementSeriesInitFunc(DynExp::ModuleInstance& Instance)
 	{
+		{
+			auto ModuleParams = DynExp::dynamic_Params_cast<ODMR>(Instance.ParamsGetter());
+
+			AnalysisPipeline.BeginSeries(ModuleParams->SweepProcessing == ODMRParams::SweepProcessingType::Pipelined,
+				Util::NumToT<size_t>(ModuleParams->MaxNumPendingSweeps.Get()));
+		} // ModuleParams unlocked here.
+
 		auto ModuleData = DynExp::dynamic_ModuleData_cast<ODMR>(Instance.ModuleDataGetter());
 
 		ModuleData->CurrentSweepIndex = 0;
@@ -712,29 +734,37 @@ namespace DynExpModule::ODMR
 
 	StateType ODMR::MeasurementSeriesStepFunc(DynExp::ModuleInstance& Instance)
 	{
-		auto ModuleData = DynExp::dynamic_ModuleData_cast<ODMR>(Instance.ModuleDataGetter());
-
-		if (!ModuleData->SweepSeriesEnabled || ++ModuleData->CurrentSweepIndex >= ModuleData->GetSweepNumberSteps())
 		{
-			++ModuleData->CurrentSaveIndex;
+			auto ModuleData = DynExp::dynamic_ModuleData_cast<ODMR>(Instance.ModuleDataGetter());
 
-			if (ModuleData->SweepSeriesEnabled && ModuleData->SweepSeriesRetrace)
+			if (ModuleData->SweepSeriesEnabled && ++ModuleData->CurrentSweepIndex < ModuleData->GetSweepNumberSteps())
 			{
-				ModuleData->CurrentSweepIndex = 0;
 				InitSweepValues(ModuleData);
 
-				SetAuxAnalogOutValue(ModuleData);
-				InitRFGenerator(ModuleData->GetRFStartFreq(), false, ModuleData);
+				return ModuleData->MeasurementMode == ODMRData::MeasurementModeType::All ? StateType::ODMRTraceInit : StateType::SensitivityInit;
 			}
-			if (ModuleData->RFAutoEnabled)
-				ModuleData->GetRFGenerator()->Stop();
+		} // ModuleData unlocked here (waiting for the analysis of the last sweeps follows).
 
-			return StateType::Ready;
-		}
+		AnalysisPipeline.WaitUntilFinished();
+		Util::EventLog().Log(AnalysisPipeline.GetTimingStr());
 
-		InitSweepValues(ModuleData);
+		auto ModuleData = DynExp::dynamic_ModuleData_cast<ODMR>(Instance.ModuleDataGetter());
+		AnalysisPipeline.ApplyFinished(*ModuleData);
 
-		return ModuleData->MeasurementMode == ODMRData::MeasurementModeType::All ? StateType::ODMRTraceInit : StateType::SensitivityInit;
+		++ModuleData->CurrentSaveIndex;
+
+		if (ModuleData->SweepSeriesEnabled && ModuleData->SweepSeriesRetrace)
+		{
+			ModuleData->CurrentSweepIndex = 0;
+			InitSweepValues(ModuleData);
+
+			SetAuxAnalogOutValue(ModuleData);
+			InitRFGenerator(ModuleData->GetRFStartFreq(), false, ModuleData);
+		}
+		if (ModuleData->RFAutoEnabled)
+			ModuleData->GetRFGenerator()->Stop();
+
+		return StateType::Ready;
 	}
 
 	StateType ODMR::ODMRTraceInitFunc(DynExp::ModuleInstance& Instance)
@@ -764,6 +794,7 @@ namespace DynExpModule::ODMR
 		}
 
 		WaitUntilReadyAndTrigger(ModuleData);
+		AnalysisPipeline.BeginAcquisition();
 
 		return StateType::ODMRTraceWait;
 	}
@@ -772,12 +803,19 @@ namespace DynExpModule::ODMR
 	{
 		auto ModuleData = DynExp::dynamic_ModuleData_cast<ODMR>(Instance.ModuleDataGetter());
 
-		return ModuleData->GetSignalDetector()->HasFinished() ? StateType::ODMRTraceFinish : StateType::ODMRTraceWait;
+		// Display results of the previous sweeps as soon as they are available.
+		AnalysisPipeline.ApplyFinished(*ModuleData);
+
+		if (!ModuleData->GetSignalDetector()->HasFinished())
+			return StateType::ODMRTraceWait;
+
+		AnalysisPipeline.EndAcquisition();
+
+		return StateType::ODMRTraceFinish;
 	}
 
 	StateType ODMR::ODMRTraceFinishFunc(DynExp::ModuleInstance& Instance)
 	{
-		std::vector<std::tuple<double, double, double>> SaveSamples;
 		bool Save = false;
 		bool PerformSensitivityMeasurement = false;
 		double RFStartFreq{};
@@ -786,18 +824,12 @@ namespace DynExpModule::ODMR
 		bool IsBasicSampleTimeUsed{};
 		double SamplingRate{ .0 };
 		DynExpInstr::DataStreamBase::BasicSampleListType ODMRSamples;
-		decltype(ODMRPlotType::DataPoints) ODMRDataPoints;
-		decltype(ODMRPlotType::DataPointsMinValues) ODMRDataPointsMinValues = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
-		decltype(ODMRPlotType::DataPointsMaxValues) ODMRDataPointsMaxValues = { std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest() };
 		decltype(ODMRData::SensitivityResonanceFreq) SensitivityResonanceFreq{};
 		decltype(ODMRData::SensitivityResonanceSpan) SensitivityResonanceSpan{};
-		decltype(ODMRPlotType::FitParams) ODMRFitParams{};
-		decltype(ODMRPlotType::FitPoints) ODMRFitPoints{};
-		std::vector<double> FitXData;
-		std::vector<double> FitYData;
 		std::string Filename;
 		std::string ValueUnitStr;
-		std::stringstream CSVData;
+		std::string CSVHeader;
+		Util::DataFileWriter::FormatType SaveDataFormat = Util::DataFileWriter::FormatType::CSV;
 
 		{
 			auto ModuleData = DynExp::dynamic_ModuleData_cast<ODMR>(Instance.ModuleDataGetter());
@@ -826,63 +858,80 @@ namespace DynExpModule::ODMR
 					throw Util::InvalidDataException("The analog input channel's sampling rate must not be 0.");
 			}
 
-		} // ModuleData unlocked here (heavy calculation follows).
-
-		for (size_t i = 0; i < ODMRSamples.size(); ++i)
-		{
-			const auto& Sample = ODMRSamples[i];
+			// Gather everything to save now since the next sweep might change the module data while the analysis is running.
+			SaveDataFormat = DynExp::dynamic_Params_cast<ODMR>(Instance.ParamsGetter())->SaveDataFormat;
+			Filename = Util::RemoveExtFromPath(ModuleData->SaveDataPath) + "_ODMR" + Util::ToStr(ModuleData->CurrentSaveIndex) + "_Sweep" + Util::ToStr(ModuleData->CurrentSweepIndex)
+				+ Util::DataFileWriter::GetFileExtension(SaveDataFormat).toStdString();
+			ValueUnitStr = ModuleData->GetSignalDetector()->GetValueUnitStr();
 
-			auto Frequency = RFStartFreq + (IsBasicSampleTimeUsed ? Sample.Time : (static_cast<double>(i) / SamplingRate)) / RFDwellTime * RFFreqSpacing;
-			ODMRDataPoints.push_back({ Frequency / 1e9, Sample.Value });
-			ODMRDataPointsMinValues = { std::min(ODMRDataPointsMinValues.x(), Frequency / 1e9), std::min(ODMRDataPointsMinValues.y(), Sample.Value) };
-			ODMRDataPointsMaxValues = { std::max(ODMRDataPointsMaxValues.x(), Frequency / 1e9), std::max(ODMRDataPointsMaxValues.y(), Sample.Value) };
 			if (Save)
-				SaveSamples.emplace_back(std::make_tuple(Frequency, Sample.Time, Sample.Value));
+				CSVHeader = ModuleData->AssembleCSVHeader(NextRFPower, NextRFModulationDepth, NextAuxAnalogOutValue, false).str();
+		} // ModuleData unlocked here (heavy calculation follows).
 
-			if (PerformSensitivityMeasurement &&
-				Frequency >= SensitivityResonanceFreq - SensitivityResonanceSpan / 2 &&
-				Frequency <= SensitivityResonanceFreq + SensitivityResonanceSpan / 2)
+		// Runs on the analysis pipeline's worker thread possibly while the next sweep is acquired.
+		AnalysisPipeline.Enqueue([=, ODMRSamples = std::move(ODMRSamples), CSVHeader = std::move(CSVHeader)]() mutable -> ODMRAnalysisPipeline::ApplyFuncType {
+			std::vector<std::array<double, 3>> SaveSamples;
+			decltype(ODMRPlotType::DataPoints) ODMRDataPoints;
+			decltype(ODMRPlotType::DataPointsMinValues) ODMRDataPointsMinValues = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+			decltype(ODMRPlotType::DataPointsMaxValues) ODMRDataPointsMaxValues = { std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest() };
+			decltype(ODMRPlotType::FitParams) ODMRFitParams{};
+			decltype(ODMRPlotType::FitPoints) ODMRFitPoints{};
+			std::vector<double> FitXData;
+			std::vector<double> FitYData;
+
+			for (size_t i = 0; i < ODMRSamples.size(); ++i)
 			{
-				FitXData.push_back(Frequency - SensitivityResonanceFreq);
-				FitYData.push_back(Sample.Value);
+				const auto& Sample = ODMRSamples[i];
+
+				auto Frequency = RFStartFreq + (IsBasicSampleTimeUsed ? Sample.Time : (static_cast<double>(i) / SamplingRate)) / RFDwellTime * RFFreqSpacing;
+				ODMRDataPoints.push_back({ Frequency / 1e9, Sample.Value });
+				ODMRDataPointsMinValues = { std::min(ODMRDataPointsMinValues.x(), Frequency / 1e9), std::min(ODMRDataPointsMinValues.y(), Sample.Value) };
+				ODMRDataPointsMaxValues = { std::max(ODMRDataPointsMaxValues.x(), Frequency / 1e9), std::max(ODMRDataPointsMaxValues.y(), Sample.Value) };
+				if (Save)
+					SaveSamples.push_back({ Frequency, Sample.Time, Sample.Value });
+
+				if (PerformSensitivityMeasurement &&
+					Frequency >= SensitivityResonanceFreq - SensitivityResonanceSpan / 2 &&
+					Frequency <= SensitivityResonanceFreq + SensitivityResonanceSpan / 2)
+				{
+					FitXData.push_back(Frequency - SensitivityResonanceFreq);
+					FitYData.push_back(Sample.Value);
+				}
 			}
-		}
-
-		if (PerformSensitivityMeasurement)
-		{
-			double c0{0}, c1{0}, cov00{0}, cov01{0}, cov11{0}, chisq{0};
-			gsl_fit_linear(FitXData.data(), 1, FitYData.data(), 1, FitXData.size(), &c0, &c1, &cov00, &cov01, &cov11, &chisq);
-			ODMRFitParams = { c0, c1 };
-
-			for (const auto& f : FitXData)
-				ODMRFitPoints.push_back({ (f + SensitivityResonanceFreq) / 1e9, c0 + c1 * f });
-		}
 
-		{
-			auto ModuleData = DynExp::dynamic_ModuleData_cast<ODMR>(Instance.ModuleDataGetter());
-
-			ModuleData->ODMRPlot.DataPoints = std::move(ODMRDataPoints);
-			ModuleData->ODMRPlot.DataPointsMinValues = ODMRDataPointsMinValues;
-			ModuleData->ODMRPlot.DataPointsMaxValues = ODMRDataPointsMaxValues;
-			ModuleData->ODMRPlot.FitParams = ODMRFitParams;
-			ModuleData->ODMRPlot.FitPoints = ODMRFitPoints;
-			ModuleData->ODMRPlot.HasChanged = true;
+			if (PerformSensitivityMeasurement)
+			{
+				double c0{0}, c1{0}, cov00{0}, cov01{0}, cov11{0}, chisq{0};
+				gsl_fit_linear(FitXData.data(), 1, FitYData.data(), 1, FitXData.size(), &c0, &c1, &cov00, &cov01, &cov11, &chisq);
+				ODMRFitParams = { c0, c1 };
 
-			Filename = Util::RemoveExtFromPath(ModuleData->SaveDataPath) + "_ODMR" + Util::ToStr(ModuleData->CurrentSaveIndex) + "_Sweep" + Util::ToStr(ModuleData->CurrentSweepIndex) + ".csv";
-			ValueUnitStr = ModuleData->GetSignalDetector()->GetValueUnitStr();
+				for (const auto& f : FitXData)
+					ODMRFitPoints.push_back({ (f + SensitivityResonanceFreq) / 1e9, c0 + c1 * f });
+			}
 
+			// Writing the file to disk is left to the writer thread.
 			if (Save)
-				CSVData = ModuleData->AssembleCSVHeader(NextRFPower, NextRFModulationDepth, NextAuxAnalogOutValue, false);
-		} // ModuleData unlocked here.
+				Util::FileWriter().EnqueueData(QString::fromStdString(Filename), SaveDataFormat, std::move(CSVHeader),
+					{ "f(Hz)", "t(s)", "Value(" + ValueUnitStr + ")" }, [SaveSamples = std::move(SaveSamples)](Util::DataFileWriter& Writer) {
+						for (const auto& Sample : SaveSamples)
+							Writer.WriteRow(Sample);
+					});
+
+			return [ODMRDataPoints = std::move(ODMRDataPoints), ODMRDataPointsMinValues, ODMRDataPointsMaxValues, ODMRFitParams,
+				ODMRFitPoints = std::move(ODMRFitPoints)](ODMRData& ModuleData) mutable {
+				ModuleData.ODMRPlot.DataPoints = std::move(ODMRDataPoints);
+				ModuleData.ODMRPlot.DataPointsMinValues = ODMRDataPointsMinValues;
+				ModuleData.ODMRPlot.DataPointsMaxValues = ODMRDataPointsMaxValues;
+				ModuleData.ODMRPlot.FitParams = ODMRFitParams;
+				ModuleData.ODMRPlot.FitPoints = std::move(ODMRFitPoints);
+				ModuleData.ODMRPlot.HasChanged = true;
+			};
+		});
 
-		if (Save)
 		{
-			CSVData << "f(Hz);t(s);Value(" << ValueUnitStr << ")\n";
-			for (const auto& Sample : SaveSamples)
-				CSVData << std::get<0>(Sample) << ";" << std::get<1>(Sample) << ";" << std::get<2>(Sample) << "\n";
-
-			Util::SaveToFile(QString::fromStdString(Filename), CSVData.str());
-		}
+			auto ModuleData = DynExp::dynamic_ModuleData_cast<ODMR>(Instance.ModuleDataGetter());
+			AnalysisPipeline.ApplyFinished(*ModuleData);
+		} // ModuleData unlocked here.
 
 		return PerformSensitivityMeasurement ? StateType::SensitivityInit : StateType::MeasurementSeriesStep;
 	}
@@ -910,6 +959,7 @@ namespace DynExpModule::ODMR
 		LockinAmplifier->SetSamplingRate(ModuleData->SensitivitySamplingRate);
 
 		WaitUntilReadyAndTrigger(ModuleData);
+		AnalysisPipeline.BeginAcquisition();
 
 		return StateType::SensitivityWait;
 	}
@@ -918,12 +968,20 @@ namespace DynExpModule::ODMR
 	{
 		auto ModuleData = DynExp::dynamic_ModuleData_cast<ODMR>(Instance.ModuleDataGetter());
 
-		return ModuleData->GetSignalDetector()->HasFinished() ? StateType::SensitivityFinish : StateType::SensitivityWait;
+		// Display results of the previous sweeps as soon as they are available.
+		AnalysisPipeline.ApplyFinished(*ModuleData);
+
+		if (!ModuleData->GetSignalDetector()->HasFinished())
+			return StateType::SensitivityWait;
+
+		AnalysisPipeline.EndAcquisition();
+
+		return StateType::SensitivityFinish;
 	}
 
 	StateType ODMR::SensitivityFinishFunc(DynExp::ModuleInstance& Instance)
 	{
-		std::vector<std::tuple<double, double>> SaveSamples;
+		const bool IsOffResonance = StateMachine.GetContext() == &SensitivityOffResonanceContext;
 		ODMRData::MeasurementModeType MeasurementMode = ODMRData::MeasurementModeType::All;
 		bool Save = false;
 		bool SensitivityOffResonanceEnabled = false;
@@ -931,14 +989,10 @@ namespace DynExpModule::ODMR
 		decltype(ODMRPlotType::FitParams) ODMRFitParams{};
 		decltype(ODMRData::GyromagneticRatio) GyromagneticRatio{};
 		DynExpInstr::DataStreamBase::BasicSampleListType SensitivitySamples;
-		std::vector<std::complex<double>> SensitivityASD;
-		decltype(SensitivityPlotType::DataPoints) SensitivityDataPoints;
-		decltype(SensitivityPlotType::DataPointsMinValues) SensitivityDataPointsMinValues = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
-		decltype(SensitivityPlotType::DataPointsMaxValues) SensitivityDataPointsMaxValues = { std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest() };
 		std::string Filename;
-		std::string FilenamePrefix;
 		std::string ValueUnitStr;
-		std::stringstream CSVData;
+		std::string CSVHeader;
+		Util::DataFileWriter::FormatType SaveDataFormat = Util::DataFileWriter::FormatType::CSV;
 
 		{
 			auto ModuleData = DynExp::dynamic_ModuleData_cast<ODMR>(Instance.ModuleDataGetter());
@@ -947,6 +1001,19 @@ namespace DynExpModule::ODMR
 				return StateType::SensitivityFinish;
 
 			MeasurementMode = ModuleData->MeasurementMode;
+		} // ModuleData unlocked here.
+
+		// The sensitivity is calculated from the slope fitted to the preceding ODMR trace. Its analysis might still be running.
+		const bool NeedsODMRFit = MeasurementMode == ODMRData::MeasurementModeType::All && !IsOffResonance;
+		if (NeedsODMRFit)
+			AnalysisPipeline.WaitUntilFinished();
+
+		{
+			auto ModuleData = DynExp::dynamic_ModuleData_cast<ODMR>(Instance.ModuleDataGetter());
+
+			if (NeedsODMRFit)
+				AnalysisPipeline.ApplyFinished(*ModuleData);
+
 			Save = ModuleData->AutosaveEnabled;
 			SensitivityOffResonanceEnabled = ModuleData->SensitivityOffResonanceEnabled;
 			SensitivityAnalysisEnabled = ModuleData->SensitivityAnalysisEnabled;
@@ -956,78 +1023,89 @@ namespace DynExpModule::ODMR
 			auto SignalDetectorData = DynExp::dynamic_InstrumentData_cast<DynExpInstr::DataStreamInstrument>(ModuleData->GetSignalDetector()->GetInstrumentData());
 			SignalDetectorData->GetSampleStream()->SeekBeg(std::ios_base::in);
 			SensitivitySamples = SignalDetectorData->GetSampleStream()->ReadBasicSamples(SignalDetectorData->GetSampleStream()->GetStreamSizeRead());
-		} // ModuleData unlocked here (heavy calculation follows).
-
-		for (const auto& Sample : SensitivitySamples)
-		{
-			SaveSamples.emplace_back(std::make_tuple(Sample.Time, Sample.Value));
-
-			if (MeasurementMode == ODMRData::MeasurementModeType::All && StateMachine.GetContext() != &SensitivityOffResonanceContext)
-				SensitivityASD.emplace_back(Sample.Value / std::get<1>(ODMRFitParams) / GyromagneticRatio, 0);
-		}
 
-		if (SensitivityASD.size() > 2 && SensitivityAnalysisEnabled && StateMachine.GetContext() != &SensitivityOffResonanceContext)
-		{
-			const auto Length = static_cast<double>(SensitivityASD.size());
-
-			SensitivityASD = Util::FFT(SensitivityASD);
-			std::transform(SensitivityASD.cbegin(), SensitivityASD.cend(), SensitivityASD.begin(), [Length](auto x) { return std::abs(x / Length); });
+			// Gather everything to save now since the next sweep might change the module data while the analysis is running.
+			const std::string FilenamePrefix = IsOffResonance ? "OffResSensitivity" : "Sensitivity";
+			SaveDataFormat = DynExp::dynamic_Params_cast<ODMR>(Instance.ParamsGetter())->SaveDataFormat;
+			Filename = Util::RemoveExtFromPath(ModuleData->SaveDataPath) + "_" + FilenamePrefix + Util::ToStr(ModuleData->CurrentSaveIndex) + "_Sweep" + Util::ToStr(ModuleData->CurrentSweepIndex)
+				+ Util::DataFileWriter::GetFileExtension(SaveDataFormat).toStdString();
+			ValueUnitStr = ModuleData->GetSignalDetector()->GetValueUnitStr();
 
-			// Make single-sided spectrum
-			SensitivityASD.erase(SensitivityASD.cbegin() + SensitivityASD.size() / 2 + 1, SensitivityASD.cend());
-			std::transform(SensitivityASD.cbegin() + 1, SensitivityASD.cend(), SensitivityASD.begin() + 1, [Length](auto x) { return 2.0 * x; });
-				
-			// Assume SensitivitySamples sorted by Time. Assume samples equally spaced in time.
-			double TimeSamplingRate = 1 / (std::abs(SensitivitySamples.back().Time - SensitivitySamples.front().Time) / (SensitivitySamples.size() - 1));
-			std::vector<double> Frequencies(Length / 2 + 1, 0);
-			std::iota(Frequencies.begin(), Frequencies.end(), 0);
-			std::transform(Frequencies.cbegin(), Frequencies.cend(), Frequencies.begin(), [TimeSamplingRate, Length](auto x) { return TimeSamplingRate * x / Length; });
+			if (Save)
+				CSVHeader = ModuleData->AssembleCSVHeader(NextRFPower, NextRFModulationDepth, NextAuxAnalogOutValue, IsOffResonance).str();
+		} // ModuleData unlocked here (heavy calculation follows).
 
-			double FrequencySamplingRate = std::abs(Frequencies.back() - Frequencies.front()) / (Frequencies.size() - 1);
-			std::transform(SensitivityASD.cbegin(), SensitivityASD.cend(), SensitivityASD.begin(), [FrequencySamplingRate](auto x) { return x / std::sqrt(FrequencySamplingRate); });
+		// Runs on the analysis pipeline's worker thread possibly while the next sweep is acquired.
+		AnalysisPipeline.Enqueue([=, SensitivitySamples = std::move(SensitivitySamples), CSVHeader = std::move(CSVHeader)]() mutable -> ODMRAnalysisPipeline::ApplyFuncType {
+			std::vector<std::array<double, 2>> SaveSamples;
+			std::vector<double> SensitivityValues;
+			std::vector<double> SensitivityASD;
+			decltype(SensitivityPlotType::DataPoints) SensitivityDataPoints;
+			decltype(SensitivityPlotType::DataPointsMinValues) SensitivityDataPointsMinValues = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+			decltype(SensitivityPlotType::DataPointsMaxValues) SensitivityDataPointsMaxValues = { std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest() };
 
-			if (SensitivityASD.size() == Frequencies.size())
-				for (size_t i = 1; i < SensitivityASD.size(); ++i)		// Ignore 0 Hz frequency component
-				{
-					SensitivityDataPoints.push_back({ Frequencies[i], SensitivityASD[i].real() });
-					SensitivityDataPointsMinValues = { std::min(SensitivityDataPointsMinValues.x(), SensitivityDataPoints.back().x()),
-						std::min(SensitivityDataPointsMinValues.y(), SensitivityDataPoints.back().y()) };
-					SensitivityDataPointsMaxValues = { std::max(SensitivityDataPointsMaxValues.x(), SensitivityDataPoints.back().x()),
-						std::max(SensitivityDataPointsMaxValues.y(), SensitivityDataPoints.back().y()) };
-				}
-		} 
+			for (const auto& Sample : SensitivitySamples)
+			{
+				SaveSamples.push_back({ Sample.Time, Sample.Value });
 
-		{
-			auto ModuleData = DynExp::dynamic_ModuleData_cast<ODMR>(Instance.ModuleDataGetter());
+				if (NeedsODMRFit)
+					SensitivityValues.push_back(Sample.Value / std::get<1>(ODMRFitParams) / GyromagneticRatio);
+			}
 
-			if (StateMachine.GetContext() != &SensitivityOffResonanceContext)
+			if (SensitivityValues.size() > 2 && SensitivityAnalysisEnabled && !IsOffResonance)
 			{
-				ModuleData->SensitivityPlot.DataPoints = std::move(SensitivityDataPoints);
-				ModuleData->SensitivityPlot.DataPointsMinValues = SensitivityDataPointsMinValues;
-				ModuleData->SensitivityPlot.DataPointsMaxValues = SensitivityDataPointsMaxValues;
-				ModuleData->SensitivityPlot.HasChanged = true;
+				const auto Length = static_cast<double>(SensitivityValues.size());
 
-				FilenamePrefix = "Sensitivity";
+				// The real-valued FFT (using a cached FFT plan) directly returns the single-sided spectrum.
+				const auto Spectrum = Util::RealFFT(std::move(SensitivityValues));
+				SensitivityASD.resize(Spectrum.size());
+				std::transform(Spectrum.cbegin(), Spectrum.cend(), SensitivityASD.begin(), [Length](auto x) { return std::abs(x / Length); });
+				std::transform(SensitivityASD.cbegin() + 1, SensitivityASD.cend(), SensitivityASD.begin() + 1, [](auto x) { return 2.0 * x; });
+				
+				// Assume SensitivitySamples sorted by Time. Assume samples equally spaced in time.
+				double TimeSamplingRate = 1 / (std::abs(SensitivitySamples.back().Time - SensitivitySamples.front().Time) / (SensitivitySamples.size() - 1));
+				std::vector<double> Frequencies(Length / 2 + 1, 0);
+				std::iota(Frequencies.begin(), Frequencies.end(), 0);
+				std::transform(Frequencies.cbegin(), Frequencies.cend(), Frequencies.begin(), [TimeSamplingRate, Length](auto x) { return TimeSamplingRate * x / Length; });
+
+				double FrequencySamplingRate = std::abs(Frequencies.back() - Frequencies.front()) / (Frequencies.size() - 1);
+				std::transform(SensitivityASD.cbegin(), SensitivityASD.cend(), SensitivityASD.begin(), [FrequencySamplingRate](auto x) { return x / std::sqrt(FrequencySamplingRate); });
+
+				if (SensitivityASD.size() == Frequencies.size())
+					for (size_t i = 1; i < SensitivityASD.size(); ++i)		// Ignore 0 Hz frequency component
+					{
+						SensitivityDataPoints.push_back({ Frequencies[i], SensitivityASD[i] });
+						SensitivityDataPointsMinValues = { std::min(SensitivityDataPointsMinValues.x(), SensitivityDataPoints.back().x()),
+							std::min(SensitivityDataPointsMinValues.y(), SensitivityDataPoints.back().y()) };
+						SensitivityDataPointsMaxValues = { std::max(SensitivityDataPointsMaxValues.x(), SensitivityDataPoints.back().x()),
+							std::max(SensitivityDataPointsMaxValues.y(), SensitivityDataPoints.back().y()) };
+					}
 			}
-			else
-				FilenamePrefix = "OffResSensitivity";
-
-			Filename = Util::RemoveExtFromPath(ModuleData->SaveDataPath) + "_" + FilenamePrefix + Util::ToStr(ModuleData->CurrentSaveIndex) + "_Sweep" + Util::ToStr(ModuleData->CurrentSweepIndex) + ".csv";
-			ValueUnitStr = ModuleData->GetSignalDetector()->GetValueUnitStr();
 
+			// Writing the file to disk is left to the writer thread.
 			if (Save)
-				CSVData = ModuleData->AssembleCSVHeader(NextRFPower, NextRFModulationDepth, NextAuxAnalogOutValue, StateMachine.GetContext() == &SensitivityOffResonanceContext);
-		} // ModuleData unlocked here.
+				Util::FileWriter().EnqueueData(QString::fromStdString(Filename), SaveDataFormat, std::move(CSVHeader),
+					{ "t(s)", "Value(" + ValueUnitStr + ")" }, [SaveSamples = std::move(SaveSamples)](Util::DataFileWriter& Writer) {
+						for (const auto& Sample : SaveSamples)
+							Writer.WriteRow(Sample);
+					});
+
+			if (IsOffResonance)
+				return {};
+
+			return [SensitivityDataPoints = std::move(SensitivityDataPoints), SensitivityDataPointsMinValues,
+				SensitivityDataPointsMaxValues](ODMRData& ModuleData) mutable {
+				ModuleData.SensitivityPlot.DataPoints = std::move(SensitivityDataPoints);
+				ModuleData.SensitivityPlot.DataPointsMinValues = SensitivityDataPointsMinValues;
+				ModuleData.SensitivityPlot.DataPointsMaxValues = SensitivityDataPointsMaxValues;
+				ModuleData.SensitivityPlot.HasChanged = true;
+			};
+		});
 
-		if (Save)
 		{
-			CSVData << "t(s);Value(" << ValueUnitStr << ")\n";
-			CSVData << std::setprecision(12);
-			for (const auto& Sample : SaveSamples)
-				CSVData << std::get<0>(Sample) << ";" << std::get<1>(Sample) << "\n";
-
-			Util::SaveToFile(QString::fromStdString(Filename), CSVData.str());
-		}
+			auto ModuleData = DynExp::dynamic_ModuleData_cast<ODMR>(Instance.ModuleDataGetter());
+			AnalysisPipeline.ApplyFinished(*ModuleData);
+		} // ModuleData unlocked here.
 
 		if (SensitivityOffResonanceEnabled)
 		{
@@ -17,6 +17,7 @@
 #include "../../MetaInstruments/DigitalOut.h"
 
 #include "ODMRWidget.h"
+#include "ODMRAnalysisPipeline.h"
 
 namespace DynExpModule::ODMR
 {
@@ -124,6 +125,16 @@ namespace DynExpModule::ODMR
 
 		virtual const char* GetParamClassTag() const noexcept override { return "ODMRParams"; }
 
+		/**
+		 * @brief Determines when recorded sweeps are analyzed and saved.
+		*/
+		enum SweepProcessingType {
+			Sequential,		//!< Before the next sweep is configured
+			Pipelined		//!< On a worker thread while the next sweep is configured and acquired
+		};
+
+		static Util::TextValueListType<SweepProcessingType> SweepProcessingTypeStrList();
+
 		Param<DynExp::ObjectLink<DynExpInstr::FunctionGenerator>> RFGenerator = { *this, GetCore().GetInstrumentManager(),
 			"RFGenerator", "RF generator", "RF generator to drive spin transitions", DynExpUI::Icons::Instrument };
 		Param<DynExp::ObjectLink<DynExpInstr::DataStreamInstrument>> SignalDetector = { *this, GetCore().GetInstrumentManager(),
@@ -132,6 +143,13 @@ namespace DynExpModule::ODMR
 			"TriggerOut", "Trigger output (DO)", "Trigger output to synchronize an RF frequency sweep and the data acquisition", DynExpUI::Icons::Instrument };
 		Param<DynExp::ObjectLink<DynExpInstr::AnalogOut>> AuxAnalogOut = { *this, GetCore().GetInstrumentManager(),
 			"AuxAnalogOut", "Auxiliary analog output (AO)", "Auxiliary output to perform ODMR parameter sweeps with", DynExpUI::Icons::Instrument, true };
+		Param<Util::DataFileWriter::FormatType> SaveDataFormat = { *this, Util::DataFileWriter::FormatTypeStrList(), "SaveDataFormat", "Save data format",
+			"Format of the files the recorded ODMR and sensitivity data is saved to", false, Util::DataFileWriter::FormatType::CSV };
+		Param<SweepProcessingType> SweepProcessing = { *this, SweepProcessingTypeStrList(), "SweepProcessing", "Sweep processing",
+			"Determines whether recorded sweeps are analyzed and saved before the next sweep is started or while the next sweep is acquired", false, SweepProcessingType::Sequential };
+		Param<ParamsConfigDialog::NumberType> MaxNumPendingSweeps = { *this, "MaxNumPendingSweeps", "Max. number of pending sweeps",
+			"Maximal number of recorded sweeps awaiting analysis in pipelined mode. Acquiring the next sweep is delayed if this number is reached.",
+			false, ODMRAnalysisPipeline::DefaultMaxNumPendingJobs, 1, 16, 1, 0 };
 
 	private:
 		void ConfigureParamsImpl(dispatch_tag<QModuleParamsBase>) override final {}
@@ -281,6 +299,8 @@ namespace DynExpModule::ODMR
 		double NextRFModulationDepth{};
 		double NextAuxAnalogOutValue{};
 
+		ODMRAnalysisPipeline AnalysisPipeline;		// Analyzes and saves recorded sweeps (possibly overlapping with the next sweep).
+
 		size_t NumFailedUpdateAttempts = 0;
 	};
 }
\ No newline at end of file
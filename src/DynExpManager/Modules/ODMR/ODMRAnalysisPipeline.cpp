@@ -0,0 +1,161 @@
+// This file is part of DynExp.
+
+#include "stdafx.h"
+#include "ODMRAnalysisPipeline.h"
+
+namespace DynExpModule::ODMR
+{
+	ODMRAnalysisPipeline::ODMRAnalysisPipeline()
+	{
+		Worker = std::thread(&ODMRAnalysisPipeline::WorkerThread, this);
+	}
+
+	ODMRAnalysisPipeline::~ODMRAnalysisPipeline()
+	{
+		{
+			std::lock_guard<decltype(WorkerMutex)> lock(WorkerMutex);
+			WorkerStopRequested = true;
+		}
+		WorkerCV.notify_one();
+
+		if (Worker.joinable())
+			Worker.join();
+	}
+
+	void ODMRAnalysisPipeline::BeginSeries(bool Pipelined, size_t MaxNumPendingJobs)
+	{
+		this->Pipelined = Pipelined;
+		this->MaxNumPendingJobs = std::max(size_t(1), MaxNumPendingJobs);
+
+		SeriesBeginTime = ClockType::now();
+		AcquisitionBeginTime.reset();
+		TotalAcquisitionTime = {};
+		NumAcquisitions = 0;
+		TotalAnalysisTime = 0;
+	}
+
+	void ODMRAnalysisPipeline::Enqueue(AnalysisFuncType AnalysisFunc)
+	{
+		{
+			std::unique_lock<decltype(WorkerMutex)> lock(WorkerMutex);
+
+			// Backpressure: do not let recorded samples pile up if analyzing takes longer than acquiring.
+			FinishedCV.wait(lock, [this]() { return NumUnfinishedJobs < MaxNumPendingJobs; });
+
+			PendingJobs.push_back(std::move(AnalysisFunc));
+			++NumUnfinishedJobs;
+		}
+		WorkerCV.notify_one();
+
+		if (!Pipelined)
+			WaitUntilFinished();
+	}
+
+	void ODMRAnalysisPipeline::ApplyFinished(ODMRData& ModuleData)
+	{
+		std::deque<ResultType> Results;
+		{
+			std::lock_guard<decltype(WorkerMutex)> lock(WorkerMutex);
+			Results.swap(FinishedResults);
+		}
+
+		for (auto& Result : Results)
+		{
+			if (Result.Exception)
+				std::rethrow_exception(Result.Exception);
+
+			if (Result.ApplyFunc)
+				Result.ApplyFunc(ModuleData);
+		}
+	}
+
+	void ODMRAnalysisPipeline::WaitUntilFinished()
+	{
+		std::unique_lock<decltype(WorkerMutex)> lock(WorkerMutex);
+		FinishedCV.wait(lock, [this]() { return NumUnfinishedJobs == 0; });
+	}
+
+	void ODMRAnalysisPipeline::Clear()
+	{
+		WaitUntilFinished();
+
+		std::lock_guard<decltype(WorkerMutex)> lock(WorkerMutex);
+		FinishedResults.clear();
+	}
+
+	void ODMRAnalysisPipeline::BeginAcquisition()
+	{
+		AcquisitionBeginTime = ClockType::now();
+	}
+
+	void ODMRAnalysisPipeline::EndAcquisition()
+	{
+		if (!AcquisitionBeginTime)
+			return;
+
+		TotalAcquisitionTime += ClockType::now() - *AcquisitionBeginTime;
+		++NumAcquisitions;
+		AcquisitionBeginTime.reset();
+	}
+
+	size_t ODMRAnalysisPipeline::GetNumPendingJobs() const
+	{
+		std::lock_guard<decltype(WorkerMutex)> lock(WorkerMutex);
+
+		return NumUnfinishedJobs;
+	}
+
+	std::string ODMRAnalysisPipeline::GetTimingStr() const
+	{
+		const auto SeriesTime = std::chrono::duration<double>(ClockType::now() - SeriesBeginTime).count();
+		const auto AcquisitionTime = std::chrono::duration<double>(TotalAcquisitionTime).count();
+		const auto AnalysisTime = std::chrono::duration<double>(ClockType::duration(TotalAnalysisTime.load())).count();
+
+		std::stringstream Stream;
+		Stream << std::setprecision(3) << "ODMR measurement series (" << (Pipelined ? "pipelined" : "sequential") << ") took "
+			<< SeriesTime << " s. Acquiring data (" << NumAcquisitions << " acquisitions) took " << AcquisitionTime
+			<< " s (duty cycle " << (SeriesTime > 0 ? 100 * AcquisitionTime / SeriesTime : 0) << " %). Analyzing and saving took "
+			<< AnalysisTime << " s.";
+
+		return Stream.str();
+	}
+
+	void ODMRAnalysisPipeline::WorkerThread() noexcept
+	{
+		while (true)
+		{
+			AnalysisFuncType Job;
+			{
+				std::unique_lock<decltype(WorkerMutex)> lock(WorkerMutex);
+				WorkerCV.wait(lock, [this]() { return !PendingJobs.empty() || WorkerStopRequested; });
+
+				// Finish all jobs enqueued so far even if stopping has been requested.
+				if (PendingJobs.empty())
+					break;
+
+				Job = std::move(PendingJobs.front());
+				PendingJobs.pop_front();
+			}
+
+			ResultType Result;
+			const auto BeginTime = ClockType::now();
+			try
+			{
+				Result.ApplyFunc = Job();
+			}
+			catch (...)
+			{
+				Result.Exception = std::current_exception();
+			}
+			TotalAnalysisTime += (ClockType::now() - BeginTime).count();
+
+			{
+				std::lock_guard<decltype(WorkerMutex)> lock(WorkerMutex);
+
+				FinishedResults.push_back(std::move(Result));
+				--NumUnfinishedJobs;
+			}
+			FinishedCV.notify_all();
+		}
+	}
+}
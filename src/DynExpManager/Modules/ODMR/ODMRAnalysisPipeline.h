@@ -0,0 +1,118 @@
+// This file is part of DynExp.
+
+/**
+ * @file ODMRAnalysisPipeline.h
+ * @brief Helper for the DynExpModule::ODMR::ODMR module to analyze and save recorded sweeps on
+ * a worker thread while the next sweep is configured and acquired.
+*/
+
+#pragma once
+
+#include "stdafx.h"
+
+namespace DynExpModule::ODMR
+{
+	class ODMRData;
+
+	/**
+	 * @brief Runs the analysis (fits, spectral densities) and the saving of recorded ODMR traces and
+	 * sensitivity series on a single worker thread. Analysis jobs return functions which apply the
+	 * results to the module data. These are called in the module thread by ApplyFinished() in the
+	 * order the jobs have been enqueued. At most #MaxNumPendingJobs jobs are pending at a time.
+	 * Enqueue() blocks until a job has finished if this limit has been reached. So, the memory
+	 * occupied by recorded samples awaiting analysis stays bounded. The worker thread is kept alive
+	 * for the lifetime of this object to make use of its cached FFT plans (refer to Util::RealFFT()).
+	 * Furthermore, this class measures how much of a measurement series' duration is spent acquiring
+	 * data (duty cycle).
+	*/
+	class ODMRAnalysisPipeline : public Util::INonCopyable
+	{
+	public:
+		using ClockType = std::chrono::steady_clock;
+
+		/**
+		 * @brief Function applying the result of an analysis job to the module data.
+		 * It is called in the module thread with the module data locked.
+		*/
+		using ApplyFuncType = std::function<void(ODMRData& ModuleData)>;
+
+		/**
+		 * @brief Analysis job running on the worker thread. It must not access the module or its data.
+		 * Instead, it has to capture (by moving) all the data it needs.
+		*/
+		using AnalysisFuncType = std::function<ApplyFuncType()>;
+
+		static constexpr size_t DefaultMaxNumPendingJobs = 2;	//!< Default value of #MaxNumPendingJobs
+
+		ODMRAnalysisPipeline();
+		~ODMRAnalysisPipeline();	//!< Finishes all pending jobs discarding their results and terminates the worker thread.
+
+		/**
+		 * @brief Resets the timing statistics at the beginning of a measurement series.
+		 * @param Pipelined If false, the module waits for each analysis job right after enqueuing it.
+		 * @param MaxNumPendingJobs @copybrief #MaxNumPendingJobs
+		*/
+		void BeginSeries(bool Pipelined, size_t MaxNumPendingJobs = DefaultMaxNumPendingJobs);
+
+		/**
+		 * @brief Enqueues an analysis job. Blocks until a previously enqueued job has finished if
+		 * #MaxNumPendingJobs jobs are pending. If the pipeline is not in pipelined mode, blocks until
+		 * @p AnalysisFunc has finished.
+		 * @param AnalysisFunc Analysis job to run on the worker thread
+		*/
+		void Enqueue(AnalysisFuncType AnalysisFunc);
+
+		/**
+		 * @brief Applies the results of all finished jobs to @p ModuleData in the order the jobs have been enqueued.
+		 * @param ModuleData Module data to apply the results to
+		 * @throws Rethrows exceptions thrown by analysis jobs.
+		*/
+		void ApplyFinished(ODMRData& ModuleData);
+
+		void WaitUntilFinished();	//!< Blocks until all jobs enqueued so far have finished. Call ApplyFinished() afterwards.
+		void Clear();				//!< Waits for pending jobs and discards all results.
+
+		void BeginAcquisition();	//!< Marks the beginning of a data acquisition (i.e. when a sweep has been triggered).
+		void EndAcquisition();		//!< Marks the end of a data acquisition (i.e. when the recorded samples are available).
+
+		bool IsPipelined() const noexcept { return Pipelined; }						//!< Getter for #Pipelined
+		size_t GetNumPendingJobs() const;												//!< Returns the number of jobs which have not finished yet.
+
+		/**
+		 * @brief Assembles a human-readable summary of the timing statistics of the current measurement series.
+		 * @return Summary containing the series' duration, the acquisition duty cycle and the analysis time
+		*/
+		std::string GetTimingStr() const;
+
+	private:
+		/**
+		 * @brief Result of an analysis job
+		*/
+		struct ResultType
+		{
+			ApplyFuncType ApplyFunc;				//!< Function to apply the result with. Empty if the job has failed.
+			std::exception_ptr Exception;			//!< Exception thrown by the job if it has failed.
+		};
+
+		void WorkerThread() noexcept;				//!< Worker thread's main function
+
+		bool Pipelined = false;						//!< Determines whether jobs overlap with the module's next sweep.
+		size_t MaxNumPendingJobs = DefaultMaxNumPendingJobs;	//!< Maximal number of jobs which have not finished yet
+
+		ClockType::time_point SeriesBeginTime;			//!< Time point the current measurement series has begun at
+		std::optional<ClockType::time_point> AcquisitionBeginTime;	//!< Time point the active acquisition has begun at
+		ClockType::duration TotalAcquisitionTime{};		//!< Time spent acquiring data during the current series
+		size_t NumAcquisitions = 0;						//!< Number of acquisitions during the current series
+		std::atomic<ClockType::duration::rep> TotalAnalysisTime = 0;	//!< Time (in ClockType ticks) the worker thread spent analyzing during the current series
+
+		std::deque<AnalysisFuncType> PendingJobs;		//!< Jobs not started yet. Synchronized by #WorkerMutex.
+		std::deque<ResultType> FinishedResults;			//!< Results not applied yet. Synchronized by #WorkerMutex.
+		size_t NumUnfinishedJobs = 0;					//!< Number of enqueued jobs which have not finished yet. Synchronized by #WorkerMutex.
+
+		bool WorkerStopRequested = false;				//!< Indicates that the worker should terminate. Synchronized by #WorkerMutex.
+		mutable std::mutex WorkerMutex;					//!< Mutex for the queues, #WorkerCV and #FinishedCV
+		std::condition_variable WorkerCV;				//!< Wakes up the worker thread.
+		std::condition_variable FinishedCV;				//!< Notifies threads waiting for jobs to finish.
+		std::thread Worker;								//!< Worker thread. Must be the last member to be initialized.
+	};
+}
@@ -121,17 +121,16 @@ namespace DynExpModule
 		FinishedSavingDataGuardType FinishedSavingDataGuard(*this, &SignalPlotterWidget::FinishedSavingData);
 		IsSavingData = true;
 
-		auto Filename = Util::PromptSaveFilePathModule(this, "Save data", ".csv", " Comma-separated values file (*.csv)");
+		auto Filename = Util::PromptSaveFilePathModule(this, "Save data", ".csv", Util::DataFileWriter::GetFileFilter());
 		if (Filename.isEmpty())
 			return;
 
-		std::stringstream CSVData;
-		CSVData << "X;Y\n";
-		for (int i = 0; i < Util::NumToT<int>(DataSeries->count()); ++i)
-			CSVData << DataSeries->at(i).x() / std::pow(10.0, Multiplier) << ";" << DataSeries->at(i).y() << "\n";
-
-		if (!Util::SaveToFile(Filename, CSVData.str()))
-			QMessageBox::warning(this, "DynExp - Error", "Error writing data to file.");
+		// The file is written in the background. Errors are logged to the event log.
+		Util::FileWriter().EnqueueData(Filename, Util::DataFileWriter::GetFormatFromFilename(Filename), "", { "X", "Y" },
+			[Points = DataSeries->points(), XScale = std::pow(10.0, Multiplier)](Util::DataFileWriter& Writer) {
+				for (const auto& Point : Points)
+					Writer.WriteRow({ Point.x() / XScale, Point.y() });
+			});
 	}
 
 	void SignalPlotterWidget::SampleDataType::Reset()
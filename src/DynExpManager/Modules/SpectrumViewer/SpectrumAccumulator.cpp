@@ -0,0 +1,120 @@
+// This file is part of DynExp.
+
+#include "stdafx.h"
+#include "SpectrumAccumulator.h"
+
+namespace DynExpModule::SpectrumViewer
+{
+	SpectrumAccumulator::SpectrumAccumulator(bool CosmicRayRejectionEnabled, size_t MedianWindowSize, double RejectionThreshold)
+		: CosmicRayRejectionEnabled(CosmicRayRejectionEnabled), MedianWindowSize(std::max(size_t(3), MedianWindowSize)),
+		RejectionThreshold(RejectionThreshold)
+	{
+	}
+
+	bool SpectrumAccumulator::Add(DynExpInstr::SpectrometerData::SpectrumType&& Spectrum)
+	{
+		bool Restarted = false;
+		if (NumSpectra && (Spectrum.GetFrequencyUnit() != Mean.GetFrequencyUnit() || Spectrum.GetIntensityUnit() != Mean.GetIntensityUnit()
+			|| Spectrum.GetFrequencies() != Mean.GetFrequencies()))
+		{
+			Reset();
+			Restarted = true;
+		}
+
+		if (CosmicRayRejectionEnabled)
+		{
+			RejectCosmicRays(Spectrum.GetIntensities());
+
+			MedianWindow.push_back(Spectrum.GetIntensities());
+			if (MedianWindow.size() > MedianWindowSize)
+				MedianWindow.pop_front();
+		}
+
+		if (!NumSpectra++)
+		{
+			M2.assign(Spectrum.GetNumSamples(), 0.0);
+			Mean = std::move(Spectrum);
+
+			return Restarted;
+		}
+
+		// Welford's algorithm
+		const auto& Intensities = Spectrum.GetIntensities();
+		auto& MeanIntensities = Mean.GetIntensities();
+		for (size_t i = 0; i < Intensities.size(); ++i)
+		{
+			const auto Delta = Intensities[i] - MeanIntensities[i];
+			MeanIntensities[i] += Delta / NumSpectra;
+			M2[i] += Delta * (Intensities[i] - MeanIntensities[i]);
+		}
+
+		return Restarted;
+	}
+
+	void SpectrumAccumulator::Reset()
+	{
+		Mean.Reset();
+		M2.clear();
+		NumSpectra = 0;
+		NumRejectedSamples = 0;
+		MedianWindow.clear();
+	}
+
+	DynExpInstr::SpectrometerData::SpectrumType SpectrumAccumulator::GetMean() const
+	{
+		return Mean;
+	}
+
+	std::vector<double> SpectrumAccumulator::GetStandardDeviation() const
+	{
+		std::vector<double> StandardDeviation(M2.size(), 0.0);
+		if (NumSpectra < 2)
+			return StandardDeviation;
+
+		for (size_t i = 0; i < M2.size(); ++i)
+			StandardDeviation[i] = std::sqrt(M2[i] / (NumSpectra - 1));
+
+		return StandardDeviation;
+	}
+
+	void SpectrumAccumulator::RejectCosmicRays(std::vector<double>& Intensities)
+	{
+		// Only start rejecting once the median window is filled since the median and the MAD are unreliable otherwise.
+		if (MedianWindow.size() < MedianWindowSize || MedianWindow.front().size() != Intensities.size())
+			return;
+
+		// Scaling of the median absolute deviation (MAD) to estimate the standard deviation of normally distributed data.
+		constexpr double MADToStdDev = 1.4826;
+
+		std::vector<double> WindowValues(MedianWindow.size());
+		std::vector<double> Deviations(MedianWindow.size());
+		const auto MedianOf = [](std::vector<double>& Values) {
+			const auto Mid = Values.begin() + Values.size() / 2;
+			std::nth_element(Values.begin(), Mid, Values.end());
+			if (Values.size() % 2)
+				return *Mid;
+
+			return (*Mid + *std::max_element(Values.begin(), Mid)) / 2;
+		};
+
+		for (size_t i = 0; i < Intensities.size(); ++i)
+		{
+			for (size_t j = 0; j < MedianWindow.size(); ++j)
+				WindowValues[j] = MedianWindow[j][i];
+			const auto Median = MedianOf(WindowValues);
+
+			for (size_t j = 0; j < MedianWindow.size(); ++j)
+				Deviations[j] = std::abs(MedianWindow[j][i] - Median);
+			auto StdDev = MADToStdDev * MedianOf(Deviations);
+			if (NumSpectra >= 2 && M2.size() == Intensities.size())
+				StdDev = std::max(StdDev, std::sqrt(M2[i] / (NumSpectra - 1)));
+
+			// Cosmic rays only ever add intensity. Do not reject anything if the data does not fluctuate at all.
+			if (StdDev > 0 && Intensities[i] - Median > RejectionThreshold * StdDev)
+			{
+				Intensities[i] = Median;
+				++NumRejectedSamples;
+			}
+		}
+	}
+}
@@ -0,0 +1,92 @@
+// This file is part of DynExp.
+
+/**
+ * @file SpectrumAccumulator.h
+ * @brief Incremental accumulation of spectra for the DynExpModule::SpectrumViewer::SpectrumViewer module.
+*/
+
+#pragma once
+
+#include "stdafx.h"
+#include "../../MetaInstruments/Spectrometer.h"
+
+namespace DynExpModule::SpectrumViewer
+{
+	/**
+	 * @brief Accumulates successive spectra with identical frequency axes computing the running mean
+	 * and the running variance of each sample (Welford's algorithm). Only the statistics are stored,
+	 * not the individual spectra. Optionally, cosmic rays are rejected by comparing each sample to the
+	 * median of the respective samples of the most recent spectra. Samples exceeding this median by more
+	 * than a multiple of the sample's standard deviation are replaced by the median before being
+	 * accumulated. For this purpose, only the most recent spectra forming the median window are retained.
+	*/
+	class SpectrumAccumulator
+	{
+	public:
+		static constexpr size_t DefaultMedianWindowSize = 5;		//!< Default value of #MedianWindowSize
+		static constexpr double DefaultRejectionThreshold = 5.0;	//!< Default value of #RejectionThreshold
+
+		/**
+		 * @brief Constructs an empty accumulator.
+		 * @param CosmicRayRejectionEnabled @copybrief #CosmicRayRejectionEnabled
+		 * @param MedianWindowSize @copybrief #MedianWindowSize Values less than three are set to three.
+		 * @param RejectionThreshold @copybrief #RejectionThreshold
+		*/
+		SpectrumAccumulator(bool CosmicRayRejectionEnabled = false, size_t MedianWindowSize = DefaultMedianWindowSize,
+			double RejectionThreshold = DefaultRejectionThreshold);
+
+		/**
+		 * @brief Adds a spectrum to the accumulation. If the frequency axis or the units of
+		 * @p Spectrum differ from the ones of the spectra accumulated so far, the accumulation
+		 * is restarted with @p Spectrum.
+		 * @param Spectrum Spectrum to add. Moved from if it needs to be retained for the median window.
+		 * @return Returns true if the accumulation has been restarted, false otherwise.
+		*/
+		bool Add(DynExpInstr::SpectrometerData::SpectrumType&& Spectrum);
+
+		void Reset();		//!< Discards all spectra accumulated so far.
+
+		/**
+		 * @brief Enables or disables the cosmic ray rejection. Takes effect for subsequently added spectra.
+		 * @param Enable @copybrief #CosmicRayRejectionEnabled
+		*/
+		void EnableCosmicRayRejection(bool Enable) noexcept { CosmicRayRejectionEnabled = Enable; }
+
+		bool IsCosmicRayRejectionEnabled() const noexcept { return CosmicRayRejectionEnabled; }		//!< Getter for #CosmicRayRejectionEnabled
+		size_t GetNumSpectra() const noexcept { return NumSpectra; }								//!< Getter for #NumSpectra
+		size_t GetNumRejectedSamples() const noexcept { return NumRejectedSamples; }				//!< Getter for #NumRejectedSamples
+		bool IsEmpty() const noexcept { return !NumSpectra; }										//!< Returns true if no spectrum has been accumulated yet.
+
+		/**
+		 * @brief Returns the running mean of all spectra accumulated so far.
+		 * @return Mean spectrum. Empty if no spectrum has been accumulated yet.
+		*/
+		DynExpInstr::SpectrometerData::SpectrumType GetMean() const;
+
+		/**
+		 * @brief Returns the sample standard deviation of each sample of all spectra accumulated so far.
+		 * @return Standard deviations with the same order as the samples returned by @p GetMean().
+		 * Contains zeros if less than two spectra have been accumulated.
+		*/
+		std::vector<double> GetStandardDeviation() const;
+
+	private:
+		/**
+		 * @brief Replaces samples of @p Intensities deviating from the median of the median window
+		 * by more than #RejectionThreshold standard deviations by this median.
+		 * @param Intensities Intensities of a new spectrum to check
+		*/
+		void RejectCosmicRays(std::vector<double>& Intensities);
+
+		bool CosmicRayRejectionEnabled;		//!< Determines whether cosmic rays are rejected.
+		const size_t MedianWindowSize;		//!< Number of most recent spectra whose median each new spectrum is compared to
+		const double RejectionThreshold;	//!< Samples exceeding the median by more than this number of standard deviations are rejected.
+
+		DynExpInstr::SpectrometerData::SpectrumType Mean;	//!< Running mean of the accumulated spectra. Defines the frequency axis.
+		std::vector<double> M2;								//!< Running sum of squared deviations from the mean (Welford's algorithm)
+		size_t NumSpectra = 0;								//!< Number of accumulated spectra
+		size_t NumRejectedSamples = 0;						//!< Number of samples rejected as cosmic rays
+
+		std::deque<std::vector<double>> MedianWindow;		//!< Intensities of the most recent spectra (at most #MedianWindowSize)
+	};
+}
@@ -11,7 +11,7 @@ namespace DynExpModule::SpectrumViewer
 		DataSeries(nullptr), DataChart(nullptr), XAxis(nullptr), YAxis(nullptr)
 	{
 		ui.setupUi(this);
-		
+
 		// For shortcuts
 		this->addAction(ui.action_Run);
 		this->addAction(ui.action_Stop);
@@ -57,12 +57,22 @@ namespace DynExpModule::SpectrumViewer
 
 	void SpectrumViewerWidget::UpdateUI(Util::SynchronizedPointer<SpectrumViewerData>& ModuleData)
 	{
-		ui.action_Save_CSV->setEnabled(ModuleData->CapturingState != DynExpInstr::SpectrometerData::CapturingStateType::Capturing);
-		ui.action_Run->setEnabled(ModuleData->CapturingState != DynExpInstr::SpectrometerData::CapturingStateType::Capturing);
-		ui.action_Stop->setEnabled(ModuleData->CapturingState == DynExpInstr::SpectrometerData::CapturingStateType::Capturing);
-		ui.SBExposureTime->setEnabled(ModuleData->CapturingState != DynExpInstr::SpectrometerData::CapturingStateType::Capturing);
-		ui.SBLowerFrequency->setEnabled(ModuleData->CapturingState != DynExpInstr::SpectrometerData::CapturingStateType::Capturing);
-		ui.SBUpperFrequency->setEnabled(ModuleData->CapturingState != DynExpInstr::SpectrometerData::CapturingStateType::Capturing);
+		const bool IsBusy = ModuleData->CapturingState == DynExpInstr::SpectrometerData::CapturingStateType::Capturing || ModuleData->IsAccumulating;
+
+		ui.action_Save_CSV->setEnabled(!IsBusy);
+		ui.action_Run->setEnabled(!IsBusy);
+		ui.action_Stop->setEnabled(IsBusy);
+		ui.action_Accumulate->setEnabled(!IsBusy);
+		ui.SBExposureTime->setEnabled(!IsBusy);
+		ui.SBLowerFrequency->setEnabled(!IsBusy);
+		ui.SBUpperFrequency->setEnabled(!IsBusy);
+		ui.SBNumAccumulations->setEnabled(!IsBusy && ModuleData->AccumulationEnabled);
+		ui.CBRejectCosmicRays->setEnabled(!IsBusy && ModuleData->AccumulationEnabled);
+
+		{
+			const QSignalBlocker Blocker(ui.action_Accumulate);
+			ui.action_Accumulate->setChecked(ModuleData->AccumulationEnabled);
+		} // Blocker destroyed here.
 
 		{
 			const QSignalBlocker Blocker(ui.action_SilentMode);
@@ -87,6 +97,25 @@ namespace DynExpModule::SpectrumViewer
 			ui.SBUpperFrequency->setValue(ModuleData->CurrentUpperFrequency);
 		}
 
+		if (ModuleData->IsAccumulating && ModuleData->CapturingState != DynExpInstr::SpectrometerData::CapturingStateType::Error)
+		{
+			auto StateText = " Accumulating spectra (" + std::to_string(ModuleData->Accumulator.GetNumSpectra());
+			if (ModuleData->NumSpectraToAccumulate)
+				StateText += " / " + std::to_string(ModuleData->NumSpectraToAccumulate);
+			if (ModuleData->Accumulator.IsCosmicRayRejectionEnabled())
+				StateText += ", " + std::to_string(ModuleData->Accumulator.GetNumRejectedSamples()) + " samples rejected";
+			StateText += ")...";
+
+			ui.LState->setText(QString::fromStdString(StateText));
+			ui.LState->setStyleSheet(DynExpUI::StatusBarBusyStyleSheet);
+
+			ui.PBProgress->setVisible(ModuleData->NumSpectraToAccumulate > 0);
+			ui.PBProgress->setValue(ModuleData->NumSpectraToAccumulate > 0 ?
+				Util::NumToT<int>(100 * ModuleData->Accumulator.GetNumSpectra() / ModuleData->NumSpectraToAccumulate) : 0);
+
+			return;
+		}
+
 		switch (ModuleData->CapturingState)
 		{
 		case DynExpInstr::SpectrometerData::CapturingStateType::Capturing:
@@ -137,7 +166,7 @@ namespace DynExpModule::SpectrumViewer
 		}
 		else
 			DataChart->axes()[1]->setRange(CurrentSpectrum.MinValues.y(), CurrentSpectrum.MaxValues.y());
-		
+
 		DataChart->addSeries(DataSeries);
 		DataSeries->attachAxis(DataChart->axes()[0]);
 		DataSeries->attachAxis(DataChart->axes()[1]);
@@ -153,8 +182,8 @@ namespace DynExpModule::SpectrumViewer
 		if (Filename.isEmpty())
 			return;
 
-		if (!Util::SaveToFile(Filename, CurrentSpectrum.ToStr(CurrentExposureTime)))
-			QMessageBox::warning(this, "DynExp - Error", "Error writing data to file.");
+		// The file is written in the background. Errors are logged to the event log.
+		Util::FileWriter().EnqueueText(Filename, CurrentSpectrum.ToStr(CurrentExposureTime));
 	}
 
 	void SpectrumViewerWidget::SampleDataType::Reset()
@@ -164,6 +193,10 @@ namespace DynExpModule::SpectrumViewer
 		MinValues = {};
 		MaxValues = {};
 
+		StandardDeviations.clear();
+		NumAccumulatedSpectra = 0;
+		NumRejectedSamples = 0;
+
 		FrequencyUnit = DynExpInstr::SpectrometerData::FrequencyUnitType::Hz;
 		IntensityUnit = DynExpInstr::SpectrometerData::IntensityUnitType::Counts;
 	}
@@ -173,12 +206,28 @@ namespace DynExpModule::SpectrumViewer
 		std::stringstream CSVData;
 		CSVData << std::setprecision(6);
 		CSVData << "ExposureTime = " << ExposureTime.count() << " " << Util::ToUnitStr<DynExpInstr::SpectrometerData::TimeType>() << "\n";
+
+		const bool IsAccumulated = StandardDeviations.size() == Util::NumToT<size_t>(Points.size());
+		if (IsAccumulated)
+		{
+			CSVData << "NumAccumulatedSpectra = " << NumAccumulatedSpectra << "\n";
+			CSVData << "NumRejectedSamples = " << NumRejectedSamples << "\n";
+		}
 		CSVData << "HEADER_END\n";
 
 		CSVData << "f[" << DynExpInstr::SpectrometerData::FrequencyUnitTypeToStr(FrequencyUnit)
-			<< "];I[" << DynExpInstr::SpectrometerData::IntensityUnitTypeToStr(IntensityUnit) << "]\n";
-		for (const auto& Sample : Points)
-			CSVData << Sample.x() << ";" << Sample.y() << "\n";
+			<< "];I[" << DynExpInstr::SpectrometerData::IntensityUnitTypeToStr(IntensityUnit) << "]";
+		if (IsAccumulated)
+			CSVData << ";sigma_I[" << DynExpInstr::SpectrometerData::IntensityUnitTypeToStr(IntensityUnit) << "]";
+		CSVData << "\n";
+
+		for (decltype(Points.size()) i = 0; i < Points.size(); ++i)
+		{
+			CSVData << Points[i].x() << ";" << Points[i].y();
+			if (IsAccumulated)
+				CSVData << ";" << StandardDeviations[i];
+			CSVData << "\n";
+		}
 
 		return CSVData.str();
 	}
@@ -207,6 +256,12 @@ namespace DynExpModule::SpectrumViewer
 		CurrentSpectrum.Reset();
 		SpectrumRecordingPaused = false;
 
+		AccumulationEnabled = false;
+		NumSpectraToAccumulate = 10;
+		CosmicRayRejectionEnabled = false;
+		IsAccumulating = false;
+		Accumulator.Reset();
+
 		UIInitialized = false;
 	}
 
@@ -226,12 +281,41 @@ namespace DynExpModule::SpectrumViewer
 
 			if (InstrData->HasSpectrum() && !ModuleData->SpectrumRecordingPaused)
 			{
-				ModuleData->CurrentSpectrum = ProcessSpectrum(InstrData->GetSpectrum(), ModuleData);
+				bool IsRecordingFinished = true;
+
+				if (ModuleData->IsAccumulating)
+				{
+					// Only the accumulated statistics are kept, the individual spectra are discarded.
+					ModuleData->Accumulator.Add(InstrData->GetSpectrum());
+					ModuleData->CurrentSpectrum = ProcessAccumulatedSpectrum(ModuleData);
+
+					IsRecordingFinished = ModuleData->NumSpectraToAccumulate &&
+						ModuleData->Accumulator.GetNumSpectra() >= ModuleData->NumSpectraToAccumulate;
+					if (IsRecordingFinished)
+					{
+						ModuleData->IsAccumulating = false;
+
+						// Spectrometers acquiring spectra continuously need to be stopped.
+						if (ModuleData->CapturingState == DynExpInstr::SpectrometerData::CapturingStateType::Capturing)
+							ModuleData->GetSpectrometer()->Abort();
+					}
+					else if (ModuleData->CapturingState != DynExpInstr::SpectrometerData::CapturingStateType::Capturing)
+						ModuleData->GetSpectrometer()->Record();
+				}
+				else
+					ModuleData->CurrentSpectrum = ProcessSpectrum(InstrData->GetSpectrum());
 
-				if (!ModuleData->CurrentSpectrum.Points.empty())
+				// When accumulating, save only once per accumulation.
+				if (IsRecordingFinished && !ModuleData->CurrentSpectrum.Points.empty())
 				{
-					if (ModuleData->GetCommunicator().valid() && !ModuleData->AutoSaveFilename.empty())
-						ModuleData->GetCommunicator()->PostEvent(*this, SpectrumFinishedRecordingEvent{});
+					if (!ModuleData->AutoSaveFilename.empty())
+					{
+						// Notify first to let the requesting module continue while the spectrum is being saved.
+						if (ModuleData->GetCommunicator().valid())
+							ModuleData->GetCommunicator()->PostEvent(*this, SpectrumFinishedRecordingEvent{});
+
+						SaveSpectrum(ModuleData->CurrentSpectrum, ModuleData);
+					}
 
 					ModuleData->AutoSaveFilename.clear();
 				}
@@ -263,6 +347,9 @@ namespace DynExpModule::SpectrumViewer
 		Connect(Widget->GetUI().SBExposureTime, QOverload<int>::of(&QSpinBox::valueChanged), this, &SpectrumViewer::OnExposureTimeChanged);
 		Connect(Widget->GetUI().SBLowerFrequency, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &SpectrumViewer::OnLowerLimitChanged);
 		Connect(Widget->GetUI().SBUpperFrequency, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &SpectrumViewer::OnUpperLimitChanged);
+		Connect(Widget->GetUI().action_Accumulate, &QAction::toggled, this, &SpectrumViewer::OnAccumulateToggled);
+		Connect(Widget->GetUI().SBNumAccumulations, QOverload<int>::of(&QSpinBox::valueChanged), this, &SpectrumViewer::OnNumAccumulationsChanged);
+		Connect(Widget->GetUI().CBRejectCosmicRays, &QCheckBox::stateChanged, this, &SpectrumViewer::OnRejectCosmicRaysChanged);
 
 		return Widget;
 	}
@@ -284,8 +371,7 @@ namespace DynExpModule::SpectrumViewer
 			Widget->SetData(std::move(ModuleData->CurrentSpectrum), ModuleData->AcquisitionExposureTime);
 	}
 
-	SpectrumViewerWidget::SampleDataType SpectrumViewer::ProcessSpectrum(DynExpInstr::SpectrometerData::SpectrumType&& Spectrum,
-		Util::SynchronizedPointer<SpectrumViewerData>& ModuleData)
+	SpectrumViewerWidget::SampleDataType SpectrumViewer::ProcessSpectrum(DynExpInstr::SpectrometerData::SpectrumType&& Spectrum)
 	{
 		SpectrumViewerWidget::SampleDataType TransformedSpectrum;
 		TransformedSpectrum.FrequencyUnit = Spectrum.GetFrequencyUnit();
@@ -294,20 +380,25 @@ namespace DynExpModule::SpectrumViewer
 		if (!Spectrum.HasSpectrum())
 			return TransformedSpectrum;
 
-		double YMin(std::numeric_limits<double>::max()), YMax(std::numeric_limits<double>::lowest());
-		for (const auto& Sample : Spectrum.GetSpectrum())
-		{
-			TransformedSpectrum.Points.append({ Sample.first, Sample.second });
+		const auto& Frequencies = Spectrum.GetFrequencies();
+		const auto& Intensities = Spectrum.GetIntensities();
+		TransformedSpectrum.Points.reserve(Util::NumToT<decltype(TransformedSpectrum.Points)::size_type>(Frequencies.size()));
+		for (size_t i = 0; i < Frequencies.size(); ++i)
+			TransformedSpectrum.Points.append({ Frequencies[i], Intensities[i] });
 
-			YMin = std::min(YMin, Sample.second);
-			YMax = std::max(YMax, Sample.second);
-		}
+		const auto IntensityRange = Spectrum.GetIntensityRange();
+		TransformedSpectrum.MinValues = { Frequencies.front(), IntensityRange.first };
+		TransformedSpectrum.MaxValues = { Frequencies.back(), IntensityRange.second };
 
-		TransformedSpectrum.MinValues = { Spectrum.GetSpectrum().begin()->first, YMin};
-		TransformedSpectrum.MaxValues = { Spectrum.GetSpectrum().rbegin()->first, YMax};
+		return TransformedSpectrum;
+	}
 
-		if (!ModuleData->AutoSaveFilename.empty())
-			SaveSpectrum(TransformedSpectrum, ModuleData);
+	SpectrumViewerWidget::SampleDataType SpectrumViewer::ProcessAccumulatedSpectrum(Util::SynchronizedPointer<SpectrumViewerData>& ModuleData)
+	{
+		auto TransformedSpectrum = ProcessSpectrum(ModuleData->Accumulator.GetMean());
+		TransformedSpectrum.StandardDeviations = ModuleData->Accumulator.GetStandardDeviation();
+		TransformedSpectrum.NumAccumulatedSpectra = ModuleData->Accumulator.GetNumSpectra();
+		TransformedSpectrum.NumRejectedSamples = ModuleData->Accumulator.GetNumRejectedSamples();
 
 		return TransformedSpectrum;
 	}
@@ -315,10 +406,17 @@ namespace DynExpModule::SpectrumViewer
 	void SpectrumViewer::SaveSpectrum(const SpectrumViewerWidget::SampleDataType& Spectrum,
 		Util::SynchronizedPointer<SpectrumViewerData>& ModuleData)
 	{
-		if (!Util::SaveToFile(QString::fromStdString(ModuleData->AutoSaveFilename), Spectrum.ToStr(ModuleData->CurrentExposureTime)))
-			Util::EventLogger().Log("Saving spectrum as \"" + ModuleData->AutoSaveFilename + "\" to file failed.", Util::ErrorType::Error);
-		else
-			Util::EventLogger().Log("Saved spectrum as \"" + ModuleData->AutoSaveFilename + "\" to file.");
+		// Formatting and writing the spectrum is left to the writer thread in order not to block the module.
+		Util::FileWriter().Enqueue(QString::fromStdString(ModuleData->AutoSaveFilename),
+			[Spectrum, ExposureTime = ModuleData->CurrentExposureTime](const QString& Filename) {
+				if (!Util::SaveToFile(Filename, Spectrum.ToStr(ExposureTime)))
+					throw Util::FileIOErrorException(Filename.toStdString());
+			},
+			[](const QString& Filename, bool Success) {
+				// Failures have already been logged by the file writer.
+				if (Success)
+					Util::EventLog().Log("Saved spectrum as \"" + Filename.toStdString() + "\" to file.");
+			});
 	}
 
 	void SpectrumViewer::OnInit(DynExp::ModuleInstance* Instance) const
@@ -364,6 +462,11 @@ namespace DynExpModule::SpectrumViewer
 
 		ModuleData->SpectrumRecordingPaused = false;
 		ModuleData->AcquisitionExposureTime = ModuleData->CurrentExposureTime;
+
+		ModuleData->IsAccumulating = ModuleData->AccumulationEnabled;
+		ModuleData->Accumulator.Reset();
+		ModuleData->Accumulator.EnableCosmicRayRejection(ModuleData->CosmicRayRejectionEnabled);
+
 		ModuleData->GetSpectrometer()->Record();
 	}
 
@@ -373,6 +476,7 @@ namespace DynExpModule::SpectrumViewer
 
 		ModuleData->SpectrumRecordingPaused = false;
 		ModuleData->AutoSaveFilename.clear();
+		ModuleData->IsAccumulating = false;
 		ModuleData->GetSpectrometer()->Abort();
 	}
 
@@ -408,6 +512,27 @@ namespace DynExpModule::SpectrumViewer
 			ModuleData->GetSpectrometer()->SetFrequencyRange(InstrData->GetCurrentLowerFrequency(), Value);
 	}
 
+	void SpectrumViewer::OnAccumulateToggled(DynExp::ModuleInstance* Instance, bool Checked) const
+	{
+		auto ModuleData = DynExp::dynamic_ModuleData_cast<SpectrumViewer>(Instance->ModuleDataGetter());
+
+		ModuleData->AccumulationEnabled = Checked;
+	}
+
+	void SpectrumViewer::OnNumAccumulationsChanged(DynExp::ModuleInstance* Instance, int Value) const
+	{
+		auto ModuleData = DynExp::dynamic_ModuleData_cast<SpectrumViewer>(Instance->ModuleDataGetter());
+
+		ModuleData->NumSpectraToAccumulate = Util::NumToT<size_t>(std::max(0, Value));
+	}
+
+	void SpectrumViewer::OnRejectCosmicRaysChanged(DynExp::ModuleInstance* Instance, int Value) const
+	{
+		auto ModuleData = DynExp::dynamic_ModuleData_cast<SpectrumViewer>(Instance->ModuleDataGetter());
+
+		ModuleData->CosmicRayRejectionEnabled = Value == Qt::CheckState::Checked;
+	}
+
 	void SpectrumViewer::OnRecordAndSaveSpectrum(DynExp::ModuleInstance* Instance, std::string SaveDataFilename) const
 	{
 		{
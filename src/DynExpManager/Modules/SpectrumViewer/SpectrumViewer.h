@@ -13,6 +13,7 @@
 #include "../../Instruments/InterModuleCommunicator.h"
 
 #include "SpectrumViewerEvents.h"
+#include "SpectrumAccumulator.h"
 
 #include <QWidget>
 #include "ui_SpectrumViewer.h"
@@ -38,6 +39,11 @@ namespace DynExpModule::SpectrumViewer
 			QPointF MinValues;
 			QPointF MaxValues;
 
+			// Statistics of accumulated spectra. StandardDeviations is empty if the spectrum has not been accumulated.
+			std::vector<double> StandardDeviations;
+			size_t NumAccumulatedSpectra;
+			size_t NumRejectedSamples;
+
 			DynExpInstr::SpectrometerData::FrequencyUnitType FrequencyUnit;
 			DynExpInstr::SpectrometerData::IntensityUnitType IntensityUnit;
 		};
@@ -103,6 +109,12 @@ namespace DynExpModule::SpectrumViewer
 		SpectrumViewerWidget::SampleDataType CurrentSpectrum;
 		bool SpectrumRecordingPaused;
 
+		bool AccumulationEnabled;
+		size_t NumSpectraToAccumulate;
+		bool CosmicRayRejectionEnabled;
+		bool IsAccumulating;
+		SpectrumAccumulator Accumulator;
+
 	private:
 		void ResetImpl(dispatch_tag<QModuleDataBase>) override final;
 		virtual void ResetImpl(dispatch_tag<SpectrumViewerData>) {};
@@ -172,8 +184,8 @@ namespace DynExpModule::SpectrumViewer
 		std::unique_ptr<DynExp::QModuleWidget> MakeUIWidget() override final;
 		void UpdateUIChild(const ModuleBase::ModuleDataGetterType& ModuleDataGetter) override final;
 
-		SpectrumViewerWidget::SampleDataType ProcessSpectrum(DynExpInstr::SpectrometerData::SpectrumType&& Spectrum,
-			Util::SynchronizedPointer<SpectrumViewerData>& ModuleData);
+		SpectrumViewerWidget::SampleDataType ProcessSpectrum(DynExpInstr::SpectrometerData::SpectrumType&& Spectrum);
+		SpectrumViewerWidget::SampleDataType ProcessAccumulatedSpectrum(Util::SynchronizedPointer<SpectrumViewerData>& ModuleData);
 		void SaveSpectrum(const SpectrumViewerWidget::SampleDataType& Spectrum,
 			Util::SynchronizedPointer<SpectrumViewerData>& ModuleData);
 
@@ -187,6 +199,9 @@ namespace DynExpModule::SpectrumViewer
 		void OnExposureTimeChanged(DynExp::ModuleInstance* Instance, int Value) const;
 		void OnLowerLimitChanged(DynExp::ModuleInstance* Instance, double Value) const;
 		void OnUpperLimitChanged(DynExp::ModuleInstance* Instance, double Value) const;
+		void OnAccumulateToggled(DynExp::ModuleInstance* Instance, bool Checked) const;
+		void OnNumAccumulationsChanged(DynExp::ModuleInstance* Instance, int Value) const;
+		void OnRejectCosmicRaysChanged(DynExp::ModuleInstance* Instance, int Value) const;
 		void OnRecordAndSaveSpectrum(DynExp::ModuleInstance* Instance, std::string SaveDataFilename) const;
 		void OnPauseSpectrumRecording(DynExp::ModuleInstance* Instance) const;
 		void OnResumeSpectrumRecording(DynExp::ModuleInstance* Instance) const;
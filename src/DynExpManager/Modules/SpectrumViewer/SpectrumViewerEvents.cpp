@@ -5,27 +5,27 @@
 
 namespace DynExpModule::SpectrumViewer
 {
-	void RecordSpectrumEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const
+	void RecordSpectrumEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const
 	{
 		EventFunc(&Instance, SaveDataFilename);
 	}
 
-	void SpectrumFinishedRecordingEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const
+	void SpectrumFinishedRecordingEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const
 	{
 		EventFunc(&Instance);
 	}
 
-	void PauseSpectrumRecordingEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const
+	void PauseSpectrumRecordingEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const
 	{
 		EventFunc(&Instance);
 	}
 
-	void ResumeSpectrumRecordingEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const
+	void ResumeSpectrumRecordingEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const
 	{
 		EventFunc(&Instance);
 	}
 
-	void SetSilentModeEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const
+	void SetSilentModeEvent::InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const
 	{
 		EventFunc(&Instance, Enable);
 	}
@@ -20,7 +20,7 @@ namespace DynExpModule::SpectrumViewer
 		virtual ~RecordSpectrumEvent() {}
 
 	private:
-		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const override;
+		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const override;
 
 		const std::string SaveDataFilename;
 	};
@@ -32,7 +32,7 @@ namespace DynExpModule::SpectrumViewer
 		virtual ~SpectrumFinishedRecordingEvent() {}
 
 	private:
-		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const override;
+		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const override;
 	};
 
 	class PauseSpectrumRecordingEvent : public DynExp::InterModuleEvent<PauseSpectrumRecordingEvent>
@@ -42,7 +42,7 @@ namespace DynExpModule::SpectrumViewer
 		virtual ~PauseSpectrumRecordingEvent() {}
 
 	private:
-		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const override;
+		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const override;
 	};
 
 	class ResumeSpectrumRecordingEvent : public DynExp::InterModuleEvent<ResumeSpectrumRecordingEvent>
@@ -52,7 +52,7 @@ namespace DynExpModule::SpectrumViewer
 		virtual ~ResumeSpectrumRecordingEvent() {}
 
 	private:
-		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const override;
+		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const override;
 	};
 
 	class SetSilentModeEvent : public DynExp::InterModuleEvent<RecordSpectrumEvent, bool>
@@ -62,7 +62,7 @@ namespace DynExpModule::SpectrumViewer
 		virtual ~SetSilentModeEvent() {}
 
 	private:
-		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, EventListenersType::EventFunctionType EventFunc) const override;
+		virtual void InvokeWithParamsChild(DynExp::ModuleInstance& Instance, const EventListenersType::EventFunctionType& EventFunc) const override;
 
 		const bool Enable;
 	};
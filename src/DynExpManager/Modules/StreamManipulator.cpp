@@ -6,7 +6,7 @@
 PYBIND11_MAKE_OPAQUE(DynExpModule::PyStreamListType);
 PYBIND11_MAKE_OPAQUE(decltype(DynExpModule::PyStreamManipulatorOutputData::LastConsumedSampleIDsPerInputStream));
 
-PYBIND11_EMBEDDED_MODULE(PyModuleStreamManipulator, m)
+DYNEXP_PY_EMBEDDED_MODULE(PyModuleStreamManipulator, m)
 {
 	using namespace DynExpModule;
 
@@ -46,6 +46,16 @@ namespace DynExpModule
 		LastConsumedSampleIDsPerInputStream.clear();
 	}
 
+	Util::TextValueListType<StreamManipulatorParams::ExecutionBackendType> StreamManipulatorParams::ExecutionBackendTypeStrList()
+	{
+		Util::TextValueListType<ExecutionBackendType> List = {
+			{ "Main interpreter (shared GIL)", ExecutionBackendType::MainInterpreter },
+			{ "Subinterpreter (own GIL)", ExecutionBackendType::Subinterpreter }
+		};
+
+		return List;
+	}
+
 	void StreamManipulatorData::ResetImpl(dispatch_tag<ModuleDataBase>)
 	{
 		Init();
@@ -102,6 +112,7 @@ namespace DynExpModule
 		ManipulatorPyFuncExit.Reset();
 		ManipulatorPyFuncInput.Reset();
 		ManipulatorPyFuncOutput.Reset();
+		Interpreter.reset();
 
 		NumFailedUpdateAttempts = 0;
 		LastManipulatorPyFuncExecution = {};
@@ -136,7 +147,7 @@ namespace DynExpModule
 
 		PyStreamManipulatorOutputData FuncOutput;
 		{
-			py::gil_scoped_acquire acquire;
+			Util::PyInterpreterLock Lock(Interpreter.get());
 
 			auto PyResult = ManipulatorPyFuncStep(&ManipulatorPyFuncInput);
 			if (!PyResult.is_none())
@@ -186,7 +197,16 @@ namespace DynExpModule
 		PythonCode = std::regex_replace(PythonCode, std::regex("\r\n"), "\n");
 		PythonCode = std::regex_replace(PythonCode, std::regex("\n"), std::string("\n") + Util::PyTab);
 
-		py::gil_scoped_acquire acquire;
+		if (ModuleParams->ExecutionBackend == StreamManipulatorParams::ExecutionBackendType::Subinterpreter)
+		{
+			Interpreter = std::make_unique<Util::PySubinterpreter>();
+
+			ManipulatorPyFuncInit.Reset(Interpreter.get());
+			ManipulatorPyFuncStep.Reset(Interpreter.get());
+			ManipulatorPyFuncExit.Reset(Interpreter.get());
+		}
+
+		Util::PyInterpreterLock Lock(Interpreter.get());
 		DynExpInstr::PyDataStreamInstrument::import();
 		py::exec("import PyModuleStreamManipulator as StreamManipulator");
 		py::exec("def " + ManipulatorPyFuncName + "():\n" +
@@ -236,9 +256,20 @@ namespace DynExpModule
 
 		try 
 		{
-			py::gil_scoped_acquire acquire;
-			ManipulatorPyFuncExit(&ManipulatorPyFuncInput);
-			py::exec("del " + ManipulatorPyFuncName);
+			{
+				Util::PyInterpreterLock Lock(Interpreter.get());
+				ManipulatorPyFuncExit(&ManipulatorPyFuncInput);
+				py::exec("del " + ManipulatorPyFuncName);
+			} // GIL released here.
+
+			if (Interpreter)
+			{
+				// The subinterpreter must outlive all Python objects belonging to it.
+				ManipulatorPyFuncInit.Reset();
+				ManipulatorPyFuncStep.Reset();
+				ManipulatorPyFuncExit.Reset();
+				Interpreter.reset();
+			}
 		}
 		catch (...)
 		{
@@ -133,6 +133,20 @@ namespace DynExpModule
 	class StreamManipulatorParams : public DynExp::ModuleParamsBase
 	{
 	public:
+		/**
+		 * @brief Type of the Python interpreter the module's Python code is executed in
+		*/
+		enum class ExecutionBackendType {
+			MainInterpreter,	//!< Share %DynExp's main interpreter and its GIL with all other Python modules.
+			Subinterpreter		//!< Use a subinterpreter with an own GIL to run in parallel to other Python modules.
+		};
+
+		/**
+		 * @brief Assigns labels to the entries of @p ExecutionBackendType.
+		 * @return List of @p ExecutionBackendType entries with their labels
+		*/
+		static Util::TextValueListType<ExecutionBackendType> ExecutionBackendTypeStrList();
+
 		/**
 		 * @brief Constructs the parameters for a @p StreamManipulator instance.
 		*/
@@ -181,6 +195,17 @@ namespace DynExpModule
 		Param<ParamsConfigDialog::TextType> PythonCodePath = { *this, "PythonCodePath", "Python code path",
 			"Path to a Python file containing the function which writes samples to the output streams based on the input streams' data", true, "", DynExp::TextUsageType::Code };
 
+		/**
+		 * @brief Determines the Python interpreter the code at #PythonCodePath is executed in.
+		 * @details With ExecutionBackendType::Subinterpreter, each @p StreamManipulator instance
+		 * runs its code in a Util::PySubinterpreter with an own GIL. Then, multiple instances do not
+		 * block each other. Python modules imported by the code must support subinterpreters,
+		 * which is not the case for many third-party extension modules (e.g. numpy).
+		*/
+		Param<ExecutionBackendType> ExecutionBackend = { *this, ExecutionBackendTypeStrList(), "ExecutionBackend", "Execution backend",
+			"Python interpreter to run the code in. A subinterpreter (requires Python 3.12 or later) has an own GIL and does not block other modules executing Python code, but not all Python modules can be imported in a subinterpreter.",
+			true, ExecutionBackendType::MainInterpreter };
+
 	private:
 		/**
 		 * @copydoc DynExp::ParamsBase::ConfigureParamsImpl
@@ -286,6 +311,14 @@ namespace DynExpModule
 		*/
 		std::string ManipulatorPyFuncName;
 
+		/**
+		 * @brief Subinterpreter the module's Python code is executed in if
+		 * StreamManipulatorParams::ExecutionBackend is ExecutionBackendType::Subinterpreter.
+		 * nullptr if the main interpreter is used. Declared before the handles to Python
+		 * functions since the subinterpreter must outlive them.
+		*/
+		mutable std::unique_ptr<Util::PySubinterpreter> Interpreter;
+
 		mutable PyFuncType ManipulatorPyFuncInit;	//!< Handle to a Python function called on module initialization.
 		mutable PyFuncType ManipulatorPyFuncStep;	//!< Handle to a Python function called for each manipulation step.
 		mutable PyFuncType ManipulatorPyFuncExit;	//!< Handle to a Python function called on module termination.
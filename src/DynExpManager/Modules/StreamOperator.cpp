@@ -0,0 +1,395 @@
+// This file is part of DynExp.
+
+#include "stdafx.h"
+#include "StreamOperator.h"
+
+namespace DynExpModule
+{
+	void GainOffsetOperator::Process(StreamOperatorBlock& Block)
+	{
+		for (auto& Value : Block.Values)
+			Value = Gain * Value + Offset;
+	}
+
+	void NoiseOperator::Process(StreamOperatorBlock& Block)
+	{
+		if (Gaussian)
+		{
+			std::normal_distribution<StreamOperatorBlock::DataType> Distribution(0, Amplitude);
+			for (auto& Value : Block.Values)
+				Value += Distribution(RandomEngine);
+		}
+		else
+		{
+			std::uniform_real_distribution<StreamOperatorBlock::DataType> Distribution(-Amplitude, Amplitude);
+			for (auto& Value : Block.Values)
+				Value += Distribution(RandomEngine);
+		}
+	}
+
+	void MovingAverageOperator::Process(StreamOperatorBlock& Block)
+	{
+		if (Block.Empty())
+			return;
+
+		// History is extended by the block's values. The window sum is rebuilt from the history for each block,
+		// so that rounding errors of the running sum do not accumulate over many blocks.
+		const auto NumHistoryValues = History.size();
+		WindowSum = 0;
+		NumNaNsInWindow = NumPosInfsInWindow = NumNegInfsInWindow = 0;
+		for (const auto Value : History)
+			UpdateWindow(Value, true);
+		History.insert(History.cend(), Block.Values.cbegin(), Block.Values.cend());
+
+		for (size_t i = 0; i < Block.Size(); ++i)
+		{
+			const auto End = NumHistoryValues + i + 1;
+
+			UpdateWindow(History[End - 1], true);
+			if (End > Length)
+				UpdateWindow(History[End - 1 - Length], false);
+
+			Block.Values[i] = GetWindowMean(std::min(End, Length));
+		}
+
+		History.erase(History.cbegin(), History.cend() - std::min(Length - 1, History.size()));
+	}
+
+	void MovingAverageOperator::UpdateWindow(StreamOperatorBlock::DataType Value, bool Add) noexcept
+	{
+		if (std::isfinite(Value))
+		{
+			WindowSum += Add ? Value : -Value;
+
+			return;
+		}
+
+		auto& NumValues = std::isnan(Value) ? NumNaNsInWindow : (Value > 0 ? NumPosInfsInWindow : NumNegInfsInWindow);
+		if (Add)
+			++NumValues;
+		else
+			--NumValues;
+	}
+
+	StreamOperatorBlock::DataType MovingAverageOperator::GetWindowMean(size_t NumValues) const noexcept
+	{
+		if (NumNaNsInWindow || (NumPosInfsInWindow && NumNegInfsInWindow))
+			return std::numeric_limits<StreamOperatorBlock::DataType>::quiet_NaN();
+		if (NumPosInfsInWindow)
+			return std::numeric_limits<StreamOperatorBlock::DataType>::infinity();
+		if (NumNegInfsInWindow)
+			return -std::numeric_limits<StreamOperatorBlock::DataType>::infinity();
+
+		return WindowSum / static_cast<StreamOperatorBlock::DataType>(NumValues);
+	}
+
+	void DecimationOperator::Process(StreamOperatorBlock& Block)
+	{
+		const auto NumSamples = Block.Size();
+		size_t NumKeptSamples = 0;
+
+		for (auto i = (Factor - Phase) % Factor; i < NumSamples; i += Factor, ++NumKeptSamples)
+		{
+			Block.Values[NumKeptSamples] = Block.Values[i];
+			Block.Times[NumKeptSamples] = Block.Times[i];
+		}
+
+		Phase = (Phase + NumSamples) % Factor;
+		Block.Resize(NumKeptSamples);
+	}
+
+	void ThresholdOperator::Process(StreamOperatorBlock& Block)
+	{
+		// Separate loops without branches inside allow for vectorization.
+		if (TrueIfAbove)
+			for (auto& Value : Block.Values)
+				Value = Value >= Level ? 1 : 0;
+		else
+			for (auto& Value : Block.Values)
+				Value = Value < Level ? 1 : 0;
+	}
+
+	DynExpInstr::DataStreamBase::BasicSampleListType StreamOperatorBlock::ToBasicSamples() const
+	{
+		DynExpInstr::DataStreamBase::BasicSampleListType Samples(Size());
+		for (size_t i = 0; i < Samples.size(); ++i)
+			Samples[i] = { Values[i], Times[i] };
+
+		return Samples;
+	}
+
+	Util::TextValueListType<StreamOperatorParams::CombineModeType> StreamOperatorParams::CombineModeTypeStrList()
+	{
+		Util::TextValueListType<CombineModeType> List = {
+			{ "Sum of the inputs' n-th samples", CombineModeType::Sum },
+			{ "Product of the inputs' n-th samples", CombineModeType::Product },
+			{ "First input's n-th sample minus the other inputs' n-th samples", CombineModeType::Difference },
+			{ "Merge the inputs' samples by time", CombineModeType::MergeByTime }
+		};
+
+		return List;
+	}
+
+	Util::TextValueListType<StreamOperatorParams::NoiseModeType> StreamOperatorParams::NoiseModeTypeStrList()
+	{
+		Util::TextValueListType<NoiseModeType> List = {
+			{ "Disabled", NoiseModeType::Disabled },
+			{ "Uniformly distributed in [-amplitude, amplitude]", NoiseModeType::Uniform },
+			{ "Normally distributed with amplitude as standard deviation", NoiseModeType::Gaussian }
+		};
+
+		return List;
+	}
+
+	Util::TextValueListType<StreamOperatorParams::ThresholdModeType> StreamOperatorParams::ThresholdModeTypeStrList()
+	{
+		Util::TextValueListType<ThresholdModeType> List = {
+			{ "Disabled", ThresholdModeType::Disabled },
+			{ "1 if value >= level, 0 otherwise", ThresholdModeType::Above },
+			{ "1 if value < level, 0 otherwise", ThresholdModeType::Below }
+		};
+
+		return List;
+	}
+
+	void StreamOperatorData::ResetImpl(dispatch_tag<ModuleDataBase>)
+	{
+		Init();
+	}
+
+	void StreamOperatorData::Init()
+	{
+	}
+
+	Util::DynExpErrorCodes::DynExpErrorCodes StreamOperator::ModuleMainLoop(DynExp::ModuleInstance& Instance)
+	{
+		try
+		{
+			auto ModuleData = DynExp::dynamic_ModuleData_cast<StreamOperator>(Instance.ModuleDataGetter());
+			StreamOperatorBlock Block;
+
+			std::vector<DynExpInstr::DataStreamBase::BasicSampleListType> InputSamples(LastConsumedSampleIDsPerInputStream.size());
+			std::vector<size_t> FirstSampleIDs(InputSamples.size());
+			for (size_t i = 0; i < InputSamples.size(); ++i)
+			{
+				auto& Instrument = ModuleData->GetInputDataStreams()[i];
+				Instrument->ReadData();
+
+				auto InstrData = DynExp::dynamic_InstrumentData_cast<DynExpInstr::DataStreamInstrument>(Instrument->GetInstrumentData());
+				auto SampleStream = InstrData->GetCastSampleStream<SampleStreamType>();
+
+				// The stream has been cleared.
+				if (LastConsumedSampleIDsPerInputStream[i] > SampleStream->GetNumSamplesWritten())
+					LastConsumedSampleIDsPerInputStream[i] = 0;
+
+				// Every operator requires samples from each input.
+				if (!SampleStream->GetNumRecentBasicSamples(LastConsumedSampleIDsPerInputStream[i]))
+				{
+					NumFailedUpdateAttempts = 0;
+					return Util::DynExpErrorCodes::NoError;
+				}
+
+				InputSamples[i] = SampleStream->ReadRecentBasicSamples(LastConsumedSampleIDsPerInputStream[i]);
+				FirstSampleIDs[i] = SampleStream->GetNumSamplesWritten() - InputSamples[i].size();
+			} // InstrData unlocked here.
+
+			if (InputSamples.empty())
+				GenerateSourceSamples(Block);
+			else
+			{
+				const auto NumConsumedSamples = Combine(CombineMode, InputSamples, Block);
+				for (size_t i = 0; i < NumConsumedSamples.size(); ++i)
+					LastConsumedSampleIDsPerInputStream[i] = FirstSampleIDs[i] + NumConsumedSamples[i];
+			}
+
+			for (auto& Operator : Operators)
+				Operator->Process(Block);
+
+			if (!Block.Empty())
+			{
+				const auto Samples = Block.ToBasicSamples();
+
+				for (size_t i = 0; i < ModuleData->GetOutputDataStreams().GetList().size(); ++i)
+				{
+					auto& Instrument = ModuleData->GetOutputDataStreams()[i];
+
+					{
+						auto InstrData = DynExp::dynamic_InstrumentData_cast<DynExpInstr::DataStreamInstrument>(Instrument->GetInstrumentData());
+						InstrData->GetCastSampleStream<SampleStreamType>()->WriteBasicSamples(Samples);
+					} // InstrData unlocked here.
+
+					Instrument->WriteData();
+				}
+			}
+
+			NumFailedUpdateAttempts = 0;
+		} // ModuleData unlocked here.
+		catch (const Util::TimeoutException& e)
+		{
+			if (NumFailedUpdateAttempts++ >= 3)
+				Instance.GetOwner().SetWarning(e);
+		}
+
+		return Util::DynExpErrorCodes::NoError;
+	}
+
+	void StreamOperator::ResetImpl(dispatch_tag<ModuleBase>)
+	{
+		CombineMode = StreamOperatorParams::CombineModeType::Sum;
+		Operators.clear();
+		LastConsumedSampleIDsPerInputStream.clear();
+		SourceSampleRate = 0;
+		SourceStartTime = {};
+		NumSourceSamplesGenerated = 0;
+
+		NumFailedUpdateAttempts = 0;
+	}
+
+	std::vector<size_t> StreamOperator::Combine(StreamOperatorParams::CombineModeType CombineMode,
+		const std::vector<DynExpInstr::DataStreamBase::BasicSampleListType>& InputSamples, StreamOperatorBlock& Block)
+	{
+		std::vector<size_t> NumConsumedSamples(InputSamples.size(), 0);
+		if (InputSamples.empty())
+			return NumConsumedSamples;
+
+		if (CombineMode == StreamOperatorParams::CombineModeType::MergeByTime && InputSamples.size() > 1)
+		{
+			// Samples of a stream might still arrive up to the time of its last sample. So, only samples up to
+			// the earliest of all streams' last samples can be merged in order.
+			auto EndTime = std::numeric_limits<StreamOperatorBlock::DataType>::max();
+			for (const auto& Samples : InputSamples)
+				EndTime = std::min(EndTime, Samples.back().Time);
+
+			DynExpInstr::DataStreamBase::BasicSampleListType Merged, MergedSoFar;
+			for (size_t i = 0; i < InputSamples.size(); ++i)
+			{
+				const auto& Samples = InputSamples[i];
+				const auto End = std::upper_bound(Samples.cbegin(), Samples.cend(), EndTime,
+					[](const auto Time, const auto& Sample) { return Time < Sample.Time; });
+				NumConsumedSamples[i] = std::distance(Samples.cbegin(), End);
+
+				MergedSoFar.swap(Merged);
+				Merged.resize(MergedSoFar.size() + NumConsumedSamples[i]);
+				std::merge(MergedSoFar.cbegin(), MergedSoFar.cend(), Samples.cbegin(), End, Merged.begin(),
+					[](const auto& a, const auto& b) { return a.Time < b.Time; });
+			}
+
+			Block.Resize(Merged.size());
+			for (size_t i = 0; i < Merged.size(); ++i)
+			{
+				Block.Values[i] = Merged[i].Value;
+				Block.Times[i] = Merged[i].Time;
+			}
+
+			return NumConsumedSamples;
+		}
+
+		// Element-wise combination of the n-th samples of all inputs
+		size_t NumSamples = std::numeric_limits<size_t>::max();
+		for (const auto& Samples : InputSamples)
+			NumSamples = std::min(NumSamples, Samples.size());
+		std::fill(NumConsumedSamples.begin(), NumConsumedSamples.end(), NumSamples);
+
+		Block.Resize(NumSamples);
+		const auto& FirstSamples = InputSamples.front();
+		for (size_t i = 0; i < NumSamples; ++i)
+		{
+			Block.Values[i] = FirstSamples[i].Value;
+			Block.Times[i] = FirstSamples[i].Time;
+		}
+
+		// Separate loops for each mode without branches inside allow for vectorization.
+		for (auto Input = InputSamples.cbegin() + 1; Input != InputSamples.cend(); ++Input)
+		{
+			const auto& Samples = *Input;
+
+			switch (CombineMode)
+			{
+			case StreamOperatorParams::CombineModeType::Product:
+				for (size_t i = 0; i < NumSamples; ++i)
+					Block.Values[i] *= Samples[i].Value;
+				break;
+			case StreamOperatorParams::CombineModeType::Difference:
+				for (size_t i = 0; i < NumSamples; ++i)
+					Block.Values[i] -= Samples[i].Value;
+				break;
+			default:
+				for (size_t i = 0; i < NumSamples; ++i)
+					Block.Values[i] += Samples[i].Value;
+			}
+		}
+
+		return NumConsumedSamples;
+	}
+
+	void StreamOperator::GenerateSourceSamples(StreamOperatorBlock& Block)
+	{
+		// Limits the block size if the main loop has been delayed for a long time. Missing samples are generated in the next iterations.
+		constexpr size_t MaxNumSamplesPerBlock = 1 << 20;
+
+		const auto Now = std::chrono::steady_clock::now();
+		if (!NumSourceSamplesGenerated)
+			SourceStartTime = Now;
+
+		const auto NumSamplesDue = static_cast<size_t>(std::chrono::duration<double>(Now - SourceStartTime).count() * SourceSampleRate) + 1;
+		const auto NumSamples = std::min(NumSamplesDue - std::min(NumSamplesDue, NumSourceSamplesGenerated), MaxNumSamplesPerBlock);
+
+		// Samples are spaced equally in time regardless of the main loop's timing.
+		Block.Resize(NumSamples);
+		std::fill(Block.Values.begin(), Block.Values.end(), 0);
+		for (size_t i = 0; i < NumSamples; ++i)
+			Block.Times[i] = (NumSourceSamplesGenerated + i) / SourceSampleRate;
+
+		NumSourceSamplesGenerated += NumSamples;
+	}
+
+	void StreamOperator::OnInit(DynExp::ModuleInstance* Instance) const
+	{
+		auto ModuleParams = DynExp::dynamic_Params_cast<StreamOperator>(Instance->ParamsGetter());
+		auto ModuleData = DynExp::dynamic_ModuleData_cast<StreamOperator>(Instance->ModuleDataGetter());
+
+		Instance->LockObject(ModuleParams->InputDataStreams, ModuleData->GetInputDataStreams());
+		Instance->LockObject(ModuleParams->OutputDataStreams, ModuleData->GetOutputDataStreams());
+
+		CombineMode = ModuleParams->CombineMode;
+		Operators.clear();
+		if (ModuleParams->Gain != 1 || ModuleParams->Offset != 0)
+			Operators.push_back(std::make_unique<GainOffsetOperator>(ModuleParams->Gain, ModuleParams->Offset));
+		if (ModuleParams->NoiseMode != StreamOperatorParams::NoiseModeType::Disabled && ModuleParams->NoiseAmplitude > 0)
+			Operators.push_back(std::make_unique<NoiseOperator>(ModuleParams->NoiseMode == StreamOperatorParams::NoiseModeType::Gaussian,
+				ModuleParams->NoiseAmplitude));
+
+		// Clamping again makes the conversion to size_t safe even if a project file contains values out of range.
+		// NaN fails the comparisons below.
+		const auto MovingAverageLength = std::clamp(ModuleParams->MovingAverageLength.Get(), ParamsConfigDialog::NumberType(1), StreamOperatorParams::MaxOperatorLength);
+		const auto DecimationFactor = std::clamp(ModuleParams->DecimationFactor.Get(), ParamsConfigDialog::NumberType(1), StreamOperatorParams::MaxOperatorLength);
+		if (MovingAverageLength >= 2)
+			Operators.push_back(std::make_unique<MovingAverageOperator>(static_cast<size_t>(MovingAverageLength)));
+		if (DecimationFactor >= 2)
+			Operators.push_back(std::make_unique<DecimationOperator>(static_cast<size_t>(DecimationFactor)));
+		if (ModuleParams->ThresholdMode != StreamOperatorParams::ThresholdModeType::Disabled)
+			Operators.push_back(std::make_unique<ThresholdOperator>(ModuleParams->ThresholdLevel,
+				ModuleParams->ThresholdMode == StreamOperatorParams::ThresholdModeType::Above));
+
+		SourceSampleRate = std::isfinite(ModuleParams->SourceSampleRate.Get()) ?
+			std::clamp(ModuleParams->SourceSampleRate.Get(), ParamsConfigDialog::NumberType(1e-3), StreamOperatorParams::MaxSourceSampleRate) : 1;
+		NumSourceSamplesGenerated = 0;
+
+		// Only process samples which are written after the module has been started.
+		LastConsumedSampleIDsPerInputStream.clear();
+		for (size_t i = 0; i < ModuleData->GetInputDataStreams().GetList().size(); ++i)
+		{
+			auto& Instrument = ModuleData->GetInputDataStreams()[i];
+			auto InstrData = DynExp::dynamic_InstrumentData_cast<DynExpInstr::DataStreamInstrument>(Instrument->GetInstrumentData());
+			LastConsumedSampleIDsPerInputStream.push_back(InstrData->GetCastSampleStream<SampleStreamType>()->GetNumSamplesWritten());
+		}
+	}
+
+	void StreamOperator::OnExit(DynExp::ModuleInstance* Instance) const
+	{
+		auto ModuleData = DynExp::dynamic_ModuleData_cast<StreamOperator>(Instance->ModuleDataGetter());
+
+		Instance->UnlockObject(ModuleData->GetInputDataStreams());
+		Instance->UnlockObject(ModuleData->GetOutputDataStreams());
+	}
+}
@@ -0,0 +1,438 @@
+// This file is part of DynExp.
+
+/**
+ * @file StreamOperator.h
+ * @brief Implementation of a module to process data stored in data stream instrument(s) with
+ * a chain of built-in operators and to write the resulting data to other data stream instrument(s).
+ * This is a compiled alternative to the @p StreamManipulator module for common manipulations
+ * which do not require Python.
+*/
+
+#pragma once
+
+#include "stdafx.h"
+#include "DynExpCore.h"
+#include "../MetaInstruments/DataStreamInstrument.h"
+
+namespace DynExpModule
+{
+	class StreamOperator;
+
+	/**
+	 * @brief Block of samples passed through the operators of a @p StreamOperator module. Values
+	 * and times are stored in separate contiguous arrays (structure of arrays), so that the
+	 * compiler can vectorize the operators' loops.
+	*/
+	struct StreamOperatorBlock
+	{
+		using DataType = DynExpInstr::BasicSample::DataType;
+
+		size_t Size() const noexcept { return Values.size(); }
+		bool Empty() const noexcept { return Values.empty(); }
+		void Resize(size_t Size) { Values.resize(Size); Times.resize(Size); }
+
+		/**
+		 * @brief Converts the block into samples to be written to a data stream.
+		 * @return List of samples with values and times taken from #Values and #Times.
+		*/
+		DynExpInstr::DataStreamBase::BasicSampleListType ToBasicSamples() const;
+
+		std::vector<DataType> Values;		//!< Sample values
+		std::vector<DataType> Times;		//!< Sample times in seconds
+	};
+
+	/**
+	 * @brief Base class of all operators a @p StreamOperator module chains to process blocks
+	 * of samples. Operators may keep state between consecutive blocks.
+	*/
+	class StreamOperatorBase
+	{
+	public:
+		virtual ~StreamOperatorBase() = default;
+
+		/**
+		 * @brief Processes @p Block in place.
+		 * @param Block Block of samples to process. The operator might change its size.
+		*/
+		virtual void Process(StreamOperatorBlock& Block) = 0;
+	};
+
+	/**
+	 * @brief Operator multiplying all values with a gain and adding an offset afterwards.
+	*/
+	class GainOffsetOperator : public StreamOperatorBase
+	{
+	public:
+		GainOffsetOperator(StreamOperatorBlock::DataType Gain, StreamOperatorBlock::DataType Offset) noexcept
+			: Gain(Gain), Offset(Offset) {}
+
+		void Process(StreamOperatorBlock& Block) override;
+
+	private:
+		const StreamOperatorBlock::DataType Gain;
+		const StreamOperatorBlock::DataType Offset;
+	};
+
+	/**
+	 * @brief Operator adding uniformly or normally distributed random numbers to all values.
+	*/
+	class NoiseOperator : public StreamOperatorBase
+	{
+	public:
+		/**
+		 * @brief Constructs a @p NoiseOperator instance.
+		 * @param Gaussian Determines whether the noise is normally (true) or uniformly (false) distributed.
+		 * @param Amplitude Standard deviation of normally distributed noise or half the width of the interval
+		 * uniformly distributed noise is drawn from. The noise is centered around zero.
+		 * @param Seed Seed of the random number generator
+		*/
+		NoiseOperator(bool Gaussian, StreamOperatorBlock::DataType Amplitude, std::mt19937_64::result_type Seed = std::random_device{}())
+			: Gaussian(Gaussian), Amplitude(Amplitude), RandomEngine(Seed) {}
+
+		void Process(StreamOperatorBlock& Block) override;
+
+	private:
+		const bool Gaussian;
+		const StreamOperatorBlock::DataType Amplitude;
+		std::mt19937_64 RandomEngine;
+	};
+
+	/**
+	 * @brief Operator replacing each value by the mean of this value and its preceding values.
+	 * Keeps the last values of the previous block to average across block boundaries. Non-finite
+	 * values (NaN, infinity) only affect the means of the windows containing them.
+	*/
+	class MovingAverageOperator : public StreamOperatorBase
+	{
+	public:
+		MovingAverageOperator(size_t Length) noexcept : Length(Length) {}
+
+		void Process(StreamOperatorBlock& Block) override;
+
+	private:
+		/**
+		 * @brief Adds @p Value to or removes it from the current window.
+		 * @param Value Value entering or leaving the window
+		 * @param Add Pass true if @p Value enters the window, false if it leaves the window.
+		*/
+		void UpdateWindow(StreamOperatorBlock::DataType Value, bool Add) noexcept;
+
+		/**
+		 * @brief Calculates the mean of the current window as summing up its values would.
+		 * @param NumValues Number of values in the current window
+		 * @return Mean of the current window
+		*/
+		StreamOperatorBlock::DataType GetWindowMean(size_t NumValues) const noexcept;
+
+		const size_t Length;
+		std::vector<StreamOperatorBlock::DataType> History;		//!< Up to #Length - 1 values preceding the current block
+
+		/**
+		 * @brief Sum of the finite values in the current window. Infinite values and NaN are counted
+		 * separately, so that they do not affect the sum after they have left the window.
+		*/
+		StreamOperatorBlock::DataType WindowSum = 0;
+		size_t NumNaNsInWindow = 0;					//!< Number of NaN values in the current window
+		size_t NumPosInfsInWindow = 0;				//!< Number of positive infinite values in the current window
+		size_t NumNegInfsInWindow = 0;				//!< Number of negative infinite values in the current window
+	};
+
+	/**
+	 * @brief Operator keeping only every n-th sample. Counts samples across block boundaries.
+	*/
+	class DecimationOperator : public StreamOperatorBase
+	{
+	public:
+		DecimationOperator(size_t Factor) noexcept : Factor(Factor) {}
+
+		void Process(StreamOperatorBlock& Block) override;
+
+	private:
+		const size_t Factor;
+		size_t Phase = 0;			//!< Index of the next sample to process modulo #Factor
+	};
+
+	/**
+	 * @brief Operator replacing values by 1 or 0 depending on whether they exceed a level.
+	*/
+	class ThresholdOperator : public StreamOperatorBase
+	{
+	public:
+		ThresholdOperator(StreamOperatorBlock::DataType Level, bool TrueIfAbove) noexcept
+			: Level(Level), TrueIfAbove(TrueIfAbove) {}
+
+		void Process(StreamOperatorBlock& Block) override;
+
+	private:
+		const StreamOperatorBlock::DataType Level;
+		const bool TrueIfAbove;
+	};
+
+	/**
+	 * @brief Data class for @p StreamOperator
+	*/
+	class StreamOperatorData : public DynExp::ModuleDataBase
+	{
+	public:
+		StreamOperatorData() { Init(); }
+		virtual ~StreamOperatorData() = default;
+
+		auto& GetInputDataStreams() const noexcept { return InputDataStreams; }		//!< Getter for #InputDataStreams
+		auto& GetInputDataStreams() noexcept { return InputDataStreams; }			//!< Getter for #InputDataStreams
+		auto& GetOutputDataStreams() const noexcept { return OutputDataStreams; }	//!< Getter for #OutputDataStreams
+		auto& GetOutputDataStreams() noexcept { return OutputDataStreams; }			//!< Getter for #OutputDataStreams
+
+	private:
+		/**
+		 * @copydoc DynExp::ModuleDataBase::ResetImpl
+		*/
+		void ResetImpl(dispatch_tag<ModuleDataBase>) override final;
+
+		/**
+		 * @copydoc DynExp::ModuleDataBase::ResetImpl
+		*/
+		virtual void ResetImpl(dispatch_tag<StreamOperatorData>) {};
+
+		/**
+		 * @brief Called by @p ResetImpl(dispatch_tag<DynExp::ModuleDataBase>) overridden by this
+		 * class to initialize the data class instance. Currently, does not do anything.
+		*/
+		void Init();
+
+		/**
+		 * @brief Linked input data stream instruments whose samples are going to be processed
+		*/
+		DynExp::LinkedObjectWrapperContainerList<DynExpInstr::DataStreamInstrument> InputDataStreams;
+
+		/**
+		 * @brief Linked output data stream instruments to write the processed samples to
+		*/
+		DynExp::LinkedObjectWrapperContainerList<DynExpInstr::DataStreamInstrument> OutputDataStreams;
+	};
+
+	/**
+	 * @brief Parameter class for @p StreamOperator
+	*/
+	class StreamOperatorParams : public DynExp::ModuleParamsBase
+	{
+	public:
+		/**
+		 * @brief Determines how the samples of multiple input data streams are combined into a
+		 * single stream before the remaining operators are applied.
+		*/
+		enum class CombineModeType {
+			Sum,			//!< Add the values of the n-th samples of all input streams (times of the first stream).
+			Product,		//!< Multiply the values of the n-th samples of all input streams (times of the first stream).
+			Difference,		//!< Subtract the values of the n-th samples of all other input streams from the first one.
+			MergeByTime		//!< Interleave the samples of all input streams in order of their times.
+		};
+
+		/**
+		 * @brief Determines the output of the threshold operator.
+		*/
+		enum class ThresholdModeType {
+			Disabled,		//!< Do not apply a threshold.
+			Above,			//!< Replace values greater than or equal to the threshold level by 1 and others by 0.
+			Below			//!< Replace values less than the threshold level by 1 and others by 0.
+		};
+
+		/**
+		 * @brief Determines the distribution of the noise added by the noise operator.
+		*/
+		enum class NoiseModeType {
+			Disabled,		//!< Do not add noise.
+			Uniform,		//!< Add noise uniformly distributed in [-amplitude, amplitude].
+			Gaussian		//!< Add normally distributed noise with the amplitude as its standard deviation.
+		};
+
+		static Util::TextValueListType<CombineModeType> CombineModeTypeStrList();
+		static Util::TextValueListType<NoiseModeType> NoiseModeTypeStrList();
+		static Util::TextValueListType<ThresholdModeType> ThresholdModeTypeStrList();
+
+		/**
+		 * @brief Maximal moving average length and decimation factor. Keeps the operators' buffers
+		 * and the conversion of the parameters to @p size_t in a sane range.
+		*/
+		static constexpr ParamsConfigDialog::NumberType MaxOperatorLength = 1e6;
+
+		/**
+		 * @brief Maximal number of samples generated per second in source mode
+		*/
+		static constexpr ParamsConfigDialog::NumberType MaxSourceSampleRate = 1e8;
+
+		/**
+		 * @brief Constructs the parameters for a @p StreamOperator instance.
+		*/
+		StreamOperatorParams(DynExp::ItemIDType ID, const DynExp::DynExpCore& Core) : ModuleParamsBase(ID, Core) {}
+
+		virtual ~StreamOperatorParams() = default;
+
+		virtual const char* GetParamClassTag() const noexcept override { return "StreamOperatorParams"; }
+
+		/**
+		 * @brief Parameter for data stream instruments containing input samples. If no input data
+		 * stream is selected, the module acts as a source generating samples with value 0 at
+		 * #SourceSampleRate, which the operators then process (e.g. adding noise).
+		 * Refer to StreamOperatorData::InputDataStreams.
+		*/
+		ListParam<DynExp::ObjectLink<DynExpInstr::DataStreamInstrument>> InputDataStreams = { *this, GetCore().GetInstrumentManager(),
+			"InputDataStreams", "Input data stream instrument(s)", "Data stream instruments to be used as data sources. If none is selected, samples are generated.",
+			DynExpUI::Icons::Instrument, true };
+
+		/**
+		 * @brief Parameter for data stream instruments the processed samples are written to.
+		 * Refer to StreamOperatorData::OutputDataStreams.
+		*/
+		ListParam<DynExp::ObjectLink<DynExpInstr::DataStreamInstrument>> OutputDataStreams = { *this, GetCore().GetInstrumentManager(),
+			"OutputDataStreams", "Output data stream instrument(s)", "Data stream instruments to write the processed samples to (each receives the same samples)", DynExpUI::Icons::Instrument };
+
+		/**
+		 * @brief The operators are applied in the order of the following parameters. Each
+		 * operator left at its default value is skipped.
+		*/
+		Param<ParamsConfigDialog::NumberType> SourceSampleRate = { *this, "SourceSampleRate", "Source sample rate",
+			"Number of samples per second to generate if no input data stream is selected", true,
+			100, 1e-3, MaxSourceSampleRate, 1, 3 };
+		Param<CombineModeType> CombineMode = { *this, CombineModeTypeStrList(), "CombineMode", "Combination of inputs",
+			"Determines how the input streams are combined into one stream. Without effect for a single input stream.", true, CombineModeType::Sum };
+		Param<ParamsConfigDialog::NumberType> Gain = { *this, "Gain", "Gain",
+			"Factor to multiply all values with", true,
+			1, std::numeric_limits<ParamsConfigDialog::NumberType>::lowest(), std::numeric_limits<ParamsConfigDialog::NumberType>::max(), .1, 3 };
+		Param<ParamsConfigDialog::NumberType> Offset = { *this, "Offset", "Offset",
+			"Offset to add to all values after multiplying them with the gain", true,
+			0, std::numeric_limits<ParamsConfigDialog::NumberType>::lowest(), std::numeric_limits<ParamsConfigDialog::NumberType>::max(), .1, 3 };
+		Param<NoiseModeType> NoiseMode = { *this, NoiseModeTypeStrList(), "NoiseMode", "Noise",
+			"Determines the distribution of random numbers added to all values", true, NoiseModeType::Disabled };
+		Param<ParamsConfigDialog::NumberType> NoiseAmplitude = { *this, "NoiseAmplitude", "Noise amplitude",
+			"Half the width of the interval uniformly distributed noise is drawn from or standard deviation of normally distributed noise", true,
+			1, 0, std::numeric_limits<ParamsConfigDialog::NumberType>::max(), .1, 3 };
+		Param<ParamsConfigDialog::NumberType> MovingAverageLength = { *this, "MovingAverageLength", "Moving average length",
+			"Number of consecutive samples to average (1 to disable averaging)", true,
+			1, 1, MaxOperatorLength, 1, 0 };
+		Param<ParamsConfigDialog::NumberType> DecimationFactor = { *this, "DecimationFactor", "Decimation factor",
+			"Only every n-th sample is kept (1 to keep all samples)", true,
+			1, 1, MaxOperatorLength, 1, 0 };
+		Param<ThresholdModeType> ThresholdMode = { *this, ThresholdModeTypeStrList(), "ThresholdMode", "Threshold mode",
+			"Determines whether values are compared to a threshold level resulting in 1 or 0", true, ThresholdModeType::Disabled };
+		Param<ParamsConfigDialog::NumberType> ThresholdLevel = { *this, "ThresholdLevel", "Threshold level",
+			"Level values are compared to if a threshold mode is selected", true,
+			0, std::numeric_limits<ParamsConfigDialog::NumberType>::lowest(), std::numeric_limits<ParamsConfigDialog::NumberType>::max(), .1, 3 };
+
+	private:
+		/**
+		 * @copydoc DynExp::ParamsBase::ConfigureParamsImpl
+		*/
+		void ConfigureParamsImpl(dispatch_tag<ModuleParamsBase>) override final {}
+	};
+
+	/**
+	 * @brief Configurator class for @p StreamOperator
+	*/
+	class StreamOperatorConfigurator : public DynExp::ModuleConfiguratorBase
+	{
+	public:
+		using ObjectType = StreamOperator;
+		using ParamsType = StreamOperatorParams;
+
+		StreamOperatorConfigurator() = default;
+		virtual ~StreamOperatorConfigurator() = default;
+
+	private:
+		virtual DynExp::ParamsBasePtrType MakeParams(DynExp::ItemIDType ID, const DynExp::DynExpCore& Core) const override final { return DynExp::MakeParams<StreamOperatorConfigurator>(ID, Core); }
+	};
+
+	/**
+	 * @brief Module to process data stored in data stream instrument(s) with a chain of built-in
+	 * operators (combination of inputs, gain and offset, noise, moving average, decimation, threshold)
+	 * and to write the resulting data to other data stream instrument(s). New input samples are
+	 * processed in blocks. Without input data stream instruments, the module generates samples
+	 * to be processed by the operators instead (e.g. to generate noise).
+	*/
+	class StreamOperator : public DynExp::ModuleBase
+	{
+		/**
+		 * @brief Sample stream type expected for input (StreamOperatorData::InputDataStreams)
+		 * and output (StreamOperatorData::OutputDataStreams) data stream instruments.
+		*/
+		using SampleStreamType = DynExpInstr::CircularDataStreamBase;
+
+	public:
+		using ParamsType = StreamOperatorParams;								//!< @copydoc DynExp::Object::ParamsType
+		using ConfigType = StreamOperatorConfigurator;							//!< @copydoc DynExp::Object::ConfigType
+		using ModuleDataType = StreamOperatorData;								//!< @copydoc DynExp::ModuleBase::ModuleDataType
+
+		constexpr static auto Name() noexcept { return "Stream Operator"; }		//!< @copydoc DynExp::SerialCommunicationHardwareAdapter::Name
+		constexpr static auto Category() noexcept { return "I/O"; }				//!< @copydoc DynExp::ModuleBase::Category
+
+		/**
+		 * @copydoc DynExp::ModuleBase::ModuleBase
+		*/
+		StreamOperator(const std::thread::id OwnerThreadID, DynExp::ParamsBasePtrType&& Params)
+			: ModuleBase(OwnerThreadID, std::move(Params)) {}
+
+		virtual ~StreamOperator() = default;
+
+		virtual std::string GetName() const override { return Name(); }
+		virtual std::string GetCategory() const override { return Category(); }
+
+		bool TreatModuleExceptionsAsWarnings() const override { return false; }
+
+		std::chrono::milliseconds GetMainLoopDelay() const override final { return std::chrono::milliseconds(1); }
+
+		/**
+		 * @brief Combines the samples read from the input data streams into a single block.
+		 * @param CombineMode Determines how the samples are combined.
+		 * @param InputSamples Recent samples read from each input data stream
+		 * @param Block Block to store the combined samples in
+		 * @return Number of samples consumed from each input data stream. Samples which have not
+		 * been consumed are passed to this function again in the next call.
+		*/
+		static std::vector<size_t> Combine(StreamOperatorParams::CombineModeType CombineMode,
+			const std::vector<DynExpInstr::DataStreamBase::BasicSampleListType>& InputSamples, StreamOperatorBlock& Block);
+
+	private:
+		Util::DynExpErrorCodes::DynExpErrorCodes ModuleMainLoop(DynExp::ModuleInstance& Instance) override final;
+
+		/**
+		 * @copydoc DynExp::Object::ResetImpl
+		*/
+		void ResetImpl(dispatch_tag<ModuleBase>) override final;
+
+		/**
+		 * @brief Fills @p Block with samples of value 0 at StreamOperatorParams::SourceSampleRate up to
+		 * the current time if no input data stream instruments are selected.
+		 * @param Block Block to store the generated samples in
+		*/
+		void GenerateSourceSamples(StreamOperatorBlock& Block);
+
+		/** @name Events
+		 * Event functions running in the module thread.
+		*/
+		///@{
+		void OnInit(DynExp::ModuleInstance* Instance) const override final;
+		void OnExit(DynExp::ModuleInstance* Instance) const override final;
+		///@}
+
+		mutable StreamOperatorParams::CombineModeType CombineMode = StreamOperatorParams::CombineModeType::Sum;	//!< Copy of StreamOperatorParams::CombineMode
+
+		/**
+		 * @brief Operators to apply to the combined samples in this order
+		*/
+		mutable std::vector<std::unique_ptr<StreamOperatorBase>> Operators;
+
+		/**
+		 * @brief For each input data stream, the sample ID up to which samples have been consumed
+		*/
+		mutable std::vector<size_t> LastConsumedSampleIDsPerInputStream;
+
+		mutable StreamOperatorBlock::DataType SourceSampleRate = 0;			//!< Copy of StreamOperatorParams::SourceSampleRate
+		mutable std::chrono::steady_clock::time_point SourceStartTime;		//!< Time the first sample has been generated at in source mode
+		mutable size_t NumSourceSamplesGenerated = 0;						//!< Number of samples generated so far in source mode
+
+		/**
+		 * @brief Counts how often StreamOperator::ModuleMainLoop() contiguously failed due
+		 * to an exception of type Util::TimeoutException.
+		*/
+		size_t NumFailedUpdateAttempts = 0;
+	};
+}
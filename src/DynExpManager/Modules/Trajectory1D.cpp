@@ -6,6 +6,147 @@
 
 namespace DynExpModule
 {
+	std::string Trajectory1DScheduler::JitterStatsType::ToStr() const
+	{
+		const auto ToMicroseconds = [](std::chrono::nanoseconds Time) { return std::chrono::duration<double, std::micro>(Time).count(); };
+
+		std::stringstream Stream;
+		Stream << std::fixed << std::setprecision(1) << "Jitter of " << NumSamples << " samples: mean " << ToMicroseconds(Mean)
+			<< " us, RMS " << ToMicroseconds(RMS) << " us, max " << ToMicroseconds(Max) << " us";
+
+		return Stream.str();
+	}
+
+	void Trajectory1DScheduler::Start(ScheduleType&& Schedule, ClockType::duration RepetitionPeriod, size_t RepeatCount, MoveFuncType MoveFunc)
+	{
+		Stop();
+
+		this->Schedule = std::move(Schedule);
+		this->RepetitionPeriod = RepetitionPeriod;
+		this->RepeatCount = RepeatCount;
+		this->MoveFunc = std::move(MoveFunc);
+
+		Exception = nullptr;
+		NumSamplesWritten = 0;
+		CurrentRepetition = 0;
+		{
+			std::lock_guard<decltype(Mutex)> lock(Mutex);
+
+			NumJitterSamples = 0;
+			JitterSum = 0;
+			JitterSquaredSum = 0;
+			MaxJitter = {};
+		}
+
+		Running = true;
+		SchedulerThreadHandle = std::thread(&Trajectory1DScheduler::SchedulerThread, this);
+	}
+
+	void Trajectory1DScheduler::Stop()
+	{
+		if (!SchedulerThreadHandle.joinable())
+			return;
+
+		{
+			std::lock_guard<decltype(Mutex)> lock(Mutex);
+			StopRequested = true;
+		}
+		StopCV.notify_one();
+
+		SchedulerThreadHandle.join();
+		StopRequested = false;
+	}
+
+	Trajectory1DScheduler::JitterStatsType Trajectory1DScheduler::GetJitterStats() const
+	{
+		std::lock_guard<decltype(Mutex)> lock(Mutex);
+
+		if (!NumJitterSamples)
+			return {};
+
+		const auto Mean = JitterSum / NumJitterSamples;
+		const auto RMS = std::sqrt(JitterSquaredSum / NumJitterSamples);
+
+		return { NumJitterSamples, std::chrono::nanoseconds(Util::NumToT<std::chrono::nanoseconds::rep>(Mean)),
+			std::chrono::nanoseconds(Util::NumToT<std::chrono::nanoseconds::rep>(RMS)), std::chrono::duration_cast<std::chrono::nanoseconds>(MaxJitter) };
+	}
+
+	void Trajectory1DScheduler::RethrowIfFailed() const
+	{
+		if (Exception)
+			std::rethrow_exception(Exception);
+	}
+
+	void Trajectory1DScheduler::SchedulerThread() noexcept
+	{
+		try
+		{
+			const auto StartTime = ClockType::now();
+
+			for (size_t Repetition = 0; Repetition < RepeatCount; ++Repetition)
+			{
+				const auto RepetitionStartTime = StartTime + RepetitionPeriod * static_cast<ClockType::rep>(Repetition);
+				CurrentRepetition = Repetition;
+				NumSamplesWritten = 0;
+
+				for (const auto& Sample : Schedule)
+				{
+					const auto ScheduledTime = RepetitionStartTime + Sample.Time;
+					if (!WaitUntil(ScheduledTime))
+					{
+						Running = false;
+						return;
+					}
+
+					const auto Jitter = ClockType::now() - ScheduledTime;
+					MoveFunc(Sample.Position);
+					++NumSamplesWritten;
+
+					std::lock_guard<decltype(Mutex)> lock(Mutex);
+					const auto JitterNs = std::chrono::duration<double, std::nano>(Jitter).count();
+					++NumJitterSamples;
+					JitterSum += JitterNs;
+					JitterSquaredSum += JitterNs * JitterNs;
+					MaxJitter = std::max(MaxJitter, Jitter);
+				}
+			}
+
+			// Finish at the end of the last repetition such that retriggering keeps the period.
+			WaitUntil(StartTime + RepetitionPeriod * static_cast<ClockType::rep>(RepeatCount));
+		}
+		catch (...)
+		{
+			Exception = std::current_exception();
+		}
+
+		Running = false;
+	}
+
+	bool Trajectory1DScheduler::WaitUntil(ClockType::time_point TimePoint)
+	{
+		{
+			std::unique_lock<decltype(Mutex)> lock(Mutex);
+
+			const auto WakeUpTime = TimePoint - SpinDuration;
+			if (WakeUpTime > ClockType::now())
+			{
+				if (StopCV.wait_until(lock, WakeUpTime, [this]() { return StopRequested; }))
+					return false;
+
+				// Busy-wait longer if the operating system wakes up the thread too late.
+				const auto Oversleep = ClockType::now() - WakeUpTime;
+				SpinDuration = std::clamp<ClockType::duration>(2 * Oversleep, SpinDuration, MaxSpinDuration);
+			}
+			else if (StopRequested)
+				return false;
+		}
+
+		while (ClockType::now() < TimePoint)
+			std::this_thread::yield();
+
+		return true;
+	}
+
 	Trajectory1DWidget::Trajectory1DWidget(Trajectory1D& Owner, QModuleWidget* parent) : QModuleWidget(Owner, parent)
 	{
 		ui.setupUi(this);
@@ -21,6 +162,8 @@ namespace DynExpModule
 		TriggerMode = TriggerModeType::Manual;
 		RepeatCount = 1;
 		DwellTime = std::chrono::milliseconds(100);
+		PlaybackMode = PlaybackModeType::ModuleLoop;
+		HardwareTimed = false;
 
 		LastWrittenSampleID = 0;
 		Samples.clear();
@@ -29,6 +172,21 @@ namespace DynExpModule
 		CurrentRepeatCount = 0;
 		Ready = false;
 		TrajectoryStartedTime = {};
+		RepetitionPeriod = {};
+		TimingInfo.clear();
+	}
+
+	std::chrono::steady_clock::duration Trajectory1DData::CalcRepetitionPeriod() const
+	{
+		if (Samples.empty())
+			return {};
+
+		const auto FirstTime = std::chrono::duration<double>(Samples.front().Time);
+		const auto LastTime = std::chrono::duration<double>(Samples.back().Time);
+		const auto MeanInterval = Samples.size() > 1 && LastTime > FirstTime ?
+			(LastTime - FirstTime) / static_cast<double>(Samples.size() - 1) : std::chrono::duration<double>(DwellTime);
+
+		return std::chrono::duration_cast<std::chrono::steady_clock::duration>(LastTime + MeanInterval);
 	}
 
 	Util::TextValueListType<Trajectory1DData::TriggerModeType> Trajectory1DParams::TriggerModeTypeStrList()
@@ -43,6 +201,16 @@ namespace DynExpModule
 		return List;
 	}
 
+	Util::TextValueListType<Trajectory1DData::PlaybackModeType> Trajectory1DParams::PlaybackModeTypeStrList()
+	{
+		Util::TextValueListType<Trajectory1DData::PlaybackModeType> List = {
+			{ "Write samples in the module's main loop (millisecond resolution)", Trajectory1DData::PlaybackModeType::ModuleLoop },
+			{ "Precompute trajectory and play back hardware-timed or by a dedicated scheduler", Trajectory1DData::PlaybackModeType::Precomputed }
+		};
+
+		return List;
+	}
+
 	Util::DynExpErrorCodes::DynExpErrorCodes Trajectory1D::ModuleMainLoop(DynExp::ModuleInstance& Instance)
 	{
 		try
@@ -65,6 +233,7 @@ namespace DynExpModule
 
 	void Trajectory1D::ResetImpl(dispatch_tag<QModuleBase>)
 	{
+		Scheduler.Stop();
 		NumFailedUpdateAttempts = 0;
 	}
 
@@ -96,6 +265,10 @@ namespace DynExpModule
 		Widget->GetUI().LRepetition->setText(QString("Repetition ") + QString::number(ModuleData->GetCurrentRepeatCount() + 1)
 			+ " / " + QString::number(ModuleData->GetRepeatCount()));
 
+		Widget->GetUI().LTiming->setVisible(!ModuleData->GetTimingInfo().empty());
+		Widget->GetUI().LTimingInfo->setVisible(!ModuleData->GetTimingInfo().empty());
+		Widget->GetUI().LTimingInfo->setText(QString::fromStdString(ModuleData->GetTimingInfo()));
+
 		Widget->GetUI().BStart->setEnabled(!ModuleData->IsReady());
 		Widget->GetUI().BStop->setEnabled(ModuleData->IsReady());
 		Widget->GetUI().BForce->setEnabled(ModuleData->IsReady());
@@ -130,6 +303,7 @@ namespace DynExpModule
 				Trigger(ModuleData);
 				break;
 			case Trajectory1DData::TriggerModeType::Manual:
+				Scheduler.Stop();
 				ModuleData->SetCurrentPlaybackPos(0);
 				ModuleData->SetCurrentRepeatCount(0);
 				break;
@@ -141,17 +315,23 @@ namespace DynExpModule
 
 	void Trajectory1D::Move(Util::SynchronizedPointer<ModuleDataType>& ModuleData)
 	{
+		if (ModuleData->GetPlaybackMode() == Trajectory1DData::PlaybackModeType::Precomputed)
+		{
+			MovePrecomputed(ModuleData);
+			return;
+		}
+
 		if (!ModuleData->IsReady() || !ModuleData->GetCurrentPlaybackPos())
 			return;
 
-		std::chrono::system_clock::duration TimeEllapsed;
+		std::chrono::steady_clock::duration TimeEllapsed;
 		if (ModuleData->GetCurrentPlaybackPos() == 1)
 		{
-			ModuleData->SetTrajectoryStartedTime(std::chrono::system_clock::now());
+			ModuleData->SetTrajectoryStartedTime(std::chrono::steady_clock::now());
 			TimeEllapsed = std::chrono::milliseconds(0);
 		}
 		else
-			TimeEllapsed = std::chrono::system_clock::now() - ModuleData->GetTrajectoryStartedTime();
+			TimeEllapsed = std::chrono::steady_clock::now() - ModuleData->GetTrajectoryStartedTime();
 
 		const auto& Samples = ModuleData->GetSamples();
 		for (size_t i = ModuleData->GetCurrentPlaybackPos() - 1; i < Samples.size(); ++i)
@@ -178,22 +358,119 @@ namespace DynExpModule
 			if (ModuleData->GetCurrentRepeatCount() < ModuleData->GetRepeatCount())
 				ModuleData->SetCurrentPlaybackPos(1);
 			else
+				FinishPlayback(ModuleData);
+		}
+	}
+
+	void Trajectory1D::MovePrecomputed(Util::SynchronizedPointer<ModuleDataType>& ModuleData)
+	{
+		if (!ModuleData->IsReady() || !ModuleData->GetCurrentPlaybackPos())
+			return;
+
+		// Playback position 1 indicates a (re-)trigger.
+		if (ModuleData->GetCurrentPlaybackPos() == 1)
+		{
+			StartPrecomputed(ModuleData);
+			return;
+		}
+
+		bool Finished = false;
+		if (ModuleData->IsHardwareTimed())
+		{
+			// The output does not report its progress. So, estimate it from the time ellapsed since starting it.
+			const auto TimeEllapsed = std::chrono::steady_clock::now() - ModuleData->GetTrajectoryStartedTime();
+			const auto RepetitionPeriod = ModuleData->GetRepetitionPeriod();
+			const auto Repetition = std::min(Util::NumToT<size_t>(TimeEllapsed / RepetitionPeriod), ModuleData->GetRepeatCount() - 1);
+			const auto TimeInRepetition = std::chrono::duration<double>(TimeEllapsed - RepetitionPeriod * static_cast<std::chrono::steady_clock::rep>(Repetition)).count();
+
+			const auto& Samples = ModuleData->GetSamples();
+			const auto NumSamplesWritten = std::upper_bound(Samples.cbegin(), Samples.cend(), TimeInRepetition,
+				[](const DynExpInstr::BasicSample::DataType Time, const DynExpInstr::BasicSample& Sample) { return Time < Sample.Time; }) - Samples.cbegin();
+
+			ModuleData->SetCurrentRepeatCount(Repetition);
+			ModuleData->SetCurrentPlaybackPos(std::max(size_t(2), Util::NumToT<size_t>(NumSamplesWritten) + 1));
+
+			Finished = TimeEllapsed >= RepetitionPeriod * static_cast<std::chrono::steady_clock::rep>(ModuleData->GetRepeatCount()) &&
+				ModuleData->GetHardwareOutput()->HasFinished() != Util::OptionalBool::Values::False;
+		}
+		else
+		{
+			ModuleData->SetCurrentRepeatCount(Scheduler.GetCurrentRepetition());
+			ModuleData->SetCurrentPlaybackPos(std::max(size_t(2), Scheduler.GetNumSamplesWritten() + 1));
+
+			if (!Scheduler.IsRunning())
 			{
-				switch (ModuleData->GetTriggerMode())
-				{
-				case Trajectory1DData::TriggerModeType::Continuous:
-					Trigger(ModuleData);
-					break;
-				case Trajectory1DData::TriggerModeType::Manual: [[fallthrough]];
-				case Trajectory1DData::TriggerModeType::OnStreamChanged:
-					ModuleData->SetCurrentPlaybackPos(0);
-					ModuleData->SetCurrentRepeatCount(0);
-					break;
-				default:
-					ModuleData->SetReady(false);	// Do not call Stop() to let the positioner complete its motion.
-				}
+				Finished = true;
+				ModuleData->SetTimingInfo(Scheduler.GetJitterStats().ToStr());
+				Scheduler.RethrowIfFailed();
+
+				if (ModuleData->GetTriggerMode() != Trajectory1DData::TriggerModeType::Continuous)
+					Util::EventLog().Log("Trajectory playback finished. " + ModuleData->GetTimingInfo() + ".");
 			}
 		}
+
+		if (Finished)
+		{
+			ModuleData->SetCurrentRepeatCount(ModuleData->GetRepeatCount());
+			FinishPlayback(ModuleData);
+		}
+	}
+
+	void Trajectory1D::StartPrecomputed(Util::SynchronizedPointer<ModuleDataType>& ModuleData)
+	{
+		Scheduler.Stop();
+
+		const auto& Samples = ModuleData->GetSamples();
+		const auto RepetitionPeriod = ModuleData->CalcRepetitionPeriod();
+		const auto RepeatCount = ModuleData->GetRepeatCount();
+
+		if (ModuleData->IsHardwareTimed())
+		{
+			const auto& HardwareOutput = ModuleData->GetHardwareOutput();
+			const auto SamplingRate = HardwareOutput->GetNumericSampleStreamParams().SamplingRate;
+			auto Waveform = ResampleTrajectory(Samples, RepetitionPeriod, RepeatCount, SamplingRate);
+
+			ModuleData->SetTimingInfo("Hardware-timed: " + Util::ToStr(Waveform.size()) + " samples at " + Util::ToStr(SamplingRate) + " samples/s");
+
+			HardwareOutput->Stop();
+			HardwareOutput->SetArbitraryFunction(std::move(Waveform), true);
+		}
+		else
+		{
+			Trajectory1DScheduler::ScheduleType Schedule;
+			Schedule.reserve(Samples.size());
+			for (const auto& Sample : Samples)
+				Schedule.push_back({ std::chrono::duration_cast<Trajectory1DScheduler::ClockType::duration>(std::chrono::duration<double>(Sample.Time)),
+					Sample.Value });
+
+			// The scheduler thread must not access ModuleData. Stopping the scheduler before unlocking the positioner keeps the pointer valid.
+			Scheduler.Start(std::move(Schedule), RepetitionPeriod, RepeatCount,
+				[PositionerStage = ModuleData->GetPositionerStage().get()](DynExpInstr::BasicSample::DataType Position) {
+					PositionerStage->MoveAbsolute(Position);
+			});
+		}
+
+		ModuleData->SetTrajectoryStartedTime(std::chrono::steady_clock::now());
+		ModuleData->SetRepetitionPeriod(RepetitionPeriod);
+		ModuleData->SetCurrentPlaybackPos(2);
+		ModuleData->SetCurrentRepeatCount(0);
+	}
+
+	void Trajectory1D::FinishPlayback(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const
+	{
+		switch (ModuleData->GetTriggerMode())
+		{
+		case Trajectory1DData::TriggerModeType::Continuous:
+			Trigger(ModuleData);
+			break;
+		case Trajectory1DData::TriggerModeType::Manual: [[fallthrough]];
+		case Trajectory1DData::TriggerModeType::OnStreamChanged:
+			ModuleData->SetCurrentPlaybackPos(0);
+			ModuleData->SetCurrentRepeatCount(0);
+			break;
+		default:
+			ModuleData->SetReady(false);	// Do not call Stop() to let the positioner complete its motion.
+		}
 	}
 
 	void Trajectory1D::Start(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const
@@ -211,6 +488,10 @@ namespace DynExpModule
 
 	void Trajectory1D::Stop(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const
 	{
+		Scheduler.Stop();
+		if (ModuleData->IsHardwareTimed())
+			ModuleData->GetHardwareOutput()->Stop();
+
 		ModuleData->GetPositionerStage()->StopMotion();
 		ModuleData->SetReady(false);
 	}
@@ -226,6 +507,35 @@ namespace DynExpModule
 		}
 	}
 
+	DynExpInstr::DataStreamBase::BasicSampleListType Trajectory1D::ResampleTrajectory(const DynExpInstr::DataStreamBase::BasicSampleListType& Samples,
+		std::chrono::steady_clock::duration RepetitionPeriod, size_t RepeatCount, double SamplingRate)
+	{
+		if (Samples.empty() || SamplingRate <= 0)
+			throw Util::InvalidArgException("A trajectory can only be resampled if it contains samples and if the sampling rate is positive.");
+
+		const auto NumSamplesPerRepetition = std::max(size_t(1),
+			Util::NumToT<size_t>(std::ceil(std::chrono::duration<double>(RepetitionPeriod).count() * SamplingRate)));
+
+		std::vector<DynExpInstr::BasicSample::DataType> Positions;
+		Positions.reserve(NumSamplesPerRepetition);
+		for (size_t i = 0, j = 0; i < NumSamplesPerRepetition; ++i)
+		{
+			const auto Time = i / SamplingRate;
+			while (j + 1 < Samples.size() && Samples[j + 1].Time <= Time)
+				++j;
+
+			Positions.push_back(Samples[j].Value);
+		}
+
+		DynExpInstr::DataStreamBase::BasicSampleListType Waveform;
+		Waveform.reserve(NumSamplesPerRepetition * RepeatCount);
+		for (size_t Repetition = 0; Repetition < RepeatCount; ++Repetition)
+			for (size_t i = 0; i < NumSamplesPerRepetition; ++i)
+				Waveform.emplace_back(Positions[i], (Repetition * NumSamplesPerRepetition + i) / SamplingRate);
+
+		return Waveform;
+	}
+
 	void Trajectory1D::OnInit(DynExp::ModuleInstance* Instance) const
 	{
 		StartEvent::Register(*this, &Trajectory1D::OnStart);
@@ -239,10 +549,24 @@ namespace DynExpModule
 		Instance->LockObject(ModuleParams->PositionerStage, ModuleData->GetPositionerStage());
 		if (ModuleParams->Communicator.ContainsID())
 			Instance->LockObject(ModuleParams->Communicator, ModuleData->GetCommunicator());
+		if (ModuleParams->HardwareOutput.ContainsID())
+			Instance->LockObject(ModuleParams->HardwareOutput, ModuleData->GetHardwareOutput());
 
 		ModuleData->SetTriggerMode(ModuleParams->TriggerMode);
 		ModuleData->SetRepeatCount(std::max(static_cast<size_t>(1), Util::NumToT<size_t>(ModuleParams->RepeatCount)));
 		ModuleData->SetDwellTime(std::chrono::milliseconds(Util::NumToT<std::chrono::milliseconds::rep>(std::max(1.0, ModuleParams->DwellTime.Get()))));
+		ModuleData->SetPlaybackMode(ModuleParams->PlaybackMode);
+
+		if (ModuleData->GetPlaybackMode() == Trajectory1DData::PlaybackModeType::Precomputed && ModuleData->GetHardwareOutput().valid())
+		{
+			const auto& HardwareOutput = ModuleData->GetHardwareOutput();
+			ModuleData->SetHardwareTimed(HardwareOutput->GetWaveformCaps().Test(DynExpInstr::FunctionGenerator::WaveformCapsType::UserDefined) &&
+				HardwareOutput->GetNumericSampleStreamParams().SamplingRate > 0);
+
+			if (!ModuleData->IsHardwareTimed())
+				Util::EventLog().Log("The selected output of module \"" + GetObjectName() + "\" cannot generate hardware-timed arbitrary waveforms. "
+					"Precomputed trajectories are played back by a software scheduler instead.", Util::ErrorType::Warning);
+		}
 
 		ModuleData->SetReady(ModuleData->GetTriggerMode() != Trajectory1DData::TriggerModeType::ManualOnce);
 	}
@@ -256,6 +580,7 @@ namespace DynExpModule
 		Instance->UnlockObject(ModuleData->GetTrajectoryDataInstr());
 		Instance->UnlockObject(ModuleData->GetPositionerStage());
 		Instance->UnlockObject(ModuleData->GetCommunicator());
+		Instance->UnlockObject(ModuleData->GetHardwareOutput());
 
 		StartEvent::Deregister(*this);
 		StopEvent::Deregister(*this);
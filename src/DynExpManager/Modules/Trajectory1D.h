@@ -12,6 +12,7 @@
 #include "DynExpCore.h"
 #include "../MetaInstruments/Stage.h"
 #include "../MetaInstruments/DataStreamInstrument.h"
+#include "../MetaInstruments/AnalogOut.h"
 #include "../Instruments/InterModuleCommunicator.h"
 
 #include "CommonModuleEvents.h"
@@ -39,10 +40,113 @@ namespace DynExpModule
 		Ui::Trajectory1D ui;
 	};
 
+	/**
+	 * @brief Plays back a precomputed trajectory on a dedicated thread writing each sample at its
+	 * scheduled time independent of the module's main loop delay. The thread sleeps until shortly
+	 * before a sample is due and busy-waits for the remaining time. The busy-waiting duration adapts
+	 * to the accuracy with which the operating system wakes up sleeping threads. The delay between the
+	 * scheduled time of a sample and the time it is actually handed to the positioner (jitter) is
+	 * recorded. It does not include the time the positioner needs to process the command.
+	*/
+	class Trajectory1DScheduler : public Util::INonCopyable
+	{
+	public:
+		using ClockType = std::chrono::steady_clock;
+
+		/**
+		 * @brief Function moving the positioner to the given position. It is called on the scheduler thread.
+		*/
+		using MoveFuncType = std::function<void(DynExpInstr::BasicSample::DataType Position)>;
+
+		/**
+		 * @brief Sample of a precomputed trajectory
+		*/
+		struct ScheduledSampleType
+		{
+			ClockType::duration Time;						//!< Time relative to the beginning of the repetition
+			DynExpInstr::BasicSample::DataType Position;	//!< Position to move to
+		};
+
+		using ScheduleType = std::vector<ScheduledSampleType>;
+
+		/**
+		 * @brief Statistics of the delay between the scheduled and the actual time of writing samples
+		*/
+		struct JitterStatsType
+		{
+			std::string ToStr() const;		//!< Returns a human-readable summary of the statistics.
+
+			size_t NumSamples = 0;			//!< Number of samples written
+			std::chrono::nanoseconds Mean{};
+			std::chrono::nanoseconds RMS{};
+			std::chrono::nanoseconds Max{};
+		};
+
+		static constexpr std::chrono::microseconds InitialSpinDuration{ 1000 };	//!< Initial value of #SpinDuration
+		static constexpr std::chrono::microseconds MaxSpinDuration{ 20000 };		//!< Maximal value of #SpinDuration
+
+		Trajectory1DScheduler() = default;
+		~Trajectory1DScheduler() { Stop(); }
+
+		/**
+		 * @brief Starts playing back a trajectory. Stops a running playback before.
+		 * @param Schedule Samples to write in ascending order of their times
+		 * @param RepetitionPeriod Time between the beginnings of consecutive repetitions
+		 * @param RepeatCount Number of times to play back @p Schedule
+		 * @param MoveFunc @copybrief MoveFuncType
+		*/
+		void Start(ScheduleType&& Schedule, ClockType::duration RepetitionPeriod, size_t RepeatCount, MoveFuncType MoveFunc);
+
+		void Stop();	//!< Aborts the playback and waits for the scheduler thread to terminate.
+
+		bool IsRunning() const noexcept { return Running; }									//!< Returns whether a playback is in progress.
+		size_t GetNumSamplesWritten() const noexcept { return NumSamplesWritten; }			//!< Returns the number of samples written during the current repetition.
+		size_t GetCurrentRepetition() const noexcept { return CurrentRepetition; }			//!< Returns the zero-based index of the current repetition.
+		JitterStatsType GetJitterStats() const;												//!< Returns the jitter statistics of the current or last playback.
+
+		/**
+		 * @brief Rethrows the exception which has terminated the last playback if @p MoveFunc has thrown one.
+		 * Only call this function if IsRunning() returns false.
+		*/
+		void RethrowIfFailed() const;
+
+	private:
+		void SchedulerThread() noexcept;		//!< Scheduler thread's main function
+
+		/**
+		 * @brief Blocks until @p TimePoint.
+		 * @param TimePoint Time point to wait for
+		 * @return Returns false if stopping the playback has been requested while waiting, true otherwise.
+		*/
+		bool WaitUntil(ClockType::time_point TimePoint);
+
+		ScheduleType Schedule;
+		ClockType::duration RepetitionPeriod{};
+		size_t RepeatCount = 1;
+		MoveFuncType MoveFunc;
+
+		std::atomic<bool> Running = false;
+		std::atomic<size_t> NumSamplesWritten = 0;
+		std::atomic<size_t> CurrentRepetition = 0;
+		std::exception_ptr Exception;								//!< Exception thrown by @p MoveFunc. Only accessed if #Running is false.
+
+		ClockType::duration SpinDuration = InitialSpinDuration;		//!< Time to busy-wait before a sample is due. Only accessed by the scheduler thread.
+		size_t NumJitterSamples = 0;								//!< Synchronized by #Mutex.
+		double JitterSum = 0;										//!< Sum of jitters in ns. Synchronized by #Mutex.
+		double JitterSquaredSum = 0;								//!< Sum of squared jitters in ns^2. Synchronized by #Mutex.
+		ClockType::duration MaxJitter{};							//!< Synchronized by #Mutex.
+
+		bool StopRequested = false;									//!< Indicates that the playback should be aborted. Synchronized by #Mutex.
+		mutable std::mutex Mutex;									//!< Mutex for the jitter statistics, #StopRequested and #StopCV
+		std::condition_variable StopCV;								//!< Wakes up the scheduler thread if stopping has been requested.
+		std::thread SchedulerThreadHandle;
+	};
+
 	class Trajectory1DData : public DynExp::QModuleDataBase
 	{
 	public:
 		enum TriggerModeType { Continuous, ManualOnce, Manual, OnStreamChanged };
+		enum PlaybackModeType { ModuleLoop, Precomputed };
 
 		Trajectory1DData() { Init(); }
 		virtual ~Trajectory1DData() = default;
@@ -50,6 +154,7 @@ namespace DynExpModule
 		auto& GetTrajectoryDataInstr() { return TrajectoryDataInstr; }
 		auto& GetPositionerStage() { return PositionerStage; }
 		auto& GetCommunicator() { return Communicator; }
+		auto& GetHardwareOutput() { return HardwareOutput; }
 
 		auto GetTriggerMode() const noexcept { return TriggerMode; }
 		void SetTriggerMode(TriggerModeType TriggerMode) noexcept { this->TriggerMode = TriggerMode; }
@@ -57,6 +162,10 @@ namespace DynExpModule
 		void SetRepeatCount(size_t RepeatCount) noexcept { this->RepeatCount = RepeatCount; }
 		auto GetDwellTime() const noexcept { return DwellTime; }
 		void SetDwellTime(std::chrono::milliseconds DwellTime) noexcept { this->DwellTime = DwellTime; }
+		auto GetPlaybackMode() const noexcept { return PlaybackMode; }
+		void SetPlaybackMode(PlaybackModeType PlaybackMode) noexcept { this->PlaybackMode = PlaybackMode; }
+		bool IsHardwareTimed() const noexcept { return HardwareTimed; }
+		void SetHardwareTimed(bool HardwareTimed) noexcept { this->HardwareTimed = HardwareTimed; }
 
 		auto GetLastWrittenSampleID() const noexcept { return LastWrittenSampleID; }
 		void SetLastWrittenSampleID(size_t LastWrittenSampleID) noexcept { this->LastWrittenSampleID = LastWrittenSampleID; }
@@ -72,7 +181,19 @@ namespace DynExpModule
 		auto IsReady() const noexcept { return Ready; }
 		void SetReady(bool Ready) noexcept { this->Ready = Ready; }
 		auto GetTrajectoryStartedTime() const noexcept { return TrajectoryStartedTime; }
-		void SetTrajectoryStartedTime(std::chrono::time_point<std::chrono::system_clock> TrajectoryStartedTime) noexcept { this->TrajectoryStartedTime = TrajectoryStartedTime; }
+		void SetTrajectoryStartedTime(std::chrono::steady_clock::time_point TrajectoryStartedTime) noexcept { this->TrajectoryStartedTime = TrajectoryStartedTime; }
+		auto GetRepetitionPeriod() const noexcept { return RepetitionPeriod; }
+		void SetRepetitionPeriod(std::chrono::steady_clock::duration RepetitionPeriod) noexcept { this->RepetitionPeriod = RepetitionPeriod; }
+		const auto& GetTimingInfo() const noexcept { return TimingInfo; }
+		void SetTimingInfo(std::string TimingInfo) { this->TimingInfo = std::move(TimingInfo); }
+
+		/**
+		 * @brief Determines the time between the beginnings of consecutive repetitions of the trajectory.
+		 * This is the time of the last sample plus the mean time between samples. The next repetition
+		 * continues as if the trajectory was periodic.
+		 * @return Duration of one repetition of the trajectory
+		*/
+		std::chrono::steady_clock::duration CalcRepetitionPeriod() const;
 
 	private:
 		void ResetImpl(dispatch_tag<QModuleDataBase>) override final;
@@ -83,10 +204,13 @@ namespace DynExpModule
 		DynExp::LinkedObjectWrapperContainer<DynExpInstr::DataStreamInstrument> TrajectoryDataInstr;
 		DynExp::LinkedObjectWrapperContainer<DynExpInstr::PositionerStage> PositionerStage;
 		DynExp::LinkedObjectWrapperContainer<DynExpInstr::InterModuleCommunicator> Communicator;
+		DynExp::LinkedObjectWrapperContainer<DynExpInstr::AnalogOut> HardwareOutput;
 
 		TriggerModeType TriggerMode = TriggerModeType::Manual;
 		size_t RepeatCount = 1;
 		std::chrono::milliseconds DwellTime = std::chrono::milliseconds(100);
+		PlaybackModeType PlaybackMode = PlaybackModeType::ModuleLoop;
+		bool HardwareTimed = false;		//!< Indicates whether precomputed trajectories are played back by #HardwareOutput.
 
 		size_t LastWrittenSampleID = 0;
 		DynExpInstr::DataStreamBase::BasicSampleListType Samples;
@@ -94,13 +218,16 @@ namespace DynExpModule
 		size_t CurrentPlaybackPos = 0;	//!< 0 means waiting for trigger. Values > 0 mean running. They indicate the sample to be written next.
 		size_t CurrentRepeatCount = 0;
 		bool Ready = false;				//!< Running (not necessarily triggered yet) if true.
-		std::chrono::time_point<std::chrono::system_clock> TrajectoryStartedTime;
+		std::chrono::steady_clock::time_point TrajectoryStartedTime;
+		std::chrono::steady_clock::duration RepetitionPeriod{};		//!< Repetition period of the running precomputed playback
+		std::string TimingInfo;										//!< Timing information about the last precomputed playback
 	};
 
 	class Trajectory1DParams : public DynExp::QModuleParamsBase
 	{
 	public:
 		static Util::TextValueListType<Trajectory1DData::TriggerModeType> TriggerModeTypeStrList();
+		static Util::TextValueListType<Trajectory1DData::PlaybackModeType> PlaybackModeTypeStrList();
 
 		Trajectory1DParams(DynExp::ItemIDType ID, const DynExp::DynExpCore& Core) : QModuleParamsBase(ID, Core) {}
 		virtual ~Trajectory1DParams() = default;
@@ -113,6 +240,8 @@ namespace DynExpModule
 			"PositionerStage", "Positioner", "Underlying positioner to be controlled by this module", DynExpUI::Icons::Instrument };
 		Param<DynExp::ObjectLink<DynExpInstr::InterModuleCommunicator>> Communicator = { *this, GetCore().GetInstrumentManager(),
 			"InterModuleCommunicator", "Inter-module communicator", "Inter-module communicator to control this module with", DynExpUI::Icons::Instrument, true };
+		Param<DynExp::ObjectLink<DynExpInstr::AnalogOut>> HardwareOutput = { *this, GetCore().GetInstrumentManager(),
+			"HardwareOutput", "Hardware-timed output", "Analog output which generates precomputed trajectories as hardware-clocked arbitrary waveforms (positions are written without conversion). If not selected or if the output is not hardware-timed, a software scheduler is used.", DynExpUI::Icons::Instrument, true };
 
 		Param<Trajectory1DData::TriggerModeType> TriggerMode = { *this, TriggerModeTypeStrList(), "TriggerMode", "Trigger mode",
 			"Trigger action which starts streaming the position data", true, Trajectory1DData::TriggerModeType::Manual };
@@ -120,6 +249,8 @@ namespace DynExpModule
 			"Determines how many times the trajectory data stream should be played back after a trigger event has occurred", true, 1, 1 };
 		Param<ParamsConfigDialog::NumberType> DwellTime = { *this, "DwellTime", "Dwell time in ms",
 			"Dwell time used for data streams containing samples without time data", true, 100, 1 };
+		Param<Trajectory1DData::PlaybackModeType> PlaybackMode = { *this, PlaybackModeTypeStrList(), "PlaybackMode", "Playback mode",
+			"Determines how the writing of the samples is timed", true, Trajectory1DData::PlaybackModeType::ModuleLoop };
 
 	private:
 		void ConfigureParamsImpl(dispatch_tag<QModuleParamsBase>) override final {}
@@ -168,6 +299,9 @@ namespace DynExpModule
 		// Helper functions
 		void UpdateStream(Util::SynchronizedPointer<ModuleDataType>& ModuleData);
 		void Move(Util::SynchronizedPointer<ModuleDataType>& ModuleData);
+		void MovePrecomputed(Util::SynchronizedPointer<ModuleDataType>& ModuleData);
+		void StartPrecomputed(Util::SynchronizedPointer<ModuleDataType>& ModuleData);
+		void FinishPlayback(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
 		void Start(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
 		void Stop(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
 		void Trigger(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
@@ -183,6 +317,23 @@ namespace DynExpModule
 		void OnStop(DynExp::ModuleInstance* Instance) const;
 		void OnTrigger(DynExp::ModuleInstance* Instance) const;
 
+		/**
+		 * @brief Resamples @p Samples at equidistant times holding each position until the time of the next sample.
+		 * @param Samples Trajectory to resample
+		 * @param RepetitionPeriod Duration of one repetition of the trajectory
+		 * @param RepeatCount Number of repetitions to append to each other
+		 * @param SamplingRate Sampling rate in samples per second
+		 * @return Waveform containing all repetitions
+		*/
+		static DynExpInstr::DataStreamBase::BasicSampleListType ResampleTrajectory(const DynExpInstr::DataStreamBase::BasicSampleListType& Samples,
+			std::chrono::steady_clock::duration RepetitionPeriod, size_t RepeatCount, double SamplingRate);
+
 		size_t NumFailedUpdateAttempts = 0;
+
+		/**
+		 * @brief Plays back precomputed trajectories if no hardware-timed output is available.
+		 * Mutable since it is stopped by the const event functions.
+		*/
+		mutable Trajectory1DScheduler Scheduler;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,128 @@
+// This file is part of DynExp.
+
+#include "stdafx.h"
+#include "AutoMeasurePipeline.h"
+
+namespace DynExpModule::Widefield
+{
+	const char* AutoMeasurePhaseTimer::GetPhaseName(AutoMeasurePhaseType Phase) noexcept
+	{
+		switch (Phase)
+		{
+		case AutoMeasurePhaseType::Moving: return "Moving";
+		case AutoMeasurePhaseType::Optimizing: return "Optimizing";
+		case AutoMeasurePhaseType::Spectrum: return "Spectrum";
+		case AutoMeasurePhaseType::HBT: return "HBT";
+		case AutoMeasurePhaseType::SpectrumAndHBT: return "Spectrum and HBT";
+		case AutoMeasurePhaseType::Saving: return "Saving";
+		default: return "Unknown";
+		}
+	}
+
+	void AutoMeasurePhaseTimer::Begin(AutoMeasurePhaseType Phase)
+	{
+		if (CurrentPhase == Phase)
+			return;
+
+		End();
+
+		CurrentPhase = Phase;
+		CurrentPhaseBeginTime = ClockType::now();
+	}
+
+	void AutoMeasurePhaseTimer::End()
+	{
+		if (!CurrentPhase)
+			return;
+
+		auto& PhaseStatistics = Statistics[static_cast<size_t>(*CurrentPhase)];
+		PhaseStatistics.TotalTime += ClockType::now() - CurrentPhaseBeginTime;
+		++PhaseStatistics.Count;
+
+		CurrentPhase.reset();
+	}
+
+	void AutoMeasurePhaseTimer::Reset()
+	{
+		Statistics = {};
+		CurrentPhase.reset();
+	}
+
+	AutoMeasurePhaseTimer::ClockType::duration AutoMeasurePhaseTimer::GetTotalTime() const noexcept
+	{
+		ClockType::duration TotalTime{};
+		for (const auto& PhaseStatistics : Statistics)
+			TotalTime += PhaseStatistics.TotalTime;
+
+		return TotalTime;
+	}
+
+	std::string AutoMeasurePhaseTimer::ToStr() const
+	{
+		const auto TotalTime = std::chrono::duration<double>(GetTotalTime()).count();
+
+		std::stringstream Stream;
+		Stream << std::fixed << std::setprecision(1) << "Time spent in total: " << TotalTime << " s";
+
+		for (size_t i = 0; i < Statistics.size(); ++i)
+		{
+			if (!Statistics[i].Count)
+				continue;
+
+			const auto PhaseTime = std::chrono::duration<double>(Statistics[i].TotalTime).count();
+			Stream << "; " << GetPhaseName(static_cast<AutoMeasurePhaseType>(i)) << ": " << PhaseTime << " s ("
+				<< (TotalTime > 0 ? 100 * PhaseTime / TotalTime : 0) << " %, " << Statistics[i].Count << " x "
+				<< PhaseTime / Statistics[i].Count << " s)";
+		}
+
+		return Stream.str();
+	}
+
+	void AutoMeasurePhaseTimer::WriteCSV(std::stringstream& Stream) const
+	{
+		Stream << "Phase;TotalTime(s);Count;MeanTime(s)\n";
+
+		for (size_t i = 0; i < Statistics.size(); ++i)
+		{
+			const auto PhaseTime = std::chrono::duration<double>(Statistics[i].TotalTime).count();
+
+			Stream << GetPhaseName(static_cast<AutoMeasurePhaseType>(i)) << ";" << PhaseTime << ";" << Statistics[i].Count << ";"
+				<< (Statistics[i].Count ? PhaseTime / Statistics[i].Count : 0) << "\n";
+		}
+	}
+
+	void AutoMeasureFileWriter::Enqueue(QString Filename, std::string Content, std::string ErrorMessage)
+	{
+		auto CompletionCallback = MakeCompletionCallback(std::move(ErrorMessage));
+		Util::FileWriter().EnqueueText(std::move(Filename), std::move(Content), std::move(CompletionCallback));
+	}
+
+	void AutoMeasureFileWriter::Enqueue(QString Filename, Util::AsyncFileWriter::JobFuncType JobFunc, std::string ErrorMessage)
+	{
+		auto CompletionCallback = MakeCompletionCallback(std::move(ErrorMessage));
+		Util::FileWriter().Enqueue(std::move(Filename), std::move(JobFunc), std::move(CompletionCallback));
+	}
+
+	void AutoMeasureFileWriter::WaitUntilFinished()
+	{
+		if (*NumPendingSaves && !Util::FileWriter().WaitUntilIdle(std::chrono::minutes(1)))
+			Util::EventLog().Log("Timeout while waiting for files of the automated characterization to be saved.", Util::ErrorType::Warning);
+	}
+
+	bool AutoMeasureFileWriter::IsBusy() const
+	{
+		return *NumPendingSaves != 0;
+	}
+
+	Util::AsyncFileWriter::CompletionCallbackType AutoMeasureFileWriter::MakeCompletionCallback(std::string ErrorMessage)
+	{
+		++*NumPendingSaves;
+
+		return [NumPendingSaves = NumPendingSaves, ErrorMessage = std::move(ErrorMessage)](const QString&, bool Success) {
+			if (!Success)
+				Util::EventLog().Log(ErrorMessage, Util::ErrorType::Error);
+
+			--*NumPendingSaves;
+		};
+	}
+}
@@ -0,0 +1,123 @@
+// This file is part of DynExp.
+
+/**
+ * @file AutoMeasurePipeline.h
+ * @brief Helpers for the DynExpModule::Widefield::WidefieldMicroscope module to overlap independent
+ * phases of the automated characterization of emitters and to gather timing statistics about these phases.
+*/
+
+#pragma once
+
+#include "stdafx.h"
+
+namespace DynExpModule::Widefield
+{
+	/**
+	 * @brief Phases of the automated characterization of a single emitter
+	*/
+	enum class AutoMeasurePhaseType { Moving, Optimizing, Spectrum, HBT, SpectrumAndHBT, Saving, NumPhases };
+
+	/**
+	 * @brief Accumulates the time spent in each phase of the automated characterization of emitters.
+	 * At most one phase is active at a time. Beginning a phase ends the previously active one.
+	*/
+	class AutoMeasurePhaseTimer
+	{
+	public:
+		using ClockType = std::chrono::steady_clock;
+
+		/**
+		 * @brief Statistics of a single phase
+		*/
+		struct PhaseStatisticsType
+		{
+			ClockType::duration TotalTime{};	//!< Total time spent in the phase
+			size_t Count = 0;					//!< Number of times the phase has been entered
+		};
+
+		/**
+		 * @brief Returns a human-readable name of @p Phase.
+		 * @param Phase Phase to return the name of
+		 * @return Name of @p Phase
+		*/
+		static const char* GetPhaseName(AutoMeasurePhaseType Phase) noexcept;
+
+		/**
+		 * @brief Ends the active phase (if any) and begins @p Phase. Does nothing if @p Phase is already active.
+		 * @param Phase Phase to begin
+		*/
+		void Begin(AutoMeasurePhaseType Phase);
+
+		void End();		//!< Ends the active phase (if any) adding its duration to the phase's statistics.
+		void Reset();	//!< Discards all statistics and ends the active phase without accounting for it.
+
+		bool IsRunning() const noexcept { return CurrentPhase.has_value(); }	//!< Returns whether a phase is active.
+
+		/**
+		 * @brief Getter for the statistics of @p Phase
+		 * @param Phase Phase to return the statistics of
+		 * @return Statistics of @p Phase. Does not include the duration of @p Phase if it is active.
+		*/
+		const PhaseStatisticsType& GetStatistics(AutoMeasurePhaseType Phase) const { return Statistics[static_cast<size_t>(Phase)]; }
+
+		ClockType::duration GetTotalTime() const noexcept;	//!< Returns the sum of the total times of all phases.
+
+		/**
+		 * @brief Assembles a human-readable summary of the statistics of all phases entered at least once.
+		 * @return Summary of the statistics
+		*/
+		std::string ToStr() const;
+
+		/**
+		 * @brief Writes the statistics of all phases to @p Stream in CSV format.
+		 * @param Stream Stream to write the statistics to
+		*/
+		void WriteCSV(std::stringstream& Stream) const;
+
+	private:
+		std::array<PhaseStatisticsType, static_cast<size_t>(AutoMeasurePhaseType::NumPhases)> Statistics{};
+		std::optional<AutoMeasurePhaseType> CurrentPhase;	//!< Active phase or no value if no phase is active
+		ClockType::time_point CurrentPhaseBeginTime;		//!< Time point #CurrentPhase has begun at
+	};
+
+	/**
+	 * @brief Saves files in the background to let the module continue with the next phase of the
+	 * automated characterization while the files are written. Files are written by %DynExp's shared
+	 * Util::AsyncFileWriter. So, they are saved strictly in the order they have been enqueued such that
+	 * subsequent saves of the same file never overtake each other.
+	*/
+	class AutoMeasureFileWriter
+	{
+	public:
+		AutoMeasureFileWriter() = default;
+		~AutoMeasureFileWriter() { WaitUntilFinished(); }
+
+		/**
+		 * @brief Enqueues a text file to be saved in the background.
+		 * @param Filename Path of the file to save
+		 * @param Content Text to write to the file
+		 * @param ErrorMessage Message to log as an error if saving the file fails
+		*/
+		void Enqueue(QString Filename, std::string Content, std::string ErrorMessage);
+
+		/**
+		 * @brief Enqueues a file to be saved in the background by @p JobFunc.
+		 * @param Filename Path of the file to save
+		 * @param JobFunc Function writing the file on the writer thread
+		 * @param ErrorMessage Message to log as an error if saving the file fails
+		*/
+		void Enqueue(QString Filename, Util::AsyncFileWriter::JobFuncType JobFunc, std::string ErrorMessage);
+
+		void WaitUntilFinished();	//!< Blocks until all enqueued files have been saved.
+		bool IsBusy() const;		//!< Returns whether there are enqueued files which have not been saved yet.
+
+	private:
+		Util::AsyncFileWriter::CompletionCallbackType MakeCompletionCallback(std::string ErrorMessage);	//!< Counts a pending save and returns a callback logging @p ErrorMessage on failure.
+
+		/**
+		 * @brief Number of files enqueued by this instance which have not been saved yet. Shared with the
+		 * completion callbacks since they might be called on the writer thread after this instance's destruction.
+		*/
+		std::shared_ptr<std::atomic<size_t>> NumPendingSaves = std::make_shared<std::atomic<size_t>>(0);
+	};
+}
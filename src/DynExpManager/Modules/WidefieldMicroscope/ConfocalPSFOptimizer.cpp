@@ -0,0 +1,184 @@
+// This file is part of DynExp.
+
+#include "stdafx.h"
+#include "ConfocalPSFOptimizer.h"
+
+namespace DynExpModule::Widefield
+{
+	void ConfocalPSFOptimizer::Init(const PointType& Center, const PointType& StepSize, double Tolerance, size_t MaxNumBatches)
+	{
+		for (const auto Step : StepSize)
+			if (!(Step > 0))
+				throw Util::InvalidArgException("Each step size must be positive.");
+
+		this->Center = Center;
+		this->StepSize = StepSize;
+		for (size_t i = 0; i < NumDimensions; ++i)
+			MinStepSize[i] = MinStepSizeFactor * StepSize[i];
+		this->Tolerance = Tolerance;
+		this->MaxNumBatches = std::max(size_t(1), MaxNumBatches);
+		NumBatches = 0;
+
+		PendingPoints.clear();
+		Measurements.clear();
+		FinalResult.reset();
+
+		MakeBatch(Center);
+	}
+
+	const ConfocalPSFOptimizer::PointType& ConfocalPSFOptimizer::GetNextPoint() const
+	{
+		if (PendingPoints.empty())
+			throw Util::InvalidStateException("No measurement of the confocal PSF optimizer is pending.");
+
+		return PendingPoints.front();
+	}
+
+	ConfocalPSFOptimizer::ResultType ConfocalPSFOptimizer::ReportCountRate(double CountRate)
+	{
+		if (PendingPoints.empty())
+			throw Util::InvalidStateException("No measurement of the confocal PSF optimizer is pending.");
+
+		const auto MeasuredPoint = PendingPoints.front();
+		PendingPoints.pop_front();
+		Measurements.push_back({ MeasuredPoint, CountRate });
+
+		if (FinalResult)
+			return *FinalResult;
+		if (!PendingPoints.empty())
+			return ResultType::NextPoint;
+
+		++NumBatches;
+		const auto JumpDistance = FitAndJump();
+
+		if (!JumpDistance)
+			Finish(GetBestMeasurement().Point, ResultType::Failed);
+		else if (*JumpDistance < Tolerance)
+			Finish(Center, ResultType::Finished);
+		else if (NumBatches >= MaxNumBatches)
+			Finish(GetBestMeasurement().Point, ResultType::Failed);
+		else
+			MakeBatch(MeasuredPoint);
+
+		return ResultType::NextPoint;
+	}
+
+	const ConfocalPSFOptimizer::MeasurementType& ConfocalPSFOptimizer::GetBestMeasurement() const
+	{
+		if (Measurements.empty())
+			throw Util::InvalidStateException("The confocal PSF optimizer has not measured anything yet.");
+
+		return *std::max_element(Measurements.cbegin(), Measurements.cend(), [](const auto& a, const auto& b) {
+			return a.CountRate < b.CountRate;
+		});
+	}
+
+	void ConfocalPSFOptimizer::MakeBatch(const PointType& PathOrigin)
+	{
+		std::vector<PointType> Batch{ Center };
+		for (size_t i = 0; i < NumDimensions; ++i)
+			for (const auto Direction : { -1.0, 1.0 })
+			{
+				auto Point = Center;
+				Point[i] += Direction * StepSize[i];
+				Batch.push_back(Point);
+			}
+
+		// Moving the sample stage (x, y) takes much longer than changing the focus voltage (z). So, greedily
+		// append the point closest to the previous one in the x-y plane. This keeps points only differing in
+		// z together and avoids crossing the center more often than necessary.
+		const auto StageDistance = [](const PointType& a, const PointType& b) { return std::hypot(a[0] - b[0], a[1] - b[1]); };
+		auto PreviousPoint = PathOrigin;
+		PendingPoints.clear();
+		while (!Batch.empty())
+		{
+			auto NextPoint = std::min_element(Batch.begin(), Batch.end(), [&PreviousPoint, &StageDistance](const auto& a, const auto& b) {
+				return StageDistance(a, PreviousPoint) < StageDistance(b, PreviousPoint);
+			});
+
+			PreviousPoint = *NextPoint;
+			PendingPoints.push_back(*NextPoint);
+			Batch.erase(NextPoint);
+		}
+	}
+
+	std::optional<double> ConfocalPSFOptimizer::FitAndJump()
+	{
+		// Model: ln(I) = c_0 + sum_i (c_(2i+1) u_i + c_(2i+2) u_i^2) with u_i being the distance from the center
+		// in units of the step size along axis i. This equals a separable Gaussian function plus a constant.
+		constexpr size_t NumCoefficients = 1 + 2 * NumDimensions;
+
+		std::vector<const MeasurementType*> FitMeasurements;
+		for (const auto& Measurement : Measurements)
+		{
+			bool IsInFitWindow = true;
+			for (size_t i = 0; i < NumDimensions; ++i)
+				IsInFitWindow &= std::abs(Measurement.Point[i] - Center[i]) <= FitWindowFactor * StepSize[i];
+
+			if (IsInFitWindow)
+				FitMeasurements.push_back(&Measurement);
+		}
+
+		if (FitMeasurements.size() < NumCoefficients || !(GetBestMeasurement().CountRate > 0))
+			return {};
+
+		std::unique_ptr<gsl_matrix, decltype(&gsl_matrix_free)> X(gsl_matrix_alloc(FitMeasurements.size(), NumCoefficients), &gsl_matrix_free);
+		std::unique_ptr<gsl_vector, decltype(&gsl_vector_free)> y(gsl_vector_alloc(FitMeasurements.size()), &gsl_vector_free);
+		std::unique_ptr<gsl_vector, decltype(&gsl_vector_free)> w(gsl_vector_alloc(FitMeasurements.size()), &gsl_vector_free);
+		std::unique_ptr<gsl_vector, decltype(&gsl_vector_free)> c(gsl_vector_alloc(NumCoefficients), &gsl_vector_free);
+		std::unique_ptr<gsl_matrix, decltype(&gsl_matrix_free)> Cov(gsl_matrix_alloc(NumCoefficients, NumCoefficients), &gsl_matrix_free);
+		std::unique_ptr<gsl_multifit_linear_workspace, decltype(&gsl_multifit_linear_free)> Workspace(
+			gsl_multifit_linear_alloc(FitMeasurements.size(), NumCoefficients), &gsl_multifit_linear_free);
+		if (!X || !y || !w || !c || !Cov || !Workspace)
+			throw Util::NotAvailableException("Could not initialize GSL multifit library components.", Util::ErrorType::Error);
+
+		for (size_t Row = 0; Row < FitMeasurements.size(); ++Row)
+		{
+			gsl_matrix_set(X.get(), Row, 0, 1);
+			for (size_t i = 0; i < NumDimensions; ++i)
+			{
+				const auto u = (FitMeasurements[Row]->Point[i] - Center[i]) / StepSize[i];
+				gsl_matrix_set(X.get(), Row, 2 * i + 1, u);
+				gsl_matrix_set(X.get(), Row, 2 * i + 2, u * u);
+			}
+
+			// Assuming Poissonian noise, the variance of ln(I) is approximately 1/I.
+			const auto CountRate = std::max(1.0, FitMeasurements[Row]->CountRate);
+			gsl_vector_set(y.get(), Row, std::log(CountRate));
+			gsl_vector_set(w.get(), Row, CountRate);
+		}
+
+		double ChiSquared{};
+		if (gsl_multifit_wlinear(X.get(), w.get(), y.get(), c.get(), Cov.get(), &ChiSquared, Workspace.get()) != GSL_SUCCESS)
+			return {};
+
+		double JumpDistanceSquared = 0;
+		for (size_t i = 0; i < NumDimensions; ++i)
+		{
+			const auto Slope = gsl_vector_get(c.get(), 2 * i + 1);
+			const auto Curvature = gsl_vector_get(c.get(), 2 * i + 2);
+			if (!std::isfinite(Slope) || !std::isfinite(Curvature))
+				return {};
+
+			// Without a maximum along this axis, move uphill.
+			const auto Jump = Curvature < 0 ? std::clamp(-Slope / (2 * Curvature), -MaxJumpFactor, MaxJumpFactor) :
+				(Slope > 0 ? MaxJumpFactor : (Slope < 0 ? -MaxJumpFactor : 0));
+			Center[i] += Jump * StepSize[i];
+			JumpDistanceSquared += std::pow(Jump * StepSize[i], 2);
+
+			// Points one standard deviation of the Gaussian function away from its maximum yield the most
+			// reliable fit. Only shrink the step size in order not to leave the region of the maximum.
+			if (Curvature < 0)
+				StepSize[i] = std::clamp(StepSize[i] * std::sqrt(-1 / (2 * Curvature)), MinStepSize[i], StepSize[i]);
+		}
+
+		return std::sqrt(JumpDistanceSquared);
+	}
+
+	void ConfocalPSFOptimizer::Finish(const PointType& Point, ResultType Result)
+	{
+		PendingPoints.clear();
+		PendingPoints.push_back(Point);
+		FinalResult = Result;
+	}
+}
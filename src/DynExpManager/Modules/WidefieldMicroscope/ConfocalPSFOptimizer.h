@@ -0,0 +1,132 @@
+// This file is part of DynExp.
+
+/**
+ * @file ConfocalPSFOptimizer.h
+ * @brief Model-based optimizer for the DynExpModule::Widefield::WidefieldMicroscope module to maximize
+ * the confocal count rate by fitting a Gaussian point spread function to batches of measured count rates.
+*/
+
+#pragma once
+
+#include "stdafx.h"
+
+namespace DynExpModule::Widefield
+{
+	/**
+	 * @brief Maximizes the confocal count rate with respect to the sample position (x, y) and the focus
+	 * voltage (z). In each iteration, the count rate is measured at a batch of points around the current
+	 * center (the center itself and one step in positive and negative direction along each axis). The
+	 * batch is ordered to minimize the distance the sample stage has to travel. A separable 3D Gaussian
+	 * point spread function is fitted to the logarithm of the count rates measured within the vicinity of
+	 * the center by weighted linear least squares. The fitted maximum becomes the next center. The distance
+	 * the center jumps per iteration is limited to #MaxJumpFactor step sizes per axis. Along axes without
+	 * a maximum, the center moves uphill by this distance. The step sizes adapt to the fitted widths of
+	 * the point spread function. Finally, the count rate is measured at the optimum once more such that
+	 * the sample is located there after the optimization and the last measured count rate belongs to it.
+	*/
+	class ConfocalPSFOptimizer
+	{
+	public:
+		static constexpr size_t NumDimensions = 3;					//!< Number of dimensions to optimize (x, y, z)
+		static constexpr size_t DefaultMaxNumBatches = 10;			//!< Default value of #MaxNumBatches
+		static constexpr double MaxJumpFactor = 2.0;				//!< Maximal distance in step sizes per axis the center jumps by per iteration
+		static constexpr double FitWindowFactor = 2.5;				//!< Measurements up to this distance in step sizes per axis from the center are fitted.
+		static constexpr double MinStepSizeFactor = 0.125;			//!< Step sizes do not shrink below this fraction of the initial step sizes.
+
+		/**
+		 * @brief Type of a point to optimize. Contains the sample position in x and y direction
+		 * in nm and the focus voltage in V.
+		*/
+		using PointType = std::array<double, NumDimensions>;
+
+		/**
+		 * @brief Count rate measured at a point
+		*/
+		struct MeasurementType
+		{
+			PointType Point{};		//!< Point where the count rate has been measured
+			double CountRate{};		//!< Measured count rate in Hz
+		};
+
+		/**
+		 * @brief Result of reporting a measured count rate to the optimizer
+		*/
+		enum class ResultType {
+			NextPoint,	//!< The count rate has to be measured at the point returned by @p GetNextPoint() next.
+			Finished,	//!< The optimization has converged. The sample is located at the optimum.
+			Failed		//!< The optimization has not converged. The sample is located at the point with the highest count rate measured.
+		};
+
+		/**
+		 * @brief Starts a new optimization discarding all previous measurements.
+		 * @param Center Point to start the optimization at. The sample is assumed to be located there.
+		 * @param StepSize Initial step sizes along each axis. Each of them needs to be positive.
+		 * @param Tolerance The optimization has converged if the center jumps by less than this distance.
+		 * @param MaxNumBatches @copybrief #MaxNumBatches
+		 * @throws Util::InvalidArgException is thrown if any of @p StepSize is not positive.
+		*/
+		void Init(const PointType& Center, const PointType& StepSize, double Tolerance, size_t MaxNumBatches = DefaultMaxNumBatches);
+
+		/**
+		 * @brief Returns the point to measure the count rate at next.
+		 * @return Next point to measure
+		 * @throws Util::InvalidStateException is thrown if no measurement is pending.
+		*/
+		const PointType& GetNextPoint() const;
+
+		/**
+		 * @brief Reports the count rate measured at the point returned by @p GetNextPoint(). If this
+		 * completes a batch, the point spread function is fitted and the next batch is prepared.
+		 * @param CountRate Count rate measured in Hz
+		 * @return Returns whether to continue measuring or whether the optimization has ended.
+		 * @throws Util::InvalidStateException is thrown if no measurement is pending.
+		*/
+		ResultType ReportCountRate(double CountRate);
+
+		const PointType& GetCenter() const noexcept { return Center; }						//!< Getter for #Center
+		const PointType& GetStepSize() const noexcept { return StepSize; }					//!< Getter for #StepSize
+		size_t GetNumBatches() const noexcept { return NumBatches; }						//!< Getter for #NumBatches
+		size_t GetNumMeasurements() const noexcept { return Measurements.size(); }			//!< Returns the number of count rates measured so far.
+		const auto& GetMeasurements() const noexcept { return Measurements; }				//!< Getter for #Measurements
+
+		/**
+		 * @brief Returns the measurement with the highest count rate.
+		 * @return Best measurement
+		 * @throws Util::InvalidStateException is thrown if nothing has been measured yet.
+		*/
+		const MeasurementType& GetBestMeasurement() const;
+
+	private:
+		/**
+		 * @brief Fills #PendingPoints with a batch of points around #Center ordered along a short path
+		 * starting at @p PathOrigin.
+		 * @param PathOrigin Point the sample is located at before measuring the batch
+		*/
+		void MakeBatch(const PointType& PathOrigin);
+
+		/**
+		 * @brief Fits the point spread function to the measurements within the vicinity of #Center
+		 * and moves #Center towards the fitted maximum adapting #StepSize.
+		 * @return Returns the distance #Center has jumped by or no value if the fit has failed.
+		*/
+		std::optional<double> FitAndJump();
+
+		/**
+		 * @brief Ends the optimization by enqueuing a final measurement at @p Point.
+		 * @param Point Point to locate the sample at after the optimization
+		 * @param Result Result to return once the final measurement has been reported
+		*/
+		void Finish(const PointType& Point, ResultType Result);
+
+		PointType Center{};								//!< Current estimate of the point with the maximal count rate
+		PointType StepSize{};							//!< Current distances of the batch's points from #Center along each axis
+		PointType MinStepSize{};						//!< Minimal values of #StepSize
+		double Tolerance{};								//!< The optimization has converged if #Center jumps by less than this distance.
+		size_t MaxNumBatches{};							//!< Maximal number of batches to measure before the optimization fails
+		size_t NumBatches{};							//!< Number of batches measured so far
+
+		std::deque<PointType> PendingPoints;			//!< Points of the current batch still to be measured in this order
+		std::vector<MeasurementType> Measurements;		//!< All count rates measured during the current optimization
+		std::optional<ResultType> FinalResult;			//!< Result of the optimization once only the final measurement is pending
+	};
+}
@@ -124,12 +124,14 @@ namespace DynExpModule::Widefield
 			CSVData << "ConfocalScanWidth = " << ConfocalScanWidth << "\n";
 			CSVData << "ConfocalScanHeight = " << ConfocalScanHeight << "\n";
 			CSVData << "ConfocalScanDistPerPixel = " << ConfocalScanDistPerPixel << "\n";
+			CSVData << "ConfocalScanContinuous = " << (ConfocalScanContinuous ? "yes" : "no") << "\n";
 			CSVData << "SPDExposureTime = " << SPDExposureTime.count() << " ms\n";
 		}
 
 		CSVData << "ConfocalOptimizationInitXYStepSize = " << ConfocalOptimizationInitXYStepSize << "\n";
 		CSVData << "ConfocalOptimizationInitZStepSize = " << ConfocalOptimizationInitZStepSize << "\n";
 		CSVData << "ConfocalOptimizationTolerance = " << ConfocalOptimizationTolerance << "\n";
+		CSVData << "ConfocalOptimizationMethod = " << ConfocalOptimizationMethod << "\n";
 
 		if (IncludeHBT)
 		{
@@ -175,23 +177,33 @@ namespace DynExpModule::Widefield
 		return CSVData;
 	}
 
-	void WidefieldMicroscopeData::WriteConfocalScanResults(std::stringstream& Stream) const
+	Util::AsyncFileWriter::JobFuncType WidefieldMicroscopeData::MakeConfocalScanResultsWriter(Util::DataFileWriter::FormatType Format) const
 	{
-		Stream << "X_measured(nm);Y_measured(nm);X_destiny(nm);Y_destiny(nm);C(Hz)\n";
+		// Copy the data such that the file can be written without locking the module data.
+		return [Format, Header = AssembleCSVHeader(true, false, false).str(), ResultItems = GetConfocalScanResults()](const QString& Filename) {
+			Util::DataFileWriter Writer(Filename, Format);
+			Writer.WriteHeader(Header, { "X_measured(nm)", "Y_measured(nm)", "X_destiny(nm)", "Y_destiny(nm)", "C(Hz)" });
 
-		auto& ResultItems = GetConfocalScanResults();
-		for (const auto& ResultItem : ResultItems)
-			Stream << ResultItem.first.MeasuredX << ";" << ResultItem.first.MeasuredY << ";"
-				<< ResultItem.first.x << ";" << ResultItem.first.y << ";"
-				<< ResultItem.second << "\n";
+			for (const auto& ResultItem : ResultItems)
+				Writer.WriteRow({ static_cast<double>(ResultItem.first.MeasuredX), static_cast<double>(ResultItem.first.MeasuredY),
+					static_cast<double>(ResultItem.first.x), static_cast<double>(ResultItem.first.y), ResultItem.second });
+
+			Writer.Close();
+		};
 	}
 
-	void WidefieldMicroscopeData::WriteHBTResults(std::stringstream& Stream) const
+	Util::AsyncFileWriter::JobFuncType WidefieldMicroscopeData::MakeHBTResultsWriter(Util::DataFileWriter::FormatType Format) const
 	{
-		Stream << "t(ps);g2\n";
+		// Copy the data such that the file can be written without locking the module data.
+		return [Format, Header = AssembleCSVHeader(false, true, false).str(), DataPoints = GetHBTDataPoints()](const QString& Filename) {
+			Util::DataFileWriter Writer(Filename, Format);
+			Writer.WriteHeader(Header, { "t(ps)", "g2" });
+
+			for (const auto& DataPoint : DataPoints)
+				Writer.WriteRow({ DataPoint.x(), DataPoint.y() });
 
-		for (const auto& ResultItem : GetHBTDataPoints())
-			Stream << ResultItem.x() << ";" << ResultItem.y() << "\n";
+			Writer.Close();
+		};
 	}
 
 	void WidefieldMicroscopeData::SetLEDLightTurnedOn(bool State)
@@ -353,6 +365,7 @@ namespace DynExpModule::Widefield
 		ConfocalScanWidth = 20;
 		ConfocalScanHeight = 20;
 		ConfocalScanDistPerPixel = 50;
+		ConfocalScanContinuous = false;
 		SPDExposureTime = std::chrono::milliseconds(100);
 		SPD1State.Reset();
 		SPD2State.Reset();
@@ -362,6 +375,7 @@ namespace DynExpModule::Widefield
 		ConfocalOptimizationInitXYStepSize = 20.0;
 		ConfocalOptimizationInitZStepSize = 20.0;
 		ConfocalOptimizationTolerance = 1.0;
+		ConfocalOptimizationMethod = WidefieldMicroscopeWidget::ConfocalOptimizationMethodType::NelderMeadSimplex;
 		LastCountRate = .0;
 
 		HBTBinWidth = Util::picoseconds(500);
@@ -526,6 +540,11 @@ namespace DynExpModule::Widefield
 		return Point;
 	}
 
+	void WidefieldMicroscope::ConfocalLineScanType::Reset()
+	{
+		*this = ConfocalLineScanType();
+	}
+
 	WidefieldMicroscope::WidefieldMicroscope(const std::thread::id OwnerThreadID, DynExp::ParamsBasePtrType&& Params)
 		: QModuleBase(OwnerThreadID, std::move(Params)),
 		StateMachine(InitializingState,
@@ -538,7 +557,8 @@ namespace DynExpModule::Widefield
 			WaitingForWidefieldCellIDState, WidefieldCellWaitUntilCenteredState, WidefieldCellIDReadFinishedState,
 			WaitingForWidefieldLocalizationState, WidefieldLocalizationFinishedState,
 			FindingConfocalSpotBeginState, FindingConfocalSpotAfterTransitioningToConfocalModeState, FindingConfocalSpotAfterRecordingWidefieldImageState,
-			ConfocalScanStepState, ConfocalScanWaitUntilMovedState, ConfocalScanCaptureState, ConfocalScanWaitUntilCapturedState,
+			ConfocalScanStepState, ConfocalScanWaitUntilMovedState, ConfocalScanCaptureState, ConfocalScanWaitUntilCapturedState, ConfocalScanRunningState,
+			ConfocalLineScanStepState, ConfocalLineScanWaitUntilAtLineStartState, ConfocalLineScanAcquiringState,
 			ConfocalOptimizationInitState, ConfocalOptimizationInitSubStepState, ConfocalOptimizationWaitState, ConfocalOptimizationStepState, ConfocalOptimizationFinishedState,
 			HBTAcquiringState, HBTFinishedState,
 			WaitingState, WaitingFinishedState,
@@ -548,6 +568,7 @@ namespace DynExpModule::Widefield
 			AutoMeasureCharacterizationStepState, AutoMeasureCharacterizationGotoEmitterState, AutoMeasureCharacterizationOptimizationFinishedState,
 			AutoMeasureCharacterizationSpectrumBeginState, AutoMeasureCharacterizationSpectrumFinishedState,
 			AutoMeasureCharacterizationHBTBeginState, AutoMeasureCharacterizationHBTWaitForInitState, AutoMeasureCharacterizationHBTFinishedState,
+			AutoMeasureCharacterizationSpectrumHBTBeginState, AutoMeasureCharacterizationWaitForSpectrumState,
 			AutoMeasureCharacterizationFinishedState,
 			AutoMeasureSampleStepState, AutoMeasureSampleReadCellIDState, AutoMeasureSampleReadCellIDFinishedState,
 			AutoMeasureSampleLocalizeState, AutoMeasureSampleFindEmittersState,
@@ -557,6 +578,7 @@ namespace DynExpModule::Widefield
 		ConfocalScanPositionerStateZ(std::make_shared<AtomicPositionerStateType>()),
 		WidefieldCellIDState(std::make_shared<AtomicWidefieldImageProcessingStateType>()),
 		WidefieldLocalizationState(std::make_shared<AtomicWidefieldImageProcessingStateType>()),
+		ConfocalScanScheduler(*this),
 		GSLConfocalOptimizationState(gsl_multimin_fminimizer_alloc(GSLConfocalOptimizationMinimizer, GSLConfocalOptimizationNumDimensions)),
 		GSLConfocalOptimizationStepSize(gsl_vector_alloc(GSLConfocalOptimizationNumDimensions)),
 		GSLConfocalOptimizationInitialPoint(gsl_vector_alloc(GSLConfocalOptimizationNumDimensions))
@@ -672,7 +694,9 @@ namespace DynExpModule::Widefield
 		*WidefieldCellIDState = WidefieldImageProcessingStateType::Finished;
 		*WidefieldLocalizationState = WidefieldImageProcessingStateType::Finished;
 
+		ConfocalScanScheduler.Cancel();
 		ConfocalScanPositions.clear();
+		ConfocalLineScan.Reset();
 
 		ConfocalOptimizationNumStepsPerformed = 0;
 		ConfocalOptimizationPromisesRenewed = false;
@@ -682,6 +706,10 @@ namespace DynExpModule::Widefield
 
 		HBTIntegrationTimeBeforeReset = {};
 
+		AutoMeasurePhaseTimes.Reset();
+		AutoMeasureSpectrumPending = false;
+		AutoMeasureHBTSwitchPreset = false;
+
 		NumFailedUpdateAttempts = 0;
 		LogUIMessagesOnly = false;
 	}
@@ -723,9 +751,11 @@ namespace DynExpModule::Widefield
 		Connect(Widget->GetUI().SBConfocalHeight, QOverload<int>::of(&QSpinBox::valueChanged), this, &WidefieldMicroscope::OnConfocalConfocalHeightChanged);
 		Connect(Widget->GetUI().SBConfocalDistPerPixel, QOverload<int>::of(&QSpinBox::valueChanged), this, &WidefieldMicroscope::OnConfocalConfocalDistPerPixelChanged);
 		Connect(Widget->GetUI().SBConfocalSPDExposureTime, QOverload<int>::of(&QSpinBox::valueChanged), this, &WidefieldMicroscope::OnConfocalSPDExposureTimeChanged);
+		Connect(Widget->GetUI().CBConfocalContinuousScan, &QCheckBox::stateChanged, this, &WidefieldMicroscope::OnToggleConfocalScanContinuous);
 		Connect(Widget->GetUI().SBConfocalOptimizationInitXYStepSize, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &WidefieldMicroscope::OnConfocalOptimizationInitXYStepSizeChanged);
 		Connect(Widget->GetUI().SBConfocalOptimizationInitZStepSize, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &WidefieldMicroscope::OnConfocalOptimizationInitZStepSizeChanged);
 		Connect(Widget->GetUI().SBConfocalOptimizationTolerance, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &WidefieldMicroscope::OnConfocalOptimizationToleranceChanged);
+		Connect(Widget->GetUI().CBConfocalOptimizationMethod, &QComboBox::currentIndexChanged, this, &WidefieldMicroscope::OnConfocalOptimizationMethodChanged);
 		Connect(Widget->GetUI().BConfocalScan, &QPushButton::clicked, this, &WidefieldMicroscope::OnPerformConfocalScan);
 		Connect(Widget->GetConfocalSurface3DSeries(), &QSurface3DSeries::selectedPointChanged, this, &WidefieldMicroscope::ConfocalSurfaceSelectedPointChanged);
 		Connect(Widget->GetUI().SBHBTBinWidth, QOverload<int>::of(&QSpinBox::valueChanged), this, &WidefieldMicroscope::OnHBTBinWidthChanged);
@@ -801,6 +831,15 @@ namespace DynExpModule::Widefield
 		ModuleData->ResetAutoMeasureCurrentImageSet();
 		ModuleData->SetAutoMeasureRunning(false);
 
+		// Report the phase times of an aborted characterization.
+		if (AutoMeasurePhaseTimes.IsRunning())
+		{
+			AutoMeasurePhaseTimes.End();
+			Util::EventLog().Log("Emitter characterization aborted. " + AutoMeasurePhaseTimes.ToStr());
+		}
+		AutoMeasureSpectrumPending = false;
+		AutoMeasureHBTSwitchPreset = false;
+
 		LogUIMessagesOnly = false;
 
 		StateMachine.ResetContext();
@@ -861,6 +900,29 @@ namespace DynExpModule::Widefield
 		}
 	}
 
+	/**
+	 * @brief Moves the sample in x- and y-direction like MoveSampleTo() does.
+	 * @param Point Position to move to in nm
+	 * @param ModuleData WidefieldMicroscope's locked module data
+	 * @return Futures of the stages' move tasks. They become ready when the stages have started moving.
+	*/
+	std::vector<DynExp::TaskFuture> WidefieldMicroscope::MoveSampleXYToAsync(const ModuleDataType::PositionPoint& Point, Util::SynchronizedPointer<ModuleDataType>& ModuleData) const
+	{
+		std::vector<DynExp::TaskFuture> Futures;
+
+		if (!ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::SampleXYPositioning))
+			return Futures;
+
+		if (Point.UsingX)
+			Futures.push_back(ModuleData->GetSampleStageX()->AsAsyncTask(&DynExpInstr::PositionerStage::MoveAbsolute,
+				Point.x / ModuleData->GetSampleStageX()->GetStepNanoMeterRatio()));
+		if (Point.UsingY)
+			Futures.push_back(ModuleData->GetSampleStageY()->AsAsyncTask(&DynExpInstr::PositionerStage::MoveAbsolute,
+				Point.y / ModuleData->GetSampleStageX()->GetStepNanoMeterRatio()));
+
+		return Futures;
+	}
+
 	/**
 	 * @brief Checks whether the sample is moving in x- or y-direction.
 	 * The z-direction is ignored currently since this module doesn't currently make use of it.
@@ -1060,9 +1122,209 @@ namespace DynExpModule::Widefield
 		}
 	}
 
+	/**
+	 * @brief Configures the SPDs for a continuous confocal scan. Each pixel is covered by multiple short
+	 * count samples which are buffered by the SPDs' sample streams until they are read.
+	 * Also refer to @p PrepareAPDsForConfocalMode().
+	 * @param ModuleData WidefieldMicroscope's locked module data
+	*/
+	void WidefieldMicroscope::PrepareAPDsForConfocalLineScan(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const
+	{
+		ConfocalLineScan.SampleExposureTime = std::max(ModuleDataType::SPDTimeType(1), ModuleData->GetSPDExposureTime() / ConfocalLineScanSamplesPerPixel);
+
+		ModuleData->GetSPD1()->SetStreamSize(ConfocalLineScanStreamSize);
+		ModuleData->GetSPD1()->SetExposureTime(ConfocalLineScan.SampleExposureTime);
+
+		if (ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::HBT))
+		{
+			ModuleData->GetSPD2()->SetStreamSize(ConfocalLineScanStreamSize);
+			ModuleData->GetSPD2()->SetExposureTime(ConfocalLineScan.SampleExposureTime);
+		}
+	}
+
+	/**
+	 * @brief Restores the sample stage's velocity and the SPDs' settings changed for a continuous confocal scan.
+	 * Does nothing if no continuous confocal scan is running.
+	 * @param ModuleData WidefieldMicroscope's locked module data
+	*/
+	void WidefieldMicroscope::FinishConfocalLineScan(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const
+	{
+		if (!ConfocalLineScan.IsActive)
+			return;
+
+		ModuleData->GetSampleStageX()->SetVelocity(ConfocalLineScan.OriginalVelocity);
+		PrepareAPDsForConfocalMode(ModuleData);
+
+		ConfocalLineScan.Reset();
+	}
+
+	void WidefieldMicroscope::ReadConfocalLineScanCounts(Util::SynchronizedPointer<ModuleDataType>& ModuleData, bool UsingSPD2) const
+	{
+		const auto ExposureTime = std::chrono::duration_cast<ConfocalLineScanType::ClockType::duration>(ConfocalLineScan.SampleExposureTime);
+		const auto HalfExposureTime = ExposureTime / 2;
+
+		const auto ReadCounts = [ExposureTime, HalfExposureTime](const auto& SPD, size_t& SamplesRead, std::vector<ConfocalLineScanType::CountTracePointType>& CountTrace) {
+			{
+				auto SPDData = DynExp::dynamic_InstrumentData_cast<DynExpInstr::TimeTagger>(SPD->GetInstrumentData());
+				auto SPDDataSampleStream = SPDData->GetCastSampleStream<DynExpInstr::TimeTaggerData::SampleStreamType>();
+				const auto NumSamplesWritten = SPDDataSampleStream->GetNumSamplesWritten();
+
+				// The stream has been cleared since it has been read last.
+				if (NumSamplesWritten < SamplesRead)
+					SamplesRead = 0;
+
+				if (NumSamplesWritten > SamplesRead)
+				{
+					const auto Samples = SPDDataSampleStream->ReadRecentBasicSamples(SamplesRead);
+					SamplesRead = NumSamplesWritten;
+
+					if (SPDData->AreCountsTimestamped())
+					{
+						// Each sample is timestamped by the SPD with the end of its exposure interval.
+						const auto StartTime = SPDData->GetCountsStartTime();
+						for (const auto& Sample : Samples)
+							CountTrace.push_back({ StartTime - HalfExposureTime +
+								std::chrono::duration_cast<ConfocalLineScanType::ClockType::duration>(std::chrono::duration<double>(Sample.Time)),
+								Sample.Value });
+					}
+					else
+					{
+						// The samples' times are not related to the SPD's counts clock. So, timestamp the samples on arrival
+						// assuming that they have been recorded back to back with the last one ending now.
+						auto Time = ConfocalLineScanType::ClockType::now() - HalfExposureTime -
+							Util::NumToT<ConfocalLineScanType::ClockType::duration::rep>(Samples.size() - 1) * ExposureTime;
+						for (const auto& Sample : Samples)
+						{
+							CountTrace.push_back({ Time, Sample.Value });
+							Time += ExposureTime;
+						}
+					}
+				}
+			} // SPDData unlocked here.
+
+			SPD->ReadData();
+		};
+
+		ReadCounts(ModuleData->GetSPD1(), ConfocalLineScan.SPD1SamplesRead, ConfocalLineScan.SPD1CountTrace);
+		if (UsingSPD2)
+			ReadCounts(ModuleData->GetSPD2(), ConfocalLineScan.SPD2SamplesRead, ConfocalLineScan.SPD2CountTrace);
+	}
+
+	/**
+	 * @brief Copies the samples sample stage X's own position trace has recorded while scanning the
+	 * current line to the line's position trace (ConfocalLineScanType::PositionTrace), converting their
+	 * times to ConfocalLineScanType::ClockType and their positions to nm. Does nothing if the position
+	 * trace of sample stage X is disabled.
+	 * @param ModuleData WidefieldMicroscope's locked module data
+	*/
+	void WidefieldMicroscope::ReadConfocalLineScanStagePositionTrace(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const
+	{
+		const auto StepNanoMeterRatio = ModuleData->GetSampleStageX()->GetStepNanoMeterRatio();
+		auto SampleStageXData = DynExp::dynamic_InstrumentData_cast<DynExpInstr::PositionerStage>(ModuleData->GetSampleStageX()->GetInstrumentData());
+		if (!SampleStageXData->IsPositionTraceEnabled())
+			return;
+
+		// Also read the last position recorded before the line has started to be able to interpolate the line's beginning.
+		auto& StagePositionTrace = SampleStageXData->GetPositionTrace();
+		if (StagePositionTrace.GetNumSamplesWritten() < ConfocalLineScan.StagePositionTraceSamplesRead)
+			ConfocalLineScan.StagePositionTraceSamplesRead = 0;
+		const auto Samples = StagePositionTrace.ReadRecentBasicSamples(
+			ConfocalLineScan.StagePositionTraceSamplesRead ? ConfocalLineScan.StagePositionTraceSamplesRead - 1 : 0);
+		const auto StartTime = SampleStageXData->GetPositionTraceStartTime();
+
+		ConfocalLineScan.PositionTrace.clear();
+		for (const auto& Sample : Samples)
+			ConfocalLineScan.PositionTrace.push_back({
+				StartTime + std::chrono::duration_cast<ConfocalLineScanType::ClockType::duration>(std::chrono::duration<double>(Sample.Time)),
+				Util::NumToT<WidefieldMicroscopeData::PositionType>(Sample.Value * StepNanoMeterRatio) });
+	}
+
+	/**
+	 * @brief Assigns the count samples recorded while scanning the current line to the line's pixels
+	 * and appends the resulting count rates to the confocal scan results. Pixels which no count sample
+	 * has been assigned to (e.g. if the sample stage moved too fast) are omitted.
+	 * @param ModuleData WidefieldMicroscope's locked module data
+	*/
+	void WidefieldMicroscope::BinConfocalLineScan(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const
+	{
+		struct PixelBinType
+		{
+			double Counts = 0;
+			size_t NumSamples = 0;
+			double PositionSum = 0;
+		};
+
+		const auto& PositionTrace = ConfocalLineScan.PositionTrace;
+		const auto NumPixels = ConfocalLineScan.Pixels.size();
+		if (PositionTrace.empty() || !NumPixels)
+			return;
+
+		// Linear interpolation of the position trace. Times outside of the trace are mapped to the trace's boundaries.
+		const auto InterpolatePosition = [&PositionTrace](ConfocalLineScanType::ClockType::time_point Time) {
+			const auto Next = std::upper_bound(PositionTrace.cbegin(), PositionTrace.cend(), Time,
+				[](const auto& Lhs, const auto& TracePoint) { return Lhs < TracePoint.Time; });
+			if (Next == PositionTrace.cbegin())
+				return static_cast<double>(Next->X);
+			if (Next == PositionTrace.cend())
+				return static_cast<double>(PositionTrace.back().X);
+
+			const auto Prev = std::prev(Next);
+			if (Next->Time == Prev->Time)
+				return static_cast<double>(Next->X);
+
+			const auto Fraction = std::chrono::duration<double>(Time - Prev->Time) / std::chrono::duration<double>(Next->Time - Prev->Time);
+
+			return Prev->X + Fraction * (Next->X - Prev->X);
+		};
+
+		const auto BinCountTrace = [this, &InterpolatePosition, NumPixels](const std::vector<ConfocalLineScanType::CountTracePointType>& CountTrace) {
+			std::vector<PixelBinType> Bins(NumPixels);
+
+			for (const auto& Sample : CountTrace)
+			{
+				const auto X = InterpolatePosition(Sample.Time);
+				const auto PixelIndex = std::floor((X - ConfocalLineScan.LineStartX) / ConfocalLineScan.DistPerPixel);
+				if (PixelIndex < 0 || PixelIndex >= static_cast<double>(NumPixels))
+					continue;
+
+				auto& Bin = Bins[static_cast<size_t>(PixelIndex)];
+				Bin.Counts += Sample.Counts;
+				Bin.PositionSum += X;
+				++Bin.NumSamples;
+			}
+
+			return Bins;
+		};
+
+		const bool UsingSPD2 = ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::HBT);
+		const auto SPD1Bins = BinCountTrace(ConfocalLineScan.SPD1CountTrace);
+		const auto SPD2Bins = BinCountTrace(ConfocalLineScan.SPD2CountTrace);
+		const auto ExposureTime = std::chrono::duration<double>(ConfocalLineScan.SampleExposureTime).count();
+
+		for (size_t i = 0; i < NumPixels; ++i)
+		{
+			if (!SPD1Bins[i].NumSamples || (UsingSPD2 && !SPD2Bins[i].NumSamples))
+				continue;
+
+			auto Pixel = ConfocalLineScan.Pixels[i];
+			Pixel.MeasuredX = Util::NumToT<WidefieldMicroscopeData::PositionType>(SPD1Bins[i].PositionSum / SPD1Bins[i].NumSamples);
+			Pixel.MeasuredY = ConfocalLineScan.MeasuredY;
+
+			double CountRate = SPD1Bins[i].Counts / (SPD1Bins[i].NumSamples * ExposureTime);
+			if (UsingSPD2)
+				CountRate += SPD2Bins[i].Counts / (SPD2Bins[i].NumSamples * ExposureTime);
+
+			ModuleData->GetConfocalScanResults().emplace_back(Pixel, CountRate);
+			ModuleData->SetLastCountRate(CountRate);
+		}
+	}
+
 	void WidefieldMicroscope::InitializeConfocalOptimizer(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const
 	{
 		ConfocalOptimizationNumStepsPerformed = 0;
+		ConfocalOptimizationMethodInUse = ModuleData->GetConfocalOptimizationMethod();
+		ConfocalOptimizationNumMeasurements = 0;
+		ConfocalOptimizationStartTimePoint = std::chrono::steady_clock::now();
 
 		PrepareAPDsForConfocalMode(ModuleData);
 		SetFocus(ModuleData, ModuleData->GetFocusZeroVoltage());
@@ -1077,6 +1339,42 @@ namespace DynExpModule::Widefield
 		gsl_vector_set(GSLConfocalOptimizationInitialPoint, 0, SamplePosition.x);
 		gsl_vector_set(GSLConfocalOptimizationInitialPoint, 1, SamplePosition.y);
 		gsl_vector_set(GSLConfocalOptimizationInitialPoint, 2, ModuleData->GetFocusZeroVoltage());
+
+		if (ConfocalOptimizationMethodInUse == WidefieldMicroscopeWidget::ConfocalOptimizationMethodType::GaussianPSFFit)
+			ConfocalPSFOptimization.Init(
+				{ gsl_vector_get(GSLConfocalOptimizationInitialPoint, 0), gsl_vector_get(GSLConfocalOptimizationInitialPoint, 1),
+					gsl_vector_get(GSLConfocalOptimizationInitialPoint, 2) },
+				{ gsl_vector_get(GSLConfocalOptimizationStepSize, 0), gsl_vector_get(GSLConfocalOptimizationStepSize, 1),
+					gsl_vector_get(GSLConfocalOptimizationStepSize, 2) },
+				ModuleData->GetConfocalOptimizationTolerance());
+	}
+
+	StateType WidefieldMicroscope::MeasureNextConfocalPSFOptimizationPoint(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const
+	{
+		const auto& Point = ConfocalPSFOptimization.GetNextPoint();
+
+		SetFocus(ModuleData, Point[2]);
+		ConfocalScanPositions.clear();
+		ConfocalScanPositions.emplace_back(static_cast<WidefieldMicroscopeData::PositionType>(std::round(Point[0])),
+			static_cast<WidefieldMicroscopeData::PositionType>(std::round(Point[1])));
+
+		// StateType::DummyState is replaced by context.
+		return StateType::DummyState;
+	}
+
+	void WidefieldMicroscope::LogConfocalOptimizationStatistics() const
+	{
+		// Allows comparing the optimization methods in terms of stage moves and time required on the real setup.
+		const auto Duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - ConfocalOptimizationStartTimePoint).count();
+
+		std::stringstream Message;
+		Message << "Confocal optimization ("
+			<< (ConfocalOptimizationMethodInUse == WidefieldMicroscopeWidget::ConfocalOptimizationMethodType::GaussianPSFFit ?
+				"Gaussian PSF fit" : "Nelder-Mead simplex")
+			<< ") took " << ConfocalOptimizationNumMeasurements << " count rate measurements in "
+			<< std::fixed << std::setprecision(1) << Duration << " s.";
+
+		Util::EventLog().Log(Message.str());
 	}
 
 	void WidefieldMicroscope::SetHBTSwitch(Util::SynchronizedPointer<const ParamsType>& ModuleParams,
@@ -1166,6 +1464,10 @@ namespace DynExpModule::Widefield
 		ModuleData->SetAutoMeasureRunning(true);
 		ModuleData->SetAutoMeasureCurrentCellPosition(ModuleData->GetSamplePosition());
 
+		AutoMeasurePhaseTimes.Reset();
+		AutoMeasureSpectrumPending = false;
+		AutoMeasureHBTSwitchPreset = false;
+
 		LogUIMessagesOnly = true;
 
 		StateMachine.SetContext(IsCharacterizingSample() ? &AutoMeasureSampleCharacterizationContext : &AutoMeasureCharacterizationContext);
@@ -1188,6 +1490,43 @@ namespace DynExpModule::Widefield
 		return StateType::AutoMeasureSampleStep;
 	}
 
+	bool WidefieldMicroscope::IsAutoMeasureOptimizing(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const
+	{
+		return ModuleData->GetAutoMeasureOptimizeEnabled() && ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::ConfocalOptimization) &&
+			ModuleData->GetSetupMode() == WidefieldMicroscopeData::SetupModeType::Confocal;
+	}
+
+	/**
+	 * @brief Determines whether the spectrum and HBT data of an emitter can be recorded simultaneously.
+	 * This is the case if both are to be recorded and if there is no HBT switch directing the light either
+	 * to the spectrometer or to the SPDs.
+	 * @param ModuleData Locked module data
+	 * @return True if the spectrum and HBT data can be recorded in parallel, false otherwise.
+	*/
+	bool WidefieldMicroscope::CanOverlapAutoMeasureSpectrumAndHBT(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const
+	{
+		return ModuleData->GetAutoMeasureSpectrumEnabled() && ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::InterModuleCommunicator) &&
+			ModuleData->GetAutoMeasureHBTEnabled() && ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::HBT) &&
+			!ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::HBTSwitch);
+	}
+
+	void WidefieldMicroscope::FinishAutoMeasurePhaseTimes(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const
+	{
+		AutoMeasurePhaseTimes.Begin(AutoMeasurePhaseType::Saving);
+		AutoMeasureWriter.WaitUntilFinished();
+		AutoMeasurePhaseTimes.End();
+
+		Util::EventLog().Log("Emitter characterization finished. " + AutoMeasurePhaseTimes.ToStr());
+
+		std::stringstream CSVData;
+		CSVData = ModuleData->AssembleCSVHeader(false, false, true);
+		AutoMeasurePhaseTimes.WriteCSV(CSVData);
+
+		// Saved in the background like the other results. AutoMeasureWriter waits for it at the latest when being destroyed.
+		AutoMeasureWriter.Enqueue(QString::fromUtf16(BuildFilename(ModuleData, "_PhaseTimes.csv").u16string().c_str()), CSVData.str(),
+			"Saving the phase times failed.");
+	}
+
 	std::filesystem::path WidefieldMicroscope::BuildFilename(Util::SynchronizedPointer<ModuleDataType>& ModuleData, std::string_view FilenameSuffix) const
 	{
 		auto SavePath = ModuleData->GetAutoMeasureSavePath();
@@ -1464,10 +1803,13 @@ namespace DynExpModule::Widefield
 		auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance->ModuleDataGetter());
 
 		// Firstly, stop moving parts.
+		ConfocalScanScheduler.Cancel();
 		if (ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::Confocal))
 		{
 			ModuleData->GetSampleStageX()->StopMotion();
 			ModuleData->GetSampleStageY()->StopMotion();
+
+			FinishConfocalLineScan(ModuleData);
 		}
 
 		if (ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::Widefield))
@@ -1806,6 +2148,12 @@ namespace DynExpModule::Widefield
 		ModuleData->SetSPDExposureTime(std::chrono::milliseconds(Value));
 	}
 
+	void WidefieldMicroscope::OnToggleConfocalScanContinuous(DynExp::ModuleInstance* Instance, int State) const
+	{
+		auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance->ModuleDataGetter());
+		ModuleData->SetConfocalScanContinuous(State);
+	}
+
 	void WidefieldMicroscope::OnConfocalOptimizationInitXYStepSizeChanged(DynExp::ModuleInstance* Instance, double Value) const
 	{
 		auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance->ModuleDataGetter());
@@ -1824,9 +2172,16 @@ namespace DynExpModule::Widefield
 		ModuleData->SetConfocalOptimizationTolerance(Value);
 	}
 
+	void WidefieldMicroscope::OnConfocalOptimizationMethodChanged(DynExp::ModuleInstance* Instance, int Value) const
+	{
+		auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance->ModuleDataGetter());
+		ModuleData->SetConfocalOptimizationMethod(static_cast<WidefieldMicroscopeWidget::ConfocalOptimizationMethodType>(Value));
+	}
+
 	void WidefieldMicroscope::OnPerformConfocalScan(DynExp::ModuleInstance* Instance, bool) const
 	{
 		int Width{}, Height{}, DistPerPixel{};
+		bool ScanContinuously = false;
 		WidefieldMicroscopeData::PositionPoint CenterPosition{ 0, 0 };
 
 		OnGoToHomePosition(Instance, false);
@@ -1845,6 +2200,18 @@ namespace DynExpModule::Widefield
 
 			PrepareAPDsForConfocalMode(ModuleData);
 
+			ScanContinuously = ModuleData->GetConfocalScanContinuous();
+			if (ScanContinuously)
+			{
+				ConfocalLineScan.Reset();
+				ConfocalLineScan.IsActive = true;
+
+				auto Velocity = DynExp::dynamic_InstrumentData_cast<DynExpInstr::PositionerStage>(ModuleData->GetSampleStageX()->GetInstrumentData())->GetVelocity();
+				ConfocalLineScan.OriginalVelocity = Velocity > 0 ? Velocity : ModuleData->GetSampleStageX()->GetDefaultVelocity();
+
+				PrepareAPDsForConfocalLineScan(ModuleData);
+			}
+
 			ModuleData->ClearConfocalScanResults();
 
 		} // ModuleData unlocked here.
@@ -1852,10 +2219,18 @@ namespace DynExpModule::Widefield
 		// ModuleData unlocked for this call, because it is potentially heavy.
 		auto SurfaceDataRows = CalculateConfocalScanPositions(Width, Height, DistPerPixel, CenterPosition);
 
-		auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance->ModuleDataGetter());
-		ModuleData->SetConfocalScanSurfacePlotRows(std::move(SurfaceDataRows));
+		{
+			auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance->ModuleDataGetter());
+			ModuleData->SetConfocalScanSurfacePlotRows(std::move(SurfaceDataRows));
+		} // ModuleData unlocked here since the coroutine locks it on its own.
 
-		StateMachine.SetCurrentState(StateType::ConfocalScanStep);
+		if (ScanContinuously)
+			StateMachine.SetCurrentState(StateType::ConfocalLineScanStep);
+		else
+		{
+			StateMachine.SetCurrentState(StateType::ConfocalScanRunning);
+			ConfocalScanScheduler.Start(ConfocalScanCoroutine(*Instance));
+		}
 	}
 
 	void WidefieldMicroscope::ConfocalSurfaceSelectedPointChanged(DynExp::ModuleInstance* Instance, QPoint Position) const
@@ -1943,6 +2318,14 @@ namespace DynExpModule::Widefield
 
 	void WidefieldMicroscope::OnSpectrumFinishedRecording(DynExp::ModuleInstance* Instance) const
 	{
+		// If the spectrum has been recorded in parallel to HBT data, do not interrupt the HBT acquisition.
+		if (AutoMeasureSpectrumPending)
+		{
+			AutoMeasureSpectrumPending = false;
+
+			return;
+		}
+
 		StateMachine.SetCurrentState(StateType::SpectrumAcquisitionFinished);
 	}
 
@@ -2547,8 +2930,239 @@ namespace DynExpModule::Widefield
 		return StateType::ConfocalScanWaitUntilCaptured;
 	}
 
+	// Performs the same steps as the states ConfocalScanStep to ConfocalScanWaitUntilCaptured for all of ConfocalScanPositions.
+	DynExp::ModuleCoroutine WidefieldMicroscope::ConfocalScanCoroutine(DynExp::ModuleInstance& Instance) const
+	{
+		while (!ConfocalScanPositions.empty())
+		{
+			auto& Position = ConfocalScanPositions.front();
+			std::vector<DynExp::TaskFuture> MoveFutures;
+			bool UsingSPD2 = false;
+
+			{
+				auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
+				UsingSPD2 = ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::HBT);
+
+				ModuleData->GetSampleStageX()->UpdateData();
+				ModuleData->GetSampleStageY()->UpdateData();
+				MoveFutures = MoveSampleXYToAsync(Position, ModuleData);
+			} // ModuleData unlocked here.
+
+			// Resumed as soon as the stages have started moving.
+			for (const auto& Future : MoveFutures)
+				co_await Future;
+
+			// The stages do not signal their arrival. So, check it once per main loop iteration.
+			if (!MoveFutures.empty())
+				co_await DynExp::WaitUntil([this, &Instance]() {
+					auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
+					auto SampleStageXData = DynExp::dynamic_InstrumentData_cast<DynExpInstr::PositionerStage>(ModuleData->GetSampleStageX()->GetInstrumentData());
+					auto SampleStageYData = DynExp::dynamic_InstrumentData_cast<DynExpInstr::PositionerStage>(ModuleData->GetSampleStageY()->GetInstrumentData());
+
+					return SampleStageXData->HasArrived() && SampleStageYData->HasArrived();
+				});
+
+			{
+				auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
+
+				auto MeasuredPos = ModuleData->GetSamplePosition();
+				Position.MeasuredX = MeasuredPos.x;
+				Position.MeasuredY = MeasuredPos.y;
+
+				ModuleData->ResetSPD1State();
+				ModuleData->ResetSPD2State();
+
+				{
+					auto SPD1Data = DynExp::dynamic_InstrumentData_cast<DynExpInstr::TimeTagger>(ModuleData->GetSPD1()->GetInstrumentData());
+					ModuleData->SetSPD1SamplesWritten(SPD1Data->GetCastSampleStream<DynExpInstr::TimeTaggerData::SampleStreamType>()->GetNumSamplesWritten());
+				} // SPD1Data unlocked here.
+
+				if (UsingSPD2)
+				{
+					auto SPD2Data = DynExp::dynamic_InstrumentData_cast<DynExpInstr::TimeTagger>(ModuleData->GetSPD2()->GetInstrumentData());
+					ModuleData->SetSPD2SamplesWritten(SPD2Data->GetCastSampleStream<DynExpInstr::TimeTaggerData::SampleStreamType>()->GetNumSamplesWritten());
+				} // SPD2Data unlocked here.
+			} // ModuleData unlocked here.
+
+			// Skips first sample to be sure that the sample read has entirely been captured at the most recent sample stages' positions.
+			// The condition is checked as soon as the SPDs' read tasks have completed.
+			co_await DynExp::WaitUntil(
+				[this, &Instance, UsingSPD2]() {
+					auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
+
+					{
+						auto SPD1Data = DynExp::dynamic_InstrumentData_cast<DynExpInstr::TimeTagger>(ModuleData->GetSPD1()->GetInstrumentData());
+						auto SPD1DataSampleStream = SPD1Data->GetCastSampleStream<DynExpInstr::TimeTaggerData::SampleStreamType>();
+						if (SPD1DataSampleStream->GetNumSamplesWritten() >= ModuleData->GetSPD1SamplesWritten() + 2)
+							ModuleData->SetSPD1Ready(SPD1DataSampleStream->ReadSample().Value);
+					} // SPD1Data unlocked here.
+
+					if (UsingSPD2)
+					{
+						auto SPD2Data = DynExp::dynamic_InstrumentData_cast<DynExpInstr::TimeTagger>(ModuleData->GetSPD2()->GetInstrumentData());
+						auto SPD2DataSampleStream = SPD2Data->GetCastSampleStream<DynExpInstr::TimeTaggerData::SampleStreamType>();
+						if (SPD2DataSampleStream->GetNumSamplesWritten() >= ModuleData->GetSPD2SamplesWritten() + 2)
+							ModuleData->SetSPD2Ready(SPD2DataSampleStream->ReadSample().Value);
+					} // SPD2Data unlocked here.
+
+					return ModuleData->GetSPD1Ready() && (!UsingSPD2 || ModuleData->GetSPD2Ready());
+				},
+				[this, &Instance, UsingSPD2]() {
+					auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
+
+					std::vector<DynExp::TaskFuture> ReadFutures{ ModuleData->GetSPD1()->AsAsyncTask(&DynExpInstr::DataStreamInstrument::ReadData) };
+					if (UsingSPD2)
+						ReadFutures.push_back(ModuleData->GetSPD2()->AsAsyncTask(&DynExpInstr::DataStreamInstrument::ReadData));
+
+					return ReadFutures;
+				}
+			);
+
+			{
+				auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
+
+				auto ExposureTime = ModuleData->GetSPDExposureTime().count();
+				double CountRate = (ModuleData->GetSPD1Value() + ModuleData->GetSPD2Value())
+					/ ExposureTime * WidefieldMicroscope::ModuleDataType::SPDTimeType::period::den;
+
+				ModuleData->GetConfocalScanResults().emplace_back(Position, CountRate);
+				ModuleData->SetLastCountRate(CountRate);
+			} // ModuleData unlocked here.
+
+			ConfocalScanPositions.pop_front();
+		}
+	}
+
+	StateType WidefieldMicroscope::ConfocalScanRunningStateFunc(DynExp::ModuleInstance& Instance)
+	{
+		// ConfocalScanCoroutine() is mainly resumed by events signaling completed instrument tasks.
+		// Only conditions which cannot be signaled (e.g. the stages' arrival) are checked here.
+		return ConfocalScanScheduler.Poll() ? StateType::ConfocalScanRunning : StateType::Ready;
+	}
+
+	StateType WidefieldMicroscope::ConfocalLineScanStepStateFunc(DynExp::ModuleInstance& Instance)
+	{
+		auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
+
+		if (ConfocalScanPositions.empty())
+		{
+			FinishConfocalLineScan(ModuleData);
+
+			return StateType::Ready;
+		}
+
+		// CalculateConfocalScanPositions() orders the positions of each line in the scanning direction.
+		ConfocalLineScan.Pixels.clear();
+		const auto RowIndex = ConfocalScanPositions.front().RowIndex;
+		while (!ConfocalScanPositions.empty() && ConfocalScanPositions.front().RowIndex == RowIndex)
+		{
+			ConfocalLineScan.Pixels.push_back(ConfocalScanPositions.front());
+			ConfocalScanPositions.pop_front();
+		}
+
+		const auto& FirstPixel = ConfocalLineScan.Pixels.front();
+		const auto& LastPixel = ConfocalLineScan.Pixels.back();
+		ConfocalLineScan.DistPerPixel = LastPixel.x < FirstPixel.x ? -ModuleData->GetConfocalScanDistPerPixel() : ModuleData->GetConfocalScanDistPerPixel();
+		ConfocalLineScan.LineStartX = FirstPixel.x - ConfocalLineScan.DistPerPixel / 2;
+
+		// Move to the beginning of the line (including the run-up distance) as fast as usual.
+		ModuleData->GetSampleStageX()->SetVelocity(ConfocalLineScan.OriginalVelocity);
+		ModuleData->GetSampleStageX()->UpdateData();
+		ModuleData->GetSampleStageY()->UpdateData();
+		MoveSampleTo({ Util::NumToT<WidefieldMicroscopeData::PositionType>(ConfocalLineScan.LineStartX - ConfocalLineScanRunUpDistInPixels * ConfocalLineScan.DistPerPixel),
+			FirstPixel.y }, ModuleData);
+
+		return StateType::ConfocalLineScanWaitUntilAtLineStart;
+	}
+
+	StateType WidefieldMicroscope::ConfocalLineScanWaitUntilAtLineStartStateFunc(DynExp::ModuleInstance& Instance)
+	{
+		auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
+		if (IsSampleMoving(ModuleData))
+			return StateType::ConfocalLineScanWaitUntilAtLineStart;
+
+		ConfocalLineScan.MeasuredY = ModuleData->GetSamplePosition().y;
+		ConfocalLineScan.PositionTrace.clear();
+		ConfocalLineScan.SPD1CountTrace.clear();
+		ConfocalLineScan.SPD2CountTrace.clear();
+		ConfocalLineScan.LastPositionUpdateRequest = {};
+
+		// Only count samples recorded from now on belong to the current line.
+		{
+			auto SPD1Data = DynExp::dynamic_InstrumentData_cast<DynExpInstr::TimeTagger>(ModuleData->GetSPD1()->GetInstrumentData());
+			ConfocalLineScan.SPD1SamplesRead = SPD1Data->GetCastSampleStream<DynExpInstr::TimeTaggerData::SampleStreamType>()->GetNumSamplesWritten();
+		} // SPD1Data unlocked here.
+		if (ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::HBT))
+		{
+			auto SPD2Data = DynExp::dynamic_InstrumentData_cast<DynExpInstr::TimeTagger>(ModuleData->GetSPD2()->GetInstrumentData());
+			ConfocalLineScan.SPD2SamplesRead = SPD2Data->GetCastSampleStream<DynExpInstr::TimeTaggerData::SampleStreamType>()->GetNumSamplesWritten();
+		} // SPD2Data unlocked here.
+		{
+			auto SampleStageXData = DynExp::dynamic_InstrumentData_cast<DynExpInstr::PositionerStage>(ModuleData->GetSampleStageX()->GetInstrumentData());
+			ConfocalLineScan.UsingStagePositionTrace = SampleStageXData->IsPositionTraceEnabled();
+			if (ConfocalLineScan.UsingStagePositionTrace)
+				ConfocalLineScan.StagePositionTraceSamplesRead = SampleStageXData->GetPositionTrace().GetNumSamplesWritten();
+		} // SampleStageXData unlocked here.
+
+		// The confocal spot is supposed to cross a pixel within the SPD exposure time.
+		const auto& SampleStageX = ModuleData->GetSampleStageX();
+		const auto Velocity = std::abs(ConfocalLineScan.DistPerPixel) / std::chrono::duration<double>(ModuleData->GetSPDExposureTime()).count()
+			/ SampleStageX->GetStepNanoMeterRatio();
+		SampleStageX->SetVelocity(std::max(SampleStageX->GetMinVelocity(), std::min(SampleStageX->GetMaxVelocity(),
+			Util::NumToT<WidefieldMicroscopeData::PositionType>(Velocity))));
+
+		const auto LineEndX = ConfocalLineScan.LineStartX + ConfocalLineScan.Pixels.size() * ConfocalLineScan.DistPerPixel;
+		MoveSampleTo({ Util::NumToT<WidefieldMicroscopeData::PositionType>(LineEndX + ConfocalLineScanRunUpDistInPixels * ConfocalLineScan.DistPerPixel),
+			ConfocalLineScan.Pixels.back().y }, ModuleData);
+
+		return StateType::ConfocalLineScanAcquiring;
+	}
+
+	StateType WidefieldMicroscope::ConfocalLineScanAcquiringStateFunc(DynExp::ModuleInstance& Instance)
+	{
+		auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
+		const auto Now = ConfocalLineScanType::ClockType::now();
+
+		ReadConfocalLineScanCounts(ModuleData, ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::HBT));
+
+		// Sample the position here only if the stage does not record a timestamped position trace itself.
+		if (!ConfocalLineScan.UsingStagePositionTrace)
+		{
+			{
+				auto SampleStageXData = DynExp::dynamic_InstrumentData_cast<DynExpInstr::PositionerStage>(ModuleData->GetSampleStageX()->GetInstrumentData());
+				const auto X = Util::NumToT<WidefieldMicroscopeData::PositionType>(SampleStageXData->GetCurrentPosition() * ModuleData->GetSampleStageX()->GetStepNanoMeterRatio());
+
+				// Only record changes of the position to interpolate linearly in between them.
+				if (ConfocalLineScan.PositionTrace.empty() || ConfocalLineScan.PositionTrace.back().X != X)
+					ConfocalLineScan.PositionTrace.push_back({ Now, X });
+			} // SampleStageXData unlocked here.
+
+			if (Now - ConfocalLineScan.LastPositionUpdateRequest >= ConfocalLineScanPositionUpdateInterval)
+			{
+				ModuleData->GetSampleStageX()->UpdateData();
+				ConfocalLineScan.LastPositionUpdateRequest = Now;
+			}
+		}
+
+		if (IsSampleMoving(ModuleData))
+			return StateType::ConfocalLineScanAcquiring;
+
+		if (ConfocalLineScan.UsingStagePositionTrace)
+			ReadConfocalLineScanStagePositionTrace(ModuleData);
+		BinConfocalLineScan(ModuleData);
+
+		return StateType::ConfocalLineScanStep;
+	}
+
 	StateType WidefieldMicroscope::ConfocalOptimizationInitStateFunc(DynExp::ModuleInstance& Instance)
 	{
+		if (ConfocalOptimizationMethodInUse == WidefieldMicroscopeWidget::ConfocalOptimizationMethodType::GaussianPSFFit)
+		{
+			auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
+
+			return MeasureNextConfocalPSFOptimizationPoint(ModuleData);
+		}
+
 		ConfocalOptimizationInitPromises();
 
 		ConfocalOptimizationThreadReturnFuture = std::async(std::launch::async, &WidefieldMicroscope::ConfocalOptimizationThread, this);
@@ -2592,6 +3206,28 @@ namespace DynExpModule::Widefield
 		static constexpr const char* OptimizationMaxIterReachedErrorMsg = "Optimizing confocal count rate failed - maximal number of iterations reached!";
 		static constexpr const char* OptimizationFailedErrorMsg = "Optimizing confocal count rate failed!";
 
+		++ConfocalOptimizationNumMeasurements;
+
+		if (ConfocalOptimizationMethodInUse == WidefieldMicroscopeWidget::ConfocalOptimizationMethodType::GaussianPSFFit)
+		{
+			auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
+
+			const auto Result = ConfocalPSFOptimization.ReportCountRate(ModuleData->GetLastCountRate());
+			if (Result == ConfocalPSFOptimizer::ResultType::NextPoint)
+				return MeasureNextConfocalPSFOptimizationPoint(ModuleData);
+			if (Result == ConfocalPSFOptimizer::ResultType::Failed)
+			{
+				if (LogUIMessagesOnly)
+					Util::EventLog().Log(OptimizationFailedErrorMsg, Util::ErrorType::Error);
+				else
+					ModuleData->SetUIMessage(OptimizationFailedErrorMsg);
+			}
+
+			LogConfocalOptimizationStatistics();
+
+			return StateType::ConfocalOptimizationFinished;
+		}
+
 		{
 			auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
 
@@ -2626,6 +3262,8 @@ namespace DynExpModule::Widefield
 					ModuleData->SetUIMessage(OptimizationFailedErrorMsg);
 			}
 
+			LogConfocalOptimizationStatistics();
+
 			return StateType::ConfocalOptimizationFinished;
 		}
 		
@@ -2761,7 +3399,7 @@ namespace DynExpModule::Widefield
 		auto ModuleParams = DynExp::dynamic_Params_cast<WidefieldMicroscope>(Instance.ParamsGetter());
 		auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
 
-		// Save the emitter list after characterizing each emitter.
+		// Save the emitter list after characterizing each emitter. Saving overlaps with moving to the next emitter.
 		std::stringstream CSVData;
 		CSVData = ModuleData->AssembleCSVHeader(false, false, true);
 		CSVData << "ID;X(px);Y(px);State\n";
@@ -2771,14 +3409,15 @@ namespace DynExpModule::Widefield
 			CSVData << Position.first << ";" << Position.second.Position.x() << ";" << Position.second.Position.y() << ";"
 			<< WidefieldMicroscopeData::GetLocalizedEmitterStateString(Position.second.State) << "\n";
 
-		if (!Util::SaveToFile(QString::fromUtf16(BuildFilename(ModuleData, "_Emitters.csv").u16string().c_str()), CSVData.str()))
-			Util::EventLogger().Log("Saving the emitter list failed.", Util::ErrorType::Error);
+		AutoMeasureWriter.Enqueue(QString::fromUtf16(BuildFilename(ModuleData, "_Emitters.csv").u16string().c_str()), CSVData.str(),
+			"Saving the emitter list failed.");
 
 		if (ModuleData->GetAutoMeasureCurrentEmitter() == ModuleData->GetLocalizedPositions().cend())
 		{
 			if (ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::PumpLightToggle))
 				ModuleData->SetPumpLightTurnedOn(false);
 
+			FinishAutoMeasurePhaseTimes(ModuleData);
 			ModuleData->SetAutoMeasureRunning(false);
 
 			return StateType::AutoMeasureCharacterizationFinished;
@@ -2793,6 +3432,15 @@ namespace DynExpModule::Widefield
 		ModuleData->SetLocalizedPositionsStateChanged();
 		BringMarkerToConfocalSpot(ModuleParams, ModuleData, ModuleData->GetAutoMeasureCurrentEmitter()->second.Position,
 			{ static_cast<qreal>(ModuleData->GetWidefieldPosition().x), static_cast<qreal>(ModuleData->GetWidefieldPosition().y) });
+		AutoMeasurePhaseTimes.Begin(AutoMeasurePhaseType::Moving);
+
+		// Let the HBT switch perform its transition while the sample is moving.
+		AutoMeasureHBTSwitchPreset = IsAutoMeasureOptimizing(ModuleData) && ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::HBTSwitch);
+		if (AutoMeasureHBTSwitchPreset)
+		{
+			SetHBTSwitch(ModuleParams, ModuleData, true);
+			AutoMeasureHBTSwitchSettledTimePoint = std::chrono::system_clock::now() + std::chrono::milliseconds(ModuleParams->WidefieldHBTTransitionTime);
+		}
 
 		ModuleData->ResetAutoMeasureCurrentOptimizationAttempt();
 
@@ -2807,17 +3455,25 @@ namespace DynExpModule::Widefield
 		if (IsSampleMoving(ModuleData))
 			return StateType::AutoMeasureCharacterizationGotoEmitter;
 
-		if (ModuleData->GetAutoMeasureOptimizeEnabled() && ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::ConfocalOptimization) &&
-			ModuleData->GetSetupMode() == WidefieldMicroscopeData::SetupModeType::Confocal)
+		if (IsAutoMeasureOptimizing(ModuleData))
 		{
+			AutoMeasurePhaseTimes.Begin(AutoMeasurePhaseType::Optimizing);
+
 			ModuleData->ResetAutoMeasureCurrentOptimizationRerun();
 			InitializeConfocalOptimizer(ModuleData);
 
 			if (ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::HBTSwitch))
 			{
-				SetHBTSwitch(ModuleParams, ModuleData, true);
+				// Only wait for the remaining transition time if the switch has already been set while moving.
+				if (AutoMeasureHBTSwitchPreset)
+					WaitingEndTimePoint = AutoMeasureHBTSwitchSettledTimePoint;
+				else
+				{
+					SetHBTSwitch(ModuleParams, ModuleData, true);
 
-				WaitingEndTimePoint = std::chrono::system_clock::now() + std::chrono::milliseconds(ModuleParams->WidefieldHBTTransitionTime);
+					WaitingEndTimePoint = std::chrono::system_clock::now() + std::chrono::milliseconds(ModuleParams->WidefieldHBTTransitionTime);
+				}
+				AutoMeasureHBTSwitchPreset = false;
 
 				StateMachine.SetContext(IsCharacterizingSample() ? &AutoMeasureSampleCharacterizationOptimizationContext : &AutoMeasureCharacterizationOptimizationContext);
 				return StateType::Waiting;
@@ -2841,6 +3497,9 @@ namespace DynExpModule::Widefield
 			EmitterDestiny.DistTo(ModuleData->GetSamplePosition()) <= ModuleData->GetAutoMeasureOptimizationMaxDistance())
 		{
 			// Optimization succeeded.
+			if (CanOverlapAutoMeasureSpectrumAndHBT(ModuleData))
+				return StateType::AutoMeasureCharacterizationSpectrumHBTBegin;
+
 			if (ModuleData->GetAutoMeasureSpectrumEnabled() && ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::InterModuleCommunicator))
 			{
 				if (ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::HBTSwitch))
@@ -2859,8 +3518,7 @@ namespace DynExpModule::Widefield
 				return StateType::AutoMeasureCharacterizationSpectrumFinished;
 		}
 
-		if (ModuleData->GetAutoMeasureOptimizeEnabled() && ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::ConfocalOptimization) &&
-			ModuleData->GetSetupMode() == WidefieldMicroscopeData::SetupModeType::Confocal)
+		if (IsAutoMeasureOptimizing(ModuleData))
 		{
 			if (ModuleData->IncrementAutoMeasureCurrentOptimizationRerun() >= ModuleData->GetAutoMeasureMaxOptimizationReruns())
 			{
@@ -2891,6 +3549,7 @@ namespace DynExpModule::Widefield
 	{
 		auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
 
+		AutoMeasurePhaseTimes.Begin(AutoMeasurePhaseType::Spectrum);
 		ModuleData->GetAcqCommunicator()->PostEvent(*this, SpectrumViewer::RecordSpectrumEvent {
 			BuildFilename(ModuleData, "_Emitter" + Util::ToStr(ModuleData->GetAutoMeasureCurrentEmitter()->first) + "_Spectrum.csv").string() });
 
@@ -2928,6 +3587,7 @@ namespace DynExpModule::Widefield
 	{
 		auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
 
+		AutoMeasurePhaseTimes.Begin(AutoMeasurePhaseType::HBT);
 		InitializeHBT(ModuleData);
 
 		return StateType::AutoMeasureCharacterizationHBTWaitForInit;
@@ -2956,16 +3616,47 @@ namespace DynExpModule::Widefield
 		auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
 
 		auto Filename = BuildFilename(ModuleData, "_Emitter" + Util::ToStr(ModuleData->GetAutoMeasureCurrentEmitter()->first) + "_g2.csv");
-		std::stringstream CSVData;
 
-		CSVData = ModuleData->AssembleCSVHeader(false, true, false);
-		ModuleData->WriteHBTResults(CSVData);
+		AutoMeasureWriter.Enqueue(QString::fromUtf16(Filename.u16string().c_str()), ModuleData->MakeHBTResultsWriter(Util::DataFileWriter::FormatType::CSV),
+			"Saving the g2 result failed.");
+
+		// The spectrometer might still be recording if the spectrum is recorded in parallel.
+		if (AutoMeasureSpectrumPending)
+			return StateType::AutoMeasureCharacterizationWaitForSpectrum;
 
 		ModuleData->GetAutoMeasureCurrentEmitter()->second.State = WidefieldMicroscopeData::LocalizedEmitterStateType::Finished;
 		ModuleData->SetLocalizedPositionsStateChanged();
 
-		if (!Util::SaveToFile(QString::fromUtf16(Filename.u16string().c_str()), CSVData.str()))
-			Util::EventLogger().Log("Saving the g2 result failed.", Util::ErrorType::Error);
+		ModuleData->IncrementAutoMeasureCurrentEmitter();
+		return StateType::AutoMeasureCharacterizationStep;
+	}
+
+	StateType WidefieldMicroscope::AutoMeasureCharacterizationSpectrumHBTBeginStateFunc(DynExp::ModuleInstance& Instance)
+	{
+		auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
+
+		AutoMeasurePhaseTimes.Begin(AutoMeasurePhaseType::SpectrumAndHBT);
+
+		// Record the spectrum while acquiring HBT data. OnSpectrumFinishedRecording() resets AutoMeasureSpectrumPending
+		// without leaving the HBT acquisition. Finally, AutoMeasureCharacterizationHBTFinishedStateFunc() awaits the spectrum.
+		AutoMeasureSpectrumPending = true;
+		ModuleData->GetAcqCommunicator()->PostEvent(*this, SpectrumViewer::RecordSpectrumEvent {
+			BuildFilename(ModuleData, "_Emitter" + Util::ToStr(ModuleData->GetAutoMeasureCurrentEmitter()->first) + "_Spectrum.csv").string() });
+
+		InitializeHBT(ModuleData);
+
+		return StateType::AutoMeasureCharacterizationHBTWaitForInit;
+	}
+
+	StateType WidefieldMicroscope::AutoMeasureCharacterizationWaitForSpectrumStateFunc(DynExp::ModuleInstance& Instance)
+	{
+		if (AutoMeasureSpectrumPending)
+			return StateType::AutoMeasureCharacterizationWaitForSpectrum;
+
+		auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(Instance.ModuleDataGetter());
+
+		ModuleData->GetAutoMeasureCurrentEmitter()->second.State = WidefieldMicroscopeData::LocalizedEmitterStateType::Finished;
+		ModuleData->SetLocalizedPositionsStateChanged();
 
 		ModuleData->IncrementAutoMeasureCurrentEmitter();
 		return StateType::AutoMeasureCharacterizationStep;
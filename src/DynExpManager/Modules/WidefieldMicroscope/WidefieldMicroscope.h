@@ -9,6 +9,7 @@
 
 #include "stdafx.h"
 #include "DynExpCore.h"
+#include "../../ModuleCoroutine.h"
 #include "../../MetaInstruments/Stage.h"
 #include "../../MetaInstruments/DigitalOut.h"
 #include "../../MetaInstruments/DigitalIn.h"
@@ -22,6 +23,8 @@
 #include "../../Modules/SpectrumViewer/SpectrumViewerEvents.h"
 
 #include "WidefieldMicroscopeWidget.h"
+#include "AutoMeasurePipeline.h"
+#include "ConfocalPSFOptimizer.h"
 
 namespace DynExpModule::Widefield
 {
@@ -154,8 +157,8 @@ namespace DynExpModule::Widefield
 
 		PositionPoint GetSamplePosition() const;
 		std::stringstream AssembleCSVHeader(bool IncludeConfocalScan, bool IncludeHBT, bool IncludeAutoMeasure) const;
-		void WriteConfocalScanResults(std::stringstream& Stream) const;
-		void WriteHBTResults(std::stringstream& Stream) const;
+		Util::AsyncFileWriter::JobFuncType MakeConfocalScanResultsWriter(Util::DataFileWriter::FormatType Format) const;
+		Util::AsyncFileWriter::JobFuncType MakeHBTResultsWriter(Util::DataFileWriter::FormatType Format) const;
 
 		SetupModeType GetSetupMode() const noexcept { return SetupMode; }
 		void SetSetupMode(SetupModeType NewMode) noexcept { SetupMode = NewMode; }
@@ -232,6 +235,8 @@ namespace DynExpModule::Widefield
 		void SetConfocalScanHeight(int Length) noexcept { ConfocalScanHeight = Length; }
 		int GetConfocalScanDistPerPixel() const noexcept { return ConfocalScanDistPerPixel; }
 		void SetConfocalScanDistPerPixel(int DistPerPixel) noexcept { ConfocalScanDistPerPixel = DistPerPixel; }
+		bool GetConfocalScanContinuous() const noexcept { return ConfocalScanContinuous; }
+		void SetConfocalScanContinuous(bool Continuous) noexcept { ConfocalScanContinuous = Continuous; }
 		SPDTimeType GetSPDExposureTime() const noexcept { return SPDExposureTime; }
 		void SetSPDExposureTime(SPDTimeType Time) noexcept { SPDExposureTime = Time; }
 		auto GetSPD1SamplesWritten() const noexcept { return SPD1State.StreamSamplesWritten; }
@@ -261,6 +266,8 @@ namespace DynExpModule::Widefield
 		void SetConfocalOptimizationInitZStepSize(double StepSize) noexcept { ConfocalOptimizationInitZStepSize = StepSize; }
 		double GetConfocalOptimizationTolerance() const noexcept { return ConfocalOptimizationTolerance; }
 		void SetConfocalOptimizationTolerance(double Tolerance) noexcept { ConfocalOptimizationTolerance = Tolerance; }
+		auto GetConfocalOptimizationMethod() const noexcept { return ConfocalOptimizationMethod; }
+		void SetConfocalOptimizationMethod(WidefieldMicroscopeWidget::ConfocalOptimizationMethodType Method) noexcept { ConfocalOptimizationMethod = Method; }
 		double GetLastCountRate() const noexcept { return LastCountRate; }
 		void SetLastCountRate(double CountRate) noexcept { LastCountRate = CountRate; }
 
@@ -401,6 +408,7 @@ namespace DynExpModule::Widefield
 		int ConfocalScanWidth;
 		int ConfocalScanHeight;
 		int ConfocalScanDistPerPixel;
+		bool ConfocalScanContinuous;					//!< Determines whether lines are scanned continuously instead of pixel by pixel.
 		SPDTimeType SPDExposureTime;
 		SPDStateType SPD1State;
 		SPDStateType SPD2State;
@@ -409,6 +417,7 @@ namespace DynExpModule::Widefield
 		double ConfocalOptimizationInitXYStepSize;
 		double ConfocalOptimizationInitZStepSize;
 		double ConfocalOptimizationTolerance;
+		WidefieldMicroscopeWidget::ConfocalOptimizationMethodType ConfocalOptimizationMethod;
 		double LastCountRate;
 
 		// vector of pairs <sample stage positions in nm, count rate in Hz>
@@ -611,7 +620,11 @@ namespace DynExpModule::Widefield
 		StateType InitiateReadCellIDFromImage(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
 		StateType InitiateLocalizationFromImage(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
 		void PrepareAPDsForConfocalMode(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
+		void PrepareAPDsForConfocalLineScan(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
+		void FinishConfocalLineScan(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
 		void InitializeConfocalOptimizer(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
+		StateType MeasureNextConfocalPSFOptimizationPoint(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
+		void LogConfocalOptimizationStatistics() const;
 		void SetHBTSwitch(Util::SynchronizedPointer<const ParamsType>& ModuleParams,
 			Util::SynchronizedPointer<ModuleDataType>& ModuleData, bool IsHBTMode) const;
 		void InitializeHBT(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
@@ -620,10 +633,80 @@ namespace DynExpModule::Widefield
 		StateType StartAutoMeasureLocalization(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
 		StateType StartAutoMeasureCharacterization(Util::SynchronizedPointer<ModuleDataType>& ModuleData, Util::MarkerGraphicsView::MarkerType::IDType FirstEmitterID = -1) const;
 		StateType StartAutoMeasureSampleCharacterization(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
+		bool IsAutoMeasureOptimizing(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
+		bool CanOverlapAutoMeasureSpectrumAndHBT(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
+		void FinishAutoMeasurePhaseTimes(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
 		std::filesystem::path BuildFilename(Util::SynchronizedPointer<ModuleDataType>& ModuleData, std::string_view FilenameSuffix) const;
 		ModuleDataType::PositionPoint RandomPointInCircle(ModuleDataType::PositionType Radius) const;	//!< Returns a uniformly-distributed random coordinate within a circle of radius @p Radius, not thread-safe.
 		// <-
 
+		// Types and functions for continuous confocal scans moving the sample stage at constant velocity along each line
+		// ->
+		/**
+		 * @brief State of the line being acquired by a continuous confocal scan. Count samples are
+		 * mapped to the sample position by interpolating the position trace recorded while the sample
+		 * stage moves along the line. SPDs which timestamp their count samples (refer to
+		 * DynExpInstr::TimeTaggerData::AreCountsTimestamped()) do so with the end of each sample's exposure
+		 * interval (refer to DynExpInstr::TimeTaggerData::GetCountsStartTime()), which is converted to
+		 * the center of the exposure interval on #ClockType. Samples of other SPDs are timestamped when
+		 * they are read, assuming they have been recorded back to back until then. If sample stage X
+		 * records a position trace itself (refer to DynExpInstr::PositionerStageData::EnablePositionTrace()),
+		 * that trace is used instead of sampling the stage's position from this module.
+		*/
+		struct ConfocalLineScanType
+		{
+			using ClockType = std::chrono::system_clock;
+
+			struct PositionTracePointType
+			{
+				ClockType::time_point Time;
+				WidefieldMicroscopeData::PositionType X;	//!< Sample position in nm
+			};
+
+			struct CountTracePointType
+			{
+				ClockType::time_point Time;					//!< Time at the center of the sample's exposure interval
+				double Counts;
+			};
+
+			void Reset();
+
+			bool IsActive = false;
+			std::vector<WidefieldMicroscopeData::PositionPoint> Pixels;	//!< Pixels of the current line in the scanning direction
+			double DistPerPixel{};										//!< Pixel size in nm, negative if scanning towards smaller positions
+			double LineStartX{};										//!< Position in nm the first pixel begins at
+			WidefieldMicroscopeData::PositionType MeasuredY{};			//!< Measured y position in nm of the current line
+			WidefieldMicroscopeData::PositionType OriginalVelocity{};	//!< Velocity of sample stage X in its native units to be restored after the scan
+			ModuleDataType::SPDTimeType SampleExposureTime{};			//!< Exposure time of a single count sample
+
+			std::vector<PositionTracePointType> PositionTrace;
+			std::vector<CountTracePointType> SPD1CountTrace;
+			std::vector<CountTracePointType> SPD2CountTrace;
+			size_t SPD1SamplesRead = 0;
+			size_t SPD2SamplesRead = 0;
+			ClockType::time_point LastPositionUpdateRequest;
+
+			bool UsingStagePositionTrace = false;		//!< Determines whether #PositionTrace is taken from sample stage X's own position trace
+			size_t StagePositionTraceSamplesRead = 0;	//!< Number of samples written to sample stage X's position trace before the current line
+		};
+
+		static constexpr int ConfocalLineScanSamplesPerPixel = 5;		//!< Number of count samples recorded per pixel if possible
+		static constexpr size_t ConfocalLineScanStreamSize = 1024;		//!< Size of the SPDs' sample streams while scanning lines continuously
+		static constexpr double ConfocalLineScanRunUpDistInPixels = 1;	//!< Distance before and after each line in pixels to accelerate and decelerate the stage
+		static constexpr auto ConfocalLineScanPositionUpdateInterval = std::chrono::milliseconds(20);	//!< Interval to request sample position updates with
+
+		void ReadConfocalLineScanCounts(Util::SynchronizedPointer<ModuleDataType>& ModuleData, bool UsingSPD2) const;
+		void ReadConfocalLineScanStagePositionTrace(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
+		void BinConfocalLineScan(Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
+		// <-
+
+		// Coroutine scanning pixel by pixel (refer to DynExp::ModuleCoroutine). It is resumed as soon as instrument tasks it awaits
+		// have completed instead of stepping through one state per main loop iteration.
+		// ->
+		DynExp::ModuleCoroutine ConfocalScanCoroutine(DynExp::ModuleInstance& Instance) const;
+		std::vector<DynExp::TaskFuture> MoveSampleXYToAsync(const ModuleDataType::PositionPoint& Point, Util::SynchronizedPointer<ModuleDataType>& ModuleData) const;
+		// <-
+
 		// Function and types for automatical optimization of the sample's position to maximize the count rate
 		// ->
 		struct ConfocalOptimizationStateType
@@ -679,9 +762,11 @@ namespace DynExpModule::Widefield
 		void OnConfocalConfocalHeightChanged(DynExp::ModuleInstance* Instance, int Value) const;
 		void OnConfocalConfocalDistPerPixelChanged(DynExp::ModuleInstance* Instance, int Value) const;
 		void OnConfocalSPDExposureTimeChanged(DynExp::ModuleInstance* Instance, int Value) const;
+		void OnToggleConfocalScanContinuous(DynExp::ModuleInstance* Instance, int State) const;
 		void OnConfocalOptimizationInitXYStepSizeChanged(DynExp::ModuleInstance* Instance, double Value) const;
 		void OnConfocalOptimizationInitZStepSizeChanged(DynExp::ModuleInstance* Instance, double Value) const;
 		void OnConfocalOptimizationToleranceChanged(DynExp::ModuleInstance* Instance, double Value) const;
+		void OnConfocalOptimizationMethodChanged(DynExp::ModuleInstance* Instance, int Value) const;
 		void OnPerformConfocalScan(DynExp::ModuleInstance* Instance, bool) const;
 		void ConfocalSurfaceSelectedPointChanged(DynExp::ModuleInstance* Instance, QPoint Position) const;
 		void OnHBTBinWidthChanged(DynExp::ModuleInstance* Instance, int Value) const;
@@ -736,6 +821,10 @@ namespace DynExpModule::Widefield
 		StateType ConfocalScanWaitUntilMovedStateFunc(DynExp::ModuleInstance& Instance);
 		StateType ConfocalScanCaptureStateFunc(DynExp::ModuleInstance& Instance);
 		StateType ConfocalScanWaitUntilCapturedStateFunc(DynExp::ModuleInstance& Instance);
+		StateType ConfocalScanRunningStateFunc(DynExp::ModuleInstance& Instance);
+		StateType ConfocalLineScanStepStateFunc(DynExp::ModuleInstance& Instance);
+		StateType ConfocalLineScanWaitUntilAtLineStartStateFunc(DynExp::ModuleInstance& Instance);
+		StateType ConfocalLineScanAcquiringStateFunc(DynExp::ModuleInstance& Instance);
 		StateType ConfocalOptimizationInitStateFunc(DynExp::ModuleInstance& Instance);
 		StateType ConfocalOptimizationInitSubStepStateFunc(DynExp::ModuleInstance& Instance);
 		StateType ConfocalOptimizationWaitStateFunc(DynExp::ModuleInstance& Instance);
@@ -755,6 +844,8 @@ namespace DynExpModule::Widefield
 		StateType AutoMeasureCharacterizationHBTBeginStateFunc(DynExp::ModuleInstance& Instance);
 		StateType AutoMeasureCharacterizationHBTWaitForInitStateFunc(DynExp::ModuleInstance& Instance);
 		StateType AutoMeasureCharacterizationHBTFinishedStateFunc(DynExp::ModuleInstance& Instance);
+		StateType AutoMeasureCharacterizationSpectrumHBTBeginStateFunc(DynExp::ModuleInstance& Instance);
+		StateType AutoMeasureCharacterizationWaitForSpectrumStateFunc(DynExp::ModuleInstance& Instance);
 		StateType AutoMeasureSampleStepStateFunc(DynExp::ModuleInstance& Instance);
 		StateType AutoMeasureSampleReadCellIDStateFunc(DynExp::ModuleInstance& Instance);
 		StateType AutoMeasureSampleReadCellIDFinishedStateFunc(DynExp::ModuleInstance& Instance);
@@ -822,6 +913,14 @@ namespace DynExpModule::Widefield
 			&WidefieldMicroscope::ConfocalScanCaptureStateFunc, "Performing confocal scan...");
 		static constexpr auto ConfocalScanWaitUntilCapturedState = Util::StateMachineState(StateType::ConfocalScanWaitUntilCaptured,
 			&WidefieldMicroscope::ConfocalScanWaitUntilCapturedStateFunc, "Performing confocal scan...");
+		static constexpr auto ConfocalScanRunningState = Util::StateMachineState(StateType::ConfocalScanRunning,
+			&WidefieldMicroscope::ConfocalScanRunningStateFunc, "Performing confocal scan...");
+		static constexpr auto ConfocalLineScanStepState = Util::StateMachineState(StateType::ConfocalLineScanStep,
+			&WidefieldMicroscope::ConfocalLineScanStepStateFunc, "Performing confocal scan...");
+		static constexpr auto ConfocalLineScanWaitUntilAtLineStartState = Util::StateMachineState(StateType::ConfocalLineScanWaitUntilAtLineStart,
+			&WidefieldMicroscope::ConfocalLineScanWaitUntilAtLineStartStateFunc, "Performing confocal scan...");
+		static constexpr auto ConfocalLineScanAcquiringState = Util::StateMachineState(StateType::ConfocalLineScanAcquiring,
+			&WidefieldMicroscope::ConfocalLineScanAcquiringStateFunc, "Performing confocal scan...");
 		static constexpr auto ConfocalOptimizationInitState = Util::StateMachineState(StateType::ConfocalOptimizationInit,
 			&WidefieldMicroscope::ConfocalOptimizationInitStateFunc);
 		static constexpr auto ConfocalOptimizationInitSubStepState = Util::StateMachineState(StateType::ConfocalOptimizationInitSubStep,
@@ -870,6 +969,10 @@ namespace DynExpModule::Widefield
 			&WidefieldMicroscope::AutoMeasureCharacterizationHBTWaitForInitStateFunc);
 		static constexpr auto AutoMeasureCharacterizationHBTFinishedState = Util::StateMachineState(StateType::AutoMeasureCharacterizationHBTFinished,
 			&WidefieldMicroscope::AutoMeasureCharacterizationHBTFinishedStateFunc);
+		static constexpr auto AutoMeasureCharacterizationSpectrumHBTBeginState = Util::StateMachineState(StateType::AutoMeasureCharacterizationSpectrumHBTBegin,
+			&WidefieldMicroscope::AutoMeasureCharacterizationSpectrumHBTBeginStateFunc);
+		static constexpr auto AutoMeasureCharacterizationWaitForSpectrumState = Util::StateMachineState(StateType::AutoMeasureCharacterizationWaitForSpectrum,
+			&WidefieldMicroscope::AutoMeasureCharacterizationWaitForSpectrumStateFunc, "Characterizing emitters (waiting for spectrum)...");
 		static constexpr auto AutoMeasureCharacterizationFinishedState = Util::StateMachineState(StateType::AutoMeasureCharacterizationFinished,
 			&WidefieldMicroscope::ReturnToReadyStateFunc);
 		static constexpr auto AutoMeasureSampleStepState = Util::StateMachineState(StateType::AutoMeasureSampleStep,
@@ -968,6 +1071,8 @@ namespace DynExpModule::Widefield
 		const std::shared_ptr<AtomicWidefieldImageProcessingStateType> WidefieldLocalizationState;
 
 		mutable std::list<WidefieldMicroscopeData::PositionPoint> ConfocalScanPositions;
+		mutable ConfocalLineScanType ConfocalLineScan;
+		mutable DynExp::ModuleCoroutineScheduler ConfocalScanScheduler;		// Runs ConfocalScanCoroutine() while in state ConfocalScanRunning.
 
 		// Variables for automatical optimization of the sample's position to maximize the count rate
 		static constexpr size_t GSLConfocalOptimizationNumDimensions = 3;
@@ -984,6 +1089,13 @@ namespace DynExpModule::Widefield
 		std::future<ConfocalOptimizationFeedbackType> ConfocalOptimizationFeedbackFuture;			// To be solely accessed by ConfocalOptimizationThread.
 		std::future<ConfocalOptimizationThreadReturnType> ConfocalOptimizationThreadReturnFuture;	// To be solely accessed by WidefieldMicroscope thread.
 
+		// Variables for the model-based alternative to the gsl minimizer (fitting the point spread function to batches of measurements).
+		// The method is fixed when an optimization is initialized to not switch methods during a running optimization.
+		mutable WidefieldMicroscopeWidget::ConfocalOptimizationMethodType ConfocalOptimizationMethodInUse = WidefieldMicroscopeWidget::ConfocalOptimizationMethodType::NelderMeadSimplex;
+		mutable ConfocalPSFOptimizer ConfocalPSFOptimization;
+		mutable size_t ConfocalOptimizationNumMeasurements = 0;										// Number of count rates measured by the current optimization.
+		mutable std::chrono::steady_clock::time_point ConfocalOptimizationStartTimePoint;
+
 		// Variables for switching from a confocal to a widefield setup.
 		std::chrono::system_clock::time_point SetupTransitionFinishedTimePoint;
 		bool TurnOnPumpSourceAfterTransitioning = false;
@@ -995,6 +1107,13 @@ namespace DynExpModule::Widefield
 		mutable std::chrono::system_clock::time_point WaitingEndTimePoint;
 		mutable std::chrono::microseconds HBTIntegrationTimeBeforeReset{ 0 };
 
+		// Variables for pipelining the automated characterization of emitters.
+		mutable AutoMeasurePhaseTimer AutoMeasurePhaseTimes;								// Time spent in the phases of characterizing emitters.
+		mutable AutoMeasureFileWriter AutoMeasureWriter;									// Saves results in the background while characterizing the next emitter.
+		mutable bool AutoMeasureSpectrumPending = false;									// A spectrum is being recorded in parallel to HBT data.
+		mutable bool AutoMeasureHBTSwitchPreset = false;									// The HBT switch has been set while moving to the current emitter.
+		mutable std::chrono::system_clock::time_point AutoMeasureHBTSwitchSettledTimePoint;	// Time point the preset HBT switch has finished its transition at.
+
 		// General
 		size_t NumFailedUpdateAttempts = 0;
 		mutable bool LogUIMessagesOnly = false;
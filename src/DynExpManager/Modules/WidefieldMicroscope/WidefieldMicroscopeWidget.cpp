@@ -281,9 +281,11 @@ namespace DynExpModule::Widefield
 		ui.SBConfocalHeight->setEnabled(IsReady);
 		ui.SBConfocalDistPerPixel->setEnabled(IsReady);
 		ui.SBConfocalSPDExposureTime->setEnabled(IsReady);
+		ui.CBConfocalContinuousScan->setEnabled(IsReady);
 		ui.SBConfocalOptimizationInitXYStepSize->setEnabled(IsReady && ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::ConfocalOptimization));
 		ui.SBConfocalOptimizationInitZStepSize->setEnabled(IsReady && ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::ConfocalOptimization));
 		ui.SBConfocalOptimizationTolerance->setEnabled(IsReady && ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::ConfocalOptimization));
+		ui.CBConfocalOptimizationMethod->setEnabled(IsReady && ModuleData->TestFeature(WidefieldMicroscopeData::FeatureType::ConfocalOptimization));
 		ui.BConfocalScan->setEnabled(IsReady);
 		ui.action_confocal_map_save_raw_data->setEnabled(IsReady);
 		ui.SBHBTBinWidth->setEnabled(IsReady);
@@ -469,12 +471,16 @@ namespace DynExpModule::Widefield
 			ui.SBConfocalHeight->setValue(ModuleData->GetConfocalScanHeight());
 		if (!ui.SBConfocalDistPerPixel->hasFocus())
 			ui.SBConfocalDistPerPixel->setValue(ModuleData->GetConfocalScanDistPerPixel());
+		if (!ui.CBConfocalContinuousScan->hasFocus())
+			ui.CBConfocalContinuousScan->setChecked(ModuleData->GetConfocalScanContinuous());
 		if (!ui.SBConfocalOptimizationInitXYStepSize->hasFocus())
 			ui.SBConfocalOptimizationInitXYStepSize->setValue(ModuleData->GetConfocalOptimizationInitXYStepSize());
 		if (!ui.SBConfocalOptimizationInitZStepSize->hasFocus())
 			ui.SBConfocalOptimizationInitZStepSize->setValue(ModuleData->GetConfocalOptimizationInitZStepSize());
 		if (!ui.SBConfocalOptimizationTolerance->hasFocus())
 			ui.SBConfocalOptimizationTolerance->setValue(ModuleData->GetConfocalOptimizationTolerance());
+		if (!ui.CBConfocalOptimizationMethod->hasFocus())
+			ui.CBConfocalOptimizationMethod->setCurrentIndex(ModuleData->GetConfocalOptimizationMethod());
 
 		if (ModuleData->HasConfocalScanSurfacePlotRows())
 		{
@@ -804,38 +810,36 @@ namespace DynExpModule::Widefield
 		if (!ConfocalSurfaceDataArray)
 			return;
 
-		auto Filename = Util::PromptSaveFilePathModule(this, "Save data", ".csv", " Comma-separated values file (*.csv)");
+		auto Filename = Util::PromptSaveFilePathModule(this, "Save data", ".csv", Util::DataFileWriter::GetFileFilter());
 		if (Filename.isEmpty())
 			return;
 
-		std::stringstream CSVData;
+		// The file is written in the background. Errors are logged to the event log.
+		Util::AsyncFileWriter::JobFuncType JobFunc;
 		{
 			auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(GetOwner().GetModuleData());
 
-			CSVData = ModuleData->AssembleCSVHeader(true, false, false);
-			ModuleData->WriteConfocalScanResults(CSVData);
+			JobFunc = ModuleData->MakeConfocalScanResultsWriter(Util::DataFileWriter::GetFormatFromFilename(Filename));
 		} // ModuleData unlocked here.
 
-		if (!Util::SaveToFile(Filename, CSVData.str()))
-			QMessageBox::warning(this, "DynExp - Error", "Error writing data to file.");
+		Util::FileWriter().Enqueue(Filename, std::move(JobFunc));
 	}
 
 	void WidefieldMicroscopeWidget::OnHBTSaveRawDataClicked()
 	{
-		auto Filename = Util::PromptSaveFilePathModule(this, "Save data", ".csv", " Comma-separated values file (*.csv)");
+		auto Filename = Util::PromptSaveFilePathModule(this, "Save data", ".csv", Util::DataFileWriter::GetFileFilter());
 		if (Filename.isEmpty())
 			return;
 
-		std::stringstream CSVData;
+		// The file is written in the background. Errors are logged to the event log.
+		Util::AsyncFileWriter::JobFuncType JobFunc;
 		{
 			auto ModuleData = DynExp::dynamic_ModuleData_cast<WidefieldMicroscope>(GetOwner().GetModuleData());
 
-			CSVData = ModuleData->AssembleCSVHeader(false, true, false);
-			ModuleData->WriteHBTResults(CSVData);
+			JobFunc = ModuleData->MakeHBTResultsWriter(Util::DataFileWriter::GetFormatFromFilename(Filename));
 		} // ModuleData unlocked here.
 
-		if (!Util::SaveToFile(Filename, CSVData.str()))
-			QMessageBox::warning(this, "DynExp - Error", "Error writing data to file.");
+		Util::FileWriter().Enqueue(Filename, std::move(JobFunc));
 	}
 
 	void WidefieldMicroscopeWidget::OnAutoMeasureSavePathBrowseClicked()
@@ -49,6 +49,10 @@ namespace DynExpModule::Widefield
 		ConfocalScanWaitUntilMoved,
 		ConfocalScanCapture,
 		ConfocalScanWaitUntilCaptured,
+		ConfocalScanRunning,
+		ConfocalLineScanStep,
+		ConfocalLineScanWaitUntilAtLineStart,
+		ConfocalLineScanAcquiring,
 		ConfocalOptimizationInit,
 		ConfocalOptimizationInitSubStep,
 		ConfocalOptimizationWait,
@@ -73,6 +77,8 @@ namespace DynExpModule::Widefield
 		AutoMeasureCharacterizationHBTBegin,
 		AutoMeasureCharacterizationHBTWaitForInit,
 		AutoMeasureCharacterizationHBTFinished,
+		AutoMeasureCharacterizationSpectrumHBTBegin,
+		AutoMeasureCharacterizationWaitForSpectrum,
 		AutoMeasureCharacterizationFinished,
 		AutoMeasureSampleStep,
 		AutoMeasureSampleReadCellID,
@@ -115,6 +121,7 @@ namespace DynExpModule::Widefield
 
 	public:
 		enum LocalizationType : int { LocalizeEmittersFromImage, RecallEmitterPositions };
+		enum ConfocalOptimizationMethodType : int { NelderMeadSimplex, GaussianPSFFit };
 
 		WidefieldMicroscopeWidget(WidefieldMicroscope& Owner, QModuleWidget* parent = nullptr);
 		~WidefieldMicroscopeWidget() = default;
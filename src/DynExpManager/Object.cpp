@@ -416,6 +416,9 @@ namespace DynExp
 		ClearWarning();
 
 		ResetImpl(dispatch_tag<Object>());
+
+		// Resetting clears exceptions stored by derived classes.
+		BumpStateVersion();
 	}
 
 	void Object::BlockIfUnused(const std::chrono::milliseconds Timeout)
@@ -454,6 +457,7 @@ namespace DynExp
 	void Object::SetWarning(std::string Description, int ErrorCode) const
 	{
 		Warning = Util::Warning(std::move(Description), ErrorCode);
+		BumpStateVersion();
 
 		LogWarning();
 	}
@@ -461,6 +465,7 @@ namespace DynExp
 	void Object::SetWarning(const Util::Exception& e) const
 	{
 		Warning = e;
+		BumpStateVersion();
 
 		LogWarning();
 	}
@@ -587,6 +592,7 @@ namespace DynExp
 
 		RunChild();
 		Running = true;
+		BumpStateVersion();
 
 		return true;
 	}
@@ -629,6 +635,8 @@ namespace DynExp
 			SetReasonWhyPaused(std::move(Description));
 		else
 			ClearReasonWhyPaused();
+
+		BumpStateVersion();
 	}
 
 	void RunnableObject::Init()
@@ -708,6 +716,7 @@ namespace DynExp
 		Thread = std::thread();
 		Running = false;
 		Paused = false;
+		BumpStateVersion();
 	}
 
 	void RunnableObject::OnThreadHasExited() noexcept
@@ -722,6 +731,9 @@ namespace DynExp
 		Running = false;
 		Paused = false;
 
+		// Also indicates that the exception which has possibly terminated the thread has been stored.
+		BumpStateVersion();
+
 		// This is necessary if the RunnableObject is not terminated regularly but by an error.
 		DeregisterAllUnsafe();
 	}
@@ -2187,7 +2187,7 @@ namespace DynExp
 		/**
 		 * @brief Resets Object::Warning.
 		*/
-		void ClearWarning() const { Warning.Reset(); }
+		void ClearWarning() const { Warning.Reset(); BumpStateVersion(); }
 
 		/**
 		 * @brief Returns Object::Warning in a thread-safe way by copying its internal data.
@@ -2203,6 +2203,15 @@ namespace DynExp
 		*/
 		std::exception_ptr GetException(const std::chrono::milliseconds Timeout = Util::ILockable::DefaultTimeout) const { return GetExceptionChild(Timeout); }
 
+		/**
+		 * @brief Returns a counter which is incremented after the state of this @p Object instance as
+		 * displayed by the user interface (warning, exception, running and paused state) has changed.
+		 * Does not lock any mutex. This allows the user interface to skip querying the state of
+		 * @p Object instances whose state version has not changed.
+		 * @return Current state version of this @p Object instance
+		*/
+		auto GetStateVersion() const noexcept { return StateVersion.load(std::memory_order_acquire); }
+
 		/**
 		 * @brief Returns wheter this @p Object instance is ready (e.g. it is running or connected to
 		 * a hardware device) and not blocked (refer to Object::IsBlocked).
@@ -2273,6 +2282,12 @@ namespace DynExp
 		bool IsUnusedUnsafe() { return GetUseCountUnsafe() == 0; }
 		///@}
 
+		/**
+		 * @brief Increments Object::StateVersion. Call after the state returned by functions like
+		 * @p GetException() has been changed. Refer to @p GetStateVersion().
+		*/
+		void BumpStateVersion() const noexcept { StateVersion.fetch_add(1, std::memory_order_acq_rel); }
+
 	private:
 		/** @name Override
 		 * Override by derived class to make public versions of these functions behave as described above.
@@ -2303,6 +2318,7 @@ namespace DynExp
 		const ParamsBasePtrType Params;			//!< Pointer to the parameter class instance belonging to this @p Object instance
 
 		mutable Util::Warning Warning;			//!< Last warning which occurred within this @p Object instance. (Logical const-ness: see above.)
+		mutable std::atomic<uint64_t> StateVersion = 0;	//!< Counter incremented by @p BumpStateVersion(). Refer to @p GetStateVersion().
 
 		/**
 		 * @brief List of @p Object instances making use of this @p Object instance.
@@ -11,7 +11,7 @@ PYBIND11_MAKE_OPAQUE(decltype(DynExpInstr::PyDataStreamInstrument::Samples));
  * DynExpInstr::PyDataStreamInstrument::Samples, and DynExpInstr::PyDataStreamInstrument
  * as respective Python classes.
 */
-PYBIND11_EMBEDDED_MODULE(PyModuleDataStreamInstrument, m)
+DYNEXP_PY_EMBEDDED_MODULE(PyModuleDataStreamInstrument, m)
 {
 	using namespace DynExpInstr;
 
@@ -6,7 +6,7 @@
 /**
  * @internal 
 */
-PYBIND11_EMBEDDED_MODULE(PyModuleStdoutLogger, m)
+DYNEXP_PY_EMBEDDED_MODULE(PyModuleStdoutLogger, m)
 {
 	py::class_<Util::PyStdoutLoggerWrapper>(m, "StdoutLoggerWrapper")
 		.def("write", &Util::PyStdoutLoggerWrapper::write)
@@ -24,18 +24,23 @@ namespace Util
 			Util::EventLog().Log("[Py] \"" + Str + "\"");
 	}
 
-	PyGilReleasedInterpreter::PyGilReleasedInterpreter()
+	/**
+	 * @brief Redirects stdout of the interpreter whose GIL is held by the calling thread to
+	 * %DynExp's event log and fixes the module search path.
+	 * @param Logger Wrapper to forward %DynExp's event log to Python
+	 * @return Handle to the Python sys module of the interpreter
+	*/
+	static py::module_ ConfigureInterpreter(PyStdoutLoggerWrapper& Logger)
 	{
-		py::gil_scoped_acquire acquire;
-
 		// Redirect Python's stdout.
 		py::module_::import("PyModuleStdoutLogger");
-		Module_sys = py::module_::import("sys");
+		auto Module_sys = py::module_::import("sys");
 		Module_sys.attr("stdout") = Logger;
 
 #ifdef DYNEXP_UNIX
 		// Add folder 'lib-dynload' to path and use release modules. Otherwise, Python does not find basic modules.
 		py::exec(R"(
+			import sys
 			new_path = []
 			for p in sys.path:
 				p = p.replace('debug/', '')
@@ -46,6 +51,15 @@ namespace Util
 			sys.path = new_path
 		)");
 #endif // DYNEXP_UNIX
+
+		return Module_sys;
+	}
+
+	PyGilReleasedInterpreter::PyGilReleasedInterpreter()
+	{
+		py::gil_scoped_acquire acquire;
+
+		Module_sys = ConfigureInterpreter(Logger);
 	}
 
 	void PyGilReleasedInterpreter::PrintDebugInfo()
@@ -55,4 +69,32 @@ namespace Util
 		py::print("Importing Python modules from");
 		py::print(Module_sys.attr("path"));
 	}
-}
\ No newline at end of file
+
+	PySubinterpreter::PySubinterpreter()
+#ifdef DYNEXP_PY_SUBINTERPRETERS
+		: Interpreter(py::subinterpreter::create())
+	{
+		py::subinterpreter_scoped_activate Activation(Interpreter);
+
+		ConfigureInterpreter(Logger);
+	}
+#else
+	{
+		throw NotAvailableException("Python subinterpreters with their own GIL require Python 3.12 and pybind11 3.0 or later.",
+			ErrorType::Error);
+	}
+#endif // DYNEXP_PY_SUBINTERPRETERS
+
+	PyInterpreterLock::PyInterpreterLock(const PySubinterpreter* Interpreter)
+	{
+#ifdef DYNEXP_PY_SUBINTERPRETERS
+		if (Interpreter)
+		{
+			Activation.emplace(Interpreter->Interpreter);
+			return;
+		}
+#endif // DYNEXP_PY_SUBINTERPRETERS
+
+		GILAcquire.emplace();
+	}
+}
@@ -11,6 +11,22 @@
 
 namespace py = pybind11;
 
+#if PYBIND11_VERSION_MAJOR >= 3 && PY_VERSION_HEX >= 0x030C0000
+/**
+ * @brief Defined if Python subinterpreters with their own GIL are supported by the
+ * Python version and by the pybind11 version %DynExp is built against.
+*/
+#define DYNEXP_PY_SUBINTERPRETERS
+
+/**
+ * @brief Declares an embedded Python module which may be imported by the main interpreter
+ * and by any Util::PySubinterpreter instance.
+*/
+#define DYNEXP_PY_EMBEDDED_MODULE(name, variable) PYBIND11_EMBEDDED_MODULE(name, variable, py::multiple_interpreters::per_interpreter_gil())
+#else
+#define DYNEXP_PY_EMBEDDED_MODULE(name, variable) PYBIND11_EMBEDDED_MODULE(name, variable)
+#endif // PYBIND11_VERSION_MAJOR >= 3 && PY_VERSION_HEX >= 0x030C0000
+
 namespace Util
 {
 	/**
@@ -54,10 +70,74 @@ namespace Util
 		py::gil_scoped_release GILRelease;		//!< Release which releases the GIL at construction 
 	};
 
+	/**
+	 * @brief Python interpreter running code independently of the main interpreter. Each
+	 * subinterpreter owns a separate GIL (requires Python 3.12 or later), so Python code
+	 * executed in different subinterpreters from different threads runs in parallel.
+	 * Construction and destruction do not require the main interpreter's GIL to be held.
+	 * Use PyInterpreterLock to execute code in the subinterpreter.
+	*/
+	class PySubinterpreter
+	{
+		friend class PyInterpreterLock;
+
+	public:
+		/**
+		 * @brief Creates a subinterpreter with its own GIL and redirects its stdout to
+		 * %DynExp's event log like PyGilReleasedInterpreter does for the main interpreter.
+		 * @throws NotAvailableException is thrown if %DynExp has been built without
+		 * support for subinterpreters (refer to IsAvailable()).
+		*/
+		PySubinterpreter();
+
+		/**
+		 * @brief Determines whether %DynExp has been built with support for subinterpreters.
+		 * @return Returns true if PySubinterpreter instances can be constructed, false otherwise.
+		*/
+		static constexpr bool IsAvailable() noexcept
+		{
+#ifdef DYNEXP_PY_SUBINTERPRETERS
+			return true;
+#else
+			return false;
+#endif // DYNEXP_PY_SUBINTERPRETERS
+		}
+
+	private:
+#ifdef DYNEXP_PY_SUBINTERPRETERS
+		// Do not change order. Interpreter needs to be destroyed first upon destruction.
+		PyStdoutLoggerWrapper Logger;			//!< Wrapper to forward %DynExp's event log to Python
+		py::subinterpreter Interpreter;			//!< Python subinterpreter
+#endif // DYNEXP_PY_SUBINTERPRETERS
+	};
+
+	/**
+	 * @brief Makes the calling thread hold the GIL of either the main interpreter or a
+	 * subinterpreter during the lifetime of a PyInterpreterLock instance.
+	*/
+	class PyInterpreterLock
+	{
+	public:
+		/**
+		 * @brief Acquires the GIL of the main interpreter or activates @p Interpreter
+		 * on the calling thread.
+		 * @param Interpreter Subinterpreter to lock. If nullptr, the main interpreter's
+		 * GIL is acquired.
+		*/
+		explicit PyInterpreterLock(const PySubinterpreter* Interpreter = nullptr);
+
+	private:
+		std::optional<py::gil_scoped_acquire> GILAcquire;					//!< Lock of the main interpreter's GIL
+#ifdef DYNEXP_PY_SUBINTERPRETERS
+		std::optional<py::subinterpreter_scoped_activate> Activation;	//!< Lock of a subinterpreter's GIL
+#endif // DYNEXP_PY_SUBINTERPRETERS
+	};
+
 	/**
 	 * @brief Wraps a class derived from pybind11::object and ensures that the GIL
-	 * is acquired when the PyObject is destroyed. For any other operation
-	 * on this wrapper, the GIL still needs to be acquired manually before!
+	 * of the interpreter the object belongs to is acquired when the PyObject is destroyed.
+	 * For any other operation on this wrapper, the GIL still needs to be acquired manually
+	 * before (refer to PyInterpreterLock)!
 	 * @tparam T Type derived from pybind11::object
 	*/
 	template <typename T, std::enable_if_t<
@@ -109,10 +189,15 @@ namespace Util
 		/**
 		 * @copydoc ~PyObject()
 		 * This PyObject instance does not own an object after this operation.
+		 * @param Interpreter Subinterpreter the objects assigned to this PyObject instance
+		 * afterwards belong to. If nullptr, they belong to the main interpreter.
 		*/
-		void Reset()
+		void Reset(const PySubinterpreter* Interpreter = nullptr)
 		{
-			py::gil_scoped_acquire acquire;
+			Remove();
+
+			PyInterpreterLock Lock(Interpreter);
+			this->Interpreter = Interpreter;
 			Object = std::make_unique<T>();
 		}
 
@@ -139,10 +224,19 @@ namespace Util
 		*/
 		void Remove()
 		{
-			py::gil_scoped_acquire acquire;
+			if (!Object)
+				return;
+
+			PyInterpreterLock Lock(Interpreter);
 			Object.reset();
 		}
 
+		/**
+		 * @brief Subinterpreter #Object belongs to or nullptr if it belongs to the main interpreter.
+		 * The subinterpreter must outlive #Object.
+		*/
+		const PySubinterpreter* Interpreter = nullptr;
+
 		/**
 		 * @brief Object derived from @p pybind11::object owned by this PyObject instance
 		*/
@@ -82,6 +82,104 @@ namespace Util
 		EventOccurred = false;
 	}
 
+	namespace
+	{
+		constexpr size_t NumPoolSizeClasses = SmallObjectPool::MaxBlockSize / SmallObjectPool::BlockSizeGranularity;
+
+		/**
+		 * @brief Header placed into free memory blocks of SmallObjectPool to link them
+		*/
+		struct PoolFreeBlock
+		{
+			PoolFreeBlock* Next;
+		};
+
+		/**
+		 * @brief Returns the index of the size class serving blocks of @p Size bytes.
+		*/
+		constexpr size_t GetPoolSizeClass(size_t Size) noexcept
+		{
+			return Size ? (Size - 1) / SmallObjectPool::BlockSizeGranularity : 0;
+		}
+
+		/**
+		 * @brief Blocks freed by any thread (one lock-free stack per size class). Constant-initialized,
+		 * so it is usable while other static objects are constructed or destroyed.
+		*/
+		std::array<std::atomic<PoolFreeBlock*>, NumPoolSizeClasses> PoolReturnedBlocks{};
+
+		void PushPoolBlocks(size_t SizeClass, PoolFreeBlock* First, PoolFreeBlock* Last) noexcept
+		{
+			auto& Returned = PoolReturnedBlocks[SizeClass];
+			Last->Next = Returned.load(std::memory_order_relaxed);
+			while (!Returned.compare_exchange_weak(Last->Next, First, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		/**
+		 * @brief Blocks owned by a single thread. They are handed back to the global stacks when the thread exits.
+		*/
+		struct PoolThreadCacheType
+		{
+			~PoolThreadCacheType()
+			{
+				for (size_t SizeClass = 0; SizeClass < NumPoolSizeClasses; ++SizeClass)
+				{
+					auto First = Blocks[SizeClass];
+					if (!First)
+						continue;
+
+					auto Last = First;
+					while (Last->Next)
+						Last = Last->Next;
+					PushPoolBlocks(SizeClass, First, Last);
+
+					// Destructors of other thread-local objects running afterwards might still use the pool. They
+					// must not hand out the blocks again which other threads might take over from now on.
+					Blocks[SizeClass] = nullptr;
+				}
+			}
+
+			std::array<PoolFreeBlock*, NumPoolSizeClasses> Blocks{};
+		};
+
+		thread_local PoolThreadCacheType PoolThreadCache;
+	}
+
+	void* SmallObjectPool::Allocate(size_t Size)
+	{
+		if (Size > MaxBlockSize)
+			return ::operator new(Size);
+
+		const auto SizeClass = GetPoolSizeClass(Size);
+		auto& Cached = PoolThreadCache.Blocks[SizeClass];
+
+		// Take over all the blocks freed in the meantime at once.
+		if (!Cached)
+			Cached = PoolReturnedBlocks[SizeClass].exchange(nullptr, std::memory_order_acquire);
+		if (!Cached)
+			return ::operator new((SizeClass + 1) * BlockSizeGranularity);
+
+		auto Block = Cached;
+		Cached = Block->Next;
+
+		return Block;
+	}
+
+	void SmallObjectPool::Deallocate(void* Ptr, size_t Size) noexcept
+	{
+		if (!Ptr)
+			return;
+
+		if (Size > MaxBlockSize)
+		{
+			::operator delete(Ptr);
+			return;
+		}
+
+		auto Block = ::new (Ptr) PoolFreeBlock{ nullptr };
+		PushPoolBlocks(GetPoolSizeClass(Size), Block, Block);
+	}
+
 	BlobDataType::BlobDataType(const BlobDataType& Other)
 		: DataSize(Other.DataSize)
 	{
@@ -217,50 +315,196 @@ namespace Util
 		return LowerStr;
 	}
 
-	std::vector<std::complex<double>> FFT(const std::vector<std::complex<double>>& Data, bool InverseTransform)
+	FFTPlan::FFTPlan(const size_t Length)
+		: Length(Length)
 	{
-		if (Data.size() > std::numeric_limits<size_t>::max() / 2)
-			throw OverflowException("Size of Data vector must not exceed half the capacity of size_t.");
+		if (!Length)
+			throw InvalidArgException("The length of an FFT plan must not be zero.");
+		if (Length > std::numeric_limits<size_t>::max() / 2)
+			throw OverflowException("The length of an FFT plan must not exceed half the capacity of size_t.");
+	}
 
-		std::vector<double> RawData;
-		RawData.resize(2 * Data.size());
-		for (size_t i = 0; i < Data.size(); ++i)
-		{
-			RawData[2 * i] = Data[i].real();
-			RawData[2 * i + 1] = Data[i].imag();
-		}
+	FFTPlan::~FFTPlan()
+	{
+		if (RealWorkspace)
+			gsl_fft_real_workspace_free(RealWorkspace);
+		if (RealWavetable)
+			gsl_fft_real_wavetable_free(RealWavetable);
+		if (ComplexWorkspace)
+			gsl_fft_complex_workspace_free(ComplexWorkspace);
+		if (ComplexWavetable)
+			gsl_fft_complex_wavetable_free(ComplexWavetable);
+	}
 
-		gsl_fft_complex_workspace* Workspace = gsl_fft_complex_workspace_alloc(Data.size());
-		gsl_fft_complex_wavetable* Wavetable = gsl_fft_complex_wavetable_alloc(Data.size());
-		
-		try
-		{
-			if (!Workspace || !Wavetable)
-				throw NotAvailableException("Could not reserve memory for FFT.", ErrorType::Error);
+	void FFTPlan::Transform(std::complex<double>* Data, bool InverseTransform)
+	{
+		if (!ComplexWavetable)
+			ComplexWavetable = gsl_fft_complex_wavetable_alloc(Length);
+		if (!ComplexWorkspace)
+			ComplexWorkspace = gsl_fft_complex_workspace_alloc(Length);
+		if (!ComplexWavetable || !ComplexWorkspace)
+			throw NotAvailableException("Could not reserve memory for FFT.", ErrorType::Error);
 
-			if (gsl_fft_complex_transform(RawData.data(), 1, Data.size(), Wavetable, Workspace,
-				InverseTransform ? gsl_fft_direction::gsl_fft_backward : gsl_fft_direction::gsl_fft_forward))
-				throw InvalidDataException("The FFT failed for an unknown reason.");
+		// std::complex<double> is guaranteed to be layout-compatible with double[2], which is what GSL expects.
+		if (gsl_fft_complex_transform(reinterpret_cast<double*>(Data), 1, Length, ComplexWavetable, ComplexWorkspace,
+			InverseTransform ? gsl_fft_direction::gsl_fft_backward : gsl_fft_direction::gsl_fft_forward))
+			throw InvalidDataException("The FFT failed for an unknown reason.");
+	}
 
-			gsl_fft_complex_wavetable_free(Wavetable);
-			gsl_fft_complex_workspace_free(Workspace);
+	void FFTPlan::RealTransform(double* Data)
+	{
+		if (!RealWavetable)
+			RealWavetable = gsl_fft_real_wavetable_alloc(Length);
+		if (!RealWorkspace)
+			RealWorkspace = gsl_fft_real_workspace_alloc(Length);
+		if (!RealWavetable || !RealWorkspace)
+			throw NotAvailableException("Could not reserve memory for FFT.", ErrorType::Error);
 
-			std::vector<std::complex<double>> Result;
-			Result.resize(Data.size());
-			for (size_t i = 0; i < Result.size(); ++i)
-				Result[i] = { RawData[2 * i], RawData[2 * i + 1] };
+		if (gsl_fft_real_transform(Data, 1, Length, RealWavetable, RealWorkspace))
+			throw InvalidDataException("The FFT failed for an unknown reason.");
+	}
 
-			return Result;
-		}
-		catch (...)
+	void FFTPlan::UnpackHalfComplex(const double* HalfComplexData, std::complex<double>* Result) const noexcept
+	{
+		// Refer to GSL's documentation of the half-complex storage format of mixed-radix real FFTs.
+		Result[0] = { HalfComplexData[0], 0 };
+		for (size_t i = 1; i < (Length + 1) / 2; ++i)
+			Result[i] = { HalfComplexData[2 * i - 1], HalfComplexData[2 * i] };
+		if (Length % 2 == 0)
+			Result[Length / 2] = { HalfComplexData[Length - 1], 0 };
+	}
+
+	FFTPlan& GetFFTPlan(const size_t Length)
+	{
+		// Keeps the most recently used plans. Few distinct lengths are used per thread in practice.
+		constexpr size_t MaxNumCachedPlans = 8;
+		thread_local std::deque<std::unique_ptr<FFTPlan>> CachedPlans;
+
+		auto Plan = std::find_if(CachedPlans.begin(), CachedPlans.end(), [Length](const auto& Plan) { return Plan->GetLength() == Length; });
+		if (Plan == CachedPlans.end())
 		{
-			if (Wavetable)
-				gsl_fft_complex_wavetable_free(Wavetable);
-			if (Workspace)
-				gsl_fft_complex_workspace_free(Workspace);
+			if (CachedPlans.size() >= MaxNumCachedPlans)
+				CachedPlans.pop_back();
 
-			throw;
+			CachedPlans.push_front(std::make_unique<FFTPlan>(Length));
+		}
+		else if (Plan != CachedPlans.begin())
+		{
+			auto MostRecentPlan = std::move(*Plan);
+			CachedPlans.erase(Plan);
+			CachedPlans.push_front(std::move(MostRecentPlan));
 		}
+
+		return *CachedPlans.front();
+	}
+
+	std::vector<std::complex<double>> FFT(const std::vector<std::complex<double>>& Data, bool InverseTransform)
+	{
+		auto Result = Data;
+		FFTInPlace(Result, InverseTransform);
+
+		return Result;
+	}
+
+	void FFTInPlace(std::vector<std::complex<double>>& Data, bool InverseTransform)
+	{
+		if (Data.empty())
+			return;
+
+		GetFFTPlan(Data.size()).Transform(Data.data(), InverseTransform);
+	}
+
+	std::vector<std::complex<double>> RealFFT(std::vector<double> Data)
+	{
+		if (Data.empty())
+			return {};
+
+		auto& Plan = GetFFTPlan(Data.size());
+		Plan.RealTransform(Data.data());
+
+		std::vector<std::complex<double>> Result(Data.size() / 2 + 1);
+		Plan.UnpackHalfComplex(Data.data(), Result.data());
+
+		return Result;
+	}
+
+	WelchEstimator::WelchEstimator(const size_t SegmentLength, const double SamplingRate, const FFTWindowType Window)
+		: SegmentLength(SegmentLength), SamplingRate(SamplingRate),
+		WindowValues(SegmentLength, 1.0), SegmentBuffer(SegmentLength), PowerSum(SegmentLength / 2 + 1, 0.0)
+	{
+		if (SegmentLength < 2)
+			throw InvalidArgException("The segment length must be at least two.");
+		if (SamplingRate <= 0)
+			throw InvalidArgException("The sampling rate must be positive.");
+
+		if (Window == FFTWindowType::Hann)
+			for (size_t i = 0; i < SegmentLength; ++i)
+				WindowValues[i] = .5 - .5 * std::cos(2 * std::numbers::pi * i / SegmentLength);	// Periodic Hann window
+
+		WindowPowerSum = std::inner_product(WindowValues.cbegin(), WindowValues.cend(), WindowValues.cbegin(), 0.0);
+	}
+
+	void WelchEstimator::AddSegment(const double* Segment)
+	{
+		std::transform(Segment, Segment + SegmentLength, WindowValues.cbegin(), SegmentBuffer.begin(), std::multiplies<>());
+		GetFFTPlan(SegmentLength).RealTransform(SegmentBuffer.data());
+
+		// Accumulate squared magnitudes directly from GSL's half-complex format (refer to FFTPlan::UnpackHalfComplex()).
+		PowerSum[0] += SegmentBuffer[0] * SegmentBuffer[0];
+		for (size_t i = 1; i < (SegmentLength + 1) / 2; ++i)
+			PowerSum[i] += SegmentBuffer[2 * i - 1] * SegmentBuffer[2 * i - 1] + SegmentBuffer[2 * i] * SegmentBuffer[2 * i];
+		if (SegmentLength % 2 == 0)
+			PowerSum[SegmentLength / 2] += SegmentBuffer[SegmentLength - 1] * SegmentBuffer[SegmentLength - 1];
+
+		++NumSegments;
+	}
+
+	size_t WelchEstimator::AddData(const std::vector<double>& Data, const double Overlap)
+	{
+		const auto Step = std::max(size_t(1), static_cast<size_t>(SegmentLength * (1 - std::clamp(Overlap, 0.0, .99))));
+
+		size_t Offset = 0;
+		for (; Offset + SegmentLength <= Data.size(); Offset += Step)
+			AddSegment(Data.data() + Offset);
+
+		return std::min(Offset, Data.size());
+	}
+
+	std::vector<double> WelchEstimator::GetPSD() const
+	{
+		std::vector<double> PSD(PowerSum.size(), 0.0);
+		if (!NumSegments)
+			return PSD;
+
+		// One-sided spectrum: all bins except for DC and Nyquist frequency contain the power of negative frequencies, too.
+		const auto Scale = 1.0 / (SamplingRate * WindowPowerSum * NumSegments);
+		for (size_t i = 0; i < PSD.size(); ++i)
+			PSD[i] = PowerSum[i] * Scale * ((i == 0 || (SegmentLength % 2 == 0 && i == SegmentLength / 2)) ? 1.0 : 2.0);
+
+		return PSD;
+	}
+
+	std::vector<double> WelchEstimator::GetASD() const
+	{
+		auto ASD = GetPSD();
+		std::transform(ASD.cbegin(), ASD.cend(), ASD.begin(), [](double x) { return std::sqrt(x); });
+
+		return ASD;
+	}
+
+	void WelchEstimator::Reset()
+	{
+		std::fill(PowerSum.begin(), PowerSum.end(), 0.0);
+		NumSegments = 0;
+	}
+
+	std::vector<double> WelchPSD(const std::vector<double>& Data, const double SamplingRate, const size_t SegmentLength,
+		const double Overlap, const FFTWindowType Window)
+	{
+		WelchEstimator Estimator(std::min(SegmentLength, Data.size()), SamplingRate, Window);
+		Estimator.AddData(Data, Overlap);
+
+		return Estimator.GetPSD();
 	}
 
 	Warning::Warning(Warning&& Other) noexcept : Data(std::make_unique<WarningData>())
@@ -304,6 +548,23 @@ namespace Util
 	EventLogger::EventLogger()
 	{
 		LogFile.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+
+		Writer = std::thread(&EventLogger::WriterThread, this);
+	}
+
+	EventLogger::~EventLogger()
+	{
+		{
+			std::lock_guard<decltype(WriterMutex)> lock(WriterMutex);
+			WriterStopRequested = true;
+		}
+		WriterCV.notify_one();
+
+		if (Writer.joinable())
+			Writer.join();
+
+		std::lock_guard<decltype(LogFileMutex)> lock(LogFileMutex);
+		CloseLogFileUnsafe();
 	}
 
 	void EventLogger::Log(const std::string& Message, const ErrorType Type,
@@ -315,23 +576,27 @@ namespace Util
 	{
 		try
 		{
-			auto Filename = FilenameFromPath(File);
-
-			auto lock = AcquireLock(LogOperationTimeout);
-
-			LogEntry Entry(FormatLog(Message, Line, Function, Filename, ErrorCode, false), Type, std::chrono::system_clock::now());
-			LogEntries.emplace_back(std::move(Entry));
-
-			if (!IsOpenUnsafe())
+			// Bound the memory consumed by pending records if the writer cannot keep up. Never drop fatal errors.
+			if (PendingRecords.Size() >= MaxPendingRecords && Type != ErrorType::Fatal)
+			{
+				++NumDroppedRecords;
 				return;
+			}
 
-			LogFile << FormatLogHTML(Message, Type, Line, Function, Filename, ErrorCode
+			PendingRecords.Push({ Message, Type, Line, Function, FilenameFromPath(File), ErrorCode, std::chrono::system_clock::now()
 #ifdef DYNEXP_HAS_STACKTRACE
 				, Trace
 #endif // DYNEXP_HAS_STACKTRACE
-			);
+			});
+			++NumEnqueuedRecords;
 
-			LogFile.flush();
+			// Errors are written immediately. Notifying without holding WriterMutex might miss the
+			// writer thread's wait, which is bounded by WriterFlushInterval, though.
+			if (Type >= ErrorType::Error)
+			{
+				WriterWakeupRequested = true;
+				WriterCV.notify_one();
+			}
 		}
 		catch (...)
 		{
@@ -392,6 +657,7 @@ namespace Util
 #ifdef DYNEXP_HAS_STACKTRACE
 		, const std::stacktrace& Trace
 #endif // DYNEXP_HAS_STACKTRACE
+		, const std::chrono::system_clock::time_point TimePoint
 	)
 	{
 		auto Label = Exception::GetErrorLabel(Type);
@@ -407,7 +673,8 @@ namespace Util
 #ifdef DYNEXP_HAS_STACKTRACE
 				: "<details><summary class=\"entry_details\">")
 #endif // DYNEXP_HAS_STACKTRACE
-			<< "<span class=\"entry_time\"><span class=\"time\">" << CurrentTimeAndDateString() << "</span></span>"
+			<< "<span class=\"entry_time\"><span class=\"time\">"
+			<< (TimePoint == std::chrono::system_clock::time_point() ? CurrentTimeAndDateString() : ToStr(TimePoint)) << "</span></span>"
 			<< "<span class=\"entry_label\"><span class=\"label\" style=\"color:" << ColorString << "\">" << Label << "</span></span>"
 			<< "<span class=\"entry_text\">";
 		if (!Filename.empty() || !Function.empty())
@@ -445,9 +712,12 @@ namespace Util
 
 	void EventLogger::OpenLogFile(std::string Filename)
 	{
-		auto lock = AcquireLock(LogOperationTimeout);
+		{
+			auto lock = AcquireLock(LogOperationTimeout);
+			ClearLogUnsafe();
+		}
 
-		ClearLogUnsafe();
+		std::lock_guard<decltype(LogFileMutex)> lock(LogFileMutex);
 		CloseLogFileUnsafe();
 
 		LogFile.open(Filename, std::ios_base::out | std::ios_base::trunc);
@@ -493,6 +763,34 @@ namespace Util
 		return { LogEntries.cbegin() + FirstElement, LogEntries.cend() };
 	}
 
+	void EventLogger::CloseLogFile()
+	{
+		Flush();
+
+		std::lock_guard<decltype(LogFileMutex)> lock(LogFileMutex);
+		CloseLogFileUnsafe();
+	}
+
+	bool EventLogger::Flush(const std::chrono::milliseconds Timeout) noexcept
+	{
+		try
+		{
+			const size_t Target = NumEnqueuedRecords;
+
+			std::unique_lock<decltype(WriterMutex)> lock(WriterMutex);
+			WriterWakeupRequested = true;
+			WriterCV.notify_one();
+
+			return ProcessedCV.wait_for(lock, Timeout, [this, Target]() {
+				return NumProcessedRecords >= Target || WriterStopRequested;
+			});
+		}
+		catch (...)
+		{
+			return false;
+		}
+	}
+
 	void EventLogger::CloseLogFileUnsafe()
 	{
 		if (IsOpenUnsafe())
@@ -506,6 +804,186 @@ namespace Util
 		Filename = "";
 	}
 
+	void EventLogger::WriterThread() noexcept
+	{
+		bool StopRequested = false;
+
+		while (!StopRequested)
+		{
+			try
+			{
+				{
+					std::unique_lock<decltype(WriterMutex)> lock(WriterMutex);
+					WriterCV.wait_for(lock, WriterFlushInterval, [this]() {
+						return WriterWakeupRequested || WriterStopRequested;
+					});
+
+					WriterWakeupRequested = false;
+					StopRequested = WriterStopRequested;
+				}
+
+				ProcessPendingRecords();
+			}
+			catch (...)
+			{
+				// Nowhere to log to. Continue with the next batch.
+			}
+
+			// Locking the mutex ensures that threads waiting in Flush() do not miss the notification.
+			{
+				std::lock_guard<decltype(WriterMutex)> lock(WriterMutex);
+			}
+			ProcessedCV.notify_all();
+		}
+	}
+
+	void EventLogger::ProcessPendingRecords()
+	{
+		std::vector<LogRecord> Batch;
+		size_t NumPopped = 0;
+
+		// Only pop records which have been enqueued up to now in order not to starve Flush().
+		for (auto NumPending = PendingRecords.Size(); NumPending; --NumPending)
+		{
+			auto Record = PendingRecords.Pop();
+			if (!Record)
+				break;
+
+			++NumPopped;
+			if (FilterRecord(*Record, Batch))
+				Batch.push_back(std::move(*Record));
+		}
+
+		// Write summaries of suppressed repetitions which have not been interrupted by another message for a while.
+		const auto Now = std::chrono::system_clock::now();
+		for (auto LocationState = LocationStates.begin(); LocationState != LocationStates.end();)
+		{
+			if (LocationState->second.NumRepetitions && Now - LocationState->second.FirstRepetition >= DeduplicationPeriod)
+			{
+				LogRecord Origin{ LocationState->second.LastMessage, LocationState->second.LastType,
+					LocationState->second.Line, LocationState->second.Function, LocationState->second.Filename };
+				Origin.TimePoint = Now;
+				AppendSuppressionNotices(Origin, LocationState->second, Batch);
+			}
+
+			// Clean up if too many locations are stored. Their rate limiting state gets lost then.
+			if (LocationStates.size() > MaxNumLocationStates && !LocationState->second.NumRepetitions && !LocationState->second.NumRateLimited)
+				LocationState = LocationStates.erase(LocationState);
+			else
+				++LocationState;
+		}
+
+		const size_t NumDropped = NumDroppedRecords;
+		if (NumDropped != NumReportedDroppedRecords)
+		{
+			Batch.push_back({ ToStr(NumDropped - NumReportedDroppedRecords) +
+				" log entries have been dropped since too many log entries were pending.", ErrorType::Warning });
+			Batch.back().TimePoint = Now;
+			NumReportedDroppedRecords = NumDropped;
+		}
+
+		if (!Batch.empty())
+			WriteBatch(Batch);
+
+		NumProcessedRecords += NumPopped;
+	}
+
+	bool EventLogger::FilterRecord(const LogRecord& Record, std::vector<LogRecord>& Batch)
+	{
+		// Messages not stemming from a specific location are neither deduplicated nor rate-limited.
+		if (!Record.Line && Record.Function.empty() && Record.Filename.empty())
+			return true;
+
+		auto& LocationState = LocationStates[Record.Filename + ":" + ToStr(Record.Line) + ":" + Record.Function];
+		if (LocationState.Filename.empty() && LocationState.Function.empty())
+		{
+			LocationState.Line = Record.Line;
+			LocationState.Function = Record.Function;
+			LocationState.Filename = Record.Filename;
+		}
+
+		if (Record.Message == LocationState.LastMessage && Record.Type == LocationState.LastType &&
+			Record.ErrorCode == LocationState.LastErrorCode)
+		{
+			if (!LocationState.NumRepetitions)
+				LocationState.FirstRepetition = Record.TimePoint;
+			++LocationState.NumRepetitions;
+			++NumSuppressedRecords;
+
+			return false;
+		}
+
+		if (Record.TimePoint - LocationState.RateWindowStart >= std::chrono::seconds(1))
+		{
+			LocationState.RateWindowStart = Record.TimePoint;
+			LocationState.NumRecordsInRateWindow = 0;
+		}
+
+		// Never suppress fatal errors.
+		if (LocationState.NumRecordsInRateWindow >= MaxRecordsPerLocationAndSecond && Record.Type != ErrorType::Fatal)
+		{
+			++LocationState.NumRateLimited;
+			++NumSuppressedRecords;
+
+			return false;
+		}
+
+		AppendSuppressionNotices(Record, LocationState, Batch);
+
+		++LocationState.NumRecordsInRateWindow;
+		LocationState.LastMessage = Record.Message;
+		LocationState.LastType = Record.Type;
+		LocationState.LastErrorCode = Record.ErrorCode;
+
+		return true;
+	}
+
+	void EventLogger::AppendSuppressionNotices(const LogRecord& Record, LocationStateType& LocationState, std::vector<LogRecord>& Batch)
+	{
+		if (LocationState.NumRepetitions)
+		{
+			Batch.push_back({ "Previous message \"" + LocationState.LastMessage + "\" repeated " +
+				ToStr(LocationState.NumRepetitions) + " times.", LocationState.LastType, Record.Line, Record.Function, Record.Filename });
+			Batch.back().TimePoint = Record.TimePoint;
+			LocationState.NumRepetitions = 0;
+		}
+
+		if (LocationState.NumRateLimited)
+		{
+			Batch.push_back({ ToStr(LocationState.NumRateLimited) + " messages have been suppressed due to rate limiting.",
+				ErrorType::Warning, Record.Line, Record.Function, Record.Filename });
+			Batch.back().TimePoint = Record.TimePoint;
+			LocationState.NumRateLimited = 0;
+		}
+	}
+
+	void EventLogger::WriteBatch(std::vector<LogRecord>& Batch)
+	{
+		// Wait without timeout since the writer must not lose records. The lock is only held by
+		// short-running functions.
+		{
+			auto lock = AcquireLock(std::chrono::milliseconds(0));
+
+			for (const auto& Record : Batch)
+				LogEntries.emplace_back(FormatLog(Record.Message, Record.Line, Record.Function, Record.Filename, Record.ErrorCode, false),
+					Record.Type, Record.TimePoint);
+		}
+
+		std::lock_guard<decltype(LogFileMutex)> lock(LogFileMutex);
+		if (!IsOpenUnsafe())
+			return;
+
+		for (const auto& Record : Batch)
+			LogFile << FormatLogHTML(Record.Message, Record.Type, Record.Line, Record.Function, Record.Filename, Record.ErrorCode
+#ifdef DYNEXP_HAS_STACKTRACE
+				, Record.Trace
+#endif // DYNEXP_HAS_STACKTRACE
+				, Record.TimePoint
+			);
+
+		LogFile.flush();
+	}
+
 	EventLogger& EventLog()
 	{
 		static EventLogger EventLog;
@@ -290,6 +290,243 @@ namespace Util
 		std::condition_variable ConditionVariable;
 	};
 
+	/**
+	 * @brief Lock-free pool of memory blocks for small objects which are frequently allocated by one thread
+	 * and freed by another one (like module events or queue nodes). Freed blocks are pushed onto a global
+	 * lock-free stack per size class. An allocating thread takes over the entire stack at once into a
+	 * thread-local cache and serves subsequent allocations from there. This avoids the ABA problem of
+	 * popping single blocks concurrently. Blocks are never returned to the operating system, so the pool
+	 * grows to the maximal amount of simultaneously allocated blocks. Requests larger than #MaxBlockSize
+	 * are forwarded to the global @p operator @p new.
+	*/
+	class SmallObjectPool
+	{
+	public:
+		static constexpr size_t BlockSizeGranularity = 64;		//!< Block sizes are multiples of this value in bytes.
+		static constexpr size_t MaxBlockSize = 256;				//!< Largest block size in bytes served from the pool
+
+		SmallObjectPool() = delete;
+
+		/**
+		 * @brief Allocates a memory block of at least @p Size bytes. Thread-safe, lock-free.
+		 * @param Size Amount of bytes to allocate
+		 * @return Pointer to the memory block, aligned as the global @p operator @p new aligns memory
+		 * @throws std::bad_alloc is thrown if the allocation fails.
+		*/
+		static void* Allocate(size_t Size);
+
+		/**
+		 * @brief Returns a memory block allocated by Allocate() to the pool. Thread-safe, lock-free.
+		 * @param Ptr Pointer to the memory block. Nothing happens if it is nullptr.
+		 * @param Size Amount of bytes which have been passed to Allocate()
+		*/
+		static void Deallocate(void* Ptr, size_t Size) noexcept;
+	};
+
+	/**
+	 * @brief Deriving from this class makes @p new and @p delete allocate instances of the derived class
+	 * from SmallObjectPool. Polymorphic derived classes need a virtual destructor, so that @p delete
+	 * receives the size of the most derived class.
+	*/
+	class PooledAllocation
+	{
+	public:
+		static void* operator new(size_t Size) { return SmallObjectPool::Allocate(Size); }
+		static void operator delete(void* Ptr, size_t Size) noexcept { SmallObjectPool::Deallocate(Ptr, Size); }
+
+		// Over-aligned types are not served from the pool.
+		static void* operator new(size_t Size, std::align_val_t Alignment) { return ::operator new(Size, Alignment); }
+		static void operator delete(void* Ptr, size_t Size, std::align_val_t Alignment) noexcept { ::operator delete(Ptr, Size, Alignment); }
+	};
+
+	/**
+	 * @brief Unbounded lock-free multi-producer/single-consumer queue. Any thread might call Push()
+	 * concurrently, but only a single thread at a time is allowed to call Pop(). Based on the intrusive
+	 * node-based queue by Dmitry Vyukov. Producers only perform a single atomic exchange. The consumer
+	 * might temporarily observe an empty queue while a producer is in the middle of pushing an element.
+	 * Small nodes are allocated from SmallObjectPool, so that pushing and popping does not allocate memory
+	 * in the steady state.
+	 * @tparam T Type of the queue's elements. Must be move-constructible.
+	*/
+	template <typename T>
+	class MPSCQueue : public INonCopyable
+	{
+		struct Node : public PooledAllocation
+		{
+			Node() = default;
+			Node(T&& Value) : Value(std::move(Value)) {}
+
+			std::atomic<Node*> Next = nullptr;
+			std::optional<T> Value;
+		};
+
+	public:
+		MPSCQueue() : Head(new Node), Tail(Head.load()) {}
+		~MPSCQueue()
+		{
+			while (Pop());
+			delete Tail;
+		}
+
+		/**
+		 * @brief Appends an element to the queue. Thread-safe, lock-free.
+		 * @param Value Element to move into the queue
+		*/
+		void Push(T Value)
+		{
+			auto NewNode = new Node(std::move(Value));
+
+			++NumElements;
+			auto PrevNode = Head.exchange(NewNode, std::memory_order_acq_rel);
+			PrevNode->Next.store(NewNode, std::memory_order_release);
+		}
+
+		/**
+		 * @brief Removes the oldest element from the queue. Must only be called by the single consumer thread.
+		 * @return Returns the removed element or an empty optional if the queue is empty.
+		*/
+		std::optional<T> Pop()
+		{
+			auto Next = Tail->Next.load(std::memory_order_acquire);
+			if (!Next)
+				return {};
+
+			std::optional<T> Value(std::move(Next->Value));
+			Next->Value.reset();
+			delete Tail;
+			Tail = Next;
+			--NumElements;
+
+			return Value;
+		}
+
+		/**
+		 * @brief Returns the approximate amount of elements in the queue. The returned value might
+		 * be outdated immediately if other threads push or pop concurrently.
+		 * @return Number of queued elements
+		*/
+		size_t Size() const noexcept { return NumElements.load(std::memory_order_relaxed); }
+
+		bool Empty() const noexcept { return !Size(); }		//!< Returns whether Size() is zero.
+
+	private:
+		std::atomic<Node*> Head;					//!< Node most recently pushed. Modified by producers.
+		Node* Tail;									//!< Stub node preceding the oldest element. Modified by the consumer only.
+		std::atomic<size_t> NumElements = 0;		//!< Approximate amount of queued elements
+	};
+
+	/**
+	 * @brief Bounded lock-free single-producer/single-consumer ring buffer. All elements are allocated
+	 * on construction, so that pushing and popping never allocates memory. Only a single thread at a time
+	 * is allowed to call Push() and only a single (other) thread at a time is allowed to call Pop(),
+	 * PopAll(), and Clear().
+	 * @tparam T Type of the ring buffer's elements. Must be default-constructible and copy-assignable.
+	*/
+	template <typename T>
+	class SPSCRingBuffer : public INonCopyable
+	{
+	public:
+		/**
+		 * @brief Constructs a @p SPSCRingBuffer instance.
+		 * @param Capacity Maximal amount of elements the ring buffer can hold
+		 * @throws InvalidArgException is thrown if @p Capacity is zero.
+		*/
+		explicit SPSCRingBuffer(size_t Capacity) : Elements(Capacity + 1)
+		{
+			if (!Capacity)
+				throw InvalidArgException("The capacity of a ring buffer must not be zero.");
+		}
+
+		/**
+		 * @brief Appends an element to the ring buffer. Must only be called by the single producer thread.
+		 * @param Value Element to copy into the ring buffer
+		 * @return Returns true if @p Value has been appended, false if the ring buffer is full.
+		*/
+		bool Push(const T& Value)
+		{
+			const auto CurrentHead = Head.load(std::memory_order_relaxed);
+			const auto NextHead = Increment(CurrentHead);
+			if (NextHead == Tail.load(std::memory_order_acquire))
+				return false;
+
+			Elements[CurrentHead] = Value;
+			Head.store(NextHead, std::memory_order_release);
+
+			return true;
+		}
+
+		/**
+		 * @brief Removes the oldest element from the ring buffer. Must only be called by the single consumer thread.
+		 * @return Returns the removed element or an empty optional if the ring buffer is empty.
+		*/
+		std::optional<T> Pop()
+		{
+			const auto CurrentTail = Tail.load(std::memory_order_relaxed);
+			if (CurrentTail == Head.load(std::memory_order_acquire))
+				return {};
+
+			std::optional<T> Value(Elements[CurrentTail]);
+			Tail.store(Increment(CurrentTail), std::memory_order_release);
+
+			return Value;
+		}
+
+		/**
+		 * @brief Removes all elements currently stored in the ring buffer and appends them to @p Destination.
+		 * Must only be called by the single consumer thread.
+		 * @param Destination Vector to append the removed elements to
+		 * @return Returns the amount of removed elements.
+		*/
+		size_t PopAll(std::vector<T>& Destination)
+		{
+			const auto CurrentTail = Tail.load(std::memory_order_relaxed);
+			const auto CurrentHead = Head.load(std::memory_order_acquire);
+			if (CurrentTail == CurrentHead)
+				return 0;
+
+			// Copy in at most two contiguous chunks.
+			if (CurrentTail < CurrentHead)
+				Destination.insert(Destination.end(), Elements.cbegin() + CurrentTail, Elements.cbegin() + CurrentHead);
+			else
+			{
+				Destination.insert(Destination.end(), Elements.cbegin() + CurrentTail, Elements.cend());
+				Destination.insert(Destination.end(), Elements.cbegin(), Elements.cbegin() + CurrentHead);
+			}
+
+			Tail.store(CurrentHead, std::memory_order_release);
+
+			return CurrentHead >= CurrentTail ? CurrentHead - CurrentTail : Elements.size() - CurrentTail + CurrentHead;
+		}
+
+		/**
+		 * @brief Removes all elements currently stored in the ring buffer. Must only be called by the single consumer thread.
+		*/
+		void Clear() noexcept { Tail.store(Head.load(std::memory_order_acquire), std::memory_order_release); }
+
+		/**
+		 * @brief Returns the approximate amount of elements in the ring buffer. The returned value might
+		 * be outdated immediately if other threads push or pop concurrently.
+		 * @return Number of stored elements
+		*/
+		size_t Size() const noexcept
+		{
+			const auto CurrentHead = Head.load(std::memory_order_acquire);
+			const auto CurrentTail = Tail.load(std::memory_order_acquire);
+
+			return CurrentHead >= CurrentTail ? CurrentHead - CurrentTail : Elements.size() - CurrentTail + CurrentHead;
+		}
+
+		bool Empty() const noexcept { return !Size(); }							//!< Returns whether Size() is zero.
+		size_t GetCapacity() const noexcept { return Elements.size() - 1; }		//!< Returns the maximal amount of elements the ring buffer can hold.
+
+	private:
+		size_t Increment(size_t Index) const noexcept { return ++Index == Elements.size() ? 0 : Index; }
+
+		std::vector<T> Elements;					//!< Preallocated storage. One element always remains unused to distinguish a full from an empty ring buffer.
+		alignas(64) std::atomic<size_t> Head = 0;	//!< Index of the next element to write. Modified by the producer only.
+		alignas(64) std::atomic<size_t> Tail = 0;	//!< Index of the oldest element. Modified by the consumer only.
+	};
+
 	/**
 	 * @brief Checks whether a type @p T is contained in a template parameter pack of types @p ListTs.
 	*/
@@ -947,6 +1184,73 @@ namespace Util
 	*/
 	std::string ToLower(std::string_view Str);
 
+	/**
+	 * @brief Precomputed plan (GSL wavetables and workspaces) to compute Fast Fourier Transforms (FFTs)
+	 * of a fixed length. Reusing a plan avoids reserving memory and computing trigonometric lookup tables
+	 * for every transform. Wavetables and workspaces for complex and real transforms are reserved lazily
+	 * upon the first transform of the respective kind. Instances are not thread-safe. Use GetFFTPlan()
+	 * to obtain a plan which is cached for the calling thread.
+	*/
+	class FFTPlan : public INonCopyable
+	{
+	public:
+		/**
+		 * @brief Constructs a plan for transforms of length @p Length.
+		 * @param Length Number of (complex or real) values to be transformed
+		 * @throws InvalidArgException if @p Length is zero.
+		 * @throws OverflowException if @p Length exceeds half of the maximal value @p size_t can represent.
+		*/
+		FFTPlan(const size_t Length);
+
+		~FFTPlan();
+
+		auto GetLength() const noexcept { return Length; }	//!< Returns the transform length this plan has been created for.
+
+		/**
+		 * @brief Computes the FFT of @p Length complex values in-place.
+		 * @param Data Pointer to the first of @p Length complex values to be transformed
+		 * @param InverseTransform If true, the inverse FFT is computed. False is default.
+		 * @throws NotAvailableException if GSL functions fail reserving memory.
+		 * @throws InvalidDataException if GSL fails to perform the FFT on @p Data.
+		*/
+		void Transform(std::complex<double>* Data, bool InverseTransform = false);
+
+		/**
+		 * @brief Computes the FFT of @p Length real values in-place. The result is stored in GSL's
+		 * half-complex format (refer to GSL's documentation of gsl_fft_real_transform()).
+		 * Use UnpackHalfComplex() to convert the result into a one-sided complex spectrum.
+		 * @param Data Pointer to the first of @p Length real values to be transformed
+		 * @throws NotAvailableException if GSL functions fail reserving memory.
+		 * @throws InvalidDataException if GSL fails to perform the FFT on @p Data.
+		*/
+		void RealTransform(double* Data);
+
+		/**
+		 * @brief Converts the result of RealTransform() into a one-sided complex spectrum.
+		 * @param HalfComplexData Pointer to the first of @p Length values in GSL's half-complex format
+		 * @param Result Pointer to an array of at least @p Length / 2 + 1 complex values to write the
+		 * spectrum for non-negative frequencies to
+		*/
+		void UnpackHalfComplex(const double* HalfComplexData, std::complex<double>* Result) const noexcept;
+
+	private:
+		const size_t Length;
+
+		gsl_fft_complex_wavetable* ComplexWavetable = nullptr;
+		gsl_fft_complex_workspace* ComplexWorkspace = nullptr;
+		gsl_fft_real_wavetable* RealWavetable = nullptr;
+		gsl_fft_real_workspace* RealWorkspace = nullptr;
+	};
+
+	/**
+	 * @brief Returns an FFT plan for transforms of length @p Length. Plans are cached per thread,
+	 * so that subsequent calls from the same thread with the same @p Length reuse the plan.
+	 * @param Length Number of values to be transformed
+	 * @return Reference to the calling thread's plan. It remains valid until the next call
+	 * to GetFFTPlan() from the same thread with a different @p Length.
+	*/
+	FFTPlan& GetFFTPlan(const size_t Length);
+
 	/**
 	 * @brief Computes the Fast Fourier Transform (FFT) a vector of complex values.
 	 * @param Data Vector of complex values to be transformed
@@ -958,6 +1262,109 @@ namespace Util
 	*/
 	std::vector<std::complex<double>> FFT(const std::vector<std::complex<double>>& Data, bool InverseTransform = false);
 
+	/**
+	 * @brief Computes the Fast Fourier Transform (FFT) of a vector of complex values in-place using
+	 * a cached FFT plan. Refer to FFT().
+	 * @param Data Vector of complex values to be transformed. Receives the computed FFT.
+	 * @param InverseTransform If true, the inverse FFT is computed. False is default.
+	*/
+	void FFTInPlace(std::vector<std::complex<double>>& Data, bool InverseTransform = false);
+
+	/**
+	 * @brief Computes the Fast Fourier Transform (FFT) of a vector of real values using a cached FFT plan.
+	 * This is roughly twice as fast as transforming the data as complex values.
+	 * @param Data Vector of real values to be transformed. Pass an rvalue to avoid copying the data.
+	 * @return One-sided spectrum containing the @p Data.size() / 2 + 1 complex FFT values
+	 * for non-negative frequencies
+	 * @throws NotAvailableException if GSL functions fail reserving memory.
+	 * @throws InvalidDataException if GSL fails to perform the FFT on @p Data.
+	*/
+	std::vector<std::complex<double>> RealFFT(std::vector<double> Data);
+
+	/**
+	 * @brief Window functions to be applied to segments of data before computing their FFT.
+	*/
+	enum class FFTWindowType { Rectangular, Hann };
+
+	/**
+	 * @brief Estimates the one-sided power spectral density (PSD) of real-valued data by Welch's method.
+	 * The data is split into (overlapping) segments. Each segment is windowed and transformed. The
+	 * periodograms of all segments are averaged. Segments can be added incrementally, so that instances
+	 * can be used to average the spectrum of a continuous data stream. Instances are not thread-safe.
+	*/
+	class WelchEstimator
+	{
+	public:
+		/**
+		 * @brief Constructs an estimator.
+		 * @param SegmentLength Number of samples per segment. The resulting PSD consists of
+		 * @p SegmentLength / 2 + 1 frequency bins.
+		 * @param SamplingRate Sampling rate of the data in samples/s
+		 * @param Window Window function to be applied to each segment
+		 * @throws InvalidArgException if @p SegmentLength is less than two or if @p SamplingRate is not positive.
+		*/
+		WelchEstimator(const size_t SegmentLength, const double SamplingRate, const FFTWindowType Window = FFTWindowType::Hann);
+
+		auto GetSegmentLength() const noexcept { return SegmentLength; }		//!< Returns the number of samples per segment.
+		auto GetSamplingRate() const noexcept { return SamplingRate; }			//!< Returns the sampling rate in samples/s.
+		auto GetNumSegments() const noexcept { return NumSegments; }			//!< Returns the number of segments averaged so far.
+		double GetFrequencyResolution() const noexcept { return SamplingRate / SegmentLength; }	//!< Returns the frequency bin spacing in Hz.
+
+		/**
+		 * @brief Windows, transforms and accumulates a single segment.
+		 * @param Segment Pointer to the first of @p SegmentLength samples
+		*/
+		void AddSegment(const double* Segment);
+
+		/**
+		 * @brief Splits @p Data into segments overlapping by @p Overlap and adds each complete segment.
+		 * @param Data Data to add
+		 * @param Overlap Fraction in [0, 1) of @p SegmentLength by which consecutive segments overlap
+		 * @return Returns the number of samples from the beginning of @p Data which have been consumed
+		 * entirely. Samples after this offset should be passed again to continue with the next segment.
+		*/
+		size_t AddData(const std::vector<double>& Data, const double Overlap = .5);
+
+		/**
+		 * @brief Returns the averaged one-sided PSD in squared units of the data per Hz.
+		 * @return Vector of @p SegmentLength / 2 + 1 PSD values. Bin i corresponds to the frequency
+		 * i * GetFrequencyResolution(). Contains zeros if no segment has been added yet.
+		*/
+		std::vector<double> GetPSD() const;
+
+		/**
+		 * @brief Returns the averaged one-sided amplitude spectral density (ASD), which is the square root of GetPSD().
+		 * @return Vector of @p SegmentLength / 2 + 1 ASD values in units of the data per square root of Hz.
+		*/
+		std::vector<double> GetASD() const;
+
+		void Reset();	//!< Discards all segments averaged so far.
+
+	private:
+		const size_t SegmentLength;
+		const double SamplingRate;
+
+		std::vector<double> WindowValues;		//!< Precomputed window function
+		double WindowPowerSum{};				//!< Sum of squared values of the window function
+		std::vector<double> SegmentBuffer;		//!< Buffer to transform segments in-place
+		std::vector<double> PowerSum;			//!< Sum of squared magnitudes of all segments' FFT values
+		size_t NumSegments{};
+	};
+
+	/**
+	 * @brief Estimates the one-sided power spectral density (PSD) of real-valued data by Welch's method.
+	 * Refer to class WelchEstimator.
+	 * @param Data Data to compute the PSD of
+	 * @param SamplingRate Sampling rate of @p Data in samples/s
+	 * @param SegmentLength Number of samples per segment. Limited to @p Data.size().
+	 * @param Overlap Fraction in [0, 1) of @p SegmentLength by which consecutive segments overlap
+	 * @param Window Window function to be applied to each segment
+	 * @return Vector of min(@p SegmentLength, @p Data.size()) / 2 + 1 PSD values in squared units of
+	 * the data per Hz
+	*/
+	std::vector<double> WelchPSD(const std::vector<double>& Data, const double SamplingRate, const size_t SegmentLength,
+		const double Overlap = .5, const FFTWindowType Window = FFTWindowType::Hann);
+
 	/**
 	 * @brief Class to store information about warnings in a thread-safe manner (deriving from @p ILockable).
 	 * All function calls are thread-safe.
@@ -1052,17 +1459,61 @@ namespace Util
 	};
 
 	/**
-	 * @brief Logs events like errors and writes them immediately to a HTML file in a human-readable format.
+	 * @brief Logs events like errors and writes them to a HTML file in a human-readable format.
 	 * The logger also stores the events in an internal event log to be displayed within %DynExp.
 	 * The class is designed such that instances can be shared between different threads. Member function
-	 * calls are synchronized.
+	 * calls are synchronized. Logging is asynchronous: Log() only enqueues a record into a lock-free queue.
+	 * A background writer thread formats the records, appends them to the internal log and writes them to
+	 * the log file in batches. The writer flushes the log file periodically or immediately for errors.
+	 * The amount of queued records is bounded. Records exceeding this limit are dropped and counted.
+	 * Identical messages repeatedly logged from the same source code location are deduplicated and
+	 * rate-limited per location.
 	*/
 	class EventLogger : public ILockable
 	{
+		/**
+		 * @brief Log record as enqueued by Log() and processed by the writer thread.
+		*/
+		struct LogRecord
+		{
+			std::string Message;
+			ErrorType Type;
+			size_t Line;
+			std::string Function;
+			std::string Filename;
+			int ErrorCode;
+			std::chrono::system_clock::time_point TimePoint;
+#ifdef DYNEXP_HAS_STACKTRACE
+			std::stacktrace Trace;
+#endif // DYNEXP_HAS_STACKTRACE
+		};
+
+		/**
+		 * @brief Deduplication and rate limiting state of a single source code location.
+		 * Only accessed by the writer thread.
+		*/
+		struct LocationStateType
+		{
+			size_t Line = 0;										//!< Line of the source code location
+			std::string Function;									//!< Function of the source code location
+			std::string Filename;									//!< File of the source code location
+
+			std::string LastMessage;								//!< Last message written from this location
+			ErrorType LastType = ErrorType::Info;					//!< Type of @p LastMessage
+			int LastErrorCode = 0;									//!< Error code of @p LastMessage
+			size_t NumRepetitions = 0;								//!< Number of suppressed repetitions of @p LastMessage
+			std::chrono::system_clock::time_point FirstRepetition;	//!< Time point of the first suppressed repetition
+
+			std::chrono::system_clock::time_point RateWindowStart;	//!< Begin of the current rate limiting window
+			size_t NumRecordsInRateWindow = 0;						//!< Number of records written within the current window
+			size_t NumRateLimited = 0;								//!< Number of records dropped due to rate limiting
+		};
+
 	public:
 		/**
 		 * @brief Constructs the event logger without opening a log file on disk. Events are only
 		 * stored in the internal log until OpenLogFile() is called to open a log file on disk.
+		 * Starts the writer thread.
 		*/
 		EventLogger();
 
@@ -1073,9 +1524,10 @@ namespace Util
 		EventLogger(std::string Filename) : EventLogger() { OpenLogFile(Filename); }
 
 		/**
-		 * @brief Destructor closes the log file on disk.
+		 * @brief Destructor stops the writer thread after having written all pending records
+		 * and closes the log file on disk.
 		*/
-		~EventLogger() { CloseLogFileUnsafe(); }
+		~EventLogger();
 
 		/** @name Noexcept logging
 		 * These functions do not throw exceptions. Instead, they do not perform logging if an exception occurs.
@@ -1136,6 +1588,8 @@ namespace Util
 		 * @param ErrorCode %DynExp error code from DynExpErrorCodes::DynExpErrorCodes
 		 * @param Trace Stack trace object created where the message occurred.
 		 * If it contains entries, they are displayed in an accordion-like style.
+		 * @param TimePoint Time point when the message occurred. If it is default-constructed, the
+		 * current time is used.
 		 * @return Returns the formatted log entry.
 		*/
 		static std::string FormatLogHTML(const std::string& Message, const ErrorType Type = ErrorType::Info,
@@ -1143,6 +1597,7 @@ namespace Util
 #ifdef DYNEXP_HAS_STACKTRACE
 			, const std::stacktrace& Trace = {}
 #endif // DYNEXP_HAS_STACKTRACE
+			, const std::chrono::system_clock::time_point TimePoint = {}
 		);
 
 		/**
@@ -1152,21 +1607,43 @@ namespace Util
 		void OpenLogFile(std::string Filename);
 
 		/**
-		 * @brief Closes the log file on disk and writes terminating HTML tags.
+		 * @brief Writes all pending records and closes the log file on disk writing terminating HTML tags.
 		*/
-		void CloseLogFile() { auto lock = AcquireLock(LogOperationTimeout); CloseLogFileUnsafe(); }
+		void CloseLogFile();
+
+		/**
+		 * @brief Blocks until the writer thread has processed all records which have been enqueued
+		 * before the call to this function or until @p Timeout has been exceeded.
+		 * @param Timeout Maximal time to wait for the writer thread
+		 * @return Returns true if all records have been processed, false if the timeout occurred.
+		*/
+		bool Flush(const std::chrono::milliseconds Timeout = FlushTimeout) noexcept;
 
 		/**
 		 * @brief Determines whether the log file has been openend on disk.
 		 * @return True if the log file is opened, false otherwise.
 		*/
-		bool IsOpen() const { auto lock = AcquireLock(LogOperationTimeout); return IsOpenUnsafe(); }
+		bool IsOpen() const { std::lock_guard<decltype(LogFileMutex)> lock(LogFileMutex); return IsOpenUnsafe(); }
 
 		/**
 		 * @brief Determines the full file path to the currently openend log file.
 		 * @return Path to the openend log file. Empty string if the log file is not opened.
 		*/
-		std::string GetLogFilename() const { auto lock = AcquireLock(LogOperationTimeout); return Filename; }
+		std::string GetLogFilename() const { std::lock_guard<decltype(LogFileMutex)> lock(LogFileMutex); return Filename; }
+
+		/**
+		 * @brief Determines the number of records which have been dropped since the queue of pending
+		 * records was full.
+		 * @return Number of dropped records since construction
+		*/
+		size_t GetNumDroppedRecords() const noexcept { return NumDroppedRecords; }
+
+		/**
+		 * @brief Determines the number of records which have been suppressed since they were identical
+		 * repetitions of a preceding message or since they exceeded the rate limit of their source code location.
+		 * @return Number of suppressed records since construction
+		*/
+		size_t GetNumSuppressedRecords() const noexcept { return NumSuppressedRecords; }
 
 		/**
 		 * @brief Clears the internal event log.
@@ -1198,16 +1675,71 @@ namespace Util
 		void ClearLogUnsafe() { LogEntries.clear(); }
 		///@}
 
+		/** @name Writer thread
+		 * These functions must only be called by the writer thread (or after it has been joined).
+		*/
+		///@{
+		void WriterThread() noexcept;								//!< Writer thread main function.
+		void ProcessPendingRecords();								//!< Processes all records in @p PendingRecords as a single batch.
+
+		/**
+		 * @brief Applies deduplication and rate limiting to @p Record.
+		 * @param Record Record to check
+		 * @param Batch Batch of records to be written. Notices about suppressed records are appended to it.
+		 * @return Returns true if @p Record is to be written, false if it is suppressed.
+		*/
+		bool FilterRecord(const LogRecord& Record, std::vector<LogRecord>& Batch);
+
+		/**
+		 * @brief Appends notices about suppressed repetitions and rate-limited records from @p LocationState to
+		 * @p Batch and resets the respective counters.
+		 * @param Record Record the origin of which is to be used for the notices
+		 * @param LocationState State of @p Record's source code location
+		 * @param Batch Batch of records to be written
+		*/
+		static void AppendSuppressionNotices(const LogRecord& Record, LocationStateType& LocationState, std::vector<LogRecord>& Batch);
+
+		void WriteBatch(std::vector<LogRecord>& Batch);				//!< Appends @p Batch to the internal log and writes it to the log file.
+		///@}
+
 		/**
 		 * @brief Internal timeout for locking the mutex which synchronizes the calls to member function calls.
 		 * If the timeout is exceeded while locking the mutex to log an event, the event is not logged.
 		*/
 		static constexpr auto LogOperationTimeout = std::chrono::milliseconds(100);
 
-		std::ofstream LogFile;				//!< Stream object to write to the log file on disk
-		std::string Filename;				//!< Filename and path to the log file on disk
+		static constexpr auto FlushTimeout = std::chrono::milliseconds(1000);				//!< Default timeout of Flush()
+		static constexpr auto WriterFlushInterval = std::chrono::milliseconds(250);			//!< Time after which the writer processes pending records at latest
+		static constexpr size_t MaxPendingRecords = 10000;									//!< Records exceeding this amount of queued records are dropped.
+		static constexpr auto DeduplicationPeriod = std::chrono::seconds(10);				//!< Time after which a summary of suppressed repetitions is written
+		static constexpr size_t MaxRecordsPerLocationAndSecond = 20;						//!< Rate limit of distinct records per source code location
+		static constexpr size_t MaxNumLocationStates = 1024;								//!< Location states are cleaned up above this amount.
+
+		std::ofstream LogFile;					//!< Stream object to write to the log file on disk
+		std::string Filename;					//!< Filename and path to the log file on disk
+		mutable std::mutex LogFileMutex;		//!< Synchronizes access to @p LogFile and @p Filename
+
+		std::vector<LogEntry> LogEntries;		//!< Internally stored log entries (synchronized by @p ILockable's mutex)
 
-		std::vector<LogEntry> LogEntries;	//!< Internally stored log entries
+		MPSCQueue<LogRecord> PendingRecords;	//!< Records enqueued by Log(), consumed by the writer thread
+		std::atomic<size_t> NumEnqueuedRecords = 0;		//!< Number of records ever enqueued into @p PendingRecords
+		std::atomic<size_t> NumProcessedRecords = 0;	//!< Number of records ever processed by the writer thread
+		std::atomic<size_t> NumDroppedRecords = 0;		//!< Number of records dropped since @p PendingRecords was full
+		std::atomic<size_t> NumSuppressedRecords = 0;	//!< Number of deduplicated or rate-limited records
+		size_t NumReportedDroppedRecords = 0;			//!< Number of dropped records already reported in the log (writer thread only)
+
+		/**
+		 * @brief Deduplication and rate limiting state of each source code location.
+		 * Only accessed by the writer thread.
+		*/
+		std::unordered_map<std::string, LocationStateType> LocationStates;
+
+		std::atomic<bool> WriterWakeupRequested = false;		//!< Indicates that the writer should process pending records immediately.
+		std::atomic<bool> WriterStopRequested = false;			//!< Indicates that the writer should terminate.
+		std::mutex WriterMutex;									//!< Mutex for @p WriterCV and @p ProcessedCV
+		std::condition_variable WriterCV;						//!< Wakes up the writer thread.
+		std::condition_variable ProcessedCV;					//!< Notifies threads waiting in Flush().
+		std::thread Writer;										//!< Writer thread. Must be the last member to be initialized.
 	};
 
 	/**
@@ -7,6 +7,7 @@ namespace Util
 {
 	circularbuf::circularbuf(size_t size)
 	{
+		check_size(size);
 		buffer.resize(size);
 
 		clear();
@@ -51,21 +52,19 @@ namespace Util
 
 	void circularbuf::resize(size_t size)
 	{
+		check_size(size);
+
+		// Determine the positions before reallocating since the get and put pointers refer to the old buffer.
+		const auto ppos = static_cast<size_t>(ptellp());
+		const auto gpos = static_cast<size_t>(gtellp());
+		const auto gsz = gsize();
+
 		buffer.resize(size);
 
-		auto ppos = ptellp();
 		setp(buffer.data(), buffer.data() + buffer.size());
+		pbump_large(std::min(ppos, buffer.size()));
 
-		auto buffer_size = to_pos_type(buffer.size());
-		if (buffer_size > std::numeric_limits<int>::max())
-			throw std::overflow_error("Cannot convert a buffer size to int since this would cause an overflow in circularbuf::resize().");
-		pbump(ppos >= buffer_size ? buffer_size : ppos);
-
-		auto gpos = gtellp();
-		auto gsz = gsize();
-		setg(buffer.data(),
-			gpos >= buffer_size ? buffer.data() + buffer_size : buffer.data() + gpos,
-			gsz >= buffer.size() ? buffer.data() + buffer.size() : buffer.data() + gsz);
+		setg(buffer.data(), buffer.data() + std::min(gpos, buffer.size()), buffer.data() + std::min(gsz, buffer.size()));
 	}
 
 	std::streamsize circularbuf::avail_get_count() const noexcept
@@ -73,6 +72,21 @@ namespace Util
 		return egptr() - eback();
 	}
 
+	void circularbuf::check_size(size_t size)
+	{
+		if (size > max_size())
+			throw std::overflow_error("The buffer size exceeds the maximal size of the standard library's stream buffers in circularbuf.");
+	}
+
+	void circularbuf::pbump_large(size_t count)
+	{
+		constexpr auto max_step = static_cast<size_t>(std::numeric_limits<int>::max());
+
+		for (; count > max_step; count -= max_step)
+			pbump(std::numeric_limits<int>::max());
+		pbump(static_cast<int>(count));
+	}
+
 	circularbuf::int_type circularbuf::overflow(int_type c)
 	{
 		// Return eof if put buffer is empty or c is eof
@@ -216,7 +230,7 @@ namespace Util
 			else
 			{
 				setp(pbase(), epptr());
-				pbump(pos);
+				pbump_large(static_cast<size_t>(off_type(pos)));
 			}
 		}
 
@@ -28,9 +28,26 @@ namespace Util
 		 * @brief Constructs a new @p circularbuf instance with a #buffer of size @p size.
 		 * The put area will span the entire #buffer, the get area will be empty.
 		 * @param size Initial buffer size
+		 * @throws std::overflow_error is thrown if @p size exceeds @p max_size().
 		*/
 		circularbuf(size_t size);
 
+		/**
+		 * @brief Returns the maximal buffer size. MSVC's standard library stores the sizes of the
+		 * get and put areas as @p int and derives @p egptr() and @p epptr() from them. There,
+		 * buffers are limited to the range of @p int (2 GiB). Other standard libraries store pointers
+		 * only, and the buffer size is only limited by the available memory.
+		 * @return Maximal buffer size in characters
+		*/
+		static constexpr size_t max_size() noexcept
+		{
+#ifdef _MSC_VER
+			return static_cast<size_t>(std::numeric_limits<int>::max());
+#else
+			return static_cast<size_t>(std::numeric_limits<std::streamsize>::max());
+#endif
+		}
+
 		/**
 		 * @brief Indicates whether characters can be read from the get area.
 		 * Not const since @p sync() needs to be called to get correct size after a character has been written recently.
@@ -75,9 +92,9 @@ namespace Util
 		 * The put area will span the entire #buffer. If the buffer is enlarged, the get area will
 		 * maintain its size. If the buffer is shrunk, the get area will span the entire #buffer.
 		 * If the original put (get) pointer falls behind the new put (get) area's length, it is set
-		 * to the put (get) area's end, otherwise it will maintain its old position. 
+		 * to the put (get) area's end, otherwise it will maintain its old position.
 		 * @param size New buffer size to apply
-		 * @throws std::overflow_error is thrown if @p size does not fit into @p int.
+		 * @throws std::overflow_error is thrown if @p size exceeds @p max_size().
 		*/
 		void resize(size_t size);
 
@@ -89,6 +106,14 @@ namespace Util
 		*/
 		std::streamsize avail_get_count() const noexcept;
 
+		/**
+		 * @brief Advances the put pointer by @p count characters. In contrast to @p pbump(),
+		 * @p count may exceed the range of @p int, which allows for buffers larger than 2 GiB
+		 * if @p max_size() permits.
+		 * @param count Amount of characters to advance the put pointer by
+		*/
+		void pbump_large(size_t count);
+
 		/** @name Overridden
 		 * Overridden from standard library. Refer to documentation of @p std::streambuf.
 		*/
@@ -148,6 +173,13 @@ namespace Util
 			return static_cast<std::make_signed_t<T>>(value);
 		}
 
+		/**
+		 * @brief Throws if @p size exceeds @p max_size().
+		 * @param size Buffer size to check
+		 * @throws std::overflow_error is thrown if @p size exceeds @p max_size().
+		*/
+		static void check_size(size_t size);
+
 		/**
 		 * @brief The buffer itself.
 		*/
@@ -10,14 +10,17 @@
 #include <any>
 #include <array>
 #include <atomic>
+#include <bit>
 #include <bitset>
 #include <cassert>
 #include <cctype>
+#include <charconv>
 #include <chrono>
 #include <cmath>
 #include <compare>
 #include <complex>
 #include <condition_variable>
+#include <coroutine>
 #include <cstring>
 #include <deque>
 #include <exception>
@@ -27,6 +30,7 @@
 #include <functional>
 #include <future>
 #include <iomanip>
+#include <iostream>
 #include <iterator>
 #include <latch>
 #include <limits>
@@ -37,11 +41,13 @@
 #include <mutex>
 #include <numbers>
 #include <numeric>
+#include <optional>
 #include <queue>
 #include <random>
 #include <ranges>
 #include <regex>
 #include <source_location>
+#include <span>
 #include <stacktrace>
 #include <string>
 #include <string_view>
@@ -78,7 +84,10 @@
 
 // GNU Scientific Library (GSL)
 #include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_fft_real.h>
 #include <gsl/gsl_fit.h>
+#include <gsl/gsl_multifit.h>
 #include <gsl/gsl_multimin.h>
 #include <gsl/gsl_rng.h>
 #include <gsl/gsl_siman.h>
@@ -94,6 +103,9 @@
 #include <pybind11/embed.h>
 #include <pybind11/chrono.h>
 #include <pybind11/stl_bind.h>
+#if PYBIND11_VERSION_MAJOR >= 3 && PY_VERSION_HEX >= 0x030C0000
+#include <pybind11/subinterpreter.h>
+#endif
 #pragma pop_macro("slots")
 
 // DynExp
@@ -101,4 +113,5 @@
 #include "Util.h"
 #include "circularbuf.h"
 #include "QtUtil.h"
+#include "DataFileWriter.h"
 #include "PyUtil.h"
\ No newline at end of file